@@ -0,0 +1,678 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Microbenchmark suite for the hot paths of MEOS.
+ *
+ * The program generates reproducible synthetic trips with the BerlinMOD
+ * data generator function `create_trip()` on random road paths, and then
+ * measures the following functions on these trips
+ * - `tsequence_make()` on the instants of every trip,
+ * - `temporal_append_tinstant()` building every trip instant by instant in
+ *   an expandable sequence,
+ * - `tgeo_at_stbox()` restricting every trip to the center of the region,
+ * - `tdwithin_tgeo_tgeo()` between every trip and the next one,
+ * - `temporal_tagg_transfn()` through `tfloat_tsum_transfn()` aggregating
+ *   the speed of all trips,
+ * - `temporal_as_wkb()`, `temporal_from_wkb()`, `temporal_out()` and
+ *   `tgeompoint_in()` for the binary and text input/output.
+ *
+ * Every call of a benchmarked function is timed individually. After a number
+ * of warmup repetitions that are not measured, the calls of all repetitions
+ * are collected to compute the minimum, mean, percentiles and maximum time
+ * per call, as well as the number of calls and instants processed per
+ * second. Each benchmark also computes a checksum of its results, e.g., the
+ * total number of instants of the result, that must be equal across versions
+ * of the library for the same parameters. The results are written in JSON
+ * to the file given with the option `--output` (by default `meos_bench.json`)
+ * and summarized in the standard output. When the library is built with the
+ * CMake option `MEOS_STATS`, the JSON output also contains the
+ * instrumentation counters of the measured repetitions of each benchmark.
+ *
+ * The program is built in the MEOS build directory as follows
+ * @code
+ * make meos_bench
+ * ./meos/bench/meos_bench --trips 100 --edges 50 --repetitions 10
+ * @endcode
+ * while the target `make bench` builds and runs the suite with the default
+ * parameters. The options of the program are listed with `--help`.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal.h>
+/* The data generator is not part of the public API */
+#include "geo/tpoint_datagen.h"
+/* The pseudo-random generator is shared with the test programs */
+#include "meos_test.h"
+
+/* SRID of the trips */
+#define SRID 3857
+/* Origin and size in meters of the region in which the trips are generated */
+#define REGION_XMIN 480000.0
+#define REGION_YMIN 6580000.0
+#define REGION_SIZE 20000.0
+/* Maximum number of points of an edge of the road path of a trip */
+#define MAX_EDGE_POINTS 5
+/* Minimum and maximum length in meters of a segment of an edge */
+#define MIN_SEGMENT_LENGTH 50.0
+#define MAX_SEGMENT_LENGTH 300.0
+/* Time in seconds between the start of two consecutive trips */
+#define TRIP_DELAY 60
+/* Distance in meters used in the tdwithin benchmark */
+#define DWITHIN_DIST 500.0
+/* Number of decimal digits used in the text output */
+#define MAXDD 15
+
+/* Default values of the parameters */
+#define DEFAULT_TRIPS 100
+#define DEFAULT_EDGES 50
+#define DEFAULT_WARMUP 2
+#define DEFAULT_REPETITIONS 10
+#define DEFAULT_SEED 1
+#define DEFAULT_OUTPUT "meos_bench.json"
+
+/* Maximum speed in km/h of the side roads, main roads and freeways */
+static const double ROAD_SPEEDS[3] = {30.0, 50.0, 90.0};
+
+/* Parameters of the suite */
+typedef struct
+{
+  int trips;          /**< Number of trips */
+  int edges;          /**< Number of edges of the road path of a trip */
+  int warmup;         /**< Number of repetitions that are not measured */
+  int repetitions;    /**< Number of measured repetitions */
+  uint64_t seed;      /**< Seed of the random generators */
+  const char *filter; /**< Only run the benchmarks containing this string */
+  const char *output; /**< Name of the JSON output file */
+} bench_config;
+
+/* Data shared by the benchmarks, which is prepared before running them */
+typedef struct
+{
+  int count;              /**< Number of trips */
+  Temporal **trips;       /**< Trips */
+  TInstant ***instants;   /**< Instants of the trips */
+  int *ninstants;         /**< Number of instants of the trips */
+  Temporal **speeds;      /**< Speed of the trips */
+  uint8_t **wkb;          /**< WKB representation of the trips */
+  size_t *wkb_size;       /**< Size of the WKB representation of the trips */
+  char **text;            /**< Text representation of the trips */
+  STBox *box;             /**< Box used for the restriction */
+  SkipList *state;        /**< State of the aggregation */
+} bench_data;
+
+/* Definition of a benchmark */
+typedef struct
+{
+  const char *name;       /**< Name of the benchmarked function */
+  const char *params;     /**< Parameters of the benchmark as a JSON object */
+  /* Function called once per trip in each repetition, which returns the
+   * contribution of the call to the checksum of the benchmark */
+  double (*call)(bench_data *data, int i);
+  /* Optional functions called at the beginning and the end of each
+   * repetition, the latter returns its contribution to the checksum */
+  void (*begin)(bench_data *data);
+  double (*end)(bench_data *data);
+} bench_def;
+
+/* Results of a benchmark */
+typedef struct
+{
+  long samples;           /**< Number of timed calls */
+  double min;             /**< Statistics of the time per call in ns */
+  double mean;
+  double p50;
+  double p90;
+  double p99;
+  double max;
+  double ops_per_sec;     /**< Number of calls per second */
+  double insts_per_sec;   /**< Number of input instants per second */
+  double checksum;        /**< Checksum of the last repetition */
+  bool has_stats;         /**< True if the library maintains the counters */
+  MeosStat stats[MEOS_STAT_COUNT]; /**< Counters of the measured repetitions */
+} bench_result;
+
+/*****************************************************************************
+ * Generation of the trips
+ *****************************************************************************/
+
+/**
+ * @brief Return a synthetic trip that follows a random road path of
+ * @p noedges edges starting at the timestamp @p t
+ */
+static Temporal *
+synthetic_trip(int noedges, TimestampTz t)
+{
+  LWLINE **lines = malloc(sizeof(LWLINE *) * noedges);
+  double *maxspeeds = malloc(sizeof(double) * noedges);
+  int *categories = malloc(sizeof(int) * noedges);
+  POINT4D pt = {0};
+  pt.x = REGION_XMIN + REGION_SIZE * (0.25 + 0.5 * rnd());
+  pt.y = REGION_YMIN + REGION_SIZE * (0.25 + 0.5 * rnd());
+  double heading = 2 * M_PI * rnd();
+  for (int i = 0; i < noedges; i++)
+  {
+    int npoints = 2 + (int) (rnd() * (MAX_EDGE_POINTS - 1));
+    POINTARRAY *pa = ptarray_construct_empty(false, false, npoints);
+    ptarray_append_point(pa, &pt, LW_TRUE);
+    for (int j = 1; j < npoints; j++)
+    {
+      /* Turn by at most 45 degrees and bounce on the borders of the region */
+      heading += (rnd() - 0.5) * M_PI / 2;
+      double length = MIN_SEGMENT_LENGTH +
+        (MAX_SEGMENT_LENGTH - MIN_SEGMENT_LENGTH) * rnd();
+      double x = pt.x + length * cos(heading);
+      double y = pt.y + length * sin(heading);
+      if (x < REGION_XMIN || x > REGION_XMIN + REGION_SIZE ||
+          y < REGION_YMIN || y > REGION_YMIN + REGION_SIZE)
+      {
+        heading += M_PI;
+        x = pt.x + length * cos(heading);
+        y = pt.y + length * sin(heading);
+      }
+      pt.x = x; pt.y = y;
+      ptarray_append_point(pa, &pt, LW_TRUE);
+    }
+    lines[i] = lwline_construct(SRID, NULL, pa);
+    categories[i] = (int) (rnd() * 3);
+    maxspeeds[i] = ROAD_SPEEDS[categories[i]];
+  }
+  /* The function frees the lines and their array */
+  Temporal *result = (Temporal *) create_trip(lines, maxspeeds, categories,
+    (uint32_t) noedges, t, false, 0);
+  free(maxspeeds); free(categories);
+  return result;
+}
+
+/**
+ * @brief Generate the trips and prepare the input of the benchmarks
+ */
+static void
+bench_data_make(const bench_config *config, bench_data *data)
+{
+  /* Both the road paths and the data generator are seeded */
+  rnd_seed(config->seed);
+  gsl_rng_set(gsl_get_generation_rng(), config->seed);
+
+  int count = config->trips;
+  data->count = count;
+  data->trips = malloc(sizeof(Temporal *) * count);
+  data->instants = malloc(sizeof(TInstant **) * count);
+  data->ninstants = malloc(sizeof(int) * count);
+  data->speeds = malloc(sizeof(Temporal *) * count);
+  data->wkb = malloc(sizeof(uint8_t *) * count);
+  data->wkb_size = malloc(sizeof(size_t) * count);
+  data->text = malloc(sizeof(char *) * count);
+  TimestampTz t0 = pg_timestamptz_in("2025-01-01 08:00:00", -1);
+  for (int i = 0; i < count; i++)
+  {
+    data->trips[i] = synthetic_trip(config->edges,
+      t0 + (TimestampTz) i * TRIP_DELAY * 1000000);
+    data->instants[i] = temporal_instants(data->trips[i],
+      &data->ninstants[i]);
+    data->speeds[i] = tpoint_speed(data->trips[i]);
+    data->wkb[i] = temporal_as_wkb(data->trips[i], WKB_EXTENDED,
+      &data->wkb_size[i]);
+    data->text[i] = temporal_out(data->trips[i], MAXDD);
+  }
+  data->box = stbox_make(true, false, false, SRID,
+    REGION_XMIN + REGION_SIZE / 4, REGION_XMIN + REGION_SIZE * 3 / 4,
+    REGION_YMIN + REGION_SIZE / 4, REGION_YMIN + REGION_SIZE * 3 / 4,
+    0.0, 0.0, NULL);
+  data->state = NULL;
+  return;
+}
+
+/**
+ * @brief Free the input of the benchmarks
+ */
+static void
+bench_data_free(bench_data *data)
+{
+  for (int i = 0; i < data->count; i++)
+  {
+    for (int j = 0; j < data->ninstants[i]; j++)
+      free(data->instants[i][j]);
+    free(data->instants[i]);
+    free(data->trips[i]);
+    free(data->speeds[i]);
+    free(data->wkb[i]);
+    free(data->text[i]);
+  }
+  free(data->trips); free(data->instants); free(data->ninstants);
+  free(data->speeds); free(data->wkb); free(data->wkb_size); free(data->text);
+  free(data->box);
+  return;
+}
+
+/*****************************************************************************
+ * Benchmarks
+ *****************************************************************************/
+
+/* Return the number of instants of a temporal value and free it */
+static double
+num_instants_free(Temporal *temp)
+{
+  if (! temp)
+    return 0.0;
+  double result = (double) temporal_num_instants(temp);
+  free(temp);
+  return result;
+}
+
+static double
+call_tsequence_make(bench_data *data, int i)
+{
+  TSequence *seq = tsequence_make((const TInstant **) data->instants[i],
+    data->ninstants[i], true, true, LINEAR, true);
+  return num_instants_free((Temporal *) seq);
+}
+
+static double
+call_temporal_append_tinstant(bench_data *data, int i)
+{
+  TInstant **instants = data->instants[i];
+  Temporal *temp = (Temporal *) tsequence_make_exp(
+    (const TInstant **) instants, 1, 64, true, true, LINEAR, false);
+  for (int j = 1; j < data->ninstants[i]; j++)
+    temp = temporal_append_tinstant(temp, instants[j], LINEAR, 0.0, NULL,
+      true);
+  return num_instants_free(temp);
+}
+
+static double
+call_tgeo_at_stbox(bench_data *data, int i)
+{
+  return num_instants_free(tgeo_at_stbox(data->trips[i], data->box, true));
+}
+
+static double
+call_tdwithin_tgeo_tgeo(bench_data *data, int i)
+{
+  int j = (i + 1) % data->count;
+  return num_instants_free(tdwithin_tgeo_tgeo(data->trips[i], data->trips[j],
+    DWITHIN_DIST, false, false));
+}
+
+static void
+begin_tfloat_tsum(bench_data *data)
+{
+  data->state = NULL;
+  return;
+}
+
+static double
+call_tfloat_tsum_transfn(bench_data *data, int i)
+{
+  data->state = tfloat_tsum_transfn(data->state, data->speeds[i]);
+  return 0.0;
+}
+
+static double
+end_tfloat_tsum(bench_data *data)
+{
+  /* The final function frees the state */
+  Temporal *result = temporal_tagg_finalfn(data->state);
+  data->state = NULL;
+  return num_instants_free(result);
+}
+
+static double
+call_temporal_as_wkb(bench_data *data, int i)
+{
+  size_t size;
+  uint8_t *wkb = temporal_as_wkb(data->trips[i], WKB_EXTENDED, &size);
+  free(wkb);
+  return (double) size;
+}
+
+static double
+call_temporal_from_wkb(bench_data *data, int i)
+{
+  return num_instants_free(temporal_from_wkb(data->wkb[i],
+    data->wkb_size[i]));
+}
+
+static double
+call_temporal_out(bench_data *data, int i)
+{
+  char *str = temporal_out(data->trips[i], MAXDD);
+  double result = (double) strlen(str);
+  free(str);
+  return result;
+}
+
+static double
+call_tgeompoint_in(bench_data *data, int i)
+{
+  return num_instants_free(tgeompoint_in(data->text[i]));
+}
+
+/* Benchmarks of the suite */
+static const bench_def BENCHMARKS[] =
+{
+  {"tsequence_make", "{\"interp\": \"linear\", \"normalize\": true}",
+    &call_tsequence_make, NULL, NULL},
+  {"temporal_append_tinstant", "{\"interp\": \"linear\", \"expand\": true}",
+    &call_temporal_append_tinstant, NULL, NULL},
+  {"tgeo_at_stbox", "{\"box\": \"center\", \"border_inc\": true}",
+    &call_tgeo_at_stbox, NULL, NULL},
+  {"tdwithin_tgeo_tgeo", "{\"dist\": 500, \"restr\": false}",
+    &call_tdwithin_tgeo_tgeo, NULL, NULL},
+  {"temporal_tagg_transfn", "{\"func\": \"tfloat_tsum_transfn\"}",
+    &call_tfloat_tsum_transfn, &begin_tfloat_tsum, &end_tfloat_tsum},
+  {"temporal_as_wkb", "{\"variant\": \"extended\"}",
+    &call_temporal_as_wkb, NULL, NULL},
+  {"temporal_from_wkb", "{\"variant\": \"extended\"}",
+    &call_temporal_from_wkb, NULL, NULL},
+  {"temporal_out", "{\"maxdd\": 15}",
+    &call_temporal_out, NULL, NULL},
+  {"tgeompoint_in", "{\"maxdd\": 15}",
+    &call_tgeompoint_in, NULL, NULL},
+};
+
+#define NO_BENCHMARKS ((int) (sizeof(BENCHMARKS) / sizeof(bench_def)))
+
+/*****************************************************************************
+ * Harness
+ *****************************************************************************/
+
+/* Return the current time in nanoseconds */
+static double
+get_time_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+}
+
+/* Comparison function for sorting the samples */
+static int
+double_cmp(const void *a, const void *b)
+{
+  double d1 = *(const double *) a, d2 = *(const double *) b;
+  return (d1 > d2) - (d1 < d2);
+}
+
+/**
+ * @brief Return the percentile @p p of the sorted samples using the nearest
+ * rank method
+ */
+static double
+percentile(const double *samples, long count, double p)
+{
+  long rank = (long) ceil(p / 100.0 * count);
+  if (rank < 1)
+    rank = 1;
+  return samples[rank - 1];
+}
+
+/**
+ * @brief Run a benchmark and compute its results
+ */
+static void
+bench_run(const bench_def *bench, const bench_config *config,
+  bench_data *data, bench_result *result)
+{
+  int count = data->count;
+  long ninsts = 0;
+  for (int i = 0; i < count; i++)
+    ninsts += data->ninstants[i];
+
+  long nsamples = (long) count * config->repetitions;
+  double *samples = malloc(sizeof(double) * nsamples);
+  long k = 0;
+  for (int rep = 0; rep < config->warmup + config->repetitions; rep++)
+  {
+    bool measured = rep >= config->warmup;
+    double checksum = 0.0;
+    /* Only keep the instrumentation counters of the measured repetitions */
+    if (rep == config->warmup)
+      meos_stats_reset();
+    if (bench->begin)
+      bench->begin(data);
+    for (int i = 0; i < count; i++)
+    {
+      double start = get_time_ns();
+      checksum += bench->call(data, i);
+      double elapsed = get_time_ns() - start;
+      if (measured)
+        samples[k++] = elapsed;
+    }
+    if (bench->end)
+      checksum += bench->end(data);
+    result->checksum = checksum;
+  }
+  result->has_stats = meos_stats_get(result->stats);
+
+  /* Compute the statistics */
+  qsort(samples, nsamples, sizeof(double), &double_cmp);
+  double total = 0.0;
+  for (long i = 0; i < nsamples; i++)
+    total += samples[i];
+  result->samples = nsamples;
+  result->min = samples[0];
+  result->mean = total / nsamples;
+  result->p50 = percentile(samples, nsamples, 50.0);
+  result->p90 = percentile(samples, nsamples, 90.0);
+  result->p99 = percentile(samples, nsamples, 99.0);
+  result->max = samples[nsamples - 1];
+  result->ops_per_sec = total > 0.0 ? nsamples / total * 1e9 : 0.0;
+  result->insts_per_sec = total > 0.0 ?
+    (double) ninsts * config->repetitions / total * 1e9 : 0.0;
+  free(samples);
+  return;
+}
+
+/**
+ * @brief Write the results of the benchmarks in JSON
+ */
+static bool
+bench_write_json(const bench_config *config, const bench_data *data,
+  const bench_def **benchs, const bench_result *results, int count)
+{
+  FILE *file = fopen(config->output, "w");
+  if (! file)
+  {
+    printf("Error opening output file '%s'\n", config->output);
+    return false;
+  }
+  long ninsts = 0;
+  for (int i = 0; i < data->count; i++)
+    ninsts += data->ninstants[i];
+  char date[32];
+  time_t now = time(NULL);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+  fprintf(file, "{\n");
+  fprintf(file, "  \"suite\": \"meos_bench\",\n");
+#ifdef MOBILITYDB_VERSION_STRING
+  fprintf(file, "  \"version\": \"%s\",\n", MOBILITYDB_VERSION_STRING);
+#endif
+  fprintf(file, "  \"date\": \"%s\",\n", date);
+  fprintf(file, "  \"config\": {\"trips\": %d, \"edges\": %d, "
+    "\"instants\": %ld, \"seed\": %llu, \"warmup\": %d, "
+    "\"repetitions\": %d},\n", config->trips, config->edges, ninsts,
+    (unsigned long long) config->seed, config->warmup, config->repetitions);
+  fprintf(file, "  \"benchmarks\": [\n");
+  for (int i = 0; i < count; i++)
+  {
+    const bench_result *r = &results[i];
+    fprintf(file, "    {\"name\": \"%s\", \"params\": %s, \"unit\": \"ns\", "
+      "\"samples\": %ld, \"min\": %.0f, \"mean\": %.0f, \"p50\": %.0f, "
+      "\"p90\": %.0f, \"p99\": %.0f, \"max\": %.0f, \"ops_per_sec\": %.3f, "
+      "\"instants_per_sec\": %.0f, \"checksum\": %.0f", benchs[i]->name,
+      benchs[i]->params, r->samples, r->min, r->mean, r->p50, r->p90, r->p99,
+      r->max, r->ops_per_sec, r->insts_per_sec, r->checksum);
+    if (r->has_stats)
+    {
+      fprintf(file, ", \"counters\": {");
+      for (int j = 0; j < MEOS_STAT_COUNT; j++)
+        fprintf(file, "%s\"%s\": {\"calls\": %llu, \"ns\": %llu}",
+          j > 0 ? ", " : "", meos_stat_name((meosStatType) j),
+          (unsigned long long) r->stats[j].calls,
+          (unsigned long long) r->stats[j].nsecs);
+      fprintf(file, "}");
+    }
+    fprintf(file, "}%s\n", i < count - 1 ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+  fclose(file);
+  return true;
+}
+
+/* Print the usage of the program */
+static void
+usage(const char *program)
+{
+  printf("Usage: %s [OPTION]...\n"
+    "  --trips N         number of trips (default %d)\n"
+    "  --edges N         number of edges of the path of a trip (default %d)\n"
+    "  --warmup N        number of unmeasured repetitions (default %d)\n"
+    "  --repetitions N   number of measured repetitions (default %d)\n"
+    "  --seed N          seed of the random generators (default %d)\n"
+    "  --filter STRING   only run the benchmarks whose name contains STRING\n"
+    "  --output FILE     JSON output file (default %s)\n",
+    program, DEFAULT_TRIPS, DEFAULT_EDGES, DEFAULT_WARMUP,
+    DEFAULT_REPETITIONS, DEFAULT_SEED, DEFAULT_OUTPUT);
+  return;
+}
+
+/**
+ * @brief Read the options of the program, return false on error
+ */
+static bool
+parse_options(int argc, char **argv, bench_config *config)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    const char *opt = argv[i];
+    if (strcmp(opt, "--help") == 0)
+      return false;
+    if (i + 1 == argc)
+    {
+      printf("Missing value of option '%s'\n", opt);
+      return false;
+    }
+    const char *value = argv[++i];
+    if (strcmp(opt, "--trips") == 0)
+      config->trips = atoi(value);
+    else if (strcmp(opt, "--edges") == 0)
+      config->edges = atoi(value);
+    else if (strcmp(opt, "--warmup") == 0)
+      config->warmup = atoi(value);
+    else if (strcmp(opt, "--repetitions") == 0)
+      config->repetitions = atoi(value);
+    else if (strcmp(opt, "--seed") == 0)
+      config->seed = strtoull(value, NULL, 10);
+    else if (strcmp(opt, "--filter") == 0)
+      config->filter = value;
+    else if (strcmp(opt, "--output") == 0)
+      config->output = value;
+    else
+    {
+      printf("Unknown option '%s'\n", opt);
+      return false;
+    }
+  }
+  if (config->trips < 2 || config->edges < 1 || config->warmup < 0 ||
+      config->repetitions < 1)
+  {
+    printf("The number of trips must be at least 2, the number of edges and "
+      "repetitions at least 1, and the number of warmups at least 0\n");
+    return false;
+  }
+  return true;
+}
+
+/* Main program */
+int
+main(int argc, char **argv)
+{
+  bench_config config = {DEFAULT_TRIPS, DEFAULT_EDGES, DEFAULT_WARMUP,
+    DEFAULT_REPETITIONS, DEFAULT_SEED, NULL, DEFAULT_OUTPUT};
+  if (! parse_options(argc, argv, &config))
+  {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  /* Initialize MEOS */
+  meos_initialize();
+  meos_initialize_timezone("UTC");
+
+  /* Generate the trips */
+  bench_data data;
+  bench_data_make(&config, &data);
+  long ninsts = 0;
+  for (int i = 0; i < data.count; i++)
+    ninsts += data.ninstants[i];
+  printf("%d trips with %ld instants generated (seed %llu)\n", data.count,
+    ninsts, (unsigned long long) config.seed);
+
+  /* Run the benchmarks */
+  const bench_def *benchs[NO_BENCHMARKS];
+  bench_result results[NO_BENCHMARKS];
+  int count = 0;
+  printf("%-26s %12s %12s %12s %12s %14s %14s\n", "benchmark", "p50 (us)",
+    "p90 (us)", "p99 (us)", "mean (us)", "instants/s", "checksum");
+  for (int i = 0; i < NO_BENCHMARKS; i++)
+  {
+    const bench_def *bench = &BENCHMARKS[i];
+    if (config.filter && ! strstr(bench->name, config.filter))
+      continue;
+    bench_result *r = &results[count];
+    bench_run(bench, &config, &data, r);
+    benchs[count++] = bench;
+    printf("%-26s %12.1f %12.1f %12.1f %12.1f %14.0f %14.0f\n", bench->name,
+      r->p50 / 1e3, r->p90 / 1e3, r->p99 / 1e3, r->mean / 1e3,
+      r->insts_per_sec, r->checksum);
+  }
+
+  /* Output the results */
+  int status = EXIT_SUCCESS;
+  if (bench_write_json(&config, &data, benchs, results, count))
+    printf("Results written to '%s'\n", config.output);
+  else
+    status = EXIT_FAILURE;
+
+  /* Clean up */
+  bench_data_free(&data);
+
+  /* Finalize MEOS */
+  meos_finalize();
+  return status;
+}
@@ -0,0 +1,272 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A benchmark that measures the cost of appending the instants of AIS
+ * trips one by one to expandable temporal sequences.
+ *
+ * The program reads the AIS records from the CSV file used in `ais_expand.c`,
+ * keeps the instants of the ship with the largest number of observations in
+ * memory, and then builds its trip by appending prefixes of increasing size
+ * of these instants to an expandable sequence of small initial capacity
+ * - without a maximum gap, where the trip is a single sequence, and
+ * - with a maximum gap of 5 minutes between consecutive instants, which
+ *   splits the trip into an expandable sequence set.
+ * For each prefix size the program outputs the average cost in nanoseconds
+ * per appended instant. Since only the public API is used, the program can
+ * be linked with different versions of MEOS to compare them. When the
+ * sequences are enlarged in place by doubling their capacity, the cost per
+ * instant stays constant when the number of instants increases.
+ *
+ * Please read the assumptions made about the input file in the file
+ * `02_ais_read.c` in the same directory.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -O2 -I/usr/local/include -o ais_expand_bench ais_expand_bench.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <meos.h>
+#include <meos_geo.h>
+/* The expandable functions are in the internal MEOS API */
+#include <meos_internal.h>
+
+/* Maximum length in characters of a header record in the input CSV file */
+#define MAX_LENGTH_HEADER 1024
+/* Maximum length in characters of a timestamp in the input data */
+#define MAX_LENGTH_TIMESTAMP 32
+/* Maximum number of ships */
+#define MAX_SHIPS 5
+/* Initial number of instants per ship */
+#define INITIAL_INSTANTS 1024
+/* Number of repetitions of each measure */
+#define NO_REPETITIONS 3
+
+typedef struct
+{
+  Timestamp T;
+  long int MMSI;
+  double Latitude;
+  double Longitude;
+  double SOG;
+} AIS_record;
+
+typedef struct
+{
+  long int MMSI;       /* Identifier of the ship */
+  int numinstants;     /* Number of instants */
+  int maxinstants;     /* Size of the array of instants */
+  TInstant **instants; /* Instants of the ship */
+} ship_record;
+
+/**
+ * @brief Build a trip by appending the first @p count instants to an
+ * expandable sequence and return the elapsed time in nanoseconds
+ */
+static double
+build_trip(TInstant **instants, int count, const Interval *maxt)
+{
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  /* The expandable sequence starts with a small capacity in order to also
+   * measure the cost of enlarging it */
+  Temporal *trip = (Temporal *) tsequence_make_exp(
+    (const TInstant **) instants, 1, 2, true, true, LINEAR, false);
+  for (int i = 1; i < count; i++)
+  {
+    uint8 subtype = trip->subtype;
+    Temporal *result = temporal_append_tinstant(trip, instants[i], LINEAR,
+      0.0, maxt, true);
+    /* The sequence is not freed when it is split into a sequence set */
+    if (result->subtype != subtype)
+      free(trip);
+    trip = result;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  free(trip);
+  return (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+}
+
+/**
+ * @brief Return the minimum cost in nanoseconds per instant of building a
+ * trip from the first @p count instants over several repetitions
+ */
+static double
+cost_per_instant(TInstant **instants, int count, const Interval *maxt)
+{
+  double best = -1.0;
+  for (int i = 0; i < NO_REPETITIONS; i++)
+  {
+    double elapsed = build_trip(instants, count, maxt);
+    if (best < 0 || elapsed < best)
+      best = elapsed;
+  }
+  return best / count;
+}
+
+/* Main program */
+int main(void)
+{
+  /* Initialize MEOS */
+  meos_initialize();
+  meos_initialize_timezone("UTC");
+
+  /* Allocate space to keep the instants of the ships */
+  ship_record ships[MAX_SHIPS] = {0};
+  /* Number of ships */
+  int no_ships = 0;
+  /* Iterator variable */
+  int i;
+
+  /* Substitute the full file path in the first argument of fopen */
+  FILE *file = fopen("data/ais_instants.csv", "r");
+  if (! file)
+  {
+    printf("Error opening input file\n");
+    meos_finalize();
+    return EXIT_FAILURE;
+  }
+
+  AIS_record rec;
+  int no_records = 0;
+  char header_buffer[MAX_LENGTH_HEADER];
+  char timestamp_buffer[MAX_LENGTH_TIMESTAMP];
+
+  /* Read the first line of the file with the headers */
+  fscanf(file, "%1023s\n", header_buffer);
+
+  /* Continue reading the file */
+  do
+  {
+    int read = fscanf(file, "%31[^,],%ld,%lf,%lf,%lf\n",
+      timestamp_buffer, &rec.MMSI, &rec.Latitude, &rec.Longitude, &rec.SOG);
+    if (ferror(file))
+    {
+      printf("Error reading input file\n");
+      fclose(file);
+      meos_finalize();
+      return EXIT_FAILURE;
+    }
+    if (read != 5)
+      continue;
+    no_records++;
+
+    /* Find the ship to which the record belongs */
+    rec.T = pg_timestamp_in(timestamp_buffer, -1);
+    int ship = -1;
+    for (i = 0; i < no_ships; i++)
+    {
+      if (ships[i].MMSI == rec.MMSI)
+      {
+        ship = i;
+        break;
+      }
+    }
+    if (ship < 0)
+    {
+      if (no_ships == MAX_SHIPS)
+        continue;
+      ship = no_ships++;
+      ships[ship].MMSI = rec.MMSI;
+      ships[ship].maxinstants = INITIAL_INSTANTS;
+      ships[ship].instants = malloc(sizeof(TInstant *) * INITIAL_INSTANTS);
+    }
+    /* Ignore the observations that are not in increasing timestamp value */
+    ship_record *s = &ships[ship];
+    if (s->numinstants > 0 && s->instants[s->numinstants - 1]->t >= rec.T)
+      continue;
+    if (s->numinstants == s->maxinstants)
+    {
+      s->maxinstants *= 2;
+      s->instants = realloc(s->instants, sizeof(TInstant *) * s->maxinstants);
+    }
+    GSERIALIZED *gs = geogpoint_make2d(4326, rec.Longitude, rec.Latitude);
+    s->instants[s->numinstants++] = tpointinst_make(gs, rec.T);
+    free(gs);
+  } while (! feof(file));
+
+  /* Close the file */
+  fclose(file);
+
+  /* Select the ship with the largest number of instants */
+  int ship = 0;
+  for (i = 1; i < no_ships; i++)
+  {
+    if (ships[i].numinstants > ships[ship].numinstants)
+      ship = i;
+  }
+  printf("%d records read, %d ships\n", no_records, no_ships);
+  if (no_ships == 0 || ships[ship].numinstants < 2)
+  {
+    printf("Not enough instants for the benchmark\n");
+    meos_finalize();
+    return EXIT_FAILURE;
+  }
+  printf("MMSI: %ld, Number of instants: %d\n\n", ships[ship].MMSI,
+    ships[ship].numinstants);
+
+  /* Measure the cost per instant for prefixes of increasing size */
+  Interval *maxt = pg_interval_in("5 minutes", -1);
+  printf("%10s | %16s | %16s\n", "Instants", "Sequence ns/pt",
+    "Gap 5 min ns/pt");
+  printf("-----------+------------------+-----------------\n");
+  int count = 1000;
+  while (true)
+  {
+    if (count > ships[ship].numinstants)
+      count = ships[ship].numinstants;
+    TInstant **instants = ships[ship].instants;
+    printf("%10d | %16.1f | %16.1f\n", count,
+      cost_per_instant(instants, count, NULL),
+      cost_per_instant(instants, count, maxt));
+    if (count == ships[ship].numinstants)
+      break;
+    count *= 2;
+  }
+
+  /* Free memory */
+  free(maxt);
+  for (i = 0; i < no_ships; i++)
+  {
+    for (int j = 0; j < ships[i].numinstants; j++)
+      free(ships[i].instants[j]);
+    free(ships[i].instants);
+  }
+
+  /* Finalize MEOS */
+  meos_finalize();
+
+  /* Return */
+  return EXIT_SUCCESS;
+}
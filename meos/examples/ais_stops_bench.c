@@ -0,0 +1,254 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A benchmark that measures the cost of detecting the stops of AIS
+ * trips.
+ *
+ * The program reads the AIS records from the CSV file used in `ais_expand.c`,
+ * assembles the trips of the first ships in the file, transforms them to the
+ * SRID 25832 so that distances are expressed in meters, and then computes the
+ * stops of the trips with a minimum duration of 5 minutes and several values
+ * of the maximum distance. For each value the program outputs the number of
+ * stops found and the average cost in nanoseconds per instant of the trips.
+ * Since the extent of the moving window is maintained incrementally, most of
+ * the windows are decided without computing their minimum rotated rectangle
+ * and the cost per instant does not depend on the length of the stops.
+ *
+ * Please read the assumptions made about the input file in the file
+ * `02_ais_read.c` in the same directory.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -O2 -I/usr/local/include -o ais_stops_bench ais_stops_bench.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <meos.h>
+#include <meos_geo.h>
+
+/* Maximum length in characters of a header record in the input CSV file */
+#define MAX_LENGTH_HEADER 1024
+/* Maximum length in characters of a timestamp in the input data */
+#define MAX_LENGTH_TIMESTAMP 32
+/* Maximum number of ships */
+#define MAX_SHIPS 5
+/* Initial number of instants per ship */
+#define INITIAL_INSTANTS 1024
+/* Number of repetitions of each measure */
+#define NO_REPETITIONS 3
+/* Number of values of the maximum distance */
+#define NO_MAXDIST 4
+
+typedef struct
+{
+  Timestamp T;
+  long int MMSI;
+  double Latitude;
+  double Longitude;
+  double SOG;
+} AIS_record;
+
+typedef struct
+{
+  long int MMSI;       /* Identifier of the ship */
+  int numinstants;     /* Number of instants */
+  int maxinstants;     /* Size of the array of instants */
+  TInstant **instants; /* Instants of the ship */
+  Temporal *trip;      /* Trip of the ship in SRID 25832 */
+} ship_record;
+
+/**
+ * @brief Compute the stops of the trips and return the elapsed time in
+ * nanoseconds
+ */
+static double
+compute_stops(ship_record *ships, int no_ships, double maxdist,
+  const Interval *minduration, int *no_stops)
+{
+  struct timespec start, end;
+  *no_stops = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (int i = 0; i < no_ships; i++)
+  {
+    TSequenceSet *stops = temporal_stops(ships[i].trip, maxdist, minduration);
+    if (stops)
+    {
+      *no_stops += temporal_num_sequences((Temporal *) stops);
+      free(stops);
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+}
+
+/* Main program */
+int main(void)
+{
+  /* Initialize MEOS */
+  meos_initialize();
+  meos_initialize_timezone("UTC");
+
+  /* Allocate space to keep the instants of the ships */
+  ship_record ships[MAX_SHIPS] = {0};
+  /* Number of ships */
+  int no_ships = 0;
+  /* Iterator variable */
+  int i;
+
+  /* Substitute the full file path in the first argument of fopen */
+  FILE *file = fopen("data/ais_instants.csv", "r");
+  if (! file)
+  {
+    printf("Error opening input file\n");
+    meos_finalize();
+    return EXIT_FAILURE;
+  }
+
+  AIS_record rec;
+  int no_records = 0;
+  char header_buffer[MAX_LENGTH_HEADER];
+  char timestamp_buffer[MAX_LENGTH_TIMESTAMP];
+
+  /* Read the first line of the file with the headers */
+  fscanf(file, "%1023s\n", header_buffer);
+
+  /* Continue reading the file */
+  do
+  {
+    int read = fscanf(file, "%31[^,],%ld,%lf,%lf,%lf\n",
+      timestamp_buffer, &rec.MMSI, &rec.Latitude, &rec.Longitude, &rec.SOG);
+    if (ferror(file))
+    {
+      printf("Error reading input file\n");
+      fclose(file);
+      meos_finalize();
+      return EXIT_FAILURE;
+    }
+    if (read != 5)
+      continue;
+    no_records++;
+
+    /* Find the ship to which the record belongs */
+    rec.T = pg_timestamp_in(timestamp_buffer, -1);
+    int ship = -1;
+    for (i = 0; i < no_ships; i++)
+    {
+      if (ships[i].MMSI == rec.MMSI)
+      {
+        ship = i;
+        break;
+      }
+    }
+    if (ship < 0)
+    {
+      if (no_ships == MAX_SHIPS)
+        continue;
+      ship = no_ships++;
+      ships[ship].MMSI = rec.MMSI;
+      ships[ship].maxinstants = INITIAL_INSTANTS;
+      ships[ship].instants = malloc(sizeof(TInstant *) * INITIAL_INSTANTS);
+    }
+    /* Ignore the observations that are not in increasing timestamp value */
+    ship_record *s = &ships[ship];
+    if (s->numinstants > 0 && s->instants[s->numinstants - 1]->t >= rec.T)
+      continue;
+    if (s->numinstants == s->maxinstants)
+    {
+      s->maxinstants *= 2;
+      s->instants = realloc(s->instants, sizeof(TInstant *) * s->maxinstants);
+    }
+    GSERIALIZED *gs = geompoint_make2d(4326, rec.Longitude, rec.Latitude);
+    s->instants[s->numinstants++] = tpointinst_make(gs, rec.T);
+    free(gs);
+  } while (! feof(file));
+
+  /* Close the file */
+  fclose(file);
+
+  /* Assemble the trips and transform them to SRID 25832 */
+  int no_instants = 0;
+  for (i = 0; i < no_ships; i++)
+  {
+    Temporal *trip = (Temporal *) tsequence_make(
+      (const TInstant **) ships[i].instants, ships[i].numinstants, true, true,
+      LINEAR, true);
+    ships[i].trip = tspatial_transform(trip, 25832);
+    free(trip);
+    no_instants += ships[i].numinstants;
+  }
+  printf("%d records read, %d ships, %d instants\n\n", no_records, no_ships,
+    no_instants);
+  if (no_instants == 0)
+  {
+    printf("Not enough instants for the benchmark\n");
+    meos_finalize();
+    return EXIT_FAILURE;
+  }
+
+  /* Measure the cost per instant for several maximum distances */
+  Interval *minduration = pg_interval_in("5 minutes", -1);
+  double maxdist[NO_MAXDIST] = {10.0, 50.0, 100.0, 500.0};
+  printf("%12s | %10s | %12s\n", "Max distance", "Stops", "ns/instant");
+  printf("-------------+------------+-------------\n");
+  for (i = 0; i < NO_MAXDIST; i++)
+  {
+    double best = -1.0;
+    int no_stops = 0;
+    for (int j = 0; j < NO_REPETITIONS; j++)
+    {
+      double elapsed = compute_stops(ships, no_ships, maxdist[i], minduration,
+        &no_stops);
+      if (best < 0 || elapsed < best)
+        best = elapsed;
+    }
+    printf("%12.1f | %10d | %12.1f\n", maxdist[i], no_stops,
+      best / no_instants);
+  }
+
+  /* Free memory */
+  free(minduration);
+  for (i = 0; i < no_ships; i++)
+  {
+    for (int j = 0; j < ships[i].numinstants; j++)
+      free(ships[i].instants[j]);
+    free(ships[i].instants);
+    free(ships[i].trip);
+  }
+
+  /* Finalize MEOS */
+  meos_finalize();
+
+  /* Return */
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,224 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A benchmark that compares the input and output of long temporal
+ * points in MF-JSON representation using json-c with the incremental parser
+ * and the chunked writer.
+ *
+ * The program generates random walks that are output with the functions
+ * `temporal_as_mfjson()` and `temporal_as_mfjson_stream()`, and read back with
+ * the functions `temporal_from_mfjson()` and `mfjson_parser_feed()`, where the
+ * input is fed to the incremental parser in chunks of `CHUNK_SIZE` characters
+ * as if it were read from a file or a socket. The program outputs the
+ * throughput of each method in MB per second and verifies that both methods
+ * produce the same results.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -O3 -I/usr/local/include -o mfjson_bench mfjson_bench.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal.h>
+
+/* Number of trips */
+#define NO_TRIPS 20
+/* Number of instants per trip */
+#define NO_INSTANTS 10000
+/* Time between two instants of a trip in seconds */
+#define SAMPLING_INTERVAL 5
+/* Maximum speed of a trip in meters per second */
+#define MAX_SPEED 15
+/* Number of characters of the chunks read and written */
+#define CHUNK_SIZE 4096
+/* Number of decimal digits of the coordinates */
+#define PRECISION 6
+/* SRID of the trips */
+#define SRID 3857
+
+/* State of the chunked writer */
+typedef struct
+{
+  char *buf;
+  size_t len;
+  size_t nchunks;
+} write_state;
+
+/* Return the current time in seconds */
+static double
+get_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* Function receiving the chunks of the writer, which are concatenated */
+static bool
+write_chunk(const char *chunk, size_t len, void *arg)
+{
+  write_state *state = (write_state *) arg;
+  memcpy(state->buf + state->len, chunk, len);
+  state->len += len;
+  state->nchunks++;
+  return true;
+}
+
+/* Return a random walk */
+static Temporal *
+random_trip(TimestampTz t0)
+{
+  TInstant **instants = malloc(sizeof(TInstant *) * NO_INSTANTS);
+  double x = 485000.0 + 10000.0 * rand() / RAND_MAX;
+  double y = 6590000.0 + 10000.0 * rand() / RAND_MAX;
+  double heading = 2 * M_PI * rand() / RAND_MAX;
+  for (int i = 0; i < NO_INSTANTS; i++)
+  {
+    GSERIALIZED *gs = geompoint_make2d(SRID, x, y);
+    instants[i] = tpointinst_make(gs,
+      t0 + (TimestampTz) i * SAMPLING_INTERVAL * 1000000);
+    free(gs);
+    heading += (double) rand() / RAND_MAX - 0.5;
+    double dist = (double) SAMPLING_INTERVAL * MAX_SPEED * rand() / RAND_MAX;
+    x += dist * cos(heading);
+    y += dist * sin(heading);
+  }
+  Temporal *result = (Temporal *) tsequence_make((const TInstant **) instants,
+    NO_INSTANTS, true, true, LINEAR, true);
+  for (int i = 0; i < NO_INSTANTS; i++)
+    free(instants[i]);
+  free(instants);
+  return result;
+}
+
+/* Main program */
+int
+main(void)
+{
+  /* Initialize MEOS */
+  meos_initialize();
+  meos_initialize_timezone("UTC");
+
+  /* Generate the trips */
+  srand(1);
+  TimestampTz t0 = pg_timestamptz_in("2025-01-01", -1);
+  Temporal *trips[NO_TRIPS];
+  char *mfjson[NO_TRIPS];
+  for (int i = 0; i < NO_TRIPS; i++)
+    trips[i] = random_trip(t0);
+  printf("%d trips of %d instants generated\n", NO_TRIPS, NO_INSTANTS);
+
+  /* Output the trips with json-c */
+  size_t size = 0;
+  double start = get_time();
+  for (int i = 0; i < NO_TRIPS; i++)
+  {
+    mfjson[i] = temporal_as_mfjson(trips[i], true, 0, PRECISION, "EPSG:3857");
+    size += strlen(mfjson[i]);
+  }
+  double time = get_time() - start;
+  double mb = (double) size / (1024 * 1024);
+  printf("temporal_as_mfjson:        %.1f MB in %.3f s (%.1f MB/s)\n", mb,
+    time, mb / time);
+
+  /* Output the trips with the chunked writer */
+  int nequal = 0;
+  write_state state;
+  state.buf = malloc(strlen(mfjson[0]) * 2);
+  state.nchunks = 0;
+  start = get_time();
+  for (int i = 0; i < NO_TRIPS; i++)
+  {
+    state.len = 0;
+    temporal_as_mfjson_stream(trips[i], true, PRECISION, "EPSG:3857",
+      CHUNK_SIZE, &write_chunk, &state);
+    if (state.len == strlen(mfjson[i]) &&
+        memcmp(state.buf, mfjson[i], state.len) == 0)
+      nequal++;
+  }
+  time = get_time() - start;
+  printf("temporal_as_mfjson_stream: %.1f MB in %.3f s (%.1f MB/s), "
+    "%zu chunks\n", mb, time, mb / time, state.nchunks);
+  printf("Result: %d of %d outputs identical\n", nequal, NO_TRIPS);
+  free(state.buf);
+
+  /* Input the trips with json-c */
+  Temporal *res1[NO_TRIPS];
+  start = get_time();
+  for (int i = 0; i < NO_TRIPS; i++)
+    res1[i] = tgeompoint_from_mfjson(mfjson[i]);
+  time = get_time() - start;
+  printf("temporal_from_mfjson:      %.1f MB in %.3f s (%.1f MB/s)\n", mb,
+    time, mb / time);
+
+  /* Input the trips with the incremental parser fed in chunks */
+  Temporal *res2[NO_TRIPS];
+  start = get_time();
+  for (int i = 0; i < NO_TRIPS; i++)
+  {
+    MfjsonParser *parser = mfjson_parser_make(T_TGEOMPOINT);
+    size_t len = strlen(mfjson[i]);
+    for (size_t pos = 0; pos < len; pos += CHUNK_SIZE)
+      mfjson_parser_feed(parser, mfjson[i] + pos,
+        len - pos < CHUNK_SIZE ? len - pos : CHUNK_SIZE);
+    res2[i] = mfjson_parser_end(parser);
+  }
+  time = get_time() - start;
+  printf("mfjson_parser_feed:        %.1f MB in %.3f s (%.1f MB/s)\n", mb,
+    time, mb / time);
+
+  nequal = 0;
+  for (int i = 0; i < NO_TRIPS; i++)
+  {
+    if (res1[i] && res2[i] && temporal_eq(res1[i], res2[i]))
+      nequal++;
+    free(res1[i]); free(res2[i]);
+  }
+  printf("Result: %d of %d inputs identical\n", nequal, NO_TRIPS);
+
+  /* Clean up */
+  for (int i = 0; i < NO_TRIPS; i++)
+  {
+    free(trips[i]);
+    free(mfjson[i]);
+  }
+
+  /* Finalize MEOS */
+  meos_finalize();
+  return EXIT_SUCCESS;
+}
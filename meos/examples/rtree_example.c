@@ -181,7 +181,7 @@ int main()
 #endif /* BBOX_TYPE */
 
   t = clock();
-  int *ids = rtree_search(rtree, box, &count);
+  int64 *ids = rtree_search(rtree, box, &count);
   t = clock() - t;
   time_taken = ((double) t) / CLOCKS_PER_SEC; // in seconds 
   printf("Index lookup took %f seconds to execute \n", time_taken);
@@ -0,0 +1,154 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A benchmark that compares the query throughput of an RTree index of
+ * spatiotemporal boxes with the default node layout and with the flat
+ * structure-of-arrays layout.
+ *
+ * The program generates one million random spatiotemporal boxes, loads them
+ * in bulk into two RTrees, one created with `rtree_create_stbox()` and the
+ * other with `rtree_create_stbox_flat()`, and then runs the same window
+ * queries on both trees. For each layout the program outputs the loading
+ * time, the number of queries per second, and the total number of hits,
+ * which must be equal for both layouts.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -O3 -march=native -I/usr/local/include -o rtree_flat_bench rtree_flat_bench.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal.h>
+#include <meos_internal_geo.h>
+
+/* Number of boxes to index */
+#define NO_BOXES 1000000
+/* Number of queries */
+#define NO_QUERIES 10000
+/* Extent of the space in both axes */
+#define SPACE_SIZE 100000
+/* Maximum size of a box in both axes */
+#define MAX_BOX_SIZE 50
+/* Size of the side of a query window */
+#define QUERY_SIZE 1000
+/* Extent of the time dimension in seconds */
+#define TIME_SIZE 864000
+/* Maximum duration of a box in seconds */
+#define MAX_BOX_DURATION 3600
+/* Duration of a query window in seconds */
+#define QUERY_DURATION 86400
+
+/* Return the current time in seconds */
+static double
+get_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* Set a random spatiotemporal box */
+static void
+random_stbox(TimestampTz t0, double size, int duration, STBox *box)
+{
+  double x = rand() % SPACE_SIZE, y = rand() % SPACE_SIZE;
+  TimestampTz t = t0 + (TimestampTz) (rand() % TIME_SIZE) * 1000000;
+  Span period;
+  span_set(TimestampTzGetDatum(t),
+    TimestampTzGetDatum(t + (TimestampTz) duration * 1000000), true, true,
+    T_TIMESTAMPTZ, T_TSTZSPAN, &period);
+  stbox_set(true, false, false, 0, x, x + size, y, y + size, 0, 0, &period,
+    box);
+  return;
+}
+
+/* Load the boxes into an RTree and run the queries */
+static void
+run_bench(RTree *rtree, const char *name, const STBox *boxes,
+  const STBox *queries)
+{
+  double start = get_time();
+  rtree_bulk_load(rtree, boxes, NULL, NO_BOXES);
+  double load_time = get_time() - start;
+
+  long hits = 0;
+  start = get_time();
+  for (int i = 0; i < NO_QUERIES; i++)
+  {
+    int count;
+    int64 *ids = rtree_search(rtree, &queries[i], &count);
+    hits += count;
+    free(ids);
+  }
+  double query_time = get_time() - start;
+  printf("%-8s load: %.3f s, queries: %.0f per second, hits: %ld\n", name,
+    load_time, NO_QUERIES / query_time, hits);
+  return;
+}
+
+/* Main program */
+int
+main(void)
+{
+  /* Initialize MEOS */
+  meos_initialize();
+
+  srand(1);
+  TimestampTz t0 = pg_timestamp_in("2025-01-01", -1);
+  STBox *boxes = malloc(sizeof(STBox) * NO_BOXES);
+  STBox *queries = malloc(sizeof(STBox) * NO_QUERIES);
+  for (int i = 0; i < NO_BOXES; i++)
+    random_stbox(t0, rand() % MAX_BOX_SIZE, rand() % MAX_BOX_DURATION,
+      &boxes[i]);
+  for (int i = 0; i < NO_QUERIES; i++)
+    random_stbox(t0, QUERY_SIZE, QUERY_DURATION, &queries[i]);
+  printf("%d boxes, %d queries\n", NO_BOXES, NO_QUERIES);
+
+  RTree *rtree = rtree_create_stbox();
+  run_bench(rtree, "default", boxes, queries);
+  rtree_free(rtree);
+
+  rtree = rtree_create_stbox_flat();
+  run_bench(rtree, "flat", boxes, queries);
+  rtree_free(rtree);
+
+  /* Clean up */
+  free(boxes); free(queries);
+
+  /* Finalize MEOS */
+  meos_finalize();
+  return 0;
+}
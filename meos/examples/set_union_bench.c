@@ -0,0 +1,114 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A benchmark that measures the set union aggregate of many values
+ * with few distinct ones, such as vessel identifiers or route names.
+ *
+ * The program aggregates random big integers and texts taken from a given
+ * number of distinct values with the functions `bigint_union_transfn()`,
+ * `text_union_transfn()`, and `set_union_finalfn()`. It outputs the time
+ * taken, the number of values of the result, and the maximum number of
+ * values of the aggregate state, which shows the memory used by the state.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -O3 -I/usr/local/include -o set_union_bench set_union_bench.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <meos.h>
+
+/* Number of big integers aggregated */
+#define NO_BIGINTS 10000000
+/* Number of texts aggregated */
+#define NO_TEXTS 1000000
+/* Number of numbers of distinct values */
+#define NO_DISTINCT 3
+
+/* Numbers of distinct values */
+static const int distinct[NO_DISTINCT] = {100, 5000, 100000};
+
+/* Return the current time in seconds */
+static double
+get_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* Main program */
+int
+main(void)
+{
+  /* Initialize MEOS */
+  meos_initialize();
+
+  srand(1);
+  for (int i = 0; i < NO_DISTINCT; i++)
+  {
+    /* Aggregate the big integers */
+    double start = get_time();
+    Set *state = NULL;
+    for (int j = 0; j < NO_BIGINTS; j++)
+      state = bigint_union_transfn(state,
+        (int64) (rand() % distinct[i]) * 1000003);
+    Set *result = set_union_finalfn(state);
+    printf("%8d bigint values of %6d distinct ones: %.3f s, %d values, "
+      "state of %d values\n", NO_BIGINTS, distinct[i], get_time() - start,
+      set_num_values(result), state->maxcount);
+    free(state); free(result);
+
+    /* Aggregate the texts */
+    start = get_time();
+    state = NULL;
+    for (int j = 0; j < NO_TEXTS; j++)
+    {
+      char buf[32];
+      snprintf(buf, sizeof(buf), "Route %06d", rand() % distinct[i]);
+      text *txt = cstring2text(buf);
+      state = text_union_transfn(state, txt);
+      free(txt);
+    }
+    result = set_union_finalfn(state);
+    printf("%8d text values of %6d distinct ones:   %.3f s, %d values, "
+      "state of %d values\n", NO_TEXTS, distinct[i], get_time() - start,
+      set_num_values(result), state->maxcount);
+    free(state); free(result);
+  }
+
+  /* Finalize MEOS */
+  meos_finalize();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,264 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief A benchmark that compares the size and the decoding time of the
+ * Well-Known Binary (WKB) and of the compressed binary representations of
+ * temporal values.
+ *
+ * The program generates trips similar to those of the AIS and BerlinMOD
+ * datasets. The AIS trips are ships whose positions are expressed in degrees
+ * rounded to the precision of the AIS messages and are received at irregular
+ * intervals of whole seconds. The BerlinMOD trips are cars whose positions
+ * are expressed in meters and are sampled every two seconds, with stops where
+ * the position does not change, together with the speed of the cars as a
+ * temporal float. The program outputs for each dataset the size of the
+ * values in memory, in WKB, and in the compressed representation, the number
+ * of values decoded per second from each representation, and the number of
+ * bounding boxes per second read from the header of the compressed
+ * representation, and verifies that the decoded values are equal to the
+ * original ones.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -O3 -I/usr/local/include -o temporal_compress_bench temporal_compress_bench.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal.h>
+
+/* Number of trips of each dataset */
+#define NO_TRIPS 100
+/* Number of instants per trip */
+#define NO_INSTANTS 5000
+/* Number of times each value is decoded */
+#define NO_RUNS 5
+
+/* Return the current time in seconds */
+static double
+get_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* Return a random number between 0 and 1 */
+static double
+rand01(void)
+{
+  return (double) rand() / RAND_MAX;
+}
+
+/* Return a ship trip with positions in degrees at irregular intervals */
+static Temporal *
+ais_trip(TimestampTz t0)
+{
+  TInstant **instants = malloc(sizeof(TInstant *) * NO_INSTANTS);
+  double lon = 10.0 + 2.0 * rand01(), lat = 55.0 + 2.0 * rand01();
+  double heading = 2 * M_PI * rand01(), speed = 2.0 + 8.0 * rand01();
+  TimestampTz t = t0;
+  for (int i = 0; i < NO_INSTANTS; i++)
+  {
+    /* AIS positions have a precision of 1/10000 minute */
+    GSERIALIZED *gs = geompoint_make2d(4326, round(lon * 600000) / 600000,
+      round(lat * 600000) / 600000);
+    instants[i] = tpointinst_make(gs, t);
+    free(gs);
+    int interval = 2 + rand() % 9;
+    t += (TimestampTz) interval * 1000000;
+    heading += 0.1 * (rand01() - 0.5);
+    /* Convert the distance in meters to degrees */
+    double dist = speed * interval / 111320.0;
+    lon += dist * cos(heading) / cos(lat * M_PI / 180.0);
+    lat += dist * sin(heading);
+  }
+  Temporal *result = (Temporal *) tsequence_make((const TInstant **) instants,
+    NO_INSTANTS, true, true, LINEAR, true);
+  for (int i = 0; i < NO_INSTANTS; i++)
+    free(instants[i]);
+  free(instants);
+  return result;
+}
+
+/* Return a car trip with positions in meters sampled every two seconds
+ * together with its speed */
+static Temporal *
+berlinmod_trip(TimestampTz t0, Temporal **speed)
+{
+  TInstant **instants = malloc(sizeof(TInstant *) * NO_INSTANTS);
+  TInstant **speeds = malloc(sizeof(TInstant *) * NO_INSTANTS);
+  double x = 1480000.0 + 20000.0 * rand01();
+  double y = 6880000.0 + 20000.0 * rand01();
+  double heading = 2 * M_PI * rand01(), v = 0.0;
+  int stop = 0;
+  for (int i = 0; i < NO_INSTANTS; i++)
+  {
+    TimestampTz t = t0 + (TimestampTz) i * 2000000;
+    GSERIALIZED *gs = geompoint_make2d(3857, x, y);
+    instants[i] = tpointinst_make(gs, t);
+    free(gs);
+    /* Stop from time to time, e.g., at traffic lights */
+    if (stop > 0)
+    {
+      stop--;
+      v = 0.0;
+    }
+    else if (rand() % 50 == 0)
+      stop = 5 + rand() % 20;
+    else
+      v = fmin(fmax(v + 2.0 * (rand01() - 0.4), 0.0), 20.0);
+    speeds[i] = tinstant_make(Float8GetDatum(v), T_TFLOAT, t);
+    if (rand() % 20 == 0)
+      heading += M_PI / 2 * (rand() % 2 ? 1 : -1);
+    x += 2.0 * v * cos(heading);
+    y += 2.0 * v * sin(heading);
+  }
+  Temporal *result = (Temporal *) tsequence_make((const TInstant **) instants,
+    NO_INSTANTS, true, true, LINEAR, false);
+  *speed = (Temporal *) tsequence_make((const TInstant **) speeds,
+    NO_INSTANTS, true, true, LINEAR, false);
+  for (int i = 0; i < NO_INSTANTS; i++)
+  {
+    free(instants[i]);
+    free(speeds[i]);
+  }
+  free(instants);
+  free(speeds);
+  return result;
+}
+
+/* Compare the representations of a dataset */
+static void
+compare(const char *name, Temporal **trips)
+{
+  uint8_t *wkb[NO_TRIPS], *comp[NO_TRIPS];
+  size_t wkb_size[NO_TRIPS], comp_size[NO_TRIPS];
+  size_t mem = 0, wkb_total = 0, comp_total = 0;
+  for (int i = 0; i < NO_TRIPS; i++)
+  {
+    mem += VARSIZE(trips[i]);
+    wkb[i] = temporal_as_wkb(trips[i], WKB_EXTENDED, &wkb_size[i]);
+    wkb_total += wkb_size[i];
+    comp[i] = temporal_as_compressed(trips[i], &comp_size[i]);
+    comp_total += comp_size[i];
+  }
+  printf("%s\n", name);
+  printf("  Size: memory %.2f MB, WKB %.2f MB, compressed %.2f MB "
+    "(%.1f%% of WKB)\n", mem / 1048576.0, wkb_total / 1048576.0,
+    comp_total / 1048576.0, 100.0 * comp_total / wkb_total);
+
+  /* Decode the values from WKB */
+  double start = get_time();
+  for (int r = 0; r < NO_RUNS; r++)
+    for (int i = 0; i < NO_TRIPS; i++)
+      free(temporal_from_wkb(wkb[i], wkb_size[i]));
+  double time = get_time() - start;
+  printf("  temporal_from_wkb:            %.0f values per second\n",
+    NO_RUNS * NO_TRIPS / time);
+
+  /* Decode the values from the compressed representation */
+  start = get_time();
+  for (int r = 0; r < NO_RUNS; r++)
+    for (int i = 0; i < NO_TRIPS; i++)
+      free(temporal_from_compressed(comp[i], comp_size[i]));
+  time = get_time() - start;
+  printf("  temporal_from_compressed:     %.0f values per second\n",
+    NO_RUNS * NO_TRIPS / time);
+
+  /* Read the bounding boxes from the header of the compressed values */
+  STBox box[2];
+  meosType temptype;
+  start = get_time();
+  for (int r = 0; r < NO_RUNS * 1000; r++)
+    for (int i = 0; i < NO_TRIPS; i++)
+      temporal_compressed_set_bbox(comp[i], comp_size[i], &temptype, box);
+  time = get_time() - start;
+  printf("  temporal_compressed_set_bbox: %.0f values per second\n",
+    NO_RUNS * 1000 * NO_TRIPS / time);
+
+  /* Verify the results */
+  int nequal = 0;
+  for (int i = 0; i < NO_TRIPS; i++)
+  {
+    Temporal *temp = temporal_from_compressed(comp[i], comp_size[i]);
+    if (temp && temporal_eq(temp, trips[i]))
+      nequal++;
+    free(temp); free(wkb[i]); free(comp[i]);
+  }
+  printf("  Result: %d of %d values identical\n", nequal, NO_TRIPS);
+  return;
+}
+
+/* Main program */
+int
+main(void)
+{
+  /* Initialize MEOS */
+  meos_initialize();
+  meos_initialize_timezone("UTC");
+
+  /* Generate the trips */
+  srand(1);
+  TimestampTz t0 = pg_timestamptz_in("2025-01-01", -1);
+  Temporal *ais[NO_TRIPS], *berlinmod[NO_TRIPS], *speeds[NO_TRIPS];
+  for (int i = 0; i < NO_TRIPS; i++)
+  {
+    ais[i] = ais_trip(t0);
+    berlinmod[i] = berlinmod_trip(t0, &speeds[i]);
+  }
+  printf("%d trips of %d instants generated for each dataset\n", NO_TRIPS,
+    NO_INSTANTS);
+
+  /* Compare the representations */
+  compare("AIS trips (tgeompoint)", ais);
+  compare("BerlinMOD trips (tgeompoint)", berlinmod);
+  compare("BerlinMOD speeds (tfloat)", speeds);
+
+  /* Clean up */
+  for (int i = 0; i < NO_TRIPS; i++)
+  {
+    free(ais[i]);
+    free(berlinmod[i]);
+    free(speeds[i]);
+  }
+
+  /* Finalize MEOS */
+  meos_finalize();
+  return EXIT_SUCCESS;
+}
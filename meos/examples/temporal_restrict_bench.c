@@ -0,0 +1,233 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A benchmark that measures the time taken to restrict long temporal
+ * floats to timestamp sets and span sets of increasing size.
+ *
+ * The program generates a temporal sequence and a temporal sequence set
+ * with the same number of instants, which are restricted with the functions
+ * `temporal_at_tstzset()`, `temporal_minus_tstzset()`,
+ * `temporal_at_tstzspanset()`, and `temporal_minus_tstzspanset()` to random
+ * timestamp sets and span sets spread over their time span. The program
+ * outputs the time of each restriction in milliseconds together with the
+ * total number of instants of the results, which can be used to verify that
+ * two versions of the library compute the same results.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -O3 -I/usr/local/include -o temporal_restrict_bench temporal_restrict_bench.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <meos.h>
+
+/* Number of instants of the temporal values */
+#define NO_INSTANTS 100000
+/* Number of composing sequences of the temporal sequence set */
+#define NO_SEQUENCES 1000
+/* Time between two instants in seconds */
+#define SAMPLING_INTERVAL 5
+/* Number of sizes of the timestamp sets and span sets */
+#define NO_SIZES 5
+/* Number of repetitions of each restriction */
+#define NO_REPETITIONS 5
+
+/* Sizes of the timestamp sets and span sets */
+static const int sizes[NO_SIZES] = {10, 100, 1000, 10000, 100000};
+
+/* Return the current time in seconds */
+static double
+get_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* Return a random temporal float with a gap between every nseqs instants */
+static Temporal *
+random_tfloat(TimestampTz t0, int nseqs)
+{
+  int count = NO_INSTANTS / nseqs;
+  TInstant **instants = malloc(sizeof(TInstant *) * count);
+  TSequence **sequences = malloc(sizeof(TSequence *) * nseqs);
+  double value = 0.0;
+  TimestampTz t = t0;
+  for (int i = 0; i < nseqs; i++)
+  {
+    for (int j = 0; j < count; j++)
+    {
+      value += (double) rand() / RAND_MAX - 0.5;
+      instants[j] = tfloatinst_make(value, t);
+      t += (TimestampTz) SAMPLING_INTERVAL * 1000000;
+    }
+    sequences[i] = tsequence_make((const TInstant **) instants, count, true,
+      true, LINEAR, false);
+    for (int j = 0; j < count; j++)
+      free(instants[j]);
+    /* Leave a gap of one sampling interval between the sequences */
+    t += (TimestampTz) SAMPLING_INTERVAL * 1000000;
+  }
+  Temporal *result = (nseqs == 1) ? (Temporal *) sequences[0] :
+    (Temporal *) tsequenceset_make((const TSequence **) sequences, nseqs,
+      false);
+  if (nseqs > 1)
+  {
+    for (int i = 0; i < nseqs; i++)
+      free(sequences[i]);
+  }
+  free(sequences); free(instants);
+  return result;
+}
+
+/* Return a random timestamp set with the given number of values */
+static Set *
+random_tstzset(TimestampTz t0, TimestampTz t1, int count)
+{
+  TimestampTz *times = malloc(sizeof(TimestampTz) * count);
+  double step = (double) (t1 - t0) / count;
+  for (int i = 0; i < count; i++)
+    times[i] = t0 + (TimestampTz) (step * (i + (double) rand() / RAND_MAX));
+  Set *result = tstzset_make(times, count);
+  free(times);
+  return result;
+}
+
+/* Return a random span set with the given number of spans */
+static SpanSet *
+random_tstzspanset(TimestampTz t0, TimestampTz t1, int count)
+{
+  Span *spans = malloc(sizeof(Span) * count);
+  double step = (double) (t1 - t0) / count;
+  for (int i = 0; i < count; i++)
+  {
+    TimestampTz lower = t0 + (TimestampTz) (step * i);
+    TimestampTz upper = lower +
+      (TimestampTz) (step * 0.9 * rand() / RAND_MAX) + 1;
+    Span *s = tstzspan_make(lower, upper, true, false);
+    spans[i] = *s;
+    free(s);
+  }
+  SpanSet *result = spanset_make(spans, count);
+  free(spans);
+  return result;
+}
+
+/* Restrict a temporal value and output the time and the number of instants
+ * of the result */
+static void
+bench(const char *name, const Temporal *temp, const void *arg, int size,
+  Temporal *(*func)(const Temporal *, const void *))
+{
+  long ninsts = 0;
+  double start = get_time();
+  for (int i = 0; i < NO_REPETITIONS; i++)
+  {
+    Temporal *res = func(temp, arg);
+    if (res)
+    {
+      ninsts += temporal_num_instants(res);
+      free(res);
+    }
+  }
+  double time = (get_time() - start) * 1000 / NO_REPETITIONS;
+  printf("  %-11s %6d: %10.3f ms, %ld instants\n", name, size, time,
+    ninsts / NO_REPETITIONS);
+}
+
+static Temporal *
+at_tstzset(const Temporal *temp, const void *arg)
+{
+  return temporal_at_tstzset(temp, (const Set *) arg);
+}
+
+static Temporal *
+minus_tstzset(const Temporal *temp, const void *arg)
+{
+  return temporal_minus_tstzset(temp, (const Set *) arg);
+}
+
+static Temporal *
+at_tstzspanset(const Temporal *temp, const void *arg)
+{
+  return temporal_at_tstzspanset(temp, (const SpanSet *) arg);
+}
+
+static Temporal *
+minus_tstzspanset(const Temporal *temp, const void *arg)
+{
+  return temporal_minus_tstzspanset(temp, (const SpanSet *) arg);
+}
+
+/* Main program */
+int
+main(void)
+{
+  /* Initialize MEOS */
+  meos_initialize();
+  meos_initialize_timezone("UTC");
+
+  /* Generate the temporal values */
+  srand(1);
+  TimestampTz t0 = pg_timestamptz_in("2025-01-01", -1);
+  Temporal *temps[2];
+  temps[0] = random_tfloat(t0, 1);
+  temps[1] = random_tfloat(t0, NO_SEQUENCES);
+  printf("Temporal sequence and sequence set of %d sequences with %d "
+    "instants generated\n", NO_SEQUENCES, NO_INSTANTS);
+
+  for (int i = 0; i < 2; i++)
+  {
+    printf("%s\n", i == 0 ? "Sequence" : "Sequence set");
+    TimestampTz t1 = temporal_end_timestamptz(temps[i]);
+    for (int j = 0; j < NO_SIZES; j++)
+    {
+      Set *s = random_tstzset(t0, t1, sizes[j]);
+      bench("at set", temps[i], s, sizes[j], &at_tstzset);
+      bench("minus set", temps[i], s, sizes[j], &minus_tstzset);
+      free(s);
+      SpanSet *ss = random_tstzspanset(t0, t1, sizes[j]);
+      bench("at spans", temps[i], ss, sizes[j], &at_tstzspanset);
+      bench("minus spans", temps[i], ss, sizes[j], &minus_tstzspanset);
+      free(ss);
+    }
+  }
+
+  /* Clean up */
+  free(temps[0]); free(temps[1]);
+
+  /* Finalize MEOS */
+  meos_finalize();
+  return EXIT_SUCCESS;
+}
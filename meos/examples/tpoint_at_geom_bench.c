@@ -0,0 +1,230 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A benchmark that measures the time taken to restrict long trips in
+ * Brussels to each of the 19 communes composing the region.
+ *
+ * The program reads the geometries of the communes from the file
+ * `data/brussels_communes.csv` and generates random walks inside the
+ * bounding box of the region, which are restricted to every commune with the
+ * function `tpoint_at_geom()`. Since each trip is long with respect to the
+ * size of a commune, most of its segments are far from the commune to which
+ * it is restricted. The program outputs the number of restrictions per
+ * second together with the number of sequences and the total length of the
+ * results, which can be used to verify that two versions of the library
+ * compute the same results.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -O3 -I/usr/local/include -o tpoint_at_geom_bench tpoint_at_geom_bench.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <meos.h>
+#include <meos_geo.h>
+
+/* Number of communes */
+#define NO_COMMUNES 19
+/* Number of trips */
+#define NO_TRIPS 50
+/* Number of instants per trip */
+#define NO_INSTANTS 5000
+/* Time between two instants of a trip in seconds */
+#define SAMPLING_INTERVAL 5
+/* Maximum speed of a trip in meters per second */
+#define MAX_SPEED 15
+/* Maximum length in characters of a geometry in the input data */
+#define MAX_LENGTH_GEOM 100001
+/* Maximum length in characters of a header record in the input CSV file */
+#define MAX_LENGTH_HEADER 1024
+/* Maximum length in characters of a name in the input data */
+#define MAX_LENGTH_NAME 101
+/* SRID of the input data */
+#define SRID 3857
+
+GSERIALIZED *communes[NO_COMMUNES];
+char geo_buffer[MAX_LENGTH_GEOM];
+char header_buffer[MAX_LENGTH_HEADER];
+char name_buffer[MAX_LENGTH_NAME];
+
+/* Return the current time in seconds */
+static double
+get_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* Read the communes from the file */
+static int
+read_communes(void)
+{
+  /* You may substitute the full file path in the first argument of fopen */
+  FILE *file = fopen("data/brussels_communes.csv", "r");
+  if (! file)
+  {
+    printf("Error opening input file 'brussels_communes.csv'\n");
+    return EXIT_FAILURE;
+  }
+
+  /* Read the first line of the file with the headers */
+  fscanf(file, "%1023s\n", header_buffer);
+
+  int no_records = 0;
+  while (no_records < NO_COMMUNES && ! feof(file))
+  {
+    int id, population;
+    int read = fscanf(file, "%d,%100[^,],%d,%100000[^\n]\n", &id,
+      name_buffer, &population, geo_buffer);
+    if (ferror(file) || read != 4)
+    {
+      printf("Error reading input file 'brussels_communes.csv'\n");
+      fclose(file);
+      return EXIT_FAILURE;
+    }
+    communes[no_records++] = geom_in(geo_buffer, -1);
+  }
+  fclose(file);
+  if (no_records != NO_COMMUNES)
+  {
+    printf("Expected %d communes, %d read\n", NO_COMMUNES, no_records);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/* Return a random walk inside the box */
+static Temporal *
+random_trip(const STBox *box, TimestampTz t0)
+{
+  double xmin, xmax, ymin, ymax;
+  stbox_xmin(box, &xmin); stbox_xmax(box, &xmax);
+  stbox_ymin(box, &ymin); stbox_ymax(box, &ymax);
+  TInstant **instants = malloc(sizeof(TInstant *) * NO_INSTANTS);
+  double x = xmin + (xmax - xmin) * rand() / RAND_MAX;
+  double y = ymin + (ymax - ymin) * rand() / RAND_MAX;
+  double heading = 2 * M_PI * rand() / RAND_MAX;
+  for (int i = 0; i < NO_INSTANTS; i++)
+  {
+    GSERIALIZED *gs = geompoint_make2d(SRID, x, y);
+    instants[i] = tpointinst_make(gs,
+      t0 + (TimestampTz) i * SAMPLING_INTERVAL * 1000000);
+    free(gs);
+    /* Change slightly the heading and bounce on the borders of the box */
+    heading += (double) rand() / RAND_MAX - 0.5;
+    double dist = (double) SAMPLING_INTERVAL * MAX_SPEED * rand() / RAND_MAX;
+    x += dist * cos(heading);
+    y += dist * sin(heading);
+    if (x < xmin || x > xmax || y < ymin || y > ymax)
+    {
+      heading += M_PI;
+      x = fmin(fmax(x, xmin), xmax);
+      y = fmin(fmax(y, ymin), ymax);
+    }
+  }
+  Temporal *result = (Temporal *) tsequence_make((const TInstant **) instants,
+    NO_INSTANTS, true, true, LINEAR, true);
+  for (int i = 0; i < NO_INSTANTS; i++)
+    free(instants[i]);
+  free(instants);
+  return result;
+}
+
+/* Main program */
+int
+main(void)
+{
+  /* Initialize MEOS */
+  meos_initialize();
+  meos_initialize_timezone("UTC");
+
+  if (read_communes() != EXIT_SUCCESS)
+  {
+    meos_finalize();
+    return EXIT_FAILURE;
+  }
+
+  /* Compute the extent of the communes */
+  STBox *extent = geo_to_stbox(communes[0]);
+  for (int i = 1; i < NO_COMMUNES; i++)
+  {
+    STBox *box = geo_to_stbox(communes[i]);
+    STBox *newextent = union_stbox_stbox(extent, box, false);
+    free(box); free(extent);
+    extent = newextent;
+  }
+
+  /* Generate the trips */
+  srand(1);
+  TimestampTz t0 = pg_timestamptz_in("2025-01-01", -1);
+  Temporal *trips[NO_TRIPS];
+  for (int i = 0; i < NO_TRIPS; i++)
+    trips[i] = random_trip(extent, t0);
+  printf("%d trips of %d instants generated\n", NO_TRIPS, NO_INSTANTS);
+
+  /* Restrict every trip to every commune */
+  long nseqs = 0;
+  double length = 0.0;
+  double start = get_time();
+  for (int i = 0; i < NO_TRIPS; i++)
+  {
+    for (int j = 0; j < NO_COMMUNES; j++)
+    {
+      Temporal *res = tpoint_at_geom(trips[i], communes[j], NULL);
+      if (res)
+      {
+        nseqs += temporal_num_sequences(res);
+        length += tpoint_length(res);
+        free(res);
+      }
+    }
+  }
+  double time = get_time() - start;
+  printf("%d restrictions in %.3f s (%.1f per second)\n",
+    NO_TRIPS * NO_COMMUNES, time, NO_TRIPS * NO_COMMUNES / time);
+  printf("Result: %ld sequences, total length %.3f m\n", nseqs, length);
+
+  /* Clean up */
+  for (int i = 0; i < NO_TRIPS; i++)
+    free(trips[i]);
+  for (int i = 0; i < NO_COMMUNES; i++)
+    free(communes[i]);
+  free(extent);
+
+  /* Finalize MEOS */
+  meos_finalize();
+  return EXIT_SUCCESS;
+}
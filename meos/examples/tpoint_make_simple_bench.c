@@ -0,0 +1,166 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A benchmark that measures the time taken to split trips that loiter
+ * in a small area into non self-intersecting fragments.
+ *
+ * The program generates synthetic trips of three kinds: circular trips that
+ * loop around a center with a slowly varying radius, zig-zag trips that sweep
+ * back and forth across a ring like a fishing vessel, and random walks that
+ * bounce in a small box like a delivery van. The trips are tested with the function
+ * `tpoint_is_simple()` and split with the function `tpoint_make_simple()`.
+ * The program outputs the time taken for each kind of trips together with
+ * the number of fragments of the results, which can be used to verify that
+ * two versions of the library compute the same results.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -O3 -I/usr/local/include -o tpoint_make_simple_bench tpoint_make_simple_bench.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <meos.h>
+#include <meos_geo.h>
+
+/* Number of trips of each kind */
+#define NO_TRIPS 5
+/* Number of instants per trip */
+#define NO_INSTANTS 20000
+/* Number of instants per loop of the circular and zig-zag trips */
+#define LOOP_INSTANTS 2000
+/* SRID of the trips */
+#define SRID 3857
+
+/* Return the current time in seconds */
+static double
+get_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* Return a synthetic trip of a given kind */
+static Temporal *
+synthetic_trip(int kind, TimestampTz t0)
+{
+  TInstant **instants = malloc(sizeof(TInstant *) * NO_INSTANTS);
+  double x = 0.0, y = 0.0, heading = 0.0;
+  for (int i = 0; i < NO_INSTANTS; i++)
+  {
+    if (kind == 0)
+    {
+      /* Circular trip whose radius slowly oscillates */
+      double angle = 2 * M_PI * i / LOOP_INSTANTS;
+      double radius = 1000.0 + 200.0 * sin((double) i / (3 * LOOP_INSTANTS)) +
+        (double) rand() / RAND_MAX;
+      x = radius * cos(angle);
+      y = radius * sin(angle);
+    }
+    else if (kind == 1)
+    {
+      /* Zig-zag trip sweeping back and forth across a slowly widening ring */
+      double angle = 2 * M_PI * i / LOOP_INSTANTS;
+      double radius = 500.0 + 30.0 * i / LOOP_INSTANTS +
+        ((i % 2 == 0) ? -10.0 : 10.0);
+      x = radius * cos(angle);
+      y = radius * sin(angle);
+    }
+    else
+    {
+      /* Random walk bouncing in a box */
+      heading += (double) rand() / RAND_MAX - 0.5;
+      x += 5.0 * cos(heading);
+      y += 5.0 * sin(heading);
+      if (fabs(x) > 500.0 || fabs(y) > 500.0)
+      {
+        heading += M_PI;
+        x = fmin(fmax(x, -500.0), 500.0);
+        y = fmin(fmax(y, -500.0), 500.0);
+      }
+    }
+    GSERIALIZED *gs = geompoint_make2d(SRID, x, y);
+    instants[i] = tpointinst_make(gs,
+      t0 + (TimestampTz) i * 1000000);
+    free(gs);
+  }
+  Temporal *result = (Temporal *) tsequence_make((const TInstant **) instants,
+    NO_INSTANTS, true, true, LINEAR, true);
+  for (int i = 0; i < NO_INSTANTS; i++)
+    free(instants[i]);
+  free(instants);
+  return result;
+}
+
+/* Main program */
+int
+main(void)
+{
+  /* Initialize MEOS */
+  meos_initialize();
+  meos_initialize_timezone("UTC");
+
+  srand(1);
+  TimestampTz t0 = pg_timestamptz_in("2025-01-01", -1);
+  const char *kinds[] = {"circular", "zig-zag", "random walk"};
+  for (int k = 0; k < 3; k++)
+  {
+    Temporal *trips[NO_TRIPS];
+    for (int i = 0; i < NO_TRIPS; i++)
+      trips[i] = synthetic_trip(k, t0);
+
+    int nsimple = 0, nfrags = 0;
+    double start = get_time();
+    for (int i = 0; i < NO_TRIPS; i++)
+    {
+      if (tpoint_is_simple(trips[i]))
+        nsimple++;
+      int count;
+      Temporal **frags = tpoint_make_simple(trips[i], &count);
+      nfrags += count;
+      for (int j = 0; j < count; j++)
+        free(frags[j]);
+      free(frags);
+    }
+    double time = get_time() - start;
+    printf("%-11s: %d trips of %d instants in %.3f s, %d simple, "
+      "%d fragments\n", kinds[k], NO_TRIPS, NO_INSTANTS, time, nsimple,
+      nfrags);
+  }
+
+  /* Finalize MEOS */
+  meos_finalize();
+  return EXIT_SUCCESS;
+}
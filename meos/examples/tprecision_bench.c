@@ -0,0 +1,181 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A benchmark that measures the time taken to downsample sensor data
+ * sampled every second into time bins of one minute.
+ *
+ * The program generates temporal floats and temporal points with one instant
+ * per second during a day, whose precision is set to one minute with the
+ * function `temporal_tprecision()` applied to each value and with the
+ * function `temparr_tprecision()` applied to all the values at once. The
+ * program outputs the number of instants per second for each function and
+ * the integral of the results, which can be used to verify that two
+ * versions of the library compute the same results.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -O3 -I/usr/local/include -o tprecision_bench tprecision_bench.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <meos.h>
+#include <meos_geo.h>
+
+/* Number of sensors */
+#define NO_SENSORS 20
+/* Number of instants per sensor */
+#define NO_INSTANTS 86400
+/* SRID of the points */
+#define SRID 3857
+
+/* Return the current time in seconds */
+static double
+get_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+/* Return a random walk of floats or of points sampled every second */
+static Temporal *
+random_sensor(TimestampTz t0, bool point)
+{
+  TInstant **instants = malloc(sizeof(TInstant *) * NO_INSTANTS);
+  double x = 20.0, y = 0.0;
+  for (int i = 0; i < NO_INSTANTS; i++)
+  {
+    TimestampTz t = t0 + (TimestampTz) i * 1000000;
+    if (point)
+    {
+      GSERIALIZED *gs = geompoint_make2d(SRID, x, y);
+      instants[i] = tpointinst_make(gs, t);
+      free(gs);
+    }
+    else
+      instants[i] = tfloatinst_make(x, t);
+    x += (double) rand() / RAND_MAX - 0.5;
+    y += (double) rand() / RAND_MAX - 0.5;
+  }
+  Temporal *result = (Temporal *) tsequence_make((const TInstant **) instants,
+    NO_INSTANTS, true, true, LINEAR, true);
+  for (int i = 0; i < NO_INSTANTS; i++)
+    free(instants[i]);
+  free(instants);
+  return result;
+}
+
+/* Return the integral of a temporal float or the sum of the integrals of the
+ * coordinates of a temporal point */
+static double
+checksum(const Temporal *temp, bool point)
+{
+  if (! point)
+    return tnumber_integral(temp);
+  Temporal *x = tpoint_get_x(temp);
+  Temporal *y = tpoint_get_y(temp);
+  double result = tnumber_integral(x) + tnumber_integral(y);
+  free(x); free(y);
+  return result;
+}
+
+/* Main program */
+int
+main(void)
+{
+  /* Initialize MEOS */
+  meos_initialize();
+  meos_initialize_timezone("UTC");
+
+  srand(1);
+  TimestampTz t0 = pg_timestamptz_in("2025-01-01", -1);
+  Interval *duration = pg_interval_in("1 minute", -1);
+  for (int k = 0; k < 2; k++)
+  {
+    bool point = (k == 1);
+    const char *type = point ? "tgeompoint" : "tfloat";
+
+    /* Generate the sensor data */
+    Temporal *sensors[NO_SENSORS];
+    for (int i = 0; i < NO_SENSORS; i++)
+      sensors[i] = random_sensor(t0, point);
+    printf("%d %s sensors of %d instants generated\n", NO_SENSORS, type,
+      NO_INSTANTS);
+
+    /* Set the precision of each value */
+    double sum = 0.0;
+    int ninsts = 0;
+    double start = get_time();
+    for (int i = 0; i < NO_SENSORS; i++)
+    {
+      Temporal *res = temporal_tprecision(sensors[i], duration, t0);
+      ninsts += temporal_num_instants(res);
+      sum += checksum(res, point);
+      free(res);
+    }
+    double time = get_time() - start;
+    printf("temporal_tprecision: %.3f s (%.0f instants per second)\n", time,
+      (double) NO_SENSORS * NO_INSTANTS / time);
+    printf("Result: %d instants, checksum %.6f\n", ninsts, sum);
+
+    /* Set the precision of all values at once */
+    sum = 0.0;
+    ninsts = 0;
+    start = get_time();
+    Temporal **res = temparr_tprecision((const Temporal **) sensors,
+      NO_SENSORS, duration, t0);
+    for (int i = 0; i < NO_SENSORS; i++)
+    {
+      ninsts += temporal_num_instants(res[i]);
+      sum += checksum(res[i], point);
+      free(res[i]);
+    }
+    free(res);
+    time = get_time() - start;
+    printf("temparr_tprecision:  %.3f s (%.0f instants per second)\n", time,
+      (double) NO_SENSORS * NO_INSTANTS / time);
+    printf("Result: %d instants, checksum %.6f\n", ninsts, sum);
+
+    for (int i = 0; i < NO_SENSORS; i++)
+      free(sensors[i]);
+  }
+
+  /* Clean up */
+  free(duration);
+
+  /* Finalize MEOS */
+  meos_finalize();
+  return EXIT_SUCCESS;
+}
@@ -42,12 +42,33 @@
 #include <geos_c.h>
 /* PostgreSQL */
 #include <postgres.h>
+#if ! MEOS
+  #include <fmgr.h>
+#endif /* ! MEOS */
 /* PostGIS */
 #include <liblwgeom.h>
 /* MEOS */
 #include <meos.h>
 #include <meos_geo.h>
 
+/**
+ * @brief Structure storing a geometry prepared by GEOS
+ */
+typedef struct
+{
+  GEOSGeometry *geom;                   /**< GEOS geometry */
+  const GEOSPreparedGeometry *prepared; /**< GEOS prepared geometry */
+  bool cached;                          /**< True when kept in the cache */
+} MEOSPreparedGeom;
+
+/**
+ * @brief Cache of the geometry prepared by GEOS for a PostgreSQL function,
+ * which is kept in its @p fn_extra field between calls
+ * @note The structure is only defined for PostgreSQL, MEOS keeps instead a
+ * cache of prepared geometries per thread
+ */
+typedef struct GEOSPreparedFnCache GEOSPreparedFnCache;
+
 /* Functions borrowed from lwgeom_pg.c */
 
 extern GSERIALIZED* geom_serialize(LWGEOM *lwgeom);
@@ -74,6 +95,12 @@ extern GSERIALIZED *GEOS2POSTGIS(GEOSGeom geom, char want3d);
 
 extern bool geom_spatialrel(const GSERIALIZED *gs1, const GSERIALIZED *gs2,
   spatialRel rel);
+extern bool geom_prepare(const GSERIALIZED *gs, GEOSPreparedFnCache *fncache,
+  MEOSPreparedGeom *result);
+extern void geom_prepared_free(MEOSPreparedGeom *pgeom);
+#if ! MEOS
+extern GEOSPreparedFnCache *geom_prepared_fncache(FmgrInfo *flinfo);
+#endif /* ! MEOS */
 
 /* Functions adapted from lwgeom_lrs.c */
 
@@ -40,6 +40,7 @@
 #include <liblwgeom.h>
 /* MEOS */
 #include <meos.h>
+#include "geo/postgis_funcs.h"
 
 /*****************************************************************************/
 
@@ -49,6 +50,9 @@ extern TSequence **tpointseq_at_geom(const TSequence *seq,
   const GSERIALIZED *gs, int *count);
 extern Span *tpointseq_interperiods(const TSequence *seq,
   const GSERIALIZED *gs, int *count);
+extern Temporal *tgeo_restrict_geom_int(const Temporal *temp,
+  const GSERIALIZED *gs, const Span *zspan, bool atfunc,
+  GEOSPreparedFnCache *fncache);
 
 /*****************************************************************************/
 
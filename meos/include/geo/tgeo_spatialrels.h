@@ -39,6 +39,7 @@
 /* MEOS */
 #include <meos.h>
 #include "temporal/temporal.h"
+#include "geo/postgis_funcs.h"
 
 #define INVERT_RESULT(result) (result < 0 ? -1 : (result > 0) ? 0 : 1)
 
@@ -84,6 +85,8 @@ extern int ea_contains_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs,
 extern int ea_contains_tgeo_tgeo(const Temporal *temp, const Temporal *temp2,
   bool ever);
   
+extern int ea_covers_tgeo_geo_int(const Temporal *temp,
+  const GSERIALIZED *gs, bool ever, bool invert, GEOSPreparedFnCache *fncache);
 extern int ea_covers_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp,
   bool ever);
 extern int ea_covers_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs,
@@ -91,6 +94,8 @@ extern int ea_covers_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs,
 extern int ea_covers_tgeo_tgeo(const Temporal *temp, const Temporal *temp2,
   bool ever);
 
+extern int ea_disjoint_tgeo_geo_int(const Temporal *temp,
+  const GSERIALIZED *gs, bool ever, GEOSPreparedFnCache *fncache);
 extern int ea_disjoint_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp, 
   bool ever);
 extern int ea_disjoint_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs,
@@ -98,6 +103,8 @@ extern int ea_disjoint_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs,
 extern int ea_disjoint_tgeo_tgeo(const Temporal *temp, const Temporal *temp2,
   bool ever);
 
+extern int ea_intersects_tgeo_geo_int(const Temporal *temp,
+  const GSERIALIZED *gs, bool ever, GEOSPreparedFnCache *fncache);
 extern int ea_intersects_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp, 
   bool ever);
 extern int ea_intersects_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs,
@@ -79,6 +79,10 @@ typedef struct STboxGridState
   int ntiles;              /**< Total number of tiles */
   int max_coords[MAXDIMS]; /**< Maximum coordinates of the tiles */
   int coords[MAXDIMS];     /**< Coordinates of the current tile */
+  Temporal **splits;       /**< Optional fragments of the temporal point
+                              computed in a single pass */
+  STBox *split_tiles;      /**< Tiles of the fragments, if any */
+  int nsplits;             /**< Number of fragments, if any */
 } STboxGridState;
 
 /*****************************************************************************/
@@ -103,6 +107,10 @@ extern STboxGridState *tgeo_space_time_tile_init(const Temporal *temp,
   const GSERIALIZED *sorigin, TimestampTz torigin, bool bitmatrix, 
   bool border_inc, int *ntiles);
 
+extern bool tpoint_split_onepass(const Temporal *temp);
+extern Temporal **tpoint_space_time_split_tiles(const Temporal *temp,
+  const STboxGridState *state, STBox **boxes, int *count);
+
 extern STBox *stbox_space_time_tile(const GSERIALIZED *point, TimestampTz t,
   double xsize, double ysize, double zsize, const Interval *duration,
   const GSERIALIZED *sorigin, TimestampTz torigin, bool hasx, bool hast);
@@ -51,6 +51,9 @@ extern char **spatialarr_wkt_out(const Datum *spatialarr, meosType basetype,
 extern char *spatialbase_as_text(Datum value, meosType type, int maxdd);
 extern char *spatialbase_as_ewkt(Datum value, meosType type, int maxdd);
 
+extern LWPROJ *meos_lwproj_from_str(const char *str_in, const char *str_out);
+extern LWPROJ *meos_lwproj_from_str_pipeline(const char *pipeline,
+  bool is_forward);
 extern bool point_transf_pj(GSERIALIZED *gs, int32_t srid_to, const LWPROJ *pj);
 
 /*****************************************************************************/
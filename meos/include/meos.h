@@ -47,6 +47,16 @@
 #include <utils/timestamp.h>
 #endif
 
+/*
+ * Storage class of the global variables that MEOS keeps per thread. It is
+ * defined in the file c.h of the PostgreSQL sources of MEOS when building
+ * MEOS. The PostgreSQL backends are single-threaded and thus the global
+ * variables are shared when building the extension.
+ */
+#if ! MEOS
+#define MEOS_THREAD_LOCAL
+#endif
+
 /*****************************************************************************
  * Toolchain dependent definitions
  *****************************************************************************/
@@ -273,9 +283,13 @@ extern RTree *rtree_create_datespan();
 extern RTree *rtree_create_tstzspan();
 extern RTree *rtree_create_tbox();
 extern RTree *rtree_create_stbox();
+extern RTree *rtree_create_stbox_flat();
 extern void rtree_free(RTree *rtree);
 extern void rtree_insert(RTree *rtree, void *box, int64 id);
-extern int *rtree_search(const RTree *rtree,const void *query, int *count);
+extern void rtree_bulk_load(RTree *rtree, const void *boxes, const int64 *ids, int count);
+extern bool rtree_delete(RTree *rtree, const void *box, int64 id);
+extern int64 *rtree_search(const RTree *rtree,const void *query, int *count);
+extern int64 *rtree_knn(const RTree *rtree, const void *query, int k, int *count);
 
 /*****************************************************************************
  * Error codes
@@ -331,6 +345,8 @@ extern void meos_initialize_error_handler(error_handler_fn err_handler);
 extern void meos_finalize_timezone(void);
 extern void meos_finalize_projsrs(void);
 extern void meos_finalize_ways(void);
+extern void meos_finalize_geos_prepared(void);
+extern void meos_finalize_geos(void);
 
 extern bool meos_set_datestyle(const char *newval, void *extra);
 extern bool meos_set_intervalstyle(const char *newval, int extra);
@@ -341,6 +357,43 @@ extern void meos_set_spatial_ref_sys_csv(const char* path);
 
 extern void meos_initialize(void);
 extern void meos_finalize(void);
+extern void meos_initialize_thread(void);
+extern void meos_finalize_thread(void);
+
+/*****************************************************************************
+ * Instrumentation of the MEOS library
+ *****************************************************************************/
+
+/**
+ * @brief Enumeration that defines the hot paths measured by the
+ * instrumentation counters
+ */
+typedef enum
+{
+  MEOS_STAT_GEOS               = 0, /**< Calls to the GEOS library */
+  MEOS_STAT_PROJ               = 1, /**< Transformations with the PROJ library */
+  MEOS_STAT_TSEQUENCE_MAKE     = 2, /**< Constructions of temporal sequences */
+  MEOS_STAT_TSEQUENCESET_MAKE  = 3, /**< Constructions of sequence sets */
+  MEOS_STAT_TINSTARR_NORMALIZE = 4, /**< Normalizations of arrays of instants */
+  MEOS_STAT_TSEQARR_NORMALIZE  = 5, /**< Normalizations of arrays of sequences */
+  MEOS_STAT_SKIPLIST           = 6, /**< Insertions into skiplists */
+} meosStatType;
+
+/* Number of instrumentation counters */
+#define MEOS_STAT_COUNT 7
+
+/**
+ * Structure to represent an instrumentation counter
+ */
+typedef struct
+{
+  uint64 calls;          /**< Number of calls */
+  uint64 nsecs;          /**< Cumulative time of the calls in nanoseconds */
+} MeosStat;
+
+extern const char *meos_stat_name(meosStatType stat);
+extern bool meos_stats_get(MeosStat *stats);
+extern void meos_stats_reset(void);
 
 /******************************************************************************
  * Functions for base and time types
@@ -1197,14 +1250,22 @@ extern bool tbox_ne(const TBox *box1, const TBox *box2);
  * Input and output functions for temporal types
  *****************************************************************************/
 
+/* Definition of the function receiving the chunks of an MF-JSON output */
+typedef bool (*mfjson_write_fn)(const char *, size_t, void *);
+
 extern Temporal *tbool_from_mfjson(const char *str);
 extern Temporal *tbool_in(const char *str);
 extern char *tbool_out(const Temporal *temp);
+extern uint8_t *temporal_as_compressed(const Temporal *temp, size_t *size_out);
 extern char *temporal_as_hexwkb(const Temporal *temp, uint8_t variant, size_t *size_out);
 extern char *temporal_as_mfjson(const Temporal *temp, bool with_bbox, int flags, int precision, const char *srs);
+extern bool temporal_as_mfjson_stream(const Temporal *temp, bool with_bbox, int precision, const char *srs, size_t chunk_size, mfjson_write_fn write, void *arg);
 extern uint8_t *temporal_as_wkb(const Temporal *temp, uint8_t variant, size_t *size_out);
+extern size_t temporal_as_wkb_buf(const Temporal *temp, uint8_t variant, uint8_t *buf, size_t size);
+extern Temporal *temporal_from_compressed(const uint8_t *data, size_t size);
 extern Temporal *temporal_from_hexwkb(const char *hexwkb);
 extern Temporal *temporal_from_wkb(const uint8_t *wkb, size_t size);
+extern size_t temporal_wkb_size(const Temporal *temp, uint8_t variant);
 extern Temporal *tfloat_from_mfjson(const char *str);
 extern Temporal *tfloat_in(const char *str);
 extern char *tfloat_out(const Temporal *temp, int maxdd);
@@ -1778,6 +1839,7 @@ extern Temporal *temporal_simplify_min_tdelta(const Temporal *temp, const Interv
 /* Reduction functions for temporal types */
 
 extern Temporal *temporal_tprecision(const Temporal *temp, const Interval *duration, TimestampTz origin);
+extern Temporal **temparr_tprecision(const Temporal **temparr, int count, const Interval *duration, TimestampTz torigin);
 extern Temporal *temporal_tsample(const Temporal *temp, const Interval *duration, TimestampTz origin, interpType interp);
 
 /*****************************************************************************/
@@ -1785,8 +1847,10 @@ extern Temporal *temporal_tsample(const Temporal *temp, const Interval *duration
 /* Similarity functions for temporal types */
 
 extern double temporal_dyntimewarp_distance(const Temporal *temp1, const Temporal *temp2);
+extern double temporal_dyntimewarp_distance_band(const Temporal *temp1, const Temporal *temp2, int band, double maxdist);
 extern Match *temporal_dyntimewarp_path(const Temporal *temp1, const Temporal *temp2, int *count);
 extern double temporal_frechet_distance(const Temporal *temp1, const Temporal *temp2);
+extern double temporal_frechet_distance_band(const Temporal *temp1, const Temporal *temp2, int band, double maxdist);
 extern Match *temporal_frechet_path(const Temporal *temp1, const Temporal *temp2, int *count);
 extern double temporal_hausdorff_distance(const Temporal *temp1, const Temporal *temp2);
 
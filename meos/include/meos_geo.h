@@ -604,7 +604,7 @@ extern bool stbox_ne(const STBox *box1, const STBox *box2);
 // extern RTree *rtree_create_stbox();
 // extern void rtree_free(RTree *rtree);
 // extern void rtree_insert(RTree *rtree, STBox *box, int64 id);
-// extern int *rtree_search(const RTree *rtree,const STBox *query, int *count);
+// extern int64 *rtree_search(const RTree *rtree,const STBox *query, int *count);
 
 /*****************************************************************************
  * Functions for temporal geometries/geographies
@@ -809,6 +809,9 @@ extern bool right_tspatial_tspatial(const Temporal *temp1, const Temporal *temp2
 extern int acontains_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp);
 extern int acontains_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs);
 extern int acontains_tgeo_tgeo(const Temporal *temp1, const Temporal *temp2);
+extern int acovers_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp);
+extern int acovers_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs);
+extern int acovers_tgeo_tgeo(const Temporal *temp1, const Temporal *temp2);
 extern int adisjoint_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs);
 extern int adisjoint_tgeo_tgeo(const Temporal *temp1, const Temporal *temp2);
 extern int adwithin_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, double dist);
@@ -1020,6 +1020,30 @@ extern TSequence *ttextseq_in(const char *str, interpType interp);
 extern TSequenceSet *ttextseqset_from_mfjson(json_object *mfjson);
 extern TSequenceSet *ttextseqset_in(const char *str);
 extern Temporal *temporal_from_mfjson(const char *mfjson, meosType temptype);
+extern bool temporal_compressed_set_bbox(const uint8_t *data, size_t size, meosType *temptype, void *box);
+
+/* Incremental parser of the MF-JSON representation of temporal types */
+
+typedef struct MfjsonParser MfjsonParser;
+
+extern Temporal *mfjson_parser_end(MfjsonParser *parser);
+extern bool mfjson_parser_feed(MfjsonParser *parser, const char *buf, size_t len);
+extern void mfjson_parser_free(MfjsonParser *parser);
+extern MfjsonParser *mfjson_parser_make(meosType temptype);
+
+/* Structure-of-arrays representation of temporal sequences */
+
+typedef struct TSequenceSoA TSequenceSoA;
+
+extern TSequenceSoA *tsequence_to_soa(const TSequence *seq);
+extern TSequenceSoA *tsequencesoa_at_tstzspan(const TSequenceSoA *soa, const Span *s);
+extern TInstant *tsequencesoa_inst_n(const TSequenceSoA *soa, int n);
+extern size_t tsequencesoa_mem_size(const TSequenceSoA *soa);
+extern int tsequencesoa_num_instants(const TSequenceSoA *soa);
+extern bool tsequencesoa_timestamptz_n(const TSequenceSoA *soa, int n, TimestampTz *result);
+extern TSequence *tsequencesoa_to_tsequence(const TSequenceSoA *soa);
+extern double tpointseqsoa_length(const TSequenceSoA *soa);
+extern TSequenceSoA *tpointseqsoa_speed(const TSequenceSoA *soa);
 
 /*****************************************************************************/
 
@@ -1318,6 +1342,9 @@ extern int skiplist_search(SkipList *list, void *key, void *value);
 extern void skiplist_free(SkipList *list);
 extern void skiplist_splice(SkipList *list, void **keys, void **values, int count, datum_func2 func, bool crossings, SkipListType sktype);
 extern void temporal_skiplist_splice(SkipList *list, void **values, int count, datum_func2 func, bool crossings);
+extern void skiplist_load(SkipList *list, void **values, int count);
+extern uint8_t *taggstate_serialize(SkipList *state, size_t *size);
+extern SkipList *taggstate_deserialize(const uint8_t *data, size_t size);
 extern void **skiplist_values(SkipList *list);
 extern void **skiplist_keys_values(SkipList *list, void **values);
 
@@ -0,0 +1,94 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @brief Instrumentation counters of the hot paths of MEOS.
+ * @details The counters are only maintained when the library is built with
+ * the option `MEOS_STATS`, otherwise the macros below expand to no-ops and
+ * the instrumentation has no cost. A hot path is measured as follows
+ * @code
+ * MEOS_STATS_START(start);
+ * ... code to measure ...
+ * MEOS_STATS_END(MEOS_STAT_GEOS, start);
+ * @endcode
+ * where calls that exit the code to measure on error are not counted.
+ */
+
+#ifndef __MEOS_STATS_H__
+#define __MEOS_STATS_H__
+
+#if MEOS_STATS
+
+/* C */
+#include <time.h>
+/* MEOS */
+#include <meos.h>
+
+/*****************************************************************************/
+
+extern MEOS_THREAD_LOCAL MeosStat MEOS_STAT_COUNTERS[MEOS_STAT_COUNT];
+
+/**
+ * @brief Return the value of a monotonic clock in nanoseconds
+ */
+static inline uint64
+meos_stats_clock(void)
+{
+  struct timespec ts;
+#ifdef _WIN32
+  timespec_get(&ts, TIME_UTC);
+#else
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+  return (uint64) ts.tv_sec * 1000000000 + (uint64) ts.tv_nsec;
+}
+
+/**
+ * @brief Add a call started at @p start to a counter
+ */
+static inline void
+meos_stats_add(meosStatType stat, uint64 start)
+{
+  MEOS_STAT_COUNTERS[stat].calls++;
+  MEOS_STAT_COUNTERS[stat].nsecs += meos_stats_clock() - start;
+}
+
+#define MEOS_STATS_START(var) uint64 var = meos_stats_clock()
+#define MEOS_STATS_END(stat, var) meos_stats_add((stat), (var))
+
+#else
+
+#define MEOS_STATS_START(var) ((void) 0)
+#define MEOS_STATS_END(stat, var) ((void) 0)
+
+#endif /* MEOS_STATS */
+
+/*****************************************************************************/
+
+#endif /* __MEOS_STATS_H__ */
@@ -97,6 +97,7 @@ extern float8 pg_datan2(float8 arg1, float8 arg2);
 
 extern void interval_negate(const Interval *interval, Interval *result);
 extern Interval *pg_interval_justify_hours(const Interval *span);
+extern int64 interval_cmp_usecs(const Interval *interval);
 
 /* Functions adapted from hashfn.h and hashfn.c */
 
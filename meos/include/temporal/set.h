@@ -76,6 +76,20 @@ typedef struct
   Datum *values;   /* Values obtained by getValues(temp) */
 } SetUnnestState;
 
+/*****************************************************************************
+ * Struct definition for the union aggregate
+ *****************************************************************************/
+
+/**
+ * Structure to represent the state of the union aggregate of set types,
+ * which keeps the distinct values aggregated so far in a hash table
+ */
+typedef struct
+{
+  meosType basetype;            /**< Base type of the values */
+  struct setunion_hash *table;  /**< Hash table of the distinct values */
+} SetUnionState;
+
 /*****************************************************************************/
 
 /* General functions */
@@ -90,6 +104,15 @@ extern bool set_find_value(const Set *s, Datum, int *loc);
 extern SetUnnestState *set_unnest_state_make(const Set *set);
 extern void set_unnest_state_next(SetUnnestState *state);
 
+extern SetUnionState *set_union_state_make(meosType basetype);
+extern void set_union_state_add(SetUnionState *state, Datum value);
+extern void set_union_state_add_set(SetUnionState *state, const Set *s);
+extern int set_union_state_count(const SetUnionState *state);
+extern void set_union_state_merge(SetUnionState *state1,
+  const SetUnionState *state2);
+extern Set *set_union_state_finalize(const SetUnionState *state);
+extern void set_union_state_free(SetUnionState *state);
+
 /*****************************************************************************/
 
 #endif /* __SET_H__ */
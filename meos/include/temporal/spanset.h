@@ -52,6 +52,8 @@ extern bool ensure_valid_spanset_spanset(const SpanSet *ss1,
   const SpanSet *ss2);
 
 extern bool spanset_find_value(const SpanSet *ss, Datum v, int *loc);
+extern int mi_span_spanset(const Span *s, const SpanSet *ss, int from, int to,
+  Span *result);
 
 /*****************************************************************************/
 
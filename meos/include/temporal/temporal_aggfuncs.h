@@ -94,6 +94,8 @@ extern SkipList *temporal_tagg_transfn(SkipList *state, const Temporal *temp,
   datum_func2, bool crossings);
 extern SkipList *temporal_tagg_combinefn(SkipList *state1, SkipList *state2,
   datum_func2 func, bool crossings);
+extern SkipList *temporal_tagg_combine_states(SkipList **states, int count,
+  datum_func2 func, bool crossings);
 extern SkipList *temporal_tagg_transform_transfn(SkipList *state, const Temporal *temp,
   datum_func2 func, bool crossings, TInstant *(*transform)(const TInstant *));
   
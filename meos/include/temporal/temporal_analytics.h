@@ -57,7 +57,7 @@ typedef struct
 /*****************************************************************************/
 
 extern double temporal_similarity(const Temporal *temp1, const Temporal *temp2,
-  SimFunc simfunc);
+  SimFunc simfunc, int band, double maxdist);
 extern Match *temporal_similarity_path(const Temporal *temp1,
   const Temporal *temp2, int *count, SimFunc simfunc);
 
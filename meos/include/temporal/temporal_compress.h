@@ -0,0 +1,69 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+
+/**
+ * @brief Compressed binary representation of temporal values
+ */
+
+#ifndef __TEMPORAL_COMPRESS_H__
+#define __TEMPORAL_COMPRESS_H__
+
+/* MEOS */
+#include <meos.h>
+#include "temporal/temporal.h"
+
+/*****************************************************************************/
+
+/**
+ * @brief Version of the compressed binary representation of temporal values
+ */
+#define TEMPORAL_COMPRESSED_VERSION 1
+
+/**
+ * @brief Size in bytes of the fixed part of the header of the compressed
+ * binary representation of temporal values
+ * @details The header is composed of the version, the temporal type, the
+ * subtype, and a padding byte, followed by the flags as an int16 and two
+ * padding bytes, the number of sequences, and the number of instants, both
+ * as int32. It is followed by the bounding box.
+ */
+#define TEMPORAL_COMPRESSED_HEADER_SIZE 16
+
+/**
+ * @brief Return the size in bytes to read from toast to get the header of
+ * the compressed binary representation of a temporal value, including its
+ * bounding box
+ */
+#define TEMPORAL_COMPRESSED_MAX_HEADER_SIZE \
+  (TEMPORAL_COMPRESSED_HEADER_SIZE + sizeof(bboxunion))
+
+/*****************************************************************************/
+
+#endif /* __TEMPORAL_COMPRESS_H__ */
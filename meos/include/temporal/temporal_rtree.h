@@ -45,6 +45,7 @@
 
 #define MAXITEMS 64
 #define SEARCH_ARRAY_STARTING_SIZE 64
+#define KNN_HEAP_STARTING_SIZE 64
 #define MINITEMS_PERCENTAGE 10
 #define MINITEMS ((MAXITEMS) * (MINITEMS_PERCENTAGE) / 100 + 1)
 
@@ -74,6 +75,28 @@ typedef struct RTreeNode
   char boxes[];
 } RTreeNode;
 
+/**
+ * @brief Structure-of-arrays copy of the bounds of the spatiotemporal boxes
+ * of an RTree node
+ * @details It is stored after the bounding boxes of the nodes of an RTree
+ * created with #rtree_create_stbox_flat so that the overlap test of all the
+ * entries of a node is a tight loop over contiguous arrays. Missing
+ * dimensions are stored as infinite bounds.
+ */
+typedef struct
+{
+  double xmin[MAXITEMS];
+  double xmax[MAXITEMS];
+  double ymin[MAXITEMS];
+  double ymax[MAXITEMS];
+  double zmin[MAXITEMS];
+  double zmax[MAXITEMS];
+  int64 tmin[MAXITEMS];
+  int64 tmax[MAXITEMS];
+  uint8 tmin_inc[MAXITEMS];   /**< Inclusivity of the lower time bound */
+  uint8 tmax_inc[MAXITEMS];   /**< Inclusivity of the upper time bound */
+} RTreeNodeSoA;
+
 /**
  * @brief Rtree in-memory index basic structure.
  * @details It works based on Span, TBox and STBox. 
@@ -87,14 +110,45 @@ struct RTree
   size_t bboxsize;       /**< Size of the bouding box */
   meosType bboxtype;     /**< Type of the bouding box */
   int dims;
+  bool flat;             /**< True when the nodes keep an RTreeNodeSoA */
   RTreeNode *root;
   double (*get_axis)(const void *, int, bool);
   void (*bbox_expand)(const void *, void *);
   bool (*bbox_contains)(const void *, const void *);
   bool (*bbox_overlaps)(const void *, const void *);
+  double (*bbox_distance)(const void *, const void *);
   char box[];
 };
 
+/**
+ * @brief Entry of an RTree node detached from the tree, used for bulk loading
+ * and for reinserting the entries of underflowed nodes after a deletion
+ */
+typedef struct
+{
+  union
+  {
+    struct RTreeNode *node;   /**< Child node for inner entries */
+    int64 id;                 /**< Identifier for leaf entries */
+  };
+  /* STBox is the largest MEOS bounding box */
+  STBox box;                  /**< Bounding box of the entry */
+} RTreeEntry;
+
+/**
+ * @brief Element of the priority queue of a k-nearest neighbor search
+ */
+typedef struct
+{
+  double dist;                /**< Lower bound of the distance to the query */
+  bool leaf;                  /**< True when the element is a leaf entry */
+  union
+  {
+    const struct RTreeNode *node;
+    int64 id;
+  };
+} RTreeKnnElem;
+
 /**
  * @brief Return a pointer to the n-th bounding box of a node
  * @details The bouding boxes of a node can be of type Span, TBox, or STBox
@@ -102,6 +156,13 @@ struct RTree
 #define RTREE_NODE_BBOX_N(node, n) ( (void *)( \
   ((char *) &((node)->boxes)) + (n) * (node)->bboxsize ) )
 
+/**
+ * @brief Return a pointer to the structure-of-arrays bounds of a node, which
+ * follow its bounding boxes
+ */
+#define RTREE_NODE_SOA(node) ( (RTreeNodeSoA *)( \
+  ((char *) &((node)->boxes)) + MAXITEMS * (node)->bboxsize ) )
+
 /*****************************************************************************/
 
 #endif /* __TEMPORAL_RTREE__ */
@@ -0,0 +1,84 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @brief Structure-of-arrays representation of temporal sequences
+ */
+
+#ifndef __TSEQUENCE_SOA_H__
+#define __TSEQUENCE_SOA_H__
+
+/* MEOS */
+#include <meos.h>
+#include "temporal/meos_catalog.h"
+
+/*****************************************************************************
+ * Structure-of-arrays temporal sequences
+ *****************************************************************************/
+
+/**
+ * @brief Structure to represent a temporal sequence as separate contiguous
+ * arrays of timestamps and of values
+ * @details The representation is available for temporal integers, temporal
+ * floats, and temporal geometry points. The timestamps are followed by one
+ * array of doubles for every dimension of the values, that is, one for the
+ * numbers, which represent exactly all integers, and two or three for the
+ * coordinates of the points. The flags are those of the original sequence.
+ * Compared with the instants of a TSequence, this representation divides by
+ * more than two the size of a sequence of 2D points and its scans are tight
+ * loops over consecutive doubles.
+ */
+struct TSequenceSoA
+{
+  size_t size;          /**< Size in bytes of the structure */
+  uint8 temptype;       /**< Temporal type */
+  int16 flags;          /**< Flags */
+  int32 count;          /**< Number of instants */
+  int32_t srid;         /**< SRID of the temporal points */
+  Span period;          /**< Time span */
+  TimestampTz times[];  /**< Timestamps followed by the values */
+};
+
+/**
+ * @brief Return the number of arrays of values of a structure-of-arrays
+ * temporal sequence
+ */
+#define TSEQUENCESOA_NCOLS(soa) ( tnumber_type((soa)->temptype) ? 1 : \
+  (MEOS_FLAGS_GET_Z((soa)->flags) ? 3 : 2) )
+
+/**
+ * @brief Return a pointer to the n-th array of values of a structure-of-arrays
+ * temporal sequence
+ */
+#define TSEQUENCESOA_COL(soa, n) \
+  ( (double *) ((soa)->times + (soa)->count * (1 + (n))) )
+
+/*****************************************************************************/
+
+#endif /* __TSEQUENCE_SOA_H__ */
@@ -40,6 +40,11 @@
 
 /*****************************************************************************/
 
+/* Initial size of the arrays used for parsing the temporal types */
+#define PARSER_ARRAY_STARTING_SIZE 16
+
+/*****************************************************************************/
+
 extern bool ensure_end_input(const char **str, const char *type);
 extern void p_whitespace(const char **str);
 extern bool p_delimchar(const char **str, char delim);
@@ -72,6 +72,7 @@ extern char *stringarr_to_string(char **strings, int count, size_t outlen,
 /* Sort functions */
 
 extern void datumarr_sort(Datum *values, int count, meosType basetype);
+extern void datumarr_radix_sort(Datum *values, int count, meosType basetype);
 extern void tstzarr_sort(TimestampTz *times, int count);
 extern void spanarr_sort(Span *spans, int count);
 extern void tinstarr_sort(TInstant **instants, int count);
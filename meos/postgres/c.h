@@ -191,6 +191,16 @@
 #define pg_attribute_noreturn()
 #endif
 
+/*
+ * MEOS: storage class of the global variables that are kept per thread so
+ * that the library can be used by several threads at the same time
+ */
+#if defined(_MSC_VER)
+#define MEOS_THREAD_LOCAL __declspec(thread)
+#else
+#define MEOS_THREAD_LOCAL __thread
+#endif
+
 /*
  * Use "pg_attribute_always_inline" in place of "inline" for functions that
  * we wish to force inlining of, even when the compiler's heuristics would
@@ -30,7 +30,7 @@ extern const char *select_default_timezone(const char *share_path);
 
 
 #ifndef SYSTEMTZDIR
-static char tzdirpath[MAXPGPATH];
+static MEOS_THREAD_LOCAL char tzdirpath[MAXPGPATH];
 #endif
 
 
@@ -61,7 +61,7 @@ pg_TZDIR(void)
 static pg_tz *
 pg_load_tz(const char *name)
 {
-  static pg_tz tz;
+  static MEOS_THREAD_LOCAL pg_tz tz;
 
   if (strlen(name) > TZ_STRLEN_MAX)
     return NULL;      /* not going to fit */
@@ -207,6 +207,7 @@ score_timezone(const char *tzname, struct tztry *tt)
   int      i;
   pg_time_t  pgtt;
   struct tm  *systm;
+  struct tm  systmbuf;
   struct pg_tm *pgtm;
   char    cbuf[TZ_STRLEN_MAX + 1];
   pg_tz     *tz;
@@ -232,7 +233,7 @@ score_timezone(const char *tzname, struct tztry *tt)
     pgtm = pg_localtime(&pgtt, tz);
     if (!pgtm)
       return -1;      /* probably shouldn't happen */
-    systm = localtime(&(tt->test_times[i]));
+    systm = localtime_r(&(tt->test_times[i]), &systmbuf);
     if (!systm)
     {
 #ifdef DEBUG_IDENTIFY_TIMEZONE
@@ -301,11 +302,12 @@ perfect_timezone_match(const char *tzname, struct tztry *tt)
 static const char *
 identify_system_timezone(void)
 {
-  static char resultbuf[(TZ_STRLEN_MAX + 1) * 2];
+  static MEOS_THREAD_LOCAL char resultbuf[(TZ_STRLEN_MAX + 1) * 2];
   time_t    tnow;
   time_t    t;
   struct tztry tt;
   struct tm  *tm;
+  struct tm  tmbuf;       /* MEOS: localtime() is not thread-safe */
   int      thisyear;
   int      bestscore;
   char    tmptzdir[MAXPGPATH];
@@ -337,7 +339,7 @@ identify_system_timezone(void)
    * itself.)
    */
   tnow = time(NULL);
-  tm = localtime(&tnow);
+  tm = localtime_r(&tnow, &tmbuf);
   if (!tm)
     return NULL;      /* give up if localtime is broken... */
   thisyear = tm->tm_year + 1900;
@@ -420,7 +422,7 @@ identify_system_timezone(void)
    */
   for (t = tnow; t <= tnow + T_MONTH * 14; t += T_MONTH)
   {
-    tm = localtime(&t);
+    tm = localtime_r(&t, &tmbuf);
     if (!tm)
       continue;
     if (tm->tm_isdst < 0)
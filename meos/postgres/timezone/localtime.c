@@ -101,7 +101,7 @@ static bool typesequiv(struct state const *, int, int);
  * Thanks to Paul Eggert for noting this.
  */
 
-static struct pg_tm tm;
+static MEOS_THREAD_LOCAL struct pg_tm tm;
 
 /* Initialize *S to a value based on UTOFF, ISDST, and DESIGIDX.  */
 static void
@@ -1360,7 +1360,7 @@ gmtsub(pg_time_t const *timep, int32 offset,
 	struct pg_tm *result;
 
 	/* GMT timezone state data is kept here */
-	static struct state *gmtptr = NULL;
+	static MEOS_THREAD_LOCAL struct state *gmtptr = NULL;
 
 	if (gmtptr == NULL)
 	{
@@ -59,7 +59,7 @@ static uint32 hash_string_pointer(const char *s);
 extern const char *select_default_timezone(const char *share_path);
 
 /* Current session timezone (controlled by TimeZone GUC) */
-pg_tz *session_timezone = NULL;
+MEOS_THREAD_LOCAL pg_tz *session_timezone = NULL;
 
 /* Current log timezone (controlled by log_timezone GUC) */
 // pg_tz *log_timezone = NULL; /* MEOS */
@@ -89,7 +89,7 @@ hash_string_pointer(const char *s)
 /* MEOS */
 // typedef struct {...} pg_tz_cache;
 
-static tzcache_hash *timezone_cache = NULL;
+static MEOS_THREAD_LOCAL tzcache_hash *timezone_cache = NULL;
 
 static bool
 init_timezone_hashtable(void)
@@ -130,8 +130,8 @@ pg_TZDIR(void)
 {
 #ifndef SYSTEMTZDIR
   /* normal case: timezone stuff is under our share dir */
-  static bool done_tzdir = false;
-  static char tzdir[MAXPGPATH];
+  static MEOS_THREAD_LOCAL bool done_tzdir = false;
+  static MEOS_THREAD_LOCAL char tzdir[MAXPGPATH];
 
   if (done_tzdir)
     return tzdir;
@@ -467,7 +467,10 @@ meos_initialize_timezone(const char *tz_str)
 
   /* Free the existing timezone entry */
   if (session_timezone)
-    pfree(session_timezone); 
+  {
+    pfree(session_timezone);
+    session_timezone = NULL;
+  }
   session_timezone = pg_tzset(tz_str);
   if (! session_timezone)
     meos_error(ERROR, MEOS_ERR_INTERNAL_ERROR,
@@ -482,7 +485,10 @@ void
 meos_finalize_timezone(void)
 {
   if (session_timezone)
-    pfree(session_timezone); 
+  {
+    pfree(session_timezone);
+    session_timezone = NULL;
+  }
   if (timezone_cache)
   {
     /* Free the timezone name strings associated to the keys */
@@ -495,6 +501,7 @@ meos_finalize_timezone(void)
         pfree(entry->key); 
     }
     tzcache_destroy(timezone_cache);
+    timezone_cache = NULL;
   }
   return;
 }
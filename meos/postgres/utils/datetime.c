@@ -224,15 +224,15 @@ static const datetkn deltatktbl[] = {
 
 static const int szdeltatktbl = sizeof deltatktbl / sizeof deltatktbl[0];
 
-static TimeZoneAbbrevTable *zoneabbrevtbl = NULL;
+static MEOS_THREAD_LOCAL TimeZoneAbbrevTable *zoneabbrevtbl = NULL;
 
 /* Caches of recent lookup results in the above tables */
 
-static const datetkn *datecache[MAXDATEFIELDS] = {NULL};
+static MEOS_THREAD_LOCAL const datetkn *datecache[MAXDATEFIELDS] = {NULL};
 
-static const datetkn *deltacache[MAXDATEFIELDS] = {NULL};
+static MEOS_THREAD_LOCAL const datetkn *deltacache[MAXDATEFIELDS] = {NULL};
 
-static const datetkn *abbrevcache[MAXDATEFIELDS] = {NULL};
+static MEOS_THREAD_LOCAL const datetkn *abbrevcache[MAXDATEFIELDS] = {NULL};
 
 /*
  * Calendar time to Julian date conversions.
@@ -368,11 +368,11 @@ GetCurrentTimeUsec(struct pg_tm *tm, fsec_t *fsec, int *tzp)
    * however, it might need another look if we ever allow entries in that
    * hash to be recycled.
    */
-  static TimestampTz cache_ts = 0;
-  static pg_tz *cache_timezone = NULL;
-  static struct pg_tm cache_tm;
-  static fsec_t cache_fsec;
-  static int  cache_tz;
+  static MEOS_THREAD_LOCAL TimestampTz cache_ts = 0;
+  static MEOS_THREAD_LOCAL pg_tz *cache_timezone = NULL;
+  static MEOS_THREAD_LOCAL struct pg_tm cache_tm;
+  static MEOS_THREAD_LOCAL fsec_t cache_fsec;
+  static MEOS_THREAD_LOCAL int  cache_tz;
 
   if (cur_ts != cache_ts || session_timezone != cache_timezone)
   {
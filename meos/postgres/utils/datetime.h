@@ -23,9 +23,9 @@
 struct tzEntry;
 
 /* Definitions of the global variables taken from miscadmin.h */
-extern int DateStyle;
-extern int DateOrder;
-extern int IntervalStyle;
+extern MEOS_THREAD_LOCAL int DateStyle;
+extern MEOS_THREAD_LOCAL int DateOrder;
+extern MEOS_THREAD_LOCAL int IntervalStyle;
 
 /* valid DateOrder values taken */
 #define DATEORDER_YMD      0
@@ -367,9 +367,9 @@ typedef struct
 
 
 /* global cache for date/time format pictures */
-static DCHCacheEntry *DCHCache[DCH_CACHE_ENTRIES];
-static int  n_DCHCache = 0;    /* current number of entries */
-static int  DCHCounter = 0;    /* aging-event counter */
+static MEOS_THREAD_LOCAL DCHCacheEntry *DCHCache[DCH_CACHE_ENTRIES];
+static MEOS_THREAD_LOCAL int  n_DCHCache = 0;    /* current number of entries */
+static MEOS_THREAD_LOCAL int  DCHCounter = 0;    /* aging-event counter */
 
 
 /* ----------
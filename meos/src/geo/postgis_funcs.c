@@ -41,6 +41,7 @@
 /* GEOS */
 #include <geos_c.h>
 /* PostgreSQL */
+#include <common/hashfn.h>
 #if POSTGRESQL_VERSION_NUMBER >= 160000
   #include "varatt.h"
 #endif
@@ -52,6 +53,7 @@
 /* MEOS */
 #include <meos.h>
 #include <meos_internal.h>
+#include "temporal/meos_stats.h"
 #include "temporal/type_util.h"
 #include "geo/meos_transform.h"
 #include "geo/tgeo.h"
@@ -65,12 +67,74 @@
       "%s", lwg_parser_result.message); \
   } while(0);
 #else
+  #include <fmgr.h>
   #include <lwgeom_pg.h>
 #endif
 
 /* Function not exported in liblwgeom.h */
 extern int spheroid_init_from_srid(int32_t srid, SPHEROID *s);
 
+#if MEOS
+/*****************************************************************************
+ * GEOS context handle of the thread
+ *****************************************************************************/
+
+/* Global variable to hold the GEOS context handle of the thread */
+static MEOS_THREAD_LOCAL GEOSContextHandle_t MEOS_GEOS_CONTEXT = NULL;
+
+/* Global variable to hold the last GEOS error message of the thread */
+static MEOS_THREAD_LOCAL char MEOS_GEOS_ERRMSG[LWGEOM_GEOS_ERRMSG_MAXSIZE];
+
+/**
+ * @brief Return the GEOS context handle of the thread, which is created on
+ * first use
+ * @details The functions of the non-reentrant API of GEOS are mapped in the
+ * file @p lwgeom_geos.h to the reentrant API on this handle
+ */
+GEOSContextHandle_t
+meos_geos_context(void)
+{
+  if (! MEOS_GEOS_CONTEXT)
+    MEOS_GEOS_CONTEXT = GEOS_init_r();
+  return MEOS_GEOS_CONTEXT;
+}
+
+/**
+ * @brief Set the message handlers of the GEOS context handle of the thread
+ * @note This function replaces the function @p initGEOS of the non-reentrant
+ * API of GEOS
+ */
+void
+meos_geos_init(GEOSMessageHandler notice, GEOSMessageHandler error)
+{
+  GEOSContextHandle_t handle = meos_geos_context();
+  GEOSContext_setNoticeHandler_r(handle, notice);
+  GEOSContext_setErrorHandler_r(handle, error);
+  return;
+}
+
+/**
+ * @brief Return the buffer keeping the last GEOS error message of the thread
+ */
+char *
+meos_geos_errmsg(void)
+{
+  return MEOS_GEOS_ERRMSG;
+}
+
+/**
+ * @brief Destroy the GEOS context handle of the thread
+ */
+void
+meos_finalize_geos(void)
+{
+  if (MEOS_GEOS_CONTEXT)
+    GEOS_finish_r(MEOS_GEOS_CONTEXT);
+  MEOS_GEOS_CONTEXT = NULL;
+  return;
+}
+#endif /* MEOS */
+
 /*****************************************************************************
  * Interval tree functions
  * Functions copied from /postgis/lwgeom_itree.c
@@ -1170,7 +1234,9 @@ geom_centroid(const GSERIALIZED *gs)
 {
   assert(gs);
   LWGEOM *lwgeom = lwgeom_from_gserialized(gs);
+  MEOS_STATS_START(start);
   LWGEOM *lwresult = lwgeom_centroid(lwgeom);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
   lwgeom_free(lwgeom);
   if (! lwresult)
     return NULL;
@@ -1270,11 +1336,11 @@ GEOS2POSTGIS(GEOSGeom geom, char want3d)
 
 /**
  * @brief Transform two @p GSERIALIZED geometries into @p GEOSGeometry and
- * call the GEOS function passed as argument
+ * call the GEOS function of the spatial relationship passed as argument
  */
 static char
 meos_call_geos2(const GSERIALIZED *gs1, const GSERIALIZED *gs2,
-  char (*func)(const GEOSGeometry *geos1, const GEOSGeometry *geos2))
+  spatialRel rel)
 {
   initGEOS(lwnotice, lwgeom_geos_error);
 
@@ -1296,7 +1362,25 @@ meos_call_geos2(const GSERIALIZED *gs1, const GSERIALIZED *gs2,
     return 2;
   }
 
-  char result = func(geos1, geos2);
+  /* The GEOS functions are macros calling the reentrant API of GEOS in MEOS,
+   * which prevents passing their address as argument */
+  MEOS_STATS_START(start);
+  char result;
+  switch (rel)
+  {
+    case INTERSECTS:
+      result = GEOSIntersects(geos1, geos2);
+      break;
+    case CONTAINS:
+      result = GEOSContains(geos1, geos2);
+      break;
+    case TOUCHES:
+      result = GEOSTouches(geos1, geos2);
+      break;
+    default: /* COVERS */
+      result = GEOSCovers(geos1, geos2);
+  }
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
 
   GEOSGeom_destroy(geos1); GEOSGeom_destroy(geos2);
   if (result == 2)
@@ -1306,6 +1390,300 @@ meos_call_geos2(const GSERIALIZED *gs1, const GSERIALIZED *gs2,
   return result;
 }
 
+/*****************************************************************************
+ * Cache of GEOS prepared geometries
+ *****************************************************************************/
+
+/* Number of prepared geometries kept in the cache */
+#define GEOS_PREPARED_CACHE_ITEMS 512
+
+/**
+ * @brief Return true if two geometries have the same bytes
+ */
+static inline bool
+gserialized_bytes_eq(const GSERIALIZED *gs1, const GSERIALIZED *gs2)
+{
+  return VARSIZE(gs1) == VARSIZE(gs2) &&
+    memcmp(gs1, gs2, VARSIZE(gs1)) == 0;
+}
+
+#if MEOS
+/**
+ * @brief Entry of the cache of GEOS prepared geometries
+ */
+typedef struct
+{
+  GSERIALIZED *gs;                      /**< Copy of the geometry (key) */
+  GEOSGeometry *geom;                   /**< GEOS geometry */
+  const GEOSPreparedGeometry *prepared; /**< GEOS prepared geometry */
+  uint64_t hits;                        /**< Number of hits */
+} GEOSPreparedCacheItem;
+
+/**
+ * @brief Entry of the hash table giving the position of a geometry in the
+ * cache of GEOS prepared geometries
+ */
+typedef struct
+{
+  const GSERIALIZED *key;  /**< Geometry (hash key) */
+  uint32_t position;       /**< Position of the entry in the cache */
+  char status;             /**< Hash status */
+} GEOSPreparedCacheEntry;
+
+#define SH_PREFIX geosprep
+#define SH_ELEMENT_TYPE GEOSPreparedCacheEntry
+#define SH_KEY_TYPE const GSERIALIZED *
+#define SH_KEY key
+#define SH_HASH_KEY(tb, key) \
+  hash_bytes((const unsigned char *) (key), (int) VARSIZE(key))
+#define SH_EQUAL(tb, a, b) gserialized_bytes_eq(a, b)
+#define SH_SCOPE static inline
+#define SH_RAW_ALLOCATOR palloc0
+#define SH_DEFINE
+#define SH_DECLARE
+#include <lib/simplehash.h>
+
+/**
+ * @brief The cache of GEOS prepared geometries holds a fixed number of
+ * geometries found through a hash table on their bytes
+ * @details The array of entries is only scanned to find the entry to evict
+ * when the cache is full
+ */
+typedef struct
+{
+  GEOSPreparedCacheItem items[GEOS_PREPARED_CACHE_ITEMS];
+  uint32_t count;
+  geosprep_hash *index;
+} GEOSPreparedCache;
+
+/* Global variable to hold the cache of GEOS prepared geometries */
+static MEOS_THREAD_LOCAL GEOSPreparedCache *MEOS_GEOS_PREPARED_CACHE = NULL;
+
+/**
+ * @brief Destroy all the GEOS prepared geometries stored in the cache
+ */
+void
+meos_finalize_geos_prepared(void)
+{
+  GEOSPreparedCache *cache = MEOS_GEOS_PREPARED_CACHE;
+  if (cache)
+  {
+    initGEOS(lwnotice, lwgeom_geos_error);
+    for (uint32_t i = 0; i < cache->count; i++)
+    {
+      GEOSPreparedGeom_destroy(cache->items[i].prepared);
+      GEOSGeom_destroy(cache->items[i].geom);
+      pfree(cache->items[i].gs);
+    }
+    finishGEOS();
+    geosprep_destroy(cache->index);
+    pfree(cache);
+  }
+  MEOS_GEOS_PREPARED_CACHE = NULL;
+  return;
+}
+#else
+/**
+ * @brief Prepared geometry kept in the @p fn_extra field of an external
+ * function, as done by PostGIS in @p GetPrepGeomCache
+ * @details In a query such as a geofence the same constant geometry is
+ * tested against every row, so that it is only prepared once per query
+ */
+struct GEOSPreparedFnCache
+{
+  FmgrInfo *flinfo;                     /**< Function owning the cache */
+  MemoryContextCallback callback;       /**< Callback releasing the cache */
+  GSERIALIZED *gs;                      /**< Copy of the geometry (key) */
+  GEOSGeometry *geom;                   /**< GEOS geometry */
+  const GEOSPreparedGeometry *prepared; /**< GEOS prepared geometry */
+};
+
+/**
+ * @brief Destroy the GEOS prepared geometry kept in the @p fn_extra field of
+ * a function when its memory context is reset or deleted
+ */
+static void
+geom_prepared_fncache_free(void *arg)
+{
+  GEOSPreparedFnCache *cache = (GEOSPreparedFnCache *) arg;
+  if (cache->gs)
+  {
+    initGEOS(lwnotice, lwgeom_geos_error);
+    GEOSPreparedGeom_destroy(cache->prepared);
+    GEOSGeom_destroy(cache->geom);
+    finishGEOS();
+  }
+  /* The memory of the cache is released with the memory context */
+  return;
+}
+
+/**
+ * @brief Return the cache kept in the @p fn_extra field of a function for
+ * the geometries prepared by #geom_prepare, creating it if needed
+ * @param[in] flinfo Function information, may be NULL when the function is
+ * called directly, in which case the geometries are not cached
+ * @note The @p fn_extra field of the function must not be used for other
+ * purposes
+ */
+GEOSPreparedFnCache *
+geom_prepared_fncache(FmgrInfo *flinfo)
+{
+  if (! flinfo)
+    return NULL;
+  if (! flinfo->fn_extra)
+  {
+    GEOSPreparedFnCache *cache = MemoryContextAllocZero(flinfo->fn_mcxt,
+      sizeof(GEOSPreparedFnCache));
+    cache->flinfo = flinfo;
+    cache->callback.func = geom_prepared_fncache_free;
+    cache->callback.arg = (void *) cache;
+    MemoryContextRegisterResetCallback(flinfo->fn_mcxt, &cache->callback);
+    flinfo->fn_extra = cache;
+  }
+  return (GEOSPreparedFnCache *) flinfo->fn_extra;
+}
+#endif /* MEOS */
+
+/**
+ * @brief Get a GEOS prepared geometry for a geometry
+ * @details In MEOS, the prepared geometries are kept in a cache keyed by the
+ * bytes of the geometry, so that testing many temporal values against the
+ * same geometry prepares it only once. When the cache is full the least used
+ * entry is evicted. In PostgreSQL, the last prepared geometry is kept in the
+ * cache of the calling function given as argument, if any.
+ * @param[in] gs Geometry
+ * @param[in] fncache Cache of the calling function obtained with
+ * #geom_prepared_fncache, may be NULL. It must be NULL in MEOS.
+ * @param[out] result Prepared geometry, to be released with
+ * #geom_prepared_free
+ * @return On error return false
+ * @note The function must be called after `initGEOS`
+ */
+bool
+geom_prepare(const GSERIALIZED *gs, GEOSPreparedFnCache *fncache,
+  MEOSPreparedGeom *result)
+{
+  assert(gs); assert(result);
+#if MEOS
+  assert(! fncache);
+  GEOSPreparedCache *cache = MEOS_GEOS_PREPARED_CACHE;
+  if (! cache)
+  {
+    cache = palloc(sizeof(GEOSPreparedCache));
+    cache->count = 0;
+    cache->index = geosprep_create(GEOS_PREPARED_CACHE_ITEMS, NULL);
+    MEOS_GEOS_PREPARED_CACHE = cache;
+  }
+  GEOSPreparedCacheEntry *entry = geosprep_lookup(cache->index, gs);
+  if (entry)
+  {
+    GEOSPreparedCacheItem *item = &cache->items[entry->position];
+    item->hits++;
+    result->geom = item->geom;
+    result->prepared = item->prepared;
+    result->cached = true;
+    return true;
+  }
+#else
+  GEOSPreparedFnCache *cache = fncache;
+  if (cache && cache->gs && gserialized_bytes_eq(cache->gs, gs))
+  {
+    result->geom = cache->geom;
+    result->prepared = cache->prepared;
+    result->cached = true;
+    return true;
+  }
+#endif /* MEOS */
+
+  GEOSGeometry *geom = POSTGIS2GEOS(gs);
+  if (! geom)
+    return false;
+  MEOS_STATS_START(start);
+  const GEOSPreparedGeometry *prepared = GEOSPrepare(geom);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
+  if (! prepared)
+  {
+    GEOSGeom_destroy(geom);
+    meos_error(ERROR, MEOS_ERR_INTERNAL_ERROR,
+      "Unable to prepare the geometry with GEOS");
+    return false;
+  }
+  result->geom = geom;
+  result->prepared = prepared;
+  result->cached = false;
+
+#if MEOS
+  /* If the cache is full then find the least used element and delete it */
+  uint32_t position = cache->count;
+  uint64_t hits = 1;
+  if (position == GEOS_PREPARED_CACHE_ITEMS)
+  {
+    position = 0;
+    hits = cache->items[0].hits;
+    for (uint32_t i = 1; i < GEOS_PREPARED_CACHE_ITEMS; i++)
+    {
+      if (cache->items[i].hits < hits)
+      {
+        position = i;
+        hits = cache->items[i].hits;
+      }
+    }
+    GEOSPreparedCacheItem *item = &cache->items[position];
+    geosprep_delete(cache->index, item->gs);
+    GEOSPreparedGeom_destroy(item->prepared);
+    GEOSGeom_destroy(item->geom);
+    pfree(item->gs);
+    /* Avoid evicting the new element next */
+    hits += 5;
+  }
+  else
+    cache->count++;
+
+  /* Store everything in the new cache entry */
+  GEOSPreparedCacheItem *item = &cache->items[position];
+  item->gs = palloc(VARSIZE(gs));
+  memcpy(item->gs, gs, VARSIZE(gs));
+  item->geom = geom;
+  item->prepared = prepared;
+  item->hits = hits;
+  bool found;
+  GEOSPreparedCacheEntry *entry1 = geosprep_insert(cache->index, item->gs,
+    &found);
+  entry1->position = position;
+  result->cached = true;
+#else
+  if (cache)
+  {
+    /* Replace the geometry kept in the cache */
+    if (cache->gs)
+    {
+      GEOSPreparedGeom_destroy(cache->prepared);
+      GEOSGeom_destroy(cache->geom);
+      pfree(cache->gs);
+    }
+    cache->gs = MemoryContextAlloc(cache->flinfo->fn_mcxt, VARSIZE(gs));
+    memcpy(cache->gs, gs, VARSIZE(gs));
+    cache->geom = geom;
+    cache->prepared = prepared;
+    result->cached = true;
+  }
+#endif /* MEOS */
+  return true;
+}
+
+/**
+ * @brief Release a GEOS prepared geometry obtained with #geom_prepare
+ */
+void
+geom_prepared_free(MEOSPreparedGeom *pgeom)
+{
+  if (pgeom->cached)
+    return;
+  GEOSPreparedGeom_destroy(pgeom->prepared);
+  GEOSGeom_destroy(pgeom->geom);
+  return;
+}
+
 /**
  * @brief Return true if two geometries satisfy a given spatial relationship,
  * where the function called depend on the third argument
@@ -1348,20 +1726,7 @@ geom_spatialrel(const GSERIALIZED *gs1, const GSERIALIZED *gs2, spatialRel rel)
   /* Call GEOS function */
   assert(rel == INTERSECTS || rel == CONTAINS || rel == TOUCHES ||
     rel == COVERS);
-  switch (rel)
-  {
-    case INTERSECTS:
-      return (bool) meos_call_geos2(gs1, gs2, &GEOSIntersects);
-    case CONTAINS:
-      return (bool) meos_call_geos2(gs1, gs2, &GEOSContains);
-    case TOUCHES:
-      return (bool) meos_call_geos2(gs1, gs2, &GEOSTouches);
-    case COVERS:
-      return (bool) meos_call_geos2(gs1, gs2, &GEOSCovers);
-    default:
-      /* keep compiler quiet */
-      return false;
-  }
+  return (bool) meos_call_geos2(gs1, gs2, rel);
 }
 
 /**
@@ -1474,7 +1839,9 @@ geom_relate_pattern(const GSERIALIZED *gs1, const GSERIALIZED *gs2, char *p)
     if ( p[i] == 'f' ) p[i] = 'F';
   }
 
+  MEOS_STATS_START(start);
   char result = GEOSRelatePattern(geos1, geos2, p);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
   GEOSGeom_destroy(geos1);
   GEOSGeom_destroy(geos2);
 
@@ -1498,7 +1865,9 @@ geom_intersection2d(const GSERIALIZED *gs1, const GSERIALIZED *gs2)
   assert(gs1); assert(gs2);
   LWGEOM *geom1 = lwgeom_from_gserialized(gs1);
   LWGEOM *geom2 = lwgeom_from_gserialized(gs2);
+  MEOS_STATS_START(start);
   LWGEOM *lwresult = lwgeom_intersection_prec(geom1, geom2, -1);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
   GSERIALIZED *result = geo_serialize(lwresult);
   lwgeom_free(geom1); lwgeom_free(geom2); lwgeom_free(lwresult);
   return result;
@@ -1517,7 +1886,9 @@ geom_difference2d(const GSERIALIZED *gs1, const GSERIALIZED *gs2)
   assert(gs1); assert(gs2);
   LWGEOM *geom1 = lwgeom_from_gserialized(gs1);
   LWGEOM *geom2 = lwgeom_from_gserialized(gs2);
+  MEOS_STATS_START(start);
   LWGEOM *lwresult = lwgeom_difference_prec(geom1, geom2, -1);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
   GSERIALIZED *result = geo_serialize(lwresult);
   lwgeom_free(geom1); lwgeom_free(geom2); lwgeom_free(lwresult);
   return result;
@@ -1613,7 +1984,9 @@ geom_array_union(GSERIALIZED **gsarr, int count)
       return NULL;
     }
 
+    MEOS_STATS_START(start);
     g_union = GEOSUnaryUnion(g);
+    MEOS_STATS_END(MEOS_STAT_GEOS, start);
     GEOSGeom_destroy(g);
     if (! g_union)
     {
@@ -1664,7 +2037,9 @@ geom_unary_union(GSERIALIZED *gs, double prec)
 {
   assert(gs);
   LWGEOM *lwgeom = lwgeom_from_gserialized(gs) ;
+  MEOS_STATS_START(start);
   LWGEOM *lwresult = lwgeom_unaryunion_prec(lwgeom, prec);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
   GSERIALIZED *result = geo_serialize(lwresult);
   lwgeom_free(lwgeom); lwgeom_free(lwresult);
   return result;
@@ -1698,7 +2073,9 @@ geom_convex_hull(const GSERIALIZED *gs)
     return NULL;
   }
 
+  MEOS_STATS_START(start);
   GEOSGeometry *geos2 = GEOSConvexHull(geos1);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
   GEOSGeom_destroy(geos1);
 
   if (! geos2)
@@ -1909,7 +2286,9 @@ geom_buffer(const GSERIALIZED *gs, double size, char *params)
       GEOSBufferParams_setQuadrantSegments(bufferparams, quadsegs) &&
       GEOSBufferParams_setSingleSided(bufferparams, singleside))
     {
+      MEOS_STATS_START(start);
       g3 = GEOSBufferWithParams(g1, bufferparams, size);
+      MEOS_STATS_END(MEOS_STAT_GEOS, start);
     }
     else
     {
@@ -2093,7 +2472,9 @@ geo_equals(const GSERIALIZED *gs1, const GSERIALIZED *gs2)
     return -1;
   }
 
+  MEOS_STATS_START(start);
   int result = GEOSEquals(geos1, geos2);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
   GEOSGeom_destroy(geos1);
   GEOSGeom_destroy(geos2);
 
@@ -2200,7 +2581,9 @@ geo_transform(GSERIALIZED *gs, int32_t srid_to)
 
   /* now we have a geometry, and input/output PJ structs. */
   LWGEOM *lwgeom = lwgeom_from_gserialized(gs);
+  MEOS_STATS_START(start);
   lwgeom_transform(lwgeom, pj);
+  MEOS_STATS_END(MEOS_STAT_PROJ, start);
   lwgeom->srid = srid_to;
 
   /* Re-compute bbox if input had one (COMPUTE_BBOX TAINTING) */
@@ -2229,7 +2612,9 @@ geo_transform_pipeline(const GSERIALIZED *gs, char *pipeline, int32_t srid_to,
 {
   assert(gs); assert(pipeline);
   LWGEOM *geom = lwgeom_from_gserialized(gs);
+  MEOS_STATS_START(start);
   int rv = lwgeom_transform_pipeline(geom, pipeline, is_forward);
+  MEOS_STATS_END(MEOS_STAT_PROJ, start);
 
   if (rv == LW_FAILURE)
   {
@@ -45,6 +45,7 @@
 /* MEOS */
 #include <meos.h>
 #include <meos_internal_geo.h>
+#include "temporal/meos_stats.h"
 #include "temporal/postgres_types.h"
 #include "temporal/set.h"
 #include "temporal/span.h"
@@ -55,6 +56,7 @@
 #include "geo/postgis_funcs.h"
 #include "geo/tgeo.h"
 #include "geo/tgeo_spatialfuncs.h"
+#include "geo/tspatial.h"
 #include "geo/tspatial_parser.h"
 #if CBUFFER
   #include "cbuffer/cbuffer.h"
@@ -1626,8 +1628,11 @@ stbox_transf_pj(const STBox *box, int32_t srid_to, const LWPROJ *pj)
     lwpoint_make3dz(box->srid, box->xmax, box->ymax, box->zmax) : 
     lwpoint_make2d(box->srid, box->xmax, box->ymax);
 
-  if (! lwgeom_transform((LWGEOM *) min, (LWPROJ *) pj) || 
-      ! lwgeom_transform((LWGEOM *) max, (LWPROJ *) pj))
+  MEOS_STATS_START(start);
+  bool transformed = lwgeom_transform((LWGEOM *) min, (LWPROJ *) pj) &&
+    lwgeom_transform((LWGEOM *) max, (LWPROJ *) pj);
+  MEOS_STATS_END(MEOS_STAT_PROJ, start);
+  if (! transformed)
   {
     lwpoint_free(min); lwpoint_free(max);
     return NULL;
@@ -1709,7 +1714,7 @@ stbox_transform_pipeline(const STBox *box, const char *pipeline,
   /* There is NO test verifying whether the input and output SRIDs are equal */
 
   /* Get the structure with information about the projection */
-  LWPROJ *pj = lwproj_from_str_pipeline(pipeline, is_forward);
+  LWPROJ *pj = meos_lwproj_from_str_pipeline(pipeline, is_forward);
   if (! pj)
     return NULL;
 
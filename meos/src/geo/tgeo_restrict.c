@@ -42,17 +42,21 @@
 #include <liblwgeom.h>
 #include <liblwgeom_internal.h>
 #include <lwgeodetic.h>
+#include <lwgeom_geos.h>
+#include <lwgeom_log.h>
 /* MEOS */
 #include <meos.h>
 #include <meos_internal.h>
 #include <meos_internal_geo.h>
 #include "temporal/lifting.h"
+#include "temporal/meos_stats.h"
 #include "temporal/span.h"
 #include "temporal/temporal_restrict.h"
 #include "temporal/tsequence.h"
 #include "temporal/type_util.h"
 #include "geo/postgis_funcs.h"
 #include "geo/tgeo.h"
+#include "geo/tgeo_restrict.h"
 #include "geo/tgeo_spatialfuncs.h"
 #include "geo/tgeo_spatialrels.h"
 
@@ -1746,21 +1750,241 @@ tpointseq_interperiods(const TSequence *seq, const GSERIALIZED *gsinter,
   return result;
 }
 
+/**
+ * @brief Structure storing the state of the segment-wise restriction of a
+ * temporal point sequence to a geometry
+ */
+typedef struct
+{
+  GBOX box;                /**< Box of the geometry */
+  MEOSPreparedGeom pgeom;  /**< Prepared geometry */
+  Span *periods;           /**< Periods found so far */
+  int npers;               /**< Number of periods found so far */
+  int maxpers;             /**< Size of the array of periods */
+} SegmAtGeomState;
+
+/**
+ * @brief Return the timestamp at which a segment of a temporal point sequence
+ * is at a point located on the segment
+ */
+static TimestampTz
+tpointsegm_timestamp_at_point2d(const TInstant *inst1, const TInstant *inst2,
+  const POINT2D *p1, const POINT2D *p2, const POINT2D *p)
+{
+  if (p->x == p1->x && p->y == p1->y)
+    return inst1->t;
+  if (p->x == p2->x && p->y == p2->y)
+    return inst2->t;
+  double fraction = (double) closest_point2d_on_segment_ratio(p, p1, p2, NULL);
+  double duration = (double) (inst2->t - inst1->t);
+  return inst1->t + (TimestampTz) (duration * fraction);
+}
+
+/**
+ * @brief Add to the state the period during which a temporal point sequence
+ * is in the geometry
+ * @param[in] seq Temporal point sequence
+ * @param[in] state State of the restriction
+ * @param[in] t1,t2 Timestamps defining the period, may be equal
+ */
+static void
+tpointseq_at_geom_add_period(const TSequence *seq, SegmAtGeomState *state,
+  TimestampTz t1, TimestampTz t2)
+{
+  TimestampTz lower = Min(t1, t2), upper = Max(t1, t2);
+  bool lower_inc = (lower == DatumGetTimestampTz(seq->period.lower)) ?
+    seq->period.lower_inc : true;
+  bool upper_inc = (upper == DatumGetTimestampTz(seq->period.upper)) ?
+    seq->period.upper_inc : true;
+  /* An instant at an exclusive bound of the sequence is not added */
+  if (lower == upper && (! lower_inc || ! upper_inc))
+    return;
+  if (state->npers == state->maxpers)
+  {
+    state->maxpers *= 2;
+    state->periods = repalloc(state->periods, sizeof(Span) * state->maxpers);
+  }
+  span_set(TimestampTzGetDatum(lower), TimestampTzGetDatum(upper), lower_inc,
+    upper_inc, T_TIMESTAMPTZ, T_TSTZSPAN, &state->periods[state->npers++]);
+  return;
+}
+
+/**
+ * @brief Return 2 if the geometry covers the 2D trajectory of the instants of
+ * a temporal point sequence in the range [from, to], 1 if it intersects it
+ * without covering it, 0 if it does not intersect it, and -1 on error
+ * @param[in] seq Temporal point sequence
+ * @param[in] state State of the restriction
+ * @param[in] from,to Positions of the first and last instants of the range
+ * @param[out] geom GEOS geometry of the trajectory if the result is 1, it must
+ * be freed by the calling function
+ */
+static int
+tpointseq_geom_rel(const TSequence *seq, SegmAtGeomState *state, int from,
+  int to, GEOSGeometry **geom)
+{
+  /* Bounding box test */
+  double xmin = DBL_MAX, xmax = -DBL_MAX, ymin = DBL_MAX, ymax = -DBL_MAX;
+  for (int i = from; i <= to; i++)
+  {
+    const POINT2D *p = DATUM_POINT2D_P(tinstant_value_p(
+      TSEQUENCE_INST_N(seq, i)));
+    xmin = Min(xmin, p->x); xmax = Max(xmax, p->x);
+    ymin = Min(ymin, p->y); ymax = Max(ymax, p->y);
+  }
+  if (xmax < state->box.xmin || xmin > state->box.xmax ||
+      ymax < state->box.ymin || ymin > state->box.ymax)
+    return 0;
+
+  /* Trajectory of the range, which is a point if the range is stationary */
+  bool ispoint = (xmin == xmax && ymin == ymax);
+  GEOSGeometry *traj;
+  if (ispoint)
+    traj = GEOSGeom_createPointFromXY(xmin, ymin);
+  else
+  {
+    GEOSCoordSequence *coords = GEOSCoordSeq_create(to - from + 1, 2);
+    for (int i = from; i <= to; i++)
+    {
+      const POINT2D *p = DATUM_POINT2D_P(tinstant_value_p(
+        TSEQUENCE_INST_N(seq, i)));
+      GEOSCoordSeq_setXY(coords, i - from, p->x, p->y);
+    }
+    traj = GEOSGeom_createLineString(coords);
+  }
+  int result = -1;
+  MEOS_STATS_START(start);
+  char res = GEOSPreparedIntersects(state->pgeom.prepared, traj);
+  if (res == 0)
+    result = 0;
+  else if (res == 1)
+  {
+    /* A trajectory reduced to a point is covered if it intersects */
+    res = ispoint ? 1 : GEOSPreparedCovers(state->pgeom.prepared, traj);
+    if (res != 2)
+      result = (res == 1) ? 2 : 1;
+  }
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
+  if (result == 1)
+  {
+    *geom = traj;
+    return 1;
+  }
+  GEOSGeom_destroy(traj);
+  if (result < 0)
+    meos_error(ERROR, MEOS_ERR_INTERNAL_TYPE_ERROR, "GEOS returned error");
+  return result;
+}
+
+/**
+ * @brief Add to the state the periods during which the instants of a
+ * temporal point sequence in the range [from, to] are in the geometry
+ * @details The range is discarded if it does not intersect the geometry and
+ * its whole period is added if the geometry covers it. Otherwise, the range is
+ * split in two halves until it is reduced to a single segment, for which
+ * the intersection with the geometry is computed to obtain the fractions of
+ * the segment at which it enters and exits the geometry. In this way, GEOS
+ * only computes the intersection of the segments that cross the boundary of
+ * the geometry, while the number of predicates evaluated is logarithmic in
+ * the number of segments of the runs that are either inside or outside the
+ * geometry.
+ * @return On error return false
+ */
+static bool
+tpointseq_at_geom_iter(const TSequence *seq, SegmAtGeomState *state,
+  int from, int to)
+{
+  GEOSGeometry *traj = NULL;
+  int rel = tpointseq_geom_rel(seq, state, from, to, &traj);
+  if (rel < 0)
+    return false;
+  if (rel == 0)
+    return true;
+  const TInstant *inst1 = TSEQUENCE_INST_N(seq, from);
+  const TInstant *inst2 = TSEQUENCE_INST_N(seq, to);
+  if (rel == 2)
+  {
+    tpointseq_at_geom_add_period(seq, state, inst1->t, inst2->t);
+    return true;
+  }
+  if (to - from > 1)
+  {
+    GEOSGeom_destroy(traj);
+    int mid = (from + to) / 2;
+    return tpointseq_at_geom_iter(seq, state, from, mid) &&
+      tpointseq_at_geom_iter(seq, state, mid, to);
+  }
+
+  /* Compute the intersection of the segment and the geometry */
+  MEOS_STATS_START(start);
+  GEOSGeometry *inter = GEOSIntersection(traj, state->pgeom.geom);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
+  GEOSGeom_destroy(traj);
+  if (! inter)
+  {
+    meos_error(ERROR, MEOS_ERR_INTERNAL_TYPE_ERROR,
+      "Error performing intersection");
+    return false;
+  }
+  LWGEOM *geom_inter = GEOS2LWGEOM(inter, 0);
+  GEOSGeom_destroy(inter);
+  if (! geom_inter)
+  {
+    meos_error(ERROR, MEOS_ERR_INTERNAL_TYPE_ERROR,
+      "GEOS2LWGEOM returned NULL");
+    return false;
+  }
+  const POINT2D *p1 = DATUM_POINT2D_P(tinstant_value_p(inst1));
+  const POINT2D *p2 = DATUM_POINT2D_P(tinstant_value_p(inst2));
+  /* Each element of the intersection is either a point or a linestring */
+  LWCOLLECTION *coll = lwgeom_is_collection(geom_inter) ?
+    lwgeom_as_lwcollection(geom_inter) : NULL;
+  int ninter = coll ? (int) coll->ngeoms : 1;
+  for (int i = 0; i < ninter; i++)
+  {
+    LWGEOM *subgeom = coll ? coll->geoms[i] : geom_inter;
+    if (lwgeom_is_empty(subgeom))
+      continue;
+    POINTARRAY *pa = (subgeom->type == POINTTYPE) ?
+      lwgeom_as_lwpoint(subgeom)->point : lwgeom_as_lwline(subgeom)->points;
+    /* The linestrings are collinear with the segment, their extreme points
+     * define the period during which the segment is in the geometry */
+    TimestampTz lower = 0, upper = 0; /* make compiler quiet */
+    for (uint32_t j = 0; j < pa->npoints; j++)
+    {
+      TimestampTz t = tpointsegm_timestamp_at_point2d(inst1, inst2, p1, p2,
+        getPoint2d_cp(pa, j));
+      if (j == 0 || t < lower)
+        lower = t;
+      if (j == 0 || t > upper)
+        upper = t;
+    }
+    tpointseq_at_geom_add_period(seq, state, lower, upper);
+  }
+  lwgeom_free(geom_inter);
+  return true;
+}
+
 /**
  * @brief Return a temporal point sequence with linear interpolation
  * restricted to a geometry
- * @details The computation is based on the PostGIS function @p ST_Intersection
- * which delegates the computation to GEOS. The geometry must be in 2D.
- * When computing the intersection the Z values of the temporal point must
- * be dropped since the Z values "are copied, averaged or interpolated"
- * as stated in https://postgis.net/docs/ST_Intersection.html
- * After this computation, the Z values are recovered by restricting the
- * original sequence to the time span of the 2D result.
+ * @details The computation is done on the segments of the sequence with a
+ * geometry that is prepared by GEOS only once, as explained in
+ * #tpointseq_at_geom_iter. This avoids computing with GEOS the intersection
+ * of the whole trajectory of the temporal point and the geometry, which
+ * requires to split the temporal point into non self-intersecting fragments
+ * to recover the time dimension from the intersection. The computation only
+ * considers the X and Y coordinates of the segments and the Z values are
+ * recovered by restricting the original sequence to the resulting periods.
+ * @param[in] seq Temporal point
+ * @param[in] gs Geometry
+ * @param[in] fncache Cache of the prepared geometry, may be NULL
  * @pre The arguments have the same SRID, the geometry is 2D and is not empty.
  * This is verified in #tgeo_restrict_geom
  */
 static TSequenceSet *
-tpointseq_linear_at_geom(const TSequence *seq, const GSERIALIZED *gs)
+tpointseq_linear_at_geom(const TSequence *seq, const GSERIALIZED *gs,
+  GEOSPreparedFnCache *fncache)
 {
   assert(MEOS_FLAGS_LINEAR_INTERP(seq->flags)); assert(seq->count > 1);
 
@@ -1772,79 +1996,32 @@ tpointseq_linear_at_geom(const TSequence *seq, const GSERIALIZED *gs)
   if (! overlaps_stbox_stbox(&box1, &box2))
     return NULL;
 
-  /* Convert the point to 2D before computing the restriction to geometry */
-  bool hasz = MEOS_FLAGS_GET_Z(seq->flags);
-  TSequence *seq2d = hasz ?
-    (TSequence *) tpoint_force2d((Temporal *) seq) : (TSequence *) seq;
-
-  /* Split the temporal point in an array of non self-intersecting fragments
-   * to be able to recover the time dimension after obtaining the spatial
-   * intersection */
-  int nsimple;
-  TSequence **simpleseqs = tpointseq_make_simple(seq2d, &nsimple);
-  Span *allperiods = NULL; /* make compiler quiet */
-  int totalpers = 0;
-  GSERIALIZED *traj, *inter;
-
-  if (nsimple == 1)
+  SegmAtGeomState state;
+  memset(&state, 0, sizeof(SegmAtGeomState));
+  if (gserialized_get_gbox_p(gs, &state.box) == LW_FAILURE)
+    return NULL;
+  initGEOS(lwnotice, lwgeom_geos_error);
+  if (! geom_prepare(gs, fncache, &state.pgeom))
   {
-    /* Particular case when the input sequence is simple */
-    pfree_array((void **) simpleseqs, nsimple);
-    traj = tpointseq_linear_trajectory(seq2d, UNARY_UNION_NO);
-    inter = geom_intersection2d(traj, gs);
-    if (! gserialized_is_empty(inter))
-      allperiods = tpointseq_interperiods(seq2d, inter, &totalpers);
-    pfree(inter); pfree(traj);
-    if (totalpers == 0)
-    {
-      if (hasz)
-        pfree(seq2d);
-      return NULL;
-    }
+    finishGEOS();
+    return NULL;
   }
-  else
+  state.maxpers = 16;
+  state.periods = palloc(sizeof(Span) * state.maxpers);
+  bool ok = tpointseq_at_geom_iter(seq, &state, 0, seq->count - 1);
+  geom_prepared_free(&state.pgeom);
+  finishGEOS();
+  if (! ok || state.npers == 0)
   {
-    /* General case */
-    if (hasz)
-      pfree(seq2d);
-    Span **periods = palloc(sizeof(Span *) * nsimple);
-    int *npers = palloc0(sizeof(int) * nsimple);
-    /* Loop for every simple fragment of the sequence */
-    for (int i = 0; i < nsimple; i++)
-    {
-      traj = tpointseq_linear_trajectory(simpleseqs[i], UNARY_UNION_NO);
-      inter = geom_intersection2d(traj, gs);
-      if (! gserialized_is_empty(inter))
-      {
-        periods[i] = tpointseq_interperiods(simpleseqs[i], inter, &npers[i]);
-        totalpers += npers[i];
-      }
-      pfree(inter); pfree(traj);
-    }
-    pfree_array((void **) simpleseqs, nsimple);
-    if (totalpers == 0)
-    {
-      pfree(periods); pfree(npers);
-      return NULL;
-    }
-
-    /* Assemble the periods into a single array */
-    allperiods = palloc(sizeof(Span) * totalpers);
-    int k = 0;
-    for (int i = 0; i < nsimple; i++)
-    {
-      for (int j = 0; j < npers[i]; j++)
-        allperiods[k++] = periods[i][j];
-      if (npers[i] != 0)
-        pfree(periods[i]);
-    }
-    pfree(periods); pfree(npers);
-    /* It is necessary to sort the periods */
-    spanarr_sort(allperiods, totalpers);
+    pfree(state.periods);
+    return NULL;
   }
-  /* Compute the periodset */
-  assert(totalpers > 0);
-  SpanSet *ss = spanset_make_free(allperiods, totalpers, NORMALIZE, ORDER);
+
+  /* Compute the periodset. The periods of a segment may not be ordered and
+   * consecutive ranges may share their bounds */
+  spanarr_sort(state.periods, state.npers);
+  SpanSet *ss = spanset_make_free(state.periods, state.npers, NORMALIZE,
+    ORDER);
   /* Recover the Z values from the original sequence */
   TSequenceSet *result = tcontseq_restrict_tstzspanset(seq, ss, REST_AT);
   pfree(ss);
@@ -1864,6 +2041,7 @@ tpointseq_linear_at_geom(const TSequence *seq, const GSERIALIZED *gs)
  * @param[in] gs Geometry
  * @param[in] zspan Span of values to restrict the Z dimension
  * @param[in] atfunc True if the restriction is `at`, false for `minus`
+ * @param[in] fncache Cache of the prepared geometry, may be NULL
  * @note The function computes the "at" restriction on all dimensions. Then,
  * for the "minus" restriction, it computes the complement of the "at"
  * restriction with respect to the time dimension.
@@ -1871,14 +2049,14 @@ tpointseq_linear_at_geom(const TSequence *seq, const GSERIALIZED *gs)
  */
 TSequenceSet *
 tpointseq_linear_restrict_geom(const TSequence *seq, const GSERIALIZED *gs,
-  const Span *zspan, bool atfunc)
+  const Span *zspan, bool atfunc, GEOSPreparedFnCache *fncache)
 {
   VALIDATE_TPOINT(seq, NULL); VALIDATE_NOT_NULL(gs, NULL); 
   assert(MEOS_FLAGS_LINEAR_INTERP(seq->flags));
   assert(seq->count > 1);
 
   /* Compute atGeometry for the sequence */
-  TSequenceSet *at_xy = tpointseq_linear_at_geom(seq, gs);
+  TSequenceSet *at_xy = tpointseq_linear_at_geom(seq, gs, fncache);
 
   /* Restrict to the Z dimension */
   TSequenceSet *result_at = NULL;
@@ -1928,17 +2106,17 @@ tpointseq_linear_restrict_geom(const TSequence *seq, const GSERIALIZED *gs,
 }
 
 /**
- * @ingroup meos_internal_geo_restrict
  * @brief Return a temporal geo sequence restricted to (the complement of) a
  * geometry and possibly a Z span and a timestamptz span
  * @param[in] seq Temporal geo
  * @param[in] gs Geometry
  * @param[in] zspan Span of values to restrict the Z dimension
  * @param[in] atfunc True if the restriction is `at`, false for `minus`
+ * @param[in] fncache Cache of the prepared geometry, may be NULL
  */
-Temporal *
-tgeoseq_restrict_geom(const TSequence *seq, const GSERIALIZED *gs,
-  const Span *zspan, bool atfunc)
+static Temporal *
+tgeoseq_restrict_geom_int(const TSequence *seq, const GSERIALIZED *gs,
+  const Span *zspan, bool atfunc, GEOSPreparedFnCache *fncache)
 {
   assert(seq); assert(gs); assert(tgeo_type_all(seq->temptype));
   interpType interp = MEOS_FLAGS_GET_INTERP(seq->flags);
@@ -1971,29 +2149,45 @@ tgeoseq_restrict_geom(const TSequence *seq, const GSERIALIZED *gs,
       gs, zspan, atfunc);
   else /* interp == LINEAR */
     return (Temporal *) tpointseq_linear_restrict_geom((TSequence *) seq,
-      gs, zspan, atfunc);
+      gs, zspan, atfunc, fncache);
 }
 
 /**
  * @ingroup meos_internal_geo_restrict
+ * @brief Return a temporal geo sequence restricted to (the complement of) a
+ * geometry and possibly a Z span and a timestamptz span
+ * @param[in] seq Temporal geo
+ * @param[in] gs Geometry
+ * @param[in] zspan Span of values to restrict the Z dimension
+ * @param[in] atfunc True if the restriction is `at`, false for `minus`
+ */
+Temporal *
+tgeoseq_restrict_geom(const TSequence *seq, const GSERIALIZED *gs,
+  const Span *zspan, bool atfunc)
+{
+  return tgeoseq_restrict_geom_int(seq, gs, zspan, atfunc, NULL);
+}
+
+/**
  * @brief Return a temporal geo sequence set restricted to (the complement
  * of) a geometry and possibly a Z span and a timestamptz span
  * @param[in] ss Temporal geo
  * @param[in] gs Geometry
  * @param[in] zspan Span of values to restrict the Z dimension
  * @param[in] atfunc True if the restriction is `at`, false for `minus`
+ * @param[in] fncache Cache of the prepared geometry, may be NULL
  */
-TSequenceSet *
-tgeoseqset_restrict_geom(const TSequenceSet *ss, const GSERIALIZED *gs,
-  const Span *zspan, bool atfunc)
+static TSequenceSet *
+tgeoseqset_restrict_geom_int(const TSequenceSet *ss, const GSERIALIZED *gs,
+  const Span *zspan, bool atfunc, GEOSPreparedFnCache *fncache)
 {
   assert(ss); assert(gs); assert(tgeo_type_all(ss->temptype));
 
   /* Singleton sequence set */
   if (ss->count == 1)
     /* We can safely cast since the composing sequences are continuous */
-    return (TSequenceSet *) tgeoseq_restrict_geom(TSEQUENCESET_SEQ_N(ss, 0), 
-      gs, zspan, atfunc);
+    return (TSequenceSet *) tgeoseq_restrict_geom_int(
+      TSEQUENCESET_SEQ_N(ss, 0), gs, zspan, atfunc, fncache);
 
   /* General case */
   STBox box2;
@@ -2014,8 +2208,8 @@ tgeoseqset_restrict_geom(const TSequenceSet *ss, const GSERIALIZED *gs,
     else
     {
       /* We can safely cast since the composing sequences are continuous */
-      seqsets[i] = (TSequenceSet *) tgeoseq_restrict_geom(seq, gs, zspan,
-        atfunc);
+      seqsets[i] = (TSequenceSet *) tgeoseq_restrict_geom_int(seq, gs, zspan,
+        atfunc, fncache);
       if (seqsets[i])
         totalseqs += seqsets[i]->count;
     }
@@ -2030,16 +2224,32 @@ tgeoseqset_restrict_geom(const TSequenceSet *ss, const GSERIALIZED *gs,
 
 /**
  * @ingroup meos_internal_geo_restrict
+ * @brief Return a temporal geo sequence set restricted to (the complement
+ * of) a geometry and possibly a Z span and a timestamptz span
+ * @param[in] ss Temporal geo
+ * @param[in] gs Geometry
+ * @param[in] zspan Span of values to restrict the Z dimension
+ * @param[in] atfunc True if the restriction is `at`, false for `minus`
+ */
+TSequenceSet *
+tgeoseqset_restrict_geom(const TSequenceSet *ss, const GSERIALIZED *gs,
+  const Span *zspan, bool atfunc)
+{
+  return tgeoseqset_restrict_geom_int(ss, gs, zspan, atfunc, NULL);
+}
+
+/**
  * @brief Return a temporal geo restricted to (the complement of) a geometry
  * and possibly a Z span
  * @param[in] temp Temporal geo
  * @param[in] gs Geometry
  * @param[in] zspan Span of values to restrict the Z dimension, may be `NULL`
  * @param[in] atfunc True if the restriction is `at`, false for `minus`
+ * @param[in] fncache Cache of the prepared geometry, may be NULL
  */
 Temporal *
-tgeo_restrict_geom(const Temporal *temp, const GSERIALIZED *gs,
-  const Span *zspan, bool atfunc)
+tgeo_restrict_geom_int(const Temporal *temp, const GSERIALIZED *gs,
+  const Span *zspan, bool atfunc, GEOSPreparedFnCache *fncache)
 {
   /* Ensure the validity of the arguments */
   VALIDATE_TGEO(temp, NULL); VALIDATE_NOT_NULL(gs, NULL); 
@@ -2092,18 +2302,34 @@ tgeo_restrict_geom(const Temporal *temp, const GSERIALIZED *gs,
         gs, zspan, atfunc);
       break;
     case TSEQUENCE:
-      result = tgeoseq_restrict_geom((TSequence *) temp1,
-        gs, zspan, atfunc);
+      result = tgeoseq_restrict_geom_int((TSequence *) temp1,
+        gs, zspan, atfunc, fncache);
       break;
     default: /* TSEQUENCESET */
-      result = (Temporal *) tgeoseqset_restrict_geom((TSequenceSet *) temp1,
-         gs, zspan, atfunc);
+      result = (Temporal *) tgeoseqset_restrict_geom_int(
+        (TSequenceSet *) temp1, gs, zspan, atfunc, fncache);
   }
   if (interp == LINEAR && atfunc)
     pfree(temp1);
   return result;
 }
 
+/**
+ * @ingroup meos_internal_geo_restrict
+ * @brief Return a temporal geo restricted to (the complement of) a geometry
+ * and possibly a Z span
+ * @param[in] temp Temporal geo
+ * @param[in] gs Geometry
+ * @param[in] zspan Span of values to restrict the Z dimension, may be `NULL`
+ * @param[in] atfunc True if the restriction is `at`, false for `minus`
+ */
+Temporal *
+tgeo_restrict_geom(const Temporal *temp, const GSERIALIZED *gs,
+  const Span *zspan, bool atfunc)
+{
+  return tgeo_restrict_geom_int(temp, gs, zspan, atfunc, NULL);
+}
+
 /*****************************************************************************/
 
 #if MEOS
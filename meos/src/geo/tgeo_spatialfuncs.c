@@ -52,6 +52,7 @@
 #include <meos_internal_geo.h>
 #include "temporal/postgres_types.h"
 #include "temporal/lifting.h"
+#include "temporal/meos_stats.h"
 #include "temporal/temporal.h"
 #include "temporal/temporal_compops.h"
 #include "temporal/tnumber_mathfuncs.h"
@@ -1736,8 +1737,10 @@ geo_cluster_dbscan(const GSERIALIZED **geoms, uint32_t ngeoms,
   for (i = 0; i < ngeoms; i++)
     lwgeoms[i] = lwgeom_from_gserialized(geoms[i]);
 
+  MEOS_STATS_START(start);
   bool success = union_dbscan(lwgeoms, ngeoms, uf, tolerance, minpoints,
     minpoints > 1 ? &is_in_cluster : NULL);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
 
   for (i = 0; i < ngeoms; i++)
     lwgeom_free(lwgeoms[i]);
@@ -1813,8 +1816,11 @@ geo_cluster_intersecting(const GSERIALIZED **geoms, uint32_t ngeoms,
 
   /* Perform the clustering */
   GEOSGeometry **geos_results;
-  if (cluster_intersecting(geos_inputs, ngeoms, &geos_results, &nclusters) !=
-    LW_SUCCESS)
+  MEOS_STATS_START(start);
+  int rv = cluster_intersecting(geos_inputs, ngeoms, &geos_results,
+    &nclusters);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
+  if (rv != LW_SUCCESS)
   {
     meos_error(ERROR, MEOS_ERR_INTERNAL_ERROR,
       "clusterintersecting: Error performing clustering");
@@ -1872,8 +1878,10 @@ geo_cluster_within(const GSERIALIZED **geoms, uint32_t ngeoms,
 
   LWGEOM **lw_results;
   uint32_t nclusters;
+  MEOS_STATS_START(start);
   bool success = cluster_within_distance(lwgeoms, ngeoms, tolerance,
     &lw_results, &nclusters);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
   /* don't need to destroy items because GeometryCollections have taken ownership */
   pfree(lwgeoms);
 
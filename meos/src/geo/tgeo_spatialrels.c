@@ -48,11 +48,16 @@
 
 /* C */
 #include <assert.h>
+/* PostGIS */
+#include <liblwgeom.h>
+#include <lwgeom_log.h>
+#include <lwgeom_geos.h>
 /* MEOS */
 #include <meos.h>
 #include <meos_internal.h>
 #include <meos_internal_geo.h>
 #include "temporal/lifting.h"
+#include "temporal/meos_stats.h"
 #include "temporal/tsequence.h"
 #include "geo/postgis_funcs.h"
 #include "geo/tgeo.h"
@@ -286,6 +291,236 @@ geo_dwithin_fn_geo(int16 flags1, uint8_t flags2)
       &datum_geom_dwithin3d : &datum_geom_dwithin2d;
 }
 
+/*****************************************************************************
+ * Segment-wise ever/always spatial relationships for temporal points
+ *****************************************************************************/
+
+/**
+ * @brief Structure storing the state of a segment-wise evaluation of a
+ * spatial relationship between a temporal point and a geometry
+ */
+typedef struct
+{
+  spatialRel rel;          /**< Relationship, either INTERSECTS or COVERS */
+  bool dwithin;            /**< True when testing dwithin instead of `rel` */
+  double dist;             /**< Distance for dwithin */
+  GBOX box;                /**< Box of the geometry, expanded by `dist` */
+  MEOSPreparedGeom pgeom;  /**< Prepared geometry for INTERSECTS and COVERS */
+  LWGEOM *geom;            /**< Geometry for dwithin */
+  LWLINE *line;            /**< Reusable segment for dwithin */
+  LWPOINT *point;          /**< Reusable point for dwithin */
+} SegmRelState;
+
+/**
+ * @brief Return true if a segment satisfies the relationship with the
+ * geometry, where the segment is a point when both end points are equal
+ * @return On error return -1
+ */
+static int
+segm_spatialrel(SegmRelState *state, const POINT2D *p1, const POINT2D *p2)
+{
+  double xmin = Min(p1->x, p2->x), xmax = Max(p1->x, p2->x);
+  double ymin = Min(p1->y, p2->y), ymax = Max(p1->y, p2->y);
+  /* A segment that is not inside the box of the geometry is not covered */
+  if (! state->dwithin && state->rel == COVERS)
+  {
+    if (xmin < state->box.xmin || xmax > state->box.xmax ||
+        ymin < state->box.ymin || ymax > state->box.ymax)
+      return 0;
+  }
+  /* A segment that does not overlap the box cannot intersect the geometry */
+  else if (xmax < state->box.xmin || xmin > state->box.xmax ||
+      ymax < state->box.ymin || ymin > state->box.ymax)
+    return 0;
+
+  bool ispoint = p1->x == p2->x && p1->y == p2->y;
+  if (state->dwithin)
+  {
+    LWGEOM *segm;
+    if (ispoint)
+    {
+      ptarray_set_point4d(state->point->point, 0,
+        &(POINT4D) {p1->x, p1->y, 0.0, 0.0});
+      segm = lwpoint_as_lwgeom(state->point);
+    }
+    else
+    {
+      ptarray_set_point4d(state->line->points, 0,
+        &(POINT4D) {p1->x, p1->y, 0.0, 0.0});
+      ptarray_set_point4d(state->line->points, 1,
+        &(POINT4D) {p2->x, p2->y, 0.0, 0.0});
+      segm = lwline_as_lwgeom(state->line);
+    }
+    double d = lwgeom_mindistance2d_tolerance(segm, state->geom, state->dist);
+    /* The bounding box may have been cached by the distance computation */
+    lwgeom_drop_bbox(segm);
+    return d <= state->dist ? 1 : 0;
+  }
+
+  GEOSGeometry *segm;
+  if (ispoint)
+    segm = GEOSGeom_createPointFromXY(p1->x, p1->y);
+  else
+  {
+    GEOSCoordSequence *seq = GEOSCoordSeq_create(2, 2);
+    GEOSCoordSeq_setXY(seq, 0, p1->x, p1->y);
+    GEOSCoordSeq_setXY(seq, 1, p2->x, p2->y);
+    segm = GEOSGeom_createLineString(seq);
+  }
+  MEOS_STATS_START(start);
+  char res = (state->rel == INTERSECTS) ?
+    GEOSPreparedIntersects(state->pgeom.prepared, segm) :
+    GEOSPreparedCovers(state->pgeom.prepared, segm);
+  MEOS_STATS_END(MEOS_STAT_GEOS, start);
+  GEOSGeom_destroy(segm);
+  if (res == 2)
+  {
+    meos_error(ERROR, MEOS_ERR_INTERNAL_TYPE_ERROR, "GEOS returned error");
+    return -1;
+  }
+  return (int) res;
+}
+
+/**
+ * @brief Return 1 if a spatial relationship between the segments of a
+ * temporal point sequence and a geometry is ever/always true, 0 if not, and
+ * -1 on error
+ */
+static int
+tpointseq_spatialrel_segm(const TSequence *seq, SegmRelState *state,
+  bool ever)
+{
+  const POINT2D *p1 = DATUM_POINT2D_P(tinstant_value_p(TSEQUENCE_INST_N(seq, 0)));
+  bool linear = MEOS_FLAGS_LINEAR_INTERP(seq->flags);
+  int res;
+  if (! linear || seq->count == 1)
+  {
+    /* Each instant is tested as a point */
+    for (int i = 0; i < seq->count; i++)
+    {
+      if (i > 0)
+        p1 = DATUM_POINT2D_P(tinstant_value_p(TSEQUENCE_INST_N(seq, i)));
+      res = segm_spatialrel(state, p1, p1);
+      if (res < 0 || (ever && res == 1) || (! ever && res == 0))
+        return res;
+    }
+    return ever ? 0 : 1;
+  }
+  for (int i = 1; i < seq->count; i++)
+  {
+    const POINT2D *p2 =
+      DATUM_POINT2D_P(tinstant_value_p(TSEQUENCE_INST_N(seq, i)));
+    res = segm_spatialrel(state, p1, p2);
+    if (res < 0 || (ever && res == 1) || (! ever && res == 0))
+      return res;
+    p1 = p2;
+  }
+  return ever ? 0 : 1;
+}
+
+/**
+ * @brief Return 1 if a spatial relationship between the trajectory of a
+ * temporal point and a geometry is ever/always true, 0 if not, and -1 on
+ * error
+ * @details The segments of the temporal point are tested one by one against
+ * the geometry, which is prepared by GEOS only once, and the function returns
+ * as soon as the result is known. This avoids constructing the trajectory of
+ * the temporal point, which is only needed to be tested as a whole by the
+ * relationship. The following cases are supported
+ * - `INTERSECTS` with ever semantics: a segment intersects the geometry
+ * - `COVERS` with always semantics: the geometry covers every segment
+ * - dwithin with ever semantics: a segment is within the distance of the
+ *   geometry, which is computed by liblwgeom for each segment
+ * @param[in] temp Temporal point
+ * @param[in] gs Geometry
+ * @param[in] rel Spatial relationship, ignored when @p dwithin is true
+ * @param[in] dwithin True when testing dwithin
+ * @param[in] dist Distance for dwithin
+ * @param[in] fncache Cache of the prepared geometry, may be NULL
+ */
+static int
+tpoint_spatialrel_segm(const Temporal *temp, const GSERIALIZED *gs,
+  spatialRel rel, bool dwithin, double dist, GEOSPreparedFnCache *fncache)
+{
+  bool ever = dwithin || rel == INTERSECTS;
+  SegmRelState state;
+  memset(&state, 0, sizeof(SegmRelState));
+  state.rel = rel;
+  state.dwithin = dwithin;
+  state.dist = dist;
+  if (gserialized_get_gbox_p(gs, &state.box) == LW_FAILURE)
+    return -1;
+  if (dwithin)
+    gbox_expand(&state.box, dist);
+
+  /* Filter with the bounding box of the temporal point */
+  STBox box;
+  tspatial_set_stbox(temp, &box);
+  if (! dwithin && rel == COVERS)
+  {
+    if (box.xmin < state.box.xmin || box.xmax > state.box.xmax ||
+        box.ymin < state.box.ymin || box.ymax > state.box.ymax)
+      return 0;
+  }
+  else if (box.xmax < state.box.xmin || box.xmin > state.box.xmax ||
+      box.ymax < state.box.ymin || box.ymin > state.box.ymax)
+    return 0;
+
+  if (dwithin)
+  {
+    state.geom = lwgeom_from_gserialized(gs);
+    state.point = lwpoint_make2d(SRID_UNKNOWN, 0.0, 0.0);
+    POINTARRAY *pa = ptarray_construct(0, 0, 2);
+    state.line = lwline_construct(SRID_UNKNOWN, NULL, pa);
+  }
+  else
+  {
+    initGEOS(lwnotice, lwgeom_geos_error);
+    if (! geom_prepare(gs, fncache, &state.pgeom))
+    {
+      finishGEOS();
+      return -1;
+    }
+  }
+
+  int result;
+  if (temp->subtype == TINSTANT)
+  {
+    const POINT2D *pt = DATUM_POINT2D_P(tinstant_value_p((TInstant *) temp));
+    result = segm_spatialrel(&state, pt, pt);
+  }
+  else if (temp->subtype == TSEQUENCE)
+    result = tpointseq_spatialrel_segm((TSequence *) temp, &state, ever);
+  else /* temp->subtype == TSEQUENCESET */
+  {
+    const TSequenceSet *ss = (TSequenceSet *) temp;
+    result = ever ? 0 : 1;
+    for (int i = 0; i < ss->count; i++)
+    {
+      int res = tpointseq_spatialrel_segm(TSEQUENCESET_SEQ_N(ss, i), &state,
+        ever);
+      if (res != result)
+      {
+        result = res;
+        break;
+      }
+    }
+  }
+
+  if (dwithin)
+  {
+    lwgeom_free(state.geom);
+    lwpoint_free(state.point);
+    lwline_free(state.line);
+  }
+  else
+  {
+    geom_prepared_free(&state.pgeom);
+    finishGEOS();
+  }
+  return result;
+}
+
 /*****************************************************************************
  * Generic ever/always spatial relationship functions
  *****************************************************************************/
@@ -301,20 +536,38 @@ geo_dwithin_fn_geo(int16 flags1, uint8_t flags2)
  * @param[in] func PostGIS function to be called
  * @param[in] numparam Number of parameters of the function
  * @param[in] invert True if the arguments should be inverted
+ * @param[in] fncache Cache of the prepared geometry, may be NULL
  * @return On error return -1
  * @note Since some GEOS versions do not support geometry collections, the
  * function iterates for each geometry of the collection and returns when the
  * function is true for one of them.
+ * @note The intersects, covers, and dwithin relationships of planar temporal
+ * points are computed segment by segment with #tpoint_spatialrel_segm
  */
 static int
 spatialrel_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, Datum param,
-  varfunc func, int numparam, bool invert)
+  varfunc func, int numparam, bool invert, GEOSPreparedFnCache *fncache)
 {
   /* Ensure the validity of the arguments */
   if (! ensure_valid_tgeo_geo(temp, gs) || gserialized_is_empty(gs))
     return -1;
 
   assert(numparam == 2 || numparam == 3);
+
+  /* Test the segments of a planar temporal point without its trajectory */
+  if (tpoint_type(temp->temptype) && ! MEOS_FLAGS_GET_GEODETIC(temp->flags) &&
+      gserialized_get_type(gs) != COLLECTIONTYPE)
+  {
+    if (func == (varfunc) &datum_geom_intersects2d)
+      return tpoint_spatialrel_segm(temp, gs, INTERSECTS, false, 0.0,
+        fncache);
+    if (func == (varfunc) &datum_geom_covers && invert)
+      return tpoint_spatialrel_segm(temp, gs, COVERS, false, 0.0, fncache);
+    if (func == (varfunc) &datum_geom_dwithin2d)
+      return tpoint_spatialrel_segm(temp, gs, INTERSECTS, true,
+        DatumGetFloat8(param), fncache);
+  }
+
   Datum geo = PointerGetDatum(gs);
   GSERIALIZED *trav = tpoint_type(temp->temptype) ?
     tpoint_trajectory(temp, UNARY_UNION_NO) : 
@@ -589,9 +842,9 @@ ea_contains_tgeo_geo_int(const Temporal *temp, const GSERIALIZED *gs, bool ever,
   char p[10] = "T********";
   int result = ever ?
     spatialrel_tgeo_geo(temp, gs, PointerGetDatum(&p),
-      (varfunc) &datum_geom_relate_pattern, 3, invert) :
+      (varfunc) &datum_geom_relate_pattern, 3, invert, NULL) :
     spatialrel_tgeo_geo(temp, gs, (Datum) NULL,
-      (varfunc) &datum_geom_contains, 2, invert);
+      (varfunc) &datum_geom_contains, 2, invert, NULL);
   return result ? 1 : 0;
 }
 
@@ -746,6 +999,7 @@ acontains_tgeo_tgeo(const Temporal *temp1, const Temporal *temp2)
  * @param[in] temp Temporal geo
  * @param[in] ever True for the ever semantics, false for the always semantics
  * @param[in] invert True if the arguments should be inverted
+ * @param[in] fncache Cache of the prepared geometry, may be NULL
  * @note Please refer to the documentation of the `ST_Covers` and `ST_Covers`
  * functions
  * https://postgis.net/docs/ST_Covers.html
@@ -754,7 +1008,7 @@ acontains_tgeo_tgeo(const Temporal *temp1, const Temporal *temp2)
  */
 int
 ea_covers_tgeo_geo_int(const Temporal *temp, const GSERIALIZED *gs, bool ever,
-  bool invert)
+  bool invert, GEOSPreparedFnCache *fncache)
 {
   VALIDATE_TGEO(temp, -1); VALIDATE_NOT_NULL(gs, -1);
   /* Ensure the validity of the arguments */
@@ -767,7 +1021,7 @@ ea_covers_tgeo_geo_int(const Temporal *temp, const GSERIALIZED *gs, bool ever,
     ea_spatialrel_tspatial_geo(temp, gs, &datum_geom_covers, EVER, invert) :
     /* Compute the result from the traversed area and the geometry */
     spatialrel_tgeo_geo(temp, gs, (Datum) NULL, (varfunc) &datum_geom_covers,
-      2, invert);
+      2, invert, fncache);
   return result ? 1 : 0;
 }
 
@@ -779,7 +1033,7 @@ ea_covers_tgeo_geo_int(const Temporal *temp, const GSERIALIZED *gs, bool ever,
 inline int
 ea_covers_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp, bool ever)
 {
-  return ea_covers_tgeo_geo_int(temp, gs, ever, INVERT);
+  return ea_covers_tgeo_geo_int(temp, gs, ever, INVERT, NULL);
 }
 
 /**
@@ -790,7 +1044,7 @@ ea_covers_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp, bool ever)
 inline int
 ea_covers_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, bool ever)
 {
-  return ea_covers_tgeo_geo_int(temp, gs, ever, INVERT_NO);
+  return ea_covers_tgeo_geo_int(temp, gs, ever, INVERT_NO, NULL);
 }
 
 #if MEOS
@@ -805,7 +1059,7 @@ ea_covers_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, bool ever)
 int
 ecovers_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp)
 {
-  return ea_covers_tgeo_geo_int(temp, gs, EVER, INVERT);
+  return ea_covers_tgeo_geo_int(temp, gs, EVER, INVERT, NULL);
 }
 
 /**
@@ -819,7 +1073,7 @@ ecovers_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp)
 int
 acovers_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp)
 {
-  return ea_covers_tgeo_geo_int(temp, gs, ALWAYS, INVERT);
+  return ea_covers_tgeo_geo_int(temp, gs, ALWAYS, INVERT, NULL);
 }
 
 /**
@@ -833,7 +1087,7 @@ acovers_geo_tgeo(const GSERIALIZED *gs, const Temporal *temp)
 int
 ecovers_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs)
 {
-  return ea_covers_tgeo_geo_int(temp, gs, EVER, INVERT_NO);
+  return ea_covers_tgeo_geo_int(temp, gs, EVER, INVERT_NO, NULL);
 }
 
 /**
@@ -847,7 +1101,7 @@ ecovers_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs)
 int
 acovers_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs)
 {
-  return ea_covers_tgeo_geo_int(temp, gs, ALWAYS, INVERT_NO);
+  return ea_covers_tgeo_geo_int(temp, gs, ALWAYS, INVERT_NO, NULL);
 }
 #endif /* MEOS */
 
@@ -910,7 +1164,6 @@ acovers_tgeo_tgeo(const Temporal *temp1, const Temporal *temp2)
  *****************************************************************************/
 
 /**
- * @ingroup meos_geo_rel_ever
  * @brief Return 1 if a temporal geometry and a geometry are ever disjoint,
  * 0 if not, and -1 on error or if the geometry is empty
  * @details
@@ -924,10 +1177,11 @@ acovers_tgeo_tgeo(const Temporal *temp1, const Temporal *temp2)
  * @param[in] temp Temporal geometry
  * @param[in] gs Geometry
  * @param[in] ever True for the ever semantics, false for the always semantics
- * @csqlfn #Edisjoint_tgeo_geo()
+ * @param[in] fncache Cache of the prepared geometry, may be NULL
  */
 int
-ea_disjoint_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, bool ever)
+ea_disjoint_tgeo_geo_int(const Temporal *temp, const GSERIALIZED *gs,
+  bool ever, GEOSPreparedFnCache *fncache)
 {
   VALIDATE_TGEO(temp, -1); VALIDATE_NOT_NULL(gs, -1);
   /* Ensure the validity of the arguments */
@@ -938,7 +1192,7 @@ ea_disjoint_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, bool ever)
   /* ALWAYS */
   if (! ever)
   {
-    return INVERT_RESULT(ea_intersects_tgeo_geo(temp, gs, EVER));
+    return INVERT_RESULT(ea_intersects_tgeo_geo_int(temp, gs, EVER, fncache));
   }
 
   /* EVER */
@@ -948,7 +1202,7 @@ ea_disjoint_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, bool ever)
   {
     datum_func2 func = &datum_geom_covers;
     result = spatialrel_tgeo_geo(temp, gs, (Datum) NULL, (varfunc) func, 2,
-      INVERT);
+      INVERT, fncache);
     return INVERT_RESULT(result);
   }
 
@@ -969,6 +1223,21 @@ ea_disjoint_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, bool ever)
   return result;
 }
 
+/**
+ * @ingroup meos_geo_rel_ever
+ * @brief Return 1 if a temporal geometry and a geometry are ever/always
+ * disjoint, 0 if not, and -1 on error or if the geometry is empty
+ * @param[in] temp Temporal geo
+ * @param[in] gs Geometry
+ * @param[in] ever True for the ever semantics, false for the always semantics
+ * @csqlfn #Edisjoint_tgeo_geo()
+ */
+int
+ea_disjoint_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, bool ever)
+{
+  return ea_disjoint_tgeo_geo_int(temp, gs, ever, NULL);
+}
+
 /**
  * @ingroup meos_geo_rel_ever
  * @brief Return 1 if a temporal geometry and a geometry are ever disjoint,
@@ -1065,7 +1334,6 @@ adisjoint_tgeo_tgeo(const Temporal *temp1, const Temporal *temp2)
  *****************************************************************************/
 
 /**
- * @ingroup meos_geo_rel_ever
  * @brief Return 1 if a temporal geometry ever/always intersects a geometry,
  * 0 if not, and -1 on error or if the geometry is empty
  * @details
@@ -1077,10 +1345,11 @@ adisjoint_tgeo_tgeo(const Temporal *temp1, const Temporal *temp2)
  * @param[in] temp Temporal geo
  * @param[in] gs Geometry
  * @param[in] ever True for the ever semantics, false for the always semantics
- * @csqlfn #Eintersects_tgeo_geo()
+ * @param[in] fncache Cache of the prepared geometry, may be NULL
  */
 int
-ea_intersects_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, bool ever)
+ea_intersects_tgeo_geo_int(const Temporal *temp, const GSERIALIZED *gs,
+  bool ever, GEOSPreparedFnCache *fncache)
 {
   VALIDATE_TGEO(temp, -1); VALIDATE_NOT_NULL(gs, -1);
   /* Ensure the validity of the arguments */
@@ -1089,12 +1358,27 @@ ea_intersects_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, bool ever)
 
   /* ALWAYS */
   if (! ever)
-    return INVERT_RESULT(ea_disjoint_tgeo_geo(temp, gs, EVER));
+    return INVERT_RESULT(ea_disjoint_tgeo_geo_int(temp, gs, EVER, fncache));
 
   /* EVER */
   datum_func2 func = geo_intersects_fn_geo(temp->flags, gs->gflags);
   return spatialrel_tgeo_geo(temp, gs, (Datum) NULL, (varfunc) func, 2,
-    INVERT_NO);
+    INVERT_NO, fncache);
+}
+
+/**
+ * @ingroup meos_geo_rel_ever
+ * @brief Return 1 if a temporal geometry ever/always intersects a geometry,
+ * 0 if not, and -1 on error or if the geometry is empty
+ * @param[in] temp Temporal geo
+ * @param[in] gs Geometry
+ * @param[in] ever True for the ever semantics, false for the always semantics
+ * @csqlfn #Eintersects_tgeo_geo()
+ */
+int
+ea_intersects_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, bool ever)
+{
+  return ea_intersects_tgeo_geo_int(temp, gs, ever, NULL);
 }
 
 /**
@@ -1459,13 +1743,13 @@ ea_dwithin_tgeo_geo(const Temporal *temp, const GSERIALIZED *gs, double dist,
   {
     datum_func3 func = geo_dwithin_fn_geo(temp->flags, gs->gflags);
     return spatialrel_tgeo_geo(temp, gs, Float8GetDatum(dist),
-      (varfunc) func, 3, INVERT_NO);
+      (varfunc) func, 3, INVERT_NO, NULL);
   }
 
   /* ALWAYS */
   GSERIALIZED *buffer = geom_buffer(gs, dist, "");
   int result = spatialrel_tgeo_geo(temp, buffer, (Datum) NULL,
-    (varfunc) &datum_geom_covers, 2, INVERT);
+    (varfunc) &datum_geom_covers, 2, INVERT, NULL);
   pfree(buffer);
   return result;
 }
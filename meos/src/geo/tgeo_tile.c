@@ -1337,6 +1337,391 @@ tgeo_space_time_tile_init(const Temporal *temp, double xsize, double ysize,
   return state;
 }
 
+/*****************************************************************************
+ * Single-pass split functions
+ *****************************************************************************/
+
+/* Tolerance in fractions of a tile used for finding the tiles traversed by
+ * a segment, this ensures that the candidate tiles of a segment are a
+ * superset of the tiles it intersects despite floating-point roundoff */
+#define TILE_SPLIT_EPSILON 1e-6
+
+/**
+ * @brief Structure storing a tile traversed by a segment of a temporal point
+ */
+typedef struct
+{
+  int64 tile;    /**< Position of the tile in the iteration order of the grid */
+  int seqno;     /**< Number of the sequence in the temporal point */
+  int segno;     /**< Number of the segment in the sequence, or number of the
+                      instant for discrete sequences */
+} TileSegm;
+
+/**
+ * @brief Structure storing the state for collecting the tiles traversed by
+ * the segments of a temporal point
+ */
+typedef struct
+{
+  int ndims;                /**< Number of dimensions of the grid */
+  int ncells[MAXDIMS];      /**< Number of tiles in each dimension */
+  int64 mult[MAXDIMS];      /**< Multipliers for the position of a tile */
+  int coords[MAXDIMS];      /**< Coordinates of the current tile */
+  int seqno;                /**< Number of the current sequence */
+  int segno;                /**< Number of the current segment */
+  TileSegm *segms;          /**< Array of traversed tiles */
+  int count;                /**< Number of elements in the array */
+  int maxcount;             /**< Allocated size of the array */
+} TileSegmState;
+
+/**
+ * @brief Comparator function for traversed tiles
+ */
+static int
+tilesegm_cmp(const TileSegm *ts1, const TileSegm *ts2)
+{
+  if (ts1->tile != ts2->tile)
+    return (ts1->tile < ts2->tile) ? -1 : 1;
+  if (ts1->seqno != ts2->seqno)
+    return (ts1->seqno < ts2->seqno) ? -1 : 1;
+  if (ts1->segno != ts2->segno)
+    return (ts1->segno < ts2->segno) ? -1 : 1;
+  return 0;
+}
+
+/**
+ * @brief Get the position of a temporal point instant in the grid expressed
+ * in fractional tile coordinates
+ * @param[in] inst Temporal point
+ * @param[in] state Grid definition
+ * @param[out] fpos Fractional tile coordinates
+ */
+static void
+tpointinst_tile_fpos(const TInstant *inst, const STboxGridState *state,
+  double *fpos)
+{
+  POINT4D p;
+  datum_point4d(tinstant_value_p(inst), &p);
+  int k = 0;
+  fpos[k++] = (p.x - state->box.xmin) / state->xsize;
+  fpos[k++] = (p.y - state->box.ymin) / state->ysize;
+  if (state->hasz)
+    fpos[k++] = (p.z - state->box.zmin) / state->zsize;
+  if (state->hast)
+    fpos[k++] = (double) (inst->t -
+      DatumGetTimestampTz(state->box.period.lower)) / state->tunits;
+  return;
+}
+
+/**
+ * @brief Add to the state the tiles traversed by the part of a segment
+ * between the parameters @p u0 and @p u1 in the dimensions starting from
+ * @p dim
+ * @details The segment is clipped successively to the slab of each tile in
+ * each dimension, so that only the tiles it traverses are enumerated.
+ * @param[in] fpos1,fpos2 Fractional tile coordinates of the segment ends
+ * @param[in] u0,u1 Parameters delimiting the part of the segment
+ * @param[in] dim Current dimension
+ * @param[out] ts State
+ */
+static void
+tilesegm_add(const double *fpos1, const double *fpos2, double u0, double u1,
+  int dim, TileSegmState *ts)
+{
+  if (dim == ts->ndims)
+  {
+    if (ts->count == ts->maxcount)
+    {
+      ts->maxcount *= 2;
+      ts->segms = repalloc(ts->segms, sizeof(TileSegm) * ts->maxcount);
+    }
+    int64 tile = 0;
+    for (int i = 0; i < ts->ndims; i++)
+      tile += ts->coords[i] * ts->mult[i];
+    ts->segms[ts->count].tile = tile;
+    ts->segms[ts->count].seqno = ts->seqno;
+    ts->segms[ts->count++].segno = ts->segno;
+    return;
+  }
+
+  double delta = fpos2[dim] - fpos1[dim];
+  double a = fpos1[dim] + u0 * delta, b = fpos1[dim] + u1 * delta;
+  double lo = floor(Min(a, b) - TILE_SPLIT_EPSILON);
+  double hi = floor(Max(a, b) + TILE_SPLIT_EPSILON);
+  /* Tiles outside of the grid are never output */
+  if (hi < 0 || lo > ts->ncells[dim] - 1)
+    return;
+  int cmin = (lo < 0) ? 0 : (int) lo;
+  int cmax = (hi > ts->ncells[dim] - 1) ? ts->ncells[dim] - 1 : (int) hi;
+  for (int c = cmin; c <= cmax; c++)
+  {
+    double v0 = u0, v1 = u1;
+    if (delta != 0)
+    {
+      /* Clip the part of the segment to the slab of the tile */
+      double w0 = (c - TILE_SPLIT_EPSILON - fpos1[dim]) / delta;
+      double w1 = (c + 1 + TILE_SPLIT_EPSILON - fpos1[dim]) / delta;
+      if (w0 > w1)
+      {
+        double tmp = w0; w0 = w1; w1 = tmp;
+      }
+      v0 = Max(u0, w0);
+      v1 = Min(u1, w1);
+      if (v0 > v1)
+        continue;
+    }
+    ts->coords[dim] = c;
+    tilesegm_add(fpos1, fpos2, v0, v1, dim + 1, ts);
+  }
+  return;
+}
+
+/**
+ * @brief Add to the state the tiles traversed by the segments of a temporal
+ * point sequence
+ * @details A segment with step interpolation keeps the value of its first
+ * instant until the timestamp of its second instant, and the last instant of
+ * the sequence is considered as a degenerate segment.
+ * @param[in] seq Temporal point
+ * @param[in] seqno Number of the sequence in the temporal point
+ * @param[in] state Grid definition
+ * @param[out] ts State
+ */
+static void
+tpointseq_tilesegm_add(const TSequence *seq, int seqno,
+  const STboxGridState *state, TileSegmState *ts)
+{
+  interpType interp = MEOS_FLAGS_GET_INTERP(seq->flags);
+  double fpos1[MAXDIMS], fpos2[MAXDIMS];
+  ts->seqno = seqno;
+  tpointinst_tile_fpos(TSEQUENCE_INST_N(seq, 0), state, fpos1);
+  if (interp == DISCRETE || seq->count == 1)
+  {
+    for (int i = 0; i < seq->count; i++)
+    {
+      if (i > 0)
+        tpointinst_tile_fpos(TSEQUENCE_INST_N(seq, i), state, fpos1);
+      ts->segno = i;
+      tilesegm_add(fpos1, fpos1, 0.0, 1.0, 0, ts);
+    }
+    return;
+  }
+  for (int i = 0; i < seq->count - 1; i++)
+  {
+    tpointinst_tile_fpos(TSEQUENCE_INST_N(seq, i + 1), state, fpos2);
+    ts->segno = i;
+    if (interp == LINEAR)
+      tilesegm_add(fpos1, fpos2, 0.0, 1.0, 0, ts);
+    else
+    {
+      /* The value of a step segment is the one of its first instant */
+      double fpos3[MAXDIMS];
+      memcpy(fpos3, fpos1, sizeof(double) * ts->ndims);
+      if (state->hast)
+        fpos3[ts->ndims - 1] = fpos2[ts->ndims - 1];
+      tilesegm_add(fpos1, fpos3, 0.0, 1.0, 0, ts);
+    }
+    memcpy(fpos1, fpos2, sizeof(fpos1));
+  }
+  if (interp == STEP)
+  {
+    ts->segno = seq->count - 1;
+    tilesegm_add(fpos1, fpos1, 0.0, 1.0, 0, ts);
+  }
+  return;
+}
+
+/**
+ * @brief Return the part of a temporal point composed of the segments that
+ * traverse a tile
+ * @details Consecutive segments are grouped into a single sequence. The
+ * bounds of these sequences are inclusive except for those that start or end
+ * the sequences of the temporal point, which keep the original bounds.
+ * @param[in] temp Temporal point
+ * @param[in] segms Array of traversed tiles of the same tile
+ * @param[in] count Number of elements in the array
+ */
+static Temporal *
+tpoint_tilesegm_subseqs(const Temporal *temp, const TileSegm *segms,
+  int count)
+{
+  interpType interp = MEOS_FLAGS_GET_INTERP(temp->flags);
+  TSequence **sequences = palloc(sizeof(TSequence *) * count);
+  const TInstant **instants = palloc(sizeof(TInstant *) * (count + 1));
+  int nseqs = 0, i = 0;
+  while (i < count)
+  {
+    const TSequence *seq = (temp->subtype == TSEQUENCE) ?
+      (const TSequence *) temp :
+      TSEQUENCESET_SEQ_N((const TSequenceSet *) temp, segms[i].seqno);
+    int ninsts = 0;
+    if (interp == DISCRETE)
+    {
+      /* Collect the instants located in the tile */
+      for ( ; i < count; i++)
+        instants[ninsts++] = TSEQUENCE_INST_N(seq, segms[i].segno);
+      sequences[nseqs++] = tsequence_make(instants, ninsts, true, true,
+        DISCRETE, NORMALIZE_NO);
+      break;
+    }
+    /* Collect the run of consecutive segments traversing the tile */
+    int first = segms[i].segno, last = first;
+    for (i++; i < count && segms[i].seqno == segms[i - 1].seqno &&
+        segms[i].segno == last + 1; i++)
+      last++;
+    int end = Min(last + 1, seq->count - 1);
+    for (int j = first; j <= end; j++)
+      instants[ninsts++] = TSEQUENCE_INST_N(seq, j);
+    bool lower_inc = (first == 0) ? seq->period.lower_inc : true;
+    bool upper_inc = (end == seq->count - 1) ? seq->period.upper_inc : true;
+    sequences[nseqs++] = tsequence_make(instants, ninsts, lower_inc,
+      upper_inc, interp, NORMALIZE_NO);
+  }
+  pfree(instants);
+  if (nseqs == 1)
+  {
+    Temporal *result = (Temporal *) sequences[0];
+    pfree(sequences);
+    return result;
+  }
+  return (Temporal *) tsequenceset_make_free(sequences, nseqs, NORMALIZE_NO);
+}
+
+/**
+ * @brief Return the minimum values of the tiles in a dimension of the grid
+ * @details The values are computed by successive additions as it is done when
+ * iterating over the grid to obtain exactly the same tiles
+ */
+static double *
+tile_dim_values(double min, double size, int count)
+{
+  double *result = palloc(sizeof(double) * count);
+  double value = min;
+  for (int i = 0; i < count; i++)
+  {
+    result[i] = value;
+    value += size;
+  }
+  return result;
+}
+
+/**
+ * @brief Return true if the fragments of a temporal value split according to a
+ * space and possibly a time grid can be computed in a single pass
+ */
+bool
+tpoint_split_onepass(const Temporal *temp)
+{
+  return tpoint_type(temp->temptype) &&
+    ! MEOS_FLAGS_GET_GEODETIC(temp->flags) &&
+    temporal_num_instants(temp) > 1;
+}
+
+/**
+ * @brief Return the fragments of a temporal point split according to a space
+ * and possibly a time grid computed in a single pass
+ * @details The tiles traversed by each segment are obtained by clipping the
+ * segment with the slabs of the grid in each dimension. The segments are then
+ * grouped by tile and the temporal point is restricted to each tile by only
+ * considering the segments that traverse the tile. This yields the same
+ * fragments as restricting the whole temporal point to every tile of the grid
+ * while the cost depends on the number of segments and not on the product of
+ * the number of segments and the number of tiles.
+ * @param[in] temp Temporal point
+ * @param[in] state Grid definition
+ * @param[out] boxes Array of tiles of the fragments
+ * @param[out] count Number of elements in the output arrays
+ * @pre The temporal point has planar coordinates and is not instantaneous,
+ * and the grid has space dimension
+ */
+Temporal **
+tpoint_space_time_split_tiles(const Temporal *temp,
+  const STboxGridState *state, STBox **boxes, int *count)
+{
+  assert(temp); assert(state); assert(boxes); assert(count);
+  assert(tpoint_type(temp->temptype));
+  assert(! MEOS_FLAGS_GET_GEODETIC(temp->flags));
+  assert(temp->subtype == TSEQUENCE || temp->subtype == TSEQUENCESET);
+  assert(state->hasx);
+
+  /* Initialize the state. Since the coordinates of the iteration over the grid
+   * do not reach the maximum coordinates, the grid has at least one tile in
+   * each dimension */
+  TileSegmState ts;
+  memset(&ts, 0, sizeof(TileSegmState));
+  ts.ndims = 2 + (state->hasz ? 1 : 0) + (state->hast ? 1 : 0);
+  for (int i = 0; i < ts.ndims; i++)
+  {
+    ts.ncells[i] = Max(state->max_coords[i], 1);
+    ts.mult[i] = (i == 0) ? 1 : ts.mult[i - 1] * ts.ncells[i - 1];
+  }
+  ts.maxcount = 2 * temporal_num_instants(temp);
+  ts.segms = palloc(sizeof(TileSegm) * ts.maxcount);
+
+  /* Collect the tiles traversed by the segments and sort them by tile */
+  if (temp->subtype == TSEQUENCE)
+    tpointseq_tilesegm_add((TSequence *) temp, 0, state, &ts);
+  else
+  {
+    const TSequenceSet *ss = (const TSequenceSet *) temp;
+    for (int i = 0; i < ss->count; i++)
+      tpointseq_tilesegm_add(TSEQUENCESET_SEQ_N(ss, i), i, state, &ts);
+  }
+  qsort(ts.segms, (size_t) ts.count, sizeof(TileSegm),
+    (qsort_comparator) &tilesegm_cmp);
+
+  /* Compute the minimum values of the tiles in the spatial dimensions */
+  double *xs = tile_dim_values(state->box.xmin, state->xsize, ts.ncells[0]);
+  double *ys = tile_dim_values(state->box.ymin, state->ysize, ts.ncells[1]);
+  double *zs = state->hasz ?
+    tile_dim_values(state->box.zmin, state->zsize, ts.ncells[2]) : NULL;
+
+  /* Restrict the temporal point to each tile traversed */
+  Temporal **result = palloc(sizeof(Temporal *) * ts.count);
+  STBox *tiles = palloc(sizeof(STBox) * ts.count);
+  int ntiles = 0, i = 0;
+  while (i < ts.count)
+  {
+    int j = i + 1;
+    while (j < ts.count && ts.segms[j].tile == ts.segms[i].tile)
+      j++;
+    /* Get the coordinates of the tile and construct the tile */
+    int coords[MAXDIMS];
+    int64 tile = ts.segms[i].tile;
+    for (int k = ts.ndims - 1; k >= 0; k--)
+    {
+      coords[k] = (int) (tile / ts.mult[k]);
+      tile %= ts.mult[k];
+    }
+    TimestampTz t = state->hast ? DatumGetTimestampTz(state->box.period.lower) +
+      coords[ts.ndims - 1] * state->tunits : 0;
+    STBox box;
+    stbox_tile_state_set(xs[coords[0]], ys[coords[1]],
+      state->hasz ? zs[coords[2]] : 0, t, state->xsize, state->ysize,
+      state->zsize, state->tunits, state->hasx, state->hasz, state->hast,
+      state->box.srid, &box);
+    /* Restrict the segments traversing the tile to the tile */
+    Temporal *subseqs = tpoint_tilesegm_subseqs(temp, &ts.segms[i], j - i);
+    Temporal *atstbox = tgeo_restrict_stbox(subseqs, &box, BORDER_EXC,
+      REST_AT);
+    pfree(subseqs);
+    if (atstbox)
+    {
+      result[ntiles] = atstbox;
+      tiles[ntiles++] = box;
+    }
+    i = j;
+  }
+
+  /* Clean up and return */
+  pfree(ts.segms); pfree(xs); pfree(ys);
+  if (zs)
+    pfree(zs);
+  *boxes = tiles;
+  *count = ntiles;
+  return result;
+}
+
 #if MEOS
 /**
  * @ingroup meos_geo_tile
@@ -1376,20 +1761,48 @@ tgeo_space_time_split(const Temporal *temp, double xsize, double ysize,
         ! ensure_has_not_Z(temp->temptype, temp->flags)))
     return NULL;
 
-  /* Initialize state */
+  /* Initialize state. When the bit matrix is requested for a temporal point,
+   * the fragments are computed in a single pass instead */
+  bool onepass = bitmatrix && tpoint_split_onepass(temp);
   int ntiles;
   STboxGridState *state = tgeo_space_time_tile_init(temp, xsize, ysize,
-    zsize, duration, sorigin, torigin, bitmatrix, border_inc, &ntiles);
+    zsize, duration, sorigin, torigin, onepass ? false : bitmatrix,
+    border_inc, &ntiles);
   if (! state)
     return NULL;
 
-  GSERIALIZED **spaces = palloc(sizeof(GSERIALIZED *) * ntiles);
+  bool hasz = MEOS_FLAGS_GET_Z(state->temp->flags);
+  GSERIALIZED **spaces;
   TimestampTz *times = NULL;
+  Temporal **result;
+  int i = 0;
+  if (onepass)
+  {
+    STBox *boxes;
+    result = tpoint_space_time_split_tiles(temp, state, &boxes, &i);
+    spaces = palloc(sizeof(GSERIALIZED *) * i);
+    if (duration)
+      times = palloc(sizeof(TimestampTz) * i);
+    for (int j = 0; j < i; j++)
+    {
+      spaces[j] = geopoint_make(boxes[j].xmin, boxes[j].ymin, boxes[j].zmin,
+        hasz, false, boxes[j].srid);
+      if (duration)
+        times[j] = DatumGetTimestampTz(boxes[j].period.lower);
+    }
+    pfree(boxes); pfree(state);
+    *count = i;
+    if (space_bins)
+      *space_bins = spaces;
+    if (time_bins)
+      *time_bins = times;
+    return result;
+  }
+
+  spaces = palloc(sizeof(GSERIALIZED *) * ntiles);
   if (duration)
     times = palloc(sizeof(TimestampTz) * ntiles);
-  Temporal **result = palloc(sizeof(Temporal *) * ntiles);
-  bool hasz = MEOS_FLAGS_GET_Z(state->temp->flags);
-  int i = 0;
+  result = palloc(sizeof(Temporal *) * ntiles);
   /* We need to loop since atStbox may be NULL */
   while (true)
   {
@@ -37,6 +37,7 @@
 /* C */
 #include <assert.h>
 /* PostgreSQL */
+#include <common/hashfn.h>
 #include <utils/float.h>
 #if POSTGRESQL_VERSION_NUMBER >= 160000
   #include "varatt.h"
@@ -52,6 +53,7 @@
 #include <meos_internal_geo.h>
 #include "temporal/postgres_types.h"
 #include "temporal/lifting.h"
+#include "temporal/meos_stats.h"
 #include "temporal/temporal_compops.h"
 #include "temporal/tnumber_mathfuncs.h"
 #include "temporal/tsequence.h"
@@ -3306,64 +3308,349 @@ mrr_distance_geos(GEOSGeometry *geom, bool geodetic)
 }
 
 /**
- * @brief Create a GEOS Multipoint geometry from a part (defined by start and
- * end) of a temporal point sequence
+ * @brief Relative tolerance used when deciding a stop from the bounds of the
+ * extent of a window so that the decision never differs from the one computed
+ * by GEOS due to rounding errors
  */
-static GEOSGeometry *
-multipoint_make(const TSequence *seq, int start, int end)
+#define STOPS_EXTENT_TOLERANCE 1.0e-9
+
+/**
+ * @brief Get the 2D coordinates of the points of a temporal point sequence
+ * @param[in] seq Temporal sequence
+ * @param[out] x,y Arrays of coordinates
+ * @return On error return false
+ */
+static bool
+tpointseq_coords2d(const TSequence *seq, double *x, double *y)
 {
-  GSERIALIZED *gs = NULL; /* make compiler quiet */
-  GEOSGeometry **geoms = palloc(sizeof(GEOSGeometry *) * (end - start + 1));
-  for (int i = 0; i < end - start + 1; ++i)
+  for (int i = 0; i < seq->count; ++i)
   {
+    const TInstant *inst = TSEQUENCE_INST_N(seq, i);
+    GSERIALIZED *gs = NULL; /* make compiler quiet */
     if (tpoint_type(seq->temptype))
-      gs = DatumGetGserializedP(
-        tinstant_value_p(TSEQUENCE_INST_N(seq, start + i)));
+      gs = DatumGetGserializedP(tinstant_value_p(inst));
 #if NPOINT
     else if (seq->temptype == T_TNPOINT)
-      gs = npoint_to_geompoint(DatumGetNpointP(
-        tinstant_value_p(TSEQUENCE_INST_N(seq, start + i))));
+      gs = npoint_to_geompoint(DatumGetNpointP(tinstant_value_p(inst)));
 #endif
     else
     {
       meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
         "Sequence must have a spatial base type");
-      return NULL;
+      return false;
     }
     const POINT2D *pt = GSERIALIZED_POINT2D_P(gs);
-    geoms[i] = GEOSGeom_createPointFromXY(pt->x, pt->y);
+    x[i] = pt->x;
+    y[i] = pt->y;
+    if (seq->temptype == T_TNPOINT)
+      pfree(gs);
   }
-  GEOSGeometry *result = GEOSGeom_createCollection(GEOS_MULTIPOINT, geoms, end - start + 1);
+  return true;
+}
+
+/**
+ * @brief Create a GEOS Multipoint geometry from a part (defined by start and
+ * end) of arrays of coordinates
+ */
+static GEOSGeometry *
+multipoint_make(const double *x, const double *y, int start, int end)
+{
+  GEOSGeometry **geoms = palloc(sizeof(GEOSGeometry *) * (end - start + 1));
+  for (int i = 0; i < end - start + 1; ++i)
+    geoms[i] = GEOSGeom_createPointFromXY(x[start + i], y[start + i]);
+  GEOSGeometry *result = GEOSGeom_createCollection(GEOS_MULTIPOINT, geoms,
+    end - start + 1);
   pfree(geoms);
   return result;
 }
 
 /**
- * @brief Add the point stored in the given instant to a GEOS multipoint
- * geometry
+ * @brief Monotone queue of point indexes used for maintaining the minimum or
+ * the maximum value of a coordinate in a sliding window
+ * @details Since the bounds of the window only move forward, each index is
+ * pushed and popped at most once and the array of indexes never wraps around
  */
-static GEOSGeometry *
-multipoint_add_inst_free(GEOSGeometry *geom, const TInstant *inst)
+typedef struct
 {
-  GSERIALIZED *gs = NULL; /* make compiler quiet */
-  if (tpoint_type(inst->temptype))
-    gs = DatumGetGserializedP(tinstant_value_p(inst));
-#if NPOINT
-  else if (inst->temptype == T_TNPOINT)
-    gs = npoint_to_geompoint(DatumGetNpointP(tinstant_value_p(inst)));
-#endif
-  else
+  int *idx;        /**< Indexes of the points in increasing order */
+  int head;        /**< Position of the first index of the queue */
+  int tail;        /**< Position after the last index of the queue */
+} MonoQueue;
+
+/**
+ * @brief Push the index of a point into a monotone queue
+ * @param[in] q Queue
+ * @param[in] values Coordinate values of the points
+ * @param[in] i Index of the point
+ * @param[in] max True when the queue keeps the maximum value
+ */
+static inline void
+monoqueue_push(MonoQueue *q, const double *values, int i, bool max)
+{
+  while (q->tail > q->head && (max ?
+      values[q->idx[q->tail - 1]] <= values[i] :
+      values[q->idx[q->tail - 1]] >= values[i]))
+    q->tail--;
+  q->idx[q->tail++] = i;
+}
+
+/**
+ * @brief Return the extreme value kept by a monotone queue for the window
+ * starting at a given index
+ */
+static inline double
+monoqueue_front(MonoQueue *q, const double *values, int start)
+{
+  while (q->idx[q->head] < start)
+    q->head++;
+  return values[q->idx[q->head]];
+}
+
+/**
+ * @brief Comparator of 2D points by their x and y coordinates
+ */
+static int
+point2d_cmp(const POINT2D *p1, const POINT2D *p2)
+{
+  if (p1->x != p2->x)
+    return p1->x < p2->x ? -1 : 1;
+  if (p1->y != p2->y)
+    return p1->y < p2->y ? -1 : 1;
+  return 0;
+}
+
+/**
+ * @brief Return the signed area of the parallelogram defined by three points,
+ * which is positive when they turn counterclockwise
+ */
+static inline double
+point2d_cross(const POINT2D *o, const POINT2D *a, const POINT2D *b)
+{
+  return (a->x - o->x) * (b->y - o->y) - (a->y - o->y) * (b->x - o->x);
+}
+
+/**
+ * @brief Compute the convex hull of an array of 2D points using the monotone
+ * chain algorithm and return the number of vertices of the hull
+ * @param[in,out] points Array of points, which is sorted
+ * @param[in] count Number of points
+ * @param[out] hull Vertices of the hull in counterclockwise order, which
+ * must have space for `count + 1` points
+ */
+static int
+point2d_convex_hull(POINT2D *points, int count, POINT2D *hull)
+{
+  qsort(points, (size_t) count, sizeof(POINT2D),
+    (qsort_comparator) &point2d_cmp);
+  int k = 0;
+  /* Lower hull */
+  for (int i = 0; i < count; i++)
   {
-    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
-      "Instant must have a spatial base type");
-    return NULL;
+    while (k >= 2 && point2d_cross(&hull[k - 2], &hull[k - 1], &points[i]) <= 0)
+      k--;
+    hull[k++] = points[i];
+  }
+  /* Upper hull */
+  for (int i = count - 2, lower = k + 1; i >= 0; i--)
+  {
+    while (k >= lower &&
+        point2d_cross(&hull[k - 2], &hull[k - 1], &points[i]) <= 0)
+      k--;
+    hull[k++] = points[i];
+  }
+  /* The last point is equal to the first one */
+  return Max(k - 1, 1);
+}
+
+/**
+ * @brief Compute the minimum and the maximum length of the diagonals of the
+ * rectangles enclosing a convex polygon that have a side collinear with one
+ * of its edges
+ * @details The minimum rotated rectangle computed by GEOS has a side collinear
+ * with an edge of the convex hull, whether it minimizes the area or the
+ * width, and thus the length of its diagonal is between the two values
+ * @param[in] hull Vertices of the convex polygon in counterclockwise order
+ * @param[in] count Number of vertices, which is at least 3
+ * @param[out] mindiag,maxdiag Minimum and maximum length of the diagonals
+ */
+static void
+point2d_hull_diagonals(const POINT2D *hull, int count, double *mindiag,
+  double *maxdiag)
+{
+  *mindiag = DBL_MAX;
+  *maxdiag = 0.0;
+  for (int i = 0; i < count; i++)
+  {
+    const POINT2D *p1 = &hull[i], *p2 = &hull[(i + 1) % count];
+    double len = hypot(p2->x - p1->x, p2->y - p1->y);
+    double ux = (p2->x - p1->x) / len, uy = (p2->y - p1->y) / len;
+    double umin = DBL_MAX, umax = -DBL_MAX, vmax = 0.0;
+    for (int j = 0; j < count; j++)
+    {
+      double dx = hull[j].x - p1->x, dy = hull[j].y - p1->y;
+      double u = dx * ux + dy * uy;
+      /* All vertices are on the left of a counterclockwise edge */
+      double v = dy * ux - dx * uy;
+      umin = Min(umin, u);
+      umax = Max(umax, u);
+      vmax = Max(vmax, v);
+    }
+    double diag = hypot(umax - umin, vmax);
+    *mindiag = Min(*mindiag, diag);
+    *maxdiag = Max(*maxdiag, diag);
   }
-  const POINT2D *pt = GSERIALIZED_POINT2D_P(gs);
-  GEOSGeometry *geom1 = GEOSGeom_createPointFromXY(pt->x, pt->y);
-  GEOSGeometry *result = GEOSUnion(geom, geom1);
-  GEOSGeom_destroy(geom1); GEOSGeom_destroy(geom);
-  if (inst->temptype == T_TNPOINT)
-    pfree(gs);
+  return;
+}
+
+/**
+ * @brief Sliding window over the points of a temporal point sequence used
+ * for detecting stops
+ * @details The extent of the window is maintained with monotone queues of
+ * the minimum and maximum coordinate values. The convex hull of the window is
+ * computed lazily and kept while the start of the window does not move, so
+ * that it is extended with the points added to the window since then instead
+ * of being recomputed from all the points of the window.
+ */
+typedef struct
+{
+  const double *x;       /**< X coordinates of the points */
+  const double *y;       /**< Y coordinates of the points */
+  MonoQueue queues[4];   /**< Queues for the minimum and maximum of x and y */
+  POINT2D *points;       /**< Buffer for the points of the hull computation */
+  POINT2D *hull;         /**< Vertices of the convex hull */
+  int nhull;             /**< Number of vertices of the convex hull */
+  int hstart;            /**< Index of the first point of the hull window */
+  int hend;              /**< Index of the last point of the hull window */
+} StopsWindow;
+
+/**
+ * @brief Initialize the sliding window over the points of a sequence
+ */
+static void
+stopswindow_init(StopsWindow *win, const double *x, const double *y,
+  int count)
+{
+  win->x = x;
+  win->y = y;
+  int *idx = palloc(sizeof(int) * count * 4);
+  for (int i = 0; i < 4; ++i)
+  {
+    win->queues[i].idx = idx + i * count;
+    win->queues[i].head = win->queues[i].tail = 0;
+  }
+  win->points = palloc(sizeof(POINT2D) * (count * 2 + 1));
+  win->hull = win->points + count;
+  win->nhull = 0;
+  win->hstart = win->hend = -1;
+  return;
+}
+
+/**
+ * @brief Free the buffers of the sliding window over the points of a sequence
+ */
+static void
+stopswindow_free(StopsWindow *win)
+{
+  pfree(win->queues[0].idx);
+  pfree(win->points);
+  return;
+}
+
+/**
+ * @brief Add the next point to the sliding window
+ */
+static void
+stopswindow_push(StopsWindow *win, int end)
+{
+  monoqueue_push(&win->queues[0], win->x, end, false);
+  monoqueue_push(&win->queues[1], win->x, end, true);
+  monoqueue_push(&win->queues[2], win->y, end, false);
+  monoqueue_push(&win->queues[3], win->y, end, true);
+  return;
+}
+
+/**
+ * @brief Compute the convex hull of the points of the window defined by
+ * start and end
+ */
+static void
+stopswindow_hull(StopsWindow *win, int start, int end)
+{
+  int count = 0, first = start;
+  /* Extend the current hull when the window has only grown since then */
+  if (win->hstart == start && win->hend <= end)
+  {
+    memcpy(win->points, win->hull, sizeof(POINT2D) * win->nhull);
+    count = win->nhull;
+    first = win->hend + 1;
+  }
+  for (int i = first; i <= end; i++)
+  {
+    win->points[count].x = win->x[i];
+    win->points[count++].y = win->y[i];
+  }
+  win->nhull = point2d_convex_hull(win->points, count, win->hull);
+  win->hstart = start;
+  win->hend = end;
+  return;
+}
+
+/**
+ * @brief Return true if the points of a window of a temporal point sequence
+ * are within an area whose minimum rotated rectangle has a diagonal not
+ * greater than a given distance
+ * @details For planar coordinates, the diagonal `d` of the minimum rotated
+ * rectangle of a set of points is bounded by the diameter `D` of the set,
+ * which is in turn bounded by the width `w` and the height `h` of its extent,
+ * that is, `max(w, h) <= D <= d <= sqrt(2) * D <= sqrt(2) * hypot(w, h)`.
+ * When these bounds do not decide the answer, the answer is decided by the
+ * diagonals of the rectangles aligned with the edges of the convex hull of
+ * the window. GEOS is only called to compute the rectangle when neither bound
+ * decides the answer. Since the bounds of geodetic coordinates do not hold
+ * for geodesic distances, the rectangle is always computed with GEOS in that
+ * case.
+ * @param[in] win Sliding window
+ * @param[in] start,end Indexes of the first and last points of the window
+ * @param[in] maxdist Maximum distance
+ * @param[in] geodetic True when the coordinates are geodetic
+ */
+static bool
+stopswindow_within(StopsWindow *win, int start, int end, double maxdist,
+  bool geodetic)
+{
+  if (! geodetic)
+  {
+    double lower = maxdist * (1.0 - STOPS_EXTENT_TOLERANCE);
+    double upper = maxdist * (1.0 + STOPS_EXTENT_TOLERANCE);
+    MonoQueue *queues = win->queues;
+    double width = monoqueue_front(&queues[1], win->x, start) -
+      monoqueue_front(&queues[0], win->x, start);
+    double height = monoqueue_front(&queues[3], win->y, start) -
+      monoqueue_front(&queues[2], win->y, start);
+    if (Max(width, height) > upper)
+      return false;
+    if (sqrt(2.0) * hypot(width, height) <= lower)
+      return true;
+
+    stopswindow_hull(win, start, end);
+    const POINT2D *hull = win->hull;
+    double mindiag, maxdiag;
+    if (win->nhull < 3)
+      /* The rectangle degenerates to a point or a segment */
+      mindiag = maxdiag = (win->nhull == 1) ? 0.0 :
+        hypot(hull[1].x - hull[0].x, hull[1].y - hull[0].y);
+    else
+      point2d_hull_diagonals(hull, win->nhull, &mindiag, &maxdiag);
+    if (mindiag > upper)
+      return false;
+    if (maxdiag <= lower)
+      return true;
+  }
+  MEOS_STATS_START(geos_start);
+  GEOSGeometry *geom = multipoint_make(win->x, win->y, start, end);
+  bool result = mrr_distance_geos(geom, geodetic) <= maxdist;
+  GEOSGeom_destroy(geom);
+  MEOS_STATS_END(MEOS_STAT_GEOS, geos_start);
   return result;
 }
 
@@ -3371,6 +3658,9 @@ multipoint_add_inst_free(GEOSGeometry *geom, const TInstant *inst)
  * @brief Return the subsequences where the temporal value stays within an area
  * with a given maximum size for at least the specified duration
  * (iterator function)
+ * @details The coordinates of the points are extracted once and the windows
+ * are tested with the bounds maintained by a sliding window, so that most of
+ * them are decided without building any GEOS geometry
  * @param[in] seq Temporal sequence
  * @param[in] maxdist Maximum distance
  * @param[in] mintunits Minimum duration
@@ -3384,17 +3674,25 @@ tpointseq_stops_iter(const TSequence *seq, double maxdist, int64 mintunits,
   assert(seq); assert(seq->count > 1);
   assert(tpoint_type(seq->temptype) || seq->temptype == T_TNPOINT);
 
+  /* Extract the coordinates of the points */
+  double *x = palloc(sizeof(double) * seq->count * 2);
+  double *y = x + seq->count;
+  if (! tpointseq_coords2d(seq, x, y))
+  {
+    pfree(x);
+    return 0;
+  }
+  StopsWindow win;
+  stopswindow_init(&win, x, y, seq->count);
+
   /* Use GEOS only for non-scalar input */
   bool geodetic = MEOS_FLAGS_GET_GEODETIC(seq->flags);
   const TInstant *inst1 = NULL, *inst2 = NULL; /* make compiler quiet */
-  GEOSGeometry *geom = NULL;
   initGEOS(lwnotice, lwgeom_geos_error);
-  geom = GEOSGeom_createEmptyCollection(GEOS_MULTIPOINT);
 
   int end, start = 0, nseqs = 0;
   bool  is_stopped = false,
-        previously_stopped = false,
-        rebuild_geom = false;
+        previously_stopped = false;
 
   for (end = 0; end < seq->count; ++end)
   {
@@ -3403,24 +3701,13 @@ tpointseq_stops_iter(const TSequence *seq, double maxdist, int64 mintunits,
 
     while (! is_stopped && end - start > 1
       && (int64)(inst2->t - inst1->t) >= mintunits)
-    {
       inst1 = TSEQUENCE_INST_N(seq, ++start);
-      rebuild_geom = true;
-    }
-
-    if (rebuild_geom)
-    {
-      GEOSGeom_destroy(geom);
-      geom = multipoint_make(seq, start, end);
-      rebuild_geom = false;
-    }
-    else
-      geom = multipoint_add_inst_free(geom, inst2);
 
+    stopswindow_push(&win, end);
     if (end - start == 0)
       continue;
 
-    is_stopped = mrr_distance_geos(geom, geodetic) <= maxdist;
+    is_stopped = stopswindow_within(&win, start, end, maxdist, geodetic);
     inst2 = TSEQUENCE_INST_N(seq, end - 1);
     if (! is_stopped && previously_stopped
       && (int64)(inst2->t - inst1->t) >= mintunits) // Found a stop
@@ -3431,11 +3718,11 @@ tpointseq_stops_iter(const TSequence *seq, double maxdist, int64 mintunits,
       result[nseqs++] = tsequence_make(insts, end - start,
         true, true, LINEAR, NORMALIZE_NO);
       start = end;
-      rebuild_geom = true;
     }
     previously_stopped = is_stopped;
   }
-  GEOSGeom_destroy(geom);
+  stopswindow_free(&win);
+  pfree(x);
 
   inst2 = TSEQUENCE_INST_N(seq, end - 1);
   if (is_stopped && (int64)(inst2->t - inst1->t) >= mintunits)
@@ -3624,6 +3911,280 @@ seg2d_intersection(const POINT2D *a, const POINT2D *b, const POINT2D *c,
   return MEOS_SEG_CROSS;
 }
 
+/*****************************************************************************
+ * Grid index of the segments of a temporal point
+ *****************************************************************************/
+
+/**
+ * @brief Maximum number of cells of the grid index covered by the bounding
+ * box of a segment, the segments covering more cells are kept in a separate
+ * list that is scanned for every query
+ */
+#define SEGGRID_MAX_CELLS 64
+
+/**
+ * @brief Minimum number of segments of a piece of a temporal point sequence
+ * for using a grid index to find its self-intersections, the segments of
+ * shorter pieces are tested against all the previous ones
+ */
+#define SEGGRID_MIN_SEGMENTS 64
+
+/**
+ * @brief Entry of the hash table of the cells of a grid index of segments
+ */
+typedef struct
+{
+  uint64 key;    /**< Coordinates of the cell (hash key) */
+  int head;      /**< Last node of the list of segments of the cell */
+  char status;   /**< Hash status */
+} SegGridCell;
+
+/**
+ * @brief Return the hash value of a cell of a grid index of segments
+ */
+static inline uint32
+hash_segcell(uint64 key)
+{
+  return hash_bytes_uint32((uint32) (key >> 32)) ^
+    hash_bytes_uint32((uint32) key);
+}
+
+#define SH_PREFIX segcell
+#define SH_ELEMENT_TYPE SegGridCell
+#define SH_KEY_TYPE uint64
+#define SH_KEY key
+#define SH_HASH_KEY(tb, key) hash_segcell(key)
+#define SH_EQUAL(tb, a, b) ((a) == (b))
+#define SH_SCOPE static inline
+#define SH_RAW_ALLOCATOR palloc0
+#define SH_DEFINE
+#define SH_DECLARE
+#include <lib/simplehash.h>
+
+/**
+ * @brief Grid index of the segments of a temporal point sequence
+ * @details The segments are registered in the cells of a uniform grid
+ * covered by their bounding box, where the cells are kept in a hash table.
+ * Since the segments are added in increasing order, the list of segments of
+ * a cell is sorted in decreasing order, which enables to ignore the segments
+ * that precede a given one without removing them from the index.
+ */
+typedef struct
+{
+  const POINT2D **points; /**< Points of the sequence */
+  double xmin;            /**< Minimum X coordinate of the points */
+  double ymin;            /**< Minimum Y coordinate of the points */
+  double size;            /**< Size of the cells */
+  segcell_hash *cells;    /**< Hash table of the cells */
+  int *segs;              /**< Segment of each node of the lists */
+  int *next;              /**< Next node of each node of the lists */
+  int nnodes;             /**< Number of nodes */
+  int maxnodes;           /**< Maximum number of nodes */
+  int large;              /**< Last node of the list of the large segments */
+  int *stamp;             /**< Last segment tested against each segment */
+} SegGrid;
+
+/**
+ * @brief Initialize a grid index of the segments of a temporal point sequence
+ * @details The size of the cells is twice the average extent of the
+ * segments, so that a segment covers a few cells
+ */
+static void
+seggrid_init(SegGrid *grid, const POINT2D **points, int count)
+{
+  double xmin = points[0]->x, xmax = points[0]->x;
+  double ymin = points[0]->y, ymax = points[0]->y;
+  double size = 0.0;
+  for (int i = 1; i < count; i++)
+  {
+    xmin = Min(xmin, points[i]->x); xmax = Max(xmax, points[i]->x);
+    ymin = Min(ymin, points[i]->y); ymax = Max(ymax, points[i]->y);
+    size += Max(fabs(points[i]->x - points[i - 1]->x),
+      fabs(points[i]->y - points[i - 1]->y));
+  }
+  size = 2.0 * size / (count - 1);
+  /* Bound the number of cells in each dimension so that the cell coordinates
+   * fit in 32 bits, and the number of cells covered by the tolerance */
+  size = Max(size, Max(xmax - xmin, ymax - ymin) / 1.0e6);
+  size = Max(size, MEOS_EPSILON);
+  grid->points = points;
+  grid->xmin = xmin;
+  grid->ymin = ymin;
+  grid->size = size;
+  grid->cells = segcell_create(count, NULL);
+  grid->maxnodes = 2 * count;
+  grid->segs = palloc(sizeof(int) * grid->maxnodes);
+  grid->next = palloc(sizeof(int) * grid->maxnodes);
+  grid->nnodes = 0;
+  grid->large = -1;
+  grid->stamp = palloc(sizeof(int) * count);
+  for (int i = 0; i < count; i++)
+    grid->stamp[i] = -1;
+  return;
+}
+
+/**
+ * @brief Free a grid index of segments
+ */
+static void
+seggrid_free(SegGrid *grid)
+{
+  segcell_destroy(grid->cells);
+  pfree(grid->segs); pfree(grid->next); pfree(grid->stamp);
+  return;
+}
+
+/**
+ * @brief Compute the range of cells covered by the bounding box of a segment
+ * extended by a tolerance
+ * @return Number of cells covered
+ */
+static int64
+seggrid_range(const SegGrid *grid, int seg, double tol, int32 *cx1,
+  int32 *cy1, int32 *cx2, int32 *cy2)
+{
+  const POINT2D *p1 = grid->points[seg], *p2 = grid->points[seg + 1];
+  *cx1 = (int32) floor((Min(p1->x, p2->x) - tol - grid->xmin) / grid->size);
+  *cx2 = (int32) floor((Max(p1->x, p2->x) + tol - grid->xmin) / grid->size);
+  *cy1 = (int32) floor((Min(p1->y, p2->y) - tol - grid->ymin) / grid->size);
+  *cy2 = (int32) floor((Max(p1->y, p2->y) + tol - grid->ymin) / grid->size);
+  return (int64) (*cx2 - *cx1 + 1) * (int64) (*cy2 - *cy1 + 1);
+}
+
+/**
+ * @brief Return the key of a cell of a grid index of segments
+ */
+static inline uint64
+seggrid_key(int32 cx, int32 cy)
+{
+  return ((uint64) (uint32) cx << 32) | (uint64) (uint32) cy;
+}
+
+/**
+ * @brief Add a node for a segment at the front of a list of a grid index
+ */
+static int
+seggrid_node(SegGrid *grid, int seg, int next)
+{
+  if (grid->nnodes == grid->maxnodes)
+  {
+    grid->maxnodes *= 2;
+    grid->segs = repalloc(grid->segs, sizeof(int) * grid->maxnodes);
+    grid->next = repalloc(grid->next, sizeof(int) * grid->maxnodes);
+  }
+  grid->segs[grid->nnodes] = seg;
+  grid->next[grid->nnodes] = next;
+  return grid->nnodes++;
+}
+
+/**
+ * @brief Add a segment to a grid index
+ * @pre The segments are added in increasing order
+ */
+static void
+seggrid_add(SegGrid *grid, int seg)
+{
+  int32 cx1, cy1, cx2, cy2;
+  if (seggrid_range(grid, seg, 0.0, &cx1, &cy1, &cx2, &cy2) >
+      SEGGRID_MAX_CELLS)
+  {
+    grid->large = seggrid_node(grid, seg, grid->large);
+    return;
+  }
+  for (int32 cx = cx1; cx <= cx2; cx++)
+  {
+    for (int32 cy = cy1; cy <= cy2; cy++)
+    {
+      bool found;
+      SegGridCell *cell = segcell_insert(grid->cells, seggrid_key(cx, cy),
+        &found);
+      cell->head = seggrid_node(grid, seg, found ? cell->head : -1);
+    }
+  }
+  return;
+}
+
+/**
+ * @brief Return true if two segments of a temporal point sequence intersect
+ * apart from the common point of two consecutive segments
+ * @param[in] points Points of the sequence
+ * @param[in] i,j Segments, where @p i is before @p j
+ */
+static bool
+seg2d_self_intersection(const POINT2D **points, int i, int j)
+{
+  POINT2D p = { 0 }; /* make compiler quiet */
+  int intertype = seg2d_intersection(points[i], points[i + 1], points[j],
+    points[j + 1], &p);
+  return (intertype > 0 &&
+    /* Exclude the case when two consecutive segments that
+     * necessarily touch each other in their common point */
+    (intertype != MEOS_SEG_TOUCH_END || j != i + 1 ||
+     p.x != points[j]->x || p.y != points[j]->y));
+}
+
+/**
+ * @brief Return true if a segment intersects a segment of a list of a grid
+ * index that is not before a given one
+ * @param[in,out] grid Grid index
+ * @param[in] node First node of the list
+ * @param[in] start First segment taken into account
+ * @param[in] seg Segment
+ */
+static bool
+seggrid_list_intersects(SegGrid *grid, int node, int start, int seg)
+{
+  for (; node >= 0 && grid->segs[node] >= start; node = grid->next[node])
+  {
+    int i = grid->segs[node];
+    /* Test each segment only once since it may be in several cells */
+    if (grid->stamp[i] == seg)
+      continue;
+    grid->stamp[i] = seg;
+    if (seg2d_self_intersection(grid->points, i, seg))
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Return true if a segment intersects one of the segments of a grid
+ * index that are not before a given one
+ * @param[in,out] grid Grid index
+ * @param[in] start First segment taken into account
+ * @param[in] seg Segment
+ * @pre All the segments from @p start to @p seg - 1 are in the index
+ */
+static bool
+seggrid_intersects(SegGrid *grid, int start, int seg)
+{
+  if (seggrid_list_intersects(grid, grid->large, start, seg))
+    return true;
+  int32 cx1, cy1, cx2, cy2;
+  if (seggrid_range(grid, seg, MEOS_EPSILON, &cx1, &cy1, &cx2, &cy2) >
+      SEGGRID_MAX_CELLS)
+  {
+    /* Test all the previous segments for a large segment */
+    for (int i = start; i < seg; i++)
+    {
+      if (grid->stamp[i] != seg &&
+          seg2d_self_intersection(grid->points, i, seg))
+        return true;
+    }
+    return false;
+  }
+  for (int32 cx = cx1; cx <= cx2; cx++)
+  {
+    for (int32 cy = cy1; cy <= cy2; cy++)
+    {
+      SegGridCell *cell = segcell_lookup(grid->cells, seggrid_key(cx, cy));
+      if (cell && seggrid_list_intersects(grid, cell->head, start, seg))
+        return true;
+    }
+  }
+  return false;
+}
+
 /*****************************************************************************
  * Non self-intersecting (a.k.a. simple) functions
  *****************************************************************************/
@@ -3689,23 +4250,13 @@ tpointseq_discstep_find_splits(const TSequence *seq, int *count)
   return bitarr;
 }
 
-static void gbox_merge_point2d(const POINT2D *p, GBOX *gbox)
-{
-  if ( gbox->xmin > p->x ) gbox->xmin = p->x;
-  if ( gbox->ymin > p->y ) gbox->ymin = p->y;
-  if ( gbox->xmax < p->x ) gbox->xmax = p->x;
-  if ( gbox->ymax < p->y ) gbox->ymax = p->y;
-}
-
-static void gbox_init_point2d(const POINT2D *p, GBOX *gbox)
-{
-  gbox->xmin = gbox->xmax = p->x;
-  gbox->ymin = gbox->ymax = p->y;
-}
-
 /**
  * @brief Return a temporal point sequence with linear interpolation split into
  * an array of non self-intersecting fragments
+ * @details When the current fragment is long, each segment is tested against
+ * the previous segments of the fragment that are in the same cells of a grid
+ * index instead of against all of them, which is quadratic for trajectories
+ * that loiter in a small area.
  * @note The function works only on 2D even if the input points are in 3D
  * @param[in] seq Temporal point
  * @param[out] count Number of elements in the resulting array
@@ -3743,7 +4294,10 @@ tpointseq_linear_find_splits(const TSequence *seq, int *count)
   }
 
   /* Loop for every split due to stationary segments while adding
-   * additional splits due to intersecting segments */
+   * additional splits due to intersecting segments, which are found with a
+   * grid index of the segments */
+  SegGrid grid;
+  grid.cells = NULL;
   int start = 0;
   while (start < seq->count - 2)
   {
@@ -3755,76 +4309,44 @@ tpointseq_linear_find_splits(const TSequence *seq, int *count)
       start = end;
       continue;
     }
-    /* Find intersections in the piece defined by start and end in a
-     * breadth-first search */
-    int i = start, j = start + 1;
-    GBOX box;
-    gbox_init_point2d(points[i], &box);
-    gbox_merge_point2d(points[j], &box);
-    while (j < end)
+    /* Find the first segment of the piece defined by start and end that
+     * intersects a previous segment of the piece */
+    for (int j = start + 1; j < end; j++)
     {
-      /* Candidate for intersection */
-      POINT2D p = { 0 }; /* make compiler quiet */
-      int intertype = seg2d_intersection(points[i], points[i + 1],
-        points[j], points[j + 1], &p);
-      if (intertype > 0 &&
-        /* Exclude the case when two consecutive segments that
-         * necessarily touch each other in their common point */
-        (intertype != MEOS_SEG_TOUCH_END || j != i + 1 ||
-         p.x != points[j]->x || p.y != points[j]->y))
+      bool found = false;
+      if (j - start < SEGGRID_MIN_SEGMENTS)
       {
-        /* Set the new end */
-        end = j;
-        bitarr[end] = true;
-        numsplits++;
-        break;
+        /* Test all the previous segments of a short piece */
+        for (int i = start; i < j && ! found; i++)
+          found = seg2d_self_intersection(points, i, j);
       }
-      if (i < j - 1)
-        i++;
       else
       {
-        j++;
-        i = start;
-
-        /* Shortcut */
-        if (!gbox_contains_point2d(&box, points[j]))
+        /* Index the previous segments of a long piece */
+        if (! grid.cells)
+          seggrid_init(&grid, points, seq->count);
+        if (j - start == SEGGRID_MIN_SEGMENTS)
         {
-          while (j < end) {
-            bool out = false;
-            if ( box.xmin > points[j]->x )
-            {
-              box.xmin = points[j]->x;
-              if ( box.xmin > points[j+1]->x )
-                out = true;
-            }
-            else if ( box.xmax < points[j]->x )
-            {
-              box.xmax = points[j]->x;
-              if ( box.xmax < points[j+1]->x )
-                out = true;
-            }
-            if ( box.ymin > points[j]->y )
-            {
-              box.ymin = points[j]->y;
-              if ( box.ymin > points[j+1]->y )
-                out = true;
-            }
-            else if ( box.ymax < points[j]->y )
-            {
-              box.ymax = points[j]->y;
-              if ( box.ymax < points[j+1]->y )
-                out = true;
-            }
-            if ( !out )
-              break;
-            j++;
-          }
+          for (int i = start; i < j; i++)
+            seggrid_add(&grid, i);
         }
+        found = seggrid_intersects(&grid, start, j);
+        seggrid_add(&grid, j);
+      }
+      if (found)
+      {
+        /* Set the new end */
+        end = j;
+        bitarr[end] = true;
+        numsplits++;
+        break;
       }
     }
     /* Process the next split */
     start = end;
   }
+  if (grid.cells)
+    seggrid_free(&grid);
   pfree(points);
   *count = numsplits;
   return bitarr;
@@ -395,6 +395,53 @@ tspatialinst_parse(const char **str, meosType temptype, bool end,
   return true;
 }
 
+/**
+ * @brief Parse a comma-separated list of spatiotemporal instants from the
+ * input buffer
+ * @details The instants are collected in a single pass in an array that is
+ * enlarged as needed. When the SRID of the spatiotemporal value is obtained
+ * from an instant, it is set to the previous instants that have an unknown
+ * SRID.
+ * @param[in] str Input string
+ * @param[in] temptype Temporal type
+ * @param[in,out] temp_srid SRID of the spatiotemporal value
+ * @param[out] count Number of instants
+ * @return On error return @p NULL
+ */
+static TInstant **
+tspatialinstarr_parse(const char **str, meosType temptype, int *temp_srid,
+  int *count)
+{
+  int maxcount = PARSER_ARRAY_STARTING_SIZE, ninsts = 0, nunknown = 0;
+  TInstant **instants = palloc(sizeof(TInstant *) * maxcount);
+  do
+  {
+    if (ninsts == maxcount)
+    {
+      maxcount *= 2;
+      instants = repalloc(instants, sizeof(TInstant *) * maxcount);
+    }
+    if (! tspatialinst_parse(str, temptype, false, temp_srid,
+        &instants[ninsts]))
+    {
+      pfree_array((void **) instants, ninsts);
+      return NULL;
+    }
+    if (*temp_srid == SRID_UNKNOWN)
+      nunknown = ++ninsts;
+    else
+      ninsts++;
+  } while (p_comma(str));
+  /* Set the SRID of the instants parsed before it was known */
+  if (*temp_srid != SRID_UNKNOWN)
+  {
+    for (int i = 0; i < nunknown; i++)
+      tspatialinst_set_srid(instants[i], *temp_srid);
+  }
+  *count = ninsts;
+  return instants;
+}
+
 /**
  * @brief Parse a temporal discrete sequence spatial value from the buffer
  * @param[in] str Input string
@@ -410,29 +457,16 @@ tspatialseq_disc_parse(const char **str, meosType temptype, int *temp_srid)
    * to call this function in the dispatch function #tspatial_parse */
   p_obrace(str);
 
-  /* First parsing */
-  const char *bak = *str;
-  if (! tspatialinst_parse(str, temptype, false, temp_srid, NULL))
+  int count;
+  TInstant **instants = tspatialinstarr_parse(str, temptype, temp_srid,
+    &count);
+  if (! instants)
     return NULL;
-  int count = 1;
-  while (p_comma(str))
-  {
-    count++;
-    if (! tspatialinst_parse(str, temptype, false, temp_srid, NULL))
-      return NULL;
-  }
   if (! ensure_cbrace(str, type_str) || ! ensure_end_input(str, type_str))
-    return NULL;
-
-  /* Second parsing */
-  *str = bak;
-  TInstant **instants = palloc(sizeof(TInstant *) * count);
-  for (int i = 0; i < count; i++)
   {
-    p_comma(str);
-    tspatialinst_parse(str, temptype, false, temp_srid, &instants[i]);
+    pfree_array((void **) instants, count);
+    return NULL;
   }
-  p_cbrace(str);
   return tsequence_make_free(instants, count, true, true, DISCRETE,
     NORMALIZE_NO);
 }
@@ -461,17 +495,11 @@ tspatialseq_cont_parse(const char **str, meosType temptype, interpType interp,
   else if (p_oparen(str))
     lower_inc = false;
 
-  /* First parsing */
-  const char *bak = *str;
-  if (! tspatialinst_parse(str, temptype, false, temp_srid, NULL))
+  int count;
+  TInstant **instants = tspatialinstarr_parse(str, temptype, temp_srid,
+    &count);
+  if (! instants)
     return false;
-  int count = 1;
-  while (p_comma(str))
-  {
-    count++;
-    if (! tspatialinst_parse(str, temptype, false, temp_srid, NULL))
-      return false;
-  }
   if (p_cbracket(str))
     upper_inc = true;
   else if (p_cparen(str))
@@ -481,22 +509,16 @@ tspatialseq_cont_parse(const char **str, meosType temptype, interpType interp,
     meos_error(ERROR, MEOS_ERR_TEXT_INPUT,
       "Could not parse %s value: Missing closing bracket/parenthesis", 
       type_str);
+    pfree_array((void **) instants, count);
     return false;
   }
   /* Ensure there is no more input */
   if (end && ! ensure_end_input(str, type_str))
-    return false;
-
-  /* Second parsing */
-  *str = bak;
-  TInstant **instants = palloc(sizeof(TInstant *) * count);
-  for (int i = 0; i < count; i++)
   {
-    p_comma(str);
-    tspatialinst_parse(str, temptype, false, temp_srid, &instants[i]);
+    pfree_array((void **) instants, count);
+    return false;
   }
-  p_cbracket(str);
-  p_cparen(str);
+
   if (result)
     *result = tsequence_make((const TInstant **) instants, count,
       lower_inc, upper_inc, interp, NORMALIZE);
@@ -506,6 +528,10 @@ tspatialseq_cont_parse(const char **str, meosType temptype, interpType interp,
 
 /**
  * @brief Parse a temporal sequence set spatial value from the input buffer
+ * @details The sequences are collected in a single pass in an array that is
+ * enlarged as needed. When the SRID of the spatiotemporal value is obtained
+ * from a sequence, it is set to the previous sequences that have an unknown
+ * SRID.
  * @param[in] str Input string
  * @param[in] temptype Temporal type
  * @param[in] interp Interpolation
@@ -521,30 +547,37 @@ tspatialseqset_parse(const char **str, meosType temptype, interpType interp,
    * to call this function in the dispatch function tspatial_parse */
   p_obrace(str);
 
-  /* First parsing */
-  const char *bak = *str;
-  if (! tspatialseq_cont_parse(str, temptype, interp, false, temp_srid, NULL))
-    return NULL;
-  int count = 1;
-  while (p_comma(str))
+  int maxcount = PARSER_ARRAY_STARTING_SIZE, count = 0, nunknown = 0;
+  TSequence **sequences = palloc(sizeof(TSequence *) * maxcount);
+  do
   {
-    count++;
-    if (! tspatialseq_cont_parse(str, temptype, interp, false, temp_srid, NULL))
+    if (count == maxcount)
+    {
+      maxcount *= 2;
+      sequences = repalloc(sequences, sizeof(TSequence *) * maxcount);
+    }
+    if (! tspatialseq_cont_parse(str, temptype, interp, false, temp_srid,
+        &sequences[count]))
+    {
+      pfree_array((void **) sequences, count);
       return NULL;
-  }
+    }
+    if (*temp_srid == SRID_UNKNOWN)
+      nunknown = ++count;
+    else
+      count++;
+  } while (p_comma(str));
   if (! ensure_cbrace(str, type_str) || ! ensure_end_input(str, type_str))
+  {
+    pfree_array((void **) sequences, count);
     return NULL;
-
-  /* Second parsing */
-  *str = bak;
-  TSequence **sequences = palloc(sizeof(TSequence *) * count);
-  for (int i = 0; i < count; i++)
+  }
+  /* Set the SRID of the sequences parsed before it was known */
+  if (*temp_srid != SRID_UNKNOWN)
   {
-    p_comma(str);
-    tspatialseq_cont_parse(str, temptype, interp, false, temp_srid, 
-      &sequences[i]);
+    for (int i = 0; i < nunknown; i++)
+      tspatialseq_set_srid(sequences[i], *temp_srid);
   }
-  p_cbrace(str);
   return tsequenceset_make_free(sequences, count, NORMALIZE);
 }
 
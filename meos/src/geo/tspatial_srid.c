@@ -43,7 +43,9 @@
 #include <meos.h>
 #include <meos_internal.h>
 #include <meos_internal_geo.h>
+#include "temporal/meos_stats.h"
 #include "temporal/set.h"
+#include "temporal/temporal_boxops.h"
 #include "temporal/type_util.h"
 #include "geo/meos_transform.h"
 #include "geo/stbox.h"
@@ -354,6 +356,115 @@ to_dec(POINT4D *pt)
  * Functions fetching an LWPROJ structure containing transform information
  *****************************************************************************/
 
+/**
+ * @brief Return a PROJ transformation between two coordinate systems created
+ * in the PROJ context of the calling thread
+ * @param[in] str_in,str_out Definitions of the coordinate systems
+ * @return On error return @p NULL
+ * @note Derived from PostGIS version 3.4.0 function lwproj_from_str(),
+ * file `lwgeom_transform.c`, which uses the default PROJ context shared by
+ * all threads
+ */
+LWPROJ *
+meos_lwproj_from_str(const char *str_in, const char *str_out)
+{
+  if (! str_in || ! str_out)
+    return NULL;
+
+  PJ_CONTEXT *ctx = proj_get_context();
+  PJ *pj = proj_create_crs_to_crs(ctx, str_in, str_out, NULL);
+  if (! pj)
+    return NULL;
+
+  /* Fill in the geodetic parameters for a null transformation, which is how
+   * the information about a coordinate system is stored in the cache */
+  bool source_is_latlong = false;
+  double semi_major_metre = DBL_MAX, semi_minor_metre = DBL_MAX;
+  if (strcmp(str_in, str_out) == 0)
+  {
+    PJ *pj_source_crs = proj_get_source_crs(ctx, pj);
+    PJ_TYPE pj_type = proj_get_type(pj_source_crs);
+    if (pj_type == PJ_TYPE_UNKNOWN)
+    {
+      proj_destroy(pj_source_crs); proj_destroy(pj);
+      meos_error(ERROR, MEOS_ERR_INTERNAL_ERROR,
+        "Unable to access the type of the source coordinate system");
+      return NULL;
+    }
+    source_is_latlong = (pj_type == PJ_TYPE_GEOGRAPHIC_2D_CRS) ||
+      (pj_type == PJ_TYPE_GEOGRAPHIC_3D_CRS);
+    PJ *pj_ellps = proj_get_ellipsoid(ctx, pj_source_crs);
+    proj_destroy(pj_source_crs);
+    if (! pj_ellps || ! proj_ellipsoid_get_parameters(ctx, pj_ellps,
+          &semi_major_metre, &semi_minor_metre, NULL, NULL))
+    {
+      proj_destroy(pj_ellps); proj_destroy(pj);
+      meos_error(ERROR, MEOS_ERR_INTERNAL_ERROR,
+        "Unable to access the ellipsoid of the source coordinate system");
+      return NULL;
+    }
+    proj_destroy(pj_ellps);
+  }
+
+  /* Add an axis swap if necessary */
+  PJ *pj_norm = proj_normalize_for_visualization(ctx, pj);
+  if (! pj_norm)
+    pj_norm = pj;
+  else if (pj != pj_norm)
+    proj_destroy(pj);
+
+  LWPROJ *result = palloc(sizeof(LWPROJ));
+  result->pj = pj_norm;
+  result->pipeline_is_forward = true;
+  result->source_is_latlong = source_is_latlong;
+  result->source_semi_major_metre = semi_major_metre;
+  result->source_semi_minor_metre = semi_minor_metre;
+  return result;
+}
+
+/**
+ * @brief Return a PROJ transformation from a pipeline created in the PROJ
+ * context of the calling thread
+ * @param[in] pipeline Pipeline
+ * @param[in] is_forward True when the pipeline is applied forward
+ * @return On error return @p NULL
+ * @note Derived from PostGIS version 3.4.0 function
+ * lwproj_from_str_pipeline(), file `lwgeom_transform.c`
+ */
+LWPROJ *
+meos_lwproj_from_str_pipeline(const char *pipeline, bool is_forward)
+{
+  if (! pipeline)
+    return NULL;
+
+  PJ_CONTEXT *ctx = proj_get_context();
+  PJ *pj = proj_create(ctx, pipeline);
+  if (! pj)
+    return NULL;
+  /* Ensure that we have a transformation and not a coordinate system */
+  if (proj_is_crs(pj))
+  {
+    proj_destroy(pj);
+    return NULL;
+  }
+
+  /* Add an axis swap if necessary */
+  PJ *pj_norm = proj_normalize_for_visualization(ctx, pj);
+  if (! pj_norm)
+    pj_norm = pj;
+  else if (pj != pj_norm)
+    proj_destroy(pj);
+
+  LWPROJ *result = palloc(sizeof(LWPROJ));
+  result->pj = pj_norm;
+  result->pipeline_is_forward = is_forward;
+  /* Geodetic parameters are not used for pipelines */
+  result->source_is_latlong = false;
+  result->source_semi_major_metre = DBL_MAX;
+  result->source_semi_minor_metre = DBL_MAX;
+  return result;
+}
+
 /**
  * @brief Return 1 if the SRID is geodetic, return 0 otherwise
  */
@@ -406,7 +517,9 @@ point_transf_pj(GSERIALIZED *gs, int32_t srid_to, const LWPROJ *pj)
   PJ_XYZT v = {pa_double[0], pa_double[1], has_z ? pa_double[2] : 0.0, 0.0};
   PJ_COORD c;
   c.xyzt = v;
+  MEOS_STATS_START(start);
   PJ_COORD t = proj_trans(pj->pj, direction, c);
+  MEOS_STATS_END(MEOS_STAT_PROJ, start);
 
   int pj_errno_val = proj_errno_reset(pj->pj);
   if (pj_errno_val)
@@ -451,10 +564,19 @@ Datum
     case T_GEOMETRY:
     case T_GEOGRAPHY:
     {
-      /* TODO This DOES NOT transform the geometry, it should be fixed */
-      LWGEOM *geo = lwgeom_from_gserialized(DatumGetGserializedP(d));
-      if (! lwgeom_transform(geo, (LWPROJ *) pj))
+      /* The coordinates of the LWGEOM point to those of the input geometry,
+       * which is cloned since it is transformed in place */
+      LWGEOM *geo1 = lwgeom_from_gserialized(DatumGetGserializedP(d));
+      LWGEOM *geo = lwgeom_clone_deep(geo1);
+      lwgeom_free(geo1);
+      MEOS_STATS_START(start);
+      int rv = lwgeom_transform(geo, (LWPROJ *) pj);
+      MEOS_STATS_END(MEOS_STAT_PROJ, start);
+      if (! rv)
+      {
+        lwgeom_free(geo);
         return PointerGetDatum(NULL);
+      }
       geo->srid = srid_to;
       Datum result = PointerGetDatum(geo_serialize(geo));
       lwgeom_free(geo);
@@ -553,7 +675,7 @@ spatialset_transform_pipeline(const Set *s, const char *pipeline,
   /* There is NO test verifying whether the input and output SRIDs are equal */
 
   /* Get the structure with information about the projection */
-  LWPROJ *pj = lwproj_from_str_pipeline(pipeline, is_forward);
+  LWPROJ *pj = meos_lwproj_from_str_pipeline(pipeline, is_forward);
   if (! pj)
     return NULL;
 
@@ -564,6 +686,86 @@ spatialset_transform_pipeline(const Set *s, const char *pipeline,
 
 /*****************************************************************************/
 
+/**
+ * @brief Transform in place the points of an array of temporal point instants
+ * to another SRID with a single call to PROJ
+ * @details The coordinates of the points are gathered into a strided array
+ * that is transformed by the function `proj_trans_generic` and then written
+ * back into the points
+ * @param[in,out] instants Array of temporal point instants
+ * @param[in] count Number of elements in the array
+ * @param[in] srid_to SRID, may be @p SRID_UNKNOWN for pipeline
+ * transformations
+ * @param[in] pj Information about the transformation
+ * @note Derived from PostGIS version 3.4.0 function ptarray_transform(),
+ * file `lwgeom_transform.c`
+ */
+static bool
+tpointinstarr_transf_pj(TInstant **instants, int count, int32_t srid_to,
+  const LWPROJ *pj)
+{
+  assert(instants); assert(count > 0); assert(pj);
+  assert(tpoint_type(instants[0]->temptype));
+  bool hasz = MEOS_FLAGS_GET_Z(instants[0]->flags);
+  int ndims = hasz ? 3 : 2;
+  size_t stride = sizeof(double) * ndims;
+  PJ_DIRECTION direction = pj->pipeline_is_forward ? PJ_FWD : PJ_INV;
+
+  /* Gather the coordinates of the points */
+  double *coords = palloc(stride * count);
+  for (int i = 0; i < count; i++)
+  {
+    const GSERIALIZED *gs = DatumGetGserializedP(tinstant_value_p(instants[i]));
+    memcpy(&coords[i * ndims], GS_POINT_PTR(gs), stride);
+  }
+
+  /* Convert to radians if necessary */
+  if (proj_angular_input(pj->pj, direction))
+  {
+    for (int i = 0; i < count * ndims; i += ndims)
+    {
+      coords[i] *= M_PI / 180.0;
+      coords[i + 1] *= M_PI / 180.0;
+    }
+  }
+
+  MEOS_STATS_START(start);
+  size_t n_converted = proj_trans_generic(pj->pj, direction,
+    coords, stride, count, /* X */
+    coords + 1, stride, count, /* Y */
+    hasz ? coords + 2 : NULL, hasz ? stride : 0, hasz ? count : 0, /* Z */
+    NULL, 0, 0 /* M */);
+  MEOS_STATS_END(MEOS_STAT_PROJ, start);
+  int pj_errno_val = proj_errno_reset(pj->pj);
+  if (n_converted != (size_t) count || pj_errno_val)
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG,
+      "Transform: %s (%d)", proj_errno_string(pj_errno_val), pj_errno_val);
+    pfree(coords);
+    return false;
+  }
+
+  /* Convert radians to degrees if necessary */
+  if (proj_angular_output(pj->pj, direction))
+  {
+    for (int i = 0; i < count * ndims; i += ndims)
+    {
+      coords[i] *= 180.0 / M_PI;
+      coords[i + 1] *= 180.0 / M_PI;
+    }
+  }
+
+  /* Write back the coordinates into the points */
+  for (int i = 0; i < count; i++)
+  {
+    GSERIALIZED *gs = DatumGetGserializedP(tinstant_value_p(instants[i]));
+    memcpy(GS_POINT_PTR(gs), &coords[i * ndims], stride);
+    gserialized_set_srid(gs, srid_to);
+  }
+  pfree(coords);
+  return true;
+}
+
 /**
  * @brief Return a spatiotemporal type transformed to another SRID
  * @param[in] inst Spatiotemporal instant
@@ -575,6 +777,17 @@ TInstant *
 tspatialinst_transf_pj(const TInstant *inst, int32_t srid_to, const LWPROJ *pj)
 {
   assert(inst); assert(pj); assert(tspatial_type(inst->temptype));
+  /* Transform the point of a copy of a temporal point in place */
+  if (tpoint_type(inst->temptype))
+  {
+    TInstant *result = tinstant_copy(inst);
+    if (! tpointinstarr_transf_pj(&result, 1, srid_to, pj))
+    {
+      pfree(result);
+      return NULL;
+    }
+    return result;
+  }
   meosType basetype = temptype_basetype(inst->temptype);
   /* The SRID of the geometry is set in the following function */
   Datum d = datum_transf_pj(tinstant_value_p(inst), basetype, srid_to, pj);
@@ -583,6 +796,67 @@ tspatialinst_transf_pj(const TInstant *inst, int32_t srid_to, const LWPROJ *pj)
   return tinstant_make_free(d, inst->temptype, inst->t);
 }
 
+/**
+ * @brief Return a temporal point sequence transformed to another SRID
+ * @details The points of a copy of the sequence are transformed in place
+ * with a single call to PROJ and the bounding box is recomputed
+ * @param[in] seq Temporal point sequence
+ * @param[in] srid_to SRID
+ * @param[in] pj Information about the transformation
+ */
+static TSequence *
+tpointseq_transf_pj(const TSequence *seq, int32_t srid_to, const LWPROJ *pj)
+{
+  TSequence *result = tsequence_copy(seq);
+  TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  for (int i = 0; i < seq->count; i++)
+    instants[i] = (TInstant *) TSEQUENCE_INST_N(result, i);
+  bool success = tpointinstarr_transf_pj(instants, seq->count, srid_to, pj);
+  pfree(instants);
+  if (! success)
+  {
+    pfree(result);
+    return NULL;
+  }
+  tsequence_compute_bbox(result);
+  return result;
+}
+
+/**
+ * @brief Return a temporal point sequence set transformed to another SRID
+ * @details The points of all the sequences of a copy of the sequence set
+ * are transformed in place with a single call to PROJ and the bounding boxes
+ * are recomputed
+ * @param[in] ss Temporal point sequence set
+ * @param[in] srid_to SRID
+ * @param[in] pj Information about the transformation
+ */
+static TSequenceSet *
+tpointseqset_transf_pj(const TSequenceSet *ss, int32_t srid_to,
+  const LWPROJ *pj)
+{
+  TSequenceSet *result = tsequenceset_copy(ss);
+  TInstant **instants = palloc(sizeof(TInstant *) * ss->totalcount);
+  int ninsts = 0;
+  for (int i = 0; i < ss->count; i++)
+  {
+    const TSequence *seq = TSEQUENCESET_SEQ_N(result, i);
+    for (int j = 0; j < seq->count; j++)
+      instants[ninsts++] = (TInstant *) TSEQUENCE_INST_N(seq, j);
+  }
+  bool success = tpointinstarr_transf_pj(instants, ninsts, srid_to, pj);
+  pfree(instants);
+  if (! success)
+  {
+    pfree(result);
+    return NULL;
+  }
+  for (int i = 0; i < ss->count; i++)
+    tsequence_compute_bbox((TSequence *) TSEQUENCESET_SEQ_N(result, i));
+  tsequenceset_compute_bbox(result);
+  return result;
+}
+
 /**
  * @brief Return a spatiotemporal type transformed to another SRID
  * @param[in] seq Spatiotemporal sequence
@@ -593,6 +867,9 @@ TSequence *
 tspatialseq_transf_pj(const TSequence *seq, int32_t srid_to, const LWPROJ *pj)
 {
   assert(seq); assert(pj); assert(tspatial_type(seq->temptype));
+  /* Transform all the points of a temporal point with a single call */
+  if (tpoint_type(seq->temptype) && seq->count > 1)
+    return tpointseq_transf_pj(seq, srid_to, pj);
   TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
   for (int i = 0; i < seq->count; i++)
   {
@@ -618,6 +895,9 @@ tspatialseqset_transf_pj(const TSequenceSet *ss, int32_t srid_to,
   const LWPROJ *pj)
 {
   assert(ss); assert(pj); assert(tspatial_type(ss->temptype));
+  /* Transform all the points of a temporal point with a single call */
+  if (tpoint_type(ss->temptype))
+    return tpointseqset_transf_pj(ss, srid_to, pj);
   TSequence **sequences = palloc(sizeof(TSequence *) * ss->count);
   for (int i = 0; i < ss->count; i++)
   {
@@ -715,7 +995,7 @@ tspatial_transform_pipeline(const Temporal *temp, const char *pipeline,
   /* There is NO test verifying whether the input and output SRIDs are equal */
 
   /* Get the structure with information about the projection */
-  LWPROJ *pj = lwproj_from_str_pipeline(pipeline, is_forward);
+  LWPROJ *pj = meos_lwproj_from_str_pipeline(pipeline, is_forward);
   if (! pj)
     return NULL;
 
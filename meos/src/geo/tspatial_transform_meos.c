@@ -27,6 +27,7 @@
 #include <stdio.h>
 /* PostgreSQL */
 #include <postgres.h>
+#include <common/hashfn.h>
 #if ! MEOS
   #include <libpq/pqformat.h>
   #include <executor/spi.h>
@@ -38,6 +39,7 @@
 #endif /* ! MEOS */
 /* MEOS */
 #include <meos.h>
+#include "geo/tspatial.h"
 
 #define maxprojlen  512
 #define spibufferlen 512
@@ -58,16 +60,60 @@ typedef struct struct_PROJSRSCacheItem
 /* PROJ 4 lookup transaction cache methods */
 #define PROJ_CACHE_ITEMS 128
 
+/**
+ * @brief Entry of the hash table giving the position of a pair of SRIDs in
+ * the PROJ SRS cache
+ */
+typedef struct
+{
+  uint64 key;          /**< Pair of SRIDs (hash key) */
+  uint32_t position;   /**< Position of the entry in the cache */
+  char status;         /**< Hash status */
+} PROJSRSCacheEntry;
+
+/**
+ * @brief Return the key of the hash table for a pair of SRIDs
+ */
+static inline uint64
+projsrs_key(int32_t srid_from, int32_t srid_to)
+{
+  return ((uint64) (uint32) srid_from << 32) | (uint64) (uint32) srid_to;
+}
+
+/**
+ * @brief Return the hash value of a pair of SRIDs
+ */
+static inline uint32
+hash_projsrs(uint64 key)
+{
+  return hash_bytes_uint32((uint32) (key >> 32)) ^
+    hash_bytes_uint32((uint32) key);
+}
+
+#define SH_PREFIX projsrs
+#define SH_ELEMENT_TYPE PROJSRSCacheEntry
+#define SH_KEY_TYPE uint64
+#define SH_KEY key
+#define SH_HASH_KEY(tb, key) hash_projsrs(key)
+#define SH_EQUAL(tb, a, b) ((a) == (b))
+#define SH_SCOPE static inline
+#define SH_RAW_ALLOCATOR palloc0
+#define SH_DEFINE
+#define SH_DECLARE
+#include <lib/simplehash.h>
+
 /**
  * @brief The proj4 cache holds a fixed number of reprojection entries
- * @details In normal usage we don't expect it to have many entries, so we
- * always linearly scan the list.
+ * @details The entries are found through a hash table on the pair of SRIDs,
+ * the array of entries is only scanned to find the entry to evict when the
+ * cache is full.
  * @note The structure removes the context field from PostGIS PROJSRSCache
  */
 typedef struct struct_MEOSPROJSRSCache
 {
   PROJSRSCacheItem MEOSPROJSRSCache[PROJ_CACHE_ITEMS];
   uint32_t PROJSRSCacheCount;
+  projsrs_hash *PROJSRSCacheIndex;
 } MEOSPROJSRSCache;
 
 /**
@@ -78,7 +124,7 @@ typedef struct struct_MEOSPROJSRSCache
 #define PROJ_BACKEND_HASH_SIZE 256
 
 /* Global variable to hold the Proj object cache */
-MEOSPROJSRSCache *MEOS_PROJ_CACHE = NULL;
+MEOS_THREAD_LOCAL MEOSPROJSRSCache *MEOS_PROJ_CACHE = NULL;
 
 /**
  * @brief Utility structure to get many potential string representations
@@ -156,6 +202,7 @@ GetMEOSPROJSRSCache()
       return NULL;
     }
     cache->PROJSRSCacheCount = 0;
+    cache->PROJSRSCacheIndex = projsrs_create(PROJ_CACHE_ITEMS, NULL);
     MEOS_PROJ_CACHE = cache;
   }
   return cache;
@@ -175,8 +222,10 @@ meos_finalize_projsrs(void)
       if (cache->MEOSPROJSRSCache[i].projection)
         PROJSRSDestroyPJ(cache->MEOSPROJSRSCache[i].projection);
     }
+    projsrs_destroy(cache->PROJSRSCacheIndex);
+    pfree(cache);
   }
-  pfree(cache);
+  MEOS_PROJ_CACHE = NULL;
   return;
 }
 
@@ -192,17 +241,13 @@ static LWPROJ *
 GetProjectionFromPROJCache(MEOSPROJSRSCache *cache, int32_t srid_from,
   int32_t srid_to)
 {
-  uint32_t i;
-  for (i = 0; i < cache->PROJSRSCacheCount; i++)
-  {
-    if (cache->MEOSPROJSRSCache[i].srid_from == srid_from &&
-        cache->MEOSPROJSRSCache[i].srid_to == srid_to)
-    {
-      cache->MEOSPROJSRSCache[i].hits++;
-      return cache->MEOSPROJSRSCache[i].projection;
-    }
-  }
-  return NULL;
+  PROJSRSCacheEntry *entry = projsrs_lookup(cache->PROJSRSCacheIndex,
+    projsrs_key(srid_from, srid_to));
+  if (! entry)
+    return NULL;
+  PROJSRSCacheItem *item = &cache->MEOSPROJSRSCache[entry->position];
+  item->hits++;
+  return item->projection;
 }
 
 #if ! MEOS
@@ -529,6 +574,10 @@ pgstrs_get_entry(const PjStrs *strs, int n)
 static void
 DeleteFromMEOSPROJSRSCache(MEOSPROJSRSCache *PROJCache, uint32_t position)
 {
+  /* Remove the entry from the hash table */
+  projsrs_delete(PROJCache->PROJSRSCacheIndex,
+    projsrs_key(PROJCache->MEOSPROJSRSCache[position].srid_from,
+      PROJCache->MEOSPROJSRSCache[position].srid_to));
   /* Call PROJSRSDestroyPJ to free the PROJ objects memory */
   PROJSRSDestroyPJ(PROJCache->MEOSPROJSRSCache[position].projection);
   PROJCache->MEOSPROJSRSCache[position].projection = NULL;
@@ -573,7 +622,7 @@ AddToMEOSPROJSRSCache(MEOSPROJSRSCache *PROJCache, int32_t srid_from,
     if (! (pj_from_str && pj_to_str))
       continue;
 
-    projection = lwproj_from_str(pj_from_str, pj_to_str);
+    projection = meos_lwproj_from_str(pj_from_str, pj_to_str);
     if (projection)
       break;
   }
@@ -620,6 +669,10 @@ AddToMEOSPROJSRSCache(MEOSPROJSRSCache *PROJCache, int32_t srid_from,
   PROJCache->MEOSPROJSRSCache[cache_position].srid_to = srid_to;
   PROJCache->MEOSPROJSRSCache[cache_position].projection = projection;
   PROJCache->MEOSPROJSRSCache[cache_position].hits = hits;
+  bool found;
+  PROJSRSCacheEntry *entry = projsrs_insert(PROJCache->PROJSRSCacheIndex,
+    projsrs_key(srid_from, srid_to), &found);
+  entry->position = cache_position;
 
   return projection;
 }
@@ -54,7 +54,7 @@
 #define SQL_ROUTE_MAXLEN  64
 
 /* Global variable saving the SRID of the ways table */
-static int32_t SRID_WAYS = SRID_INVALID;
+static MEOS_THREAD_LOCAL int32_t SRID_WAYS = SRID_INVALID;
 
 /*****************************************************************************
  * Route functions
@@ -94,7 +94,7 @@ typedef struct struct_WaysCache
 } WaysCache;
 
 /* Global variable to hold the Ways record cache */
-WaysCache *MEOS_WAYS_CACHE = NULL;
+MEOS_THREAD_LOCAL WaysCache *MEOS_WAYS_CACHE = NULL;
 
 /*****************************************************************************
  * General functions
@@ -29,8 +29,11 @@
 
 /**
  * @file
- * @brief Implementation of a cache storing the route records read from a ways
- * CSV file
+ * @brief Implementation of an in-memory road network storing the route
+ * records read from a ways CSV file
+ * @details The ways CSV file is read once, the first time a route is
+ * needed. The routes are then accessed through a hash table on the route
+ * identifier and through an RTree on their bounding boxes.
  */
 
 /* C */
@@ -38,10 +41,14 @@
 #include <float.h>
 /* PostgreSQL */
 #include <postgres.h>
+#include <common/hashfn.h>
 /* PostGIS */
 #include <liblwgeom.h>
 /* MEOS */
 #include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal_geo.h>
+#include "temporal/temporal.h"
 #include "geo/tgeo_spatialfuncs.h"
 #include "npoint/tnpoint.h"
 
@@ -57,6 +64,9 @@
 // #define WAYS_CSV "/usr/local/share/ways.csv"
 #define WAYS_CSV "/usr/local/share/ways1000.csv"
 
+/* Initial number of routes of the road network */
+#define WAYS_INITIAL_SIZE 1024
+
 /**
  * @brief Structure to represent a record in the ways CSV file
  */
@@ -68,170 +78,130 @@ typedef struct
 } ways_record;
 
 /**
- * @brief Structure to represent an entry in the ways cache
+ * @brief Structure to represent an entry of the hash table of the road
+ * network
  */
-typedef struct struct_WaysCacheEntry
+typedef struct
 {
-  int64 gid;              /**< Identifier of the route */
-  GSERIALIZED *the_geom;  /**< Geometry of the route */
-  double length;          /**< Length of the route */
-  uint64_t hits;          /**< Number of hits of the route */
-} WaysCacheEntry;
+  int64 gid;              /**< Identifier of the route (hash key) */
+  int index;              /**< Position of the route in the array of routes */
+  char status;            /**< Hash status */
+} WaysEntry;
+
+/**
+ * @brief Return the hash value of a route identifier
+ * @note Same definition as the function `hashint8` in PostgreSQL
+ */
+static inline uint32
+hash_gid(int64 gid)
+{
+  uint32 lohalf = (uint32) gid;
+  uint32 hihalf = (uint32) (gid >> 32);
+  lohalf ^= (gid >= 0) ? hihalf : ~hihalf;
+  return hash_bytes_uint32(lohalf);
+}
 
-/* Number of items stored in the ways cache */
-#define WAYS_CACHE_SIZE 128
+#define SH_PREFIX ways
+#define SH_ELEMENT_TYPE WaysEntry
+#define SH_KEY_TYPE int64
+#define SH_KEY gid
+#define SH_HASH_KEY(tb, key) hash_gid(key)
+#define SH_EQUAL(tb, a, b) ((a) == (b))
+#define SH_SCOPE static inline
+#define SH_RAW_ALLOCATOR palloc0
+#define SH_DEFINE
+#define SH_DECLARE
+#include <lib/simplehash.h>
 
 /**
- * @brief The ways cache holds a fixed number of ways records read from the
- * ways CSV file
- * @note In normal usage we do not expect it to have many entries, so we
- * linearly scan the list
+ * @brief The road network holds all the routes of the ways CSV file
  */
-typedef struct struct_WaysCache
+typedef struct
 {
-  WaysCacheEntry routes[WAYS_CACHE_SIZE];
-  uint32_t count;
-} WaysCache;
+  ways_record *routes;    /**< Array of routes in the order of the file */
+  STBox *boxes;           /**< Bounding boxes of the routes */
+  int count;              /**< Number of routes */
+  int32_t srid;           /**< SRID of the routes */
+  ways_hash *hash;        /**< Hash table on the route identifier */
+  RTree *rtree;           /**< RTree on the bounding boxes of the routes */
+} WaysNetwork;
 
-/* Global variable to hold the ways cache */
-WaysCache *MEOS_WAYS_CACHE = NULL;
+/* Global variable to hold the road network */
+MEOS_THREAD_LOCAL WaysNetwork *MEOS_WAYS_NETWORK = NULL;
 
 /*****************************************************************************
- * Cache management functions
+ * Road network management functions
  *****************************************************************************/
 
 /**
- * @brief Free all the malloc'ed geometries stored in the ways cache and free
- * the cache
+ * @brief Free all the geometries stored in the road network and free the
+ * network
  */
 static void
-DestroyWaysCache(WaysCache *ways_cache)
+DestroyWaysNetwork(WaysNetwork *network)
 {
-  if (ways_cache)
-  {
-    for (uint32_t i = 0; i < ways_cache->count; i++)
-    {
-      if (ways_cache->routes[i].the_geom)
-        pfree(ways_cache->routes[i].the_geom);
-    }
-  }
-  pfree(ways_cache);
+  if (! network)
+    return;
+  for (int i = 0; i < network->count; i++)
+    pfree(network->routes[i].the_geom);
+  if (network->routes)
+    pfree(network->routes);
+  if (network->boxes)
+    pfree(network->boxes);
+  if (network->hash)
+    ways_destroy(network->hash);
+  if (network->rtree)
+    rtree_free(network->rtree);
+  pfree(network);
   return;
 }
 
 /**
- * @brief Get the ways cache variable from the global variable if one exists.
- * If it doesn't exist, make a new blank one and return it.
-*/
-static WaysCache *
-GetWaysCache()
-{
-  WaysCache *ways_cache = MEOS_WAYS_CACHE;
-  if (! ways_cache)
-  {
-    /* Allocate memory */
-    ways_cache = palloc0(sizeof(WaysCache));
-    if (! ways_cache)
-    {
-      meos_error(ERROR, MEOS_ERR_INTERNAL_ERROR,
-        "Unable to allocate space for the ways cache");
-      return NULL;
-    }
-  }
-  MEOS_WAYS_CACHE = ways_cache;
-  return ways_cache;
-}
-
-/**
- * @brief Destroy the ways cache
+ * @brief Destroy the road network
  */
 void
 meos_finalize_ways(void)
 {
-  DestroyWaysCache(MEOS_WAYS_CACHE);
-}
-
-/**
- * @brief Get a route from the ways cache, if not found return `NULL`
- */
-static WaysCacheEntry *
-GetRouteFromWaysCache(WaysCache *ways_cache, int64 gid, bool any_gid)
-{
-  assert(ways_cache->count <= WAYS_CACHE_SIZE);
-  for (uint32_t i = 0; i < ways_cache->count; i++)
-  {
-    if (any_gid || ways_cache->routes[i].gid == gid)
-    {
-      ways_cache->routes[i].hits++;
-      return &ways_cache->routes[i];
-    }
-  }
-  return NULL;
-}
-
-/**
- * @brief Remove from the ways cache the route in a given position 
- */
-static void
-DeleteRouteFromWaysCache(WaysCache *ways_cache, uint32_t position)
-{
-  if (ways_cache->routes[position].the_geom)
-    pfree(ways_cache->routes[position].the_geom);
-  memset(&ways_cache->routes[position], 0, sizeof(WaysCacheEntry));
+  DestroyWaysNetwork(MEOS_WAYS_NETWORK);
+  MEOS_WAYS_NETWORK = NULL;
   return;
 }
 
 /**
- * @brief Add a route to the ways cache
+ * @brief Add a route to the road network
+ * @return Return false if a route with the same identifier was already
+ * added, in which case the route is ignored
  */
-static WaysCacheEntry *
-AddRouteToWaysCache(WaysCache *ways_cache, ways_record *rec)
+static bool
+AddRouteToWaysNetwork(WaysNetwork *network, int *size, int64 gid,
+  GSERIALIZED *geom)
 {
-  assert(ways_cache); assert(rec);
-
-  /* If the cache is full, find the least used element and delete it */
-  uint32_t cache_position = ways_cache->count;
-  uint32_t hits = 1;
-  if (cache_position == WAYS_CACHE_SIZE)
+  bool found;
+  WaysEntry *entry = ways_insert(network->hash, gid, &found);
+  if (found)
+    return false;
+  if (network->count == *size)
   {
-    cache_position = 0;
-    hits = ways_cache->routes[0].hits;
-    for (uint32_t i = 1; i < WAYS_CACHE_SIZE; i++)
-    {
-      if (ways_cache->routes[i].hits < hits)
-      {
-        cache_position = i;
-        hits = ways_cache->routes[i].hits;
-      }
-    }
-    DeleteRouteFromWaysCache(ways_cache, cache_position);
-    /* To avoid the element we are introduced now being evicted next (as it
-     * would have 1 hit, being most likely the lower one) we reuse the hits
-     * from the evicted position and add some extra buffer */
-    hits += 5;
+    *size *= 2;
+    network->routes = repalloc(network->routes, sizeof(ways_record) * *size);
+    network->boxes = repalloc(network->boxes, sizeof(STBox) * *size);
   }
-  else
-    ways_cache->count++;
-  assert(ways_cache->count <= WAYS_CACHE_SIZE);
-
-  /* Store everything in new cache entry */
-  assert(cache_position < WAYS_CACHE_SIZE);
-  ways_cache->routes[cache_position].gid = rec->gid;
-  ways_cache->routes[cache_position].the_geom = rec->the_geom;
-  ways_cache->routes[cache_position].length = rec->length;
-  ways_cache->routes[cache_position].hits = hits;
-
-  return &ways_cache->routes[cache_position];
+  entry->index = network->count;
+  ways_record *rec = &network->routes[network->count];
+  rec->gid = gid;
+  rec->the_geom = geom;
+  rec->length = geom_length(geom);
+  geo_set_stbox(geom, &network->boxes[network->count]);
+  network->count++;
+  return true;
 }
 
 /**
- * @brief Access the ways CSV file to get the geometry of a route and compute
- * its length 
- * @param[in] rid Route identifier
- * @param[out] rec Record to store on the cache
+ * @brief Read the ways CSV file and build the road network
+ * @return On error return @p NULL
  */
-static bool
-get_ways_record(int64 rid, ways_record *rec)
+static WaysNetwork *
+LoadWaysNetwork(void)
 {
   /* The full file path in the first argument is defined in a global variable*/
   FILE *file = fopen(WAYS_CSV, "r");
@@ -239,71 +209,88 @@ get_ways_record(int64 rid, ways_record *rec)
   {
     meos_error(ERROR, MEOS_ERR_INTERNAL_TYPE_ERROR,
       "Cannot open the ways CSV file");
-    return false;
+    return NULL;
   }
 
-  bool result = false;
+  WaysNetwork *network = palloc0(sizeof(WaysNetwork));
+  int size = WAYS_INITIAL_SIZE;
+  network->routes = palloc(sizeof(ways_record) * size);
+  network->boxes = palloc(sizeof(STBox) * size);
+  network->hash = ways_create(size, NULL);
+  network->srid = SRID_INVALID;
+  /* Buffer for reading the geometry strings */
+  char *geo_buffer = palloc(MAX_LENGTH_GEOM);
   /* Continue reading the file */
   do
   {
-    char geo_buffer[MAX_LENGTH_GEOM];
-    int read = fscanf(file, "%ld,%100000s\n", &rec->gid, geo_buffer);
+    int64 gid;
+    int read = fscanf(file, "%ld,%100000s\n", &gid, geo_buffer);
     if (ferror(file))
     {
       meos_error(ERROR, MEOS_ERR_INTERNAL_TYPE_ERROR,
         "Error reading the ways CSV file");
-      return false;
+      fclose(file);
+      pfree(geo_buffer);
+      DestroyWaysNetwork(network);
+      return NULL;
     }
 
     /* Ignore the records with NULL values or empty geometries */
     if (read == 2)
     {
       /* Transform the geometry string into a geometry value */
-      rec->the_geom = geom_in(geo_buffer, -1);
-      if (! geo_is_empty(rec->the_geom))
-      {
-        if (rec->gid == rid)
-        {
-          rec->length = geom_length(rec->the_geom);
-          result = true;
-          break;
-        }
-      }
-      free(rec->the_geom);
+      GSERIALIZED *geom = geom_in(geo_buffer, -1);
+      if (! geom)
+        continue;
+      if (geo_is_empty(geom) ||
+          ! AddRouteToWaysNetwork(network, &size, gid, geom))
+        pfree(geom);
     }
   } while (! feof(file));
 
   /* Close the input file */
   fclose(file);
+  pfree(geo_buffer);
 
-  return result;
+  /* Build the spatial index on the routes */
+  if (network->count > 0)
+  {
+    network->srid = gserialized_get_srid(network->routes[0].the_geom);
+    int64 *ids = palloc(sizeof(int64) * network->count);
+    for (int i = 0; i < network->count; i++)
+      ids[i] = i;
+    network->rtree = rtree_create_stbox();
+    rtree_bulk_load(network->rtree, network->boxes, ids, network->count);
+    pfree(ids);
+  }
+  return network;
 }
 
 /**
- * @brief Return true if a Ways entry was read from the ways cache,
- * return false otherwise
+ * @brief Get the road network from the global variable, reading the ways
+ * CSV file if it has not been read yet
+ * @return On error return @p NULL
  */
-static bool
-route_lookup(int64 gid, bool any_gid, ways_record *rec)
+static WaysNetwork *
+GetWaysNetwork(void)
 {
-  /* Get or initialize the cache for this round */
-  WaysCache* ways_cache = GetWaysCache();
-  if (! ways_cache)
-    return true;
-
-  /* Add the route to the cache if it is not already there */
-  WaysCacheEntry *ways_entry = GetRouteFromWaysCache(ways_cache, gid, any_gid);
-  if (ways_entry == NULL)
-  {
-    if (! get_ways_record(gid, rec))
-      return false;
-    ways_entry = AddRouteToWaysCache(ways_cache, rec);
-    return true;
-  }
-  /* The route was found in the cache */
-  rec->gid = gid; rec->the_geom = ways_entry->the_geom;
-  rec->length = ways_entry->length;
-  return true;
+  if (! MEOS_WAYS_NETWORK)
+    MEOS_WAYS_NETWORK = LoadWaysNetwork();
+  return MEOS_WAYS_NETWORK;
+}
+
+/**
+ * @brief Return the route of the road network with a route identifier, if
+ * not found return `NULL`
+ */
+static const ways_record *
+route_lookup(int64 gid)
+{
+  WaysNetwork *network = GetWaysNetwork();
+  if (! network)
+    return NULL;
+  WaysEntry *entry = ways_lookup(network->hash, gid);
+  return entry ? &network->routes[entry->index] : NULL;
 }
 
 /*****************************************************************************
@@ -312,37 +299,39 @@ route_lookup(int64 gid, bool any_gid, ways_record *rec)
 
 /**
  * @ingroup meos_npoint_base_route
- * @brief Return true if the ways cache contains a route with the route
+ * @brief Return true if the road network contains a route with the route
  * identifier
  * @param[in] rid Route identifier
  */
 bool
 route_exists(int64 rid)
 {
-  ways_record rec;
-  if (route_lookup(rid, false, &rec) == LW_FAILURE)
-    return false;
-  return true;
+  return route_lookup(rid) != NULL;
 }
 
 /**
  * @ingroup meos_npoint_base_route
- * @brief Access the ways cache to get the geometry of a route identifier
+ * @brief Access the road network to get the geometry of a route identifier
  * @param[in] rid Route identifier
  * @return On error return @p NULL
  */
 GSERIALIZED *
 route_geom(int64 rid)
 {
-  ways_record rec;
-  if (route_lookup(rid, false, &rec) == LW_FAILURE)
+  const ways_record *rec = route_lookup(rid);
+  if (! rec)
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+      "Cannot get the geometry for route %ld", rid);
     return NULL;
-  return rec.the_geom;
+  }
+  /* The callers free the geometry */
+  return geo_copy(rec->the_geom);
 }
 
 /**
  * @ingroup meos_npoint_base_route
- * @brief Access the edge table to return the route length from the
+ * @brief Access the road network to return the route length from the
  * corresponding route identifier
  * @param[in] rid Route identifier
  * @return On error return -1.0
@@ -350,19 +339,19 @@ route_geom(int64 rid)
 double
 route_length(int64 rid)
 {
-  ways_record rec;
-  if (route_lookup(rid, false, &rec) == LW_FAILURE)
+  const ways_record *rec = route_lookup(rid);
+  if (! rec)
     return -1.0;
-  return rec.length;
+  return rec->length;
 }
 
 int32_t
 get_srid_ways()
 {
-  ways_record rec;
-  if (route_lookup(0, true, &rec) == LW_FAILURE)
+  WaysNetwork *network = GetWaysNetwork();
+  if (! network)
     return SRID_INVALID;
-  return gserialized_get_srid(rec.the_geom);
+  return network->srid;
 }
 
 /*****************************************************************************
@@ -387,74 +376,43 @@ geompoint_to_npoint(const GSERIALIZED *gs)
   if (srid_ways == SRID_INVALID || ! ensure_same_srid(srid_geom, srid_ways))
     return NULL;
 
-  /* The full file path in the first argument is defined in a global variable*/
-  FILE *file = fopen(WAYS_CSV, "r");
-  if (! file)
-  {
-    meos_error(ERROR, MEOS_ERR_INTERNAL_TYPE_ERROR,
-      "Cannot open the ways CSV file");
-    return NULL;
-  }
+  /* We need to reproduce the following SQL query for a given geometry geo
+   *   SELECT npoint(gid, ST_LineLocatePoint(the_geom, geo))
+   *   FROM public.ways WHERE ST_DWithin(the_geom, geo, DIST_EPSILON)
+   *   ORDER BY ST_Distance(the_geom, geo) LIMIT 1;
+   * The routes whose bounding box is within DIST_EPSILON of the point are
+   * obtained from the RTree */
+  WaysNetwork *network = MEOS_WAYS_NETWORK;
+  STBox box;
+  geo_set_stbox(gs, &box);
+  STBox *query = stbox_expand_space(&box, DIST_EPSILON);
+  int count;
+  int64 *ids = rtree_search(network->rtree, query, &count);
+  pfree(query);
 
-  /* Record holding one line of the file */
-  ways_record rec;
   /* Minimum distance */
   double min_dist = DBL_MAX;
-  /* Position in the geometry with the shortest distance */
-  double pos = 0;
-  /* Continue reading the file */
-  do
+  /* Route with the shortest distance */
+  const ways_record *rec = NULL;
+  for (int i = 0; i < count; i++)
   {
-    /* We need to reproduce the following SQL query for a given geometry geo
-     *   SELECT npoint(gid, ST_LineLocatePoint(the_geom, geo))
-     *   FROM public.ways WHERE ST_DWithin(the_geom, geo, DIST_EPSILON)
-     *   ORDER BY ST_Distance(the_geom, geo) LIMIT 1;
-     */
-    /* Buffer for reading the geometry string */
-    char geo_buffer[MAX_LENGTH_GEOM];
-    int read = fscanf(file, "%ld,%100000s\n", &rec.gid, geo_buffer);
-    if (ferror(file))
-    {
-      meos_error(ERROR, MEOS_ERR_INTERNAL_TYPE_ERROR,
-        "Error reading the ways CSV file");
-      return NULL;
-    }
-
-    /* Ignore the records with NULL values */
-    if (read == 2)
+    const ways_record *cand = &network->routes[ids[i]];
+    double dist = geom_distance2d(cand->the_geom, gs);
+    /* Keep the first route in the order of the file in case of ties */
+    if (dist <= DIST_EPSILON && (dist < min_dist ||
+        (dist == min_dist && cand < rec)))
     {
-      /* Transform the geometry string into a geometry value */
-      rec.the_geom = geom_in(geo_buffer, -1);
-      /* Continue if the geometry is empty */
-      if (geo_is_empty(rec.the_geom))
-      {
-        free(rec.the_geom);
-        continue;
-      }
-      /* Continue if the point is not in the line */
-      pos = line_locate_point(rec.the_geom, gs);
-      if (pos < 0)
-      {
-        free(rec.the_geom);
-        continue;
-      }
-      /* Compute minimal distance */
-      double dist = geom_distance2d(rec.the_geom, gs);
-      if (dist < min_dist)
-        min_dist = dist;
+      min_dist = dist;
+      rec = cand;
     }
-  } while (! feof(file));
-
-  /* Close the input file */
-  fclose(file);
+  }
+  if (ids)
+    pfree(ids);
 
   /* If the point was not found */
-  if (min_dist == DBL_MAX)
+  if (! rec)
     return NULL;
-
-  Npoint *result = npoint_make(rec.gid, pos);
-  free(rec.the_geom);
-  return result;
+  return npoint_make(rec->gid, line_locate_point(rec->the_geom, gs));
 }
 
 /*****************************************************************************/
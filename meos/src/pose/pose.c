@@ -1144,7 +1144,7 @@ pose_transform_pipeline(const Pose *pose, const char *pipeline,
   /* There is NO test verifying whether the input and output SRIDs are equal */
 
   /* Get the structure with information about the projection */
-  LWPROJ *pj = lwproj_from_str_pipeline(pipeline, is_forward);
+  LWPROJ *pj = meos_lwproj_from_str_pipeline(pipeline, is_forward);
   if (! pj)
     return NULL;
 
@@ -49,7 +49,7 @@
 /**
  * @brief Global variable that keeps the last error number
  */
-static int MEOS_ERR_NO = 0;
+static MEOS_THREAD_LOCAL int MEOS_ERR_NO = 0;
 
 /**
  * @brief Read an error number
@@ -134,7 +134,7 @@ int meos_errno_reset(void)
 /**
  * @brief Global variable that keeps the error handler function
  */
-void (*MEOS_ERROR_HANDLER)(int, int, const char *) = NULL;
+MEOS_THREAD_LOCAL void (*MEOS_ERROR_HANDLER)(int, int, const char *) = NULL;
 
 #if MEOS
 /**
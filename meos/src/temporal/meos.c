@@ -51,9 +51,9 @@
 
 /* Global variables */
 
-static bool MEOS_GSL_INITIALIZED = false;
-static gsl_rng *MEOS_GENERATION_RNG = NULL;
-static gsl_rng *MEOS_AGGREGATION_RNG = NULL;
+static MEOS_THREAD_LOCAL bool MEOS_GSL_INITIALIZED = false;
+static MEOS_THREAD_LOCAL gsl_rng *MEOS_GENERATION_RNG = NULL;
+static MEOS_THREAD_LOCAL gsl_rng *MEOS_AGGREGATION_RNG = NULL;
 
 /**
  * @brief Initialize the Gnu Scientific Library
@@ -78,8 +78,11 @@ gsl_initialize(void)
 static void
 gsl_finalize(void)
 {
+  if (! MEOS_GSL_INITIALIZED)
+    return;
   gsl_rng_free(MEOS_GENERATION_RNG);
   gsl_rng_free(MEOS_AGGREGATION_RNG);
+  MEOS_GENERATION_RNG = MEOS_AGGREGATION_RNG = NULL;
   MEOS_GSL_INITIALIZED = false;
   return;
 }
@@ -113,7 +116,7 @@ gsl_get_aggregation_rng(void)
 
 /* Global variables keeping Proj context */
 
-PJ_CONTEXT *MEOS_PJ_CONTEXT = NULL;
+MEOS_THREAD_LOCAL PJ_CONTEXT *MEOS_PJ_CONTEXT = NULL;
 
 /**
  * @brief Initialize the PROJ library
@@ -133,6 +136,8 @@ proj_initialize(void)
 static void
 proj_finalize(void)
 {
+  if (! MEOS_PJ_CONTEXT)
+    return;
   proj_context_destroy(MEOS_PJ_CONTEXT);
   MEOS_PJ_CONTEXT = NULL;
   return;
@@ -140,7 +145,9 @@ proj_finalize(void)
 #endif /* MEOS */
 
 /**
- * @brief Get the random generator used by temporal aggregation
+ * @brief Get the PROJ context of the calling thread
+ * @note All the PROJ objects used by MEOS are created in this context, so
+ * that threads do not share PROJ objects
  */
 PJ_CONTEXT *
 proj_get_context(void)
@@ -182,9 +189,9 @@ proj_get_context(void)
 
 /* Global variables with default definitions taken from globals.c */
 
-int DateStyle = USE_ISO_DATES;
-int DateOrder = DATEORDER_MDY;
-int IntervalStyle = INTSTYLE_POSTGRES;
+MEOS_THREAD_LOCAL int DateStyle = USE_ISO_DATES;
+MEOS_THREAD_LOCAL int DateOrder = DATEORDER_MDY;
+MEOS_THREAD_LOCAL int IntervalStyle = INTSTYLE_POSTGRES;
 
 /***************************************************************************
  * Definitions taken from pg_regress.h/c
@@ -555,11 +562,19 @@ meos_get_intervalstyle(void)
 
 /*****************************************************************************/
 
-/*
- * Initialize MEOS library
+/**
+ * @brief Initialize the state of MEOS for the calling thread
+ * @details The error handler, the session timezone, the PROJ and GEOS
+ * contexts, the random generators of GSL, the DateStyle and IntervalStyle
+ * parameters as well as the caches of MEOS are kept per thread. This function
+ * must be called by every thread using MEOS before calling any other function
+ * of the library, after which the thread may set its own timezone and error
+ * handler. The main thread initializes its state with #meos_initialize.
+ * @note The GEOS context of the thread is created on first use by the
+ * reentrant API of GEOS, to which both MEOS and liblwgeom are mapped
  */
 void
-meos_initialize(void)
+meos_initialize_thread(void)
 {
   meos_initialize_error_handler(NULL);
   meos_initialize_timezone(NULL);
@@ -570,15 +585,21 @@ meos_initialize(void)
   return;
 }
 
-/*
- * Free the timezone cache
+/**
+ * @brief Free the state of MEOS for the calling thread
+ * @details This function must be called by every thread that called
+ * #meos_initialize_thread before it exits
  */
 void
-meos_finalize(void)
+meos_finalize_thread(void)
 {
   meos_finalize_timezone();
   /* Finalize PROJ SRS cache */
   meos_finalize_projsrs();
+  /* Finalize the cache of GEOS prepared geometries */
+  meos_finalize_geos_prepared();
+  /* Finalize the GEOS context */
+  meos_finalize_geos();
 #if NPOINT
   /* Finalize Ways cache */
   meos_finalize_ways();
@@ -590,6 +611,26 @@ meos_finalize(void)
   return;
 }
 
+/*
+ * Initialize MEOS library
+ */
+void
+meos_initialize(void)
+{
+  meos_initialize_thread();
+  return;
+}
+
+/*
+ * Free the timezone cache
+ */
+void
+meos_finalize(void)
+{
+  meos_finalize_thread();
+  return;
+}
+
 /*****************************************************************************/
 #endif /* MEOS */
 /*****************************************************************************/
@@ -0,0 +1,135 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Instrumentation counters of the hot paths of MEOS
+ * @details The counters keep, for each thread, the number of calls and the
+ * cumulative time in nanoseconds spent in the GEOS and PROJ libraries, in
+ * the construction and normalization of temporal sequences and sequence sets,
+ * and in the insertions into the skiplists used by temporal aggregation.
+ * Since the time of a hot path includes the time of the hot paths it calls,
+ * e.g., the construction of a sequence includes the normalization of its
+ * instants, the times of the counters must not be added.
+ *
+ * The counters are only maintained when the library is built with the CMake
+ * option `MEOS_STATS`, e.g., `cmake -DMEOS_STATS=ON ..`
+ */
+
+/* C */
+#include <string.h>
+/* PostgreSQL */
+#include <postgres.h>
+/* MEOS */
+#include <meos.h>
+#include <meos_internal.h>
+#include "temporal/meos_stats.h"
+#include "temporal/temporal.h"
+
+/*****************************************************************************
+ * Global variables
+ *****************************************************************************/
+
+/**
+ * @brief Names of the instrumentation counters
+ */
+static const char *MEOS_STAT_NAMES[] =
+{
+  [MEOS_STAT_GEOS] = "geos",
+  [MEOS_STAT_PROJ] = "proj",
+  [MEOS_STAT_TSEQUENCE_MAKE] = "tsequence_make",
+  [MEOS_STAT_TSEQUENCESET_MAKE] = "tsequenceset_make",
+  [MEOS_STAT_TINSTARR_NORMALIZE] = "tinstarr_normalize",
+  [MEOS_STAT_TSEQARR_NORMALIZE] = "tseqarr_normalize",
+  [MEOS_STAT_SKIPLIST] = "skiplist_splice",
+};
+
+#if MEOS_STATS
+/**
+ * @brief Global variable that keeps the instrumentation counters
+ */
+MEOS_THREAD_LOCAL MeosStat MEOS_STAT_COUNTERS[MEOS_STAT_COUNT];
+#endif /* MEOS_STATS */
+
+/*****************************************************************************/
+
+/**
+ * @ingroup meos_misc
+ * @brief Return the name of an instrumentation counter
+ * @param[in] stat Counter
+ * @return On error return @p NULL
+ */
+const char *
+meos_stat_name(meosStatType stat)
+{
+  if ((int) stat < 0 || (int) stat >= MEOS_STAT_COUNT)
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+      "Invalid instrumentation counter: %d", stat);
+    return NULL;
+  }
+  return MEOS_STAT_NAMES[stat];
+}
+
+/**
+ * @ingroup meos_misc
+ * @brief Copy the instrumentation counters of the current thread
+ * @param[out] stats Array of #MEOS_STAT_COUNT counters indexed by
+ * #meosStatType
+ * @return Return false when the library is built without the counters, in
+ * which case all the counters are set to zero
+ */
+bool
+meos_stats_get(MeosStat *stats)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(stats, false);
+#if MEOS_STATS
+  memcpy(stats, MEOS_STAT_COUNTERS, sizeof(MeosStat) * MEOS_STAT_COUNT);
+  return true;
+#else
+  memset(stats, 0, sizeof(MeosStat) * MEOS_STAT_COUNT);
+  return false;
+#endif /* MEOS_STATS */
+}
+
+/**
+ * @ingroup meos_misc
+ * @brief Reset the instrumentation counters of the current thread
+ */
+void
+meos_stats_reset(void)
+{
+#if MEOS_STATS
+  memset(MEOS_STAT_COUNTERS, 0, sizeof(MeosStat) * MEOS_STAT_COUNT);
+#endif /* MEOS_STATS */
+  return;
+}
+
+/*****************************************************************************/
@@ -2113,6 +2113,24 @@ interval_cmp_value(const Interval *interval)
   return span;
 }
 
+/**
+ * @brief Return the linear representation of an interval in microseconds,
+ * that is, the value used by #pg_interval_cmp for comparing intervals,
+ * saturated to the range of a 64-bit integer
+ * @details This enables to compare the difference of two timestamps with an
+ * interval without building an intermediate interval
+ */
+int64
+interval_cmp_usecs(const Interval *interval)
+{
+  INT128 span = interval_cmp_value(interval);
+  if (int128_compare(span, int64_to_int128(PG_INT64_MAX)) > 0)
+    return PG_INT64_MAX;
+  if (int128_compare(span, int64_to_int128(PG_INT64_MIN)) < 0)
+    return PG_INT64_MIN;
+  return int128_to_int64(span);
+}
+
 /**
  * @ingroup meos_base_types
  * @brief Return the multiplication of an interval and a factor
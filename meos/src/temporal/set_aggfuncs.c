@@ -0,0 +1,231 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Hash-based state for the union aggregate of set types
+ * @details The state keeps the distinct values aggregated so far in a hash
+ * table, so that its size depends on the number of distinct values rather
+ * than on the number of input values. The values are only sorted once by the
+ * final function, using a radix sort for the integer and timestamp types.
+ * Two states can be merged, which enables parallel aggregation, and a state
+ * is serialized as the set of its values.
+ */
+
+/* C */
+#include <assert.h>
+/* PostgreSQL */
+#include <postgres.h>
+/* MEOS */
+#include <meos.h>
+#include <meos_internal.h>
+#include "temporal/set.h"
+#include "temporal/type_util.h"
+
+/*****************************************************************************
+ * Hash table of distinct values
+ *****************************************************************************/
+
+/**
+ * @brief Entry of the hash table of a set union aggregate
+ */
+typedef struct
+{
+  Datum value;   /**< Value, copied in the state if passed by reference */
+  uint32 hash;   /**< Hash of the value */
+  char status;   /**< Hash status */
+} SetUnionEntry;
+
+#define SH_PREFIX setunion
+#define SH_ELEMENT_TYPE SetUnionEntry
+#define SH_KEY_TYPE Datum
+#define SH_KEY value
+#define SH_HASH_KEY(tb, key) \
+  datum_hash(key, ((SetUnionState *) (tb)->private_data)->basetype)
+#define SH_EQUAL(tb, a, b) \
+  datum_eq(a, b, ((SetUnionState *) (tb)->private_data)->basetype)
+#define SH_STORE_HASH
+#define SH_GET_HASH(tb, a) a->hash
+#define SH_SCOPE static inline
+#define SH_RAW_ALLOCATOR palloc0
+#define SH_DEFINE
+#define SH_DECLARE
+#include <lib/simplehash.h>
+
+/**
+ * @brief Initial size of the hash table of a set union aggregate
+ */
+#define SETUNION_INITIAL_SIZE 64
+
+/*****************************************************************************
+ * Set union aggregate state
+ *****************************************************************************/
+
+/**
+ * @brief Return a new empty state for the union aggregate of sets
+ * @param[in] basetype Base type of the values
+ */
+SetUnionState *
+set_union_state_make(meosType basetype)
+{
+  assert(set_basetype(basetype));
+  SetUnionState *result = palloc(sizeof(SetUnionState));
+  result->basetype = basetype;
+  result->table = setunion_create(SETUNION_INITIAL_SIZE, result);
+  return result;
+}
+
+/**
+ * @brief Add a value to the state of a union aggregate if it is not already
+ * in it
+ * @param[in,out] state State
+ * @param[in] value Value
+ * @note Values passed by reference are copied in the state when they are
+ * added for the first time
+ */
+void
+set_union_state_add(SetUnionState *state, Datum value)
+{
+  assert(state);
+  bool found;
+  SetUnionEntry *entry = setunion_insert(state->table, value, &found);
+  if (! found)
+    entry->value = datum_copy(value, state->basetype);
+  return;
+}
+
+/**
+ * @brief Add the values of a set to the state of a union aggregate
+ * @param[in,out] state State
+ * @param[in] s Set
+ */
+void
+set_union_state_add_set(SetUnionState *state, const Set *s)
+{
+  assert(state); assert(s);
+  assert(state->basetype == s->basetype);
+  for (int i = 0; i < s->count; i++)
+    set_union_state_add(state, SET_VAL_N(s, i));
+  return;
+}
+
+/**
+ * @brief Return the number of distinct values of the state of a union
+ * aggregate
+ * @param[in] state State
+ */
+int
+set_union_state_count(const SetUnionState *state)
+{
+  assert(state);
+  return (int) state->table->members;
+}
+
+/**
+ * @brief Merge the second state of a union aggregate into the first one
+ * @param[in,out] state1 State that is modified
+ * @param[in] state2 State that is merged
+ * @note This is the combine function of the aggregate, the values of the
+ * second state are copied into the first one
+ */
+void
+set_union_state_merge(SetUnionState *state1, const SetUnionState *state2)
+{
+  assert(state1); assert(state2);
+  assert(state1->basetype == state2->basetype);
+  setunion_iterator iter;
+  SetUnionEntry *entry;
+  setunion_start_iterate(state2->table, &iter);
+  while ((entry = setunion_iterate(state2->table, &iter)) != NULL)
+    set_union_state_add(state1, entry->value);
+  return;
+}
+
+/**
+ * @brief Return the set of values of the state of a union aggregate
+ * @param[in] state State
+ * @return On empty state return @p NULL
+ * @note The state is not modified so that the function can be called several
+ * times on the same state
+ */
+Set *
+set_union_state_finalize(const SetUnionState *state)
+{
+  assert(state);
+  int count = set_union_state_count(state);
+  if (count == 0)
+    return NULL;
+
+  Datum *values = palloc(sizeof(Datum) * count);
+  setunion_iterator iter;
+  SetUnionEntry *entry;
+  int i = 0;
+  setunion_start_iterate(state->table, &iter);
+  while ((entry = setunion_iterate(state->table, &iter)) != NULL)
+    values[i++] = entry->value;
+
+  /* The values are distinct, only the values of the integer and timestamp
+   * types are sorted here since the comparison of the others requires the
+   * comparison function of the base type */
+  meosType basetype = state->basetype;
+  bool order = ORDER;
+  if (basetype == T_INT4 || basetype == T_INT8 || basetype == T_DATE ||
+      basetype == T_TIMESTAMPTZ)
+  {
+    datumarr_radix_sort(values, count, basetype);
+    order = ORDER_NO;
+  }
+  Set *result = set_make_exp(values, count, count, basetype, order);
+  pfree(values);
+  return result;
+}
+
+/**
+ * @brief Free the state of a union aggregate
+ * @param[in] state State
+ */
+void
+set_union_state_free(SetUnionState *state)
+{
+  if (! state)
+    return;
+  if (! basetype_byvalue(state->basetype))
+  {
+    setunion_iterator iter;
+    SetUnionEntry *entry;
+    setunion_start_iterate(state->table, &iter);
+    while ((entry = setunion_iterate(state->table, &iter)) != NULL)
+      pfree(DatumGetPointer(entry->value));
+  }
+  setunion_destroy(state->table);
+  pfree(state);
+  return;
+}
+
+/*****************************************************************************/
@@ -176,14 +176,24 @@ set_append_value(Set *set, Datum value)
   for (int i = 0; i < set->count; i++)
     values[i] = SET_VAL_N(set, i);
   values[set->count] = value;
-  int maxcount = (set->count < set->maxcount) ?
-    set->maxcount : set->maxcount * 2;
+  /* Remove the duplicates before deciding whether the capacity must be
+   * doubled, otherwise the state of an aggregate of many repeated values
+   * grows with the number of input values instead of the distinct ones */
+  if (set->basetype == T_INT4 || set->basetype == T_INT8 ||
+      set->basetype == T_DATE || set->basetype == T_TIMESTAMPTZ)
+    datumarr_radix_sort(values, set->count + 1, set->basetype);
+  else
+    datumarr_sort(values, set->count + 1, set->basetype);
+  int count = datumarr_remove_duplicates(values, set->count + 1,
+    set->basetype);
+  int maxcount = (count * 2 > set->maxcount) ?
+    set->maxcount * 2 : set->maxcount;
 #ifdef DEBUG_EXPAND
   meos_error(WARNING, " Set -> %d\n", maxcount);
 #endif /* DEBUG_EXPAND */
 
-  Set *result = set_make_exp(values, set->count + 1, maxcount, set->basetype,
-    ORDER);
+  Set *result = set_make_exp(values, count, maxcount, set->basetype,
+    ORDER_NO);
   pfree(values); pfree(set);
   return result;
 }
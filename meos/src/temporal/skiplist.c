@@ -54,6 +54,7 @@
 /* MEOS */
 #include <meos.h>
 #include <meos_internal.h>
+#include "temporal/meos_stats.h"
 #include "temporal/temporal_aggfuncs.h"
 #include "temporal/type_util.h"
 
@@ -579,6 +580,7 @@ skiplist_splice(SkipList *list, void **keys, void **values, int count,
   datum_func2 func, bool crossings, SkipListType sktype UNUSED)
 #endif /* ! MEOS */
 {
+  MEOS_STATS_START(start);
   /* Number of elements that will be merged with the new values */
   int spliced_count = 0;
   /* Height of the element at which the new values will be merged, initialized
@@ -699,6 +701,7 @@ skiplist_splice(SkipList *list, void **keys, void **values, int count,
 #endif /* ! MEOS */
     if (sktype == TEMPORAL)
     {
+      newelem->key = NULL;
       newelem->value = temporal_copy(values[i]);
     }
     else
@@ -707,6 +710,7 @@ skiplist_splice(SkipList *list, void **keys, void **values, int count,
       {
         void *newkey = palloc(list->key_size);
         memcpy(newkey, keys[i], list->key_size);
+        newelem->key = newkey;
       }
       else
         newelem->key = NULL;
@@ -733,6 +737,73 @@ skiplist_splice(SkipList *list, void **keys, void **values, int count,
   /* Free memory */
   if (spliced_count != 0)
     pfree_array((void **) tofree, nfree);
+  MEOS_STATS_END(MEOS_STAT_SKIPLIST, start);
+  return;
+}
+
+/**
+ * @brief Replace the elements of a skiplist by an array of values sorted in
+ * increasing order
+ * @details The list is rebuilt in a single pass from left to right keeping
+ * for each level the last element linked so far, instead of searching the
+ * position of each value as done in #skiplist_splice. The complexity of this
+ * function is O(count).
+ * @param[in,out] list Skiplist
+ * @param[in] values Array of values, which are owned by the skiplist after
+ * the call
+ * @param[in] count Number of elements in the array
+ * @note The values of the list before the call are NOT freed, the calling
+ * function is responsible for freeing them
+ */
+void
+skiplist_load(SkipList *list, void **values, int count)
+{
+  /* Ensure that the elements fit in the list, the head and the tail */
+  if (count + 2 > list->capacity)
+  {
+    if (sizeof(SkipListElem) * (size_t) (count + 2) > MaxAllocSize)
+    {
+      meos_error(ERROR, MEOS_ERR_MEMORY_ALLOC_ERROR,
+        "No more memory available to compute the aggregation");
+      return;
+    }
+    while (list->capacity < count + 2)
+      list->capacity <<= SKIPLIST_GROW;
+    if (sizeof(SkipListElem) * list->capacity > MaxAllocSize)
+      list->capacity = (int) floor(MaxAllocSize / sizeof(SkipListElem));
+    list->elems = repalloc(list->elems, sizeof(SkipListElem) * list->capacity);
+  }
+
+  /* Link the elements keeping the last element of each level */
+  int last[SKIPLIST_MAXLEVEL] = {0};
+  int height = 0;
+  for (int i = 0; i < count; i++)
+  {
+    int new = i + 2;
+    SkipListElem *newelem = &list->elems[new];
+    newelem->key = NULL;
+    newelem->value = values[i];
+    newelem->height = random_level();
+    for (int level = 0; level < newelem->height; level++)
+    {
+      list->elems[last[level]].next[level] = new;
+      last[level] = new;
+    }
+    if (newelem->height > height)
+      height = newelem->height;
+  }
+  /* Close all the levels with the tail */
+  SkipListElem *head = &list->elems[0];
+  SkipListElem *tail = &list->elems[1];
+  for (int level = 0; level < Max(height, 1); level++)
+    list->elems[last[level]].next[level] = 1;
+  head->height = height;
+  tail->height = height;
+  tail->next[0] = -1;
+  list->tail = 1;
+  list->length = count;
+  list->next = count + 2;
+  list->freecount = 0;
   return;
 }
 
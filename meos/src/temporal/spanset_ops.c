@@ -1102,9 +1102,16 @@ minus_value_spanset(Datum value, const SpanSet *ss)
 }
 
 /**
- * @brief Return in the last argument the difference of a span and a span set
+ * @brief Return in the last argument the difference of a span and the spans
+ * of a span set between two indices
+ * @param[in] s Span
+ * @param[in] ss Span set
+ * @param[in] from,to Indices of the first and after the last span of the
+ * span set to consider
+ * @param[out] result Array of at least `to - from + 1` spans
+ * @return Number of spans in the result
  */
-static int
+int
 mi_span_spanset(const Span *s, const SpanSet *ss, int from, int to,
   Span *result)
 {
@@ -1246,17 +1253,24 @@ minus_spanset_spanset(const SpanSet *ss1, const SpanSet *ss2)
   if (! overlaps_span_span(&ss1->span, &ss2->span))
     return spanset_copy(ss1);
 
-  Span *spans = palloc(sizeof(Span) * (ss1->count + ss2->count));
+  /* A span of the second span set may split several spans of the first one */
+  Span *spans = palloc(sizeof(Span) * (ss1->count * 2 + ss2->count));
   int i = 0, j = 0, nspans = 0;
   while (i < ss1->count && j < ss2->count)
   {
     const Span *s1 = SPANSET_SP_N(ss1, i);
     const Span *s2 = SPANSET_SP_N(ss2, j);
-    /* The spans do not overlap, copy the first span */
+    /* The spans do not overlap, copy the first span if it is before the
+     * second one, otherwise skip the second span */
     if (! overlaps_span_span(s1, s2))
     {
-      spans[nspans++] = *s1;
-      i++;
+      if (left_span_span(s1, s2))
+      {
+        spans[nspans++] = *s1;
+        i++;
+      }
+      else
+        j++;
     }
     else
     {
@@ -1277,7 +1291,8 @@ minus_spanset_spanset(const SpanSet *ss1, const SpanSet *ss2)
       /* Compute the difference of the overlapping spans */
       nspans += mi_span_spanset(s1, ss2, j, to, &spans[nspans]);
       i++;
-      j = k;
+      /* The last overlapping span may also overlap the next span */
+      j = k - 1;
     }
   }
   /* Copy the sequences after the span set */
@@ -40,6 +40,8 @@
 /* PostgreSQL */
 #include <postgres.h>
 #include <utils/timestamp.h>
+/* PostGIS */
+#include <liblwgeom.h>
 /* MEOS */
 #include <meos.h>
 #include <meos_internal.h>
@@ -431,9 +433,9 @@ tinstant_tagg(const TInstant **instants1, int count1,
       j++;
     }
   }
-  /* We finished to aggregate state1 */
-  assert (i == count1);
-  /* Copy the instants from state2 that are after the end of state1 */
+  /* Copy the remaining instants, which are after the end of the other array */
+  while (i < count1)
+    result[count++] = tinstant_copy(instants1[i++]);
   while (j < count2)
     result[count++] = tinstant_copy(instants2[j++]);
   /* Set the output parameters and return */
@@ -812,6 +814,11 @@ temporal_tagg_transfn(SkipList *state, const Temporal *temp, datum_func2 func,
 
 /**
  * @brief Generic combine function for aggregating temporal values
+ * @details When the time frames of the two states are disjoint, the values
+ * of the second state are spliced into the first one. Otherwise, the values
+ * of both states are merged in a single linear pass and the skiplist of the
+ * first state is rebuilt from the result, which avoids searching, splicing
+ * out, and copying again every overlapping value of the first state.
  * @param[in] state1, state2 State values
  * @param[in] func Aggregate function
  * @param[in] crossings True if turning points are added in the segments
@@ -832,11 +839,499 @@ temporal_tagg_combinefn(SkipList *state1, SkipList *state2, datum_func2 func,
   if (state2->length == 0)
     return state1;
 
-  int count2 = state2->length;
+  int count1 = state1->length, count2 = state2->length;
+  void **values1 = skiplist_values(state1);
   void **values2 = skiplist_values(state2);
-  temporal_skiplist_splice(state1, values2, count2, func, crossings);
+  if (temporal_end_timestamptz(values1[count1 - 1]) <
+        temporal_start_timestamptz(values2[0]) ||
+      temporal_end_timestamptz(values2[count2 - 1]) <
+        temporal_start_timestamptz(values1[0]))
+  {
+    temporal_skiplist_splice(state1, values2, count2, func, crossings);
+    pfree(values1); pfree(values2);
+    return state1;
+  }
+
+#if ! MEOS
+  MemoryContext ctx = set_aggregation_context(fetch_fcinfo());
+#endif /* ! MEOS */
+  int newcount;
+  void **newvalues;
+  if (((Temporal *) values1[0])->subtype == TINSTANT)
+  {
+    void **tofree;
+    int nfree;
+    newvalues = (void **) tinstant_tagg((const TInstant **) values1, count1,
+      (const TInstant **) values2, count2, func, &newcount, &tofree, &nfree);
+    /* The new instants are kept in the state, only the array is freed */
+    if (newvalues)
+      pfree(tofree);
+  }
+  /* The longest array is passed first to the function since the maximum
+   * number of resulting sequences is estimated from it */
+  else if (count1 >= count2)
+    newvalues = (void **) tsequence_tagg((const TSequence **) values1, count1,
+      (const TSequence **) values2, count2, func, crossings, &newcount);
+  else
+    newvalues = (void **) tsequence_tagg((const TSequence **) values2, count2,
+      (const TSequence **) values1, count1, func, crossings, &newcount);
+  if (newvalues)
+  {
+    skiplist_load(state1, newvalues, newcount);
+    /* The previous values of the first state are no longer referenced */
+    pfree_array(values1, count1);
+    pfree(newvalues);
+  }
+  else
+    pfree(values1);
   pfree(values2);
-  return state1;
+#if ! MEOS
+  unset_aggregation_context(ctx);
+#endif /* ! MEOS */
+  return newvalues ? state1 : NULL;
+}
+
+/**
+ * @brief Generic combine function for aggregating an array of states
+ * @details The states are merged pairwise following a balanced tournament,
+ * so that each value takes part in O(log k) merges, where k is the number of
+ * states, instead of O(k) merges when folding the states one after the other
+ * @param[in] states Array of state values, which are consumed by the
+ * function
+ * @param[in] count Number of elements in the array
+ * @param[in] func Aggregate function
+ * @param[in] crossings True if turning points are added in the segments
+ */
+SkipList *
+temporal_tagg_combine_states(SkipList **states, int count, datum_func2 func,
+  bool crossings)
+{
+  assert(states); assert(count >= 0);
+  if (count == 0)
+    return NULL;
+  while (count > 1)
+  {
+    int newcount = 0;
+    for (int i = 0; i < count; i += 2)
+    {
+      if (i + 1 == count)
+      {
+        states[newcount++] = states[i];
+        continue;
+      }
+      SkipList *state = temporal_tagg_combinefn(states[i], states[i + 1],
+        func, crossings);
+      if (! state)
+        return NULL;
+      /* Free the state that has been merged into the other one */
+      skiplist_free(state == states[i] ? states[i + 1] : states[i]);
+      states[newcount++] = state;
+    }
+    count = newcount;
+  }
+  return states[0];
+}
+
+/*****************************************************************************
+ * Serialization of the aggregate state
+ *****************************************************************************/
+
+/* Formats of the serialized aggregate state */
+#define TAGGSTATE_COLUMNAR  1  /**< Columns of timestamps and values */
+#define TAGGSTATE_WKB       2  /**< Array of temporal values in WKB */
+
+/* Size of the header of the serialized aggregate state: format, temporal
+ * type, subtype, number of values, number of instants, and size of the extra
+ * data */
+#define TAGGSTATE_HEADER_SIZE (3 + 2 * sizeof(int32) + sizeof(uint64))
+
+/* Maximum number of bytes of a varint-encoded 64-bit integer */
+#define VARINT_MAX_SIZE 10
+
+/**
+ * @brief Return the number of bytes of a value of a base type in the
+ * columnar format of the aggregate state, 0 if the values are of variable
+ * length and thus cannot be stored in a column
+ */
+static int
+taggstate_value_size(meosType basetype)
+{
+  if (basetype == T_BOOL)
+    return 1;
+  if (basetype == T_INT4 || basetype == T_DATE)
+    return 4;
+  if (basetype_byvalue(basetype))
+    return 8;
+  if (basetype_varlength(basetype))
+    return 0;
+  int16 len = basetype_length(basetype);
+  return len > 0 ? len : 0;
+}
+
+/**
+ * @brief Write an unsigned integer in variable length (LEB128) encoding
+ */
+static uint8_t *
+varint_write(uint8_t *buf, uint64 value)
+{
+  while (value >= 0x80)
+  {
+    *buf++ = (uint8_t) (value | 0x80);
+    value >>= 7;
+  }
+  *buf++ = (uint8_t) value;
+  return buf;
+}
+
+/**
+ * @brief Read an unsigned integer in variable length (LEB128) encoding
+ * @return On error return NULL
+ */
+static const uint8_t *
+varint_read(const uint8_t *buf, const uint8_t *end, uint64 *value)
+{
+  uint64 result = 0;
+  for (int shift = 0; buf < end && shift < 64; shift += 7)
+  {
+    uint8_t byte = *buf++;
+    result |= (uint64) (byte & 0x7F) << shift;
+    if (! (byte & 0x80))
+    {
+      *value = result;
+      return buf;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Write a value of a base type in the columnar format
+ */
+static uint8_t *
+taggstate_value_write(uint8_t *buf, Datum value, meosType basetype, int size)
+{
+  if (basetype == T_BOOL)
+    *buf = (uint8_t) DatumGetBool(value);
+  else if (size == 4)
+  {
+    int32 i = DatumGetInt32(value);
+    memcpy(buf, &i, 4);
+  }
+  else if (basetype_byvalue(basetype))
+    memcpy(buf, &value, 8);
+  else
+    memcpy(buf, DatumGetPointer(value), size);
+  return buf + size;
+}
+
+/**
+ * @brief Read a value of a base type in the columnar format
+ * @param[in] buf Buffer
+ * @param[in] basetype Base type
+ * @param[in] size Size of the value
+ * @param[out] scratch Aligned memory to store the values passed by reference
+ */
+static Datum
+taggstate_value_read(const uint8_t *buf, meosType basetype, int size,
+  void *scratch)
+{
+  if (basetype == T_BOOL)
+    return BoolGetDatum(*buf != 0);
+  if (size == 4)
+  {
+    int32 i;
+    memcpy(&i, buf, 4);
+    return Int32GetDatum(i);
+  }
+  if (basetype_byvalue(basetype))
+  {
+    Datum d;
+    memcpy(&d, buf, 8);
+    return d;
+  }
+  memcpy(scratch, buf, size);
+  return PointerGetDatum(scratch);
+}
+
+/**
+ * @brief Write the header of a serialized aggregate state
+ */
+static uint8_t *
+taggstate_header_write(uint8_t *buf, uint8_t format, const Temporal *first,
+  int32 length, int32 totalcount, const SkipList *state)
+{
+  *buf++ = format;
+  /* An empty state only keeps its extra data */
+  *buf++ = first ? first->temptype : 0;
+  *buf++ = first ? first->subtype : 0;
+  memcpy(buf, &length, sizeof(int32));
+  buf += sizeof(int32);
+  memcpy(buf, &totalcount, sizeof(int32));
+  buf += sizeof(int32);
+  uint64 extrasize = (uint64) state->extrasize;
+  memcpy(buf, &extrasize, sizeof(uint64));
+  buf += sizeof(uint64);
+  if (extrasize)
+  {
+    memcpy(buf, state->extra, state->extrasize);
+    buf += state->extrasize;
+  }
+  return buf;
+}
+
+/**
+ * @ingroup meos_internal_temporal_agg
+ * @brief Return the serialization of an aggregate state
+ * @details The values of the state, which are either all instants or all
+ * sequences of the same temporal type, are written in a columnar format
+ * - for sequences, a column with the number of instants of each sequence
+ *   as varints and a column with its bounds and interpolation,
+ * - a column with the timestamps of all the instants encoded as
+ *   varint deltas, which take 1 to 3 bytes for regular observations,
+ * - a column with the values of all the instants packed with the size of
+ *   the base type.
+ * When the base type is of variable length, the values are written in WKB.
+ * The extra data of the state is written after the header.
+ * @param[in] state State
+ * @param[out] size Size in bytes of the result
+ * @see #taggstate_deserialize
+ */
+uint8_t *
+taggstate_serialize(SkipList *state, size_t *size)
+{
+  assert(state); assert(size);
+  int length = state->length;
+  void **values = skiplist_values(state);
+  const Temporal *first = length ? (const Temporal *) values[0] : NULL;
+  int valsize = first ?
+    taggstate_value_size(temptype_basetype(first->temptype)) : 1;
+
+  /* Variable-length base types are serialized in WKB */
+  if (valsize == 0)
+  {
+    uint8_t **wkbs = palloc(sizeof(uint8_t *) * length);
+    size_t *sizes = palloc(sizeof(size_t) * length);
+    size_t total = TAGGSTATE_HEADER_SIZE + state->extrasize;
+    for (int i = 0; i < length; i++)
+    {
+      wkbs[i] = temporal_as_wkb((const Temporal *) values[i], WKB_EXTENDED,
+        &sizes[i]);
+      total += sizeof(uint64) + sizes[i];
+    }
+    uint8_t *result = palloc(total);
+    uint8_t *buf = taggstate_header_write(result, TAGGSTATE_WKB, first,
+      length, 0, state);
+    for (int i = 0; i < length; i++)
+    {
+      uint64 wkbsize = (uint64) sizes[i];
+      memcpy(buf, &wkbsize, sizeof(uint64));
+      buf += sizeof(uint64);
+      memcpy(buf, wkbs[i], sizes[i]);
+      buf += sizes[i];
+    }
+    pfree_array((void **) wkbs, length);
+    pfree(sizes); pfree(values);
+    *size = total;
+    return result;
+  }
+
+  /* Compute an upper bound of the size of the result */
+  bool seqs = first && first->subtype == TSEQUENCE;
+  int totalcount = 0;
+  for (int i = 0; i < length; i++)
+    totalcount += seqs ? ((const TSequence *) values[i])->count : 1;
+  size_t maxsize = TAGGSTATE_HEADER_SIZE + state->extrasize +
+    (seqs ? (size_t) length * (VARINT_MAX_SIZE + 1) : 0) +
+    (size_t) totalcount * (VARINT_MAX_SIZE + valsize);
+  uint8_t *result = palloc(maxsize);
+  uint8_t *buf = taggstate_header_write(result, TAGGSTATE_COLUMNAR, first,
+    length, totalcount, state);
+
+  /* Column of the number of instants, bounds, and interpolation */
+  if (seqs)
+  {
+    for (int i = 0; i < length; i++)
+      buf = varint_write(buf, (uint64) ((const TSequence *) values[i])->count);
+    for (int i = 0; i < length; i++)
+    {
+      const TSequence *seq = (const TSequence *) values[i];
+      *buf++ = (uint8_t) (seq->period.lower_inc | (seq->period.upper_inc << 1) |
+        (MEOS_FLAGS_GET_INTERP(seq->flags) << 2));
+    }
+  }
+  /* Column of the timestamps */
+  TimestampTz prev = 0;
+  for (int i = 0; i < length; i++)
+  {
+    int count = seqs ? ((const TSequence *) values[i])->count : 1;
+    for (int j = 0; j < count; j++)
+    {
+      const TInstant *inst = seqs ?
+        TSEQUENCE_INST_N((const TSequence *) values[i], j) :
+        (const TInstant *) values[i];
+      /* The timestamps are non-decreasing but the deltas are zigzag-encoded
+       * to be robust to any order */
+      int64 delta = (int64) ((uint64) inst->t - (uint64) prev);
+      buf = varint_write(buf, ((uint64) delta << 1) ^ (uint64) (delta >> 63));
+      prev = inst->t;
+    }
+  }
+  /* Column of the values */
+  meosType basetype = first ? temptype_basetype(first->temptype) : T_BOOL;
+  for (int i = 0; i < length; i++)
+  {
+    int count = seqs ? ((const TSequence *) values[i])->count : 1;
+    for (int j = 0; j < count; j++)
+    {
+      const TInstant *inst = seqs ?
+        TSEQUENCE_INST_N((const TSequence *) values[i], j) :
+        (const TInstant *) values[i];
+      buf = taggstate_value_write(buf, tinstant_value_p(inst), basetype,
+        valsize);
+    }
+  }
+  pfree(values);
+  *size = (size_t) (buf - result);
+  return result;
+}
+
+/**
+ * @ingroup meos_internal_temporal_agg
+ * @brief Return an aggregate state from its serialization
+ * @param[in] data Serialized state
+ * @param[in] size Size in bytes of the serialized state
+ * @return On error return NULL
+ * @see #taggstate_serialize
+ */
+SkipList *
+taggstate_deserialize(const uint8_t *data, size_t size)
+{
+  assert(data);
+  const uint8_t *buf = data, *end = data + size;
+  if (size < TAGGSTATE_HEADER_SIZE ||
+      (data[0] != TAGGSTATE_COLUMNAR && data[0] != TAGGSTATE_WKB))
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+      "Invalid serialized aggregate state");
+    return NULL;
+  }
+  uint8_t format = *buf++;
+  meosType temptype = (meosType) *buf++;
+  uint8_t subtype = *buf++;
+  int32 length, totalcount;
+  uint64 extrasize;
+  memcpy(&length, buf, sizeof(int32));
+  buf += sizeof(int32);
+  memcpy(&totalcount, buf, sizeof(int32));
+  buf += sizeof(int32);
+  memcpy(&extrasize, buf, sizeof(uint64));
+  buf += sizeof(uint64);
+  const uint8_t *extra = buf;
+  buf += extrasize;
+  if (length < 0 || totalcount < 0 || buf > end)
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+      "Invalid serialized aggregate state");
+    return NULL;
+  }
+
+  void **values = palloc(sizeof(void *) * Max(length, 1));
+  int nvalues = 0;
+  if (format == TAGGSTATE_WKB)
+  {
+    for (int i = 0; i < length; i++)
+    {
+      uint64 wkbsize;
+      if (buf + sizeof(uint64) > end)
+        break;
+      memcpy(&wkbsize, buf, sizeof(uint64));
+      buf += sizeof(uint64);
+      if (wkbsize > (uint64) (end - buf))
+        break;
+      values[nvalues] = temporal_from_wkb(buf, (size_t) wkbsize);
+      if (! values[nvalues])
+        break;
+      nvalues++;
+      buf += wkbsize;
+    }
+  }
+  else if (length > 0)
+  {
+    meosType basetype = temptype_basetype(temptype);
+    int valsize = taggstate_value_size(basetype);
+    bool seqs = (subtype == TSEQUENCE);
+    /* Read the columns of the number of instants and the flags */
+    int *counts = NULL;
+    const uint8_t *flags = NULL;
+    if (seqs)
+    {
+      counts = palloc(sizeof(int) * length);
+      for (int i = 0; i < length && buf; i++)
+      {
+        uint64 count;
+        buf = varint_read(buf, end, &count);
+        counts[i] = (int) count;
+      }
+      flags = buf;
+      if (buf)
+        buf += length;
+    }
+    /* Decode the timestamps, the values follow */
+    TimestampTz *times = palloc(sizeof(TimestampTz) * Max(totalcount, 1));
+    TimestampTz prev = 0;
+    for (int i = 0; i < totalcount && buf; i++)
+    {
+      uint64 zigzag;
+      buf = varint_read(buf, end, &zigzag);
+      int64 delta = (int64) (zigzag >> 1) ^ -((int64) (zigzag & 1));
+      prev = times[i] = (TimestampTz) ((uint64) prev + (uint64) delta);
+    }
+    if (buf && (size_t) (end - buf) >= (size_t) totalcount * valsize)
+    {
+      /* Aligned memory for the values passed by reference */
+      double scratch[8];
+      int k = 0;
+      for (int i = 0; i < length; i++)
+      {
+        int count = seqs ? counts[i] : 1;
+        if (k + count > totalcount)
+          break;
+        TInstant **instants = palloc(sizeof(TInstant *) * count);
+        for (int j = 0; j < count; j++)
+        {
+          Datum value = taggstate_value_read(buf, basetype, valsize, scratch);
+          buf += valsize;
+          instants[j] = tinstant_make(value, temptype, times[k++]);
+        }
+        if (seqs)
+          values[nvalues++] = tsequence_make_free(instants, count,
+            flags[i] & 1, (flags[i] >> 1) & 1, (interpType) (flags[i] >> 2),
+            NORMALIZE_NO);
+        else
+        {
+          values[nvalues++] = instants[0];
+          pfree(instants);
+        }
+      }
+    }
+    pfree(times);
+    if (counts)
+      pfree(counts);
+  }
+  if (nvalues != length)
+  {
+    pfree_array(values, nvalues);
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+      "Invalid serialized aggregate state");
+    return NULL;
+  }
+
+  SkipList *result = temporal_skiplist_make();
+  skiplist_load(result, values, nvalues);
+  pfree(values);
+  if (extrasize)
+    skiplist_set_extra(result, (void *) extra, (size_t) extrasize);
+  return result;
 }
 
 /**
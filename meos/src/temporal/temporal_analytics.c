@@ -52,6 +52,7 @@
 #include "temporal/span.h"
 #include "temporal/spanset.h"
 #include "temporal/temporal_tile.h"
+#include "temporal/tinstant.h"
 #include "temporal/tsequence.h"
 #include "temporal/type_util.h"
 #include "geo/tgeo_distance.h"
@@ -190,11 +191,295 @@ tinstant_tprecision(const TInstant *inst, const Interval *duration,
   return tinstant_make(tinstant_value_p(inst), inst->temptype, lower);
 }
 
+/**
+ * @brief State of the computation of the time-weighted averages or centroids
+ * of the time bins of a temporal value in a single pass
+ * @details The integral of the values, or of the coordinates of the points,
+ * over the current bin is accumulated while the segments of the temporal value
+ * are read, so that no intermediate sequence is constructed for each bin.
+ * The instantaneous pieces of the value in the bin are accumulated separately
+ * since they only contribute to the result when the bin does not contain a
+ * piece with a positive duration.
+ */
+typedef struct
+{
+  meosType basetype;   /**< Base type of the temporal value */
+  meosType temptype;   /**< Temporal type of the result */
+  bool twavg;          /**< True for the twAvg, false for the twCentroid */
+  bool hasz;           /**< True when the points have Z dimension */
+  int32_t srid;        /**< SRID of the points */
+  int ndims;           /**< Number of values accumulated */
+  int64 tunits;        /**< Size of the bins in PostgreSQL time units */
+  TimestampTz lower;   /**< Lower bound of the current bin */
+  double sum[3];       /**< Integral of the pieces with positive duration */
+  double duration;     /**< Duration of the pieces with positive duration */
+  double instsum[3];   /**< Sum of the values of the instantaneous pieces */
+  int ninsts;          /**< Number of instantaneous pieces or instants */
+  TInstant **instants; /**< Instants of the result, one per nonempty bin */
+  int count;           /**< Number of instants of the result */
+} TPrecisionState;
+
+/**
+ * @brief Return the number of time bins covering a time span and the lower
+ * bound of the first one in the last argument
+ */
+static int
+tprecision_bins(const Span *s, const Interval *duration, TimestampTz torigin,
+  TimestampTz *lower_bin)
+{
+  int64 tunits = interval_units(duration);
+  *lower_bin = timestamptz_get_bin(DatumGetTimestampTz(s->lower), duration,
+    torigin);
+  /* We need to add tunits to obtain the end timestamp of the last bin */
+  TimestampTz upper_bin = timestamptz_get_bin(DatumGetTimestampTz(s->upper),
+    duration, torigin) + tunits;
+  return (int) (((int64) upper_bin - (int64) *lower_bin) / tunits);
+}
+
+/**
+ * @brief Initialize the state for setting the precision of a temporal value
+ */
+static void
+tprecision_state_init(TPrecisionState *state, const Temporal *temp,
+  int64 tunits, TimestampTz lower_bin, TInstant **instants)
+{
+  memset(state, 0, sizeof(TPrecisionState));
+  state->basetype = temptype_basetype(temp->temptype);
+  state->temptype = (temp->temptype == T_TINT) ? T_TFLOAT : temp->temptype;
+  state->twavg = tnumber_type(temp->temptype);
+  state->hasz = MEOS_FLAGS_GET_Z(temp->flags);
+  state->srid = state->twavg ? SRID_UNKNOWN : tspatial_srid(temp);
+  state->ndims = state->twavg ? 1 : (state->hasz ? 3 : 2);
+  state->tunits = tunits;
+  state->lower = lower_bin;
+  state->instants = instants;
+  return;
+}
+
+/**
+ * @brief Get the value or the coordinates of a point as an array of doubles
+ */
+static void
+tprecision_coords(const TPrecisionState *state, Datum value, double *coords)
+{
+  if (state->twavg)
+  {
+    coords[0] = datum_double(value, state->basetype);
+    return;
+  }
+  POINT4D p;
+  datum_point4d(value, &p);
+  coords[0] = p.x; coords[1] = p.y; coords[2] = p.z;
+  return;
+}
+
+/**
+ * @brief Output the twAvg/twCentroid of the current bin if it is not empty
+ * and reinitialize the accumulation
+ */
+static void
+tprecision_flush(TPrecisionState *state)
+{
+  if (state->duration == 0.0 && state->ninsts == 0)
+    return;
+  double coords[3] = {0.0, 0.0, 0.0};
+  for (int i = 0; i < state->ndims; i++)
+    coords[i] = (state->duration > 0.0) ? state->sum[i] / state->duration :
+      state->instsum[i] / state->ninsts;
+  Datum value = state->twavg ? Float8GetDatum(coords[0]) :
+    PointerGetDatum(geopoint_make(coords[0], coords[1], coords[2],
+      state->hasz, false, state->srid));
+  state->instants[state->count++] = tinstant_make(value, state->temptype,
+    state->lower);
+  if (! state->twavg)
+    pfree(DatumGetPointer(value));
+  memset(state->sum, 0, sizeof(state->sum));
+  memset(state->instsum, 0, sizeof(state->instsum));
+  state->duration = 0.0;
+  state->ninsts = 0;
+  return;
+}
+
+/**
+ * @brief Move the state to the bin containing a timestamptz, outputting the
+ * current bin if the timestamptz is after it
+ * @pre The timestamptz is not before the current bin
+ */
+static void
+tprecision_move(TPrecisionState *state, TimestampTz t)
+{
+  if (t - state->lower < state->tunits)
+    return;
+  tprecision_flush(state);
+  state->lower += ((t - state->lower) / state->tunits) * state->tunits;
+  return;
+}
+
+/**
+ * @brief Add to the current bin a piece of a sequence with its integral
+ * @param[in] state State
+ * @param[in] start,end Timestamps of the piece
+ * @param[in] integral Integral of the values over the piece
+ * @param[in] value Value at the start of the piece, which is used when the
+ * piece is instantaneous
+ */
+static void
+tprecision_add_piece(TPrecisionState *state, TimestampTz start,
+  TimestampTz end, const double *integral, const double *value)
+{
+  if (end > start)
+  {
+    for (int i = 0; i < state->ndims; i++)
+      state->sum[i] += integral[i];
+    state->duration += (double) (end - start);
+  }
+  else
+  {
+    for (int i = 0; i < state->ndims; i++)
+      state->instsum[i] += value[i];
+    state->ninsts++;
+  }
+  return;
+}
+
+/**
+ * @brief Add to a running integral the integral of a segment
+ */
+static void
+tprecision_add_segment(const TPrecisionState *state, interpType interp,
+  const double *value1, const double *value2, TimestampTz t1, TimestampTz t2,
+  double *integral)
+{
+  for (int i = 0; i < state->ndims; i++)
+  {
+    if (interp == LINEAR)
+      integral[i] += (value1[i] + value2[i]) * (double) (t2 - t1) / 2.0;
+    else
+      integral[i] += value1[i] * (double) (t2 - t1);
+  }
+  return;
+}
+
+/**
+ * @brief Accumulate the instants of a temporal sequence with discrete
+ * interpolation into the time bins
+ */
+static void
+tdiscseq_tprecision_iter(const TSequence *seq, TPrecisionState *state)
+{
+  double coords[3];
+  for (int i = 0; i < seq->count; i++)
+  {
+    const TInstant *inst = TSEQUENCE_INST_N(seq, i);
+    tprecision_move(state, inst->t);
+    tprecision_coords(state, tinstant_value_p(inst), coords);
+    for (int j = 0; j < state->ndims; j++)
+      state->instsum[j] += coords[j];
+    state->ninsts++;
+  }
+  return;
+}
+
+/**
+ * @brief Accumulate the segments of a temporal sequence with continuous
+ * interpolation into the time bins
+ * @details The segments are split at the bin boundaries, where the value is
+ * interpolated, and the running integral of each bin is computed on the fly.
+ * @param[in] seq Temporal sequence
+ * @param[in] upper_inc True when the instant at the end of the sequence is
+ * taken into account when it is at a bin boundary
+ * @param[in,out] state State
+ */
+static void
+tcontseq_tprecision_iter(const TSequence *seq, bool upper_inc,
+  TPrecisionState *state)
+{
+  interpType interp = MEOS_FLAGS_GET_INTERP(seq->flags);
+  const TInstant *inst1 = TSEQUENCE_INST_N(seq, 0);
+  /* Value and timestamp at the start of the piece in the current bin and at
+   * the start of the part of the segment remaining to be processed */
+  double start[3], value1[3], value2[3], integral[3] = {0.0, 0.0, 0.0};
+  tprecision_coords(state, tinstant_value_p(inst1), value1);
+  memcpy(start, value1, sizeof(start));
+  TimestampTz tstart = inst1->t, t1 = inst1->t;
+  tprecision_move(state, t1);
+  TimestampTz upper = state->lower + state->tunits;
+  for (int i = 1; i < seq->count; i++)
+  {
+    const TInstant *inst2 = TSEQUENCE_INST_N(seq, i);
+    tprecision_coords(state, tinstant_value_p(inst2), value2);
+    /* Split the segment at the bin boundaries it reaches */
+    while (inst2->t >= upper)
+    {
+      double bound[3];
+      if (inst2->t == upper)
+        memcpy(bound, value2, sizeof(bound));
+      else if (interp == STEP)
+        memcpy(bound, value1, sizeof(bound));
+      else
+      {
+        Datum value = tsegment_value_at_timestamptz(tinstant_value_p(inst1),
+          tinstant_value_p(inst2), seq->temptype, inst1->t, inst2->t, upper);
+        tprecision_coords(state, value, bound);
+        DATUM_FREE(value, state->basetype);
+      }
+      tprecision_add_segment(state, interp, value1, bound, t1, upper,
+        integral);
+      tprecision_add_piece(state, tstart, upper, integral, start);
+      tprecision_flush(state);
+      /* Start a new piece at the beginning of the next bin */
+      state->lower = upper;
+      upper += state->tunits;
+      tstart = t1 = state->lower;
+      memcpy(start, bound, sizeof(start));
+      memcpy(value1, bound, sizeof(value1));
+      memset(integral, 0, sizeof(integral));
+    }
+    tprecision_add_segment(state, interp, value1, value2, t1, inst2->t,
+      integral);
+    t1 = inst2->t;
+    memcpy(value1, value2, sizeof(value1));
+    inst1 = inst2;
+  }
+  /* Add the last piece, which is instantaneous when the sequence ends at a
+   * bin boundary */
+  if (t1 > tstart || upper_inc)
+    tprecision_add_piece(state, tstart, t1, integral, start);
+  return;
+}
+
+/**
+ * @brief Return a temporal sequence with the precision set to time bins
+ * using the state
+ * @note The instants of the state are freed after constructing the result
+ */
+static TSequence *
+tsequence_tprecision_state(const TSequence *seq, TPrecisionState *state)
+{
+  interpType interp = MEOS_FLAGS_GET_INTERP(seq->flags);
+  if (interp == DISCRETE)
+    tdiscseq_tprecision_iter(seq, state);
+  else
+    /* The last instant of the sequence starts a new bin when it is at a bin
+     * boundary even if the upper bound of the sequence is exclusive */
+    tcontseq_tprecision_iter(seq, true, state);
+  tprecision_flush(state);
+  /* The lower and upper bounds of the result are both true since the
+   * tprecision operation amounts to a granularity change */
+  TSequence *result = tsequence_make((const TInstant **) state->instants,
+    state->count, true, true, interp, NORMALIZE);
+  for (int i = 0; i < state->count; i++)
+    pfree(state->instants[i]);
+  return result;
+}
+
 /**
  * @brief Return a temporal sequence with the precision set to a time bin
  * @param[in] seq Temporal value
  * @param[in] duration Size of the time bins
  * @param[in] torigin Time origin of the bins
+ * @note The twAvg/twCentroid of the bins are computed in a single pass over
+ * the instants of the sequence without constructing a sequence for each bin
  */
 TSequence *
 tsequence_tprecision(const TSequence *seq, const Interval *duration,
@@ -205,137 +490,51 @@ tsequence_tprecision(const TSequence *seq, const Interval *duration,
     seq->temptype == T_TGEOMPOINT || seq->temptype == T_TGEOGPOINT ||
     seq->temptype == T_TGEOMETRY || seq->temptype == T_TGEOGRAPHY );
 
-  int64 tunits = interval_units(duration);
-  TimestampTz lower = DatumGetTimestampTz(seq->period.lower);
-  TimestampTz upper = DatumGetTimestampTz(seq->period.upper);
-  TimestampTz lower_bin = timestamptz_get_bin(lower, duration, torigin);
-  /* We need to add tunits to obtain the end timestamp of the last bin */
-  TimestampTz upper_bin = timestamptz_get_bin(upper, duration, torigin) +
-    tunits;
-  /* Number of bins */
-  int count = (int) (((int64) upper_bin - (int64) lower_bin) / tunits);
-  TInstant **ininsts = palloc(sizeof(TInstant *) * seq->count);
-  TInstant **outinsts = palloc(sizeof(TInstant *) * count);
-  lower = lower_bin;
-  upper = lower_bin + tunits;
-  interpType interp = MEOS_FLAGS_GET_INTERP(seq->flags);
-  meosType temptype_out = (seq->temptype == T_TINT) ? T_TFLOAT : seq->temptype;
-  /* Determine whether we are computing the twAvg or the twCentroid */
-  bool twavg = tnumber_type(seq->temptype);
-  /* New instants computing the value at the beginning/end of the bin */
-  TInstant *start = NULL, *end = NULL;
-  /* Sequence for computing the twAvg/twCentroid of each bin */
-  TSequence *seq1;
-  Datum value;
-  int i = 0;   /* Instant of the input sequence being processed */
-  int k = 0;   /* Number of instants for computing the twAvg/twCentroid */
-  int l = 0;   /* Number of instants of the output sequence */
-  /* Loop for each instant of the sequence */
-  while (i < seq->count)
+  TimestampTz lower_bin;
+  int count = tprecision_bins(&seq->period, duration, torigin, &lower_bin);
+  TInstant **instants = palloc(sizeof(TInstant *) * count);
+  TPrecisionState state;
+  tprecision_state_init(&state, (Temporal *) seq, interval_units(duration),
+    lower_bin, instants);
+  TSequence *result = tsequence_tprecision_state(seq, &state);
+  pfree(instants);
+  return result;
+}
+
+/**
+ * @brief Return a temporal sequence set with the precision set to time bins
+ * using the state
+ * @note The instants of the state are freed after constructing the result
+ */
+static TSequenceSet *
+tsequenceset_tprecision_state(const TSequenceSet *ss, TPrecisionState *state)
+{
+  for (int i = 0; i < ss->count; i++)
   {
-    /* Get the next instant */
-    TInstant *inst = (TInstant *) TSEQUENCE_INST_N(seq, i);
-    int cmp = timestamptz_cmp_internal(inst->t, upper);
-    if (cmp < 0)
-    {
-      /* ACCUMULATE the instant since it is WITHIN the current bin */
-      ininsts[k++] = inst;
-      i++;
-    }
-    else
-    {
-      /* We have reached the end of the bin or beyond: Add or compute the value
-       * the end of the bin ONLY for continuous interpolation */
-      if (k > 0)
-      {
-        if (interp == STEP)
-        {
-          /* For STEP interpolation ALWAYS generate the end of bin instant */
-          value = ininsts[k - 1]->value;
-          ininsts[k++] = end = tinstant_make(value, seq->temptype, upper);
-        }
-        else if (interp == LINEAR)
-        {
-          /* For LINEAR interpolation generate the end of bin instant ONLY if 
-           * the last instant read is beyond the end of the bin */
-          if (cmp == 0)
-            ininsts[k++] = inst;
-          else
-          {
-            tsequence_value_at_timestamptz(seq, upper, false, &value);
-            ininsts[k++] = end = tinstant_make_free(value, seq->temptype, upper);
-          }
-        }
-        /* Construct the sequence with the accumulated values */
-        seq1 = tsequence_make((const TInstant **) ininsts, k, true,
-          (k == 1) ? true : false, interp, NORMALIZE);
-        /* Compute the twAvg/twCentroid for the bin */
-        value = twavg ? Float8GetDatum(tnumberseq_twavg(seq1)) :
-          PointerGetDatum(tpointseq_twcentroid(seq1));
-        outinsts[l++] = tinstant_make(value, temptype_out, lower);
-        pfree(seq1);
-        if (! twavg)
-          pfree(DatumGetPointer(value));
-      }
-      /* Free the instant at the beginning of the bin if it was generated */
-      if (start)
-      {
-        pfree(start); start = NULL;
-      }
-      if (end)
-      {
-        /* For STEP interpolation, remove the instant generated for the end of
-           the bin when the last instant READ is equal to the end of the bin */
-        if (interp == STEP && cmp == 0)
-          pfree(end);
-        else 
-          start = end;
-        end = NULL;
-      }
-      /* Reinitilize the accumulation by default */
-      k = 0;
-      /* If the last instant READ is the start of the bin */
-      if (cmp == 0)
-      {
-        ininsts[0] = inst; i++; k = 1;
-      }
-      /* If the last instant READ is the after the bin and the interpolation
-       * is continuous and thus the start of the bin has been generated */
-      else if (start)
-      {
-        k = 0;
-        ininsts[k++] = start;
-        /* If the next instant is within the next time bin */
-        if (timestamptz_cmp_internal(inst->t, upper) <= 0)
-        {
-          ininsts[k++] = inst; 
-          i++;
-        }
-      }
-      lower = upper;
-      upper += tunits;
-    }
+    const TSequence *seq = TSEQUENCESET_SEQ_N(ss, i);
+    tcontseq_tprecision_iter(seq, seq->period.upper_inc, state);
   }
-  /* Compute the twAvg/twCentroid of the last bin */
-  if (k > 0)
+  tprecision_flush(state);
+  /* Split the instants into sequences at the empty bins. The lower and upper
+   * bounds of the sequences are both true since the tprecision operation
+   * amounts to a granularity change */
+  interpType interp = MEOS_FLAGS_GET_INTERP(ss->flags);
+  TSequence **sequences = palloc(sizeof(TSequence *) * state->count);
+  int nseqs = 0, first = 0;
+  for (int i = 1; i <= state->count; i++)
   {
-    seq1 = tsequence_make((const TInstant **) ininsts, k, true,
-      (k == 1) ? true : seq->period.upper_inc, interp, NORMALIZE);
-    value = twavg ? Float8GetDatum(tnumberseq_twavg(seq1)) :
-      PointerGetDatum(tpointseq_twcentroid(seq1));
-    outinsts[l++] = tinstant_make(value, temptype_out, lower);
-    if (! twavg)
-      pfree(DatumGetPointer(value));
-    pfree(seq1);
+    if (i == state->count ||
+        state->instants[i]->t - state->instants[i - 1]->t > state->tunits)
+    {
+      sequences[nseqs++] = tsequence_make(
+        (const TInstant **) &state->instants[first], i - first, true, true,
+        interp, NORMALIZE);
+      first = i;
+    }
   }
-  /* The lower and upper bounds of the result are both true since the 
-   * tprecision operation amounts to a granularity change */
-   TSequence *result = tsequence_make_free(outinsts, l, true, true, interp,
-    NORMALIZE);
-  pfree(ininsts);
-  if (start)
-    pfree(start);
-  return result;
+  for (int i = 0; i < state->count; i++)
+    pfree(state->instants[i]);
+  return tsequenceset_make_free(sequences, nseqs, NORMALIZE);
 }
 
 /**
@@ -343,6 +542,8 @@ tsequence_tprecision(const TSequence *seq, const Interval *duration,
  * @param[in] ss Temporal value
  * @param[in] duration Size of the time bins
  * @param[in] torigin Time origin of the bins
+ * @note The twAvg/twCentroid of the bins are computed in a single pass over
+ * the instants of the sequence set without restricting it to each bin
  */
 TSequenceSet *
 tsequenceset_tprecision(const TSequenceSet *ss, const Interval *duration,
@@ -352,72 +553,15 @@ tsequenceset_tprecision(const TSequenceSet *ss, const Interval *duration,
   assert(ss->temptype == T_TINT || ss->temptype == T_TFLOAT ||
     ss->temptype == T_TGEOMPOINT || ss->temptype == T_TGEOGPOINT );
 
-  int64 tunits = interval_units(duration);
-  TimestampTz lower = DatumGetTimestampTz(ss->period.lower);
-  TimestampTz upper = DatumGetTimestampTz(ss->period.upper);
-  TimestampTz lower_bin = timestamptz_get_bin(lower, duration, torigin);
-  /* We need to add tunits to obtain the end timestamp of the last bin */
-  TimestampTz upper_bin = timestamptz_get_bin(upper, duration, torigin) +
-    tunits;
-  /* Number of bins */
-  int count = (int) (((int64) upper_bin - (int64) lower_bin) / tunits);
+  TimestampTz lower_bin;
+  int count = tprecision_bins(&ss->period, duration, torigin, &lower_bin);
   TInstant **instants = palloc(sizeof(TInstant *) * count);
-  TSequence **sequences = palloc(sizeof(TSequence *) * count);
-  lower = lower_bin;
-  upper = lower_bin + tunits;
-  interpType interp = MEOS_FLAGS_GET_INTERP(ss->flags);
-  meosType temptype_out = (ss->temptype == T_TINT) ? T_TFLOAT : ss->temptype;
-  meosType basetype_out = temptype_basetype(temptype_out);
-  /* Determine whether we are computing the twAvg or the twCentroid */
-  bool twavg = tnumber_type(ss->temptype);
-  int ninsts = 0;
-  int nseqs = 0;
-  /* Loop for each bin */
-  for (int i = 0; i < count; i++)
-  {
-    Span p;
-    span_set(TimestampTzGetDatum(lower), TimestampTzGetDatum(upper),
-      true, false, T_TIMESTAMPTZ, T_TSTZSPAN, &p);
-    TSequenceSet *proj = tsequenceset_restrict_tstzspan(ss, &p, REST_AT);
-    if (proj)
-    {
-      Datum value = twavg ? Float8GetDatum(tnumber_twavg((Temporal *) proj)) :
-        PointerGetDatum(tpoint_twcentroid((Temporal *) proj));
-      /* We keep only the first instant since the tprecision operation amounts
-       * to a granularity change */
-      instants[ninsts++] = tinstant_make(value, temptype_out, lower);
-      DATUM_FREE(value, basetype_out);
-      pfree(proj);
-    }
-    else
-    {
-      /* Close the previous sequence if any and start a new one */
-      if (ninsts > 0)
-      {
-        /* The lower and upper bounds are both true since the tprecision
-         * operation amounts to a granularity change */
-        sequences[nseqs++] = tsequence_make((const TInstant **) instants,
-          ninsts, true, true, interp, NORMALIZE);
-        for (int j = 0; j < ninsts; j++)
-          pfree(instants[j]);
-        ninsts = 0;
-      }
-    }
-    lower += tunits;
-    upper += tunits;
-  }
-  /* Close the last sequence if any */
-  if (ninsts > 0)
-  {
-    /* The lower and upper bounds are both true since the tprecision
-     * operation amounts to a granularity change */
-    sequences[nseqs++] = tsequence_make((const TInstant **) instants, ninsts,
-      true, true, interp, NORMALIZE);
-    for (int j = 0; j < ninsts; j++)
-      pfree(instants[j]);
-  }
+  TPrecisionState state;
+  tprecision_state_init(&state, (Temporal *) ss, interval_units(duration),
+    lower_bin, instants);
+  TSequenceSet *result = tsequenceset_tprecision_state(ss, &state);
   pfree(instants);
-  return tsequenceset_make_free(sequences, nseqs, NORMALIZE);
+  return result;
 }
 
 /**
@@ -452,6 +596,79 @@ temporal_tprecision(const Temporal *temp, const Interval *duration,
   }
 }
 
+/**
+ * @ingroup meos_temporal_analytics_reduction
+ * @brief Return an array of temporal values with the precision set to the
+ * same time bins
+ * @details The values are downsampled to a common time grid. The buffer
+ * keeping the instants of the results is allocated once for all the values.
+ * @param[in] temparr Array of temporal values
+ * @param[in] count Number of values in the input array
+ * @param[in] duration Size of the time bins
+ * @param[in] torigin Time origin of the bins
+ */
+Temporal **
+temparr_tprecision(const Temporal **temparr, int count,
+  const Interval *duration, TimestampTz torigin)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(temparr, NULL); VALIDATE_NOT_NULL(duration, NULL);
+  if (! ensure_positive(count) || ! ensure_positive_duration(duration))
+    return NULL;
+  for (int i = 0; i < count; i++)
+  {
+    VALIDATE_NOT_NULL(temparr[i], NULL);
+    if (! ensure_tnumber_tpoint_type(temparr[i]->temptype))
+      return NULL;
+  }
+
+  /* Size the buffer for the value spanning the largest number of bins */
+  int64 tunits = interval_units(duration);
+  TimestampTz lower_bin;
+  int maxcount = 1;
+  for (int i = 0; i < count; i++)
+  {
+    if (temparr[i]->subtype == TSEQUENCE)
+      maxcount = Max(maxcount, tprecision_bins(
+        &((TSequence *) temparr[i])->period, duration, torigin, &lower_bin));
+    else if (temparr[i]->subtype == TSEQUENCESET)
+      maxcount = Max(maxcount, tprecision_bins(
+        &((TSequenceSet *) temparr[i])->period, duration, torigin,
+        &lower_bin));
+  }
+  TInstant **instants = palloc(sizeof(TInstant *) * maxcount);
+
+  Temporal **result = palloc(sizeof(Temporal *) * count);
+  TPrecisionState state;
+  for (int i = 0; i < count; i++)
+  {
+    const Temporal *temp = temparr[i];
+    assert(temptype_subtype(temp->subtype));
+    switch (temp->subtype)
+    {
+      case TINSTANT:
+        result[i] = (Temporal *) tinstant_tprecision((TInstant *) temp,
+          duration, torigin);
+        break;
+      case TSEQUENCE:
+        tprecision_bins(&((TSequence *) temp)->period, duration, torigin,
+          &lower_bin);
+        tprecision_state_init(&state, temp, tunits, lower_bin, instants);
+        result[i] = (Temporal *) tsequence_tprecision_state(
+          (TSequence *) temp, &state);
+        break;
+      default: /* TSEQUENCESET */
+        tprecision_bins(&((TSequenceSet *) temp)->period, duration, torigin,
+          &lower_bin);
+        tprecision_state_init(&state, temp, tunits, lower_bin, instants);
+        result[i] = (Temporal *) tsequenceset_tprecision_state(
+          (TSequenceSet *) temp, &state);
+    }
+  }
+  pfree(instants);
+  return result;
+}
+
 /*****************************************************************************
  * Temporal sample
  *****************************************************************************/
@@ -547,8 +764,12 @@ tsequence_tsample_iter(const TSequence *seq, TimestampTz lower_bin,
         /* Advance the bin */
         lower += tunits;
       }
-      /* Advance the bin if it is after the start of the segment */
-      else if (cmp1 >= 0)
+      /* Advance the bin if it is after the start of the segment, jumping
+       * over the bins before the segment, which happens for the sequences
+       * of a sequence set that are sampled with the same bins */
+      else if (cmp1 > 0)
+        lower += ((start->t - lower + tunits - 1) / tunits) * tunits;
+      else if (cmp1 == 0)
         lower += tunits;
       /* Advance the segment if it is after the lower bound of the bin */
       else if (cmp2 >= 0)
@@ -704,6 +925,36 @@ temporal_tsample(const Temporal *temp, const Interval *duration,
  * Linear space computation of the similarity distance
  *****************************************************************************/
 
+/**
+ * @brief Coordinates of the instants of a temporal number or of a temporal
+ * geometry point kept in contiguous arrays
+ * @details Temporal numbers only use the array @p x. Only the arrays that
+ * are needed by the number of dimensions are allocated.
+ */
+typedef struct
+{
+  int count;       /**< Number of instants */
+  double *x;       /**< Values or X coordinates */
+  double *y;       /**< Y coordinates */
+  double *z;       /**< Z coordinates */
+} SimCoords;
+
+/**
+ * @brief Input of the similarity computations, which are either the flat
+ * coordinates of the instants or the instants themselves for the types for
+ * which no flat representation is available, e.g., geodetic points
+ */
+typedef struct
+{
+  int ndims;                  /**< Number of dimensions, 0 if not flattened */
+  bool squared;               /**< True if the squared distances are used */
+  SimCoords coords1;          /**< Coordinates of the first value */
+  SimCoords coords2;          /**< Coordinates of the second value */
+  const TInstant **instants1; /**< Instants of the first value */
+  const TInstant **instants2; /**< Instants of the second value */
+  datum_func2 func;           /**< Distance function for non-flat values */
+} SimInput;
+
 /**
  * @brief Return the distance between two temporal instants
  * @param[in] inst1,inst2 Temporal instants
@@ -729,70 +980,268 @@ tinstant_distance(const TInstant *inst1, const TInstant *inst2,
 }
 
 /**
- * @brief Linear space computation of the similarity distance between two
- * temporal values
+ * @brief Return the number of dimensions of the flat coordinates of an
+ * instant, or 0 if the values of its type cannot be flattened
+ * @note Geodetic points and temporal geometries that are not points use the
+ * distance functions of PostGIS
+ */
+static int
+tinstant_flat_ndims(const TInstant *inst)
+{
+  if (tnumber_type(inst->temptype))
+    return 1;
+  if (inst->temptype == T_TGEOMPOINT)
+    return MEOS_FLAGS_GET_Z(inst->flags) ? 3 : 2;
+  return 0;
+}
+
+/**
+ * @brief Extract the coordinates of an array of instants into contiguous
+ * arrays
+ * @param[in] instants Array of temporal instants
+ * @param[in] count Number of instants in the array
+ * @param[in] ndims Number of dimensions
+ * @param[out] coords Coordinates
+ */
+static void
+tinstarr_flat_coords(const TInstant **instants, int count, int ndims,
+  SimCoords *coords)
+{
+  double *buf = palloc(sizeof(double) * count * ndims);
+  coords->count = count;
+  coords->x = buf;
+  coords->y = (ndims > 1) ? buf + count : NULL;
+  coords->z = (ndims > 2) ? buf + 2 * count : NULL;
+  for (int i = 0; i < count; i++)
+  {
+    if (ndims == 1)
+      coords->x[i] = tnumberinst_double(instants[i]);
+    else if (ndims == 2)
+    {
+      const POINT2D *pt = DATUM_POINT2D_P(tinstant_value_p(instants[i]));
+      coords->x[i] = pt->x;
+      coords->y[i] = pt->y;
+    }
+    else /* ndims == 3 */
+    {
+      const POINT3DZ *pt = DATUM_POINT3DZ_P(tinstant_value_p(instants[i]));
+      coords->x[i] = pt->x;
+      coords->y[i] = pt->y;
+      coords->z[i] = pt->z;
+    }
+  }
+  return;
+}
+
+/**
+ * @brief Initialize the input of a similarity computation
  * @param[in] instants1,instants2 Arrays of temporal instants
  * @param[in] count1,count2 Number of instants in the arrays
+ * @param[in] simfunc Similarity function
+ * @param[out] input Input of the similarity computation
+ * @note The Frechet and the Hausdorff distances only compare distances and
+ * thus are computed on the squared distances for points, taking the square
+ * root of the result
+ */
+static void
+siminput_init(const TInstant **instants1, int count1,
+  const TInstant **instants2, int count2, SimFunc simfunc, SimInput *input)
+{
+  memset(input, 0, sizeof(SimInput));
+  input->instants1 = instants1;
+  input->instants2 = instants2;
+  input->ndims = tinstant_flat_ndims(instants1[0]);
+  if (input->ndims == 0)
+  {
+    input->func = pt_distance_fn(instants1[0]->flags);
+    return;
+  }
+  input->squared = (input->ndims > 1 && simfunc != DYNTIMEWARP);
+  tinstarr_flat_coords(instants1, count1, input->ndims, &input->coords1);
+  tinstarr_flat_coords(instants2, count2, input->ndims, &input->coords2);
+  return;
+}
+
+/**
+ * @brief Free the input of a similarity computation
+ */
+static void
+siminput_free(SimInput *input)
+{
+  if (input->ndims > 0)
+  {
+    pfree(input->coords1.x);
+    pfree(input->coords2.x);
+  }
+  return;
+}
+
+/**
+ * @brief Compute in an array the distances between the i-th instant of the
+ * first value and the instants of the second value with index in the range
+ * [lo, hi]
+ * @details For flat coordinates each dimension is a separate loop over
+ * contiguous arrays without any function call, which the compiler
+ * vectorizes
+ * @param[in] input Input of the similarity computation
+ * @param[in] i Index of the instant of the first value
+ * @param[in] lo,hi Range of indexes of the instants of the second value
+ * @param[out] d Array of distances, indexed by the index of the second value
+ */
+static void
+siminput_row(const SimInput *input, int i, int lo, int hi,
+  double * restrict d)
+{
+  if (input->ndims == 0)
+  {
+    const TInstant *inst1 = input->instants1[i];
+    for (int j = lo; j <= hi; j++)
+      d[j] = tinstant_distance(inst1, input->instants2[j], input->func);
+    return;
+  }
+
+  const double * restrict x2 = input->coords2.x;
+  double x = input->coords1.x[i];
+  if (input->ndims == 1)
+  {
+    for (int j = lo; j <= hi; j++)
+      d[j] = fabs(x2[j] - x);
+    return;
+  }
+  for (int j = lo; j <= hi; j++)
+    d[j] = (x2[j] - x) * (x2[j] - x);
+  const double * restrict y2 = input->coords2.y;
+  double y = input->coords1.y[i];
+  for (int j = lo; j <= hi; j++)
+    d[j] += (y2[j] - y) * (y2[j] - y);
+  if (input->ndims == 3)
+  {
+    const double * restrict z2 = input->coords2.z;
+    double z = input->coords1.z[i];
+    for (int j = lo; j <= hi; j++)
+      d[j] += (z2[j] - z) * (z2[j] - z);
+  }
+  if (! input->squared)
+  {
+    for (int j = lo; j <= hi; j++)
+      d[j] = sqrt(d[j]);
+  }
+  return;
+}
+
+/**
+ * @brief Compute the range of the Sakoe-Chiba band of a row of the distance
+ * matrix
+ * @details The band follows the diagonal of the matrix scaled to the number
+ * of instants of the two values, which ensures that the first and the last
+ * cells of the matrix are in the band
+ * @param[in] i Row of the matrix
+ * @param[in] count1,count2 Number of rows and columns of the matrix
+ * @param[in] band Width of the band, a negative value means no band
+ * @param[out] lo,hi Range of columns in the band
+ * @pre The value of @p count1 is greater than or equal to @p count2
+ */
+static void
+simband_range(int i, int count1, int count2, int band, int *lo, int *hi)
+{
+  if (band < 0)
+  {
+    *lo = 0;
+    *hi = count2 - 1;
+    return;
+  }
+  int center = (count1 > 1) ?
+    (int) (((int64) i * (count2 - 1)) / (count1 - 1)) : 0;
+  *lo = Max(center - band, 0);
+  *hi = Min(center + band, count2 - 1);
+  return;
+}
+
+/**
+ * @brief Linear space computation of the similarity distance between two
+ * temporal values
+ * @details The matrix is computed row by row keeping two rows. The
+ * distances of a row and the minimum of the two cells of the previous row
+ * that precede each cell are computed in tight loops, only the minimum with
+ * the cell on the left is sequential.
+ * @param[in] input Input of the similarity computation
+ * @param[in] count1,count2 Number of instants of the values
  * @param[in] simfunc Similarity function, i.e., Frechet or DTW
- * @param[out] dist Array keeping the distances
- * @note Only two rows of the full matrix are used
+ * @param[in] band Width of the Sakoe-Chiba band, a negative value means no
+ * band
+ * @param[in] maxdist Threshold for abandoning the computation, a negative
+ * value means no threshold
+ * @param[out] dist Array of size @p 4 * count2 keeping the rows
+ * @note Only two rows of the full matrix are used. Since the distances are
+ * positive, the minimum of a row is a lower bound of the result, and the
+ * computation is abandoned returning this bound as soon as it is greater than
+ * @p maxdist.
  */
 static double
-tinstarr_similarity1(double *dist, const TInstant **instants1, int count1,
-  const TInstant **instants2, int count2, SimFunc simfunc)
+tinstarr_similarity1(const SimInput *input, int count1, int count2,
+  SimFunc simfunc, int band, double maxdist, double *dist)
 {
-  datum_func2 func = pt_distance_fn(instants1[0]->flags);
+  double *prev = dist;
+  double *cur = dist + count2;
+  double *d = dist + 2 * count2;
+  double *m = dist + 3 * count2;
+  for (int j = 0; j < 2 * count2; j++)
+    dist[j] = DBL_MAX;
+  /* Left bound of the band of the rows kept in prev and cur */
+  int prevlo = 0, curlo = 0;
+  double result = DBL_MAX;
   for (int i = 0; i < count1; i++)
   {
-    for (int j = 0; j < count2; j++)
+    int lo, hi;
+    simband_range(i, count1, count2, band, &lo, &hi);
+    siminput_row(input, i, lo, hi, d);
+    /* Minimum of the cells of the previous row that precede each cell */
+    if (i == 0)
     {
-      const TInstant *inst1 = instants1[i];
-      const TInstant *inst2 = instants2[j];
-      double d = tinstant_distance(inst1, inst2, func);
-      if (i > 0 && j > 0)
-      {
-        if (simfunc == FRECHET)
-        {
-          dist[i%2 * count2 + j] = Max(d,
-            Min(dist[(i - 1)%2 * count2 + j - 1],
-              Min(dist[(i - 1)%2 * count2 + j], dist[i%2 * count2 + j - 1])));
-        }
-        else /* simfunc == DYNTIMEWARP */
-        {
-          dist[i%2 * count2 + j] = d +
-            Min(dist[(i - 1)%2 * count2 + j - 1],
-              Min(dist[(i - 1)%2 * count2 + j], dist[i%2 * count2 + j - 1]));
-        }
-      }
-      else if (i > 0 && j == 0)
-      {
-        if (simfunc == FRECHET)
-        {
-          dist[i%2 * count2] = Max(d, dist[(i - 1)%2 * count2]);
-        }
-        else /* simfunc == DYNTIMEWARP */
-        {
-          dist[i%2 * count2] = d + dist[(i - 1)%2 * count2];
-        }
-      }
-      else if (i == 0 && j > 0)
-      {
-        if (simfunc == FRECHET)
-        {
-          dist[j] = Max(d, dist[j - 1]);
-        }
-        else /* simfunc == DYNTIMEWARP */
-        {
-          dist[j] = d + dist[j - 1];
-        }
-      }
-      else /* i == 0 && j == 0 */
+      m[0] = 0.0;
+      for (int j = 1; j <= hi; j++)
+        m[j] = DBL_MAX;
+    }
+    else
+    {
+      int start = lo;
+      if (lo == 0)
       {
-        dist[0] = d;
+        m[0] = prev[0];
+        start = 1;
       }
+      for (int j = start; j <= hi; j++)
+        m[j] = Min(prev[j - 1], prev[j]);
+    }
+    /* Remove the values of the row that was kept in cur outside the band */
+    for (int j = curlo; j < lo; j++)
+      cur[j] = DBL_MAX;
+    /* Sequential scan taking into account the cell on the left */
+    double left = DBL_MAX, rowmin = DBL_MAX;
+    for (int j = lo; j <= hi; j++)
+    {
+      double best = Min(m[j], left);
+      left = (simfunc == FRECHET) ? Max(d[j], best) : d[j] + best;
+      cur[j] = left;
+      if (left < rowmin)
+        rowmin = left;
     }
+    curlo = prevlo;
+    prevlo = lo;
+    double *tmp = prev; prev = cur; cur = tmp;
+    /* For squared distances the threshold is compared with the square root
+     * of the minimum since its square may be rounded so that the returned
+     * bound would not be greater than the threshold */
+    if (maxdist >= 0.0 &&
+        (input->squared ? sqrt(rowmin) : rowmin) > maxdist)
+    {
+      result = rowmin;
+      break;
+    }
+    if (i == count1 - 1)
+      result = prev[count2 - 1];
   }
-  return dist[(count1 - 1)%2 * count2 + count2 - 1];
+  return input->squared ? sqrt(result) : result;
 }
 
 /**
@@ -801,22 +1250,28 @@ tinstarr_similarity1(double *dist, const TInstant **instants1, int count1,
  * @param[in] instants1,instants2 Arrays of temporal instants
  * @param[in] count1,count2 Number of instants in the arrays
  * @param[in] simfunc Similarity function, i.e., Frechet or DTW
+ * @param[in] band Width of the Sakoe-Chiba band, a negative value means no
+ * band
+ * @param[in] maxdist Threshold for abandoning the computation, a negative
+ * value means no threshold
  * @note Only two rows of the full matrix are used
  */
 static double
 tinstarr_similarity(const TInstant **instants1, int count1,
-  const TInstant **instants2, int count2, SimFunc simfunc)
+  const TInstant **instants2, int count2, SimFunc simfunc, int band,
+  double maxdist)
 {
-  /* Allocate memory for two rows of the distance matrix */
-  double *dist = palloc(sizeof(double) * 2 * count2);
-  /* Initialise it with -1.0 */
-  for (int i = 0; i < 2 * count2; i++)
-    *(dist + i) = -1.0;
+  SimInput input;
+  siminput_init(instants1, count1, instants2, count2, simfunc, &input);
+  /* Allocate memory for two rows of the distance matrix and two rows of
+   * intermediate results */
+  double *dist = palloc(sizeof(double) * 4 * count2);
   /* Call the linear_space computation of the similarity distance */
-  double result = tinstarr_similarity1(dist, instants1, count1, instants2,
-    count2, simfunc);
+  double result = tinstarr_similarity1(&input, count1, count2, simfunc, band,
+    maxdist, dist);
   /* Free memory */
   pfree(dist);
+  siminput_free(&input);
   return result;
 }
 
@@ -824,10 +1279,14 @@ tinstarr_similarity(const TInstant **instants1, int count1,
  * @brief Return the similarity distance between two temporal values
  * @param[in] temp1,temp2 Temporal values
  * @param[in] simfunc Similarity function, i.e., Frechet or DTW
+ * @param[in] band Width of the Sakoe-Chiba band, a negative value means no
+ * band
+ * @param[in] maxdist Threshold for abandoning the computation, a negative
+ * value means no threshold
  */
 double
 temporal_similarity(const Temporal *temp1, const Temporal *temp2,
-  SimFunc simfunc)
+  SimFunc simfunc, int band, double maxdist)
 {
   assert(temp1); assert(temp2);
   assert(temp1->temptype == temp2->temptype);
@@ -836,8 +1295,10 @@ temporal_similarity(const Temporal *temp1, const Temporal *temp2,
   const TInstant **instants1 = temporal_instants_p(temp1, &count1);
   const TInstant **instants2 = temporal_instants_p(temp2, &count2);
   result = count1 > count2 ?
-    tinstarr_similarity(instants1, count1, instants2, count2, simfunc) :
-    tinstarr_similarity(instants2, count2, instants1, count1, simfunc);
+    tinstarr_similarity(instants1, count1, instants2, count2, simfunc, band,
+      maxdist) :
+    tinstarr_similarity(instants2, count2, instants1, count1, simfunc, band,
+      maxdist);
   /* Free memory */
   pfree(instants1); pfree(instants2);
   return result;
@@ -857,7 +1318,31 @@ temporal_frechet_distance(const Temporal *temp1, const Temporal *temp2)
   /* Ensure the validity of the arguments */
   if (! ensure_valid_temporal_temporal(temp1, temp2))
     return DBL_MAX;
-  return temporal_similarity(temp1, temp2, FRECHET);
+  return temporal_similarity(temp1, temp2, FRECHET, -1, -1.0);
+}
+
+/**
+ * @ingroup meos_temporal_analytics_similarity
+ * @brief Return the Frechet distance between two temporal values restricted
+ * to a Sakoe-Chiba band
+ * @param[in] temp1,temp2 Temporal values
+ * @param[in] band Maximum difference between the indexes of the matched
+ * instants after scaling the longest value to the shortest one, a negative
+ * value means no band
+ * @param[in] maxdist Threshold for abandoning the computation, a negative
+ * value means no threshold
+ * @return When the distance is greater than @p maxdist, the function may
+ * return a lower bound of the distance that is greater than @p maxdist.
+ * On error return @p DBL_MAX
+ */
+double
+temporal_frechet_distance_band(const Temporal *temp1, const Temporal *temp2,
+  int band, double maxdist)
+{
+  /* Ensure the validity of the arguments */
+  if (! ensure_valid_temporal_temporal(temp1, temp2))
+    return DBL_MAX;
+  return temporal_similarity(temp1, temp2, FRECHET, band, maxdist);
 }
 
 /**
@@ -873,7 +1358,31 @@ temporal_dyntimewarp_distance(const Temporal *temp1, const Temporal *temp2)
   /* Ensure the validity of the arguments */
   if (! ensure_valid_temporal_temporal(temp1, temp2))
     return DBL_MAX;
-  return temporal_similarity(temp1, temp2, DYNTIMEWARP);
+  return temporal_similarity(temp1, temp2, DYNTIMEWARP, -1, -1.0);
+}
+
+/**
+ * @ingroup meos_temporal_analytics_similarity
+ * @brief Return the Dynamic Time Warp distance between two temporal values
+ * restricted to a Sakoe-Chiba band
+ * @param[in] temp1,temp2 Temporal values
+ * @param[in] band Maximum difference between the indexes of the matched
+ * instants after scaling the longest value to the shortest one, a negative
+ * value means no band
+ * @param[in] maxdist Threshold for abandoning the computation, a negative
+ * value means no threshold
+ * @return When the distance is greater than @p maxdist, the function may
+ * return a lower bound of the distance that is greater than @p maxdist.
+ * On error return @p DBL_MAX
+ */
+double
+temporal_dyntimewarp_distance_band(const Temporal *temp1,
+  const Temporal *temp2, int band, double maxdist)
+{
+  /* Ensure the validity of the arguments */
+  if (! ensure_valid_temporal_temporal(temp1, temp2))
+    return DBL_MAX;
+  return temporal_similarity(temp1, temp2, DYNTIMEWARP, band, maxdist);
 }
 #endif
 
@@ -1141,47 +1650,41 @@ temporal_dyntimewarp_path(const Temporal *temp1, const Temporal *temp2,
  *****************************************************************************/
 
 /**
- * @brief Return the discrete Hausdorff distance between two temporal values
- * @param[in] instants1,instants2 Arrays of temporal instants
- * @param[in] count1,count2 Number of instants in the arrays
+ * @brief Number of distances computed at once before testing whether the
+ * computation of the directed Hausdorff distance of an instant can be
+ * abandoned
+ */
+#define HAUSDORFF_BLOCK_SIZE 16
+
+/**
+ * @brief Return the directed discrete Hausdorff distance from the first
+ * value to the second one
+ * @details The distances from an instant of the first value are computed by
+ * blocks, and the remaining blocks are abandoned as soon as a distance
+ * smaller than the current maximum is found, since the instant cannot
+ * increase the result
+ * @param[in] input Input of the similarity computation
+ * @param[in] count1,count2 Number of instants of the values
+ * @param[in] cmax Current maximum
+ * @param[out] d Array keeping the distances of a block
  */
 static double
-tinstarr_hausdorff_distance(const TInstant **instants1, int count1,
-  const TInstant **instants2, int count2)
+tinstarr_hausdorff_distance1(const SimInput *input, int count1, int count2,
+  double cmax, double *d)
 {
-  datum_func2 func = pt_distance_fn(instants1[0]->flags);
-  const TInstant *inst1, *inst2;
-  double cmax = 0.0, cmin;
-  double d;
-  int i, j;
-  for (i = 0; i < count1; i++)
-  {
-    inst1 = instants1[i];
-    cmin = DBL_MAX;
-    for (j = 0; j < count2; j++)
-    {
-      inst2 = instants2[j];
-      d = tinstant_distance(inst1, inst2, func);
-      if (d < cmin)
-        cmin = d;
-      if (cmin < cmax)
-        break;
-    }
-    if (cmax < cmin && cmin < DBL_MAX)
-      cmax = cmin;
-  }
-  for (j = 0; j < count2; j++)
+  for (int i = 0; i < count1; i++)
   {
-    cmin = DBL_MAX;
-    inst2 = instants2[j];
-    for (i = 0; i < count1; i++)
+    double cmin = DBL_MAX;
+    for (int lo = 0; lo < count2 && cmin >= cmax;
+      lo += HAUSDORFF_BLOCK_SIZE)
     {
-      inst1 = instants1[i];
-      d = tinstant_distance(inst1, inst2, func);
-      if (d < cmin)
-        cmin = d;
-      if (cmin < cmax)
-        break;
+      int hi = Min(lo + HAUSDORFF_BLOCK_SIZE, count2) - 1;
+      siminput_row(input, i, lo, hi, d);
+      for (int j = lo; j <= hi; j++)
+      {
+        if (d[j] < cmin)
+          cmin = d[j];
+      }
     }
     if (cmax < cmin && cmin < DBL_MAX)
       cmax = cmin;
@@ -1189,6 +1692,29 @@ tinstarr_hausdorff_distance(const TInstant **instants1, int count1,
   return cmax;
 }
 
+/**
+ * @brief Return the discrete Hausdorff distance between two temporal values
+ * @param[in] instants1,instants2 Arrays of temporal instants
+ * @param[in] count1,count2 Number of instants in the arrays
+ */
+static double
+tinstarr_hausdorff_distance(const TInstant **instants1, int count1,
+  const TInstant **instants2, int count2)
+{
+  SimInput input;
+  siminput_init(instants1, count1, instants2, count2, HAUSDORFF, &input);
+  /* Input with the roles of the two values swapped */
+  SimInput input2 = input;
+  input2.coords1 = input.coords2; input2.coords2 = input.coords1;
+  input2.instants1 = instants2; input2.instants2 = instants1;
+  double *d = palloc(sizeof(double) * Max(count1, count2));
+  double cmax = tinstarr_hausdorff_distance1(&input, count1, count2, 0.0, d);
+  cmax = tinstarr_hausdorff_distance1(&input2, count2, count1, cmax, d);
+  pfree(d);
+  siminput_free(&input);
+  return input.squared ? sqrt(cmax) : cmax;
+}
+
 /**
  * @ingroup meos_temporal_analytics_similarity
  * @brief Return the Hausdorf distance between two temporal values
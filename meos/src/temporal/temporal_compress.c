@@ -0,0 +1,939 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Compressed binary representation of temporal values
+ * @details The representation is composed of a header followed by a stream
+ * of bits encoding the instants. The header contains the temporal type, the
+ * subtype, the flags, the number of sequences and of instants, and the
+ * bounding box of the value, so that the bounding box can be obtained
+ * without decoding the instants.
+ *
+ * The timestamps are encoded with delta-of-delta encoding and the floats and
+ * the coordinates of the points are encoded by XORing them with the previous
+ * value, as in the Gorilla time series database described in
+ * - T. Pelkonen et al., Gorilla: A fast, scalable, in-memory time series
+ *   database. PVLDB 8(12), 2015
+ *
+ * The integers are delta encoded, the Booleans take one bit, and the texts
+ * are copied as they are. The other temporal types do not have a compressed
+ * representation, since their values could not be validated when reading
+ * them from a possibly corrupt input. The signed integers
+ * resulting from the delta and delta-of-delta encodings are zigzag encoded
+ * and written with a variable number of bits, which is a single bit for a
+ * value equal to zero, e.g., for timestamps with a regular sampling
+ * interval.
+ * @note As for the on-disk representation of the temporal types, the
+ * bounding box in the header is stored in the native representation of the
+ * machine. The Well-Known Binary (WKB) representation must be used for
+ * exchanging temporal values between machines.
+ */
+
+#include "temporal/temporal_compress.h"
+
+/* C */
+#include <assert.h>
+/* PostgreSQL */
+#include <postgres.h>
+#include "port/pg_bitutils.h"
+#if MEOS
+  #include "utils/timestamp_def.h"
+#else
+  #include "utils/timestamp.h"
+#endif
+#if POSTGRESQL_VERSION_NUMBER >= 160000
+  #include "varatt.h"
+#endif
+/* PostGIS */
+#include <liblwgeom.h>
+/* MEOS */
+#include <meos.h>
+#include <meos_internal.h>
+#include <meos_internal_geo.h>
+#include "temporal/temporal.h"
+#include "temporal/temporal_boxops.h"
+#include "temporal/tinstant.h"
+#include "temporal/tsequence.h"
+#include "temporal/tsequenceset.h"
+#include "temporal/type_util.h"
+#include "geo/tgeo_spatialfuncs.h"
+
+/*****************************************************************************
+ * Bit streams
+ *****************************************************************************/
+
+/**
+ * @brief Structure to write a stream of bits
+ * @details The bits are accumulated in a 64-bit word that is written to the
+ * buffer when it is full
+ */
+typedef struct
+{
+  uint8_t *data;   /**< Buffer */
+  size_t size;     /**< Number of bytes written in the buffer */
+  size_t maxsize;  /**< Size in bytes of the buffer */
+  uint64 acc;      /**< Bits not yet written in the buffer */
+  int nbits;       /**< Number of bits in the accumulator */
+} BitWriter;
+
+/**
+ * @brief Structure to read a stream of bits
+ * @details The low @p nbits bits of the accumulator are those not yet read
+ */
+typedef struct
+{
+  const uint8_t *data;  /**< Buffer */
+  size_t size;          /**< Size in bytes of the buffer */
+  size_t pos;           /**< Position of the next byte to read */
+  uint64 acc;           /**< Bits read from the buffer */
+  int nbits;            /**< Number of bits not yet consumed */
+  bool error;           /**< True if the end of the buffer has been passed */
+} BitReader;
+
+/**
+ * @brief Structure keeping the state of the XOR encoding of doubles
+ */
+typedef struct
+{
+  uint64 prev;  /**< Bits of the previous value */
+  int lead;     /**< Leading zeros of the current window, -1 if none */
+  int trail;    /**< Trailing zeros of the current window */
+} XorState;
+
+/**
+ * @brief Structure keeping the state of the encoding of the instants
+ */
+typedef struct
+{
+  meosType temptype;   /**< Temporal type */
+  meosType basetype;   /**< Base type */
+  int ndims;           /**< Number of coordinates of temporal points, or 0 */
+  TimestampTz prevt;   /**< Previous timestamp */
+  int64 prevdelta;     /**< Previous difference between timestamps */
+  int64 previnteger;   /**< Previous integer value */
+  XorState xor[3];     /**< State of the doubles or of the coordinates */
+} CompressState;
+
+/**
+ * @brief Write the low @p nbits bits of a value, where @p nbits is at most 64
+ */
+static void
+bitwriter_put(BitWriter *bw, uint64 value, int nbits)
+{
+  if (nbits == 0)
+    return;
+  if (nbits < 64)
+    value &= (UINT64CONST(1) << nbits) - 1;
+  int free = 64 - bw->nbits;
+  int rest = 0;
+  if (nbits == 64 && free == 64)
+    bw->acc = value;
+  else if (nbits <= free)
+    bw->acc = (bw->acc << nbits) | value;
+  else
+  {
+    /* Fill the accumulator and keep the remaining bits for later */
+    rest = nbits - free;
+    bw->acc = (bw->acc << free) | (value >> rest);
+    nbits = free;
+  }
+  bw->nbits += nbits;
+  if (bw->nbits < 64)
+    return;
+
+  /* Flush the accumulator in big-endian order */
+  if (bw->size + 8 > bw->maxsize)
+  {
+    bw->maxsize *= 2;
+    bw->data = repalloc(bw->data, bw->maxsize);
+  }
+  for (int i = 7; i >= 0; i--)
+    bw->data[bw->size++] = (uint8_t) (bw->acc >> (8 * i));
+  bw->acc = rest ? value & ((UINT64CONST(1) << rest) - 1) : 0;
+  bw->nbits = rest;
+  return;
+}
+
+/**
+ * @brief Write the remaining bits of the accumulator padded with zeros
+ */
+static void
+bitwriter_flush(BitWriter *bw)
+{
+  int nbytes = (bw->nbits + 7) / 8;
+  if (bw->size + nbytes > bw->maxsize)
+  {
+    bw->maxsize = bw->size + nbytes;
+    bw->data = repalloc(bw->data, bw->maxsize);
+  }
+  uint64 acc = bw->acc << (nbytes * 8 - bw->nbits);
+  for (int i = nbytes - 1; i >= 0; i--)
+    bw->data[bw->size++] = (uint8_t) (acc >> (8 * i));
+  bw->acc = 0;
+  bw->nbits = 0;
+  return;
+}
+
+/**
+ * @brief Read @p nbits bits, where @p nbits is at most 64
+ * @note Reading past the end of the buffer sets the error flag of the reader
+ * and returns zero bits
+ */
+static uint64
+bitreader_get(BitReader *br, int nbits)
+{
+  if (nbits > 32)
+  {
+    uint64 high = bitreader_get(br, nbits - 32);
+    return (high << 32) | bitreader_get(br, 32);
+  }
+  while (br->nbits <= 56 && br->pos < br->size)
+  {
+    br->acc = (br->acc << 8) | br->data[br->pos++];
+    br->nbits += 8;
+  }
+  if (br->nbits < nbits)
+  {
+    br->error = true;
+    br->nbits = 0;
+    return 0;
+  }
+  br->nbits -= nbits;
+  return (br->acc >> br->nbits) & ((UINT64CONST(1) << nbits) - 1);
+}
+
+/*****************************************************************************
+ * Encoding of the values
+ *****************************************************************************/
+
+/**
+ * @brief Write a signed integer zigzag encoded with a variable number of bits
+ * @details The prefixes '0', '10', '110', '1110', and '1111' are followed,
+ * respectively, by no bit, and by 12, 24, 40, and 64 bits
+ */
+static void
+bitwriter_put_int(BitWriter *bw, int64 value)
+{
+  uint64 zigzag = ((uint64) value << 1) ^ (uint64) (value >> 63);
+  if (zigzag == 0)
+    bitwriter_put(bw, 0x0, 1);
+  else if (zigzag < (UINT64CONST(1) << 12))
+  {
+    bitwriter_put(bw, 0x2, 2);
+    bitwriter_put(bw, zigzag, 12);
+  }
+  else if (zigzag < (UINT64CONST(1) << 24))
+  {
+    bitwriter_put(bw, 0x6, 3);
+    bitwriter_put(bw, zigzag, 24);
+  }
+  else if (zigzag < (UINT64CONST(1) << 40))
+  {
+    bitwriter_put(bw, 0xE, 4);
+    bitwriter_put(bw, zigzag, 40);
+  }
+  else
+  {
+    bitwriter_put(bw, 0xF, 4);
+    bitwriter_put(bw, zigzag, 64);
+  }
+  return;
+}
+
+/**
+ * @brief Read a signed integer zigzag encoded with a variable number of bits
+ * @see #bitwriter_put_int
+ */
+static int64
+bitreader_get_int(BitReader *br)
+{
+  int nbits;
+  if (! bitreader_get(br, 1))
+    return 0;
+  if (! bitreader_get(br, 1))
+    nbits = 12;
+  else if (! bitreader_get(br, 1))
+    nbits = 24;
+  else
+    nbits = bitreader_get(br, 1) ? 64 : 40;
+  uint64 zigzag = bitreader_get(br, nbits);
+  return (int64) ((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+}
+
+/**
+ * @brief Write a double XORed with the previous one
+ * @details A zero XOR is written as '0'. Otherwise, if the meaningful bits
+ * of the XOR fall within the window of the previous one, they are written
+ * after '10', otherwise they are written after '11' followed by the number
+ * of leading zeros in 5 bits and the number of meaningful bits in 6 bits
+ */
+static void
+bitwriter_put_double(BitWriter *bw, XorState *state, double d)
+{
+  uint64 bits;
+  memcpy(&bits, &d, sizeof(double));
+  uint64 xor = bits ^ state->prev;
+  state->prev = bits;
+  if (xor == 0)
+  {
+    bitwriter_put(bw, 0x0, 1);
+    return;
+  }
+  int lead = 63 - pg_leftmost_one_pos64(xor);
+  int trail = pg_rightmost_one_pos64(xor);
+  if (lead > 31)
+    lead = 31;
+  if (state->lead >= 0 && lead >= state->lead && trail >= state->trail)
+  {
+    bitwriter_put(bw, 0x2, 2);
+    bitwriter_put(bw, xor >> state->trail, 64 - state->lead - state->trail);
+    return;
+  }
+  int nbits = 64 - lead - trail;
+  bitwriter_put(bw, 0x3, 2);
+  bitwriter_put(bw, (uint64) lead, 5);
+  /* The value 64 is written as 0 */
+  bitwriter_put(bw, (uint64) nbits, 6);
+  bitwriter_put(bw, xor >> trail, nbits);
+  state->lead = lead;
+  state->trail = trail;
+  return;
+}
+
+/**
+ * @brief Read a double XORed with the previous one
+ * @see #bitwriter_put_double
+ */
+static double
+bitreader_get_double(BitReader *br, XorState *state)
+{
+  if (bitreader_get(br, 1))
+  {
+    if (bitreader_get(br, 1))
+    {
+      state->lead = (int) bitreader_get(br, 5);
+      int nbits = (int) bitreader_get(br, 6);
+      if (nbits == 0)
+        nbits = 64;
+      state->trail = 64 - state->lead - nbits;
+      if (state->trail < 0)
+      {
+        br->error = true;
+        state->trail = 0;
+      }
+    }
+    else if (state->lead < 0)
+      br->error = true;
+    if (! br->error)
+      state->prev ^= bitreader_get(br,
+        64 - state->lead - state->trail) << state->trail;
+  }
+  double result;
+  memcpy(&result, &state->prev, sizeof(double));
+  return result;
+}
+
+/**
+ * @brief Write a value of a base type without encoding
+ */
+static void
+bitwriter_put_raw(BitWriter *bw, Datum value, meosType basetype)
+{
+  if (basetype_byvalue(basetype))
+  {
+    bitwriter_put(bw, (uint64) value, 64);
+    return;
+  }
+  int16 typlen = basetype_length(basetype);
+  const uint8_t *bytes = (const uint8_t *) DatumGetPointer(value);
+  size_t size = typlen > 0 ? (size_t) typlen : VARSIZE(bytes);
+  if (typlen <= 0)
+    bitwriter_put(bw, (uint64) size, 32);
+  for (size_t i = 0; i < size; i++)
+    bitwriter_put(bw, bytes[i], 8);
+  return;
+}
+
+/**
+ * @brief Read a value of a base type written without encoding
+ * @note The values of base types passed by reference are returned in a newly
+ * allocated buffer
+ */
+static Datum
+bitreader_get_raw(BitReader *br, meosType basetype)
+{
+  if (basetype_byvalue(basetype))
+    return (Datum) bitreader_get(br, 64);
+  int16 typlen = basetype_length(basetype);
+  size_t size = typlen > 0 ? (size_t) typlen : bitreader_get(br, 32);
+  /* Ensure that the buffer contains the value before allocating it */
+  if (size < (typlen > 0 ? 1 : VARHDRSZ) ||
+      size > br->size - br->pos + (size_t) br->nbits / 8)
+  {
+    br->error = true;
+    return PointerGetDatum(NULL);
+  }
+  /* The instant constructor copies the padded size of the value */
+  uint8_t *bytes = palloc0(DOUBLE_PAD(size));
+  for (size_t i = 0; i < size; i++)
+    bytes[i] = (uint8_t) bitreader_get(br, 8);
+  if (typlen <= 0)
+    SET_VARSIZE(bytes, size);
+  return PointerGetDatum(bytes);
+}
+
+/**
+ * @brief Write the timestamp and the value of a temporal instant
+ */
+static void
+bitwriter_put_inst(BitWriter *bw, CompressState *state, const TInstant *inst)
+{
+  /* Delta-of-delta encoding of the timestamp, the subtractions are made on
+   * unsigned integers to avoid overflows */
+  int64 delta = (int64) ((uint64) inst->t - (uint64) state->prevt);
+  bitwriter_put_int(bw, (int64) ((uint64) delta - (uint64) state->prevdelta));
+  state->prevt = inst->t;
+  state->prevdelta = delta;
+
+  Datum value = tinstant_value_p(inst);
+  if (state->ndims)
+  {
+    const double *coords = (const double *) GS_POINT_PTR(
+      DatumGetGserializedP(value));
+    for (int i = 0; i < state->ndims; i++)
+      bitwriter_put_double(bw, &state->xor[i], coords[i]);
+    return;
+  }
+  switch (state->basetype)
+  {
+    case T_BOOL:
+      bitwriter_put(bw, DatumGetBool(value) ? 1 : 0, 1);
+      return;
+    case T_INT4:
+    case T_INT8:
+    {
+      int64 integer = (state->basetype == T_INT4) ?
+        (int64) DatumGetInt32(value) : DatumGetInt64(value);
+      bitwriter_put_int(bw,
+        (int64) ((uint64) integer - (uint64) state->previnteger));
+      state->previnteger = integer;
+      return;
+    }
+    case T_FLOAT8:
+      bitwriter_put_double(bw, &state->xor[0], DatumGetFloat8(value));
+      return;
+    default:
+      bitwriter_put_raw(bw, value, state->basetype);
+      return;
+  }
+}
+
+/**
+ * @brief Read the timestamp and the value of a temporal instant
+ * @details For base types passed by value, the value is returned in the
+ * last argument, for temporal points the coordinates are returned in the
+ * last argument, otherwise the value is returned in a newly allocated buffer
+ * @return Timestamp of the instant
+ */
+static TimestampTz
+bitreader_get_inst(BitReader *br, CompressState *state, Datum *value,
+  double *coords)
+{
+  int64 delta = (int64) ((uint64) state->prevdelta +
+    (uint64) bitreader_get_int(br));
+  TimestampTz t = (TimestampTz) ((uint64) state->prevt + (uint64) delta);
+  /* A corrupt input may give a timestamp out of range */
+  if (! IS_VALID_TIMESTAMP(t))
+    br->error = true;
+  state->prevt = t;
+  state->prevdelta = delta;
+
+  if (state->ndims)
+  {
+    for (int i = 0; i < state->ndims; i++)
+      coords[i] = bitreader_get_double(br, &state->xor[i]);
+    return t;
+  }
+  switch (state->basetype)
+  {
+    case T_BOOL:
+      *value = BoolGetDatum(bitreader_get(br, 1) != 0);
+      break;
+    case T_INT4:
+    case T_INT8:
+      state->previnteger = (int64) ((uint64) state->previnteger +
+        (uint64) bitreader_get_int(br));
+      *value = (state->basetype == T_INT4) ?
+        Int32GetDatum((int32) state->previnteger) :
+        Int64GetDatum(state->previnteger);
+      break;
+    case T_FLOAT8:
+      *value = Float8GetDatum(bitreader_get_double(br, &state->xor[0]));
+      break;
+    default:
+      *value = bitreader_get_raw(br, state->basetype);
+      break;
+  }
+  return t;
+}
+
+/**
+ * @brief Initialize the state of the encoding of the instants of a temporal
+ * value
+ */
+static void
+compress_state_init(CompressState *state, meosType temptype, int16 flags)
+{
+  memset(state, 0, sizeof(CompressState));
+  state->temptype = temptype;
+  state->basetype = temptype_basetype(temptype);
+  if (tpoint_type(temptype))
+    state->ndims = MEOS_FLAGS_GET_Z(flags) ? 3 : 2;
+  for (int i = 0; i < 3; i++)
+    state->xor[i].lead = -1;
+  return;
+}
+
+/**
+ * @brief Return true if a temporal type has a compressed binary
+ * representation
+ */
+static bool
+compressed_type(meosType temptype)
+{
+  return (temptype == T_TBOOL || temptype == T_TINT ||
+    temptype == T_TFLOAT || temptype == T_TTEXT || tpoint_type(temptype));
+}
+
+/**
+ * @brief Return the size of the bounding box kept in the header of the
+ * compressed binary representation of a temporal value
+ * @note As for the TInstant type, the bounding box of a temporal instant is
+ * not kept and must be computed
+ */
+static size_t
+compressed_bbox_size(meosType temptype, tempSubtype subtype)
+{
+  return (subtype == TINSTANT) ? 0 : temporal_bbox_size(temptype);
+}
+
+/*****************************************************************************
+ * Output function
+ *****************************************************************************/
+
+/**
+ * @brief Write the instants of a temporal sequence
+ */
+static void
+tsequence_put_compressed(BitWriter *bw, CompressState *state,
+  const TSequence *seq, bool withcount)
+{
+  if (withcount)
+    bitwriter_put(bw, (uint64) seq->count, 32);
+  bitwriter_put(bw, seq->period.lower_inc ? 1 : 0, 1);
+  bitwriter_put(bw, seq->period.upper_inc ? 1 : 0, 1);
+  for (int i = 0; i < seq->count; i++)
+    bitwriter_put_inst(bw, state, TSEQUENCE_INST_N(seq, i));
+  return;
+}
+
+/**
+ * @ingroup meos_temporal_inout
+ * @brief Return the compressed binary representation of a temporal value
+ * @details The timestamps are encoded with delta-of-delta encoding and the
+ * floats and the coordinates of the points are encoded by XORing them with
+ * the previous value. The representation starts with a header containing the
+ * bounding box of the value, which can be read with the function
+ * #temporal_compressed_set_bbox without decoding the instants. Only the
+ * temporal Booleans, integers, floats, texts, and points have a compressed
+ * representation.
+ * @param[in] temp Temporal value
+ * @param[out] size_out Size of the output
+ * @csqlfn #Temporal_as_compressed()
+ */
+uint8_t *
+temporal_as_compressed(const Temporal *temp, size_t *size_out)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(temp, NULL); VALIDATE_NOT_NULL(size_out, NULL);
+  if (! compressed_type(temp->temptype))
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_TYPE,
+      "The temporal type %s does not have a compressed representation",
+      meostype_name(temp->temptype));
+    return NULL;
+  }
+
+  int count, totalcount;
+  if (temp->subtype == TINSTANT)
+    count = totalcount = 1;
+  else if (temp->subtype == TSEQUENCE)
+    count = totalcount = ((TSequence *) temp)->count;
+  else /* temp->subtype == TSEQUENCESET */
+  {
+    count = ((TSequenceSet *) temp)->count;
+    totalcount = ((TSequenceSet *) temp)->totalcount;
+  }
+
+  /* Write the header */
+  size_t bboxsize = compressed_bbox_size(temp->temptype, temp->subtype);
+  BitWriter bw;
+  memset(&bw, 0, sizeof(BitWriter));
+  bw.maxsize = TEMPORAL_COMPRESSED_MAX_HEADER_SIZE + 16 * totalcount;
+  bw.data = palloc0(bw.maxsize);
+  bw.data[0] = TEMPORAL_COMPRESSED_VERSION;
+  bw.data[1] = temp->temptype;
+  bw.data[2] = temp->subtype;
+  memcpy(bw.data + 4, &temp->flags, sizeof(int16));
+  memcpy(bw.data + 8, &count, sizeof(int32));
+  memcpy(bw.data + 12, &totalcount, sizeof(int32));
+  if (bboxsize)
+  {
+    bboxunion box;
+    memset(&box, 0, sizeof(bboxunion));
+    temporal_set_bbox(temp, &box);
+    memcpy(bw.data + TEMPORAL_COMPRESSED_HEADER_SIZE, &box, bboxsize);
+  }
+  bw.size = TEMPORAL_COMPRESSED_HEADER_SIZE + bboxsize;
+
+  /* Write the instants */
+  CompressState state;
+  compress_state_init(&state, temp->temptype, temp->flags);
+  if (temp->subtype == TINSTANT)
+  {
+    /* The SRID of temporal points is otherwise kept in the bounding box */
+    if (tpoint_type(temp->temptype))
+      bitwriter_put(&bw, (uint64) (uint32) tspatial_srid(temp), 32);
+    bitwriter_put_inst(&bw, &state, (TInstant *) temp);
+  }
+  else if (temp->subtype == TSEQUENCE)
+    tsequence_put_compressed(&bw, &state, (TSequence *) temp, false);
+  else /* temp->subtype == TSEQUENCESET */
+  {
+    const TSequenceSet *ss = (const TSequenceSet *) temp;
+    for (int i = 0; i < ss->count; i++)
+      tsequence_put_compressed(&bw, &state, TSEQUENCESET_SEQ_N(ss, i), true);
+  }
+  bitwriter_flush(&bw);
+  *size_out = bw.size;
+  return bw.data;
+}
+
+/*****************************************************************************
+ * Input functions
+ *****************************************************************************/
+
+/**
+ * @brief Return the header of the compressed binary representation of a
+ * temporal value
+ * @return On error return false
+ */
+static bool
+temporal_compressed_header(const uint8_t *data, size_t size,
+  meosType *temptype, tempSubtype *subtype, int16 *flags, int *count,
+  int *totalcount)
+{
+  if (size < TEMPORAL_COMPRESSED_HEADER_SIZE ||
+      data[0] != TEMPORAL_COMPRESSED_VERSION ||
+      ! compressed_type((meosType) data[1]) ||
+      ! temptype_subtype((tempSubtype) data[2]))
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+      "Invalid compressed temporal value");
+    return false;
+  }
+  *temptype = (meosType) data[1];
+  *subtype = (tempSubtype) data[2];
+  memcpy(flags, data + 4, sizeof(int16));
+  memcpy(count, data + 8, sizeof(int32));
+  memcpy(totalcount, data + 12, sizeof(int32));
+  if (*count <= 0 || *totalcount < *count ||
+      (*subtype != TSEQUENCESET && *count != *totalcount) ||
+      (*subtype == TINSTANT && *count != 1) ||
+      size < TEMPORAL_COMPRESSED_HEADER_SIZE +
+        compressed_bbox_size(*temptype, *subtype))
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+      "Invalid compressed temporal value");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @ingroup meos_internal_temporal_inout
+ * @brief Return in the last arguments the temporal type and the bounding box
+ * of a temporal value from its compressed binary representation
+ * @details Only the header of the representation is read, which makes it
+ * possible to obtain the bounding box of a toasted value by only fetching
+ * the first #TEMPORAL_COMPRESSED_MAX_HEADER_SIZE bytes. The exceptions are
+ * temporal instants, whose bounding box is not kept and which are decoded
+ * to compute it
+ * @param[in] data Compressed binary representation, or its header
+ * @param[in] size Size in bytes of the data
+ * @param[out] temptype Temporal type
+ * @param[out] box Bounding box, which must be of size @p sizeof(bboxunion)
+ * @return On error return false
+ * @csqlfn #Temporal_compressed_tstzspan(), #Tnumber_compressed_tbox(), ...
+ */
+bool
+temporal_compressed_set_bbox(const uint8_t *data, size_t size,
+  meosType *temptype, void *box)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(data, false); VALIDATE_NOT_NULL(temptype, false);
+  VALIDATE_NOT_NULL(box, false);
+
+  tempSubtype subtype;
+  int16 flags;
+  int count, totalcount;
+  if (! temporal_compressed_header(data, size, temptype, &subtype, &flags,
+      &count, &totalcount))
+    return false;
+  if (subtype == TINSTANT)
+  {
+    Temporal *inst = temporal_from_compressed(data, size);
+    if (! inst)
+      return false;
+    tinstant_set_bbox((TInstant *) inst, box);
+    pfree(inst);
+    return true;
+  }
+  memcpy(box, data + TEMPORAL_COMPRESSED_HEADER_SIZE,
+    temporal_bbox_size(*temptype));
+  return true;
+}
+
+/**
+ * @brief Return a temporal instant from its timestamp and its value read
+ * from the compressed binary representation
+ */
+static TInstant *
+tinstant_from_compressed(const CompressState *state, int32_t srid,
+  Datum value, const double *coords, TimestampTz t)
+{
+  if (! state->ndims)
+  {
+    if (basetype_byvalue(state->basetype))
+      return tinstant_make(value, state->temptype, t);
+    return tinstant_make_free(value, state->temptype, t);
+  }
+  GSERIALIZED *gs = geopoint_make(coords[0], coords[1], coords[2],
+    state->ndims == 3, tgeodetic_type(state->temptype), srid);
+  return tinstant_make_free(PointerGetDatum(gs), state->temptype, t);
+}
+
+/**
+ * @brief Return a temporal sequence read from the compressed binary
+ * representation
+ * @details As for the incremental MF-JSON parser, the instants of base types
+ * passed by value and of temporal points are stored consecutively in a
+ * single buffer using the first instant as template for the remaining ones.
+ */
+static TSequence *
+tsequence_from_compressed(BitReader *br, CompressState *state, int16 flags,
+  int32_t srid, int count)
+{
+  bool lower_inc = bitreader_get(br, 1) != 0;
+  bool upper_inc = bitreader_get(br, 1) != 0;
+  Datum value = 0;
+  double coords[3] = {0};
+  TimestampTz t = bitreader_get_inst(br, state, &value, coords);
+  if (br->error)
+    return NULL;
+  TInstant *inst = tinstant_from_compressed(state, srid, value,
+    coords, t);
+  if (! inst)
+    return NULL;
+  const TInstant **instants = palloc(sizeof(TInstant *) * count);
+  interpType interp = MEOS_FLAGS_GET_INTERP(flags);
+  if (! state->ndims && ! basetype_byvalue(state->basetype))
+  {
+    instants[0] = inst;
+    int i;
+    for (i = 1; i < count; i++)
+    {
+      t = bitreader_get_inst(br, state, &value, coords);
+      if (br->error)
+        break;
+      instants[i] = tinstant_from_compressed(state, srid, value,
+        coords, t);
+      if (! instants[i])
+      {
+        br->error = true;
+        break;
+      }
+    }
+    if (br->error)
+    {
+      pfree_array((void **) instants, i);
+      return NULL;
+    }
+    return tsequence_make_free((TInstant **) instants, count, lower_inc,
+      upper_inc, interp, NORMALIZE_NO);
+  }
+
+  /* Store the instants consecutively using the first one as template */
+  size_t instsize = DOUBLE_PAD(VARSIZE(inst));
+  char *buf = palloc(instsize * count);
+  memcpy(buf, inst, VARSIZE(inst));
+  pfree(inst);
+  instants[0] = (TInstant *) buf;
+  for (int i = 1; i < count; i++)
+  {
+    t = bitreader_get_inst(br, state, &value, coords);
+    TInstant *inst1 = (TInstant *) (buf + instsize * i);
+    memcpy(inst1, instants[0], VARSIZE(instants[0]));
+    if (state->ndims)
+    {
+      memcpy(GS_POINT_PTR(DatumGetGserializedP(tinstant_value_p(inst1))),
+        coords, sizeof(double) * state->ndims);
+      inst1->t = t;
+    }
+    else
+      tinstant_set(inst1, value, t);
+    instants[i] = inst1;
+  }
+  TSequence *result = br->error ? NULL : tsequence_make(instants, count,
+    lower_inc, upper_inc, interp, NORMALIZE_NO);
+  pfree(buf); pfree(instants);
+  return result;
+}
+
+/**
+ * @ingroup meos_temporal_inout
+ * @brief Return a temporal value from its compressed binary representation
+ * @param[in] data Compressed binary representation
+ * @param[in] size Size in bytes of the data
+ * @return On error return @p NULL
+ * @csqlfn #Temporal_from_compressed()
+ */
+Temporal *
+temporal_from_compressed(const uint8_t *data, size_t size)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(data, NULL);
+
+  meosType temptype;
+  tempSubtype subtype;
+  int16 flags;
+  int count, totalcount;
+  if (! temporal_compressed_header(data, size, &temptype, &subtype, &flags,
+      &count, &totalcount))
+    return NULL;
+  size_t bboxsize = compressed_bbox_size(temptype, subtype);
+  /* Each instant takes at least one bit */
+  if ((size_t) totalcount > (size - TEMPORAL_COMPRESSED_HEADER_SIZE -
+      bboxsize) * 8)
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+      "Invalid compressed temporal value");
+    return NULL;
+  }
+  int32_t srid = 0;
+  if (tpoint_type(temptype) && subtype != TINSTANT)
+  {
+    STBox box;
+    memcpy(&box, data + TEMPORAL_COMPRESSED_HEADER_SIZE, sizeof(STBox));
+    srid = box.srid;
+    /* A corrupt input may give an invalid SRID */
+    if (srid < 0 || srid > SRID_MAXIMUM)
+    {
+      meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+        "Invalid compressed temporal value");
+      return NULL;
+    }
+  }
+
+  /* Read the instants */
+  BitReader br;
+  memset(&br, 0, sizeof(BitReader));
+  br.data = data;
+  br.size = size;
+  br.pos = TEMPORAL_COMPRESSED_HEADER_SIZE + bboxsize;
+  CompressState state;
+  compress_state_init(&state, temptype, flags);
+  Temporal *result = NULL;
+  if (subtype == TINSTANT)
+  {
+    Datum value = 0;
+    double coords[3] = {0};
+    if (tpoint_type(temptype))
+    {
+      srid = (int32_t) (uint32) bitreader_get(&br, 32);
+      if (srid < 0 || srid > SRID_MAXIMUM)
+        br.error = true;
+    }
+    TimestampTz t = bitreader_get_inst(&br, &state, &value, coords);
+    if (! br.error)
+      result = (Temporal *) tinstant_from_compressed(&state, srid,
+        value, coords, t);
+  }
+  else if (subtype == TSEQUENCE)
+    result = (Temporal *) tsequence_from_compressed(&br, &state, flags, srid,
+      count);
+  else /* subtype == TSEQUENCESET */
+  {
+    TSequence **sequences = palloc(sizeof(TSequence *) * count);
+    int i, ninsts = 0;
+    for (i = 0; i < count; i++)
+    {
+      int seqcount = (int) bitreader_get(&br, 32);
+      if (br.error || seqcount <= 0 || seqcount > totalcount - ninsts)
+      {
+        br.error = true;
+        break;
+      }
+      ninsts += seqcount;
+      sequences[i] = tsequence_from_compressed(&br, &state, flags, srid,
+        seqcount);
+      if (! sequences[i])
+        break;
+    }
+    if (i == count && ninsts == totalcount)
+      result = (Temporal *) tsequenceset_make_free(sequences, count,
+        NORMALIZE_NO);
+    else
+    {
+      br.error = true;
+      pfree_array((void **) sequences, i);
+    }
+  }
+  if (br.error)
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+      "Invalid compressed temporal value");
+    return NULL;
+  }
+  return result;
+}
+
+/*****************************************************************************/
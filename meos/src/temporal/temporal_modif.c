@@ -1720,26 +1720,67 @@ temporal_delete_tstzspanset(const Temporal *temp, const SpanSet *ss,
  * Append functions
  ****************************************************************************/
 
+#if MEOS
+/**
+ * @brief Enlarge in place an expandable temporal sequence so that it can
+ * hold @p count instants occupying @p insts_size bytes
+ * @details The maximum number of instants and the space reserved for the
+ * instants are (at least) doubled when they are exhausted, so that appending
+ * instants one by one has an amortized constant cost per instant. Since the
+ * offsets array is located before the instants, the instants are shifted when
+ * the maximum number of instants is increased.
+ * @note The sequence is reallocated and thus it may be moved
+ */
+static TSequence *
+tsequence_enlarge(TSequence *seq, int count, size_t insts_size)
+{
+  /* Position of the offsets array and of the instants in the sequence */
+  size_t poffsets = (char *) TSEQUENCE_OFFSETS_PTR(seq) - (char *) seq;
+  size_t pdata = poffsets + sizeof(size_t) * seq->maxcount;
+  size_t old_insts_size = VARSIZE(seq) - pdata;
+  /* Compute the new maximum number of instants and the new size */
+  int maxcount = seq->maxcount;
+  if (count > maxcount)
+    maxcount = Max(maxcount * 2, count);
+  size_t new_insts_size = old_insts_size;
+  if (insts_size > old_insts_size)
+    new_insts_size = DOUBLE_PAD(Max(old_insts_size * 2, insts_size));
+  size_t new_pdata = poffsets + sizeof(size_t) * maxcount;
+  size_t memsize = new_pdata + new_insts_size;
+#ifdef DEBUG_EXPAND
+  meos_error(WARNING, 0, " Sequence -> %d (%zu bytes) ", maxcount, memsize);
+#endif /* DEBUG_EXPAND */
+
+  seq = repalloc(seq, memsize);
+  /* Shift the instants and set to 0 the new space */
+  if (new_pdata != pdata)
+  {
+    memmove((char *) seq + new_pdata, (char *) seq + pdata, old_insts_size);
+    memset((char *) seq + pdata, 0, new_pdata - pdata);
+  }
+  memset((char *) seq + new_pdata + old_insts_size, 0,
+    new_insts_size - old_insts_size);
+  seq->maxcount = maxcount;
+  SET_VARSIZE(seq, memsize);
+  return seq;
+}
+#endif /* MEOS */
+
 /**
- * @ingroup meos_internal_temporal_modif
  * @brief Append an instant to a temporal sequence accounting for potential gaps
  * @param[in,out] seq Temporal sequence
  * @param[in] inst Temporal instant
  * @param[in] maxdist Maximum distance for defining a gap
  * @param[in] maxt Maximum time interval for defining a gap, may be `NULL`
  * @param[in] expand True when reserving space for additional instants
- * @csqlfn #Temporal_append_tinstant()
- * @return When the sequence passed as first argument has space for adding the
- * instant, the function returns the updated sequence. Otherwise, a NEW
- * sequence is returned and the input sequence is freed.
- * @note Always use the function to overwrite the existing sequence as in:
- * @code
- * seq = tsequence_append_tinstant(seq, inst, ...);
- * @endcode
+ * @param[in] owned True when the sequence is a standalone value owned by the
+ * caller that can be enlarged in place or freed, false when it is, e.g., the
+ * last sequence of an expandable sequence set
+ * @see #tsequence_append_tinstant
  */
-Temporal *
-tsequence_append_tinstant(TSequence *seq, const TInstant *inst, double maxdist,
-  const Interval *maxt, bool expand)
+static Temporal *
+tsequence_append_tinstant_iter(TSequence *seq, const TInstant *inst,
+  double maxdist, const Interval *maxt, bool expand, bool owned)
 {
   assert(seq); assert(inst); assert(seq->temptype == inst->temptype);
   interpType interp = MEOS_FLAGS_GET_INTERP(seq->flags);
@@ -1787,14 +1828,10 @@ tsequence_append_tinstant(TSequence *seq, const TInstant *inst, double maxdist,
       if (dist > maxdist)
         split = true;
     }
-    /* If there is not already a split by distance */
-    if (maxt && ! split)
-    {
-      Interval *duration = minus_timestamptz_timestamptz(inst->t, last->t);
-      if (pg_interval_cmp(duration, maxt) > 0)
-        split = true;
-      pfree(duration);
-    }
+    /* If there is not already a split by distance. The gap is compared as
+     * microseconds to avoid building an interval for each instant */
+    if (maxt && ! split && (inst->t - last->t) > interval_cmp_usecs(maxt))
+      split = true;
     /* If split => result is a sequence set */
     if (split)
     {
@@ -1806,6 +1843,8 @@ tsequence_append_tinstant(TSequence *seq, const TInstant *inst, double maxdist,
         expand ? 64 : 1, true, true, interp, NORMALIZE_NO);
       TSequenceSet *result = tsequenceset_make_exp(
         (const TSequence **) sequences, 2, expand ? 64 : 2, NORMALIZE_NO);
+      if (sequences[0] != seq)
+        pfree(sequences[0]);
       pfree(sequences[1]);
       return (Temporal *) result;
     }
@@ -1826,36 +1865,42 @@ tsequence_append_tinstant(TSequence *seq, const TInstant *inst, double maxdist,
     }
   }
 
-  /* Account for expandable structures
-   * A while is used instead of an if to enable to break the loop if there is
-   * no more available space */
-  while (expand && count <= seq->maxcount)
+  /* Account for expandable structures */
+  if (expand)
   {
     /* Determine whether there is enough available space */
     size_t size = DOUBLE_PAD(VARSIZE(inst));
     /* Get the last instant to keep. It is either the last instant or the
-     * penultimate one if the last one is redundant through normalization */
+     * penultimate one if the last one is redundant through normalization.
+     * Its offset is kept since the sequence may be moved when enlarged */
     last = (TInstant *) TSEQUENCE_INST_N(seq, count - 2);
     size_t size_last = DOUBLE_PAD(VARSIZE(last));
+    size_t pos = (TSEQUENCE_OFFSETS_PTR(seq))[count - 2] + size_last;
     char *new = (char *) last + size_last;
-    size_t size_seq = VARSIZE(seq);
-    size_t avail_size = (char *) seq + size_seq - new;
-    if (size > avail_size)
-      /* There is not enough available space */
-      break;
-
-    /* There is enough space to add the new instant */
-    if (count != seq->count)
+    size_t avail_size = (char *) seq + VARSIZE(seq) - new;
+    bool fits = (count <= seq->maxcount && size <= avail_size);
+#if MEOS
+    /* Enlarge the sequence in place if it is owned by the caller */
+    if (! fits && owned)
+    {
+      seq = tsequence_enlarge(seq, count, pos + size);
+      new = (char *) TSEQUENCE_INST_N(seq, 0) + pos;
+      fits = true;
+    }
+#endif /* MEOS */
+    if (fits)
     {
       /* Update the offsets array and the count when adding one instant */
-      (TSEQUENCE_OFFSETS_PTR(seq))[count - 1] =
-        (TSEQUENCE_OFFSETS_PTR(seq))[count - 2] + size_last;
-      seq->count++;
+      if (count != seq->count)
+      {
+        (TSEQUENCE_OFFSETS_PTR(seq))[count - 1] = pos;
+        seq->count++;
+      }
+      memcpy(new, inst, VARSIZE(inst));
+      /* Expand the bounding box and return */
+      tsequence_expand_bbox(seq, inst);
+      return (Temporal *) seq;
     }
-    memcpy(new, inst, VARSIZE(inst));
-    /* Expand the bounding box and return */
-    tsequence_expand_bbox(seq, inst);
-    return (Temporal *) seq;
   }
 
   /* This is the first time we use an expandable structure or there is no more
@@ -1871,7 +1916,7 @@ tsequence_append_tinstant(TSequence *seq, const TInstant *inst, double maxdist,
     if (count > seq->maxcount)
     {
       maxcount *= 2;
-#if DEBUG_EXPAND
+#ifdef DEBUG_EXPAND
       meos_error(WARNING, 0, " Sequence -> %d ", maxcount);
 #endif /* DEBUG_EXPAND */
     }
@@ -1889,12 +1934,39 @@ tsequence_append_tinstant(TSequence *seq, const TInstant *inst, double maxdist,
     seq->period.lower_inc, true, interp, NORMALIZE_NO, &bbox);
   pfree(instants);
 #if MEOS
-  if (expand)
+  if (expand && owned)
     pfree(seq);
 #endif /* MEOS */
   return (Temporal *) result;
 }
 
+/**
+ * @ingroup meos_internal_temporal_modif
+ * @brief Append an instant to a temporal sequence accounting for potential gaps
+ * @param[in,out] seq Temporal sequence
+ * @param[in] inst Temporal instant
+ * @param[in] maxdist Maximum distance for defining a gap
+ * @param[in] maxt Maximum time interval for defining a gap, may be `NULL`
+ * @param[in] expand True when reserving space for additional instants
+ * @csqlfn #Temporal_append_tinstant()
+ * @return When the sequence passed as first argument has space for adding the
+ * instant, the function returns the updated sequence. Otherwise, a NEW
+ * sequence is returned and the input sequence is freed. In MEOS, an
+ * expandable sequence without enough space is enlarged in place by doubling
+ * its capacity, which gives an amortized constant cost per appended instant.
+ * @note Always use the function to overwrite the existing sequence as in:
+ * @code
+ * seq = tsequence_append_tinstant(seq, inst, ...);
+ * @endcode
+ */
+Temporal *
+tsequence_append_tinstant(TSequence *seq, const TInstant *inst, double maxdist,
+  const Interval *maxt, bool expand)
+{
+  return tsequence_append_tinstant_iter(seq, inst, maxdist, maxt, expand,
+    true);
+}
+
 /**
  * @ingroup meos_internal_temporal_modif
  * @brief Append a sequence to a temporal sequence
@@ -1977,8 +2049,13 @@ tsequenceset_append_tinstant(TSequenceSet *ss, const TInstant *inst,
   assert(ss->temptype == inst->temptype);
   /* Append the instant to the last sequence */
   TSequence *last = (TSequence *) TSEQUENCESET_SEQ_N(ss, ss->count - 1);
-  Temporal *temp = tsequence_append_tinstant(last, inst, maxdist, maxt,
-    expand);
+  int lastcount = last->count;
+  /* The last sequence is not a standalone value and thus it cannot be
+   * enlarged in place nor freed */
+  Temporal *temp = tsequence_append_tinstant_iter(last, inst, maxdist, maxt,
+    expand, false);
+  if (! temp)
+    return NULL;
   /* The result may be a single sequence or a sequence set with 2 sequences */
   TSequence *seq1 = NULL, *seq2 = NULL;
   TSequenceSet *ss1 = NULL;
@@ -2016,6 +2093,11 @@ tsequenceset_append_tinstant(TSequenceSet *ss, const TInstant *inst,
       break;
 
     /* There is enough space to add the new sequence(s) */
+    ss->totalcount += seq1->count - lastcount;
+    /* Expand the bounding box */
+    tsequenceset_expand_bbox(ss, (TSequence *) seq1);
+    if (temp->subtype == TSEQUENCESET)
+      tsequenceset_expand_bbox(ss, seq2);
     /* Copy the new sequence if its address is different from last */
     if (last != seq1)
       memcpy(last, seq1, VARSIZE(seq1));
@@ -2025,14 +2107,11 @@ tsequenceset_append_tinstant(TSequenceSet *ss, const TInstant *inst,
       (TSEQUENCESET_OFFSETS_PTR(ss))[count - 1] =
         (TSEQUENCESET_OFFSETS_PTR(ss))[count - 2] + size_seq1;
       ss->count++;
-      ss->totalcount++;
-      last = (TSequence *) ((char *) last + size_seq1);
-      memcpy(last, seq2, VARSIZE(seq2));
+      ss->totalcount += seq2->count;
+      memcpy((char *) last + size_seq1, seq2, VARSIZE(seq2));
     }
-    /* Expand the bounding box and return */
-    tsequenceset_expand_bbox(ss, (TSequence *) seq1);
-    if (temp->subtype == TSEQUENCESET)
-      tsequenceset_expand_bbox(ss, seq2);
+    if ((void *) last != (void *) temp)
+      pfree(temp);
     return ss;
   }
 
@@ -2051,14 +2130,30 @@ tsequenceset_append_tinstant(TSequenceSet *ss, const TInstant *inst,
     sequences[nseqs++] = TSEQUENCESET_SEQ_N(ss1, 0);
     sequences[nseqs++] = TSEQUENCESET_SEQ_N(ss1, 1);
   }
-  TSequenceSet *result = tsequenceset_make(sequences, nseqs, NORMALIZE_NO);
+  /* Keep the result expandable so that the next instants are appended in
+   * place instead of rebuilding the sequence set each time */
+  int maxcount;
+  if (expand)
+  {
+    /* The capacity is doubled even if there is room for the sequences since
+     * the free space for their instants, which is proportional to the
+     * capacity, is exhausted */
+    maxcount = ss->maxcount * 2;
+#ifdef DEBUG_EXPAND
+    meos_error(WARNING, 0, " Sequence set -> %d ", maxcount);
+#endif /* DEBUG_EXPAND */
+  }
+  else
+    maxcount = nseqs;
+  TSequenceSet *result = tsequenceset_make_exp(sequences, nseqs, maxcount,
+    NORMALIZE_NO);
   pfree(sequences);
+  if ((void *) last != (void *) temp)
+    pfree(temp);
 #if MEOS
   if (expand)
     pfree(ss);
 #endif /* MEOS */
-  if ((void *) last != (void *) temp)
-    pfree(temp);
   return result;
 }
 
@@ -2154,14 +2249,13 @@ tsequenceset_append_tsequence(TSequenceSet *ss, const TSequence *seq,
   int maxcount;
   if (expand)
   {
-    maxcount = ss->maxcount;
-    if (count > ss->maxcount)
-    {
-      maxcount *= 2;
-#if DEBUG_EXPAND
-      meos_error(WARNING, " Sequence set -> %d ", maxcount);
-#endif
-    }
+    /* The capacity is doubled even if there is room for the sequences since
+     * the free space for their instants, which is proportional to the
+     * capacity, is exhausted */
+    maxcount = ss->maxcount * 2;
+#ifdef DEBUG_EXPAND
+    meos_error(WARNING, 0, " Sequence set -> %d ", maxcount);
+#endif /* DEBUG_EXPAND */
   }
   else
     maxcount = count;
@@ -2216,9 +2310,11 @@ temporal_append_tinstant(Temporal *temp, const TInstant *inst,
   {
     case TINSTANT:
     {
+      /* The temporary sequence is not enlarged in place to be able to free
+       * it after appending the instant */
       TSequence *seq = tinstant_to_tsequence((const TInstant *) temp, interp);
-      Temporal *result = (Temporal *) tsequence_append_tinstant(seq, inst,
-        maxdist, maxt, expand);
+      Temporal *result = tsequence_append_tinstant_iter(seq, inst, maxdist,
+        maxt, expand, false);
       pfree(seq);
       return result;
     }
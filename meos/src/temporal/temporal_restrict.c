@@ -2224,6 +2224,78 @@ tsequence_at_timestamptz(const TSequence *seq, TimestampTz t)
 
 /*****************************************************************************/
 
+/**
+ * @brief Return the index of the last instant of a continuous temporal
+ * sequence whose timestamp is before (or equal to) a timestamp, starting the
+ * search from a given instant
+ * @details The search doubles its step from the given instant until it
+ * passes the timestamp and then continues with a binary search, that is, it
+ * is a galloping search whose cost is logarithmic in the distance between
+ * the given instant and the result. When restricting a sequence to the
+ * elements of a set or a span set, which are sorted, each search starts from
+ * the result of the previous one, so that the restriction is a merge of the
+ * two sorted inputs in a single pass.
+ * @param[in] seq Temporal sequence
+ * @param[in] t Timestamp
+ * @param[in] from Index of the instant from which the search starts
+ * @param[in] strict True if the instant must be strictly before the timestamp
+ * @return Index of the instant, which is at most `seq->count - 2` so that it
+ * always starts a segment
+ * @pre The instant @p from is before (or equal to) the timestamp
+ */
+static int
+tcontseq_gallop_timestamptz(const TSequence *seq, TimestampTz t, int from,
+  bool strict)
+{
+  assert(seq->count > 1); assert(from < seq->count - 1);
+  int lo = from, hi = from + 1, step = 1;
+  /* Find an instant after the timestamp by doubling the step */
+  while (hi < seq->count)
+  {
+    TimestampTz t1 = TSEQUENCE_INST_N(seq, hi)->t;
+    if (t1 > t || (strict && t1 == t))
+      break;
+    lo = hi;
+    step *= 2;
+    hi = lo + step;
+  }
+  if (hi > seq->count)
+    hi = seq->count;
+  /* Binary search between the last two instants visited */
+  while (hi - lo > 1)
+  {
+    int middle = lo + (hi - lo) / 2;
+    TimestampTz t1 = TSEQUENCE_INST_N(seq, middle)->t;
+    if (t1 < t || (! strict && t1 == t))
+      lo = middle;
+    else
+      hi = middle;
+  }
+  return Min(lo, seq->count - 2);
+}
+
+/**
+ * @brief Restrict a continuous temporal sequence to a timestamptz starting
+ * the search from a given instant
+ * @param[in] seq Temporal sequence
+ * @param[in] t Timestamp
+ * @param[in,out] pos Index of the instant from which the search starts,
+ * which is updated with the segment containing the timestamp
+ * @pre The timestamp is contained in the period of the sequence and the
+ * instant @p pos is before (or equal to) the timestamp
+ */
+static TInstant *
+tcontseq_at_timestamptz_gallop(const TSequence *seq, TimestampTz t, int *pos)
+{
+  if (seq->count == 1)
+    return tinstant_copy(TSEQUENCE_INST_N(seq, 0));
+  *pos = tcontseq_gallop_timestamptz(seq, t, *pos, false);
+  return tsegment_at_timestamptz(TSEQUENCE_INST_N(seq, *pos),
+    TSEQUENCE_INST_N(seq, *pos + 1), MEOS_FLAGS_GET_INTERP(seq->flags), t);
+}
+
+/*****************************************************************************/
+
 /**
  * @brief Restrict a temporal sequence to the complement of a timestamptz
  * (iterator function)
@@ -2372,19 +2444,20 @@ tcontseq_at_tstzset(const TSequence *seq, const Set *s)
     return tinstant_to_tsequence((const TInstant *) inst, DISCRETE);
   }
 
-  /* General case */
+  /* General case: merge the timestamps and the instants */
   TimestampTz t = Max(DatumGetTimestampTz(seq->period.lower),
     DatumGetTimestampTz(SET_VAL_N(s, 0)));
   int loc;
   set_find_value(s, TimestampTzGetDatum(t), &loc);
   TInstant **instants = palloc(sizeof(TInstant *) * (s->count - loc));
-  int ninsts = 0;
+  int ninsts = 0, pos = 0;
   for (int i = loc; i < s->count; i++)
   {
     t = DatumGetTimestampTz(SET_VAL_N(s, i));
-    inst = tcontseq_at_timestamptz(seq, t);
-    if (inst)
-      instants[ninsts++] = inst;
+    if (t > DatumGetTimestampTz(seq->period.upper))
+      break;
+    if (contains_span_timestamptz(&seq->period, t))
+      instants[ninsts++] = tcontseq_at_timestamptz_gallop(seq, t, &pos);
   }
   return tsequence_make_free(instants, ninsts, true, true, DISCRETE,
     NORMALIZE_NO);
@@ -2435,14 +2508,19 @@ tcontseq_minus_tstzset_iter(const TSequence *seq, const Set *s,
 
   /* General case */
   interpType interp = MEOS_FLAGS_GET_INTERP(seq->flags);
-  TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
-  TInstant **tofree = palloc(sizeof(TInstant *) * Min(s->count, seq->count));
   bool lower_inc = seq->period.lower_inc;
   int i = 0,    /* current instant of the argument sequence */
-    j = 0,      /* current timestamp of the argument timestamp set */
+    j,          /* current timestamp of the argument timestamp set */
     nseqs = 0,  /* current number of new sequences */
     ninsts = 0, /* number of instants in the currently constructed sequence */
     nfree = 0;  /* number of instants to free */
+  /* Skip the timestamps before the sequence, which is needed for the
+   * composing sequences of a sequence set to make a single pass on the
+   * timestamps that they overlap */
+  set_find_value(s, seq->period.lower, &j);
+  TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  /* Each remaining timestamp creates at most one instant */
+  TInstant **tofree = palloc(sizeof(TInstant *) * (s->count - j));
   while (i < seq->count && j < s->count)
   {
     const TInstant *inst = TSEQUENCE_INST_N(seq, i);
@@ -2541,13 +2619,22 @@ tcontseq_minus_tstzset(const TSequence *seq, const Set *s)
 
 /**
  * @brief Restrict a continuous temporal sequence to a timestamptz span
+ * starting the search from a given instant
+ * @param[in] seq Temporal sequence
+ * @param[in] s Span
+ * @param[in,out] pos Index of the instant from which the search starts,
+ * which is updated with the segment containing the upper bound of the
+ * intersection, that is, the instant from which the search for the next
+ * span of a span set can start
+ * @param[out] instants Array of at least `seq->count` elements used for
+ * constructing the result
+ * @pre The instant @p pos is before (or equal to) the lower bound of the
+ * span
  */
-TSequence *
-tcontseq_at_tstzspan(const TSequence *seq, const Span *s)
+static TSequence *
+tcontseq_at_tstzspan_gallop(const TSequence *seq, const Span *s, int *pos,
+  TInstant **instants)
 {
-  assert(seq); assert(s);
-  assert(MEOS_FLAGS_GET_INTERP(seq->flags) != DISCRETE);
-
   /* Bounding box test */
   Span inter;
   if (! inter_span_span(&seq->period, s, &inter))
@@ -2563,41 +2650,30 @@ tcontseq_at_tstzspan(const TSequence *seq, const Span *s)
   /* Intersecting period is instantaneous */
   if (inter.lower == inter.upper)
   {
-    TInstant *inst = tcontseq_at_timestamptz(seq, inter.lower);
+    TInstant *inst = tcontseq_at_timestamptz_gallop(seq,
+      DatumGetTimestampTz(inter.lower), pos);
     result = tinstant_to_tsequence(inst, interp);
     pfree(inst);
     return result;
   }
 
-  int n = tcontseq_find_timestamptz(seq, inter.lower);
-  /* If the lower bound of the intersecting period is exclusive */
-  if (n == -1)
-    n = 0;
-  TInstant **instants = palloc(sizeof(TInstant *) * (seq->count - n));
+  /* Find the segments containing the bounds of the intersecting period */
+  int n = tcontseq_gallop_timestamptz(seq, DatumGetTimestampTz(inter.lower),
+    *pos, false);
+  int m = tcontseq_gallop_timestamptz(seq, DatumGetTimestampTz(inter.upper),
+    n, true);
   /* Compute the value at the beginning of the intersecting period */
-  const TInstant *inst1 = TSEQUENCE_INST_N(seq, n);
-  const TInstant *inst2 = TSEQUENCE_INST_N(seq, n + 1);
-  instants[0] = tsegment_at_timestamptz(inst1, inst2, interp, inter.lower);
+  instants[0] = tsegment_at_timestamptz(TSEQUENCE_INST_N(seq, n),
+    TSEQUENCE_INST_N(seq, n + 1), interp, DatumGetTimestampTz(inter.lower));
   int ninsts = 1;
-  for (int i = n + 2; i < seq->count; i++)
-  {
-    /* If the end of the intersecting period is between inst1 and inst2 */
-    if (inst1->t <= DatumGetTimestampTz(inter.upper) &&
-        DatumGetTimestampTz(inter.upper) <= inst2->t)
-      break;
-
-    inst1 = inst2;
-    inst2 = TSEQUENCE_INST_N(seq, i);
-    /* If the intersecting period contains inst1 */
-    if (DatumGetTimestampTz(inter.lower) <= inst1->t &&
-        inst1->t <= DatumGetTimestampTz(inter.upper))
-      instants[ninsts++] = (TInstant *) inst1;
-  }
+  /* Add the instants strictly inside the intersecting period */
+  for (int i = n + 1; i <= m; i++)
+    instants[ninsts++] = (TInstant *) TSEQUENCE_INST_N(seq, i);
   /* The last two values of sequences with step interpolation and
    * exclusive upper bound must be equal */
   if (interp == LINEAR || inter.upper_inc)
-    instants[ninsts++] = tsegment_at_timestamptz(inst1, inst2, interp,
-      inter.upper);
+    instants[ninsts++] = tsegment_at_timestamptz(TSEQUENCE_INST_N(seq, m),
+      TSEQUENCE_INST_N(seq, m + 1), interp, DatumGetTimestampTz(inter.upper));
   else
   {
     Datum value = tinstant_value_p(instants[ninsts - 1]);
@@ -2607,9 +2683,33 @@ tcontseq_at_tstzspan(const TSequence *seq, const Span *s)
    * normalize the projection of the sequence to the period */
   result = tsequence_make((const TInstant **) instants, ninsts,
     inter.lower_inc, inter.upper_inc, interp, NORMALIZE_NO);
+  pfree(instants[0]); pfree(instants[ninsts - 1]);
+  *pos = m;
+  return result;
+}
+
+/**
+ * @brief Restrict a continuous temporal sequence to a timestamptz span
+ */
+TSequence *
+tcontseq_at_tstzspan(const TSequence *seq, const Span *s)
+{
+  assert(seq); assert(s);
+  assert(MEOS_FLAGS_GET_INTERP(seq->flags) != DISCRETE);
+
+  /* Bounding box test */
+  if (! overlaps_span_span(&seq->period, s))
+    return NULL;
 
-  pfree(instants[0]); pfree(instants[ninsts - 1]); pfree(instants);
+  /* Instantaneous sequence */
+  if (seq->count == 1)
+    return tsequence_copy(seq);
 
+  /* General case */
+  TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  int pos = 0;
+  TSequence *result = tcontseq_at_tstzspan_gallop(seq, s, &pos, instants);
+  pfree(instants);
   return result;
 }
 
@@ -2730,20 +2830,22 @@ tcontseq_at_tstzspanset1(const TSequence *seq, const SpanSet *ss,
     return 1;
   }
 
-  /* General case */
+  /* General case: merge the spans and the instants */
   int loc;
   /* The second argument in the following call should be a Datum */
   spanset_find_value(ss, seq->period.lower, &loc);
-  int nseqs = 0;
+  TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  int nseqs = 0, pos = 0;
   for (int i = loc; i < ss->count; i++)
   {
     const Span *s = SPANSET_SP_N(ss, i);
-    TSequence *seq1 = tcontseq_at_tstzspan(seq, s);
+    TSequence *seq1 = tcontseq_at_tstzspan_gallop(seq, s, &pos, instants);
     if (seq1)
       result[nseqs++] = seq1;
     if (DatumGetTimestampTz(seq->period.upper) < DatumGetTimestampTz(s->upper))
       break;
   }
+  pfree(instants);
   return nseqs;
 }
 
@@ -2775,14 +2877,36 @@ tcontseq_minus_tstzspanset_iter(const TSequence *seq, const SpanSet *ss,
    *        |---| |---| |---|
    */
 
-  /* Compute the complement of the span set */
-  SpanSet *ss1 = minus_span_spanset(&seq->period, ss);
-  if (! ss1)
-    return 0;
-  int nseqs = 0;
-  for (int i = 0; i < ss1->count; i++)
-    result[nseqs++] = tcontseq_at_tstzspan(seq, SPANSET_SP_N(ss1, i));
-  pfree(ss1);
+  /* Bounding box test */
+  if (! overlaps_span_span(&seq->period, &ss->span))
+  {
+    result[0] = tsequence_copy(seq);
+    return 1;
+  }
+
+  /* Compute the complement of the spans of the span set from the one
+   * containing or following the start of the sequence, so that the composing
+   * sequences of a sequence set make a single pass on the spans */
+  int loc;
+  spanset_find_value(ss, seq->period.lower, &loc);
+  if (loc == ss->count)
+  {
+    result[0] = tsequence_copy(seq);
+    return 1;
+  }
+  Span *spans = palloc(sizeof(Span) * (ss->count - loc + 1));
+  int nspans = mi_span_spanset(&seq->period, ss, loc, ss->count, spans);
+  /* Merge the resulting spans and the instants */
+  TInstant **instants = palloc(sizeof(TInstant *) * seq->count);
+  int nseqs = 0, pos = 0;
+  for (int i = 0; i < nspans; i++)
+  {
+    TSequence *seq1 = tcontseq_at_tstzspan_gallop(seq, &spans[i], &pos,
+      instants);
+    if (seq1)
+      result[nseqs++] = seq1;
+  }
+  pfree(spans); pfree(instants);
   return nseqs;
 }
 
@@ -3112,14 +3236,15 @@ tsequenceset_restrict_tstzset(const TSequenceSet *ss, const Set *s,
   {
     TInstant **instants = palloc(sizeof(TInstant *) * s->count);
     int count = 0;
-    int i = 0, j = 0;
+    /* Position of the last instant found in the current sequence */
+    int i = 0, j = 0, pos = 0;
     while (i < s->count && j < ss->count)
     {
       seq = TSEQUENCESET_SEQ_N(ss, j);
       TimestampTz t = DatumGetTimestampTz(SET_VAL_N(s, i));
       if (contains_span_timestamptz(&seq->period, t))
       {
-        instants[count++] = tsequence_at_timestamptz(seq, t);
+        instants[count++] = tcontseq_at_timestamptz_gallop(seq, t, &pos);
         i++;
       }
       else
@@ -3127,7 +3252,10 @@ tsequenceset_restrict_tstzset(const TSequenceSet *ss, const Set *s,
         if (t <= DatumGetTimestampTz(seq->period.lower))
           i++;
         if (t >= DatumGetTimestampTz(seq->period.upper))
+        {
           j++;
+          pos = 0;
+        }
       }
     }
     return (Temporal *) tsequence_make_free(instants, count, true, true,
@@ -3267,7 +3395,10 @@ tsequenceset_restrict_tstzspanset(const TSequenceSet *ss, const SpanSet *ps,
 
   /* General case */
   TSequence **sequences;
-  int i = 0, j = 0, nseqs = 0;
+  /* For the at case, buffer for constructing the restriction of a sequence
+   * and position of the last instant found in the current sequence */
+  TInstant **instants = NULL;
+  int i = 0, j = 0, nseqs = 0, pos = 0;
   if (atfunc)
   {
     TimestampTz t = Max(DatumGetTimestampTz(ss->period.lower),
@@ -3275,6 +3406,7 @@ tsequenceset_restrict_tstzspanset(const TSequenceSet *ss, const SpanSet *ps,
     tsequenceset_find_timestamptz(ss, t, &i);
     spanset_find_value(ps, DatumGetTimestampTz(t), &j);
     sequences = palloc(sizeof(TSequence *) * (ss->count + ps->count - i - j));
+    instants = palloc(sizeof(TInstant *) * ss->totalcount);
   }
   else
     sequences = palloc(sizeof(TSequence *) * (ss->count + ps->count));
@@ -3288,25 +3420,27 @@ tsequenceset_restrict_tstzspanset(const TSequenceSet *ss, const SpanSet *ps,
       if (! atfunc)
         /* Copy the sequence */
         sequences[nseqs++] = tsequence_copy(seq);
-      i++;
+      i++; pos = 0;
     }
     else if (overlaps_span_span(&seq->period, s))
     {
       if (atfunc)
       {
         /* Compute the restriction of the sequence and the period */
-        TSequence *seq1 = tcontseq_at_tstzspan(seq, s);
+        TSequence *seq1 = tcontseq_at_tstzspan_gallop(seq, s, &pos, instants);
         if (seq1)
           sequences[nseqs++] = seq1;
         int cmp = timestamptz_cmp_internal(DatumGetTimestampTz(seq->period.upper),
           DatumGetTimestampTz(s->upper));
         if (cmp == 0 && seq->period.upper_inc == s->upper_inc)
         {
-          i++; j++;
+          i++; j++; pos = 0;
         }
         else if (cmp < 0 ||
           (cmp == 0 && ! seq->period.upper_inc && s->upper_inc))
-          i++;
+        {
+          i++; pos = 0;
+        }
         else
           j++;
       }
@@ -3323,7 +3457,9 @@ tsequenceset_restrict_tstzspanset(const TSequenceSet *ss, const SpanSet *ps,
     else
       j++;
   }
-  if (! atfunc)
+  if (atfunc)
+    pfree(instants);
+  else
   {
     /* For minus copy the sequences after the span set */
     while (i < ss->count)
@@ -35,7 +35,10 @@
 
 /* C */
 #include <stdlib.h>
+#include <float.h>
 #include <math.h>
+/* PostgreSQL */
+#include <postgres.h>
 /* MEOS */
 #include <meos.h>
 #include <meos_geo.h>
@@ -43,6 +46,8 @@
 #include <meos_internal_geo.h>
 #include "temporal/temporal.h"
 #include "temporal/temporal_rtree.h"
+#include "temporal/type_util.h"
+#include "geo/tgeo_spatialfuncs.h"
 
 /*****************************************************************************
  * Functions passed as parameters in the creation of an RTree
@@ -203,12 +208,76 @@ bbox_overlaps_tbox(const void *box1, const void *box2)
 /**
  * @brief Return `true` if the two spatiotemporal boxes overlap, `false`
  * otherwise
+ * @details Contrary to #overlaps_stbox_stbox, the inclusivity of the bounds
+ * of the periods is taken into account, as done for spans and temporal boxes
  * @param[in] box1,box2 Spatiotemporal boxes
  */
 static inline bool
 bbox_overlaps_stbox(const void *box1, const void *box2)
 {
-  return overlaps_stbox_stbox((STBox *) box1, (STBox *) box2);
+  const STBox *b1 = (const STBox *) box1;
+  const STBox *b2 = (const STBox *) box2;
+  if (! overlaps_stbox_stbox(b1, b2))
+    return false;
+  return ! MEOS_FLAGS_GET_T(b1->flags) || ! MEOS_FLAGS_GET_T(b2->flags) ||
+    overlaps_span_span(&b1->period, &b2->period);
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Return the distance between two spans as a double
+ * @param[in] box1,box2 Spans
+ * @note The distance between two timestamptz spans is already a float in
+ * seconds, while the distance between two date spans is an integer in days
+ */
+static double
+bbox_distance_span(const void *box1, const void *box2)
+{
+  const Span *s1 = (const Span *) box1;
+  Datum res = distance_span_span(s1, (const Span *) box2);
+  if (s1->spantype == T_TSTZSPAN)
+    return DatumGetFloat8(res);
+  return datum_double(res, spantype_basetype(s1->spantype));
+}
+
+/**
+ * @brief Return the nearest approach distance between two temporal boxes
+ * @param[in] box1,box2 Temporal boxes
+ * @return If the time frames do not intersect return infinity
+ */
+static double
+bbox_distance_tbox(const void *box1, const void *box2)
+{
+  return nad_tbox_tbox((const TBox *) box1, (const TBox *) box2);
+}
+
+/**
+ * @brief Return the nearest approach distance between two spatiotemporal
+ * boxes
+ * @details For Cartesian boxes the distance is computed directly from the
+ * coordinates of the boxes without converting them to geometries. Geodetic
+ * boxes are delegated to the function #nad_stbox_stbox.
+ * @param[in] box1,box2 Spatiotemporal boxes
+ * @return If the time frames do not intersect return infinity
+ */
+static double
+bbox_distance_stbox(const void *box1, const void *box2)
+{
+  const STBox *b1 = (const STBox *) box1;
+  const STBox *b2 = (const STBox *) box2;
+  if (MEOS_FLAGS_GET_GEODETIC(b1->flags))
+    return nad_stbox_stbox(b1, b2);
+  /* If the boxes do not intersect in the time dimension return infinity */
+  if (MEOS_FLAGS_GET_T(b1->flags) && MEOS_FLAGS_GET_T(b2->flags) &&
+      ! overlaps_span_span(&b1->period, &b2->period))
+    return DBL_MAX;
+  double dx = Max(0.0, Max(b1->xmin - b2->xmax, b2->xmin - b1->xmax));
+  double dy = Max(0.0, Max(b1->ymin - b2->ymax, b2->ymin - b1->ymax));
+  double dz = 0.0;
+  if (MEOS_FLAGS_GET_Z(b1->flags) && MEOS_FLAGS_GET_Z(b2->flags))
+    dz = Max(0.0, Max(b1->zmin - b2->zmax, b2->zmin - b1->zmax));
+  return sqrt(dx * dx + dy * dy + dz * dz);
 }
 
 /*****************************************************************************
@@ -217,21 +286,72 @@ bbox_overlaps_stbox(const void *box1, const void *box2)
 
 /**
  * @brief Creates a new RTree node
+ * @param[in] rtree Pointer to the RTree structure
  * @param[in] node_type Type of the node
- * @param[in] bboxsize Bounding box size 
  * @return Pointer to the newly created node
  */
 static RTreeNode *
-node_make(RTreeNodeType node_type, size_t bboxsize)
+node_make(const RTree *rtree, RTreeNodeType node_type)
 {
-  size_t bboxes_size = bboxsize * MAXITEMS;
+  size_t bboxes_size = rtree->bboxsize * MAXITEMS;
+  if (rtree->flat)
+    bboxes_size += sizeof(RTreeNodeSoA);
   RTreeNode *node = palloc0(sizeof(RTreeNode) + bboxes_size);
   node->node_type = node_type;
-  node->bboxsize = bboxsize;
+  node->bboxsize = rtree->bboxsize;
   node->count = 0;
   return node;
 }
 
+/**
+ * @brief Copy the n-th bounding box of a node into its structure-of-arrays
+ * bounds when the RTree has a flat layout
+ * @details Missing dimensions are set to infinite bounds so that they never
+ * filter out the entry, as done by #overlaps_stbox_stbox
+ * @param[in] rtree Pointer to the RTree structure
+ * @param[in,out] node Pointer to the node
+ * @param[in] n Position of the bounding box
+ */
+static void
+node_soa_set(const RTree *rtree, RTreeNode *node, int n)
+{
+  if (! rtree->flat)
+    return;
+  RTreeNodeSoA *soa = RTREE_NODE_SOA(node);
+  const STBox *box = (const STBox *) RTREE_NODE_BBOX_N(node, n);
+  if (MEOS_FLAGS_GET_X(box->flags))
+  {
+    soa->xmin[n] = box->xmin; soa->xmax[n] = box->xmax;
+    soa->ymin[n] = box->ymin; soa->ymax[n] = box->ymax;
+  }
+  else
+  {
+    soa->xmin[n] = soa->ymin[n] = -INFINITY;
+    soa->xmax[n] = soa->ymax[n] = INFINITY;
+  }
+  if (MEOS_FLAGS_GET_Z(box->flags))
+  {
+    soa->zmin[n] = box->zmin; soa->zmax[n] = box->zmax;
+  }
+  else
+  {
+    soa->zmin[n] = -INFINITY; soa->zmax[n] = INFINITY;
+  }
+  if (MEOS_FLAGS_GET_T(box->flags))
+  {
+    soa->tmin[n] = DatumGetTimestampTz(box->period.lower);
+    soa->tmax[n] = DatumGetTimestampTz(box->period.upper);
+    soa->tmin_inc[n] = box->period.lower_inc;
+    soa->tmax_inc[n] = box->period.upper_inc;
+  }
+  else
+  {
+    soa->tmin[n] = PG_INT64_MIN; soa->tmax[n] = PG_INT64_MAX;
+    soa->tmin_inc[n] = soa->tmax_inc[n] = 1;
+  }
+  return;
+}
+
 /**
  * @brief Return the length of a bounding box along a given axis as a double
  * @param[in] rtree Pointer to the RTree structure containing the function to
@@ -340,7 +460,7 @@ node_choose(const RTree *rtree, const void *box, const RTreeNode *node)
   /* Check if the bounding box can be added without expanding any rectangle */
   for (int i = 0; i < node->count; ++i)
   {
-    if (rtree->bbox_contains(&rtree->box, box))
+    if (rtree->bbox_contains(RTREE_NODE_BBOX_N(node, i), box))
       return i;
   }
   /* Fallback to "least enlargement" */
@@ -395,6 +515,7 @@ box_largest_axis(const RTree *rtree, const void *box)
 /**
  * @brief Moves a bounding box from one RTree node to another.
  * @details Changes the information from one node into another.
+ * @param[in] rtree Pointer to the RTree structure
  * @param[in] from Pointer to the node from which the bounding box is
  * being moved.
  * @param[in] index The index of the bounding box in the `from` node that is to
@@ -403,7 +524,8 @@ box_largest_axis(const RTree *rtree, const void *box)
  * to.
  */
 static void
-node_move_box_at_index_into(RTreeNode *from, int index, RTreeNode *into)
+node_move_box_at_index_into(const RTree *rtree, RTreeNode *from, int index,
+  RTreeNode *into)
 {
   memcpy(RTREE_NODE_BBOX_N(into, into->count), RTREE_NODE_BBOX_N(from, index),
     from->bboxsize);
@@ -419,6 +541,8 @@ node_move_box_at_index_into(RTreeNode *from, int index, RTreeNode *into)
     into->nodes[into->count] = from->nodes[index];
     from->nodes[index] = from->nodes[from->count - 1];
   }
+  node_soa_set(rtree, into, into->count);
+  node_soa_set(rtree, from, index);
   from->count--;
   into->count++;
   return;
@@ -447,7 +571,7 @@ node_swap(const RTree *rtree, RTreeNode *node, int i, int j)
   memcpy(RTREE_NODE_BBOX_N(node, j), &box, rtree->bboxsize);
   if (node->node_type == RTREE_LEAF)
   {
-    int tmp = node->ids[i];
+    int64 tmp = node->ids[i];
     node->ids[i] = node->ids[j];
     node->ids[j] = tmp;
   }
@@ -457,6 +581,8 @@ node_swap(const RTree *rtree, RTreeNode *node, int i, int j)
     node->nodes[i] = node->nodes[j];
     node->nodes[j] = tree;
   }
+  node_soa_set(rtree, node, i);
+  node_soa_set(rtree, node, j);
   return;
 }
 
@@ -547,7 +673,7 @@ node_split(RTree *rtree, RTreeNode *node, void *box, RTreeNode **right_out)
 {
   /* Split through the largest axis */
   int largest_axis = box_largest_axis(rtree, box);
-  RTreeNode *right = node_make(node->node_type, rtree->bboxsize);
+  RTreeNode *right = node_make(rtree, node->node_type);
   for (int i = 0; i < node->count; ++i)
   {
     double min_dist =
@@ -558,7 +684,7 @@ node_split(RTree *rtree, RTreeNode *node, void *box, RTreeNode **right_out)
       rtree->get_axis(RTREE_NODE_BBOX_N(node, i), largest_axis, true);
     /* Move to the right */
     if (max_dist < min_dist)
-      node_move_box_at_index_into(node, i--, right);
+      node_move_box_at_index_into(rtree, node, i--, right);
   }
 
   /* Make sure that both left and right nodes have at least MINITEMS by moving
@@ -569,7 +695,7 @@ node_split(RTree *rtree, RTreeNode *node, void *box, RTreeNode **right_out)
     node_sort_axis(rtree, right, largest_axis, false);
     do
     {
-      node_move_box_at_index_into(right, right->count - 1, node);
+      node_move_box_at_index_into(rtree, right, right->count - 1, node);
     } while (node->count < MINITEMS);
   }
   else if (right->count < MINITEMS)
@@ -578,7 +704,7 @@ node_split(RTree *rtree, RTreeNode *node, void *box, RTreeNode **right_out)
     node_sort_axis(rtree, node, largest_axis, true);
     do
     {
-      node_move_box_at_index_into(node, node->count - 1, right);
+      node_move_box_at_index_into(rtree, node, node->count - 1, right);
     } while (right->count < MINITEMS);
   }
   if (node->node_type == RTREE_INNER)
@@ -613,7 +739,7 @@ node_split(RTree *rtree, RTreeNode *node, void *box, RTreeNode **right_out)
  */
 static void
 node_insert(RTree *rtree, void *node_bounding_box, RTreeNode *node,
-  void *new_box, int id, bool *split)
+  void *new_box, int64 id, bool *split)
 {
   if (node->node_type == RTREE_LEAF)
   {
@@ -624,6 +750,7 @@ node_insert(RTree *rtree, void *node_bounding_box, RTreeNode *node,
     }
     int index = node->count;
     memcpy(RTREE_NODE_BBOX_N(node, index), new_box, rtree->bboxsize);
+    node_soa_set(rtree, node, index);
     node->ids[index] = id;
     node->count++;
     *split = false;
@@ -635,6 +762,7 @@ node_insert(RTree *rtree, void *node_bounding_box, RTreeNode *node,
   if (! *split)
   {
     rtree->bbox_expand(new_box, RTREE_NODE_BBOX_N(node, insertion_node));
+    node_soa_set(rtree, node, insertion_node);
     *split = false;
     return;
   }
@@ -649,6 +777,8 @@ node_insert(RTree *rtree, void *node_bounding_box, RTreeNode *node,
   node_box_calculate(rtree, node->nodes[insertion_node],
     RTREE_NODE_BBOX_N(node, insertion_node));
   node_box_calculate(rtree, right, RTREE_NODE_BBOX_N(node, node->count));
+  node_soa_set(rtree, node, insertion_node);
+  node_soa_set(rtree, node, node->count);
   node->nodes[node->count] = right;
   node->count++;
   node_insert(rtree, node_bounding_box, node, new_box, id, split);
@@ -669,19 +799,19 @@ is_power_of_two(const int n)
 /**
  * @brief Adds an ID to the dynamically allocated array with the answer of a
  * query
- * @param[in] id The integer ID to be added to the array
+ * @param[in] id The ID to be added to the array
  * @param[in] ids Pointer to a pointer to the dynamically allocated array of
- * integers
+ * IDs
  * @param[in] count Pointer to an integer representing the current number of
  * elements in the array.
  */
 static void
-add_answer(const int id, int **ids, int *count)
+add_answer(const int64 id, int64 **ids, int *count)
 {
   /* Every power of two that exceeds the size of the array must be resized to
    * double the current size */
   if (*count >= SEARCH_ARRAY_STARTING_SIZE && is_power_of_two(*count))
-    *ids = repalloc(*ids, sizeof(int) * (*count) * 2);
+    *ids = repalloc(*ids, sizeof(int64) * (*count) * 2);
   (*ids)[*count] = id;
   (*count)++;
   return;
@@ -695,9 +825,9 @@ add_answer(const int id, int **ids, int *count)
  * @param[in] ids The array with the list of answers
  * @param[in] count Total of elements found
  */
-void
+static void
 node_search(const RTree *rtree, const RTreeNode *node, const void *query,
-  int **ids, int *count)
+  int64 **ids, int *count)
 {
   for (int i = 0; i < node->count; ++i)
   {
@@ -712,6 +842,71 @@ node_search(const RTree *rtree, const RTreeNode *node, const void *query,
   return;
 }
 
+/**
+ * @brief Query bounds of a search in an RTree with a flat layout
+ * @details Missing dimensions of the query are set to infinite bounds
+ */
+typedef struct
+{
+  double xmin, xmax, ymin, ymax, zmin, zmax;
+  int64 tmin, tmax;
+  uint8 tmin_inc, tmax_inc;
+} RTreeSoAQuery;
+
+/**
+ * @brief Set the overlap flags of all the entries of a node with a flat
+ * layout
+ * @details The loop is branch-free over contiguous arrays so that the
+ * compiler vectorizes it, testing several entries per instruction. As in
+ * #overlaps_span_span, two periods whose bounds are equal only overlap when
+ * both bounds are inclusive.
+ * @param[in] soa Structure-of-arrays bounds of the node
+ * @param[in] count Number of entries of the node
+ * @param[in] q Query bounds
+ * @param[out] hits Array of flags, one per entry
+ */
+static void
+soa_overlaps(const RTreeNodeSoA *restrict soa, int count,
+  const RTreeSoAQuery *restrict q, uint8 *restrict hits)
+{
+  for (int i = 0; i < count; ++i)
+    hits[i] = (uint8) (
+      (soa->xmin[i] <= q->xmax) & (soa->xmax[i] >= q->xmin) &
+      (soa->ymin[i] <= q->ymax) & (soa->ymax[i] >= q->ymin) &
+      (soa->zmin[i] <= q->zmax) & (soa->zmax[i] >= q->zmin) &
+      ((soa->tmin[i] < q->tmax) |
+        ((soa->tmin[i] == q->tmax) & soa->tmin_inc[i] & q->tmax_inc)) &
+      ((soa->tmax[i] > q->tmin) |
+        ((soa->tmax[i] == q->tmin) & soa->tmax_inc[i] & q->tmin_inc)) );
+  return;
+}
+
+/**
+ * @brief Searches recursively a node of an RTree with a flat layout looking
+ * for hits with a query
+ * @param[in] node The node to be searched
+ * @param[in] q The bounds of the query
+ * @param[in] ids The array with the list of answers
+ * @param[in] count Total of elements found
+ */
+static void
+node_search_flat(const RTreeNode *node, const RTreeSoAQuery *q, int64 **ids,
+  int *count)
+{
+  uint8 hits[MAXITEMS];
+  soa_overlaps(RTREE_NODE_SOA(node), node->count, q, hits);
+  for (int i = 0; i < node->count; ++i)
+  {
+    if (! hits[i])
+      continue;
+    if (node->node_type == RTREE_LEAF)
+      add_answer(node->ids[i], ids, count);
+    else
+      node_search_flat(node->nodes[i], q, ids, count);
+  }
+  return;
+}
+
 /**
  * @brief Creates an RTree index.
  * @param[in] bboxtype The meosType of the elements to index.
@@ -721,7 +916,8 @@ RTree *
 rtree_create(meosType bboxtype)
 {
   assert(span_type(bboxtype) || bboxtype == T_TBOX || bboxtype == T_STBOX);
-  size_t bboxsize = bbox_get_size(bboxtype);
+  size_t bboxsize = span_type(bboxtype) ? sizeof(Span) :
+    bbox_get_size(bboxtype);
   RTree *rtree = palloc0(sizeof(RTree) + bboxsize);
   if (span_type(bboxtype))
   {
@@ -730,6 +926,7 @@ rtree_create(meosType bboxtype)
     rtree->bbox_expand = &bbox_expand_span;
     rtree->bbox_contains = &bbox_contains_span;
     rtree->bbox_overlaps = &bbox_overlaps_span;
+    rtree->bbox_distance = &bbox_distance_span;
   }
   else if (bboxtype == T_TBOX)
   {
@@ -738,6 +935,7 @@ rtree_create(meosType bboxtype)
     rtree->bbox_expand = &bbox_expand_tbox;
     rtree->bbox_contains = &bbox_contains_tbox;
     rtree->bbox_overlaps = &bbox_overlaps_tbox;
+    rtree->bbox_distance = &bbox_distance_tbox;
   }
   else /* bboxtype == T_STBOX */
   {
@@ -748,6 +946,7 @@ rtree_create(meosType bboxtype)
     rtree->bbox_expand = &bbox_expand_stbox;
     rtree->bbox_contains = &bbox_contains_stbox;
     rtree->bbox_overlaps = &bbox_overlaps_stbox;
+    rtree->bbox_distance = &bbox_distance_stbox;
   }
   rtree->bboxtype = bboxtype;
   rtree->bboxsize = bboxsize;
@@ -824,6 +1023,42 @@ rtree_create_stbox()
   return rtree_create(T_STBOX);
 }
 
+/**
+ * @ingroup meos_geo_box_index
+ * @brief Creates an RTree index for spatiotemporal boxes with a flat layout
+ * @details Each node keeps, in addition to its bounding boxes, a
+ * structure-of-arrays copy of their bounds, so that searches test all the
+ * entries of a node with a single vectorized loop instead of calling the
+ * overlap function for each box. This speeds up searches at the expense of
+ * about 4KB of memory per node. Since the SRID and the geodetic flag of the
+ * boxes are not copied, all the boxes of the tree must have the same ones,
+ * which is verified at insertion, and they are verified once per query.
+ * @return RTree initialized
+ */
+RTree *
+rtree_create_stbox_flat()
+{
+  RTree *result = rtree_create(T_STBOX);
+  result->flat = true;
+  return result;
+}
+
+/**
+ * @brief Ensure that two spatiotemporal boxes have the same SRID and
+ * geodetic flag when both have a spatial dimension
+ * @details All the spatiotemporal boxes of an RTree must have the same SRID
+ * and geodetic flag
+ * @param[in] box1,box2 Spatiotemporal boxes
+ */
+static bool
+rtree_ensure_same_srs(const STBox *box1, const STBox *box2)
+{
+  if (! MEOS_FLAGS_GET_X(box1->flags) || ! MEOS_FLAGS_GET_X(box2->flags))
+    return true;
+  return ensure_same_geodetic(box1->flags, box2->flags) &&
+    ensure_same_srid(stbox_srid(box1), stbox_srid(box2));
+}
+
 /**
  * @ingroup meos_geo_box_index
  * @brief Insert a bounding box into the RTree index.
@@ -837,11 +1072,15 @@ rtree_create_stbox()
 void
 rtree_insert(RTree *rtree, void *box, int64 id)
 {
+  if (rtree->bboxtype == T_STBOX && rtree->root &&
+      ! rtree_ensure_same_srs((const STBox *) box, (const STBox *) rtree->box))
+    return;
+
   while (1)
   {
     if (! rtree->root)
     {
-      RTreeNode *new_root = node_make(RTREE_LEAF, rtree->bboxsize);
+      RTreeNode *new_root = node_make(rtree, RTREE_LEAF);
       if (rtree->dims < 0)
         rtree->dims = 3 + MEOS_FLAGS_GET_Z(((STBox *) box)->flags);
       rtree->root = new_root;
@@ -854,12 +1093,14 @@ rtree_insert(RTree *rtree, void *box, int64 id)
       rtree->bbox_expand(box, &rtree->box);
       return;
     }
-    RTreeNode *new_root = node_make(RTREE_INNER, rtree->bboxsize);
+    RTreeNode *new_root = node_make(rtree, RTREE_INNER);
     RTreeNode *right;
     node_split(rtree, rtree->root, &rtree->box, &right);
 
     node_box_calculate(rtree, rtree->root, RTREE_NODE_BBOX_N(new_root, 0));
     node_box_calculate(rtree, right, RTREE_NODE_BBOX_N(new_root, 1));
+    node_soa_set(rtree, new_root, 0);
+    node_soa_set(rtree, new_root, 1);
     new_root->nodes[0] = rtree->root;
     new_root->nodes[1] = right;
     rtree->root = new_root;
@@ -878,13 +1119,59 @@ rtree_insert(RTree *rtree, void *box, int64 id)
  * @return Array of ids that have a hit.
  * @note The `count` will be the output size of the array given.
  */
-int *
+int64 *
 rtree_search(const RTree *rtree, const void *query, int *count)
 {
-  int *ids = palloc(sizeof(int) * SEARCH_ARRAY_STARTING_SIZE);
+  int64 *ids = palloc(sizeof(int64) * SEARCH_ARRAY_STARTING_SIZE);
   *count = 0;
-  if (rtree->root)
+  if (! rtree->root)
+    return ids;
+  if (! rtree->flat)
+  {
     node_search(rtree, rtree->root, query, &ids, count);
+    return ids;
+  }
+
+  /* Validate the query against the box of the tree once, since all the
+   * boxes of the tree have the same SRID and geodetic flag, and give up
+   * early when the query does not overlap the box of the tree */
+  const STBox *box = (const STBox *) query;
+  if (! ensure_common_dimension(box->flags, ((STBox *) rtree->box)->flags) ||
+      ! rtree_ensure_same_srs(box, (const STBox *) rtree->box) ||
+      ! bbox_overlaps_stbox(box, rtree->box))
+    return ids;
+  RTreeSoAQuery q;
+  if (MEOS_FLAGS_GET_X(box->flags))
+  {
+    q.xmin = box->xmin; q.xmax = box->xmax;
+    q.ymin = box->ymin; q.ymax = box->ymax;
+  }
+  else
+  {
+    q.xmin = q.ymin = -INFINITY;
+    q.xmax = q.ymax = INFINITY;
+  }
+  if (MEOS_FLAGS_GET_Z(box->flags))
+  {
+    q.zmin = box->zmin; q.zmax = box->zmax;
+  }
+  else
+  {
+    q.zmin = -INFINITY; q.zmax = INFINITY;
+  }
+  if (MEOS_FLAGS_GET_T(box->flags))
+  {
+    q.tmin = DatumGetTimestampTz(box->period.lower);
+    q.tmax = DatumGetTimestampTz(box->period.upper);
+    q.tmin_inc = box->period.lower_inc;
+    q.tmax_inc = box->period.upper_inc;
+  }
+  else
+  {
+    q.tmin = PG_INT64_MIN; q.tmax = PG_INT64_MAX;
+    q.tmin_inc = q.tmax_inc = 1;
+  }
+  node_search_flat(rtree->root, &q, &ids, count);
   return ids;
 }
 
@@ -922,4 +1209,502 @@ rtree_free(RTree *rtree)
   return;
 }
 
+/*****************************************************************************
+ * Bulk loading
+ *****************************************************************************/
+
+/**
+ * @brief Argument of the comparison function for sorting RTree entries
+ */
+typedef struct
+{
+  const RTree *rtree;  /**< RTree providing the function to retrieve axes */
+  int axis;            /**< Axis along which the entries are sorted */
+} RTreeSortArg;
+
+/**
+ * @brief Comparison function for sorting RTree entries on the center of
+ * their bounding boxes along a given axis
+ * @note Comparing the sum of the bounds is equivalent to comparing the
+ * centers
+ */
+static int
+entry_center_cmp(const void *a, const void *b, void *arg)
+{
+  const RTreeSortArg *sarg = (const RTreeSortArg *) arg;
+  const RTree *rtree = sarg->rtree;
+  const RTreeEntry *e1 = (const RTreeEntry *) a;
+  const RTreeEntry *e2 = (const RTreeEntry *) b;
+  double c1 = rtree->get_axis(&e1->box, sarg->axis, false) +
+    rtree->get_axis(&e1->box, sarg->axis, true);
+  double c2 = rtree->get_axis(&e2->box, sarg->axis, false) +
+    rtree->get_axis(&e2->box, sarg->axis, true);
+  return (c1 < c2) ? -1 : ((c1 > c2) ? 1 : 0);
+}
+
+/**
+ * @brief Order an array of entries following the Sort-Tile-Recursive (STR)
+ * algorithm
+ * @details The entries are sorted along the given axis and partitioned into
+ * `ceil(P^(1/d))` slabs, where `P` is the number of nodes needed to hold the
+ * entries and `d` is the number of remaining axes. Each slab is then tiled
+ * recursively along the next axis. After the call, each run of `MAXITEMS`
+ * consecutive entries forms a node.
+ * @param[in] rtree Pointer to the RTree structure
+ * @param[in,out] entries Array of entries
+ * @param[in] count Number of entries
+ * @param[in] axis Axis along which the entries are sorted
+ */
+static void
+rtree_str_tile(const RTree *rtree, RTreeEntry *entries, int count, int axis)
+{
+  RTreeSortArg arg = { rtree, axis };
+  qsort_arg(entries, (size_t) count, sizeof(RTreeEntry), &entry_center_cmp,
+    &arg);
+  if (axis == rtree->dims - 1 || count <= MAXITEMS)
+    return;
+  int nodes = (count + MAXITEMS - 1) / MAXITEMS;
+  int slabs = (int) ceil(pow((double) nodes, 1.0 / (rtree->dims - axis)));
+  /* Each slab holds a whole number of full nodes */
+  int slabsize = ((nodes + slabs - 1) / slabs) * MAXITEMS;
+  for (int i = 0; i < count; i += slabsize)
+    rtree_str_tile(rtree, &entries[i], Min(slabsize, count - i), axis + 1);
+  return;
+}
+
+/**
+ * @brief Pack an array of entries into the nodes of one level of an RTree
+ * @details The entries are ordered with the STR algorithm and grouped into
+ * nodes of `MAXITEMS` entries. On return, the first elements of the array
+ * are the entries pointing to the newly created nodes.
+ * @param[in] rtree Pointer to the RTree structure
+ * @param[in,out] entries Array of entries
+ * @param[in] count Number of entries
+ * @param[in] node_type Type of the nodes to create
+ * @return Number of nodes created
+ */
+static int
+rtree_str_pack(const RTree *rtree, RTreeEntry *entries, int count,
+  RTreeNodeType node_type)
+{
+  rtree_str_tile(rtree, entries, count, 0);
+  int nnodes = 0;
+  for (int i = 0; i < count; i += MAXITEMS)
+  {
+    RTreeNode *node = node_make(rtree, node_type);
+    node->count = Min(MAXITEMS, count - i);
+    for (int j = 0; j < node->count; ++j)
+    {
+      memcpy(RTREE_NODE_BBOX_N(node, j), &entries[i + j].box,
+        rtree->bboxsize);
+      node_soa_set(rtree, node, j);
+      if (node_type == RTREE_LEAF)
+        node->ids[j] = entries[i + j].id;
+      else
+        node->nodes[j] = entries[i + j].node;
+    }
+    /* The entries of the node have already been consumed since nnodes <= i */
+    node_box_calculate(rtree, node, &entries[nnodes].box);
+    entries[nnodes++].node = node;
+  }
+  return nnodes;
+}
+
+/**
+ * @brief Append the leaf entries of a subtree to a dynamically allocated
+ * array of entries
+ * @param[in] rtree Pointer to the RTree structure
+ * @param[in] node Root of the subtree
+ * @param[in,out] entries Pointer to the array of entries
+ * @param[in,out] count Number of elements in the array
+ * @param[in,out] maxcount Number of elements allocated for the array
+ */
+static void
+node_collect(const RTree *rtree, const RTreeNode *node, RTreeEntry **entries,
+  int *count, int *maxcount)
+{
+  for (int i = 0; i < node->count; ++i)
+  {
+    if (node->node_type == RTREE_INNER)
+    {
+      node_collect(rtree, node->nodes[i], entries, count, maxcount);
+      continue;
+    }
+    if (*count == *maxcount)
+    {
+      *maxcount *= 2;
+      *entries = repalloc(*entries, sizeof(RTreeEntry) * (*maxcount));
+    }
+    (*entries)[*count].id = node->ids[i];
+    memcpy(&(*entries)[*count].box, RTREE_NODE_BBOX_N(node, i),
+      rtree->bboxsize);
+    (*count)++;
+  }
+  return;
+}
+
+/**
+ * @ingroup meos_geo_box_index
+ * @brief Load an array of bounding boxes into an RTree index using the
+ * Sort-Tile-Recursive (STR) algorithm
+ * @details The tree is built bottom-up with fully packed nodes, which yields
+ * less overlap between nodes and faster queries than inserting the boxes one
+ * by one. If the RTree is not empty, the boxes already indexed are loaded
+ * together with the new ones. Spatiotemporal boxes must have the same SRID
+ * and geodetic flag as the ones already indexed, otherwise no box is loaded.
+ * @param[in] rtree The RTree previously initialized
+ * @param[in] boxes Array of bounding boxes of the type of the RTree
+ * @param[in] ids Array of ids of the bounding boxes, if `NULL` the position
+ * of the box in the array is used as id
+ * @param[in] count Number of bounding boxes
+ */
+void
+rtree_bulk_load(RTree *rtree, const void *boxes, const int64 *ids, int count)
+{
+  assert(rtree); assert(boxes);
+  if (count <= 0)
+    return;
+  if (rtree->bboxtype == T_STBOX)
+  {
+    const STBox *stboxes = (const STBox *) boxes;
+    const STBox *first = rtree->root ? (const STBox *) rtree->box : stboxes;
+    for (int i = 0; i < count; ++i)
+    {
+      if (! rtree_ensure_same_srs(&stboxes[i], first))
+        return;
+    }
+  }
+
+  int total = 0, maxcount = count;
+  RTreeEntry *entries = palloc(sizeof(RTreeEntry) * maxcount);
+  if (rtree->root)
+  {
+    node_collect(rtree, rtree->root, &entries, &total, &maxcount);
+    node_free(rtree->root);
+    rtree->root = NULL;
+    if (total + count > maxcount)
+    {
+      maxcount = total + count;
+      entries = repalloc(entries, sizeof(RTreeEntry) * maxcount);
+    }
+  }
+  else if (rtree->dims < 0)
+    rtree->dims = 3 + MEOS_FLAGS_GET_Z(((STBox *) boxes)->flags);
+
+  const char *box = (const char *) boxes;
+  for (int i = 0; i < count; ++i)
+  {
+    memcpy(&entries[total].box, box + i * rtree->bboxsize, rtree->bboxsize);
+    entries[total++].id = ids ? ids[i] : (int64) i;
+  }
+
+  /* Pack the entries bottom-up until a single root node remains */
+  RTreeNodeType node_type = RTREE_LEAF;
+  do
+  {
+    total = rtree_str_pack(rtree, entries, total, node_type);
+    node_type = RTREE_INNER;
+  } while (total > 1);
+  rtree->root = entries[0].node;
+  memcpy(rtree->box, &entries[0].box, rtree->bboxsize);
+  pfree(entries);
+  return;
+}
+
+/*****************************************************************************
+ * Deletion
+ *****************************************************************************/
+
+/**
+ * @brief Remove the entry at a given position of an RTree node by moving the
+ * last entry into its place
+ * @param[in] rtree Pointer to the RTree structure
+ * @param[in,out] node Pointer to the node
+ * @param[in] index Position of the entry to remove
+ */
+static void
+node_remove_at(const RTree *rtree, RTreeNode *node, int index)
+{
+  int last = node->count - 1;
+  if (index != last)
+  {
+    memcpy(RTREE_NODE_BBOX_N(node, index), RTREE_NODE_BBOX_N(node, last),
+      node->bboxsize);
+    if (node->node_type == RTREE_LEAF)
+      node->ids[index] = node->ids[last];
+    else
+      node->nodes[index] = node->nodes[last];
+    node_soa_set(rtree, node, index);
+  }
+  node->count--;
+  return;
+}
+
+/**
+ * @brief Delete recursively an entry from a node
+ * @details Only the children whose bounding box contains the box to delete
+ * are visited. When a child underflows after the deletion, it is removed
+ * from the node and its leaf entries are appended to the array of orphans,
+ * which must be reinserted afterwards. Otherwise, the bounding box of the
+ * child is tightened.
+ * @param[in] rtree Pointer to the RTree structure
+ * @param[in] node Node from which the entry is deleted
+ * @param[in] box Bounding box of the entry to delete
+ * @param[in] id Id of the entry to delete
+ * @param[in,out] orphans Pointer to the array of orphan entries
+ * @param[in,out] norphans Number of orphan entries
+ * @param[in,out] maxorphans Number of elements allocated for the orphans
+ * @return True if the entry was found and deleted
+ */
+static bool
+node_delete(const RTree *rtree, RTreeNode *node, const void *box, int64 id,
+  RTreeEntry **orphans, int *norphans, int *maxorphans)
+{
+  for (int i = 0; i < node->count; ++i)
+  {
+    void *node_box = RTREE_NODE_BBOX_N(node, i);
+    if (node->node_type == RTREE_LEAF)
+    {
+      if (node->ids[i] == id && rtree->bbox_contains(node_box, box) &&
+          rtree->bbox_contains(box, node_box))
+      {
+        node_remove_at(rtree, node, i);
+        return true;
+      }
+      continue;
+    }
+    if (! rtree->bbox_contains(node_box, box))
+      continue;
+    RTreeNode *child = node->nodes[i];
+    if (! node_delete(rtree, child, box, id, orphans, norphans, maxorphans))
+      continue;
+    if (child->count < MINITEMS)
+    {
+      node_collect(rtree, child, orphans, norphans, maxorphans);
+      node_free(child);
+      node_remove_at(rtree, node, i);
+    }
+    else
+    {
+      node_box_calculate(rtree, child, node_box);
+      node_soa_set(rtree, node, i);
+    }
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @ingroup meos_geo_box_index
+ * @brief Delete a bounding box from an RTree index
+ * @details The entry to delete must have the same id and bounding box as
+ * the ones given at insertion. Nodes that underflow after the deletion are
+ * dissolved and their entries are reinserted into the tree.
+ * @param[in] rtree The RTree
+ * @param[in] box The bounding box to delete
+ * @param[in] id The id of the box to delete
+ * @return True if the entry was found and deleted, false otherwise
+ */
+bool
+rtree_delete(RTree *rtree, const void *box, int64 id)
+{
+  assert(rtree); assert(box);
+  if (! rtree->root)
+    return false;
+
+  int norphans = 0, maxorphans = MAXITEMS;
+  RTreeEntry *orphans = palloc(sizeof(RTreeEntry) * maxorphans);
+  if (! node_delete(rtree, rtree->root, box, id, &orphans, &norphans,
+      &maxorphans))
+  {
+    pfree(orphans);
+    return false;
+  }
+
+  /* Shorten the tree while the root has a single child */
+  while (rtree->root->node_type == RTREE_INNER && rtree->root->count == 1)
+  {
+    RTreeNode *child = rtree->root->nodes[0];
+    pfree(rtree->root);
+    rtree->root = child;
+  }
+  if (rtree->root->count == 0)
+  {
+    node_free(rtree->root);
+    rtree->root = NULL;
+  }
+  else
+    node_box_calculate(rtree, rtree->root, rtree->box);
+
+  /* Reinsert the entries of the dissolved nodes */
+  for (int i = 0; i < norphans; ++i)
+    rtree_insert(rtree, &orphans[i].box, orphans[i].id);
+  pfree(orphans);
+  return true;
+}
+
+/*****************************************************************************
+ * Nearest neighbor search
+ *****************************************************************************/
+
+/**
+ * @brief Return true if the first element of a kNN priority queue must be
+ * popped before the second one
+ * @details At equal distance leaf entries come before nodes so that the
+ * search can stop as soon as possible
+ */
+static inline bool
+knn_elem_lt(const RTreeKnnElem *e1, const RTreeKnnElem *e2)
+{
+  return e1->dist < e2->dist ||
+    (e1->dist == e2->dist && e1->leaf && ! e2->leaf);
+}
+
+/**
+ * @brief Push an element into the binary min-heap of a kNN search
+ * @param[in,out] heap Pointer to the array of the heap
+ * @param[in,out] count Number of elements in the heap
+ * @param[in,out] maxcount Number of elements allocated for the heap
+ * @param[in] elem Element to push
+ */
+static void
+knn_heap_push(RTreeKnnElem **heap, int *count, int *maxcount,
+  const RTreeKnnElem *elem)
+{
+  if (*count == *maxcount)
+  {
+    *maxcount *= 2;
+    *heap = repalloc(*heap, sizeof(RTreeKnnElem) * (*maxcount));
+  }
+  RTreeKnnElem *h = *heap;
+  int i = (*count)++;
+  while (i > 0)
+  {
+    int parent = (i - 1) / 2;
+    if (! knn_elem_lt(elem, &h[parent]))
+      break;
+    h[i] = h[parent];
+    i = parent;
+  }
+  h[i] = *elem;
+  return;
+}
+
+/**
+ * @brief Pop the element with the smallest distance from the binary min-heap
+ * of a kNN search
+ * @param[in,out] heap Array of the heap
+ * @param[in,out] count Number of elements in the heap, must be positive
+ */
+static RTreeKnnElem
+knn_heap_pop(RTreeKnnElem *heap, int *count)
+{
+  RTreeKnnElem result = heap[0];
+  RTreeKnnElem last = heap[--(*count)];
+  int i = 0;
+  while (true)
+  {
+    int child = 2 * i + 1;
+    if (child >= *count)
+      break;
+    if (child + 1 < *count && knn_elem_lt(&heap[child + 1], &heap[child]))
+      child++;
+    if (! knn_elem_lt(&heap[child], &last))
+      break;
+    heap[i] = heap[child];
+    i = child;
+  }
+  heap[i] = last;
+  return result;
+}
+
+/**
+ * @brief Ensure that a box of an RTree of temporal or spatiotemporal boxes
+ * has a value or spatial dimension, which is required by the distance
+ * functions #nad_tbox_tbox and #nad_stbox_stbox
+ * @param[in] rtree The RTree
+ * @param[in] box The bounding box
+ */
+static bool
+rtree_knn_has_X(const RTree *rtree, const void *box)
+{
+  if (rtree->bboxtype == T_TBOX)
+    return ensure_has_X(T_TBOX, ((const TBox *) box)->flags);
+  if (rtree->bboxtype == T_STBOX)
+    return ensure_has_X(T_STBOX, ((const STBox *) box)->flags);
+  return true;
+}
+
+/**
+ * @ingroup meos_geo_box_index
+ * @brief Return the ids of the k bounding boxes of an RTree that are nearest
+ * to a query box
+ * @details The tree is traversed best-first using a priority queue ordered
+ * by the nearest approach distance between the query and the bounding boxes
+ * of the nodes, which is a lower bound of the distance to any of the boxes
+ * they contain. The distance used is the one of the functions
+ * #distance_span_span, #nad_tbox_tbox, and #nad_stbox_stbox, respectively.
+ * Boxes whose time frame does not intersect the one of the query are not
+ * returned.
+ * @param[in] rtree The RTree to query
+ * @param[in] query The bounding box that serves as query
+ * @param[in] k Number of neighbors to return
+ * @param[out] count Number of ids returned, which is at most `k`
+ * @return Array of ids ordered by increasing distance to the query. On error,
+ * in particular when the query or the boxes of an RTree of temporal or
+ * spatiotemporal boxes do not have a value or spatial dimension, return
+ * `NULL`
+ */
+int64 *
+rtree_knn(const RTree *rtree, const void *query, int k, int *count)
+{
+  assert(rtree); assert(query); assert(count);
+  *count = 0;
+  if (! ensure_positive(k) || ! rtree_knn_has_X(rtree, query))
+    return NULL;
+
+  int64 *ids = palloc(sizeof(int64) * k);
+  if (! rtree->root)
+    return ids;
+  if (! rtree_knn_has_X(rtree, rtree->box))
+  {
+    pfree(ids);
+    return NULL;
+  }
+
+  int nheap = 0, maxheap = KNN_HEAP_STARTING_SIZE;
+  RTreeKnnElem *heap = palloc(sizeof(RTreeKnnElem) * maxheap);
+  RTreeKnnElem elem;
+  elem.dist = 0.0;
+  elem.leaf = false;
+  elem.node = rtree->root;
+  knn_heap_push(&heap, &nheap, &maxheap, &elem);
+  while (nheap > 0 && *count < k)
+  {
+    elem = knn_heap_pop(heap, &nheap);
+    if (elem.leaf)
+    {
+      ids[(*count)++] = elem.id;
+      continue;
+    }
+    const RTreeNode *node = elem.node;
+    for (int i = 0; i < node->count; ++i)
+    {
+      RTreeKnnElem child;
+      child.dist = rtree->bbox_distance(query, RTREE_NODE_BBOX_N(node, i));
+      /* Prune the subtrees that do not intersect the query in time */
+      if (child.dist == DBL_MAX)
+        continue;
+      child.leaf = (node->node_type == RTREE_LEAF);
+      if (child.leaf)
+        child.id = node->ids[i];
+      else
+        child.node = node->nodes[i];
+      knn_heap_push(&heap, &nheap, &maxheap, &child);
+    }
+  }
+  pfree(heap);
+  return ids;
+}
+
 /*****************************************************************************/
@@ -230,7 +230,7 @@ tinstant_make(Datum value, meosType temptype, TimestampTz t)
   if (typbyval)
   {
     /* For base types passed by value */
-    value_size = DOUBLE_PAD(sizeof(Datum));
+    value_size = sizeof(Datum);
     value_from = &value;
   }
   else
@@ -238,12 +238,12 @@ tinstant_make(Datum value, meosType temptype, TimestampTz t)
     /* For base types passed by reference */
     int16 typlen = basetype_length(basetype);
     value_from = DatumGetPointer(value);
-    value_size = (typlen != -1) ? DOUBLE_PAD((unsigned int) typlen) :
-      DOUBLE_PAD(VARSIZE(value_from));
+    value_size = (typlen != -1) ? (unsigned int) typlen : VARSIZE(value_from);
   }
-  size += value_size;
+  size += DOUBLE_PAD(value_size);
   TInstant *result = palloc0(size);
   void *value_to = ((char *) result) + value_offset;
+  /* The padding after the value is set to zero by palloc0 */
   memcpy(value_to, value_from, value_size);
   /* Initialize fixed-size values */
   result->temptype = temptype;
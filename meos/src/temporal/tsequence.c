@@ -50,6 +50,7 @@
 #include <meos_internal.h>
 #include <meos_internal_geo.h>
 #include "temporal/doublen.h"
+#include "temporal/meos_stats.h"
 #include "temporal/postgres_types.h"
 #include "temporal/set.h"
 #include "temporal/span.h"
@@ -349,6 +350,7 @@ tinstarr_normalize(const TInstant **instants, interpType interp, int count,
   int *newcount)
 {
   assert(count > 1);
+  MEOS_STATS_START(start);
   meosType basetype = temptype_basetype(instants[0]->temptype);
   TInstant **result = palloc(sizeof(TInstant *) * count);
   /* Remove redundant instants */
@@ -376,6 +378,7 @@ tinstarr_normalize(const TInstant **instants, interpType interp, int count,
   }
   result[ninsts++] = inst2;
   *newcount = ninsts;
+  MEOS_STATS_END(MEOS_STAT_TINSTARR_NORMALIZE, start);
   return result;
 }
 
@@ -805,6 +808,7 @@ tsequence_make_exp1(const TInstant **instants, int count, int maxcount,
   void *bbox)
 {
   assert(instants); assert(maxcount >= count);
+  MEOS_STATS_START(start);
   /* Normalize the array of instants */
   TInstant **norminsts = (TInstant **) instants;
   int newcount = count;
@@ -873,6 +877,7 @@ tsequence_make_exp1(const TInstant **instants, int count, int maxcount,
   }
   if (interp != DISCRETE && normalize && count > 1)
     pfree(norminsts);
+  MEOS_STATS_END(MEOS_STAT_TSEQUENCE_MAKE, start);
   return result;
 }
 
@@ -1251,9 +1256,9 @@ tsequence_compact(const TSequence *seq)
   /* Copy the instants */
   memcpy(((char *) result) + seqsize, (char *) TSEQUENCE_INST_N(seq, 0),
     insts_size);
-#if DEBUG_EXPAND
+#ifdef DEBUG_EXPAND
   meos_error(WARNING, 0, " Sequence -> %d ", seq->count);
-#endif
+#endif /* DEBUG_EXPAND */
   return result;
 }
 
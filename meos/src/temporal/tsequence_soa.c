@@ -0,0 +1,543 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Structure-of-arrays representation of temporal sequences
+ * @details In this representation, which is available for temporal integers,
+ * temporal floats, and temporal geometry points, the timestamps and the
+ * values of a sequence are kept in separate contiguous arrays of 8-byte
+ * values instead of a sequence of instants. The functions of this file
+ * convert sequences from and to this representation and compute the length,
+ * the speed, and the restriction to a time span directly on the arrays.
+ */
+
+#include "temporal/tsequence_soa.h"
+
+/* C */
+#include <assert.h>
+#include <math.h>
+/* PostgreSQL */
+#include <postgres.h>
+/* PostGIS */
+#include <liblwgeom.h>
+/* MEOS */
+#include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal.h>
+#include <meos_internal_geo.h>
+#include "temporal/span.h"
+#include "temporal/temporal.h"
+#include "temporal/tinstant.h"
+#include "temporal/tsequence.h"
+#include "geo/tgeo_spatialfuncs.h"
+
+/*****************************************************************************
+ * Constructor functions
+ *****************************************************************************/
+
+/**
+ * @brief Return a new structure-of-arrays temporal sequence with space for
+ * a number of instants
+ * @param[in] temptype Temporal type
+ * @param[in] flags Flags
+ * @param[in] count Number of instants
+ * @param[in] srid SRID
+ */
+static TSequenceSoA *
+tsequencesoa_make(meosType temptype, int16 flags, int count, int32_t srid)
+{
+  int ncols = tnumber_type(temptype) ? 1 : (MEOS_FLAGS_GET_Z(flags) ? 3 : 2);
+  size_t size = sizeof(TSequenceSoA) +
+    sizeof(TimestampTz) * count * (1 + ncols);
+  TSequenceSoA *result = palloc(size);
+  result->size = size;
+  result->temptype = temptype;
+  result->flags = flags;
+  result->count = count;
+  result->srid = srid;
+  return result;
+}
+
+/**
+ * @brief Copy a range of instants of a structure-of-arrays temporal sequence
+ * into another one
+ * @param[out] result Result
+ * @param[in] pos Position of the first instant copied in the result
+ * @param[in] soa Structure-of-arrays temporal sequence
+ * @param[in] start Position of the first instant to copy
+ * @param[in] count Number of instants to copy
+ */
+static void
+tsequencesoa_copy_range(TSequenceSoA *result, int pos,
+  const TSequenceSoA *soa, int start, int count)
+{
+  if (count <= 0)
+    return;
+  memcpy(&result->times[pos], &soa->times[start],
+    sizeof(TimestampTz) * count);
+  for (int i = 0; i < TSEQUENCESOA_NCOLS(soa); i++)
+    memcpy(&TSEQUENCESOA_COL(result, i)[pos],
+      &TSEQUENCESOA_COL(soa, i)[start], sizeof(double) * count);
+  return;
+}
+
+/**
+ * @ingroup meos_internal_temporal_constructor
+ * @brief Return the structure-of-arrays representation of a temporal sequence
+ * @param[in] seq Temporal sequence
+ * @return On error return @p NULL
+ * @see #tsequencesoa_to_tsequence()
+ */
+TSequenceSoA *
+tsequence_to_soa(const TSequence *seq)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(seq, NULL);
+  if (seq->temptype != T_TINT && seq->temptype != T_TFLOAT &&
+      seq->temptype != T_TGEOMPOINT)
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_TYPE,
+      "The structure-of-arrays representation is not available for type %s",
+      meostype_name(seq->temptype));
+    return NULL;
+  }
+
+  bool tpoint = (seq->temptype == T_TGEOMPOINT);
+  int32_t srid = tpoint ?
+    tspatial_srid((const Temporal *) seq) : SRID_UNKNOWN;
+  TSequenceSoA *result = tsequencesoa_make(seq->temptype, seq->flags,
+    seq->count, srid);
+  result->period = seq->period;
+  double *col0 = TSEQUENCESOA_COL(result, 0);
+  for (int i = 0; i < seq->count; i++)
+  {
+    const TInstant *inst = TSEQUENCE_INST_N(seq, i);
+    result->times[i] = inst->t;
+    Datum value = tinstant_value_p(inst);
+    if (seq->temptype == T_TINT)
+      col0[i] = (double) DatumGetInt32(value);
+    else if (seq->temptype == T_TFLOAT)
+      col0[i] = DatumGetFloat8(value);
+    else if (MEOS_FLAGS_GET_Z(seq->flags))
+    {
+      const POINT3DZ *pt = DATUM_POINT3DZ_P(value);
+      col0[i] = pt->x;
+      TSEQUENCESOA_COL(result, 1)[i] = pt->y;
+      TSEQUENCESOA_COL(result, 2)[i] = pt->z;
+    }
+    else
+    {
+      const POINT2D *pt = DATUM_POINT2D_P(value);
+      col0[i] = pt->x;
+      TSEQUENCESOA_COL(result, 1)[i] = pt->y;
+    }
+  }
+  return result;
+}
+
+/**
+ * @ingroup meos_internal_temporal_accessor
+ * @brief Return the n-th instant of a structure-of-arrays temporal sequence
+ * @param[in] soa Structure-of-arrays temporal sequence
+ * @param[in] n Position of the instant, starting at 0
+ * @return On error return @p NULL
+ */
+TInstant *
+tsequencesoa_inst_n(const TSequenceSoA *soa, int n)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(soa, NULL);
+  if (n < 0 || n >= soa->count)
+  {
+    meos_error(ERROR, MEOS_ERR_INVALID_ARG_VALUE,
+      "The position of the instant must be between 0 and %d", soa->count - 1);
+    return NULL;
+  }
+
+  double value = TSEQUENCESOA_COL(soa, 0)[n];
+  if (soa->temptype == T_TINT)
+    return tinstant_make(Int32GetDatum((int32) value), T_TINT,
+      soa->times[n]);
+  if (soa->temptype == T_TFLOAT)
+    return tinstant_make(Float8GetDatum(value), T_TFLOAT, soa->times[n]);
+  bool hasz = MEOS_FLAGS_GET_Z(soa->flags);
+  GSERIALIZED *gs = geopoint_make(value, TSEQUENCESOA_COL(soa, 1)[n],
+    hasz ? TSEQUENCESOA_COL(soa, 2)[n] : 0.0, hasz, false, soa->srid);
+  return tinstant_make_free(PointerGetDatum(gs), soa->temptype,
+    soa->times[n]);
+}
+
+/**
+ * @ingroup meos_internal_temporal_constructor
+ * @brief Return a temporal sequence from its structure-of-arrays
+ * representation
+ * @param[in] soa Structure-of-arrays temporal sequence
+ * @see #tsequence_to_soa()
+ */
+TSequence *
+tsequencesoa_to_tsequence(const TSequenceSoA *soa)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(soa, NULL);
+  TInstant **instants = palloc(sizeof(TInstant *) * soa->count);
+  for (int i = 0; i < soa->count; i++)
+    instants[i] = tsequencesoa_inst_n(soa, i);
+  return tsequence_make_free(instants, soa->count, soa->period.lower_inc,
+    soa->period.upper_inc, MEOS_FLAGS_GET_INTERP(soa->flags), NORMALIZE);
+}
+
+/*****************************************************************************
+ * Accessor functions
+ *****************************************************************************/
+
+/**
+ * @ingroup meos_internal_temporal_accessor
+ * @brief Return the size in bytes of a structure-of-arrays temporal sequence
+ * @param[in] soa Structure-of-arrays temporal sequence
+ * @return On error return 0
+ */
+size_t
+tsequencesoa_mem_size(const TSequenceSoA *soa)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(soa, 0);
+  return soa->size;
+}
+
+/**
+ * @ingroup meos_internal_temporal_accessor
+ * @brief Return the number of instants of a structure-of-arrays temporal
+ * sequence
+ * @param[in] soa Structure-of-arrays temporal sequence
+ * @return On error return -1
+ */
+int
+tsequencesoa_num_instants(const TSequenceSoA *soa)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(soa, -1);
+  return soa->count;
+}
+
+/**
+ * @ingroup meos_internal_temporal_accessor
+ * @brief Return the n-th timestamp of a structure-of-arrays temporal sequence
+ * @param[in] soa Structure-of-arrays temporal sequence
+ * @param[in] n Position of the timestamp, starting at 0
+ * @param[out] result Timestamp
+ * @return Return false if the position is out of range
+ */
+bool
+tsequencesoa_timestamptz_n(const TSequenceSoA *soa, int n,
+  TimestampTz *result)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(soa, false); VALIDATE_NOT_NULL(result, false);
+  if (n < 0 || n >= soa->count)
+    return false;
+  *result = soa->times[n];
+  return true;
+}
+
+/*****************************************************************************
+ * Restriction functions
+ *****************************************************************************/
+
+/**
+ * @brief Return the position of the first timestamp of a structure-of-arrays
+ * temporal sequence that is greater than or equal to a timestamp, or the
+ * number of instants if there is none
+ */
+static int
+tsequencesoa_find_timestamptz(const TSequenceSoA *soa, TimestampTz t)
+{
+  int first = 0, last = soa->count;
+  while (first < last)
+  {
+    int middle = first + (last - first) / 2;
+    if (soa->times[middle] < t)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  return first;
+}
+
+/**
+ * @brief Write in the n-th position of the result the values of the segment
+ * of a structure-of-arrays temporal sequence starting at an instant at a
+ * timestamp
+ * @param[in] soa Structure-of-arrays temporal sequence
+ * @param[in] i Position of the start instant of the segment
+ * @param[in] t Timestamp
+ * @param[in] interp Interpolation
+ * @param[out] result Result
+ * @param[in] n Position of the values in the result
+ * @note The function mimics #tsegment_at_timestamptz()
+ */
+static void
+tsequencesoa_segment_at(const TSequenceSoA *soa, int i, TimestampTz t,
+  interpType interp, TSequenceSoA *result, int n)
+{
+  TimestampTz t1 = soa->times[i];
+  int ncols = TSEQUENCESOA_NCOLS(soa);
+  result->times[n] = t;
+  if (t1 == t || (interp != LINEAR && t < soa->times[i + 1]))
+  {
+    for (int j = 0; j < ncols; j++)
+      TSEQUENCESOA_COL(result, j)[n] = TSEQUENCESOA_COL(soa, j)[i];
+    return;
+  }
+  TimestampTz t2 = soa->times[i + 1];
+  if (t == t2)
+  {
+    for (int j = 0; j < ncols; j++)
+      TSEQUENCESOA_COL(result, j)[n] = TSEQUENCESOA_COL(soa, j)[i + 1];
+    return;
+  }
+  long double ratio = (long double) (t - t1) / (long double) (t2 - t1);
+  for (int j = 0; j < ncols; j++)
+  {
+    const double *col = TSEQUENCESOA_COL(soa, j);
+    TSEQUENCESOA_COL(result, j)[n] = floatsegm_interpolate(col[i],
+      col[i + 1], ratio);
+  }
+  return;
+}
+
+/**
+ * @ingroup meos_internal_temporal_restrict
+ * @brief Return a structure-of-arrays temporal sequence restricted to a
+ * timestamptz span
+ * @details The instants inside the span are found by binary search and
+ * copied with one copy per array, and only the values at the bounds of the
+ * span are interpolated.
+ * @param[in] soa Structure-of-arrays temporal sequence
+ * @param[in] s Span
+ * @note The function mimics #tcontseq_at_tstzspan() and
+ * #tdiscseq_at_tstzspan()
+ */
+TSequenceSoA *
+tsequencesoa_at_tstzspan(const TSequenceSoA *soa, const Span *s)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(soa, NULL); VALIDATE_TSTZSPAN(s, NULL);
+
+  /* Bounding box test */
+  Span inter;
+  if (! inter_span_span(&soa->period, s, &inter))
+    return NULL;
+
+  TSequenceSoA *result;
+  interpType interp = MEOS_FLAGS_GET_INTERP(soa->flags);
+  TimestampTz lower = DatumGetTimestampTz(inter.lower);
+  TimestampTz upper = DatumGetTimestampTz(inter.upper);
+  if (interp == DISCRETE)
+  {
+    int first = tsequencesoa_find_timestamptz(soa, lower);
+    if (first < soa->count && soa->times[first] == lower && ! inter.lower_inc)
+      first++;
+    int last = tsequencesoa_find_timestamptz(soa, upper);
+    if (last < soa->count && soa->times[last] == upper && inter.upper_inc)
+      last++;
+    if (first >= last)
+      return NULL;
+    result = tsequencesoa_make(soa->temptype, soa->flags, last - first,
+      soa->srid);
+    tsequencesoa_copy_range(result, 0, soa, first, last - first);
+    span_set(TimestampTzGetDatum(result->times[0]),
+      TimestampTzGetDatum(result->times[result->count - 1]), true, true,
+      T_TIMESTAMPTZ, T_TSTZSPAN, &result->period);
+    return result;
+  }
+
+  /* Instantaneous sequence */
+  if (soa->count == 1)
+  {
+    result = palloc(soa->size);
+    memcpy(result, soa, soa->size);
+    return result;
+  }
+
+  /* Intersecting period is instantaneous */
+  int n = tsequencesoa_find_timestamptz(soa, lower);
+  if (soa->times[n] != lower)
+    n--;
+  if (lower == upper)
+  {
+    result = tsequencesoa_make(soa->temptype, soa->flags, 1, soa->srid);
+    if (n == soa->count - 1)
+      tsequencesoa_copy_range(result, 0, soa, n, 1);
+    else
+      tsequencesoa_segment_at(soa, n, lower, interp, result, 0);
+    result->period = inter;
+    return result;
+  }
+
+  /* General case: the segment n contains the lower bound and the segment
+   * ending at m contains the upper bound */
+  int m = tsequencesoa_find_timestamptz(soa, upper);
+  int count = m - n + 1;
+  result = tsequencesoa_make(soa->temptype, soa->flags, count, soa->srid);
+  tsequencesoa_segment_at(soa, n, lower, interp, result, 0);
+  tsequencesoa_copy_range(result, 1, soa, n + 1, m - n - 1);
+  /* The last two values of sequences with step interpolation and
+   * exclusive upper bound must be equal */
+  if (interp == LINEAR || inter.upper_inc)
+    tsequencesoa_segment_at(soa, m - 1, upper, interp, result, count - 1);
+  else
+  {
+    result->times[count - 1] = upper;
+    for (int j = 0; j < TSEQUENCESOA_NCOLS(soa); j++)
+      TSEQUENCESOA_COL(result, j)[count - 1] =
+        TSEQUENCESOA_COL(result, j)[count - 2];
+  }
+  result->period = inter;
+  return result;
+}
+
+/*****************************************************************************
+ * Spatial functions
+ *****************************************************************************/
+
+/**
+ * @brief Ensure that a structure-of-arrays temporal sequence is a temporal
+ * point
+ */
+static bool
+ensure_tpointseqsoa(const TSequenceSoA *soa)
+{
+  if (soa->temptype == T_TGEOMPOINT)
+    return true;
+  meos_error(ERROR, MEOS_ERR_INVALID_ARG_TYPE,
+    "The structure-of-arrays temporal sequence must be of type %s",
+    meostype_name(T_TGEOMPOINT));
+  return false;
+}
+
+/**
+ * @ingroup meos_internal_geo_accessor
+ * @brief Return the length traversed by a structure-of-arrays temporal point
+ * sequence
+ * @param[in] soa Structure-of-arrays temporal sequence
+ * @return On error return -1.0
+ * @note The function mimics #tpointseq_length()
+ */
+double
+tpointseqsoa_length(const TSequenceSoA *soa)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(soa, -1.0);
+  if (! ensure_tpointseqsoa(soa))
+    return -1.0;
+  if (! MEOS_FLAGS_LINEAR_INTERP(soa->flags))
+    return 0.0;
+
+  const double *x = TSEQUENCESOA_COL(soa, 0);
+  const double *y = TSEQUENCESOA_COL(soa, 1);
+  double result = 0.0;
+  if (MEOS_FLAGS_GET_Z(soa->flags))
+  {
+    const double *z = TSEQUENCESOA_COL(soa, 2);
+    for (int i = 1; i < soa->count; i++)
+      result += sqrt((x[i - 1] - x[i]) * (x[i - 1] - x[i]) +
+        (y[i - 1] - y[i]) * (y[i - 1] - y[i]) +
+        (z[i - 1] - z[i]) * (z[i - 1] - z[i]));
+  }
+  else
+  {
+    for (int i = 1; i < soa->count; i++)
+      result += sqrt((x[i - 1] - x[i]) * (x[i - 1] - x[i]) +
+        (y[i - 1] - y[i]) * (y[i - 1] - y[i]));
+  }
+  return result;
+}
+
+/**
+ * @ingroup meos_internal_geo_accessor
+ * @brief Return the speed of a structure-of-arrays temporal point sequence
+ * as a structure-of-arrays temporal float sequence with step interpolation
+ * @param[in] soa Structure-of-arrays temporal sequence
+ * @return On error or if the sequence is instantaneous return @p NULL
+ * @note The function mimics #tsequence_derivative(), in particular, the
+ * consecutive segments with equal speed are merged
+ */
+TSequenceSoA *
+tpointseqsoa_speed(const TSequenceSoA *soa)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(soa, NULL);
+  if (! ensure_tpointseqsoa(soa) || ! ensure_linear_interp(soa->flags))
+    return NULL;
+  if (soa->count == 1)
+    return NULL;
+
+  int16 flags = 0;
+  MEOS_FLAGS_SET_BYVAL(flags, true);
+  MEOS_FLAGS_SET_CONTINUOUS(flags, true);
+  MEOS_FLAGS_SET_INTERP(flags, STEP);
+  MEOS_FLAGS_SET_X(flags, true);
+  MEOS_FLAGS_SET_T(flags, true);
+  TSequenceSoA *result = tsequencesoa_make(T_TFLOAT, flags, soa->count,
+    SRID_UNKNOWN);
+  const double *x = TSEQUENCESOA_COL(soa, 0);
+  const double *y = TSEQUENCESOA_COL(soa, 1);
+  const double *z = MEOS_FLAGS_GET_Z(soa->flags) ?
+    TSEQUENCESOA_COL(soa, 2) : NULL;
+  double *speed = TSEQUENCESOA_COL(result, 0);
+  int count = 0;
+  double value = 0.0;
+  for (int i = 0; i < soa->count - 1; i++)
+  {
+    /* Same computation as in distance2d_pt_pt and distance3d_pt_pt */
+    double dx = x[i + 1] - x[i], dy = y[i + 1] - y[i];
+    double dist = z ? sqrt(dx * dx + dy * dy +
+      (z[i + 1] - z[i]) * (z[i + 1] - z[i])) : hypot(dx, dy);
+    value = dist / ((double) (soa->times[i + 1] - soa->times[i]) / 1000000);
+    /* Merge consecutive segments with equal speed */
+    if (count > 0 && speed[count - 1] == value)
+      continue;
+    result->times[count] = soa->times[i];
+    speed[count++] = value;
+  }
+  result->times[count] = soa->times[soa->count - 1];
+  speed[count++] = value;
+  /* The values were written after the space for all the timestamps */
+  if (count < soa->count)
+  {
+    memmove(result->times + count, speed, sizeof(double) * count);
+    result->count = count;
+    result->size = sizeof(TSequenceSoA) + sizeof(TimestampTz) * count * 2;
+  }
+  result->period = soa->period;
+  return result;
+}
+
+/*****************************************************************************/
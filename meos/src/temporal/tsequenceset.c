@@ -45,6 +45,7 @@
 /* MEOS */
 #include <meos.h>
 #include <meos_internal.h>
+#include "temporal/meos_stats.h"
 #include "temporal/postgres_types.h"
 #include "temporal/span.h"
 #include "temporal/spanset.h"
@@ -133,6 +134,7 @@ TSequence **
 tseqarr_normalize(const TSequence **sequences, int count, int *newcount)
 {
   assert(sequences); assert(newcount); assert(count > 0);
+  MEOS_STATS_START(start);
   TSequence **result = palloc(sizeof(TSequence *) * count);
   /* seq1 is the sequence to which we try to join subsequent seq2 */
   TSequence *seq1 = (TSequence *) sequences[0];
@@ -160,6 +162,7 @@ tseqarr_normalize(const TSequence **sequences, int count, int *newcount)
   }
   result[nseqs++] = isnew ? seq1 : tsequence_copy(seq1);
   *newcount = nseqs;
+  MEOS_STATS_END(MEOS_STAT_TSEQARR_NORMALIZE, start);
   return result;
 }
 
@@ -318,6 +321,7 @@ tsequenceset_make_exp(const TSequence **sequences, int count, int maxcount,
   if (! ensure_valid_tseqarr(sequences, count))
     return NULL;
 
+  MEOS_STATS_START(start);
   /* Normalize the array of sequences */
   TSequence **normseqs = (TSequence **) sequences;
   int newcount = count;
@@ -388,6 +392,7 @@ tsequenceset_make_exp(const TSequence **sequences, int count, int maxcount,
   }
   if (normalize && count > 1)
     pfree_array((void **) normseqs, newcount);
+  MEOS_STATS_END(MEOS_STAT_TSEQUENCESET_MAKE, start);
   return result;
 }
 
@@ -1385,9 +1390,9 @@ tsequenceset_compact(const TSequenceSet *ss)
       memcpy(((char *) result) + pdata_ss + pos + pdata_seq,
         ((char *) seq) + seqheader + sizeof(size_t) * seq->maxcount,
         insts_size[i]);
-#if DEBUG_EXPAND
+#ifdef DEBUG_EXPAND
       meos_error(WARNING, 0, " Sequence -> %d ", seq->count);
-#endif
+#endif /* DEBUG_EXPAND */
     }
     /* Set the offset */
     (TSEQUENCESET_OFFSETS_PTR(result))[i] = pos;
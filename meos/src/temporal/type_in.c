@@ -47,6 +47,8 @@
 #include "temporal/set.h"
 #include "temporal/span.h"
 #include "temporal/tbox.h"
+#include "temporal/tinstant.h"
+#include "temporal/type_util.h"
 #include "geo/postgis_funcs.h"
 #include "geo/stbox.h"
 #include "geo/tgeo_spatialfuncs.h"
@@ -1954,19 +1956,107 @@ tinstant_from_wkb_state(meos_wkb_parse_state *s)
 }
 
 /**
- * @brief Return a temporal instant array from its WKB representation
+ * @brief Return a temporal sequence from the instants of its WKB
+ * representation
+ * @details The instants of base types passed by value and of temporal points
+ * whose points are in the machine byte order have all the same size. In that
+ * case the first instant is created as usual and is then used as a template
+ * for the remaining ones, which are stored consecutively in a single buffer
+ * by only replacing their value and their timestamp. This avoids allocating
+ * every instant and, for temporal points, parsing every point with liblwgeom
+ * and serializing it.
  */
-static TInstant **
-tinstarr_from_wkb_state(meos_wkb_parse_state *s, int count)
+static TSequence *
+tsequence_from_wkb_state_iter(meos_wkb_parse_state *s, int count,
+  bool lower_inc, bool upper_inc)
 {
-  TInstant **result = palloc(sizeof(TInstant *) * count);
-  for (int i = 0; i < count; i++)
+  /* Parse the first instant */
+  const uint8_t *first = s->pos;
+  TInstant *inst = tinstant_from_wkb_state(s);
+  if (! inst)
+    return NULL;
+  bool fixed = basetype_byvalue(s->basetype);
+  size_t hdrsize = 0, coordsize = 0;
+  if (tpoint_type(s->temptype))
+  {
+    const GSERIALIZED *gs = DatumGetGserializedP(tinstant_value_p(inst));
+    coordsize = FLAGS_NDIMS(gs->gflags) * MEOS_WKB_DOUBLE_SIZE;
+    hdrsize = (s->pos - first) - coordsize - MEOS_WKB_TIMESTAMP_SIZE;
+    fixed = ! FLAGS_GET_BBOX(gs->gflags) &&
+      first[0] == (MEOS_IS_BIG_ENDIAN ? 0 : 1);
+  }
+  const TInstant **instants = palloc(sizeof(TInstant *) * count);
+  TSequence *result;
+  if (! fixed)
+  {
+    instants[0] = inst;
+    for (int i = 1; i < count; i++)
+    {
+      /* Parse the value and the timestamp to create the temporal instant */
+      instants[i] = tinstant_from_wkb_state(s);
+      if (! instants[i])
+      {
+        pfree_array((void **) instants, i);
+        return NULL;
+      }
+    }
+    return tsequence_make_free((TInstant **) instants, count, lower_inc,
+      upper_inc, s->interp, NORMALIZE);
+  }
+
+  /* Store the instants consecutively using the first one as template */
+  size_t size = VARSIZE(inst), instsize = DOUBLE_PAD(size);
+  char *buf = palloc(instsize * count);
+  memcpy(buf, inst, size);
+  pfree(inst);
+  instants[0] = (TInstant *) buf;
+  for (int i = 1; i < count; i++)
   {
-    /* Parse the point and the timestamp to create the instant point */
-    Datum value = base_from_wkb_state(s);
-    TimestampTz t = timestamp_from_wkb_state(s);
-    result[i] = tinstant_make_free(value, s->temptype, t);
+    TInstant *inst1 = (TInstant *) (buf + instsize * i);
+    memcpy(inst1, instants[0], size);
+    if (hdrsize)
+    {
+      /* Copy the coordinates if the point has the same header as the first
+       * one and it is not empty, otherwise parse it with liblwgeom */
+      wkb_parse_state_check(s, hdrsize + coordsize);
+      double *coords = (double *) GS_POINT_PTR(
+        DatumGetGserializedP(tinstant_value_p(inst1)));
+      memcpy(coords, s->pos + hdrsize, coordsize);
+      if (memcmp(s->pos, first, hdrsize) == 0 && ! isnan(coords[0]))
+      {
+        s->pos += hdrsize + coordsize;
+        inst1->t = timestamp_from_wkb_state(s);
+      }
+      else
+      {
+        inst = tinstant_from_wkb_state(s);
+        if (! inst)
+        {
+          pfree(buf); pfree(instants);
+          return NULL;
+        }
+        if (VARSIZE(inst) != size)
+        {
+          meos_error(ERROR, MEOS_ERR_WKB_INPUT,
+            "The points of a temporal point must have the same dimensionality");
+          pfree(inst); pfree(buf); pfree(instants);
+          return NULL;
+        }
+        memcpy(inst1, inst, size);
+        pfree(inst);
+      }
+    }
+    else
+    {
+      Datum value = base_from_wkb_state(s);
+      TimestampTz t = timestamp_from_wkb_state(s);
+      tinstant_set(inst1, value, t);
+    }
+    instants[i] = inst1;
   }
+  result = tsequence_make(instants, count, lower_inc, upper_inc, s->interp,
+    NORMALIZE);
+  pfree(buf); pfree(instants);
   return result;
 }
 
@@ -1984,9 +2074,7 @@ tsequence_from_wkb_state(meos_wkb_parse_state *s)
   bool lower_inc, upper_inc;
   bounds_from_wkb_state(wkb_bounds, &lower_inc, &upper_inc);
   /* Parse the instants */
-  TInstant **instants = tinstarr_from_wkb_state(s, count);
-  return tsequence_make_free(instants, count, lower_inc, upper_inc, s->interp,
-    NORMALIZE);
+  return tsequence_from_wkb_state_iter(s, count, lower_inc, upper_inc);
 }
 
 /**
@@ -2009,16 +2097,8 @@ tsequenceset_from_wkb_state(meos_wkb_parse_state *s)
     bool lower_inc, upper_inc;
     bounds_from_wkb_state(wkb_bounds, &lower_inc, &upper_inc);
     /* Parse the instants */
-    TInstant **instants = palloc(sizeof(TInstant *) * ninst);
-    for (int j = 0; j < ninst; j++)
-    {
-      /* Parse the value and the timestamp to create the temporal instant */
-      Datum value = base_from_wkb_state(s);
-      TimestampTz t = timestamp_from_wkb_state(s);
-      instants[j] = tinstant_make_free(value, s->temptype, t);
-    }
-    sequences[i] = tsequence_make_free(instants, ninst, lower_inc, upper_inc,
-      s->interp, NORMALIZE);
+    sequences[i] = tsequence_from_wkb_state_iter(s, ninst, lower_inc,
+      upper_inc);
   }
   return tsequenceset_make_free(sequences, count, NORMALIZE);
 }
@@ -39,13 +39,20 @@
 /* PostgreSQL */
 #include <postgres.h>
 #include "utils/timestamp.h"
+/* PostGIS */
+#include <liblwgeom.h>
 /* MEOS */
 #include <meos.h>
+#include <meos_geo.h>
 #include <meos_internal.h>
+#include <meos_internal_geo.h>
 #include "temporal/postgres_types.h"
 #include "temporal/set.h"
 #include "temporal/span.h"
 #include "temporal/tbox.h"
+#include "temporal/tinstant.h"
+#include "temporal/type_util.h"
+#include "geo/tgeo_spatialfuncs.h"
 
 /*****************************************************************************
  * Input in MF-JSON representation
@@ -258,3 +265,1140 @@ ttext_from_mfjson(const char *mfjson)
 }
 
 /*****************************************************************************/
+/*****************************************************************************
+ * Incremental input in MF-JSON representation
+ *
+ * The parser below reads the MF-JSON representation of a temporal value,
+ * which may be given in several chunks, without building a json-c object
+ * tree. Only the members needed for building the temporal value are
+ * interpreted, all the other ones such as the bounding box are skipped. The
+ * coordinates, values, and timestamps are accumulated in compact arrays from
+ * which the instants are built once the whole document has been read, since
+ * the interpolation comes after the values in the MF-JSON documents output by
+ * #temporal_as_mfjson. The parser supports temporal alphanumeric types and
+ * temporal points. Since the values are interpreted when they are read, the
+ * temporal type must be known, either given as argument or read from the
+ * `type` member, before reading the values.
+ *****************************************************************************/
+
+/** Maximum nesting depth of an MF-JSON document */
+#define MFJSON_MAX_DEPTH 64
+/** Initial number of elements of the arrays of the parser */
+#define MFJSON_INITIAL_SIZE 64
+
+/**
+ * @brief Enumeration that defines the meaning of a JSON value in an MF-JSON
+ * document
+ */
+typedef enum
+{
+  MFJSON_SKIP,          /**< Value that is not interpreted */
+  MFJSON_ROOT,          /**< Top-level object */
+  MFJSON_TYPE,          /**< Member `type` */
+  MFJSON_INTERP,        /**< Member `interpolation` */
+  MFJSON_CRS,           /**< Member `crs` */
+  MFJSON_CRS_PROPS,     /**< Member `properties` of the `crs` */
+  MFJSON_CRS_NAME,      /**< Member `name` of the properties of the `crs` */
+  MFJSON_SEQUENCES,     /**< Member `sequences` */
+  MFJSON_SEQUENCE,      /**< Element of the `sequences` array */
+  MFJSON_COORDINATES,   /**< Member `coordinates` */
+  MFJSON_COORD,         /**< Element of the `coordinates` array */
+  MFJSON_COORD_NUMBER,  /**< Number in an element of the `coordinates` array */
+  MFJSON_VALUES,        /**< Member `values` */
+  MFJSON_VALUE,         /**< Element of the `values` array */
+  MFJSON_DATETIMES,     /**< Member `datetimes` */
+  MFJSON_DATETIME,      /**< Element of the `datetimes` array */
+  MFJSON_LOWER_INC,     /**< Member `lower_inc` */
+  MFJSON_UPPER_INC,     /**< Member `upper_inc` */
+} mfjsonContext;
+
+/**
+ * @brief Enumeration that defines what the parser expects next in a JSON
+ * object or array
+ */
+typedef enum
+{
+  MFJSON_EXPECT_KEY_OR_END,    /**< After the opening brace */
+  MFJSON_EXPECT_KEY,           /**< After a comma in an object */
+  MFJSON_EXPECT_COLON,         /**< After a key */
+  MFJSON_EXPECT_VALUE_OR_END,  /**< After the opening bracket */
+  MFJSON_EXPECT_VALUE,         /**< After a colon or a comma in an array */
+  MFJSON_EXPECT_COMMA_OR_END,  /**< After a value */
+} mfjsonExpect;
+
+/**
+ * @brief Enumeration that defines the state of the lexer
+ */
+typedef enum
+{
+  MFJSON_LEX_NONE,      /**< Between tokens */
+  MFJSON_LEX_STRING,    /**< Inside a string */
+  MFJSON_LEX_ESCAPE,    /**< After a backslash inside a string */
+  MFJSON_LEX_UNICODE,   /**< Inside a \\uXXXX escape sequence */
+  MFJSON_LEX_SCALAR,    /**< Inside a number or a literal */
+} mfjsonLex;
+
+/**
+ * @brief Structure to represent a JSON object or array being parsed
+ */
+typedef struct
+{
+  bool isobject;        /**< True for an object, false for an array */
+  uint8 context;        /**< Meaning of the object or array */
+  uint8 expect;         /**< What is expected next */
+  uint8 keycontext;     /**< Meaning of the value of the current member */
+} MfjsonFrame;
+
+/**
+ * @brief Structure to represent the values and timestamps of a sequence
+ * being parsed
+ */
+typedef struct
+{
+  int vstart;           /**< Position of the first value */
+  int vcount;           /**< Number of values */
+  int tstart;           /**< Position of the first timestamp */
+  int tcount;           /**< Number of timestamps */
+  bool hasvalues;       /**< True when the values were read */
+  bool hastimes;        /**< True when the timestamps were read */
+  bool lower_inc;       /**< Lower bound */
+  bool upper_inc;       /**< Upper bound */
+} MfjsonSeq;
+
+/**
+ * @brief Structure to represent the state of an incremental MF-JSON parser
+ */
+struct MfjsonParser
+{
+  meosType expected;    /**< Temporal type given as argument, if any */
+  meosType temptype;    /**< Temporal type, the expected one until read */
+  bool hastype;         /**< True when the `type` member was read */
+  bool hasinterp;       /**< True when the `interpolation` member was read */
+  interpType interp;    /**< Interpolation, `INTERP_NONE` for instants */
+  bool hasseqs;         /**< True when the `sequences` member was read */
+  int32_t srid;         /**< SRID */
+  bool hassrid;         /**< True when the SRID was read */
+  bool error;           /**< True when an error was found */
+  bool done;            /**< True when the top-level object was read */
+  /* Lexer */
+  uint8 lexstate;       /**< State of the lexer */
+  char *tok;            /**< Characters of the current token */
+  size_t toklen;        /**< Number of characters of the current token */
+  size_t tokmax;        /**< Size of the token buffer */
+  int nhex;             /**< Number of hexadecimal digits read in \\uXXXX */
+  uint32 code;          /**< Code point read in \\uXXXX */
+  uint32 highsurr;      /**< Pending high surrogate of a UTF-16 pair */
+  /* Stack of objects and arrays */
+  MfjsonFrame stack[MFJSON_MAX_DEPTH];
+  int depth;            /**< Number of frames in the stack */
+  /* Point being read */
+  double coord[3];      /**< Coordinates of the point being read */
+  int ncoord;           /**< Number of coordinates of the point being read */
+  int ndims;            /**< Number of coordinates of all points, 0 if unknown */
+  /* Values and timestamps */
+  double *coords;       /**< Coordinates of the points, 3 per point */
+  Datum *values;        /**< Values of the alphanumeric types */
+  int nvalues;          /**< Number of values or points */
+  int maxvalues;        /**< Number of elements of the arrays of values */
+  TimestampTz *times;   /**< Timestamps */
+  int ntimes;           /**< Number of timestamps */
+  int maxtimes;         /**< Number of elements of the array of timestamps */
+  /* Sequences */
+  MfjsonSeq root;       /**< Values and timestamps of the top-level object */
+  MfjsonSeq *seqs;      /**< Values and timestamps of the sequences */
+  int nseqs;            /**< Number of sequences */
+  int maxseqs;          /**< Number of elements of the array of sequences */
+  int curseq;           /**< Current sequence, -1 for the top-level object */
+};
+
+/**
+ * @brief Return the name of the member corresponding to a context for
+ * error messages
+ */
+static const char *
+mfjson_context_name(mfjsonContext context)
+{
+  switch (context)
+  {
+    case MFJSON_TYPE: return "type";
+    case MFJSON_INTERP: return "interpolation";
+    case MFJSON_SEQUENCES: case MFJSON_SEQUENCE: return "sequences";
+    case MFJSON_COORDINATES: case MFJSON_COORD: case MFJSON_COORD_NUMBER:
+      return "coordinates";
+    case MFJSON_VALUES: case MFJSON_VALUE: return "values";
+    case MFJSON_DATETIMES: case MFJSON_DATETIME: return "datetimes";
+    case MFJSON_LOWER_INC: return "lower_inc";
+    case MFJSON_UPPER_INC: return "upper_inc";
+    default: return "MFJSON";
+  }
+}
+
+/**
+ * @brief Set the error state of the parser and return false
+ */
+static bool
+mfjson_parser_fail(MfjsonParser *parser, const char *msg, mfjsonContext ctx)
+{
+  parser->error = true;
+  meos_error(ERROR, MEOS_ERR_MFJSON_INPUT, msg, mfjson_context_name(ctx));
+  return false;
+}
+
+/**
+ * @ingroup meos_internal_temporal_inout
+ * @brief Return a new incremental parser of the MF-JSON representation of a
+ * temporal value
+ * @param[in] temptype Expected temporal type, `T_UNKNOWN` if it is read from
+ * the input
+ * @see #mfjson_parser_feed()
+ * @see #mfjson_parser_end()
+ */
+MfjsonParser *
+mfjson_parser_make(meosType temptype)
+{
+  MfjsonParser *result = palloc0(sizeof(MfjsonParser));
+  result->expected = temptype;
+  result->temptype = temptype;
+  result->tokmax = MFJSON_INITIAL_SIZE;
+  result->tok = palloc(result->tokmax);
+  result->root.lower_inc = result->root.upper_inc = true;
+  result->curseq = -1;
+  return result;
+}
+
+/**
+ * @ingroup meos_internal_temporal_inout
+ * @brief Free an incremental MF-JSON parser
+ * @param[in] parser Parser
+ */
+void
+mfjson_parser_free(MfjsonParser *parser)
+{
+  if (! parser)
+    return;
+  if (parser->values && parser->temptype == T_TTEXT)
+  {
+    for (int i = 0; i < parser->nvalues; i++)
+      pfree(DatumGetPointer(parser->values[i]));
+  }
+  if (parser->values)
+    pfree(parser->values);
+  if (parser->coords)
+    pfree(parser->coords);
+  if (parser->times)
+    pfree(parser->times);
+  if (parser->seqs)
+    pfree(parser->seqs);
+  pfree(parser->tok);
+  pfree(parser);
+  return;
+}
+
+/**
+ * @brief Return the sequence to which the values being read belong
+ */
+static inline MfjsonSeq *
+mfjson_parser_seq(MfjsonParser *parser)
+{
+  return (parser->curseq < 0) ? &parser->root : &parser->seqs[parser->curseq];
+}
+
+/**
+ * @brief Append a character to the current token
+ */
+static inline void
+mfjson_parser_tokchar(MfjsonParser *parser, char c)
+{
+  if (parser->toklen + 1 >= parser->tokmax)
+  {
+    parser->tokmax *= 2;
+    parser->tok = repalloc(parser->tok, parser->tokmax);
+  }
+  parser->tok[parser->toklen++] = c;
+  return;
+}
+
+/**
+ * @brief Append a code point encoded in UTF-8 to the current token
+ */
+static void
+mfjson_parser_tokcode(MfjsonParser *parser, uint32 code)
+{
+  if (code < 0x80)
+    mfjson_parser_tokchar(parser, (char) code);
+  else if (code < 0x800)
+  {
+    mfjson_parser_tokchar(parser, (char) (0xC0 | (code >> 6)));
+    mfjson_parser_tokchar(parser, (char) (0x80 | (code & 0x3F)));
+  }
+  else if (code < 0x10000)
+  {
+    mfjson_parser_tokchar(parser, (char) (0xE0 | (code >> 12)));
+    mfjson_parser_tokchar(parser, (char) (0x80 | ((code >> 6) & 0x3F)));
+    mfjson_parser_tokchar(parser, (char) (0x80 | (code & 0x3F)));
+  }
+  else
+  {
+    mfjson_parser_tokchar(parser, (char) (0xF0 | (code >> 18)));
+    mfjson_parser_tokchar(parser, (char) (0x80 | ((code >> 12) & 0x3F)));
+    mfjson_parser_tokchar(parser, (char) (0x80 | ((code >> 6) & 0x3F)));
+    mfjson_parser_tokchar(parser, (char) (0x80 | (code & 0x3F)));
+  }
+  return;
+}
+
+/**
+ * @brief Set the temporal type of the parser from the `type` member
+ */
+static bool
+mfjson_parser_set_type(MfjsonParser *parser, const char *typestr)
+{
+  meosType temptype;
+  if (pg_strcasecmp(typestr, "MovingBoolean") == 0)
+    temptype = T_TBOOL;
+  else if (pg_strcasecmp(typestr, "MovingInteger") == 0)
+    temptype = T_TINT;
+  else if (pg_strcasecmp(typestr, "MovingFloat") == 0)
+    temptype = T_TFLOAT;
+  else if (pg_strcasecmp(typestr, "MovingText") == 0)
+    temptype = T_TTEXT;
+  else if (pg_strcasecmp(typestr, "MovingPoint") == 0)
+    temptype = (parser->expected == T_TGEOGPOINT) ?
+      T_TGEOGPOINT : T_TGEOMPOINT;
+  else
+  {
+    parser->error = true;
+    meos_error(ERROR, MEOS_ERR_MFJSON_INPUT,
+      "Invalid or unsupported 'type' value in MFJSON string: %s", typestr);
+    return false;
+  }
+  if (parser->expected != T_UNKNOWN && temptype != parser->expected)
+  {
+    parser->error = true;
+    meos_error(ERROR, MEOS_ERR_MFJSON_INPUT,
+      "Invalid 'type' value in MFJSON string, expected: %s, received: %s",
+      meostype_name(parser->expected), meostype_name(temptype));
+    return false;
+  }
+  parser->temptype = temptype;
+  parser->hastype = true;
+  return true;
+}
+
+/**
+ * @brief Return the context of the value of a member from its key
+ */
+static mfjsonContext
+mfjson_key_context(MfjsonParser *parser, mfjsonContext context,
+  const char *key)
+{
+  if (context == MFJSON_ROOT)
+  {
+    if (pg_strcasecmp(key, "type") == 0)
+      return MFJSON_TYPE;
+    if (pg_strcasecmp(key, "interpolation") == 0)
+      return MFJSON_INTERP;
+    if (pg_strcasecmp(key, "crs") == 0)
+      return MFJSON_CRS;
+    if (pg_strcasecmp(key, "sequences") == 0)
+      return MFJSON_SEQUENCES;
+  }
+  else if (context == MFJSON_CRS)
+    return (pg_strcasecmp(key, "properties") == 0) ?
+      MFJSON_CRS_PROPS : MFJSON_SKIP;
+  else if (context == MFJSON_CRS_PROPS)
+    return (pg_strcasecmp(key, "name") == 0) ? MFJSON_CRS_NAME : MFJSON_SKIP;
+  else if (context != MFJSON_SEQUENCE)
+    return MFJSON_SKIP;
+
+  /* Members of the top-level object or of a sequence */
+  if (pg_strcasecmp(key, "datetimes") == 0)
+    return MFJSON_DATETIMES;
+  if (pg_strcasecmp(key, "lower_inc") == 0)
+    return MFJSON_LOWER_INC;
+  if (pg_strcasecmp(key, "upper_inc") == 0)
+    return MFJSON_UPPER_INC;
+  bool coords = (pg_strcasecmp(key, "coordinates") == 0);
+  bool values = (pg_strcasecmp(key, "values") == 0);
+  if (! coords && ! values)
+    return MFJSON_SKIP;
+  /* The temporal type determines which of the two members is read */
+  if (parser->temptype == T_UNKNOWN)
+  {
+    mfjson_parser_fail(parser, "The 'type' member must precede the '%s' "
+      "member for the incremental parsing of an MFJSON string",
+      coords ? MFJSON_COORDINATES : MFJSON_VALUES);
+    return MFJSON_SKIP;
+  }
+  if (tpoint_type(parser->temptype))
+    return coords ? MFJSON_COORDINATES : MFJSON_SKIP;
+  return values ? MFJSON_VALUES : MFJSON_SKIP;
+}
+
+/**
+ * @brief Return the context of the next value to be read
+ */
+static mfjsonContext
+mfjson_value_context(MfjsonParser *parser)
+{
+  if (parser->depth == 0)
+    return MFJSON_ROOT;
+  MfjsonFrame *frame = &parser->stack[parser->depth - 1];
+  if (frame->isobject)
+    return frame->keycontext;
+  switch (frame->context)
+  {
+    case MFJSON_SEQUENCES: return MFJSON_SEQUENCE;
+    case MFJSON_COORDINATES: return MFJSON_COORD;
+    case MFJSON_COORD: return MFJSON_COORD_NUMBER;
+    case MFJSON_VALUES: return MFJSON_VALUE;
+    case MFJSON_DATETIMES: return MFJSON_DATETIME;
+    default: return MFJSON_SKIP;
+  }
+}
+
+/**
+ * @brief Ensure that the parser expects a value and mark it as read in the
+ * enclosing object or array
+ */
+static bool
+mfjson_parser_value_read(MfjsonParser *parser)
+{
+  if (parser->done)
+    return mfjson_parser_fail(parser,
+      "Unexpected characters after the end of the %s string", MFJSON_SKIP);
+  if (parser->depth == 0)
+    return true;
+  MfjsonFrame *frame = &parser->stack[parser->depth - 1];
+  if (frame->expect != MFJSON_EXPECT_VALUE &&
+      frame->expect != MFJSON_EXPECT_VALUE_OR_END)
+    return mfjson_parser_fail(parser, "Invalid %s string", MFJSON_SKIP);
+  frame->expect = MFJSON_EXPECT_COMMA_OR_END;
+  return true;
+}
+
+/**
+ * @brief Start a new array for the values, coordinates, or timestamps of the
+ * current sequence
+ */
+static bool
+mfjson_parser_array_start(MfjsonParser *parser, mfjsonContext context)
+{
+  MfjsonSeq *seq = mfjson_parser_seq(parser);
+  bool *has = (context == MFJSON_DATETIMES) ? &seq->hastimes : &seq->hasvalues;
+  if (*has)
+    return mfjson_parser_fail(parser,
+      "Duplicate '%s' member in MFJSON string", context);
+  *has = true;
+  if (context == MFJSON_DATETIMES)
+    seq->tstart = parser->ntimes;
+  else
+    seq->vstart = parser->nvalues;
+  return true;
+}
+
+/**
+ * @brief Ensure that there is space for a new value
+ */
+static void
+mfjson_parser_values_enlarge(MfjsonParser *parser)
+{
+  if (parser->nvalues < parser->maxvalues)
+    return;
+  parser->maxvalues = parser->maxvalues ?
+    parser->maxvalues * 2 : MFJSON_INITIAL_SIZE;
+  if (tpoint_type(parser->temptype))
+    parser->coords = parser->coords ?
+      repalloc(parser->coords, sizeof(double) * 3 * parser->maxvalues) :
+      palloc(sizeof(double) * 3 * parser->maxvalues);
+  else
+    parser->values = parser->values ?
+      repalloc(parser->values, sizeof(Datum) * parser->maxvalues) :
+      palloc(sizeof(Datum) * parser->maxvalues);
+  return;
+}
+
+/**
+ * @brief Process the start of an object or an array
+ */
+static bool
+mfjson_parser_open(MfjsonParser *parser, bool isobject)
+{
+  mfjsonContext context = mfjson_value_context(parser);
+  if (parser->error || ! mfjson_parser_value_read(parser))
+    return false;
+  if (parser->depth == MFJSON_MAX_DEPTH)
+    return mfjson_parser_fail(parser,
+      "Maximum nesting depth exceeded in %s string", MFJSON_SKIP);
+
+  /* Ensure that the container corresponds to the context */
+  bool valid;
+  switch (context)
+  {
+    case MFJSON_SKIP:
+      valid = true;
+      break;
+    case MFJSON_CRS:
+    case MFJSON_CRS_PROPS:
+      /* A crs that is not an object is ignored */
+      if (! isobject)
+        context = MFJSON_SKIP;
+      valid = true;
+      break;
+    case MFJSON_ROOT:
+    case MFJSON_SEQUENCE:
+      valid = isobject;
+      break;
+    case MFJSON_SEQUENCES:
+    case MFJSON_COORDINATES:
+    case MFJSON_COORD:
+    case MFJSON_VALUES:
+    case MFJSON_DATETIMES:
+      valid = ! isobject;
+      break;
+    default:
+      valid = false;
+  }
+  if (! valid)
+    return (context == MFJSON_ROOT) ?
+      mfjson_parser_fail(parser, "Invalid %s string", MFJSON_SKIP) :
+      mfjson_parser_fail(parser, "Invalid '%s' value in MFJSON string",
+        context);
+
+  /* Start the corresponding component */
+  if (context == MFJSON_SEQUENCES)
+  {
+    if (parser->hasseqs)
+      return mfjson_parser_fail(parser,
+        "Duplicate '%s' member in MFJSON string", context);
+    parser->hasseqs = true;
+  }
+  else if (context == MFJSON_SEQUENCE)
+  {
+    if (parser->nseqs == parser->maxseqs)
+    {
+      parser->maxseqs = parser->maxseqs ?
+        parser->maxseqs * 2 : MFJSON_INITIAL_SIZE;
+      parser->seqs = parser->seqs ?
+        repalloc(parser->seqs, sizeof(MfjsonSeq) * parser->maxseqs) :
+        palloc(sizeof(MfjsonSeq) * parser->maxseqs);
+    }
+    MfjsonSeq *seq = &parser->seqs[parser->nseqs];
+    memset(seq, 0, sizeof(MfjsonSeq));
+    seq->lower_inc = seq->upper_inc = true;
+    parser->curseq = parser->nseqs++;
+  }
+  else if (context == MFJSON_COORDINATES || context == MFJSON_VALUES ||
+      context == MFJSON_DATETIMES)
+  {
+    if (! mfjson_parser_array_start(parser, context))
+      return false;
+  }
+  else if (context == MFJSON_COORD)
+    parser->ncoord = 0;
+
+  MfjsonFrame *frame = &parser->stack[parser->depth++];
+  frame->isobject = isobject;
+  frame->context = (uint8) context;
+  frame->expect = (uint8) (isobject ?
+    MFJSON_EXPECT_KEY_OR_END : MFJSON_EXPECT_VALUE_OR_END);
+  frame->keycontext = MFJSON_SKIP;
+  return true;
+}
+
+/**
+ * @brief Process the end of an object or an array
+ */
+static bool
+mfjson_parser_close(MfjsonParser *parser, bool isobject)
+{
+  if (parser->depth == 0)
+    return mfjson_parser_fail(parser, "Invalid %s string", MFJSON_SKIP);
+  MfjsonFrame *frame = &parser->stack[parser->depth - 1];
+  if (frame->isobject != isobject ||
+      (frame->expect != MFJSON_EXPECT_COMMA_OR_END &&
+       frame->expect != MFJSON_EXPECT_KEY_OR_END &&
+       frame->expect != MFJSON_EXPECT_VALUE_OR_END))
+    return mfjson_parser_fail(parser, "Invalid %s string", MFJSON_SKIP);
+
+  switch (frame->context)
+  {
+    case MFJSON_ROOT:
+      parser->done = true;
+      break;
+    case MFJSON_SEQUENCE:
+      parser->curseq = -1;
+      break;
+    case MFJSON_COORD:
+    {
+      if (parser->ncoord < 2)
+        return mfjson_parser_fail(parser,
+          "Too few elements in '%s' values in MFJSON string", MFJSON_COORD);
+      if (parser->ndims == 0)
+        parser->ndims = parser->ncoord;
+      else if (parser->ndims != parser->ncoord)
+        return mfjson_parser_fail(parser, "The points of the '%s' array "
+          "must have the same dimensionality in MFJSON string", MFJSON_COORD);
+      mfjson_parser_values_enlarge(parser);
+      double *coords = &parser->coords[3 * parser->nvalues++];
+      coords[0] = parser->coord[0];
+      coords[1] = parser->coord[1];
+      coords[2] = (parser->ncoord == 3) ? parser->coord[2] : 0.0;
+      mfjson_parser_seq(parser)->vcount++;
+      break;
+    }
+    default:
+      break;
+  }
+  parser->depth--;
+  return true;
+}
+
+/**
+ * @brief Return a boolean from a literal token
+ */
+static bool
+mfjson_parser_bool(MfjsonParser *parser, bool isstring, bool *result)
+{
+  if (isstring)
+    return false;
+  if (strcmp(parser->tok, "true") == 0)
+    *result = true;
+  else if (strcmp(parser->tok, "false") == 0)
+    *result = false;
+  else
+    return false;
+  return true;
+}
+
+/**
+ * @brief Return a double from a number token
+ */
+static bool
+mfjson_parser_double(MfjsonParser *parser, bool isstring, double *result)
+{
+  if (isstring)
+    return false;
+  char *end;
+  *result = strtod(parser->tok, &end);
+  return (end != parser->tok && *end == '\0');
+}
+
+/**
+ * @brief Process a scalar value, i.e., a string, a number, or a literal
+ */
+static bool
+mfjson_parser_scalar(MfjsonParser *parser, bool isstring)
+{
+  parser->tok[parser->toklen] = '\0';
+  /* Determine whether the string is a key */
+  if (isstring && parser->depth > 0)
+  {
+    MfjsonFrame *frame = &parser->stack[parser->depth - 1];
+    if (frame->isobject && (frame->expect == MFJSON_EXPECT_KEY ||
+        frame->expect == MFJSON_EXPECT_KEY_OR_END))
+    {
+      frame->keycontext = (uint8) mfjson_key_context(parser, frame->context,
+        parser->tok);
+      frame->expect = MFJSON_EXPECT_COLON;
+      return ! parser->error;
+    }
+  }
+
+  mfjsonContext context = mfjson_value_context(parser);
+  if (! mfjson_parser_value_read(parser))
+    return false;
+  /* Ensure that a literal or a number is valid */
+  if (! isstring && strcmp(parser->tok, "true") != 0 &&
+      strcmp(parser->tok, "false") != 0 && strcmp(parser->tok, "null") != 0)
+  {
+    double d;
+    if (! mfjson_parser_double(parser, false, &d))
+      return mfjson_parser_fail(parser, "Invalid %s string", MFJSON_SKIP);
+  }
+
+  MfjsonSeq *seq = mfjson_parser_seq(parser);
+  switch (context)
+  {
+    case MFJSON_SKIP:
+    case MFJSON_CRS:
+    case MFJSON_CRS_PROPS:
+      return true;
+
+    case MFJSON_TYPE:
+      if (! isstring)
+        break;
+      return mfjson_parser_set_type(parser, parser->tok);
+
+    case MFJSON_INTERP:
+      if (! isstring)
+        break;
+      if (strcmp(parser->tok, "None") == 0)
+        parser->interp = INTERP_NONE;
+      else if (strcmp(parser->tok, "Discrete") == 0)
+        parser->interp = DISCRETE;
+      else if (strcmp(parser->tok, "Step") == 0)
+        parser->interp = STEP;
+      else if (strcmp(parser->tok, "Linear") == 0)
+        parser->interp = LINEAR;
+      else
+        break;
+      parser->hasinterp = true;
+      return true;
+
+    case MFJSON_CRS_NAME:
+      if (isstring && sscanf(parser->tok, "EPSG:%d", &parser->srid) == 1)
+        parser->hassrid = true;
+      return true;
+
+    case MFJSON_COORD_NUMBER:
+    {
+      double d;
+      if (parser->ncoord == 3)
+        return mfjson_parser_fail(parser,
+          "Too many elements in '%s' values in MFJSON string", context);
+      if (! mfjson_parser_double(parser, isstring, &d))
+        return mfjson_parser_fail(parser,
+          "Invalid value of the '%s' array in MFJSON string", context);
+      parser->coord[parser->ncoord++] = d;
+      return true;
+    }
+
+    case MFJSON_VALUE:
+    {
+      Datum value;
+      bool b;
+      double d;
+      switch (parser->temptype)
+      {
+        case T_TBOOL:
+          if (! mfjson_parser_bool(parser, isstring, &b))
+            return mfjson_parser_fail(parser,
+              "Invalid boolean value in '%s' array in MFJSON string", context);
+          value = BoolGetDatum(b);
+          break;
+        case T_TINT:
+          if (! mfjson_parser_double(parser, isstring, &d) ||
+              strpbrk(parser->tok, ".eE") || d < PG_INT32_MIN ||
+              d > PG_INT32_MAX)
+            return mfjson_parser_fail(parser,
+              "Invalid integer value in '%s' array in MFJSON string", context);
+          value = Int32GetDatum((int32) d);
+          break;
+        case T_TFLOAT:
+          if (! mfjson_parser_double(parser, isstring, &d))
+            return mfjson_parser_fail(parser,
+              "Invalid float value in '%s' array in MFJSON string", context);
+          value = Float8GetDatum(d);
+          break;
+        default: /* T_TTEXT */
+          if (! isstring)
+            return mfjson_parser_fail(parser,
+              "Invalid string value in '%s' array in MFJSON string", context);
+          value = PointerGetDatum(cstring2text(parser->tok));
+      }
+      mfjson_parser_values_enlarge(parser);
+      parser->values[parser->nvalues++] = value;
+      seq->vcount++;
+      return true;
+    }
+
+    case MFJSON_DATETIME:
+    {
+      if (! isstring || parser->toklen <= 10)
+        return mfjson_parser_fail(parser,
+          "Invalid value of '%s' array in MFJSON string", context);
+      /* Replace 'T' by ' ' before converting to timestamptz */
+      parser->tok[10] = ' ';
+      TimestampTz t = pg_timestamptz_in(parser->tok, -1);
+      if (t == DT_NOEND)
+      {
+        parser->error = true;
+        return false;
+      }
+      if (parser->ntimes == parser->maxtimes)
+      {
+        parser->maxtimes = parser->maxtimes ?
+          parser->maxtimes * 2 : MFJSON_INITIAL_SIZE;
+        parser->times = parser->times ?
+          repalloc(parser->times, sizeof(TimestampTz) * parser->maxtimes) :
+          palloc(sizeof(TimestampTz) * parser->maxtimes);
+      }
+      parser->times[parser->ntimes++] = t;
+      seq->tcount++;
+      return true;
+    }
+
+    case MFJSON_LOWER_INC:
+    case MFJSON_UPPER_INC:
+    {
+      bool b;
+      if (! mfjson_parser_bool(parser, isstring, &b))
+      {
+        meos_error(WARNING, MEOS_ERR_MFJSON_INPUT, "Type of '%s' value in "
+          "MFJSON string is not boolean, defaulting to true",
+          mfjson_context_name(context));
+        b = true;
+      }
+      if (context == MFJSON_LOWER_INC)
+        seq->lower_inc = b;
+      else
+        seq->upper_inc = b;
+      return true;
+    }
+
+    default:
+      break;
+  }
+  return mfjson_parser_fail(parser,
+    "Invalid '%s' value in MFJSON string", context);
+}
+
+/**
+ * @brief Return the value of a hexadecimal digit, -1 if it is not valid
+ */
+static inline int
+mfjson_hex(char c)
+{
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+/**
+ * @ingroup meos_internal_temporal_inout
+ * @brief Feed a chunk of the MF-JSON representation of a temporal value to
+ * an incremental parser
+ * @details The chunks can be split at any position of the input
+ * @param[in,out] parser Parser
+ * @param[in] buf Chunk
+ * @param[in] len Number of characters of the chunk
+ * @return On error return false
+ * @see #mfjson_parser_make()
+ * @see #mfjson_parser_end()
+ */
+bool
+mfjson_parser_feed(MfjsonParser *parser, const char *buf, size_t len)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(parser, false); VALIDATE_NOT_NULL(buf, false);
+  if (parser->error)
+    return false;
+
+  for (size_t i = 0; i < len; i++)
+  {
+    char c = buf[i];
+    switch (parser->lexstate)
+    {
+      case MFJSON_LEX_STRING:
+        if (c == '"')
+        {
+          parser->lexstate = MFJSON_LEX_NONE;
+          if (! mfjson_parser_scalar(parser, true))
+            return false;
+        }
+        else if (c == '\\')
+          parser->lexstate = MFJSON_LEX_ESCAPE;
+        else if ((unsigned char) c < 0x20)
+          return mfjson_parser_fail(parser, "Invalid %s string", MFJSON_SKIP);
+        else
+          mfjson_parser_tokchar(parser, c);
+        continue;
+
+      case MFJSON_LEX_ESCAPE:
+        parser->lexstate = MFJSON_LEX_STRING;
+        switch (c)
+        {
+          case '"': case '\\': case '/':
+            mfjson_parser_tokchar(parser, c); break;
+          case 'b': mfjson_parser_tokchar(parser, '\b'); break;
+          case 'f': mfjson_parser_tokchar(parser, '\f'); break;
+          case 'n': mfjson_parser_tokchar(parser, '\n'); break;
+          case 'r': mfjson_parser_tokchar(parser, '\r'); break;
+          case 't': mfjson_parser_tokchar(parser, '\t'); break;
+          case 'u':
+            parser->lexstate = MFJSON_LEX_UNICODE;
+            parser->nhex = 0;
+            parser->code = 0;
+            break;
+          default:
+            return mfjson_parser_fail(parser, "Invalid %s string",
+              MFJSON_SKIP);
+        }
+        continue;
+
+      case MFJSON_LEX_UNICODE:
+      {
+        int digit = mfjson_hex(c);
+        if (digit < 0)
+          return mfjson_parser_fail(parser, "Invalid %s string", MFJSON_SKIP);
+        parser->code = (parser->code << 4) | (uint32) digit;
+        if (++parser->nhex < 4)
+          continue;
+        parser->lexstate = MFJSON_LEX_STRING;
+        /* Combine the surrogate pairs of UTF-16 */
+        if (parser->code >= 0xD800 && parser->code <= 0xDBFF)
+          parser->highsurr = parser->code;
+        else if (parser->code >= 0xDC00 && parser->code <= 0xDFFF &&
+          parser->highsurr)
+        {
+          mfjson_parser_tokcode(parser, 0x10000 +
+            ((parser->highsurr - 0xD800) << 10) + (parser->code - 0xDC00));
+          parser->highsurr = 0;
+        }
+        else
+          mfjson_parser_tokcode(parser, parser->code);
+        continue;
+      }
+
+      case MFJSON_LEX_SCALAR:
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+            (c >= 'A' && c <= 'Z') || c == '.' || c == '+' || c == '-')
+        {
+          mfjson_parser_tokchar(parser, c);
+          continue;
+        }
+        parser->lexstate = MFJSON_LEX_NONE;
+        if (! mfjson_parser_scalar(parser, false))
+          return false;
+        /* The current character is processed below */
+        break;
+
+      default: /* MFJSON_LEX_NONE */
+        break;
+    }
+
+    /* Between tokens */
+    MfjsonFrame *frame = parser->depth ?
+      &parser->stack[parser->depth - 1] : NULL;
+    switch (c)
+    {
+      case ' ': case '\t': case '\n': case '\r':
+        break;
+      case '{': case '[':
+        if (! mfjson_parser_open(parser, c == '{'))
+          return false;
+        break;
+      case '}': case ']':
+        if (! mfjson_parser_close(parser, c == '}'))
+          return false;
+        break;
+      case ':':
+        if (! frame || frame->expect != MFJSON_EXPECT_COLON)
+          return mfjson_parser_fail(parser, "Invalid %s string", MFJSON_SKIP);
+        frame->expect = MFJSON_EXPECT_VALUE;
+        break;
+      case ',':
+        if (! frame || frame->expect != MFJSON_EXPECT_COMMA_OR_END)
+          return mfjson_parser_fail(parser, "Invalid %s string", MFJSON_SKIP);
+        frame->expect = (uint8) (frame->isobject ?
+          MFJSON_EXPECT_KEY : MFJSON_EXPECT_VALUE);
+        break;
+      case '"':
+        parser->lexstate = MFJSON_LEX_STRING;
+        parser->toklen = 0;
+        parser->highsurr = 0;
+        break;
+      default:
+        if ((c >= '0' && c <= '9') || c == '-' || (c >= 'a' && c <= 'z'))
+        {
+          parser->lexstate = MFJSON_LEX_SCALAR;
+          parser->toklen = 0;
+          mfjson_parser_tokchar(parser, c);
+        }
+        else
+          return mfjson_parser_fail(parser, "Invalid %s string", MFJSON_SKIP);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Return a temporal instant from a value and a timestamp read by an
+ * incremental MF-JSON parser
+ */
+static TInstant *
+mfjson_parser_inst(MfjsonParser *parser, int i, TimestampTz t)
+{
+  if (! tpoint_type(parser->temptype))
+    return tinstant_make(parser->values[i], parser->temptype, t);
+  const double *coords = &parser->coords[3 * i];
+  GSERIALIZED *gs = geopoint_make(coords[0], coords[1], coords[2],
+    parser->ndims == 3, tgeodetic_type(parser->temptype), parser->srid);
+  return tinstant_make_free(PointerGetDatum(gs), parser->temptype, t);
+}
+
+/**
+ * @brief Return a temporal sequence from the values and the timestamps read
+ * by an incremental MF-JSON parser
+ * @details The instants of base types passed by value and of temporal points
+ * have all the same size. They are stored consecutively in a single buffer
+ * using the first instant as template for the remaining ones.
+ */
+static TSequence *
+mfjson_parser_tsequence(MfjsonParser *parser, const MfjsonSeq *seq,
+  interpType interp)
+{
+  int count = seq->vcount;
+  const TInstant **instants = palloc(sizeof(TInstant *) * count);
+  TInstant *inst = mfjson_parser_inst(parser, seq->vstart,
+    parser->times[seq->tstart]);
+  if (! inst)
+  {
+    pfree(instants);
+    return NULL;
+  }
+  TSequence *result;
+  if (! tpoint_type(parser->temptype) &&
+      ! basetype_byvalue(temptype_basetype(parser->temptype)))
+  {
+    instants[0] = inst;
+    for (int i = 1; i < count; i++)
+      instants[i] = mfjson_parser_inst(parser, seq->vstart + i,
+        parser->times[seq->tstart + i]);
+    return tsequence_make_free((TInstant **) instants, count, seq->lower_inc,
+      seq->upper_inc, interp, NORMALIZE);
+  }
+
+  /* Store the instants consecutively using the first one as template */
+  size_t size = VARSIZE(inst), instsize = DOUBLE_PAD(size);
+  char *buf = palloc(instsize * count);
+  memcpy(buf, inst, size);
+  pfree(inst);
+  instants[0] = (TInstant *) buf;
+  for (int i = 1; i < count; i++)
+  {
+    TInstant *inst1 = (TInstant *) (buf + instsize * i);
+    memcpy(inst1, instants[0], size);
+    if (tpoint_type(parser->temptype))
+    {
+      double *coords = (double *) GS_POINT_PTR(
+        DatumGetGserializedP(tinstant_value_p(inst1)));
+      memcpy(coords, &parser->coords[3 * (seq->vstart + i)],
+        sizeof(double) * parser->ndims);
+      inst1->t = parser->times[seq->tstart + i];
+    }
+    else
+      tinstant_set(inst1, parser->values[seq->vstart + i],
+        parser->times[seq->tstart + i]);
+    instants[i] = inst1;
+  }
+  result = tsequence_make(instants, count, seq->lower_inc, seq->upper_inc,
+    interp, NORMALIZE);
+  pfree(buf); pfree(instants);
+  return result;
+}
+
+/**
+ * @brief Ensure that the values and the timestamps of a sequence read by an
+ * incremental MF-JSON parser are valid
+ */
+static bool
+mfjson_parser_ensure_seq(MfjsonParser *parser, const MfjsonSeq *seq)
+{
+  mfjsonContext context = tpoint_type(parser->temptype) ?
+    MFJSON_COORDINATES : MFJSON_VALUES;
+  if (! seq->hasvalues)
+    return mfjson_parser_fail(parser,
+      "Unable to find '%s' in MFJSON string", context);
+  if (! seq->hastimes)
+    return mfjson_parser_fail(parser,
+      "Unable to find '%s' in MFJSON string", MFJSON_DATETIMES);
+  if (seq->vcount < 1)
+    return mfjson_parser_fail(parser,
+      "Invalid value of '%s' array in MFJSON string", context);
+  if (seq->vcount != seq->tcount)
+    return mfjson_parser_fail(parser,
+      "Distinct number of elements in '%s' and 'datetimes' arrays", context);
+  return true;
+}
+
+/**
+ * @ingroup meos_internal_temporal_inout
+ * @brief Return the temporal value read by an incremental MF-JSON parser and
+ * free the parser
+ * @param[in] parser Parser
+ * @return On error return @p NULL
+ * @see #mfjson_parser_make()
+ * @see #mfjson_parser_feed()
+ */
+Temporal *
+mfjson_parser_end(MfjsonParser *parser)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(parser, NULL);
+
+  /* A number or a literal at the end of the input is only ended here */
+  if (! parser->error && parser->lexstate == MFJSON_LEX_SCALAR)
+  {
+    parser->lexstate = MFJSON_LEX_NONE;
+    mfjson_parser_scalar(parser, false);
+  }
+
+  Temporal *result = NULL;
+  if (parser->error)
+    ;
+  else if (! parser->done || parser->lexstate != MFJSON_LEX_NONE)
+    mfjson_parser_fail(parser, "Incomplete %s string", MFJSON_SKIP);
+  else if (! parser->hastype)
+    mfjson_parser_fail(parser, "Unable to find '%s' in MFJSON string",
+      MFJSON_TYPE);
+  else if (! parser->hasinterp)
+    mfjson_parser_fail(parser, "Unable to find '%s' in MFJSON string",
+      MFJSON_INTERP);
+  else
+  {
+    if (! parser->hassrid && tgeodetic_type(parser->temptype))
+      parser->srid = WGS84_SRID;
+    if (parser->interp == INTERP_NONE)
+    {
+      if (mfjson_parser_ensure_seq(parser, &parser->root))
+      {
+        if (parser->root.vcount != 1)
+          mfjson_parser_fail(parser, "Invalid number of elements in '%s' "
+            "and/or 'datetimes' arrays", tpoint_type(parser->temptype) ?
+            MFJSON_COORDINATES : MFJSON_VALUES);
+        else
+          result = (Temporal *) mfjson_parser_inst(parser,
+            parser->root.vstart, parser->times[parser->root.tstart]);
+      }
+    }
+    else if (parser->interp == DISCRETE || ! parser->hasseqs)
+    {
+      if (mfjson_parser_ensure_seq(parser, &parser->root))
+        result = (Temporal *) mfjson_parser_tsequence(parser, &parser->root,
+          parser->interp);
+    }
+    else if (parser->nseqs < 1)
+      mfjson_parser_fail(parser,
+        "Invalid value of '%s' array in MFJSON string", MFJSON_SEQUENCES);
+    else
+    {
+      TSequence **sequences = palloc(sizeof(TSequence *) * parser->nseqs);
+      int nseqs = 0;
+      for (int i = 0; i < parser->nseqs; i++)
+      {
+        if (! mfjson_parser_ensure_seq(parser, &parser->seqs[i]))
+          break;
+        sequences[nseqs] = mfjson_parser_tsequence(parser, &parser->seqs[i],
+          parser->interp);
+        if (! sequences[nseqs])
+          break;
+        nseqs++;
+      }
+      if (nseqs == parser->nseqs)
+        result = (Temporal *) tsequenceset_make_free(sequences, nseqs,
+          NORMALIZE);
+      else
+        pfree_array((void **) sequences, nseqs);
+    }
+  }
+  mfjson_parser_free(parser);
+  return result;
+}
+
+/*****************************************************************************/
@@ -504,6 +504,43 @@ temptype_as_mfjson_sb(stringbuffer_t *sb, meosType temptype)
 
 /*****************************************************************************/
 
+/**
+ * @brief Structure to represent the callback to which the MF-JSON
+ * representation of a temporal value is written in chunks
+ */
+typedef struct
+{
+  size_t chunk_size;      /**< Minimum number of characters of a chunk */
+  mfjson_write_fn write;  /**< Function called for each chunk */
+  void *arg;              /**< Argument passed to the function */
+} MfjsonWriter;
+
+/**
+ * @brief Pass the content of the buffer to the callback of the writer and
+ * empty the buffer when it has at least the size of a chunk or when forced
+ * @details Nothing is done when the writer is @p NULL, in which case the
+ * whole representation is accumulated in the buffer
+ */
+static bool
+mfjson_sb_flush(stringbuffer_t *sb, const MfjsonWriter *writer, bool force)
+{
+  if (! writer)
+    return true;
+  size_t len = (size_t) stringbuffer_getlength(sb);
+  if (len == 0 || (! force && len < writer->chunk_size))
+    return true;
+  if (! writer->write(stringbuffer_getstring(sb), len, writer->arg))
+  {
+    meos_error(ERROR, MEOS_ERR_MFJSON_OUTPUT,
+      "Error while writing the MFJSON representation of a temporal value");
+    return false;
+  }
+  stringbuffer_clear(sb);
+  return true;
+}
+
+/*****************************************************************************/
+
 /**
  * @brief Write into the buffer a temporal instant in the MF-JSON
  * representation
@@ -579,7 +616,8 @@ tinstant_as_mfjson_sb(stringbuffer_t *sb, const TInstant *inst,
  */
 static bool
 tsequence_as_mfjson_sb(stringbuffer_t *sb, const TSequence *seq,
-  const bboxunion *box, int precision, const char *srs)
+  const bboxunion *box, int precision, const char *srs,
+  const MfjsonWriter *writer)
 {
   bool success = temptype_as_mfjson_sb(sb, seq->temptype);
   /* Propagate errors up */
@@ -645,6 +683,8 @@ tsequence_as_mfjson_sb(stringbuffer_t *sb, const TSequence *seq,
       if (! success)
         return false;
     }
+    if (! mfjson_sb_flush(sb, writer, false))
+      return false;
   }
   stringbuffer_append_len(sb, "],\"datetimes\":[", 15);
   for (int i = 0; i < seq->count; i++)
@@ -652,6 +692,8 @@ tsequence_as_mfjson_sb(stringbuffer_t *sb, const TSequence *seq,
     if (i) stringbuffer_append_char(sb, ',');
     inst = TSEQUENCE_INST_N(seq, i);
     datetimes_as_mfjson_sb(sb, inst->t);
+    if (! mfjson_sb_flush(sb, writer, false))
+      return false;
   }
   stringbuffer_aprintf(sb, "],\"lower_inc\":%s,\"upper_inc\":%s,\"interpolation\":\"%s\"}",
     seq->period.lower_inc ? "true" : "false", seq->period.upper_inc ? "true" : "false",
@@ -668,7 +710,8 @@ tsequence_as_mfjson_sb(stringbuffer_t *sb, const TSequence *seq,
  */
 static bool
 tsequenceset_as_mfjson_sb(stringbuffer_t *sb, const TSequenceSet *ss,
-  const bboxunion *box, int precision, const char *srs)
+  const bboxunion *box, int precision, const char *srs,
+  const MfjsonWriter *writer)
 {
   bool success = temptype_as_mfjson_sb(sb, ss->temptype);
   /* Propagate errors up */
@@ -741,6 +784,8 @@ tsequenceset_as_mfjson_sb(stringbuffer_t *sb, const TSequenceSet *ss,
         if (! success)
           return false;
       }
+      if (! mfjson_sb_flush(sb, writer, false))
+        return false;
     }
     stringbuffer_append_len(sb, "],\"datetimes\":[", 15);
     for (int j = 0; j < seq->count; j++)
@@ -748,6 +793,8 @@ tsequenceset_as_mfjson_sb(stringbuffer_t *sb, const TSequenceSet *ss,
       if (j) stringbuffer_append_char(sb, ',');
       inst = TSEQUENCE_INST_N(seq, j);
       datetimes_as_mfjson_sb(sb, inst->t);
+      if (! mfjson_sb_flush(sb, writer, false))
+        return false;
     }
       stringbuffer_aprintf(sb, "],\"lower_inc\":%s,\"upper_inc\":%s}",
       seq->period.lower_inc ? "true" : "false", 
@@ -760,6 +807,38 @@ tsequenceset_as_mfjson_sb(stringbuffer_t *sb, const TSequenceSet *ss,
 
 /*****************************************************************************/
 
+/**
+ * @brief Write into the buffer a temporal value in the MF-JSON representation
+ * @details When the writer is not @p NULL, the buffer is passed to it in
+ * chunks while the representation is written
+ */
+static bool
+temporal_as_mfjson_sb(stringbuffer_t *sb, const Temporal *temp,
+  bool with_bbox, int precision, const char *srs, const MfjsonWriter *writer)
+{
+  /* Get bounding box if needed */
+  bboxunion *box = NULL, tmp;
+  if (with_bbox)
+  {
+    temporal_set_bbox(temp, &tmp);
+    box = &tmp;
+  }
+
+  assert(temptype_subtype(temp->subtype));
+  switch (temp->subtype)
+  {
+    case TINSTANT:
+      return tinstant_as_mfjson_sb(sb, (TInstant *) temp, box, precision,
+        srs);
+    case TSEQUENCE:
+      return tsequence_as_mfjson_sb(sb, (TSequence *) temp, box, precision,
+        srs, writer);
+    default: /* TSEQUENCESET */
+      return tsequenceset_as_mfjson_sb(sb, (TSequenceSet *) temp, box,
+        precision, srs, writer);
+  }
+}
+
 /**
  * @ingroup meos_temporal_inout
  * @brief Return the MF-JSON representation of a temporal value
@@ -779,32 +858,10 @@ temporal_as_mfjson(const Temporal *temp, bool with_bbox, int flags,
   /* Ensure the validity of the arguments */
   VALIDATE_NOT_NULL(temp, NULL);
 
-  /* Get bounding box if needed */
-  bboxunion *box = NULL, tmp;
-  if (with_bbox)
-  {
-    temporal_set_bbox(temp, &tmp);
-    box = &tmp;
-  }
-
   /* Create the string buffer */
   stringbuffer_t *sb = stringbuffer_create();
+  bool res = temporal_as_mfjson_sb(sb, temp, with_bbox, precision, srs, NULL);
 
-  bool res;
-  assert(temptype_subtype(temp->subtype));
-  switch (temp->subtype)
-  {
-    case TINSTANT:
-      res = tinstant_as_mfjson_sb(sb, (TInstant *) temp, box, precision, srs);
-      break;
-    case TSEQUENCE:
-      res = tsequence_as_mfjson_sb(sb, (TSequence *) temp, box, precision, 
-        srs);
-      break;
-    default: /* TSEQUENCESET */
-      res = tsequenceset_as_mfjson_sb(sb, (TSequenceSet *) temp, box,
-        precision, srs);
-  }
   /* Convert the string buffer to a C string */
   char *result = ! res ? NULL : stringbuffer_getstringcopy(sb);
 
@@ -824,6 +881,43 @@ temporal_as_mfjson(const Temporal *temp, bool with_bbox, int flags,
   return result;
 }
 
+#if MEOS
+/**
+ * @ingroup meos_temporal_inout
+ * @brief Write the MF-JSON representation of a temporal value in chunks
+ * to a callback function
+ * @details The representation is the same as the one returned by
+ * #temporal_as_mfjson() without flags. It is passed to the function
+ * in chunks of at least @p chunk_size characters, except the last one, so that
+ * the whole representation is never stored in memory. The chunks are not
+ * null-terminated.
+ * @param[in] temp Temporal value
+ * @param[in] with_bbox True when the output value has bounding box
+ * @param[in] precision Number of decimal digits
+ * @param[in] srs Spatial reference system
+ * @param[in] chunk_size Minimum number of characters of a chunk
+ * @param[in] write Function called for each chunk, which returns false on
+ * error
+ * @param[in] arg Argument passed to the function
+ * @return On error return false
+ */
+bool
+temporal_as_mfjson_stream(const Temporal *temp, bool with_bbox,
+  int precision, const char *srs, size_t chunk_size, mfjson_write_fn write,
+  void *arg)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(temp, false); VALIDATE_NOT_NULL(write, false);
+
+  MfjsonWriter writer = { chunk_size, write, arg };
+  stringbuffer_t *sb = stringbuffer_create();
+  bool result = temporal_as_mfjson_sb(sb, temp, with_bbox, precision, srs,
+      &writer) && mfjson_sb_flush(sb, &writer, true);
+  stringbuffer_destroy(sb);
+  return result;
+}
+#endif /* MEOS */
+
 /*****************************************************************************
  * Output in Well-Known Binary (WKB) representation
  *
@@ -1086,21 +1180,44 @@ stbox_to_wkb_size(const STBox *box, uint8_t variant)
 /*****************************************************************************/
 
 /**
- * @brief Return the maximum size in bytes of an array of temporal instants
- * in the Well-Known Binary (WKB) representation
+ * @brief Return the size in bytes of the base value and the timestamp of a
+ * temporal instant in the Well-Known Binary (WKB) representation when this
+ * size is the same for all the instants of a temporal value, return 0
+ * otherwise
+ * @details This is the case for base types of fixed size and for temporal
+ * points, since all their instants share the dimensionality and the SRID.
+ * The size of the points is then obtained from the first one.
  */
 static size_t
-tinstarr_to_wkb_size(const TInstant **instants, int count, uint8_t variant)
+tinstant_wkb_fixed_size(const TInstant *inst, uint8_t variant)
 {
-  size_t result = 0;
-  meosType basetype = temptype_basetype(instants[0]->temptype);
-  for (int i = 0; i < count; i++)
-  {
-    Datum value = tinstant_value_p(instants[i]);
-    result += base_to_wkb_size(value, basetype, variant);
-  }
-  /* size of the TInstant array */
-  result += count * MEOS_WKB_TIMESTAMP_SIZE;
+  meosType basetype = temptype_basetype(inst->temptype);
+  if (tpoint_type(inst->temptype))
+    return geo_to_wkb_size(DatumGetGserializedP(tinstant_value_p(inst)),
+      variant) + MEOS_WKB_TIMESTAMP_SIZE;
+  if (basetype_byvalue(basetype))
+    return base_to_wkb_size(tinstant_value_p(inst), basetype, variant) +
+      MEOS_WKB_TIMESTAMP_SIZE;
+  return 0;
+}
+
+/**
+ * @brief Return the size in bytes of the instants of a temporal sequence in
+ * the Well-Known Binary (WKB) representation
+ */
+static size_t
+tsequence_insts_to_wkb_size(const TSequence *seq, uint8_t variant)
+{
+  /* Instants of fixed size do not need to be traversed */
+  size_t result = tinstant_wkb_fixed_size(TSEQUENCE_INST_N(seq, 0), variant);
+  if (result)
+    return result * seq->count;
+  meosType basetype = temptype_basetype(seq->temptype);
+  for (int i = 0; i < seq->count; i++)
+    result += base_to_wkb_size(tinstant_value_p(TSEQUENCE_INST_N(seq, i)),
+      basetype, variant);
+  /* size of the timestamps */
+  result += seq->count * MEOS_WKB_TIMESTAMP_SIZE;
   return result;
 }
 
@@ -1118,7 +1235,8 @@ tinstant_to_wkb_size(const TInstant *inst, uint8_t variant)
       spatial_wkb_needs_srid(tspatial_srid((Temporal *) inst), variant))
     result += MEOS_WKB_INT4_SIZE;
   /* TInstant */
-  result += tinstarr_to_wkb_size(&inst, 1, variant);
+  result += base_to_wkb_size(tinstant_value_p(inst),
+    temptype_basetype(inst->temptype), variant) + MEOS_WKB_TIMESTAMP_SIZE;
   return result;
 }
 
@@ -1137,10 +1255,8 @@ tsequence_to_wkb_size(const TSequence *seq, uint8_t variant)
     result += MEOS_WKB_INT4_SIZE;
   /* Include the number of instants and the period bounds flag */
   result += MEOS_WKB_INT4_SIZE + MEOS_WKB_BYTE_SIZE;
-  const TInstant **instants = tsequence_insts_p(seq);
   /* Include the TInstant array */
-  result += tinstarr_to_wkb_size(instants, seq->count, variant);
-  pfree(instants);
+  result += tsequence_insts_to_wkb_size(seq, variant);
   return result;
 }
 
@@ -1162,9 +1278,16 @@ tsequenceset_to_wkb_size(const TSequenceSet *ss, uint8_t variant)
   /* For each sequence include the number of instants and the period bounds flag */
   result += ss->count * (MEOS_WKB_INT4_SIZE + MEOS_WKB_BYTE_SIZE);
   /* Include all the instants of all the sequences */
-  const TInstant **instants = tsequenceset_insts_p(ss);
-  result += tinstarr_to_wkb_size(instants, ss->totalcount, variant);
-  pfree(instants);
+  size_t instsize = tinstant_wkb_fixed_size(
+    TSEQUENCE_INST_N(TSEQUENCESET_SEQ_N(ss, 0), 0), variant);
+  if (instsize)
+    result += instsize * ss->totalcount;
+  else
+  {
+    for (int i = 0; i < ss->count; i++)
+      result += tsequence_insts_to_wkb_size(TSEQUENCESET_SEQ_N(ss, i),
+        variant);
+  }
   return result;
 }
 
@@ -1461,6 +1584,9 @@ text_to_wkb_buf(const text *txt, uint8_t *buf, uint8_t variant)
   uint8_t *bstr = (uint8_t *)(str);
   size_t size = VARSIZE_ANY_EXHDR(txt) + 1;
   buf = int64_to_wkb_buf(size, buf, variant);
+  /* The characters of the string are never swapped */
+  variant = (uint8_t) (MEOS_IS_BIG_ENDIAN ? variant & ~WKB_NDR :
+    variant | WKB_NDR);
   buf = bytes_to_wkb_buf(bstr, size, buf, variant);
   pfree(str);
   return buf;
@@ -2049,6 +2175,51 @@ tinstant_base_time_to_wkb_buf(const TInstant *inst, uint8_t *buf,
   return buf;
 }
 
+/**
+ * @brief Write into the buffer the instants of a temporal sequence in the
+ * Well-Known Binary (WKB) representation
+ * @details When the output is binary and in the machine byte order, only the
+ * first point of a temporal point is written through liblwgeom. Since all the
+ * points share the same header, i.e., endian, type, and optional SRID, this
+ * header is copied for the remaining points, whose coordinates and timestamps
+ * are copied directly from the instants.
+ */
+static uint8_t *
+tsequence_insts_to_wkb_buf(const TSequence *seq, uint8_t *buf,
+  uint8_t variant)
+{
+  if (! tpoint_type(seq->temptype) || wkb_swap_bytes(variant) ||
+      (variant & WKB_HEX))
+  {
+    for (int i = 0; i < seq->count; i++)
+      buf = tinstant_base_time_to_wkb_buf(TSEQUENCE_INST_N(seq, i), buf,
+        variant);
+    return buf;
+  }
+
+  /* Write the first instant */
+  uint8_t *first = buf;
+  buf = tinstant_base_time_to_wkb_buf(TSEQUENCE_INST_N(seq, 0), buf, variant);
+  /* The SFSQL variant only outputs the X and Y coordinates */
+  size_t coordsize = ((variant & (WKB_ISO | WKB_EXTENDED)) &&
+    MEOS_FLAGS_GET_Z(seq->flags)) ? 3 * MEOS_WKB_DOUBLE_SIZE :
+    2 * MEOS_WKB_DOUBLE_SIZE;
+  size_t hdrsize = (buf - first) - coordsize - MEOS_WKB_TIMESTAMP_SIZE;
+  /* Write the remaining instants */
+  for (int i = 1; i < seq->count; i++)
+  {
+    const TInstant *inst = TSEQUENCE_INST_N(seq, i);
+    const GSERIALIZED *gs = DatumGetGserializedP(tinstant_value_p(inst));
+    memcpy(buf, first, hdrsize);
+    buf += hdrsize;
+    memcpy(buf, GS_POINT_PTR(gs), coordsize);
+    buf += coordsize;
+    memcpy(buf, &inst->t, MEOS_WKB_TIMESTAMP_SIZE);
+    buf += MEOS_WKB_TIMESTAMP_SIZE;
+  }
+  return buf;
+}
+
 /**
  * @brief Write into the buffer the temporal instant in the Well-Known Binary
  * (WKB) representation
@@ -2116,10 +2287,7 @@ tsequence_to_wkb_buf(const TSequence *seq, uint8_t *buf, uint8_t variant)
   buf = bounds_to_wkb_buf(seq->period.lower_inc, seq->period.upper_inc, buf,
     variant);
   /* Write the array of instants */
-  for (int i = 0; i < seq->count; i++)
-    buf = tinstant_base_time_to_wkb_buf(TSEQUENCE_INST_N(seq, i), buf,
-      variant);
-  return buf;
+  return tsequence_insts_to_wkb_buf(seq, buf, variant);
 }
 
 /**
@@ -2164,9 +2332,7 @@ tsequenceset_to_wkb_buf(const TSequenceSet *ss, uint8_t *buf, uint8_t variant)
     buf = bounds_to_wkb_buf(seq->period.lower_inc, seq->period.upper_inc, buf,
       variant);
     /* Write the array of instants */
-    for (int j = 0; j < seq->count; j++)
-      buf = tinstant_base_time_to_wkb_buf(TSEQUENCE_INST_N(seq, j), buf,
-        variant);
+    buf = tsequence_insts_to_wkb_buf(seq, buf, variant);
   }
   return buf;
 }
@@ -2236,6 +2402,80 @@ datum_to_wkb_buf(Datum value, meosType type, uint8_t *buf, uint8_t variant)
   return buf;
 }
 
+/**
+ * @brief Return the variant of the WKB representation with the machine byte
+ * order if neither or both byte orders are specified
+ */
+static uint8_t
+wkb_variant_byte_order(uint8_t variant)
+{
+  if (! (variant & WKB_NDR || variant & WKB_XDR) ||
+    (variant & WKB_NDR && variant & WKB_XDR))
+  {
+    if (MEOS_IS_BIG_ENDIAN)
+      variant = variant | (uint8_t) WKB_XDR;
+    else
+      variant = variant | (uint8_t) WKB_NDR;
+  }
+  return variant;
+}
+
+/**
+ * @brief Return the size in bytes of the WKB representation of a datum value,
+ * including the null terminator in the case of ASCII
+ * @return On error return 0
+ */
+static size_t
+datum_as_wkb_size(Datum value, meosType type, uint8_t variant)
+{
+  /* Calculate the required size of the output buffer */
+  size_t buf_size = datum_to_wkb_size(value, type, variant);
+  if (buf_size == 0 || buf_size == SIZE_MAX)
+  {
+    meos_error(ERROR, MEOS_ERR_WKB_OUTPUT,
+      "Error calculating output WKB buffer size.");
+    return 0;
+  }
+  /* Hex string takes twice as much space as binary + a null character */
+  if (variant & WKB_HEX)
+    buf_size = 2 * buf_size + 1;
+  return buf_size;
+}
+
+/**
+ * @brief Write the WKB representation of a datum value into a buffer whose
+ * size has been computed by the function #datum_as_wkb_size
+ * @return On error return false
+ */
+static bool
+datum_as_wkb_buf(Datum value, meosType type, uint8_t variant, uint8_t *buf,
+  size_t buf_size)
+{
+  /* Retain a pointer to the front of the buffer for later */
+  uint8_t *wkb_out = buf;
+
+  /* Write the WKB into the output buffer */
+  buf = datum_to_wkb_buf(value, type, buf, wkb_variant_byte_order(variant));
+  if (! buf)
+    return false;
+
+  /* Null the last byte if this is a hex output */
+  if (variant & WKB_HEX)
+  {
+    *buf = '\0';
+    buf++;
+  }
+
+  /* The buffer pointer should now land at the end of the allocated buffer space. Let's check. */
+  if (buf_size != (size_t) (buf - wkb_out))
+  {
+    meos_error(ERROR, MEOS_ERR_WKB_OUTPUT,
+      "Output WKB is not the same size as the allocated buffer.");
+    return false;
+  }
+  return true;
+}
+
 /**
  * @brief Return the WKB representation of a datum value
  * @param[in] value Value
@@ -2252,38 +2492,16 @@ datum_to_wkb_buf(Datum value, meosType type, uint8_t *buf, uint8_t variant)
 uint8_t *
 datum_as_wkb(Datum value, meosType type, uint8_t variant, size_t *size_out)
 {
-  size_t buf_size;
-  uint8_t *buf = NULL;
-  uint8_t *wkb_out = NULL;
-
   /* Initialize output size */
   if (size_out) *size_out = 0;
 
   /* Calculate the required size of the output buffer */
-  buf_size = datum_to_wkb_size(value, type, variant);
+  size_t buf_size = datum_as_wkb_size(value, type, variant);
   if (buf_size == 0)
-  {
-    meos_error(ERROR, MEOS_ERR_WKB_OUTPUT,
-      "Error calculating output WKB buffer size.");
     return NULL;
-  }
-
-  /* Hex string takes twice as much space as binary + a null character */
-  if (variant & WKB_HEX)
-    buf_size = 2 * buf_size + 1;
-
-  /* If neither or both variants are specified, choose the native order */
-  if (! (variant & WKB_NDR || variant & WKB_XDR) ||
-    (variant & WKB_NDR && variant & WKB_XDR))
-  {
-    if (MEOS_IS_BIG_ENDIAN)
-      variant = variant | (uint8_t) WKB_XDR;
-    else
-      variant = variant | (uint8_t) WKB_NDR;
-  }
 
   /* Allocate the buffer */
-  buf = palloc(buf_size);
+  uint8_t *buf = palloc(buf_size);
   if (buf == NULL)
   {
     meos_error(ERROR, MEOS_ERR_WKB_OUTPUT, "Unable to allocate "
@@ -2291,25 +2509,10 @@ datum_as_wkb(Datum value, meosType type, uint8_t variant, size_t *size_out)
     return NULL;
   }
 
-  /* Retain a pointer to the front of the buffer for later */
-  wkb_out = buf;
-
   /* Write the WKB into the output buffer */
-  buf = datum_to_wkb_buf(value, type, buf, variant);
-
-  /* Null the last byte if this is a hex output */
-  if (variant & WKB_HEX)
-  {
-    *buf = '\0';
-    buf++;
-  }
-
-  /* The buffer pointer should now land at the end of the allocated buffer space. Let's check. */
-  if (buf_size != (size_t) (buf - wkb_out))
+  if (! datum_as_wkb_buf(value, type, variant, buf, buf_size))
   {
-    meos_error(ERROR, MEOS_ERR_WKB_OUTPUT,
-      "Output WKB is not the same size as the allocated buffer.");
-    pfree(wkb_out);
+    pfree(buf);
     return NULL;
   }
 
@@ -2317,7 +2520,7 @@ datum_as_wkb(Datum value, meosType type, uint8_t variant, size_t *size_out)
   if (size_out)
     *size_out = buf_size;
 
-  return wkb_out;
+  return buf;
 }
 
 /**
@@ -2510,6 +2713,72 @@ temporal_as_wkb(const Temporal *temp, uint8_t variant, size_t *size_out)
 }
 
 #if MEOS
+/**
+ * @ingroup meos_temporal_inout
+ * @brief Return the size in bytes of the Well-Known Binary (WKB)
+ * representation of a temporal value
+ * @details The size includes the null terminator if the variant requests the
+ * ASCII hex-encoded representation. It is the size of the buffer to be passed
+ * to the function #temporal_as_wkb_buf
+ * @param[in] temp Temporal value
+ * @param[in] variant Output variant
+ * @return On error return 0
+ */
+size_t
+temporal_wkb_size(const Temporal *temp, uint8_t variant)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(temp, 0);
+  return datum_as_wkb_size(PointerGetDatum(temp), temp->temptype, variant);
+}
+
+/**
+ * @ingroup meos_temporal_inout
+ * @brief Write the Well-Known Binary (WKB) representation of a temporal value
+ * into a buffer provided by the caller
+ * @details The function allows the caller to reuse the same buffer for many
+ * values or to write consecutive values into a single buffer by advancing the
+ * buffer by the number of bytes written, as in
+ * @code
+ * for (int i = 0; i < count; i++)
+ * {
+ *   size_t n = temporal_as_wkb_buf(temps[i], WKB_NDR, buf, end - buf);
+ *   if (n == 0)
+ *     break;
+ *   buf += n;
+ * }
+ * @endcode
+ * @param[in] temp Temporal value
+ * @param[in] variant Output variant
+ * @param[out] buf Output buffer
+ * @param[in] size Size in bytes of the output buffer
+ * @return Number of bytes written into the buffer, including the null
+ * terminator in the case of ASCII. On error, including when the buffer is
+ * too small, return 0
+ */
+size_t
+temporal_as_wkb_buf(const Temporal *temp, uint8_t variant, uint8_t *buf,
+  size_t size)
+{
+  /* Ensure the validity of the arguments */
+  VALIDATE_NOT_NULL(temp, 0); VALIDATE_NOT_NULL(buf, 0);
+  size_t result = datum_as_wkb_size(PointerGetDatum(temp), temp->temptype,
+    variant);
+  if (result == 0)
+    return 0;
+  if (result > size)
+  {
+    meos_error(ERROR, MEOS_ERR_WKB_OUTPUT, "The output buffer of "
+      UINT64_FORMAT " bytes is too small for the " UINT64_FORMAT
+      " bytes of the WKB output", (uint64) size, (uint64) result);
+    return 0;
+  }
+  if (! datum_as_wkb_buf(PointerGetDatum(temp), temp->temptype, variant, buf,
+      result))
+    return 0;
+  return result;
+}
+
 /**
  * @ingroup meos_temporal_inout
  * @brief Return the ASCII hex-encoded Well-Known Binary (HexWKB)
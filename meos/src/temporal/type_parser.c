@@ -33,11 +33,15 @@
  * @details Many functions make two passes for parsing, the first one to obtain
  * the number of elements in order to do memory allocation with @p palloc, the
  * second one to create the type. This is the only approach we can see at the
- * moment which is both correct and simple.
+ * moment which is both correct and simple. The temporal types, whose text
+ * representation may be very long, are parsed instead in a single pass that
+ * collects the instants or the sequences in an array enlarged as needed.
  */
 
 #include "temporal/type_parser.h"
 
+/* PostgreSQL */
+#include <utils/datetime.h>
 /* MEOS */
 #include <meos.h>
 #include <meos_internal.h>
@@ -418,14 +422,114 @@ tbox_parse(const char **str)
 /*****************************************************************************/
 /* Time Types */
 
+/**
+ * @brief Input a given number of decimal digits from the buffer
+ * @return Return false if there are not enough digits
+ */
+static inline bool
+p_digits(const char *str, int count, int *result)
+{
+  int value = 0;
+  for (int i = 0; i < count; i++)
+  {
+    if (str[i] < '0' || str[i] > '9')
+      return false;
+    value = value * 10 + (str[i] - '0');
+  }
+  *result = value;
+  return true;
+}
+
+/**
+ * @brief Parse a timestamp with time zone in the canonical format
+ * `YYYY-MM-DD HH:MM:SS[.ffffff]+HH[:MM]` from the buffer
+ * @details This is the format of the output functions, which is decoded
+ * without going through the generic datetime machinery. The function returns
+ * false without consuming any input when the timestamp is not in this format
+ * or is out of the ranges handled here, so that the caller falls back to the
+ * generic parser, which also raises the errors.
+ */
+static bool
+timestamp_parse_iso(const char **str, TimestampTz *result)
+{
+  const char *s = *str;
+  int year, month, day, hour, min, sec, tzhour, tzmin = 0;
+  if (! p_digits(s, 4, &year) || s[4] != '-' ||
+      ! p_digits(s + 5, 2, &month) || s[7] != '-' ||
+      ! p_digits(s + 8, 2, &day) || (s[10] != ' ' && s[10] != 'T') ||
+      ! p_digits(s + 11, 2, &hour) || s[13] != ':' ||
+      ! p_digits(s + 14, 2, &min) || s[16] != ':' ||
+      ! p_digits(s + 17, 2, &sec))
+    return false;
+  s += 19;
+
+  /* Fractional seconds up to the microsecond, which are never rounded */
+  fsec_t fsec = 0;
+  if (*s == '.')
+  {
+    int ndigits = 0;
+    s++;
+    while (*s >= '0' && *s <= '9' && ndigits < 6)
+    {
+      fsec = fsec * 10 + (*s++ - '0');
+      ndigits++;
+    }
+    if (ndigits == 0 || (*s >= '0' && *s <= '9'))
+      return false;
+    for (; ndigits < 6; ndigits++)
+      fsec *= 10;
+  }
+
+  /* Numeric time zone offset */
+  if (*s != '+' && *s != '-')
+    return false;
+  int sign = (*s == '-') ? -1 : 1;
+  if (! p_digits(s + 1, 2, &tzhour))
+    return false;
+  s += 3;
+  if (*s == ':')
+  {
+    if (! p_digits(s + 1, 2, &tzmin))
+      return false;
+    s += 3;
+  }
+
+  /* The timestamp must be followed by a delimiter */
+  while (*s == ' ' || *s == '\n' || *s == '\r' || *s == '\t')
+    s++;
+  if (*s != ',' && *s != ']' && *s != ')' && *s != '}' && *s != '\0')
+    return false;
+
+  /* Ensure the validity of the fields */
+  if (year < 1 || month < 1 || month > MONTHS_PER_YEAR || day < 1 ||
+      day > day_tab[isleap(year)][month - 1] || hour >= HOURS_PER_DAY ||
+      min >= MINS_PER_HOUR || sec >= SECS_PER_MINUTE ||
+      tzhour > MAX_TZDISP_HOUR || tzmin >= MINS_PER_HOUR)
+    return false;
+
+  int64 date = date2j(year, month, day) - POSTGRES_EPOCH_JDATE;
+  int64 time = ((hour * MINS_PER_HOUR + min) * SECS_PER_MINUTE + sec) *
+    USECS_PER_SEC + fsec;
+  int64 tz = sign * (tzhour * MINS_PER_HOUR + tzmin) * SECS_PER_MINUTE;
+  *result = date * USECS_PER_DAY + time - tz * USECS_PER_SEC;
+  *str = s;
+  return true;
+}
+
 /**
  * @brief Parse a timestamp value from the buffer
+ * @details Timestamps in the canonical format are decoded directly, the other
+ * formats are decoded with the generic parser of PostgreSQL.
  * @return On error return DT_NOEND
  */
 TimestampTz
 timestamp_parse(const char **str)
 {
   p_whitespace(str);
+  TimestampTz result;
+  if (timestamp_parse_iso(str, &result))
+    return result;
+
   int pos = 0;
   while ((*str)[pos] != ',' && (*str)[pos] != ']' && (*str)[pos] != ')' &&
     (*str)[pos] != '}' && (*str)[pos] != '\0')
@@ -435,7 +539,7 @@ timestamp_parse(const char **str)
   strncpy(str1, *str, pos);
   str1[pos] = '\0';
   /* The last argument is for an unused typmod */
-  TimestampTz result = pg_timestamptz_in(str1, -1);
+  result = pg_timestamptz_in(str1, -1);
   pfree(str1);
   *str += pos;
   return result;
@@ -685,6 +789,38 @@ tinstant_parse(const char **str, meosType temptype, bool end,
   return true;
 }
 
+/**
+ * @brief Parse a comma-separated list of temporal instants from the buffer
+ * @details The instants are collected in a single pass in an array that is
+ * enlarged as needed
+ * @param[in] str Input string
+ * @param[in] temptype Temporal type
+ * @param[out] count Number of instants
+ * @return On error return @p NULL
+ */
+static TInstant **
+tinstarr_parse(const char **str, meosType temptype, int *count)
+{
+  int maxcount = PARSER_ARRAY_STARTING_SIZE, ninsts = 0;
+  TInstant **instants = palloc(sizeof(TInstant *) * maxcount);
+  do
+  {
+    if (ninsts == maxcount)
+    {
+      maxcount *= 2;
+      instants = repalloc(instants, sizeof(TInstant *) * maxcount);
+    }
+    if (! tinstant_parse(str, temptype, false, &instants[ninsts]))
+    {
+      pfree_array((void **) instants, ninsts);
+      return NULL;
+    }
+    ninsts++;
+  } while (p_comma(str));
+  *count = ninsts;
+  return instants;
+}
+
 /**
  * @brief Parse a temporal discrete sequence from the buffer
  * @param[in] str Input string
@@ -700,29 +836,15 @@ tdiscseq_parse(const char **str, meosType temptype)
    * to call this function in the dispatch function #temporal_parse */
   p_obrace(str);
 
-  /* First parsing */
-  const char *bak = *str;
-  if (! tinstant_parse(str, temptype, false, NULL))
+  int count;
+  TInstant **instants = tinstarr_parse(str, temptype, &count);
+  if (! instants)
     return NULL;
-  int count = 1;
-  while (p_comma(str))
-  {
-    count++;
-    if (! tinstant_parse(str, temptype, false, NULL))
-      return NULL;
-  }
   if (! ensure_cbrace(str, type_str) || ! ensure_end_input(str, type_str))
-    return NULL;
-
-  /* Second parsing */
-  *str = bak;
-  TInstant **instants = palloc(sizeof(TInstant *) * count);
-  for (int i = 0; i < count; i++)
   {
-    p_comma(str);
-    tinstant_parse(str, temptype, false, &instants[i]);
+    pfree_array((void **) instants, count);
+    return NULL;
   }
-  p_cbrace(str);
   return tsequence_make_free(instants, count, true, true, DISCRETE,
     NORMALIZE_NO);
 }
@@ -750,17 +872,10 @@ tcontseq_parse(const char **str, meosType temptype, interpType interp,
   else if (p_oparen(str))
     lower_inc = false;
 
-  /* First parsing */
-  const char *bak = *str;
-  if (! tinstant_parse(str, temptype, false, NULL))
+  int count;
+  TInstant **instants = tinstarr_parse(str, temptype, &count);
+  if (! instants)
     return false;
-  int count = 1;
-  while (p_comma(str))
-  {
-    count++;
-    if (! tinstant_parse(str, temptype, false, NULL))
-      return false;
-  }
   if (p_cbracket(str))
     upper_inc = true;
   else if (p_cparen(str))
@@ -770,22 +885,16 @@ tcontseq_parse(const char **str, meosType temptype, interpType interp,
     meos_error(ERROR, MEOS_ERR_TEXT_INPUT,
       "Could not parse %s value: Missing closing bracket/parenthesis",
       meostype_name(temptype));
-      return false;
+    pfree_array((void **) instants, count);
+    return false;
   }
   /* Ensure there is no more input */
   if (end && ! ensure_end_input(str, meostype_name(temptype)))
-    return NULL;
-
-  /* Second parsing */
-  *str = bak;
-  TInstant **instants = palloc(sizeof(TInstant *) * count);
-  for (int i = 0; i < count; i++)
   {
-    p_comma(str);
-    tinstant_parse(str, temptype, false, &instants[i]);
+    pfree_array((void **) instants, count);
+    return false;
   }
-  p_cbracket(str);
-  p_cparen(str);
+
   if (result)
     *result = tsequence_make((const TInstant **) instants, count,
       lower_inc, upper_inc, interp, NORMALIZE);
@@ -809,29 +918,27 @@ tsequenceset_parse(const char **str, meosType temptype, interpType interp)
    * to call this function in the dispatch function temporal_parse */
   p_obrace(str);
 
-  /* First parsing */
-  const char *bak = *str;
-  if (! tcontseq_parse(str, temptype, interp, false, NULL))
-    return NULL;
-  int count = 1;
-  while (p_comma(str))
+  int maxcount = PARSER_ARRAY_STARTING_SIZE, count = 0;
+  TSequence **sequences = palloc(sizeof(TSequence *) * maxcount);
+  do
   {
-    count++;
-    if (! tcontseq_parse(str, temptype, interp, false, NULL))
+    if (count == maxcount)
+    {
+      maxcount *= 2;
+      sequences = repalloc(sequences, sizeof(TSequence *) * maxcount);
+    }
+    if (! tcontseq_parse(str, temptype, interp, false, &sequences[count]))
+    {
+      pfree_array((void **) sequences, count);
       return NULL;
-  }
+    }
+    count++;
+  } while (p_comma(str));
   if (! ensure_cbrace(str, type_str) || ! ensure_end_input(str, type_str))
-    return NULL;
-
-  /* Second parsing */
-  *str = bak;
-  TSequence **sequences = palloc(sizeof(TSequence *) * count);
-  for (int i = 0; i < count; i++)
   {
-    p_comma(str);
-    tcontseq_parse(str, temptype, interp, false, &sequences[i]);
+    pfree_array((void **) sequences, count);
+    return NULL;
   }
-  p_cbrace(str);
   return tsequenceset_make_free(sequences, count, NORMALIZE);
 }
 
@@ -637,6 +637,67 @@ datumarr_sort(Datum *values, int count, meosType type)
   return;
 }
 
+/**
+ * @brief Sort function for datums of an integer, a date, or a timestamptz
+ * type using a radix sort
+ * @details The values are mapped to unsigned keys preserving their order,
+ * which are sorted with a least significant digit radix sort on 8-bit digits
+ * in linear time. The passes on a digit that is equal for all the values,
+ * such as the high-order digits of identifiers or timestamps close to each
+ * other, are skipped.
+ * @note Small arrays are sorted with #datumarr_sort()
+ */
+void
+datumarr_radix_sort(Datum *values, int count, meosType type)
+{
+  assert(type == T_INT4 || type == T_INT8 || type == T_DATE ||
+    type == T_TIMESTAMPTZ);
+  if (count < 64)
+  {
+    datumarr_sort(values, count, type);
+    return;
+  }
+
+  /* Map the values to unsigned keys by flipping the sign bit */
+  bool is32 = (type == T_INT4 || type == T_DATE);
+  uint64 *keys = palloc(sizeof(uint64) * count);
+  uint64 *buf = palloc(sizeof(uint64) * count);
+  for (int i = 0; i < count; i++)
+    keys[i] = is32 ?
+      (uint64) ((uint32) DatumGetInt32(values[i]) ^ 0x80000000U) :
+      (uint64) DatumGetInt64(values[i]) ^ UINT64CONST(0x8000000000000000);
+
+  int ndigits = is32 ? 4 : 8;
+  for (int d = 0; d < ndigits; d++)
+  {
+    int shift = d * 8;
+    int hist[256] = {0};
+    for (int i = 0; i < count; i++)
+      hist[(keys[i] >> shift) & 0xFF]++;
+    /* Skip the pass if all the values have the same digit */
+    if (hist[(keys[0] >> shift) & 0xFF] == count)
+      continue;
+    int pos = 0;
+    for (int b = 0; b < 256; b++)
+    {
+      int n = hist[b];
+      hist[b] = pos;
+      pos += n;
+    }
+    for (int i = 0; i < count; i++)
+      buf[hist[(keys[i] >> shift) & 0xFF]++] = keys[i];
+    uint64 *tmp = keys; keys = buf; buf = tmp;
+  }
+
+  /* Map the keys back to the values */
+  for (int i = 0; i < count; i++)
+    values[i] = is32 ?
+      Int32GetDatum((int32) ((uint32) keys[i] ^ 0x80000000U)) :
+      Int64GetDatum((int64) (keys[i] ^ UINT64CONST(0x8000000000000000)));
+  pfree(keys); pfree(buf);
+  return;
+}
+
 /**
  * @brief Sort function for timestamptz values
  */
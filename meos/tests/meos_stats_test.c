@@ -0,0 +1,156 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the instrumentation counters of the hot
+ * paths of MEOS
+ *
+ * The program is only built when the library is built with the CMake option
+ * `MEOS_STATS`. It verifies that
+ * - every counter has a name and an invalid counter is rejected with an
+ *   error;
+ * - the constructions of temporal sequences and sequence sets increment
+ *   their counters;
+ * - `meos_stats_reset()` sets all the counters to zero.
+ *
+ * The program returns a nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o meos_stats_test meos_stats_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <meos.h>
+#include <meos_internal.h>
+#include "meos_test.h"
+
+/* Number of instants of the sequences */
+#define NO_INSTANTS 10
+/* Number of sequences constructed */
+#define NO_SEQUENCES 5
+
+/*****************************************************************************/
+
+/* Verify that all the counters are zero */
+static void
+check_zero(const char *msg)
+{
+  MeosStat stats[MEOS_STAT_COUNT];
+  if (! meos_stats_get(stats))
+  {
+    test_fail("%s: the library does not maintain the counters", msg);
+    return;
+  }
+  for (int i = 0; i < MEOS_STAT_COUNT; i++)
+  {
+    if (stats[i].calls != 0 || stats[i].nsecs != 0)
+      test_fail("%s: counter %s is not zero", msg,
+        meos_stat_name((meosStatType) i));
+  }
+  return;
+}
+
+/* Verify the names of the counters */
+static void
+test_names(void)
+{
+  for (int i = 0; i < MEOS_STAT_COUNT; i++)
+  {
+    if (! meos_stat_name((meosStatType) i))
+      test_fail("name of the counter %d", i);
+  }
+  nerrors = 0;
+  if (meos_stat_name((meosStatType) MEOS_STAT_COUNT) || nerrors == 0)
+    test_fail("name of an invalid counter");
+  return;
+}
+
+/* Verify the counters of the constructions of sequences and sequence sets */
+static void
+test_counters(void)
+{
+  TInstant *instants[NO_INSTANTS];
+  for (int i = 0; i < NO_INSTANTS; i++)
+    instants[i] = tinstant_make(Float8GetDatum((double) i), T_TFLOAT,
+      (TimestampTz) i * USECS_PER_SEC);
+  /* Only the constructions below are counted */
+  meos_stats_reset();
+  check_zero("reset before the constructions");
+  TSequence *sequences[NO_SEQUENCES];
+  for (int i = 0; i < NO_SEQUENCES; i++)
+    sequences[i] = tsequence_make((const TInstant **) instants, NO_INSTANTS,
+      true, true, LINEAR, true);
+  TSequenceSet *ss = tsequenceset_make((const TSequence **) sequences, 1,
+    true);
+
+  MeosStat stats[MEOS_STAT_COUNT];
+  if (! meos_stats_get(stats))
+    test_fail("the library does not maintain the counters");
+  else
+  {
+    if (stats[MEOS_STAT_TSEQUENCE_MAKE].calls < NO_SEQUENCES)
+      test_fail("calls of tsequence_make: %llu",
+        (unsigned long long) stats[MEOS_STAT_TSEQUENCE_MAKE].calls);
+    if (stats[MEOS_STAT_TSEQUENCESET_MAKE].calls == 0)
+      test_fail("calls of tsequenceset_make: %llu",
+        (unsigned long long) stats[MEOS_STAT_TSEQUENCESET_MAKE].calls);
+  }
+
+  meos_stats_reset();
+  check_zero("reset after the constructions");
+
+  for (int i = 0; i < NO_INSTANTS; i++)
+    free(instants[i]);
+  for (int i = 0; i < NO_SEQUENCES; i++)
+    free(sequences[i]);
+  free(ss);
+  return;
+}
+
+/*****************************************************************************/
+
+int
+main(void)
+{
+  /* Initialize MEOS */
+  test_initialize();
+  meos_initialize_error_handler(&test_count_errors);
+
+  test_names();
+  test_counters();
+
+  /* Finalize MEOS */
+  return test_finalize();
+}
+
+/*****************************************************************************/
@@ -0,0 +1,180 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Definitions shared by the test programs of MEOS and by the MEOS
+ * microbenchmarks
+ *
+ * The header defines the counters of failed checks and of errors raised by
+ * MEOS, the functions that initialize and finalize MEOS for a test program,
+ * and the pseudo-random generator used to build the random inputs. Since
+ * every program is a single translation unit, all the definitions are
+ * static.
+ */
+
+#ifndef __MEOS_TEST_H__
+#define __MEOS_TEST_H__
+
+/* C */
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+/* MEOS */
+#include <meos.h>
+
+/*****************************************************************************
+ * Pseudo-random generator
+ *****************************************************************************/
+
+/* State of the pseudo-random generator */
+static uint64_t rnd_state = 1;
+
+/**
+ * @brief Set the seed of the pseudo-random generator
+ */
+static inline void
+rnd_seed(uint64_t seed)
+{
+  rnd_state = seed;
+  return;
+}
+
+/**
+ * @brief Return a pseudo-random 64-bit integer
+ * @details The SplitMix64 generator is used instead of `rand()` so that the
+ * programs generate the same inputs on every platform
+ */
+static inline uint64_t
+rnd64(void)
+{
+  uint64_t z = (rnd_state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief Return a pseudo-random number in [0, 1)
+ */
+static inline double
+rnd(void)
+{
+  return (double) (rnd64() >> 11) / (double) (1ULL << 53);
+}
+
+/**
+ * @brief Return a pseudo-random integer in [0, n)
+ */
+static inline int
+rnd_int(int n)
+{
+  return (int) (rnd() * n);
+}
+
+/*****************************************************************************
+ * Checks
+ *****************************************************************************/
+
+/* Number of failed checks */
+static int nfailures = 0;
+/* Number of errors raised by MEOS since the last reset of the counter */
+static int nerrors = 0;
+
+/**
+ * @brief Error handler that counts the errors instead of exiting
+ * @details It is set with `meos_initialize_error_handler()` by the programs
+ * that verify that some inputs are rejected with an error
+ */
+static inline void
+test_count_errors(int errlevel, int errcode, const char *errmsg)
+{
+  (void) errlevel; (void) errcode; (void) errmsg;
+  nerrors++;
+  return;
+}
+
+/**
+ * @brief Report a failed check with a message in the format of `printf()`
+ */
+static inline void
+test_fail(const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  printf("FAILED ");
+  vprintf(format, args);
+  printf("\n");
+  va_end(args);
+  nfailures++;
+  return;
+}
+
+/*****************************************************************************
+ * Initialization and finalization
+ *****************************************************************************/
+
+/**
+ * @brief Initialize MEOS for a test program
+ * @details The location of the `spatial_ref_sys.csv` file is given by the
+ * build when the program is run from the source tree
+ */
+static inline void
+test_initialize(void)
+{
+  meos_initialize();
+  meos_initialize_timezone("UTC");
+#ifdef MEOS_TEST_SPATIAL_REF_SYS_CSV
+  meos_set_spatial_ref_sys_csv(MEOS_TEST_SPATIAL_REF_SYS_CSV);
+#endif
+  return;
+}
+
+/**
+ * @brief Finalize MEOS, report the number of failed checks, and return the
+ * exit status of a test program
+ */
+static inline int
+test_finalize(void)
+{
+  meos_finalize();
+  if (nfailures)
+  {
+    printf("%d checks failed\n", nfailures);
+    return EXIT_FAILURE;
+  }
+  printf("All checks passed\n");
+  return EXIT_SUCCESS;
+}
+
+/*****************************************************************************/
+
+#endif /* __MEOS_TEST_H__ */
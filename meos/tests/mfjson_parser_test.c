@@ -0,0 +1,399 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the incremental parser of the MF-JSON
+ * representation of temporal values against the function
+ * `temporal_from_mfjson()`
+ *
+ * The program verifies that
+ * - the parser gives the same result whatever the position at which the
+ *   input is split into chunks, including inside strings, numbers, literals,
+ *   and escape sequences;
+ * - the members of the MF-JSON object can be given in any order when the
+ *   temporal type is known in advance, and that otherwise the `type` member
+ *   must precede the values;
+ * - malformed inputs are rejected with an error instead of a crash.
+ *
+ * The program returns a nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o mfjson_parser_test mfjson_parser_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal.h>
+#include "meos_test.h"
+
+/* Maximum number of members of the objects permuted */
+#define MAX_MEMBERS 8
+/* Size of the buffer holding the permuted objects */
+#define MAX_LENGTH 1024
+
+/* Parse a string fed in chunks of at most chunk characters after a first
+ * chunk of first characters */
+static Temporal *
+parse(const char *input, meosType temptype, size_t first, size_t chunk)
+{
+  MfjsonParser *parser = mfjson_parser_make(temptype);
+  size_t len = strlen(input);
+  if (first > len)
+    first = len;
+  mfjson_parser_feed(parser, input, first);
+  for (size_t pos = first; pos < len; pos += chunk)
+    mfjson_parser_feed(parser, input + pos,
+      len - pos < chunk ? len - pos : chunk);
+  return mfjson_parser_end(parser);
+}
+
+/* Return true if the result of the parser is equal to the expected one */
+static bool
+check_equal(Temporal *result, const Temporal *expected)
+{
+  bool eq = result && nerrors == 0 && temporal_eq(result, expected);
+  free(result);
+  return eq;
+}
+
+/*****************************************************************************/
+
+/* Valid inputs, written by hand to cover escape sequences, numbers in all
+ * formats, bounding boxes, and members ignored by the parser */
+static const char *valid_inputs[] = {
+  "{\"type\":\"MovingBoolean\",\"values\":[true],"
+    "\"datetimes\":[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingInteger\",\"period\":{\"begin\":\"2000-01-01T00:00:00+00\","
+    "\"end\":\"2000-01-03T00:00:00+00\",\"lower_inc\":true,\"upper_inc\":true},"
+    "\"values\":[-1,20,-300],\"datetimes\":[\"2000-01-01T00:00:00+00\","
+    "\"2000-01-02T00:00:00+00\",\"2000-01-03T00:00:00+00\"],"
+    "\"interpolation\":\"Discrete\"}",
+  " { \"type\" : \"MovingFloat\" , \"values\" : [ 1.5 , -2.5e1 , 3E-2 , 0 ] ,\n"
+    "\t\"datetimes\" : [ \"2000-01-01T00:00:00+00\" , \"2000-01-02T00:00:00+00\" ,"
+    " \"2000-01-03T00:00:00+00\" , \"2000-01-04T00:00:00+00\" ] ,\r\n"
+    " \"lower_inc\" : false , \"upper_inc\" : true , \"interpolation\" : \"Linear\" } ",
+  "{\"type\":\"MovingFloat\",\"sequences\":[{\"values\":[1,2],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\",\"2000-01-02T00:00:00+00\"],\"lower_inc\":true,"
+    "\"upper_inc\":true},{\"values\":[3,3],\"datetimes\":"
+    "[\"2000-01-03T00:00:00+00\",\"2000-01-04T00:00:00+00\"],\"lower_inc\":true,"
+    "\"upper_inc\":true}],\"interpolation\":\"Step\"}",
+  "{\"type\":\"MovingText\",\"values\":[\"a\\\"b\\\\c\\/d\\n\",\"\\u00e9\\u20AC\","
+    "\"\\ud83d\\ude00 \xc3\xa9\"],\"datetimes\":[\"2000-01-01T00:00:00+00\","
+    "\"2000-01-02T00:00:00+00\",\"2000-01-03T00:00:00+00\"],\"lower_inc\":true,"
+    "\"upper_inc\":true,\"interpolation\":\"Step\"}",
+  "{\"type\":\"MovingPoint\",\"crs\":{\"type\":\"Name\",\"properties\":"
+    "{\"name\":\"EPSG:3857\"}},\"stBoundedBy\":{\"bbox\":[1,1,3,3]},"
+    "\"coordinates\":[[1,1],[2.5,2],[3,3]],\"datetimes\":[\"2000-01-01T00:00:00+00\","
+    "\"2000-01-02T00:00:00+00\",\"2000-01-03T00:00:00+00\"],\"lower_inc\":true,"
+    "\"upper_inc\":false,\"interpolation\":\"Linear\"}",
+  "{\"type\":\"MovingPoint\",\"sequences\":[{\"coordinates\":[[1,1,1],[2,2,2]],"
+    "\"datetimes\":[\"2000-01-01T00:00:00+00\",\"2000-01-02T00:00:00+00\"],"
+    "\"lower_inc\":true,\"upper_inc\":true},{\"coordinates\":[[3,3,3]],"
+    "\"datetimes\":[\"2000-01-03T00:00:00+00\"],\"lower_inc\":true,"
+    "\"upper_inc\":true}],\"interpolation\":\"Linear\"}",
+};
+
+/* Temporal types of the valid inputs */
+static const meosType valid_types[] = {
+  T_TBOOL, T_TINT, T_TFLOAT, T_TFLOAT, T_TTEXT, T_TGEOMPOINT, T_TGEOMPOINT
+};
+
+/* Verify that the parser gives the same result as temporal_from_mfjson
+ * wherever the input is split, and when it is fed one character at a time */
+static void
+test_chunks(void)
+{
+  int ninputs = (int) (sizeof(valid_inputs) / sizeof(char *));
+  for (int i = 0; i < ninputs; i++)
+  {
+    const char *input = valid_inputs[i];
+    Temporal *expected = temporal_from_mfjson(input, valid_types[i]);
+    if (! expected)
+    {
+      test_fail("temporal_from_mfjson: %s", input);
+      continue;
+    }
+    size_t len = strlen(input);
+    for (size_t first = 0; first <= len; first++)
+    {
+      nerrors = 0;
+      Temporal *result = parse(input, valid_types[i], first, len);
+      if (! check_equal(result, expected))
+        test_fail("chunk boundary at %zu: %s", first, input);
+    }
+    nerrors = 0;
+    if (! check_equal(parse(input, valid_types[i], 0, 1), expected))
+      test_fail("one character chunks: %s", input);
+    /* The temporal type is also read from the input */
+    nerrors = 0;
+    if (valid_types[i] != T_TGEOMPOINT &&
+        ! check_equal(parse(input, T_UNKNOWN, 0, 7), expected))
+      test_fail("unknown temporal type: %s", input);
+    free(expected);
+  }
+  printf("Chunk boundaries: %d inputs verified\n", ninputs);
+  return;
+}
+
+/*****************************************************************************/
+
+/* Build an object from the members in the order given by perm */
+static void
+make_object(char *buf, const char **members, const int *perm, int count)
+{
+  char *pos = buf;
+  pos += sprintf(pos, "{");
+  for (int i = 0; i < count; i++)
+    pos += sprintf(pos, "%s%s", i ? "," : "", members[perm[i]]);
+  sprintf(pos, "}");
+  return;
+}
+
+/* Move to the next permutation in lexicographic order, return false after
+ * the last one */
+static bool
+next_perm(int *perm, int count)
+{
+  int i = count - 2;
+  while (i >= 0 && perm[i] >= perm[i + 1])
+    i--;
+  if (i < 0)
+    return false;
+  int j = count - 1;
+  while (perm[j] <= perm[i])
+    j--;
+  int tmp = perm[i]; perm[i] = perm[j]; perm[j] = tmp;
+  for (int l = i + 1, r = count - 1; l < r; l++, r--)
+  {
+    tmp = perm[l]; perm[l] = perm[r]; perm[r] = tmp;
+  }
+  return true;
+}
+
+/* Verify all the orders of the members of an object. The member at position
+ * 0 is the type and the one at position 1 holds the values. */
+static void
+test_permutations(const char *name, const char **members, int count,
+  meosType temptype)
+{
+  char input[MAX_LENGTH];
+  int perm[MAX_MEMBERS];
+  for (int i = 0; i < count; i++)
+    perm[i] = i;
+  make_object(input, members, perm, count);
+  Temporal *expected = temporal_from_mfjson(input, temptype);
+  if (! expected)
+  {
+    test_fail("temporal_from_mfjson: %s", input);
+    return;
+  }
+  int nperms = 0;
+  do
+  {
+    make_object(input, members, perm, count);
+    /* Position of the type and of the values */
+    int typepos = 0, valpos = 0;
+    for (int i = 0; i < count; i++)
+    {
+      if (perm[i] == 0)
+        typepos = i;
+      else if (perm[i] == 1)
+        valpos = i;
+    }
+    /* With a known temporal type any order is valid */
+    nerrors = 0;
+    if (! check_equal(parse(input, temptype, 0, 5), expected))
+      test_fail("member order: %s", input);
+    /* Otherwise the type must precede the values */
+    if (temptype != T_TGEOMPOINT)
+    {
+      nerrors = 0;
+      Temporal *result = parse(input, T_UNKNOWN, 0, 5);
+      if (typepos < valpos)
+      {
+        if (! check_equal(result, expected))
+          test_fail("member order with unknown type: %s", input);
+      }
+      else if (result || nerrors == 0)
+      {
+        free(result);
+        test_fail("type after the values with unknown type: %s", input);
+      }
+    }
+    nperms++;
+  } while (next_perm(perm, count));
+  free(expected);
+  printf("Member orders of %s: %d permutations verified\n", name, nperms);
+  return;
+}
+
+/*****************************************************************************/
+
+/* Malformed inputs */
+static const char *invalid_inputs[] = {
+  "",
+  "{",
+  "[]",
+  "{\"type\":\"MovingFloat\",\"values\":[1],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"]}",
+  "{\"values\":[1],\"datetimes\":[\"2000-01-01T00:00:00+00\"],"
+    "\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingFoo\",\"values\":[1],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingInteger\",\"values\":[1],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingFloat\",\"values\":[1,2],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"Linear\"}",
+  "{\"type\":\"MovingFloat\",\"values\":[1],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}}",
+  "{\"type\":\"MovingFloat\",\"values\":[1],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"} x",
+  "{\"type\":\"MovingFloat\",\"values\":[1],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"} \"x",
+  "{\"type\":\"MovingFloat\",\"values\":[1,],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingFloat\",\"values\":[1..5],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingFloat\",\"values\":[\"a\"],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingFloat\",\"values\":[1],\"values\":[2],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingFloat\",\"values\":[1],\"datetimes\":"
+    "[\"2000-13-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingFloat\",\"values\":[1],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"Foo\"}",
+  "{\"type\":\"MovingFl",
+  "{\"type\":\"MovingText\",\"values\":[\"\\x\"],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingText\",\"values\":[\"\\u00G0\"],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingBoolean\",\"values\":[tru],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingPoint\",\"coordinates\":[[1]],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingPoint\",\"coordinates\":[[1,2],[1,2,3]],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\",\"2000-01-02T00:00:00+00\"],"
+    "\"interpolation\":\"Linear\"}",
+  "{\"type\":\"MovingPoint\",\"coordinates\":[1,2],\"datetimes\":"
+    "[\"2000-01-01T00:00:00+00\"],\"interpolation\":\"None\"}",
+  "{\"type\":\"MovingFloat\",\"sequences\":[],\"interpolation\":\"Linear\"}",
+  "{\"type\":\"MovingFloat\",\"values\":[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[["
+    "[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[",
+};
+
+/* Temporal types given to the parser for the malformed inputs */
+static const meosType invalid_types[] = {
+  T_TFLOAT, T_TFLOAT, T_TFLOAT, T_TFLOAT, T_UNKNOWN, T_UNKNOWN, T_TFLOAT,
+  T_TFLOAT, T_TFLOAT, T_TFLOAT, T_TFLOAT, T_TFLOAT, T_TFLOAT, T_TFLOAT,
+  T_TFLOAT, T_TFLOAT, T_TFLOAT, T_TFLOAT, T_TTEXT, T_TTEXT, T_TBOOL,
+  T_TGEOMPOINT, T_TGEOMPOINT, T_TGEOMPOINT, T_TFLOAT, T_TFLOAT
+};
+
+/* Verify that the malformed inputs are rejected with an error whatever the
+ * size of the chunks */
+static void
+test_invalid(void)
+{
+  int ninputs = (int) (sizeof(invalid_inputs) / sizeof(char *));
+  if (ninputs != (int) (sizeof(invalid_types) / sizeof(meosType)))
+  {
+    test_fail("number of malformed inputs");
+    return;
+  }
+  for (int i = 0; i < ninputs; i++)
+  {
+    size_t chunks[] = {1, 3, MAX_LENGTH};
+    for (int j = 0; j < 3; j++)
+    {
+      nerrors = 0;
+      Temporal *result = parse(invalid_inputs[i], invalid_types[i], 0,
+        chunks[j]);
+      if (result || nerrors == 0)
+      {
+        free(result);
+        test_fail("malformed input accepted: %s", invalid_inputs[i]);
+      }
+    }
+  }
+  printf("Malformed inputs: %d inputs verified\n", ninputs);
+  return;
+}
+
+/*****************************************************************************/
+
+int
+main(void)
+{
+  /* Initialize MEOS */
+  test_initialize();
+  meos_initialize_error_handler(&test_count_errors);
+
+  test_chunks();
+
+  const char *tfloat_members[] = {
+    "\"type\":\"MovingFloat\"",
+    "\"values\":[1.5,2.5,3]",
+    "\"datetimes\":[\"2000-01-01T00:00:00+00\",\"2000-01-02T00:00:00+00\","
+      "\"2000-01-03T00:00:00+00\"]",
+    "\"lower_inc\":true",
+    "\"upper_inc\":false",
+    "\"interpolation\":\"Linear\"",
+  };
+  test_permutations("tfloat", tfloat_members, 6, T_TFLOAT);
+
+  const char *ttext_members[] = {
+    "\"type\":\"MovingText\"",
+    "\"values\":[\"a\",\"bc\"]",
+    "\"datetimes\":[\"2000-01-01T00:00:00+00\",\"2000-01-02T00:00:00+00\"]",
+    "\"interpolation\":\"Discrete\"",
+    "\"lower_inc\":true",
+  };
+  test_permutations("ttext", ttext_members, 5, T_TTEXT);
+
+  const char *tgeompoint_members[] = {
+    "\"type\":\"MovingPoint\"",
+    "\"coordinates\":[[1,1],[2,2]]",
+    "\"datetimes\":[\"2000-01-01T00:00:00+00\",\"2000-01-02T00:00:00+00\"]",
+    "\"crs\":{\"type\":\"Name\",\"properties\":{\"name\":\"EPSG:3857\"}}",
+    "\"upper_inc\":true",
+    "\"interpolation\":\"Step\"",
+  };
+  test_permutations("tgeompoint", tgeompoint_members, 6, T_TGEOMPOINT);
+
+  test_invalid();
+
+  /* Finalize MEOS */
+  return test_finalize();
+}
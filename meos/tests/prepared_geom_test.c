@@ -0,0 +1,391 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the spatial relationships of temporal
+ * points computed segment by segment with a geometry prepared by GEOS
+ *
+ * The program verifies the functions `eintersects_tgeo_geo()`,
+ * `aintersects_tgeo_geo()`, `edisjoint_tgeo_geo()`, `adisjoint_tgeo_geo()`,
+ * and `acovers_geo_tgeo()` against the relationship computed with the
+ * trajectory of the temporal point. It first tests sequences of many
+ * segments in which the result is decided by the first, a middle, or the
+ * last segment, so that the segments are no longer tested once the result
+ * is known. It then tests random temporal points against geometries taken
+ * again and again, in which the prepared geometry is found in the cache,
+ * and against more geometries than the cache keeps, in which the prepared
+ * geometries are evicted from the cache. The restriction of the temporal
+ * points to the geometries, which also uses the cache, must return the same
+ * result on every call. The program returns a nonzero exit status on
+ * failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o prepared_geom_test prepared_geom_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include "meos_test.h"
+
+/* SRID of the values */
+#define SRID 3857
+/* Number of instants of the sequences testing the early exit */
+#define LONG_INSTANTS 1000
+/* Maximum number of instants of a random value */
+#define MAX_INSTANTS 30
+/* Number of random values */
+#define NO_VALUES 20
+/* Number of geometries, which is greater than the number of prepared
+ * geometries kept in the cache */
+#define NO_GEOMS 600
+/* Number of microseconds in a minute */
+#define USECS_PER_MINUTE INT64CONST(60000000)
+
+/* Origin of the timestamps */
+static TimestampTz t0;
+
+/*****************************************************************************/
+
+/* Return a geometry from its WKT representation */
+static GSERIALIZED *
+make_geom(const char *wkt)
+{
+  char ewkt[256];
+  snprintf(ewkt, sizeof(ewkt), "SRID=%d;%s", SRID, wkt);
+  return geom_in(ewkt, -1);
+}
+
+/* Return an L-shaped polygon whose lower left corner is (x, y) and whose
+ * side is 2 * s, which is not convex so that a segment between two points of
+ * the polygon may not be covered by it */
+static GSERIALIZED *
+make_lshape(int x, int y, int s)
+{
+  char wkt[256];
+  snprintf(wkt, sizeof(wkt), "POLYGON((%d %d,%d %d,%d %d,%d %d,%d %d,%d %d,"
+    "%d %d))", x, y, x + 2 * s, y, x + 2 * s, y + s, x + s, y + s, x + s,
+    y + 2 * s, x, y + 2 * s, x, y);
+  return make_geom(wkt);
+}
+
+/* Return a temporal point from arrays of coordinates, whose timestamps are
+ * one minute apart from the one of the @p start instant */
+static Temporal *
+make_tpoint(const double *x, const double *y, int start, int count,
+  interpType interp)
+{
+  TInstant **instants = malloc(sizeof(TInstant *) * count);
+  for (int i = 0; i < count; i++)
+  {
+    GSERIALIZED *gs = geompoint_make2d(SRID, x[start + i], y[start + i]);
+    instants[i] = tpointinst_make(gs, t0 + (start + i) * USECS_PER_MINUTE);
+    free(gs);
+  }
+  Temporal *result = (Temporal *) tsequence_make((const TInstant **) instants,
+    count, true, true, interp, false);
+  for (int i = 0; i < count; i++)
+    free(instants[i]);
+  free(instants);
+  return result;
+}
+
+/* Return a random temporal point with integral coordinates in [0, 100) */
+static Temporal *
+random_tpoint(void)
+{
+  double x[MAX_INSTANTS], y[MAX_INSTANTS];
+  int count = 1 + rnd_int(MAX_INSTANTS);
+  for (int i = 0; i < count; i++)
+  {
+    x[i] = rnd_int(100);
+    y[i] = rnd_int(100);
+  }
+  /* Instants, discrete sequences, linear sequences, and sequence sets */
+  int kind = rnd_int(4);
+  if (kind == 0)
+    count = 1;
+  if (kind < 3 || count < 4)
+  {
+    Temporal *seq = make_tpoint(x, y, 0, count,
+      kind == 1 ? DISCRETE : LINEAR);
+    if (kind != 0)
+      return seq;
+    Temporal *result = (Temporal *) temporal_to_tinstant(seq);
+    free(seq);
+    return result;
+  }
+  /* Two sequences without instantaneous ones */
+  TSequence *seqs[2];
+  seqs[0] = (TSequence *) make_tpoint(x, y, 0, count / 2, LINEAR);
+  seqs[1] = (TSequence *) make_tpoint(x, y, count / 2, count - count / 2,
+    LINEAR);
+  Temporal *result = (Temporal *) tsequenceset_make((const TSequence **) seqs,
+    2, false);
+  free(seqs[0]); free(seqs[1]);
+  return result;
+}
+
+/*****************************************************************************/
+
+/* Relationships verified */
+typedef enum
+{
+  EINTERSECTS,
+  AINTERSECTS,
+  EDISJOINT,
+  ADISJOINT,
+  ACOVERS,
+} relType;
+
+#define NO_RELS 5
+
+static const char *rel_names[] =
+  {"eIntersects", "aIntersects", "eDisjoint", "aDisjoint", "aCovers"};
+
+/* Return a relationship computed segment by segment */
+static int
+rel_segm(relType rel, const Temporal *temp, const GSERIALIZED *gs)
+{
+  switch (rel)
+  {
+    case EINTERSECTS:
+      return eintersects_tgeo_geo(temp, gs);
+    case AINTERSECTS:
+      return aintersects_tgeo_geo(temp, gs);
+    case EDISJOINT:
+      return edisjoint_tgeo_geo(temp, gs);
+    case ADISJOINT:
+      return adisjoint_tgeo_geo(temp, gs);
+    default: /* ACOVERS */
+      return acovers_geo_tgeo(gs, temp);
+  }
+}
+
+/* Return a relationship computed with the trajectory of a temporal point */
+static int
+rel_traj(relType rel, const Temporal *temp, const GSERIALIZED *gs)
+{
+  GSERIALIZED *traj = tpoint_trajectory(temp, false);
+  bool intersects = geom_intersects2d(traj, gs);
+  bool covers = geom_covers(gs, traj);
+  free(traj);
+  switch (rel)
+  {
+    case EINTERSECTS:
+      return intersects ? 1 : 0;
+    case AINTERSECTS:
+      return covers ? 1 : 0;
+    case EDISJOINT:
+      return covers ? 0 : 1;
+    case ADISJOINT:
+      return intersects ? 0 : 1;
+    default: /* ACOVERS */
+      return covers ? 1 : 0;
+  }
+}
+
+/* Verify a relationship against the one computed with the trajectory */
+static void
+check_rel(const char *name, relType rel, const Temporal *temp,
+  const GSERIALIZED *gs, int expected)
+{
+  int result = rel_segm(rel, temp, gs);
+  if (expected < 0)
+    expected = rel_traj(rel, temp, gs);
+  if (result != expected)
+  {
+    char *str = tspatial_as_text(temp, 0);
+    char *gstr = geo_as_text(gs, 0);
+    test_fail("%s %s: %s and %s returned %d instead of %d", name,
+      rel_names[rel], str, gstr, result, expected);
+    free(str); free(gstr);
+  }
+  return;
+}
+
+/*****************************************************************************/
+
+/* Verify the relationships with long sequences in which the result is known
+ * after testing the first, a middle, or the last segment */
+static void
+test_early_exit(void)
+{
+  double x[LONG_INSTANTS], y[LONG_INSTANTS];
+  /* Square [0, 10] x [0, 10] and L-shaped polygon without [5, 10] x [5, 10] */
+  GSERIALIZED *square = make_geom("POLYGON((0 0,10 0,10 10,0 10,0 0))");
+  GSERIALIZED *lshape = make_lshape(0, 0, 5);
+  /* The points move back and forth inside the bounding box of the square */
+  for (int i = 0; i < LONG_INSTANTS; i++)
+  {
+    x[i] = 1 + (i % 3);
+    y[i] = 1 + (i % 4);
+  }
+  Temporal *inside = make_tpoint(x, y, 0, LONG_INSTANTS, LINEAR);
+  /* A single segment in the notch of the L-shaped polygon */
+  x[LONG_INSTANTS / 2] = 8; y[LONG_INSTANTS / 2] = 8;
+  Temporal *notch = make_tpoint(x, y, 0, LONG_INSTANTS, LINEAR);
+  check_rel("early exit", ACOVERS, inside, square, 1);
+  check_rel("early exit", ACOVERS, inside, lshape, 1);
+  check_rel("early exit", ACOVERS, notch, square, 1);
+  check_rel("early exit", ACOVERS, notch, lshape, 0);
+  check_rel("early exit", EDISJOINT, notch, lshape, 1);
+  check_rel("early exit", AINTERSECTS, notch, lshape, 0);
+
+  /* Points outside the square except in the first, a middle, or the last
+   * segment */
+  for (int i = 0; i < LONG_INSTANTS; i++)
+  {
+    x[i] = 20 + (i % 3);
+    y[i] = (i % 2) ? -5 : 15;
+  }
+  Temporal *outside = make_tpoint(x, y, 0, LONG_INSTANTS, LINEAR);
+  check_rel("early exit", EINTERSECTS, outside, square, 0);
+  check_rel("early exit", ADISJOINT, outside, square, 1);
+  check_rel("early exit", ACOVERS, outside, square, 0);
+  int pos[] = {0, LONG_INSTANTS / 2, LONG_INSTANTS - 1};
+  for (int k = 0; k < 3; k++)
+  {
+    double oldx = x[pos[k]];
+    x[pos[k]] = 5;
+    Temporal *temp = make_tpoint(x, y, 0, LONG_INSTANTS, LINEAR);
+    check_rel("early exit", EINTERSECTS, temp, square, 1);
+    check_rel("early exit", ADISJOINT, temp, square, 0);
+    check_rel("early exit", EINTERSECTS, temp, lshape, -1);
+    free(temp);
+    x[pos[k]] = oldx;
+  }
+
+  free(inside); free(notch); free(outside);
+  free(square); free(lshape);
+  return;
+}
+
+/* Verify the relationships and the restriction of random temporal points
+ * with geometries found in and evicted from the cache of prepared geometries
+ */
+static void
+test_cache(void)
+{
+  Temporal *values[NO_VALUES];
+  GSERIALIZED *geoms[NO_GEOMS];
+  /* Expected results and restrictions to the first geometry */
+  static int expected[NO_VALUES][NO_GEOMS][NO_RELS];
+  Temporal *at[NO_VALUES];
+
+  for (int i = 0; i < NO_VALUES; i++)
+    values[i] = random_tpoint();
+  for (int j = 0; j < NO_GEOMS; j++)
+  {
+    /* Some geometries are large enough to cover the values */
+    geoms[j] = (j % 10 == 1) ? make_lshape(-1 - j / 10, -1, 55) :
+      make_lshape(rnd_int(80), rnd_int(80), 1 + rnd_int(10));
+    for (int i = 0; i < NO_VALUES; i++)
+      for (int r = 0; r < NO_RELS; r++)
+        expected[i][j][r] = rel_traj(r, values[i], geoms[j]);
+  }
+  for (int i = 0; i < NO_VALUES; i++)
+    at[i] = tpoint_at_geom(values[i], geoms[0], NULL);
+
+  /* The same geometry many times, where all the calls but the first one find
+   * the prepared geometry in the cache */
+  for (int k = 0; k < 3; k++)
+  {
+    for (int i = 0; i < NO_VALUES; i++)
+    {
+      for (int r = 0; r < NO_RELS; r++)
+        check_rel("same geometry", r, values[i], geoms[0],
+          expected[i][0][r]);
+      Temporal *res = tpoint_at_geom(values[i], geoms[0], NULL);
+      if ((res == NULL) != (at[i] == NULL) ||
+          (res && ! temporal_eq(res, at[i])))
+        test_fail("same geometry atGeometry: result differs on call %d",
+          k + 2);
+      free(res);
+    }
+  }
+
+  /* A geometry with the same bytes as one in the cache */
+  GSERIALIZED *copy = geo_copy(geoms[0]);
+  for (int i = 0; i < NO_VALUES; i++)
+    for (int r = 0; r < NO_RELS; r++)
+      check_rel("copy of geometry", r, values[i], copy, expected[i][0][r]);
+  free(copy);
+
+  /* All the geometries again and again, which evicts the prepared geometries
+   * from the cache, interleaved with the first one, which is kept in the
+   * cache since it is the most used one */
+  for (int k = 0; k < 2; k++)
+  {
+    for (int j = 0; j < NO_GEOMS; j++)
+    {
+      int i = rnd_int(NO_VALUES);
+      for (int r = 0; r < NO_RELS; r++)
+      {
+        check_rel("many geometries", r, values[i], geoms[j],
+          expected[i][j][r]);
+        check_rel("many geometries", r, values[i], geoms[0],
+          expected[i][0][r]);
+      }
+    }
+  }
+  for (int i = 0; i < NO_VALUES; i++)
+  {
+    Temporal *res = tpoint_at_geom(values[i], geoms[0], NULL);
+    if ((res == NULL) != (at[i] == NULL) ||
+        (res && ! temporal_eq(res, at[i])))
+      test_fail("many geometries atGeometry: result differs");
+    free(res);
+  }
+
+  for (int i = 0; i < NO_VALUES; i++)
+  {
+    free(values[i]); free(at[i]);
+  }
+  for (int j = 0; j < NO_GEOMS; j++)
+    free(geoms[j]);
+  return;
+}
+
+/*****************************************************************************/
+
+int
+main(void)
+{
+  test_initialize();
+  t0 = pg_timestamptz_in("2025-01-01", -1);
+  rnd_seed(12);
+  test_early_exit();
+  test_cache();
+  return test_finalize();
+}
@@ -0,0 +1,542 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the bulk loading, the deletion, and the
+ * k-nearest neighbor search of the RTree index against a brute-force scan
+ *
+ * The program builds RTrees of tstzspan, floatspan, tbox, and 2D and 3D
+ * stbox boxes both by inserting random boxes one by one and by bulk loading
+ * them, and then verifies that the functions `rtree_search()` and
+ * `rtree_knn()` return the same answers as a sequential scan of the boxes
+ * before and after deleting a third of them with `rtree_delete()`. The
+ * bounds of the random boxes are rounded so that many boxes touch each
+ * other. Since several boxes may be at the same distance of a query, the
+ * answers of the kNN search are verified by comparing their distances.
+ * The RTrees of stbox boxes are also built with the flat layout of the
+ * nodes, whose searches must give the same answers, in particular for
+ * periods that only touch at an exclusive bound. Finally, the program
+ * verifies that a kNN search on temporal boxes without value dimension or on
+ * spatiotemporal boxes without spatial dimension, and that boxes and queries
+ * whose SRID is not the one of the tree are rejected with an error. The
+ * program returns a nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o rtree_test rtree_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal.h>
+#include "meos_test.h"
+
+/* Number of boxes indexed */
+#define NO_BOXES 2000
+/* Number of queries */
+#define NO_QUERIES 100
+/* Number of neighbors of the kNN queries */
+#define NO_NEIGHBORS 10
+/* Number of microseconds in an hour */
+#define USECS_PER_HOUR INT64CONST(3600000000)
+
+/* Description of the boxes of a kind of RTree */
+typedef struct
+{
+  const char *name;                 /* Name of the kind of boxes */
+  RTree *(*create)(void);           /* Function creating the RTree */
+  RTree *(*create_flat)(void);      /* Same for the flat layout, if any */
+  size_t size;                      /* Size of the boxes */
+  void (*random)(void *, bool);     /* Function generating a random box */
+  bool (*overlaps)(const void *, const void *);
+  double (*distance)(const void *, const void *);
+} box_kind;
+
+/* Origin of the random periods */
+static TimestampTz t0;
+
+/*****************************************************************************/
+
+/* Return a random tstzspan in the year 2025 whose bounds are hours, which
+ * is at most 2 days long for the boxes and 30 days long for the queries */
+static Span
+random_period(bool query)
+{
+  TimestampTz lower = t0 + rnd_int(365 * 24) * USECS_PER_HOUR;
+  TimestampTz upper = lower + rnd_int(query ? 30 * 24 : 48) * USECS_PER_HOUR;
+  bool lower_inc = (upper == lower) || rnd() < 0.5;
+  bool upper_inc = (upper == lower) || rnd() < 0.5;
+  Span *s = tstzspan_make(lower, upper, lower_inc, upper_inc);
+  Span result = *s;
+  free(s);
+  return result;
+}
+
+/* Return a random floatspan in [0, 1000] whose bounds are multiple of 0.5,
+ * which is at most 2 units wide for the boxes and 20 for the queries */
+static Span
+random_values(bool query)
+{
+  double lower = rnd_int(2000) * 0.5;
+  double upper = lower + rnd_int(query ? 40 : 4) * 0.5;
+  bool lower_inc = (upper == lower) || rnd() < 0.5;
+  bool upper_inc = (upper == lower) || rnd() < 0.5;
+  Span *s = floatspan_make(lower, upper, lower_inc, upper_inc);
+  Span result = *s;
+  free(s);
+  return result;
+}
+
+/* Return a random coordinate interval in [0, 1000] whose bounds are
+ * integers, which is at most 5 units wide for the boxes and 50 for the
+ * queries */
+static void
+random_coords(bool query, double *min, double *max)
+{
+  *min = rnd_int(1000);
+  *max = *min + rnd_int(query ? 50 : 5);
+  return;
+}
+
+static void
+random_tstzspan(void *box, bool query)
+{
+  *(Span *) box = random_period(query);
+  return;
+}
+
+static void
+random_floatspan(void *box, bool query)
+{
+  *(Span *) box = random_values(query);
+  return;
+}
+
+static void
+random_tbox(void *box, bool query)
+{
+  Span s = random_values(query);
+  Span p = random_period(query);
+  TBox *b = tbox_make(&s, &p);
+  memcpy(box, b, sizeof(TBox));
+  free(b);
+  return;
+}
+
+static void
+random_stbox(void *box, bool query, bool hasz)
+{
+  double xmin, xmax, ymin, ymax, zmin = 0, zmax = 0;
+  random_coords(query, &xmin, &xmax);
+  random_coords(query, &ymin, &ymax);
+  if (hasz)
+    random_coords(query, &zmin, &zmax);
+  Span p = random_period(query);
+  STBox *b = stbox_make(true, hasz, false, 3857, xmin, xmax, ymin, ymax,
+    zmin, zmax, &p);
+  memcpy(box, b, sizeof(STBox));
+  free(b);
+  return;
+}
+
+static void
+random_stbox2d(void *box, bool query)
+{
+  random_stbox(box, query, false);
+  return;
+}
+
+static void
+random_stbox3d(void *box, bool query)
+{
+  random_stbox(box, query, true);
+  return;
+}
+
+/*****************************************************************************/
+
+static bool
+span_overlaps(const void *box1, const void *box2)
+{
+  return overlaps_span_span((const Span *) box1, (const Span *) box2);
+}
+
+static bool
+tbox_overlaps(const void *box1, const void *box2)
+{
+  return overlaps_tbox_tbox((const TBox *) box1, (const TBox *) box2);
+}
+
+/* Return true if two spatiotemporal boxes overlap, where the periods are
+ * compared taking into account the inclusivity of their bounds */
+static bool
+stbox_overlaps(const void *box1, const void *box2)
+{
+  const STBox *b1 = (const STBox *) box1;
+  const STBox *b2 = (const STBox *) box2;
+  return overlaps_stbox_stbox(b1, b2) &&
+    overlaps_span_span(&b1->period, &b2->period);
+}
+
+/* Return the distance between two tstzspans, which is a number of seconds */
+static double
+tstzspan_dist(const void *box1, const void *box2)
+{
+  return distance_tstzspan_tstzspan((const Span *) box1, (const Span *) box2);
+}
+
+static double
+floatspan_dist(const void *box1, const void *box2)
+{
+  return DatumGetFloat8(distance_span_span((const Span *) box1,
+    (const Span *) box2));
+}
+
+/* Return the distance between two temporal boxes, which is infinite when
+ * their periods do not overlap */
+static double
+tbox_dist(const void *box1, const void *box2)
+{
+  return nad_tbox_tbox((const TBox *) box1, (const TBox *) box2);
+}
+
+/* Return the gap between two intervals of coordinates */
+static double
+coord_gap(double min1, double max1, double min2, double max2)
+{
+  return Max(0.0, Max(min1 - max2, min2 - max1));
+}
+
+/* Return the Euclidean distance between two Cartesian spatiotemporal boxes,
+ * which is infinite when their periods do not overlap */
+static double
+stbox_dist(const void *box1, const void *box2)
+{
+  const STBox *b1 = (const STBox *) box1;
+  const STBox *b2 = (const STBox *) box2;
+  if (! overlaps_span_span(&b1->period, &b2->period))
+    return DBL_MAX;
+  double dx = coord_gap(b1->xmin, b1->xmax, b2->xmin, b2->xmax);
+  double dy = coord_gap(b1->ymin, b1->ymax, b2->ymin, b2->ymax);
+  double dz = MEOS_FLAGS_GET_Z(b1->flags) ?
+    coord_gap(b1->zmin, b1->zmax, b2->zmin, b2->zmax) : 0.0;
+  return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/* Kinds of boxes verified */
+static const box_kind kinds[] =
+{
+  { "tstzspan", &rtree_create_tstzspan, NULL, sizeof(Span),
+    &random_tstzspan, &span_overlaps, &tstzspan_dist },
+  { "floatspan", &rtree_create_floatspan, NULL, sizeof(Span),
+    &random_floatspan, &span_overlaps, &floatspan_dist },
+  { "tbox", &rtree_create_tbox, NULL, sizeof(TBox), &random_tbox,
+    &tbox_overlaps, &tbox_dist },
+  { "stbox 2D", &rtree_create_stbox, &rtree_create_stbox_flat,
+    sizeof(STBox), &random_stbox2d, &stbox_overlaps, &stbox_dist },
+  { "stbox 3D", &rtree_create_stbox, &rtree_create_stbox_flat,
+    sizeof(STBox), &random_stbox3d, &stbox_overlaps, &stbox_dist },
+};
+
+/*****************************************************************************/
+
+/* Comparator of ids */
+static int
+id_cmp(const void *a, const void *b)
+{
+  int64 x = *(const int64 *) a, y = *(const int64 *) b;
+  return (x > y) - (x < y);
+}
+
+/* Comparator of doubles */
+static int
+dist_cmp(const void *a, const void *b)
+{
+  double x = *(const double *) a, y = *(const double *) b;
+  return (x > y) - (x < y);
+}
+
+/* Return the i-th box of an array */
+static inline const void *
+box_n(const box_kind *kind, const char *boxes, int i)
+{
+  return boxes + kind->size * i;
+}
+
+/* Verify the answers of the search and kNN queries of a tree against a
+ * sequential scan of the boxes that are not deleted */
+static void
+check_queries(const box_kind *kind, const RTree *rtree, const char *boxes,
+  const bool *deleted, const char *queries)
+{
+  int64 *expected = malloc(sizeof(int64) * NO_BOXES);
+  double *dists = malloc(sizeof(double) * NO_BOXES);
+  for (int q = 0; q < NO_QUERIES; q++)
+  {
+    const void *query = box_n(kind, queries, q);
+    /* Search */
+    int nexp = 0, ndist = 0;
+    for (int i = 0; i < NO_BOXES; i++)
+    {
+      if (deleted[i])
+        continue;
+      const void *box = box_n(kind, boxes, i);
+      if (kind->overlaps(box, query))
+        expected[nexp++] = i;
+      /* Boxes whose period does not overlap the one of the query are not
+       * returned by the kNN search */
+      double d = kind->distance(box, query);
+      if (d != DBL_MAX)
+        dists[ndist++] = d;
+    }
+    int count;
+    int64 *ids = rtree_search(rtree, query, &count);
+    qsort(ids, count, sizeof(int64), &id_cmp);
+    if (count != nexp || (count && memcmp(ids, expected,
+        sizeof(int64) * count) != 0))
+      test_fail("%s: rtree_search for query %d", kind->name, q);
+    free(ids);
+
+    /* kNN: the distances of the answers must be the k smallest ones */
+    qsort(dists, ndist, sizeof(double), &dist_cmp);
+    int k = ndist < NO_NEIGHBORS ? ndist : NO_NEIGHBORS;
+    ids = rtree_knn(rtree, query, NO_NEIGHBORS, &count);
+    if (count != k)
+      test_fail("%s: rtree_knn count for query %d", kind->name, q);
+    else
+    {
+      for (int i = 0; i < count; i++)
+      {
+        if (ids[i] < 0 || ids[i] >= NO_BOXES || deleted[ids[i]] ||
+            kind->distance(box_n(kind, boxes, (int) ids[i]), query) !=
+              dists[i])
+        {
+          test_fail("%s: rtree_knn distance for query %d", kind->name, q);
+          break;
+        }
+      }
+    }
+    free(ids);
+  }
+  free(expected); free(dists);
+  return;
+}
+
+/* Verify that two trees give the same answers to the search queries */
+static void
+check_same_search(const box_kind *kind, const RTree *rtree1,
+  const RTree *rtree2, const char *queries)
+{
+  for (int q = 0; q < NO_QUERIES; q++)
+  {
+    int count1, count2;
+    int64 *ids1 = rtree_search(rtree1, box_n(kind, queries, q), &count1);
+    int64 *ids2 = rtree_search(rtree2, box_n(kind, queries, q), &count2);
+    qsort(ids1, count1, sizeof(int64), &id_cmp);
+    qsort(ids2, count2, sizeof(int64), &id_cmp);
+    if (count1 != count2 || (count1 && memcmp(ids1, ids2,
+        sizeof(int64) * count1) != 0))
+      test_fail("%s: rtree_search of the flat layout for query %d",
+        kind->name, q);
+    free(ids1); free(ids2);
+  }
+  return;
+}
+
+/* Verify the trees built by insertion and by bulk loading random boxes,
+ * with the flat layout of the nodes when the kind of boxes has one */
+static void
+test_rtree_layout(const box_kind *kind, bool flat, const char *boxes,
+  const char *queries)
+{
+  bool deleted[NO_BOXES];
+  memset(deleted, 0, sizeof(deleted));
+  RTree *(*create)(void) = flat ? kind->create_flat : kind->create;
+
+  /* Build a tree by insertion and another one by bulk loading */
+  RTree *inserted = create();
+  for (int i = 0; i < NO_BOXES; i++)
+    rtree_insert(inserted, (void *) box_n(kind, boxes, i), i);
+  RTree *loaded = create();
+  rtree_bulk_load(loaded, boxes, NULL, NO_BOXES);
+  check_queries(kind, inserted, boxes, deleted, queries);
+  check_queries(kind, loaded, boxes, deleted, queries);
+  /* The answers of the flat layout must be those of the pointer layout */
+  if (flat)
+  {
+    RTree *pointer = kind->create();
+    rtree_bulk_load(pointer, boxes, NULL, NO_BOXES);
+    check_same_search(kind, pointer, inserted, queries);
+    check_same_search(kind, pointer, loaded, queries);
+    rtree_free(pointer);
+  }
+
+  /* Delete a third of the boxes from both trees */
+  for (int i = 0; i < NO_BOXES; i += 3)
+  {
+    const void *box = box_n(kind, boxes, i);
+    if (! rtree_delete(inserted, box, i) || ! rtree_delete(loaded, box, i))
+      test_fail("%s: rtree_delete of box %d", kind->name, i);
+    /* A second deletion of the same entry must not find it */
+    if (rtree_delete(inserted, box, i) || rtree_delete(loaded, box, i))
+      test_fail("%s: rtree_delete twice of box %d", kind->name, i);
+    deleted[i] = true;
+  }
+  check_queries(kind, inserted, boxes, deleted, queries);
+  check_queries(kind, loaded, boxes, deleted, queries);
+
+  rtree_free(inserted);
+  rtree_free(loaded);
+  printf("%s%s: %d boxes, %d queries verified\n", kind->name,
+    flat ? " flat" : "", NO_BOXES, NO_QUERIES);
+  return;
+}
+
+/* Verify the trees of random boxes of a kind */
+static void
+test_rtree(const box_kind *kind)
+{
+  char *boxes = malloc(kind->size * NO_BOXES);
+  char *queries = malloc(kind->size * NO_QUERIES);
+  for (int i = 0; i < NO_BOXES; i++)
+    kind->random(boxes + kind->size * i, false);
+  for (int i = 0; i < NO_QUERIES; i++)
+    kind->random(queries + kind->size * i, true);
+  test_rtree_layout(kind, false, boxes, queries);
+  if (kind->create_flat)
+    test_rtree_layout(kind, true, boxes, queries);
+  free(boxes);
+  free(queries);
+  return;
+}
+
+/* Verify that a kNN search raises an error when the query or the boxes of
+ * the tree do not have a value or spatial dimension */
+static void
+test_knn_without_x(void)
+{
+  meos_initialize_error_handler(&test_count_errors);
+  Span p = random_period(false);
+  Span s = random_values(false);
+  TBox *tbox_t = tbox_make(NULL, &p);
+  TBox *tbox_xt = tbox_make(&s, &p);
+  STBox *stbox_t = stbox_make(false, false, false, 0, 0, 0, 0, 0, 0, 0, &p);
+  STBox *stbox_xt = stbox_make(true, false, false, 0, 1, 2, 1, 2, 0, 0, &p);
+
+  /* Trees of boxes with the value or spatial dimension and a query without
+   * it, and the other way round */
+  const void *trees[][2] = {
+    { tbox_xt, tbox_t }, { tbox_t, tbox_xt },
+    { stbox_xt, stbox_t }, { stbox_t, stbox_xt } };
+  for (int i = 0; i < 4; i++)
+  {
+    RTree *rtree = i < 2 ? rtree_create_tbox() : rtree_create_stbox();
+    rtree_insert(rtree, (void *) trees[i][0], 1);
+    nerrors = 0;
+    int count;
+    int64 *ids = rtree_knn(rtree, trees[i][1], NO_NEIGHBORS, &count);
+    if (ids || count != 0 || nerrors == 0)
+      test_fail("%s: rtree_knn without value or spatial dimension, case %d",
+        i < 2 ? "tbox" : "stbox", i);
+    free(ids);
+    /* The search on the temporal dimension remains available */
+    nerrors = 0;
+    ids = rtree_search(rtree, trees[i][1], &count);
+    if (count != 1 || nerrors != 0)
+      test_fail("%s: rtree_search without value or spatial dimension, "
+        "case %d", i < 2 ? "tbox" : "stbox", i);
+    free(ids);
+    rtree_free(rtree);
+  }
+  free(tbox_t); free(tbox_xt); free(stbox_t); free(stbox_xt);
+  meos_initialize_error_handler(NULL);
+  printf("kNN without value or spatial dimension verified\n");
+  return;
+}
+
+/* Verify that the boxes and the queries whose SRID is not the one of the
+ * boxes of an RTree of spatiotemporal boxes are rejected with an error */
+static void
+test_srid(void)
+{
+  meos_initialize_error_handler(&test_count_errors);
+  Span p = random_period(false);
+  STBox *box1 = stbox_make(true, false, false, 3857, 0, 10, 0, 10, 0, 0, &p);
+  STBox *box2 = stbox_make(true, false, false, 4326, 0, 10, 0, 10, 0, 0, &p);
+  STBox boxes[2] = { *box1, *box2 };
+  for (int flat = 0; flat < 2; flat++)
+  {
+    const char *name = flat ? "stbox flat" : "stbox";
+    RTree *rtree = flat ? rtree_create_stbox_flat() : rtree_create_stbox();
+    rtree_insert(rtree, box1, 1);
+    int count;
+    nerrors = 0;
+    rtree_insert(rtree, box2, 2);
+    int64 *ids = rtree_search(rtree, box1, &count);
+    if (nerrors == 0 || count != 1)
+      test_fail("%s: rtree_insert of a box with another SRID", name);
+    free(ids);
+    nerrors = 0;
+    rtree_bulk_load(rtree, boxes, NULL, 2);
+    ids = rtree_search(rtree, box1, &count);
+    if (nerrors == 0 || count != 1)
+      test_fail("%s: rtree_bulk_load of a box with another SRID", name);
+    free(ids);
+    nerrors = 0;
+    ids = rtree_search(rtree, box2, &count);
+    if (nerrors == 0 || count != 0)
+      test_fail("%s: rtree_search with another SRID", name);
+    free(ids);
+    rtree_free(rtree);
+  }
+  free(box1); free(box2);
+  meos_initialize_error_handler(NULL);
+  printf("Boxes and queries with another SRID verified\n");
+  return;
+}
+
+/* Main program */
+int
+main(void)
+{
+  test_initialize();
+  t0 = pg_timestamptz_in("2025-01-01", -1);
+  for (size_t i = 0; i < sizeof(kinds) / sizeof(box_kind); i++)
+    test_rtree(&kinds[i]);
+  test_knn_without_x();
+  test_srid();
+  return test_finalize();
+}
@@ -0,0 +1,232 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the radix sort of integers, dates, and
+ * timestamps used by the set union aggregate
+ *
+ * The program verifies that
+ * - the function `datumarr_radix_sort()` gives the same order as a
+ *   comparison sort for arrays of integers, big integers, dates, and
+ *   timestamps of various sizes, in particular with negative values, with
+ *   more than 64 elements, which are not sorted by a comparison sort, and
+ *   with digits shared by all the values, whose passes are skipped;
+ * - the set union aggregate of values with many duplicates gives the same
+ *   set as the one built from the distinct values.
+ *
+ * The program returns a nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o set_union_test set_union_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <meos.h>
+#include <meos_internal.h>
+#include "meos_test.h"
+
+/* The radix sort is not part of the public API */
+extern void datumarr_radix_sort(Datum *values, int count, meosType basetype);
+
+/* Number of random arrays for each type, size, and distribution */
+#define NO_ARRAYS 20
+/* Number of values aggregated */
+#define NO_VALUES 100000
+/* Number of distinct values aggregated */
+#define NO_DISTINCT 5000
+
+/* Return true if the type is represented as a 32-bit integer */
+static bool
+is32(meosType basetype)
+{
+  return (basetype == T_INT4 || basetype == T_DATE);
+}
+
+/* Comparison functions of the reference sort */
+static int
+value32_cmp(const void *l, const void *r)
+{
+  int32 x = DatumGetInt32(*(const Datum *) l);
+  int32 y = DatumGetInt32(*(const Datum *) r);
+  return (x > y) - (x < y);
+}
+
+static int
+value64_cmp(const void *l, const void *r)
+{
+  int64 x = DatumGetInt64(*(const Datum *) l);
+  int64 y = DatumGetInt64(*(const Datum *) r);
+  return (x > y) - (x < y);
+}
+
+/*****************************************************************************/
+
+/* Return the i-th value of an array following a distribution */
+static int64
+array_value(int dist, int i, int64 base)
+{
+  switch (dist)
+  {
+    case 0: /* Any value of the type */
+      return (int64) rnd64();
+    case 1: /* Small negative and positive values with duplicates */
+      return rnd_int(101) - 50;
+    case 2: /* Values close to each other, sharing their high-order digits */
+      return base + rnd_int(1 << 20);
+    case 3: /* Ascending values */
+      return base + (int64) i * 1000;
+    case 4: /* Descending values */
+      return base - (int64) i * 1000;
+    default: /* Equal values */
+      return base;
+  }
+}
+
+/* Verify the radix sort of random arrays of a type */
+static void
+test_radix_sort(meosType basetype)
+{
+  const int sizes[] = {0, 1, 2, 3, 63, 64, 65, 200, 256, 1000, 10000};
+  int nsizes = sizeof(sizes) / sizeof(int);
+  Datum *values = malloc(sizeof(Datum) * 10000);
+  Datum *expected = malloc(sizeof(Datum) * 10000);
+  for (int s = 0; s < nsizes; s++)
+  {
+    int count = sizes[s];
+    for (int dist = 0; dist < 6; dist++)
+    {
+      for (int n = 0; n < NO_ARRAYS; n++)
+      {
+        /* Negative bases, which have the sign bit set, are frequent */
+        int64 base = (int64) rnd64() >> (is32(basetype) ? 34 : 2);
+        for (int i = 0; i < count; i++)
+        {
+          int64 v = array_value(dist, i, base);
+          values[i] = is32(basetype) ? Int32GetDatum((int32) v) :
+            Int64GetDatum(v);
+        }
+        memcpy(expected, values, sizeof(Datum) * count);
+        qsort(expected, (size_t) count, sizeof(Datum),
+          is32(basetype) ? &value32_cmp : &value64_cmp);
+        datumarr_radix_sort(values, count, basetype);
+        for (int i = 0; i < count; i++)
+        {
+          if ((is32(basetype) &&
+                DatumGetInt32(values[i]) != DatumGetInt32(expected[i])) ||
+              (! is32(basetype) &&
+                DatumGetInt64(values[i]) != DatumGetInt64(expected[i])))
+          {
+            test_fail("datumarr_radix_sort: %s, %d values, distribution %d, "
+              "position %d", meostype_name(basetype), count, dist, i);
+            break;
+          }
+        }
+      }
+    }
+  }
+  free(values); free(expected);
+  printf("%s: radix sort verified\n", meostype_name(basetype));
+  return;
+}
+
+/*****************************************************************************/
+
+/* Verify the set union aggregate of values of a type with duplicates */
+static void
+test_set_union(meosType basetype)
+{
+  /* Distinct values, negative and positive, far apart or not */
+  int64 *distinct = malloc(sizeof(int64) * NO_DISTINCT);
+  for (int i = 0; i < NO_DISTINCT; i++)
+    distinct[i] = (basetype == T_INT8) ? (int64) rnd64() >> 4 :
+      ((basetype == T_TIMESTAMPTZ) ? (int64) rnd64() >> 8 :
+        (int64) (int32) rnd64() >> 4);
+
+  Set *state = NULL;
+  for (int i = 0; i < NO_VALUES; i++)
+  {
+    int64 v = distinct[rnd_int(NO_DISTINCT)];
+    switch (basetype)
+    {
+      case T_INT4: state = int_union_transfn(state, (int32) v); break;
+      case T_INT8: state = bigint_union_transfn(state, v); break;
+      case T_DATE: state = date_union_transfn(state, (DateADT) v); break;
+      default: state = timestamptz_union_transfn(state, (TimestampTz) v);
+    }
+  }
+  Set *result = set_union_finalfn(state);
+
+  /* The set built from the distinct values removes the duplicates too */
+  Set *expected;
+  if (basetype == T_INT8 || basetype == T_TIMESTAMPTZ)
+    expected = (basetype == T_INT8) ? bigintset_make(distinct, NO_DISTINCT) :
+      tstzset_make((TimestampTz *) distinct, NO_DISTINCT);
+  else
+  {
+    int32 *distinct32 = malloc(sizeof(int32) * NO_DISTINCT);
+    for (int i = 0; i < NO_DISTINCT; i++)
+      distinct32[i] = (int32) distinct[i];
+    expected = (basetype == T_INT4) ? intset_make(distinct32, NO_DISTINCT) :
+      dateset_make((DateADT *) distinct32, NO_DISTINCT);
+    free(distinct32);
+  }
+  if (! result || ! set_eq(result, expected))
+    test_fail("set union aggregate: %s, %d of %d values",
+      meostype_name(basetype), result ? set_num_values(result) : 0,
+      set_num_values(expected));
+  else
+    printf("%s: set union aggregate of %d distinct values verified\n",
+      meostype_name(basetype), set_num_values(result));
+  free(distinct); free(state); free(result); free(expected);
+  return;
+}
+
+/*****************************************************************************/
+
+int
+main(void)
+{
+  /* Initialize MEOS */
+  test_initialize();
+
+  const meosType basetypes[] = {T_INT4, T_INT8, T_DATE, T_TIMESTAMPTZ};
+  for (int i = 0; i < 4; i++)
+  {
+    test_radix_sort(basetypes[i]);
+    test_set_union(basetypes[i]);
+  }
+
+  /* Finalize MEOS */
+  return test_finalize();
+}
@@ -0,0 +1,364 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the appending of instants one by one to
+ * expandable temporal values against the values built at once
+ *
+ * The program generates random streams of instants of several temporal
+ * types and interpolations, in which values are often repeated or continue
+ * at the same speed so that the appended instants are normalized, and in
+ * which the text values have random lengths. Each stream is appended with
+ * the function `temporal_append_tinstant()` starting from an instant or
+ * from expandable sequences of small capacity, so that the sequences are
+ * enlarged in place, with and without a maximum distance and a maximum
+ * time interval between consecutive instants, which split the stream into
+ * expandable sequence sets. Regularly during the appends, the result is
+ * compared with the value built with `tsequence_make()` and
+ * `tsequenceset_make()` from the instants appended so far, including its
+ * number of instants and its bounding box. The program returns a nonzero
+ * exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o temporal_append_test temporal_append_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <meos.h>
+#include <meos_geo.h>
+/* The expandable functions are in the internal MEOS API */
+#include <meos_internal.h>
+#include "meos_test.h"
+
+/* Number of streams per kind of temporal values */
+#define NO_STREAMS 20
+/* Maximum number of instants of a stream */
+#define MAX_INSTANTS 300
+/* The appended value is compared with the expected one every CHECK_EVERY
+ * instants and after the last one */
+#define CHECK_EVERY 16
+/* Maximum time interval between consecutive instants, as a string and in
+ * microseconds */
+#define MAXT "30 minutes"
+#define MAXT_USECS INT64CONST(1800000000)
+/* Number of microseconds in a minute and in an hour */
+#define USECS_PER_MINUTE INT64CONST(60000000)
+#define USECS_PER_HOUR INT64CONST(3600000000)
+
+/* Description of a kind of temporal values */
+typedef struct
+{
+  const char *name;             /* Name of the kind of temporal values */
+  interpType interp;            /* Interpolation */
+  double maxdist;               /* Maximum distance, 0 if not applicable */
+  bool spatial;                 /* True when the values have 2 coordinates */
+  TInstant *(*make)(double, double, TimestampTz); /* Instant constructor */
+} append_kind;
+
+/* Origin of the random timestamps */
+static TimestampTz t0;
+
+/*****************************************************************************/
+
+static TInstant *
+make_tbool(double x, double y, TimestampTz t)
+{
+  (void) y;
+  return tboolinst_make(x > 4, t);
+}
+
+static TInstant *
+make_tint(double x, double y, TimestampTz t)
+{
+  (void) y;
+  return tintinst_make((int) x, t);
+}
+
+static TInstant *
+make_tfloat(double x, double y, TimestampTz t)
+{
+  (void) y;
+  return tfloatinst_make(x, t);
+}
+
+/* The length of the text values varies with the value so that the appended
+ * instants may not fit in the free space of an expandable sequence */
+static TInstant *
+make_ttext(double x, double y, TimestampTz t)
+{
+  (void) y;
+  char str[40];
+  int v = abs((int) x);
+  int len = 1 + v % 37;
+  memset(str, 'a' + v % 26, len);
+  str[len] = '\0';
+  text *txt = cstring2text(str);
+  TInstant *result = ttextinst_make(txt, t);
+  free(txt);
+  return result;
+}
+
+static TInstant *
+make_tgeompoint(double x, double y, TimestampTz t)
+{
+  GSERIALIZED *gs = geompoint_make2d(3857, x, y);
+  TInstant *result = tpointinst_make(gs, t);
+  free(gs);
+  return result;
+}
+
+static const append_kind kinds[] =
+{
+  {"tbool step", STEP, 0.0, false, &make_tbool},
+  {"tint discrete", DISCRETE, 0.0, false, &make_tint},
+  {"tint step", STEP, 4.0, false, &make_tint},
+  {"tfloat linear", LINEAR, 6.0, false, &make_tfloat},
+  {"ttext discrete", DISCRETE, 0.0, false, &make_ttext},
+  {"ttext step", STEP, 0.0, false, &make_ttext},
+  {"tgeompoint discrete", DISCRETE, 0.0, true, &make_tgeompoint},
+  {"tgeompoint linear", LINEAR, 8.0, true, &make_tgeompoint},
+};
+
+/*****************************************************************************/
+
+/* Generate the integral values and the timestamps of a random stream of
+ * instants, whose values are often repeated or continue at the same speed
+ * as the previous ones, and which sometimes have a gap of one hour */
+static void
+random_stream(int count, double *x, double *y, TimestampTz *t)
+{
+  x[0] = rnd_int(10);
+  y[0] = rnd_int(10);
+  t[0] = t0;
+  TimestampTz dt = USECS_PER_MINUTE;
+  for (int i = 1; i < count; i++)
+  {
+    double p = rnd();
+    if (p < 0.3)
+    {
+      x[i] = x[i - 1];
+      y[i] = y[i - 1];
+    }
+    else if (p < 0.6 && i > 1)
+    {
+      x[i] = 2 * x[i - 1] - x[i - 2];
+      y[i] = 2 * y[i - 1] - y[i - 2];
+      /* Keep the same time step to keep the same speed */
+      t[i] = t[i - 1] + (t[i - 1] - t[i - 2]);
+      continue;
+    }
+    else
+    {
+      x[i] = rnd_int(10);
+      y[i] = rnd_int(10);
+    }
+    dt = rnd() < 0.1 ? USECS_PER_HOUR : (1 + rnd_int(3)) * USECS_PER_MINUTE;
+    t[i] = t[i - 1] + dt;
+  }
+  return;
+}
+
+/* Return the value built at once from the first @p count instants of a
+ * stream, which is split into sequences when the distance between
+ * consecutive values is greater than @p maxdist or the time interval between
+ * them is greater than @p maxt */
+static Temporal *
+expected_value(TInstant **instants, const double *x, const double *y,
+  int count, interpType interp, double maxdist, bool maxt)
+{
+  TSequence **sequences = malloc(sizeof(TSequence *) * count);
+  int nseqs = 0, first = 0;
+  for (int i = 1; i <= count; i++)
+  {
+    bool split = (i == count);
+    if (! split && maxdist > 0.0 &&
+        hypot(x[i] - x[i - 1], y[i] - y[i - 1]) > maxdist)
+      split = true;
+    if (! split && maxt && instants[i]->t - instants[i - 1]->t > MAXT_USECS)
+      split = true;
+    if (split)
+    {
+      sequences[nseqs++] = tsequence_make((const TInstant **) &instants[first],
+        i - first, true, true, interp, true);
+      first = i;
+    }
+  }
+  Temporal *result;
+  if (nseqs == 1)
+    result = (Temporal *) sequences[0];
+  else
+  {
+    result = (Temporal *) tsequenceset_make((const TSequence **) sequences,
+      nseqs, false);
+    for (int i = 0; i < nseqs; i++)
+      free(sequences[i]);
+  }
+  free(sequences);
+  return result;
+}
+
+/* Verify that a value obtained by appending instants is equal to the
+ * expected one, including its number of instants and its bounding box */
+static bool
+check_value(const Temporal *temp, const Temporal *expected, const char *name,
+  const char *config, int count)
+{
+  /* The bounding box of all temporal types fits in an STBox */
+  STBox box1, box2;
+  if (! temporal_eq(temp, expected))
+    test_fail("%s %s: different value after %d instants", name, config,
+      count);
+  else if (temporal_num_instants(temp) != temporal_num_instants(expected))
+    test_fail("%s %s: %d instants instead of %d after %d instants", name,
+      config, temporal_num_instants(temp), temporal_num_instants(expected),
+      count);
+  else
+  {
+    temporal_set_bbox(temp, &box1);
+    temporal_set_bbox(expected, &box2);
+    if (temporal_bbox_eq(&box1, &box2, temp->temptype))
+      return true;
+    test_fail("%s %s: different bounding box after %d instants", name,
+      config, count);
+  }
+  return false;
+}
+
+/* Append the instants of a stream one by one starting from an instant when
+ * @p capacity is 0 and from a sequence with this capacity otherwise */
+static void
+test_append(const append_kind *kind, TInstant **instants, const double *x,
+  const double *y, int count, int capacity, bool expand, double maxdist,
+  const Interval *maxt)
+{
+  char config[128];
+  snprintf(config, sizeof(config),
+    "(capacity %d, expand %d, maxdist %g, maxt %s)", capacity, expand,
+    maxdist, maxt ? MAXT : "none");
+  Temporal *temp = capacity ?
+    (Temporal *) tsequence_make_exp((const TInstant **) instants, 1, capacity,
+      true, true, kind->interp, false) :
+    (Temporal *) tinstant_copy(instants[0]);
+  for (int i = 1; i < count; i++)
+  {
+    /* The subtype is read before the append since an expandable sequence
+     * may be moved when it is enlarged */
+    uint8 subtype = temp->subtype;
+    Temporal *result = temporal_append_tinstant(temp, instants[i],
+      kind->interp, maxdist, maxt, expand);
+    if (! result)
+    {
+      test_fail("%s %s: append of instant %d failed", kind->name, config, i);
+      free(temp);
+      return;
+    }
+    /* An expandable value is either modified in place or freed when it is
+     * rebuilt, unless it is a sequence that is split into a sequence set */
+    if (! expand || result->subtype != subtype)
+      free(temp);
+    temp = result;
+    if (i % CHECK_EVERY == 0 || i == count - 1)
+    {
+      Temporal *expected = expected_value(instants, x, y, i + 1,
+        kind->interp, maxdist, maxt != NULL);
+      bool ok = check_value(temp, expected, kind->name, config, i + 1);
+      free(expected);
+      if (! ok)
+        break;
+    }
+  }
+  free(temp);
+  return;
+}
+
+/* Verify the appends of random streams of a kind of temporal values */
+static void
+test_kind(const append_kind *kind, const Interval *maxt)
+{
+  static const int capacities[] = {0, 1, 2, 64};
+  double x[MAX_INSTANTS], y[MAX_INSTANTS];
+  TimestampTz t[MAX_INSTANTS];
+  TInstant *instants[MAX_INSTANTS];
+  int failures = nfailures;
+  for (int i = 0; i < NO_STREAMS; i++)
+  {
+    int count = 2 + rnd_int(MAX_INSTANTS - 1);
+    random_stream(count, x, y, t);
+    /* The distance between the values only depends on the first coordinate
+     * for the alphanumeric types */
+    if (! kind->spatial)
+      memset(y, 0, sizeof(double) * count);
+    for (int j = 0; j < count; j++)
+      instants[j] = kind->make(x[j], y[j], t[j]);
+    for (size_t j = 0; j < sizeof(capacities) / sizeof(int); j++)
+    {
+      for (int expand = 0; expand < 2; expand++)
+      {
+        test_append(kind, instants, x, y, count, capacities[j], expand, 0.0,
+          NULL);
+        /* The instants of a discrete sequence are not split by gaps */
+        if (kind->interp == DISCRETE)
+          continue;
+        test_append(kind, instants, x, y, count, capacities[j], expand, 0.0,
+          maxt);
+        if (kind->maxdist > 0.0)
+        {
+          test_append(kind, instants, x, y, count, capacities[j], expand,
+            kind->maxdist, NULL);
+          test_append(kind, instants, x, y, count, capacities[j], expand,
+            kind->maxdist, maxt);
+        }
+      }
+    }
+    for (int j = 0; j < count; j++)
+      free(instants[j]);
+  }
+  printf("%s: %d streams verified%s\n", kind->name, NO_STREAMS,
+    nfailures > failures ? " with failures" : "");
+  return;
+}
+
+/* Main program */
+int
+main(void)
+{
+  test_initialize();
+  t0 = pg_timestamptz_in("2025-01-01", -1);
+  Interval *maxt = pg_interval_in(MAXT, -1);
+  for (size_t i = 0; i < sizeof(kinds) / sizeof(append_kind); i++)
+    test_kind(&kinds[i], maxt);
+  free(maxt);
+  return test_finalize();
+}
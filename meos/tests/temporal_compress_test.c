@@ -0,0 +1,417 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the compressed binary representation of
+ * temporal values
+ *
+ * The program verifies on fixed and on random temporal values of all base
+ * types and subtypes that
+ * - the function `temporal_from_compressed()` returns the value given to
+ *   the function `temporal_as_compressed()`;
+ * - the function `temporal_compressed_set_bbox()` returns the bounding box
+ *   of the value, reading only the header for sequences and sequence sets;
+ * - truncated inputs are rejected with an error;
+ * - corrupt inputs are rejected with an error or return a valid temporal
+ *   value, but never crash.
+ *
+ * The program returns a nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o temporal_compress_test temporal_compress_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal.h>
+#include "meos_test.h"
+
+/* Number of random values of each type and subtype */
+#define NO_VALUES 300
+/* Number of corruptions of each random value */
+#define NO_CORRUPTIONS 20
+/* Maximum number of sequences of the random sequence sets */
+#define MAX_SEQUENCES 5
+/* Maximum number of instants of the random sequences */
+#define MAX_INSTANTS 30
+/* Size of the fixed part of the header of the compressed representation */
+#define HEADER_SIZE 16
+/* Number of microseconds in a minute */
+#define USECS_PER_MINUTE INT64CONST(60000000)
+
+/* Report a failed check */
+static void
+fail(const char *what, const Temporal *temp)
+{
+  char *str = temporal_out(temp, 15);
+  test_fail("%s: %s", what, str);
+  free(str);
+  return;
+}
+
+/* Return the size of the bounding box of a temporal type */
+static size_t
+bbox_size(meosType temptype)
+{
+  if (tnumber_type(temptype))
+    return sizeof(TBox);
+  if (tspatial_type(temptype))
+    return sizeof(STBox);
+  return sizeof(Span);
+}
+
+/*****************************************************************************/
+
+/* Verify the compressed representation of a temporal value */
+static void
+check_compressed(const Temporal *temp, bool corrupt)
+{
+  size_t size;
+  uint8_t *data = temporal_as_compressed(temp, &size);
+
+  /* Round trip */
+  Temporal *temp1 = temporal_from_compressed(data, size);
+  if (! temp1 || ! temporal_eq(temp, temp1))
+    fail("round trip", temp);
+  free(temp1);
+
+  /* Bounding box, which for sequences and sequence sets is read from the
+   * header alone */
+  size_t boxsize = bbox_size(temp->temptype);
+  size_t hdrsize = (temp->subtype == TINSTANT) ? size : HEADER_SIZE + boxsize;
+  char box[sizeof(STBox)], box1[sizeof(STBox)];
+  memset(box, 0, sizeof(box)); memset(box1, 0, sizeof(box1));
+  temporal_set_bbox(temp, box);
+  meosType temptype;
+  if (hdrsize > size ||
+      ! temporal_compressed_set_bbox(data, hdrsize, &temptype, box1) ||
+      temptype != temp->temptype || memcmp(box, box1, boxsize) != 0)
+    fail("temporal_compressed_set_bbox", temp);
+
+  /* Truncated inputs */
+  for (size_t i = 0; i < size; i++)
+  {
+    nerrors = 0;
+    temp1 = temporal_from_compressed(data, i);
+    if (temp1 || nerrors == 0)
+    {
+      printf("Truncated to %zu of %zu bytes\n", i, size);
+      fail("truncated input", temp);
+    }
+    free(temp1);
+  }
+
+  /* Corrupt inputs must be rejected or give a valid value */
+  if (corrupt)
+  {
+    uint8_t *data1 = malloc(size);
+    for (int i = 0; i < NO_CORRUPTIONS; i++)
+    {
+      memcpy(data1, data, size);
+      int nflips = 1 + rnd_int(3);
+      for (int j = 0; j < nflips; j++)
+        data1[rnd_int((int) size)] ^= (uint8_t) (1 << rnd_int(8));
+      nerrors = 0;
+      temp1 = temporal_from_compressed(data1, size);
+      if (temp1)
+      {
+        char *str = temporal_out(temp1, 15);
+        free(str);
+      }
+      else if (nerrors == 0)
+        fail("corrupt input", temp);
+      free(temp1);
+    }
+    free(data1);
+  }
+  free(data);
+  return;
+}
+
+/* Verify the compressed representation of a temporal value given as a
+ * string */
+static void
+check_str(meosType temptype, const char *str)
+{
+  Temporal *temp;
+  switch (temptype)
+  {
+    case T_TBOOL: temp = tbool_in(str); break;
+    case T_TINT: temp = tint_in(str); break;
+    case T_TFLOAT: temp = tfloat_in(str); break;
+    case T_TTEXT: temp = ttext_in(str); break;
+    case T_TGEOMPOINT: temp = tgeompoint_in(str); break;
+    default: temp = tgeogpoint_in(str); break;
+  }
+  if (! temp)
+  {
+    test_fail("input: %s", str);
+    return;
+  }
+  check_compressed(temp, false);
+  free(temp);
+  return;
+}
+
+/* Verify the compressed representation of particular values */
+static void
+test_fixed(void)
+{
+  const char *tbool_values[] = {
+    "t@2000-01-01",
+    "{t@2000-01-01, f@2000-01-02, f@2000-01-03}",
+    "[t@2000-01-01, f@2000-01-02, f@2000-01-03)",
+    "{[t@2000-01-01, f@2000-01-02], (t@2000-01-03, t@2000-01-04]}",
+  };
+  const char *tint_values[] = {
+    "-2147483647@1900-01-01",
+    "{1@2000-01-01, -2147483647@2000-01-02, 2147483646@2200-01-03}",
+    "[1@2000-01-01 00:00:00.000001, 2@2000-01-01 00:00:00.000002, "
+      "2@2000-01-01 00:00:00.000003]",
+    "{[1@2000-01-01, 1@2000-01-02), [3@2000-01-03, 3@2000-01-04]}",
+  };
+  const char *tfloat_values[] = {
+    "1.5@2000-01-01",
+    "{1.5@2000-01-01, -0@2000-01-02, 1e308@2000-01-03}",
+    "Interp=Step;[1.5@2000-01-01, 2.5@2000-01-02, 2.5@2000-01-03)",
+    "[0.1@2000-01-01, 0.2@2000-01-02, 0.30000000000000004@2000-01-03]",
+    "{[1.5@2000-01-01, 2.5@2000-01-02), [3.5@2000-01-03, 3.5@2000-01-04]}",
+    "Interp=Step;{[1@2000-01-01, 2@2000-01-02], [3@2000-01-03]}",
+  };
+  const char *ttext_values[] = {
+    "\"\"@2000-01-01",
+    "{\"AAA\"@2000-01-01, \"\"@2000-01-02, \"BBB\"@2000-01-03}",
+    "[\"AAA\"@2000-01-01, \"a much longer text value\"@2000-01-02, "
+      "\"a much longer text value\"@2000-01-03]",
+    "{[\"AAA\"@2000-01-01, \"AAA\"@2000-01-02), [\"CCC\"@2000-01-03]}",
+  };
+  const char *tgeompoint_values[] = {
+    "Point(1 1)@2000-01-01",
+    "SRID=3812;Point Z(1 1 1)@2000-01-01",
+    "{Point(1 1)@2000-01-01, Point(2 2)@2000-01-02, Point(1 1)@2000-01-03}",
+    "SRID=3812;[Point(1 1)@2000-01-01, Point(2.5 -1e10)@2000-01-02, "
+      "Point(2.5 -1e10)@2000-01-03)",
+    "Interp=Step;[Point Z(1 1 1)@2000-01-01, Point Z(2 2 2)@2000-01-02]",
+    "{[Point Z(1 1 1)@2000-01-01, Point Z(2 2 2)@2000-01-02), "
+      "[Point Z(3 3 3)@2000-01-03]}",
+  };
+  const char *tgeogpoint_values[] = {
+    "Point(1 1)@2000-01-01",
+    "Point Z(1 1 1)@2000-01-01",
+    "{Point(1 1)@2000-01-01, Point(2 2)@2000-01-02}",
+    "[Point(4.35 50.85)@2000-01-01, Point(4.36 50.84)@2000-01-02]",
+    "SRID=4326;{[Point Z(1 1 1)@2000-01-01, Point Z(2 2 2)@2000-01-02), "
+      "[Point Z(3 3 3)@2000-01-03]}",
+  };
+  for (size_t i = 0; i < sizeof(tbool_values) / sizeof(char *); i++)
+    check_str(T_TBOOL, tbool_values[i]);
+  for (size_t i = 0; i < sizeof(tint_values) / sizeof(char *); i++)
+    check_str(T_TINT, tint_values[i]);
+  for (size_t i = 0; i < sizeof(tfloat_values) / sizeof(char *); i++)
+    check_str(T_TFLOAT, tfloat_values[i]);
+  for (size_t i = 0; i < sizeof(ttext_values) / sizeof(char *); i++)
+    check_str(T_TTEXT, ttext_values[i]);
+  for (size_t i = 0; i < sizeof(tgeompoint_values) / sizeof(char *); i++)
+    check_str(T_TGEOMPOINT, tgeompoint_values[i]);
+  for (size_t i = 0; i < sizeof(tgeogpoint_values) / sizeof(char *); i++)
+    check_str(T_TGEOGPOINT, tgeogpoint_values[i]);
+
+  /* Headers that are invalid or inconsistent with the data */
+  Temporal *temp = tint_in("{[1@2000-01-01, 2@2000-01-02], [3@2000-01-03]}");
+  size_t size;
+  uint8_t *data = temporal_as_compressed(temp, &size);
+  const int positions[] = {0, 1, 2, 8, 8, 12, 12};
+  const uint8_t values[] = {0xFF, 0xFF, 0xFF, 0x00, 0x03, 0x01, 0xFF};
+  for (size_t i = 0; i < sizeof(positions) / sizeof(int); i++)
+  {
+    uint8_t saved = data[positions[i]];
+    data[positions[i]] = values[i];
+    nerrors = 0;
+    Temporal *temp1 = temporal_from_compressed(data, size);
+    if (temp1 || nerrors == 0)
+    {
+      printf("Byte %d set to %d\n", positions[i], values[i]);
+      fail("invalid header", temp);
+    }
+    free(temp1);
+    data[positions[i]] = saved;
+  }
+  free(data); free(temp);
+  return;
+}
+
+/*****************************************************************************/
+
+/* Return a random instant of a temporal type */
+static TInstant *
+random_instant(meosType temptype, bool hasz, TimestampTz t)
+{
+  /* Repeated values are frequent to test the encoding of equal values */
+  static double x = 0.0, y = 0.0, z = 0.0;
+  if (rnd() < 0.7)
+  {
+    x = (rnd() - 0.5) * 360; y = (rnd() - 0.5) * 170; z = rnd() * 1000;
+  }
+  switch (temptype)
+  {
+    case T_TBOOL:
+      return tinstant_make(BoolGetDatum(x > 0), temptype, t);
+    case T_TINT:
+      return tinstant_make(Int32GetDatum((int) (x * 1e6)), temptype, t);
+    case T_TFLOAT:
+      return tinstant_make(Float8GetDatum(x), temptype, t);
+    case T_TTEXT:
+    {
+      char str[48];
+      snprintf(str, sizeof(str), "%.*s", (int) (y + 85) / 6,
+        "abcdefghijklmnopqrstuvwxyz0123456789");
+      return tinstant_make_free(PointerGetDatum(cstring2text(str)),
+        temptype, t);
+    }
+    case T_TGEOMPOINT:
+      return tinstant_make_free(PointerGetDatum(hasz ?
+        geompoint_make3dz(3812, x, y, z) : geompoint_make2d(3812, x, y)),
+        temptype, t);
+    default: /* T_TGEOGPOINT */
+      return tinstant_make_free(PointerGetDatum(hasz ?
+        geogpoint_make3dz(4326, x, y, z) : geogpoint_make2d(4326, x, y)),
+        temptype, t);
+  }
+}
+
+/* Return a random sequence of a temporal type starting after a timestamp */
+static TSequence *
+random_sequence(meosType temptype, bool hasz, interpType interp,
+  TimestampTz *t)
+{
+  int count = 1 + rnd_int(MAX_INSTANTS);
+  /* The array and the instants are freed by tsequence_make_free */
+  TInstant **instants = malloc(sizeof(TInstant *) * count);
+  /* Regular sampling intervals are frequent, as for AIS and GPS data */
+  bool regular = rnd() < 0.5;
+  TimestampTz delta = USECS_PER_MINUTE * (1 + rnd_int(60));
+  for (int i = 0; i < count; i++)
+  {
+    *t += regular ? delta : 1 + (TimestampTz) (rnd() * 2 * delta);
+    instants[i] = random_instant(temptype, hasz, *t);
+  }
+  bool lower_inc = (count == 1 || interp == DISCRETE) || rnd() < 0.5;
+  bool upper_inc = (count == 1 || interp == DISCRETE) || rnd() < 0.5;
+  /* Step sequences with an exclusive upper bound end with equal values */
+  if (interp == STEP && ! upper_inc)
+  {
+    TInstant *inst = tinstant_make(tinstant_value_p(instants[count - 2]),
+      temptype, instants[count - 1]->t);
+    free(instants[count - 1]);
+    instants[count - 1] = inst;
+  }
+  return tsequence_make_free(instants, count, lower_inc, upper_inc, interp,
+    true);
+}
+
+/* Return a random temporal value of a temporal type and subtype */
+static Temporal *
+random_temporal(meosType temptype, bool hasz, tempSubtype subtype,
+  interpType interp)
+{
+  TimestampTz t = (TimestampTz) (rnd() * 1e16) - INT64CONST(5000000000000000);
+  if (subtype == TINSTANT)
+    return (Temporal *) random_instant(temptype, hasz, t);
+  if (subtype == TSEQUENCE)
+    return (Temporal *) random_sequence(temptype, hasz, interp, &t);
+  int count = 1 + rnd_int(MAX_SEQUENCES);
+  /* The array and the sequences are freed by tsequenceset_make_free */
+  TSequence **sequences = malloc(sizeof(TSequence *) * count);
+  for (int i = 0; i < count; i++)
+  {
+    t += USECS_PER_MINUTE;
+    sequences[i] = random_sequence(temptype, hasz, interp, &t);
+  }
+  return (Temporal *) tsequenceset_make_free(sequences, count, true);
+}
+
+/* Verify the compressed representation of random values of a temporal type
+ * and a subtype */
+static void
+test_random(meosType temptype, bool hasz, tempSubtype subtype,
+  interpType interp)
+{
+  for (int i = 0; i < NO_VALUES; i++)
+  {
+    Temporal *temp = random_temporal(temptype, hasz, subtype, interp);
+    check_compressed(temp, true);
+    free(temp);
+  }
+  printf("%s%s %s%s: %d values verified\n", meostype_name(temptype),
+    hasz ? " 3D" : "", tempsubtype_name(subtype),
+    subtype == TINSTANT ? "" : (interp == DISCRETE ? " discrete" :
+      (interp == STEP ? " step" : " linear")), NO_VALUES);
+  return;
+}
+
+/*****************************************************************************/
+
+int
+main(void)
+{
+  /* Initialize MEOS */
+  test_initialize();
+  meos_initialize_error_handler(&test_count_errors);
+
+  test_fixed();
+
+  const meosType temptypes[] = {T_TBOOL, T_TINT, T_TFLOAT, T_TTEXT,
+    T_TGEOMPOINT, T_TGEOMPOINT, T_TGEOGPOINT, T_TGEOGPOINT};
+  for (size_t i = 0; i < sizeof(temptypes) / sizeof(meosType); i++)
+  {
+    meosType temptype = temptypes[i];
+    /* The temporal points are verified in 2D and in 3D */
+    bool hasz = (i > 0 && temptypes[i - 1] == temptype);
+    interpType interp = (temptype == T_TFLOAT || temptype == T_TGEOMPOINT ||
+      temptype == T_TGEOGPOINT) ? LINEAR : STEP;
+    test_random(temptype, hasz, TINSTANT, interp);
+    test_random(temptype, hasz, TSEQUENCE, DISCRETE);
+    test_random(temptype, hasz, TSEQUENCE, STEP);
+    test_random(temptype, hasz, TSEQUENCESET, STEP);
+    if (interp == LINEAR)
+    {
+      test_random(temptype, hasz, TSEQUENCE, LINEAR);
+      test_random(temptype, hasz, TSEQUENCESET, LINEAR);
+    }
+  }
+
+  /* Finalize MEOS */
+  return test_finalize();
+}
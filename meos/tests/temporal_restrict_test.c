@@ -0,0 +1,371 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the restriction of temporal sequences and
+ * sequence sets to timestamp sets and span sets
+ *
+ * The restrictions merge the instants of the sequences with the elements of
+ * the set or the spans of the span set, which are located with a galloping
+ * search that starts from the segment found for the previous element. The
+ * program generates random temporal floats with step and linear
+ * interpolation made of up to many composing sequences, random timestamp
+ * sets and span sets whose bounds often coincide with the instants of the
+ * values, and verifies that
+ * - the result of `temporal_at_tstzset()` has one instant for each timestamp
+ *   of the set at which the value is defined, with the same value;
+ * - the time of the results of `temporal_minus_tstzset()`,
+ *   `temporal_at_tstzspanset()`, and `temporal_minus_tstzspanset()` is,
+ *   respectively, the time of the value minus the timestamps, intersected
+ *   with the span set, and minus the span set;
+ * - the results have the value of the temporal float wherever they are
+ *   defined;
+ * - a sequence with few instants split by many timestamps yields one
+ *   sequence more than the number of timestamps.
+ *
+ * The program returns a nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o temporal_restrict_test temporal_restrict_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <meos.h>
+#include <meos_internal.h>
+#include "meos_test.h"
+
+/* Number of random values of each interpolation and number of sequences */
+#define NO_VALUES 20
+/* Number of random sets and span sets for each value */
+#define NO_SETS 10
+/* Maximum number of instants of the random sequences */
+#define MAX_INSTANTS 30
+/* Maximum number of elements of the random sets and span sets */
+#define MAX_ELEMS 200
+/* Number of microseconds in a minute */
+#define USECS_PER_MINUTE INT64CONST(60000000)
+/* Tolerance for the comparison of the values */
+#define EPSILON 1.0e-9
+
+/*****************************************************************************/
+
+/* Return a random temporal float sequence with the given interpolation
+ * starting at the timestamp t, which is set to the end of the sequence */
+static TSequence *
+random_sequence(interpType interp, TimestampTz *t)
+{
+  int count = 1 + rnd_int(MAX_INSTANTS);
+  /* The array and the instants are freed by tsequence_make_free */
+  TInstant **instants = malloc(sizeof(TInstant *) * count);
+  /* Instantaneous sequences have inclusive bounds */
+  bool lower_inc = (count == 1) || rnd() < 0.5;
+  bool upper_inc = (count == 1) || rnd() < 0.5;
+  double v = 0.0;
+  for (int i = 0; i < count; i++)
+  {
+    if (i > 0)
+      *t += USECS_PER_MINUTE * (1 + rnd_int(10));
+    /* Step sequences with an exclusive upper bound end with equal values */
+    if (! (i == count - 1 && i > 0 && interp == STEP && ! upper_inc))
+      v = rnd_int(10) + rnd();
+    instants[i] = tinstant_make(Float8GetDatum(v), T_TFLOAT, *t);
+  }
+  return tsequence_make_free(instants, count, lower_inc, upper_inc, interp,
+    true);
+}
+
+/* Return a random temporal float with the given interpolation, which is a
+ * sequence when the number of sequences is 1 and a sequence set otherwise */
+static Temporal *
+random_tfloat(interpType interp, int nseqs)
+{
+  TimestampTz t = 0;
+  if (nseqs == 1)
+    return (Temporal *) random_sequence(interp, &t);
+  /* The array and the sequences are freed by tsequenceset_make_free */
+  TSequence **sequences = malloc(sizeof(TSequence *) * nseqs);
+  for (int i = 0; i < nseqs; i++)
+  {
+    sequences[i] = random_sequence(interp, &t);
+    t += USECS_PER_MINUTE * (1 + rnd_int(10));
+  }
+  return (Temporal *) tsequenceset_make_free(sequences, nseqs, true);
+}
+
+/* Return a random timestamp on the minute grid around the time span of a
+ * temporal value, so that it often coincides with one of its instants */
+static TimestampTz
+random_timestamptz(const Span *s)
+{
+  int64 minutes = (DatumGetTimestampTz(s->upper) -
+    DatumGetTimestampTz(s->lower)) / USECS_PER_MINUTE;
+  return DatumGetTimestampTz(s->lower) +
+    USECS_PER_MINUTE * (rnd_int((int) minutes + 20) - 10);
+}
+
+/* Return a random timestamp set around the time span of a temporal value */
+static Set *
+random_tstzset(const Span *s)
+{
+  int count = 1 + rnd_int(MAX_ELEMS);
+  TimestampTz *times = malloc(sizeof(TimestampTz) * count);
+  for (int i = 0; i < count; i++)
+    times[i] = random_timestamptz(s);
+  /* The timestamps are sorted and their duplicates are removed */
+  Set *result = tstzset_make(times, count);
+  free(times);
+  return result;
+}
+
+/* Return a random span set around the time span of a temporal value */
+static SpanSet *
+random_tstzspanset(const Span *s)
+{
+  int count = 1 + rnd_int(MAX_ELEMS);
+  Span *spans = malloc(sizeof(Span) * count);
+  for (int i = 0; i < count; i++)
+  {
+    TimestampTz lower = random_timestamptz(s);
+    TimestampTz upper = lower + USECS_PER_MINUTE * rnd_int(5);
+    /* Instantaneous spans have inclusive bounds */
+    bool lower_inc = (lower == upper) || rnd() < 0.5;
+    bool upper_inc = (lower == upper) || rnd() < 0.5;
+    span_set(TimestampTzGetDatum(lower), TimestampTzGetDatum(upper),
+      lower_inc, upper_inc, T_TIMESTAMPTZ, T_TSTZSPAN, &spans[i]);
+  }
+  /* The spans are sorted and normalized */
+  SpanSet *result = spanset_make(spans, count);
+  free(spans);
+  return result;
+}
+
+/*****************************************************************************/
+
+/* Report a failure of a restriction of a temporal value */
+static void
+report_fail(const char *msg, const Temporal *temp, char *arg_str)
+{
+  char *temp_str = temporal_out(temp, 6);
+  test_fail("%s of %s to %s", msg, temp_str, arg_str);
+  free(temp_str); free(arg_str);
+  return;
+}
+
+/* Verify that the time of a result is the expected one, where NULL denotes
+ * the empty time */
+static bool
+check_time(const Temporal *result, const SpanSet *expected)
+{
+  if (! result || ! expected)
+    return ! result && ! expected;
+  SpanSet *time = temporal_time(result);
+  bool ok = spanset_eq(time, expected);
+  free(time);
+  return ok;
+}
+
+/* Verify that a result has the value of the temporal value at its instants
+ * and at random timestamps where it is defined */
+static bool
+check_values(const Temporal *temp, const Temporal *result)
+{
+  if (! result)
+    return true;
+  const Span *s = &((const TSequenceSet *) temp)->period;
+  if (temp->subtype == TSEQUENCE)
+    s = &((const TSequence *) temp)->period;
+  int count = temporal_num_instants(result);
+  for (int i = 0; i < count + MAX_INSTANTS; i++)
+  {
+    TimestampTz t;
+    if (i < count)
+    {
+      TInstant *inst = temporal_instant_n(result, i + 1);
+      t = inst->t;
+      free(inst);
+    }
+    else
+      t = random_timestamptz(s);
+    double value1, value2;
+    if (! tfloat_value_at_timestamptz(result, t, true, &value1))
+      continue;
+    if (! tfloat_value_at_timestamptz(temp, t, false, &value2) ||
+        fabs(value1 - value2) > EPSILON)
+      return false;
+  }
+  return true;
+}
+
+/* Verify the restriction of a temporal value to a timestamp set */
+static void
+test_tstzset(const Temporal *temp, const Set *s)
+{
+  /* Restriction to the set */
+  Temporal *result = temporal_at_tstzset(temp, s);
+  int count = 0;
+  bool ok = true;
+  for (int i = 0; i < s->count && ok; i++)
+  {
+    TimestampTz t = DatumGetTimestampTz(SET_VAL_N(s, i));
+    double value1, value2;
+    if (! tfloat_value_at_timestamptz(temp, t, true, &value1))
+      continue;
+    count++;
+    ok = result && tfloat_value_at_timestamptz(result, t, true, &value2) &&
+      fabs(value1 - value2) <= EPSILON;
+  }
+  if (! ok || (result && temporal_num_instants(result) != count))
+    report_fail("at", temp, tstzset_out(s));
+  free(result);
+
+  /* Restriction to the complement of the set */
+  result = temporal_minus_tstzset(temp, s);
+  SpanSet *expected = temporal_time(temp);
+  for (int i = 0; i < s->count && expected; i++)
+  {
+    SpanSet *expected1 = minus_spanset_timestamptz(expected,
+      DatumGetTimestampTz(SET_VAL_N(s, i)));
+    free(expected);
+    expected = expected1;
+  }
+  if (! check_time(result, expected) || ! check_values(temp, result))
+    report_fail("minus", temp, tstzset_out(s));
+  free(expected); free(result);
+  return;
+}
+
+/* Verify the restriction of a temporal value to a span set */
+static void
+test_tstzspanset(const Temporal *temp, const SpanSet *ss)
+{
+  SpanSet *time = temporal_time(temp);
+  /* Restriction to the span set */
+  Temporal *result = temporal_at_tstzspanset(temp, ss);
+  SpanSet *expected = intersection_spanset_spanset(time, ss);
+  if (! check_time(result, expected) || ! check_values(temp, result))
+    report_fail("at", temp, tstzspanset_out(ss));
+  free(expected); free(result);
+
+  /* Restriction to the complement of the span set */
+  result = temporal_minus_tstzspanset(temp, ss);
+  expected = minus_spanset_spanset(time, ss);
+  if (! check_time(result, expected) || ! check_values(temp, result))
+    report_fail("minus", temp, tstzspanset_out(ss));
+  free(expected); free(result); free(time);
+  return;
+}
+
+/* Verify the restrictions of random values with the given interpolation and
+ * number of sequences to random timestamp sets and span sets */
+static void
+test_random(interpType interp, int nseqs)
+{
+  for (int i = 0; i < NO_VALUES; i++)
+  {
+    Temporal *temp = random_tfloat(interp, nseqs);
+    const Span *s = (nseqs == 1) ? &((const TSequence *) temp)->period :
+      &((const TSequenceSet *) temp)->period;
+    for (int j = 0; j < NO_SETS; j++)
+    {
+      Set *set = random_tstzset(s);
+      test_tstzset(temp, set);
+      SpanSet *ss = random_tstzspanset(s);
+      test_tstzspanset(temp, ss);
+      free(set); free(ss);
+    }
+    free(temp);
+  }
+  printf("%s interpolation with %d sequences: %d values verified\n",
+    interp == STEP ? "Step" : "Linear", nseqs, NO_VALUES);
+  return;
+}
+
+/* Verify the restriction of sequences with few instants to many timestamps,
+ * which split each sequence into more sequences than it has instants */
+static void
+test_few_instants(void)
+{
+  const char *values[] = {
+    "[1@2000-01-01, 2@2000-01-02]",
+    "[1@2000-01-01, 2@2000-01-02, 3@2000-01-03)",
+    "{[1@2000-01-01, 2@2000-01-02], [3@2000-01-03, 4@2000-01-04]}"
+  };
+  /* One timestamp per hour from 2000-01-01 00:30 on, inside the sequences */
+  TimestampTz times[MAX_ELEMS];
+  TimestampTz t = pg_timestamptz_in("2000-01-01 00:30:00", -1);
+  for (int i = 0; i < MAX_ELEMS; i++)
+    times[i] = t + i * (INT64CONST(60) * USECS_PER_MINUTE);
+  for (size_t i = 0; i < sizeof(values) / sizeof(char *); i++)
+  {
+    Temporal *temp = tfloat_in(values[i]);
+    /* Keep the timestamps strictly inside the composing sequences */
+    TimestampTz end = DatumGetTimestampTz(temp->subtype == TSEQUENCE ?
+      ((TSequence *) temp)->period.upper : TSEQUENCESET_SEQ_N(
+        (TSequenceSet *) temp, 0)->period.upper);
+    int count = 0;
+    while (count < MAX_ELEMS && times[count] < end)
+      count++;
+    Set *s = tstzset_make(times, count);
+    Temporal *result = temporal_minus_tstzset(temp, s);
+    int nseqs = temporal_num_sequences(temp);
+    if (! result || temporal_num_sequences(result) != count + nseqs)
+      report_fail("minus", temp, tstzset_out(s));
+    test_tstzset(temp, s);
+    free(result); free(s); free(temp);
+  }
+  printf("Sequences with few instants split by many timestamps verified\n");
+  return;
+}
+
+/*****************************************************************************/
+
+int
+main(void)
+{
+  /* Initialize MEOS */
+  test_initialize();
+
+  test_few_instants();
+  int nseqs[] = {1, 2, 10, 50};
+  for (int i = 0; i < 4; i++)
+  {
+    test_random(STEP, nseqs[i]);
+    test_random(LINEAR, nseqs[i]);
+  }
+
+  /* Finalize MEOS */
+  return test_finalize();
+}
+
+/*****************************************************************************/
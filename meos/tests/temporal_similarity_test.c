@@ -0,0 +1,276 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the Frechet and the Dynamic Time Warp
+ * distances restricted to a Sakoe-Chiba band and with an abandoning
+ * threshold against a computation with the full distance matrix
+ *
+ * The program generates random temporal floats and 2D and 3D temporal
+ * points with integral coordinates and verifies that the functions
+ * `temporal_frechet_distance_band()` and
+ * `temporal_dyntimewarp_distance_band()` return the same distance as the
+ * full distance matrix in which the cells outside the band are ignored.
+ * Without band, or with a band wider than the values, the distance must be
+ * the one of `temporal_frechet_distance()` and
+ * `temporal_dyntimewarp_distance()`. When the threshold is not less than
+ * the distance, the distance must be returned, in particular when it is
+ * equal to the distance, otherwise the result must be a lower bound of the
+ * distance that is greater than the threshold. The program returns a
+ * nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o temporal_similarity_test temporal_similarity_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include "meos_test.h"
+
+/* Number of pairs of values per kind of temporal values */
+#define NO_PAIRS 200
+/* Maximum number of instants of a value */
+#define MAX_INSTANTS 60
+/* Number of microseconds in a minute */
+#define USECS_PER_MINUTE INT64CONST(60000000)
+
+/* Similarity distances */
+typedef enum
+{
+  FRECHET,
+  DYNTIMEWARP,
+} simfunc;
+
+/* Coordinates of the instants of a value */
+typedef struct
+{
+  int count;
+  double x[MAX_INSTANTS];
+  double y[MAX_INSTANTS];
+  double z[MAX_INSTANTS];
+} coords;
+
+/* Origin of the timestamps */
+static TimestampTz t0;
+
+/*****************************************************************************/
+
+/* Generate a random value with 1 to MAX_INSTANTS instants, whose number of
+ * coordinates is given by @p ndims, 1 meaning a temporal float */
+static Temporal *
+random_value(int ndims, coords *c)
+{
+  TInstant *instants[MAX_INSTANTS];
+  c->count = 1 + rnd_int(MAX_INSTANTS);
+  for (int i = 0; i < c->count; i++)
+  {
+    TimestampTz t = t0 + i * USECS_PER_MINUTE;
+    c->x[i] = rnd_int(20);
+    c->y[i] = ndims > 1 ? rnd_int(20) : 0.0;
+    c->z[i] = ndims > 2 ? rnd_int(20) : 0.0;
+    if (ndims == 1)
+      instants[i] = tfloatinst_make(c->x[i], t);
+    else
+    {
+      GSERIALIZED *gs = (ndims == 2) ?
+        geompoint_make2d(3857, c->x[i], c->y[i]) :
+        geompoint_make3dz(3857, c->x[i], c->y[i], c->z[i]);
+      instants[i] = tpointinst_make(gs, t);
+      free(gs);
+    }
+  }
+  Temporal *result = (Temporal *) tsequence_make((const TInstant **) instants,
+    c->count, true, true, LINEAR, false);
+  for (int i = 0; i < c->count; i++)
+    free(instants[i]);
+  return result;
+}
+
+/* Return the distance between the i-th instant of the first value and the
+ * j-th instant of the second one */
+static double
+instant_distance(const coords *c1, int i, const coords *c2, int j, int ndims)
+{
+  if (ndims == 1)
+    return fabs(c2->x[j] - c1->x[i]);
+  double dx = c2->x[j] - c1->x[i];
+  double dy = c2->y[j] - c1->y[i];
+  double dz = c2->z[j] - c1->z[i];
+  return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/* Return the similarity distance computed with the full distance matrix, in
+ * which the cells outside the band are ignored. As in MEOS, the rows of the
+ * matrix are the instants of the longest value and the band follows the
+ * diagonal of the matrix */
+static double
+full_matrix_distance(const coords *c1, const coords *c2, int ndims,
+  simfunc func, int band)
+{
+  if (c1->count <= c2->count)
+  {
+    const coords *tmp = c1; c1 = c2; c2 = tmp;
+  }
+  int n1 = c1->count, n2 = c2->count;
+  double *dist = malloc(sizeof(double) * n1 * n2);
+  for (int i = 0; i < n1; i++)
+  {
+    int center = (n1 > 1) ? (int) (((int64) i * (n2 - 1)) / (n1 - 1)) : 0;
+    for (int j = 0; j < n2; j++)
+    {
+      if (band >= 0 && abs(j - center) > band)
+      {
+        dist[i * n2 + j] = DBL_MAX;
+        continue;
+      }
+      double best;
+      if (i == 0 && j == 0)
+        best = 0.0;
+      else
+      {
+        best = DBL_MAX;
+        if (i > 0)
+          best = fmin(best, dist[(i - 1) * n2 + j]);
+        if (j > 0)
+          best = fmin(best, dist[i * n2 + j - 1]);
+        if (i > 0 && j > 0)
+          best = fmin(best, dist[(i - 1) * n2 + j - 1]);
+      }
+      double d = instant_distance(c1, i, c2, j, ndims);
+      dist[i * n2 + j] = (func == FRECHET) ? fmax(d, best) : d + best;
+    }
+  }
+  double result = dist[n1 * n2 - 1];
+  free(dist);
+  return result;
+}
+
+/* Return the similarity distance restricted to a band with a threshold */
+static double
+band_distance(const Temporal *temp1, const Temporal *temp2, simfunc func,
+  int band, double maxdist)
+{
+  return (func == FRECHET) ?
+    temporal_frechet_distance_band(temp1, temp2, band, maxdist) :
+    temporal_dyntimewarp_distance_band(temp1, temp2, band, maxdist);
+}
+
+/* Verify the distances of a pair of values */
+static void
+check_pair(const char *name, const Temporal *temp1, const coords *c1,
+  const Temporal *temp2, const coords *c2, int ndims, simfunc func)
+{
+  static const int bands[] = {-1, 0, 1, 2, 5, MAX_INSTANTS};
+  const char *fname = (func == FRECHET) ? "Frechet" : "DTW";
+  double full = (func == FRECHET) ?
+    temporal_frechet_distance(temp1, temp2) :
+    temporal_dyntimewarp_distance(temp1, temp2);
+  double prev = DBL_MAX;
+  for (size_t k = 0; k < sizeof(bands) / sizeof(int); k++)
+  {
+    int band = bands[k];
+    double expected = full_matrix_distance(c1, c2, ndims, func, band);
+    double d = band_distance(temp1, temp2, func, band, -1.0);
+    if (d != expected)
+    {
+      test_fail("%s %s band %d: %.17g instead of %.17g", name, fname, band, d,
+        expected);
+      continue;
+    }
+    /* Without band or with a band wider than the values, the band does not
+     * restrict the matching */
+    if ((band < 0 || band == MAX_INSTANTS) && d != full)
+      test_fail("%s %s band %d: %.17g instead of the distance %.17g", name,
+        fname, band, d, full);
+    /* A wider band can only decrease the distance */
+    if (band >= 0 && d > prev)
+      test_fail("%s %s band %d: %.17g greater than for a narrower band", name,
+        fname, band, d);
+    if (band >= 0)
+      prev = d;
+
+    /* The threshold is either the distance itself, which is the cut-off
+     * boundary, a larger value, or values less than the distance */
+    double thresholds[] = {d, d + 1.0, nextafter(d, 0.0), d / 2, 0.0};
+    for (size_t l = 0; l < sizeof(thresholds) / sizeof(double); l++)
+    {
+      double maxdist = thresholds[l];
+      double r = band_distance(temp1, temp2, func, band, maxdist);
+      if (maxdist >= d)
+      {
+        if (r != d)
+          test_fail("%s %s band %d maxdist %.17g: %.17g instead of %.17g",
+            name, fname, band, maxdist, r, d);
+      }
+      else if (r <= maxdist || r > d)
+        test_fail("%s %s band %d maxdist %.17g: %.17g is not a lower bound "
+          "of %.17g greater than the threshold", name, fname, band, maxdist,
+          r, d);
+    }
+  }
+  return;
+}
+
+/* Verify the distances of random pairs of values */
+static void
+test_similarity(const char *name, int ndims)
+{
+  int failures = nfailures;
+  for (int i = 0; i < NO_PAIRS; i++)
+  {
+    coords c1, c2;
+    Temporal *temp1 = random_value(ndims, &c1);
+    Temporal *temp2 = random_value(ndims, &c2);
+    check_pair(name, temp1, &c1, temp2, &c2, ndims, FRECHET);
+    check_pair(name, temp1, &c1, temp2, &c2, ndims, DYNTIMEWARP);
+    free(temp1); free(temp2);
+  }
+  printf("%s: %d pairs verified%s\n", name, NO_PAIRS,
+    nfailures > failures ? " with failures" : "");
+  return;
+}
+
+/* Main program */
+int
+main(void)
+{
+  test_initialize();
+  t0 = pg_timestamptz_in("2025-01-01", -1);
+  test_similarity("tfloat", 1);
+  test_similarity("tgeompoint 2D", 2);
+  test_similarity("tgeompoint 3D", 3);
+  return test_finalize();
+}
@@ -0,0 +1,268 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the function `temparr_tprecision()`, which
+ * sets the precision of an array of temporal values to the same time bins
+ *
+ * The program generates random arrays of temporal integers, floats, and
+ * geometry points of all subtypes with step and linear interpolation, whose
+ * values span different numbers of bins, and verifies that
+ * - the result for each value is the one of `temporal_tprecision()`;
+ * - the value of each bin of the continuous sequences and sequence sets is
+ *   the time-weighted average or centroid of the value restricted to the
+ *   bin, as computed by `tnumber_twavg()` and `tpoint_twcentroid()`, which
+ *   in particular verifies the step temporal points;
+ * - arrays with a value that is not a temporal number or a temporal point are
+ *   rejected with an error.
+ *
+ * The program returns a nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o temporal_tprecision_test temporal_tprecision_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal.h>
+#include "meos_test.h"
+
+/* Number of random arrays of each type and interpolation */
+#define NO_ARRAYS 50
+/* Maximum number of values of the random arrays */
+#define MAX_VALUES 10
+/* Maximum number of sequences of the random sequence sets */
+#define MAX_SEQUENCES 3
+/* Maximum number of instants of the random sequences */
+#define MAX_INSTANTS 20
+/* Number of microseconds in a minute */
+#define USECS_PER_MINUTE INT64CONST(60000000)
+/* Tolerance for the comparison of the values of the bins */
+#define EPSILON 1.0e-6
+
+/*****************************************************************************/
+
+/* Return a random sequence of the given temporal type and interpolation
+ * starting at the timestamp t, which is set to the end of the sequence */
+static TSequence *
+random_sequence(meosType temptype, interpType interp, TimestampTz *t)
+{
+  int count = 1 + rnd_int(MAX_INSTANTS);
+  /* The array and the instants are freed by tsequence_make_free */
+  TInstant **instants = malloc(sizeof(TInstant *) * count);
+  /* Instantaneous sequences have inclusive bounds */
+  bool lower_inc = (count == 1) || rnd() < 0.5;
+  bool upper_inc = (count == 1) || rnd() < 0.5;
+  double v = 0.0, x = 0.0, y = 0.0;
+  for (int i = 0; i < count; i++)
+  {
+    if (i > 0)
+      *t += USECS_PER_MINUTE * (1 + rnd_int(90));
+    /* Step sequences with an exclusive upper bound end with equal values */
+    if (! (i == count - 1 && i > 0 && interp == STEP && ! upper_inc))
+    {
+      v = (temptype == T_TINT) ? rnd_int(10) : rnd_int(10) + rnd();
+      x = rnd_int(100) + rnd(); y = rnd_int(100) + rnd();
+    }
+    if (temptype == T_TINT)
+      instants[i] = tinstant_make(Int32GetDatum((int) v), temptype, *t);
+    else if (temptype == T_TFLOAT)
+      instants[i] = tinstant_make(Float8GetDatum(v), temptype, *t);
+    else
+      instants[i] = tinstant_make_free(
+        PointerGetDatum(geompoint_make2d(3857, x, y)), temptype, *t);
+  }
+  return tsequence_make_free(instants, count, lower_inc, upper_inc, interp,
+    true);
+}
+
+/* Return a random temporal value of the given temporal type, interpolation,
+ * and subtype, which starts at a random timestamp in a range of a few days
+ * so that the values of an array span different numbers of bins */
+static Temporal *
+random_temporal(meosType temptype, interpType interp, tempSubtype subtype)
+{
+  TimestampTz t = USECS_PER_MINUTE * rnd_int(3 * 24 * 60);
+  if (subtype == TINSTANT)
+  {
+    TSequence *seq = random_sequence(temptype, interp, &t);
+    Temporal *result = (Temporal *) tinstant_copy(TSEQUENCE_INST_N(seq, 0));
+    free(seq);
+    return result;
+  }
+  if (subtype == TSEQUENCE)
+    return (Temporal *) random_sequence(temptype, interp, &t);
+  int count = 1 + rnd_int(MAX_SEQUENCES);
+  /* The array and the sequences are freed by tsequenceset_make_free */
+  TSequence **sequences = malloc(sizeof(TSequence *) * count);
+  for (int i = 0; i < count; i++)
+  {
+    sequences[i] = random_sequence(temptype, interp, &t);
+    t += USECS_PER_MINUTE * (1 + rnd_int(90));
+  }
+  return (Temporal *) tsequenceset_make_free(sequences, count, true);
+}
+
+/*****************************************************************************/
+
+/* Verify that the value of each bin of the result is the time-weighted
+ * average or centroid of the value restricted to the bin */
+static void
+check_bins(const Temporal *temp, const Temporal *result,
+  const Interval *duration)
+{
+  int count = temporal_num_instants(result);
+  for (int i = 0; i < count; i++)
+  {
+    TInstant *inst = temporal_instant_n(result, i + 1);
+    Span *bin = tstzspan_make(inst->t,
+      add_timestamptz_interval(inst->t, duration), true, false);
+    Temporal *at = temporal_at_tstzspan(temp, bin);
+    bool ok;
+    /* A bin starting at the exclusive upper bound of a sequence only contains
+     * the last instant of the sequence, which is not kept by the restriction */
+    if (! at)
+      ok = true;
+    else if (temp->temptype == T_TGEOMPOINT)
+    {
+      GSERIALIZED *expected = tpoint_twcentroid(at);
+      GSERIALIZED *value = tgeo_start_value((Temporal *) inst);
+      ok = geom_distance2d(value, expected) < EPSILON;
+      free(expected); free(value);
+    }
+    else
+      ok = fabs(tfloat_start_value((Temporal *) inst) - tnumber_twavg(at)) <
+        EPSILON;
+    if (! ok)
+    {
+      char *temp_str = temporal_out(temp, 6);
+      char *bin_str = tstzspan_out(bin);
+      test_fail("value of the bin %s: %s", bin_str, temp_str);
+      free(temp_str); free(bin_str);
+    }
+    free(inst); free(bin); free(at);
+    if (! ok)
+      break;
+  }
+  return;
+}
+
+/* Verify the function on random arrays of the given temporal type and
+ * interpolation */
+static void
+test_random(meosType temptype, interpType interp, const Interval *duration)
+{
+  Temporal *temparr[MAX_VALUES];
+  TimestampTz torigin = USECS_PER_MINUTE * rnd_int(24 * 60);
+  for (int i = 0; i < NO_ARRAYS; i++)
+  {
+    int count = 1 + rnd_int(MAX_VALUES);
+    for (int j = 0; j < count; j++)
+      temparr[j] = random_temporal(temptype, interp,
+        (tempSubtype) (TINSTANT + rnd_int(3)));
+    Temporal **result = temparr_tprecision((const Temporal **) temparr,
+      count, duration, torigin);
+    for (int j = 0; j < count; j++)
+    {
+      Temporal *expected = temporal_tprecision(temparr[j], duration,
+        torigin);
+      if (! result || ! result[j] || ! expected ||
+          ! temporal_eq(result[j], expected))
+      {
+        char *str = temporal_out(temparr[j], 6);
+        test_fail("temparr_tprecision: %s", str);
+        free(str);
+      }
+      else if (temparr[j]->subtype != TINSTANT)
+        check_bins(temparr[j], result[j], duration);
+      free(expected);
+      if (result)
+        free(result[j]);
+      free(temparr[j]);
+    }
+    free(result);
+  }
+  printf("%s with %s interpolation: %d arrays verified\n",
+    meostype_name(temptype), interp == STEP ? "step" : "linear", NO_ARRAYS);
+  return;
+}
+
+/* Verify that the arrays with a value of an invalid type are rejected */
+static void
+test_invalid(const Interval *duration)
+{
+  Temporal *temparr[2];
+  temparr[0] = tfloat_in("[1@2000-01-01, 2@2000-01-02]");
+  temparr[1] = tbool_in("[t@2000-01-01, f@2000-01-02]");
+  nerrors = 0;
+  Temporal **result = temparr_tprecision((const Temporal **) temparr, 2,
+    duration, 0);
+  if (result || nerrors == 0)
+    test_fail("temparr_tprecision: an array with a tbool is not rejected");
+  nerrors = 0;
+  result = temparr_tprecision((const Temporal **) temparr, 0, duration, 0);
+  if (result || nerrors == 0)
+    test_fail("temparr_tprecision: an empty array is not rejected");
+  nerrors = 0;
+  free(temparr[0]); free(temparr[1]);
+  return;
+}
+
+/*****************************************************************************/
+
+int
+main(void)
+{
+  /* Initialize MEOS */
+  test_initialize();
+  meos_initialize_error_handler(&test_count_errors);
+
+  const char *durations[] = {"15 minutes", "1 hour", "1 day"};
+  for (int i = 0; i < 3; i++)
+  {
+    Interval *duration = pg_interval_in(durations[i], -1);
+    test_random(T_TINT, STEP, duration);
+    test_random(T_TFLOAT, STEP, duration);
+    test_random(T_TFLOAT, LINEAR, duration);
+    test_random(T_TGEOMPOINT, STEP, duration);
+    test_random(T_TGEOMPOINT, LINEAR, duration);
+    if (i == 0)
+      test_invalid(duration);
+    free(duration);
+  }
+
+  /* Finalize MEOS */
+  return test_finalize();
+}
@@ -0,0 +1,319 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the Well-Known Binary (WKB) representation
+ * of temporal values written into a buffer given by the caller and read back
+ *
+ * For temporal values of every subtype and of point and non-point temporal
+ * types, and for the little-endian (NDR) and big-endian (XDR) byte orders,
+ * the program verifies that
+ * - `temporal_wkb_size()` returns the size of the output of
+ *   `temporal_as_wkb()`
+ * - `temporal_as_wkb_buf()` writes the same bytes as `temporal_as_wkb()`
+ *   into a buffer of this size
+ * - `temporal_as_wkb_buf()` raises an error and returns 0 when the buffer
+ *   is too small
+ * - `temporal_from_wkb()` reads back the temporal value.
+ *
+ * The program also reads temporal point sequences in which the points are
+ * copied directly from the WKB, when the byte order is the one of the
+ * machine, or parsed one by one otherwise. It verifies that both ways
+ * reject the sequences with an empty point or with points that do not have
+ * the same dimensionality. The program returns a nonzero exit status on
+ * failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o temporal_wkb_test temporal_wkb_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include "meos_test.h"
+
+/* Byte orders of the output */
+static const uint8_t variants[] = {WKB_NDR, WKB_XDR};
+static const char *variant_names[] = {"NDR", "XDR"};
+#define NO_VARIANTS 2
+
+/* Temporal values written and read back */
+static const char *tbool_texts[] = {
+  "t@2001-01-01",
+  "{t@2001-01-01, f@2001-01-02}",
+  "[t@2001-01-01, f@2001-01-02]",
+  "{[t@2001-01-01, f@2001-01-02], [t@2001-01-03]}",
+};
+static const char *tint_texts[] = {
+  "1@2001-01-01",
+  "{1@2001-01-01, 2@2001-01-02, 1@2001-01-03}",
+  "[1@2001-01-01, 2@2001-01-02]",
+  "{[1@2001-01-01, 2@2001-01-02], [3@2001-01-03, 3@2001-01-04]}",
+};
+static const char *tfloat_texts[] = {
+  "1.5@2001-01-01",
+  "Interp=Step;[1.5@2001-01-01, 2.5@2001-01-02]",
+  "[1.5@2001-01-01, 2.5@2001-01-02, 1@2001-01-03)",
+  "{[1.5@2001-01-01, 2.5@2001-01-02], (3.5@2001-01-03, 1@2001-01-04]}",
+};
+static const char *ttext_texts[] = {
+  "AAA@2001-01-01",
+  "{AAA@2001-01-01, BBBBBBB@2001-01-02}",
+  "[AAA@2001-01-01, BBBBBBB@2001-01-02]",
+  "{[AAA@2001-01-01], [BBBBBBB@2001-01-02, C@2001-01-03]}",
+};
+static const char *tgeompoint_texts[] = {
+  "POINT(1 1)@2001-01-01",
+  "{POINT(1 1)@2001-01-01, POINT(2 2)@2001-01-02}",
+  "[POINT(1 1)@2001-01-01, POINT(2 2)@2001-01-02, POINT(5 1)@2001-01-03]",
+  "SRID=3857;{[POINT(1 1)@2001-01-01, POINT(2 2)@2001-01-02],"
+    "[POINT(3 3)@2001-01-03, POINT(1 5)@2001-01-04]}",
+  "[POINT Z(1 1 1)@2001-01-01, POINT Z(2 2 3)@2001-01-02, "
+    "POINT Z(5 1 2)@2001-01-03]",
+  "{[POINT Z(1 1 1)@2001-01-01], [POINT Z(2 2 3)@2001-01-02, "
+    "POINT Z(5 1 2)@2001-01-03]}",
+};
+static const char *tgeogpoint_texts[] = {
+  "POINT(1 1)@2001-01-01",
+  "[POINT(1 1)@2001-01-01, POINT(2 2)@2001-01-02, POINT(5 1)@2001-01-03]",
+  "{[POINT Z(1 1 1)@2001-01-01], [POINT Z(2 2 3)@2001-01-02, "
+    "POINT Z(5 1 2)@2001-01-03]}",
+};
+
+/*****************************************************************************/
+
+/* Verify the WKB representation of a temporal value given with its text
+ * representation */
+static void
+check_value(const char *name, const char *str, const Temporal *temp)
+{
+  for (int v = 0; v < NO_VARIANTS; v++)
+  {
+    uint8_t variant = (uint8_t) (variants[v] | WKB_EXTENDED);
+    size_t size;
+    uint8_t *wkb = temporal_as_wkb(temp, variant, &size);
+    size_t size1 = temporal_wkb_size(temp, variant);
+    if (size1 != size)
+    {
+      test_fail("%s %s %s: size %zu instead of %zu", name,
+        variant_names[v], str, size1, size);
+      free(wkb);
+      continue;
+    }
+
+    /* Buffer of the exact size, whose last byte is followed by a guard */
+    uint8_t *buf = malloc(size + 1);
+    buf[size] = 0xAA;
+    size_t size2 = temporal_as_wkb_buf(temp, variant, buf, size);
+    if (size2 != size || memcmp(buf, wkb, size) != 0 || buf[size] != 0xAA)
+      test_fail("%s %s %s: the output in the buffer differs", name,
+        variant_names[v], str);
+
+    /* Buffer too small */
+    nerrors = 0;
+    size2 = temporal_as_wkb_buf(temp, variant, buf, size - 1);
+    if (size2 != 0 || nerrors != 1)
+      test_fail("%s %s %s: no error for a buffer of size %zu", name,
+        variant_names[v], str, size - 1);
+    nerrors = 0;
+
+    /* Read back */
+    Temporal *temp1 = temporal_from_wkb(wkb, size);
+    if (! temp1 || ! temporal_eq(temp, temp1))
+      test_fail("%s %s %s: the value read back differs", name,
+        variant_names[v], str);
+    free(temp1); free(buf); free(wkb);
+  }
+  return;
+}
+
+/* Verify the WKB representation of temporal values given by their text
+ * representation */
+static void
+test_values(const char *name, Temporal *(*in)(const char *),
+  const char **values, int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    Temporal *temp = in(values[i]);
+    check_value(name, values[i], temp);
+    free(temp);
+  }
+  return;
+}
+
+/*****************************************************************************/
+
+/* Write a double in a byte order */
+static void
+write_double(uint8_t *buf, double d, bool xdr)
+{
+  uint8_t bytes[8];
+  memcpy(bytes, &d, 8);
+  for (int i = 0; i < 8; i++)
+    buf[i] = bytes[xdr ? 7 - i : i];
+  return;
+}
+
+/* Verify that a WKB is rejected with an error */
+static void
+check_rejected(const char *name, const char *variant, const uint8_t *wkb,
+  size_t size)
+{
+  nerrors = 0;
+  Temporal *temp = temporal_from_wkb(wkb, size);
+  if (temp || nerrors == 0)
+    test_fail("%s %s: the WKB is not rejected", name, variant);
+  free(temp);
+  nerrors = 0;
+  return;
+}
+
+/* Verify that temporal point sequences with an empty point or with points of
+ * different dimensionality are rejected. The WKB of a sequence of three
+ * instants is the header followed by the instants, whose size is the
+ * difference between the sizes of the WKB of sequences of three and two
+ * instants */
+static void
+test_invalid_points(void)
+{
+  Temporal *seq2d = tgeompoint_in(
+    "[POINT(1 1)@2001-01-01, POINT(2 2)@2001-01-02, POINT(5 1)@2001-01-03]");
+  Temporal *seq2d_2 = tgeompoint_in(
+    "[POINT(1 1)@2001-01-01, POINT(2 2)@2001-01-02]");
+  Temporal *seq3d = tgeompoint_in("[POINT Z(1 1 1)@2001-01-01, "
+    "POINT Z(2 2 3)@2001-01-02, POINT Z(5 1 2)@2001-01-03]");
+  Temporal *seq3d_2 = tgeompoint_in(
+    "[POINT Z(1 1 1)@2001-01-01, POINT Z(2 2 3)@2001-01-02]");
+  for (int v = 0; v < NO_VARIANTS; v++)
+  {
+    bool xdr = (variants[v] == WKB_XDR);
+    /* The Z coordinates are only written in the extended variant */
+    uint8_t variant = (uint8_t) (variants[v] | WKB_EXTENDED);
+    size_t size2d, size2d_2, size3d, size3d_2;
+    uint8_t *wkb2d = temporal_as_wkb(seq2d, variant, &size2d);
+    uint8_t *wkb2d_2 = temporal_as_wkb(seq2d_2, variant, &size2d_2);
+    uint8_t *wkb3d = temporal_as_wkb(seq3d, variant, &size3d);
+    uint8_t *wkb3d_2 = temporal_as_wkb(seq3d_2, variant, &size3d_2);
+    size_t inst2d = size2d - size2d_2, inst3d = size3d - size3d_2;
+    size_t hdr2d = size2d - 3 * inst2d, hdr3d = size3d - 3 * inst3d;
+
+    /* An empty point, whose coordinates are NaN, in every position */
+    uint8_t *wkb = malloc(size2d);
+    for (int i = 0; i < 3; i++)
+    {
+      memcpy(wkb, wkb2d, size2d);
+      /* The coordinates precede the timestamp */
+      uint8_t *coords = wkb + hdr2d + (i + 1) * inst2d - 8 - 16;
+      write_double(coords, NAN, xdr);
+      write_double(coords + 8, NAN, xdr);
+      check_rejected("empty point", variant_names[v], wkb, size2d);
+    }
+    free(wkb);
+
+    /* A 3D point in a 2D sequence and a 2D point in a 3D sequence, in every
+     * position */
+    size_t size = hdr2d + 2 * inst2d + inst3d;
+    wkb = malloc(size);
+    for (int i = 0; i < 3; i++)
+    {
+      uint8_t *pos = wkb;
+      memcpy(pos, wkb2d, hdr2d);
+      pos += hdr2d;
+      for (int j = 0; j < 3; j++)
+      {
+        if (j == i)
+        {
+          memcpy(pos, wkb3d + hdr3d + j * inst3d, inst3d);
+          pos += inst3d;
+        }
+        else
+        {
+          memcpy(pos, wkb2d + hdr2d + j * inst2d, inst2d);
+          pos += inst2d;
+        }
+      }
+      check_rejected("3D point in 2D sequence", variant_names[v], wkb, size);
+    }
+    free(wkb);
+    size = hdr3d + 2 * inst3d + inst2d;
+    wkb = malloc(size);
+    for (int i = 0; i < 3; i++)
+    {
+      uint8_t *pos = wkb;
+      memcpy(pos, wkb3d, hdr3d);
+      pos += hdr3d;
+      for (int j = 0; j < 3; j++)
+      {
+        if (j == i)
+        {
+          memcpy(pos, wkb2d + hdr2d + j * inst2d, inst2d);
+          pos += inst2d;
+        }
+        else
+        {
+          memcpy(pos, wkb3d + hdr3d + j * inst3d, inst3d);
+          pos += inst3d;
+        }
+      }
+      check_rejected("2D point in 3D sequence", variant_names[v], wkb, size);
+    }
+    free(wkb);
+    free(wkb2d); free(wkb2d_2); free(wkb3d); free(wkb3d_2);
+  }
+  free(seq2d); free(seq2d_2); free(seq3d); free(seq3d_2);
+  return;
+}
+
+/*****************************************************************************/
+
+#define COUNT(a) ((int) (sizeof(a) / sizeof(a[0])))
+
+int
+main(void)
+{
+  test_initialize();
+  meos_initialize_error_handler(test_count_errors);
+  test_values("tbool", &tbool_in, tbool_texts, COUNT(tbool_texts));
+  test_values("tint", &tint_in, tint_texts, COUNT(tint_texts));
+  test_values("tfloat", &tfloat_in, tfloat_texts, COUNT(tfloat_texts));
+  test_values("ttext", &ttext_in, ttext_texts, COUNT(ttext_texts));
+  test_values("tgeompoint", &tgeompoint_in, tgeompoint_texts,
+    COUNT(tgeompoint_texts));
+  test_values("tgeogpoint", &tgeogpoint_in, tgeogpoint_texts,
+    COUNT(tgeogpoint_texts));
+  test_invalid_points();
+  return test_finalize();
+}
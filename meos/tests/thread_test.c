@@ -0,0 +1,186 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies that several threads may call MEOS
+ * concurrently, in particular the functions calling GEOS and PROJ
+ *
+ * The main thread computes for random temporal points and polygons the
+ * restriction of the temporal point to the polygon with `tpoint_at_geom()`,
+ * which calls GEOS, the result of `eintersects_tgeo_geo()`, which uses the
+ * cache of GEOS prepared geometries, and the transformation of the temporal
+ * point to WGS84 with `tspatial_transform()`, which calls PROJ. Then, several
+ * threads initialize their own state with `meos_initialize_thread()` and
+ * concurrently compute the same results, each of them starting at a
+ * different input, which must be equal to those of the main thread. The
+ * program returns a nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o thread_test thread_test.c -L/usr/local/lib -lmeos -lpthread
+ * @endcode
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include "meos_test.h"
+
+/* Number of threads */
+#define NO_THREADS 8
+/* Number of pairs of temporal points and polygons */
+#define NO_INPUTS 64
+/* Number of instants of the temporal points */
+#define NO_INSTANTS 20
+/* Number of times each thread computes the results for all the inputs */
+#define NO_ROUNDS 4
+/* Maximum length of the input strings */
+#define MAX_LENGTH_INPUT 2048
+
+/* Input and expected results for a pair of a temporal point and a polygon */
+typedef struct
+{
+  char temp[MAX_LENGTH_INPUT];  /* Temporal point */
+  char geom[MAX_LENGTH_INPUT];  /* Polygon */
+  char *at;                     /* Result of tpoint_at_geom() */
+  int inter;                    /* Result of eintersects_tgeo_geo() */
+  char *transf;                 /* Result of tspatial_transform() */
+} thread_input;
+
+static thread_input inputs[NO_INPUTS];
+
+/* State of a thread */
+typedef struct
+{
+  int id;          /* Number of the thread */
+  int nfailures;   /* Number of failed checks of the thread */
+} thread_state;
+
+/**
+ * @brief Return the results of the functions for an input
+ */
+static void
+compute_results(const thread_input *input, char **at, int *inter,
+  char **transf)
+{
+  Temporal *temp = tgeompoint_in(input->temp);
+  GSERIALIZED *gs = geom_in(input->geom, -1);
+  Temporal *rest = tpoint_at_geom(temp, gs, NULL);
+  *at = rest ? tspatial_as_ewkt(rest, 6) : strdup("NULL");
+  *inter = eintersects_tgeo_geo(temp, gs);
+  Temporal *temp1 = tspatial_transform(temp, 4326);
+  *transf = tspatial_as_ewkt(temp1, 6);
+  free(temp); free(gs); free(rest); free(temp1);
+  return;
+}
+
+/**
+ * @brief Compute the results for all the inputs in a thread and compare
+ * them with those of the main thread
+ */
+static void *
+thread_run(void *arg)
+{
+  thread_state *state = (thread_state *) arg;
+  meos_initialize_thread();
+  meos_initialize_timezone("UTC");
+  for (int round = 0; round < NO_ROUNDS; round++)
+  {
+    for (int j = 0; j < NO_INPUTS; j++)
+    {
+      const thread_input *input =
+        &inputs[(state->id * NO_INPUTS / NO_THREADS + j) % NO_INPUTS];
+      char *at, *transf;
+      int inter;
+      compute_results(input, &at, &inter, &transf);
+      if (strcmp(at, input->at) != 0 || inter != input->inter ||
+          strcmp(transf, input->transf) != 0)
+        state->nfailures++;
+      free(at); free(transf);
+    }
+  }
+  meos_finalize_thread();
+  return NULL;
+}
+
+int
+main(void)
+{
+  test_initialize();
+  rnd_seed(10);
+
+  /* Generate the inputs and compute the expected results */
+  for (int i = 0; i < NO_INPUTS; i++)
+  {
+    int len = sprintf(inputs[i].temp, "SRID=3857;[");
+    for (int j = 0; j < NO_INSTANTS; j++)
+      len += sprintf(inputs[i].temp + len,
+        "%sPoint(%.3f %.3f)@2000-01-01 00:%02d:00+00", j ? "," : "",
+        rnd() * 1000, rnd() * 1000, j);
+    sprintf(inputs[i].temp + len, "]");
+    double x = rnd() * 800, y = rnd() * 800;
+    double w = 50 + rnd() * 150, h = 50 + rnd() * 150;
+    sprintf(inputs[i].geom, "SRID=3857;Polygon((%.3f %.3f,%.3f %.3f,"
+      "%.3f %.3f,%.3f %.3f,%.3f %.3f))", x, y, x + w, y, x + w, y + h,
+      x, y + h, x, y);
+    compute_results(&inputs[i], &inputs[i].at, &inputs[i].inter,
+      &inputs[i].transf);
+  }
+
+  /* Compute the results concurrently in several threads */
+  pthread_t threads[NO_THREADS];
+  thread_state states[NO_THREADS];
+  for (int i = 0; i < NO_THREADS; i++)
+  {
+    states[i].id = i;
+    states[i].nfailures = 0;
+    if (pthread_create(&threads[i], NULL, thread_run, &states[i]) != 0)
+    {
+      printf("Cannot create thread %d\n", i);
+      return EXIT_FAILURE;
+    }
+  }
+  for (int i = 0; i < NO_THREADS; i++)
+  {
+    pthread_join(threads[i], NULL);
+    if (states[i].nfailures)
+      test_fail("thread %d: %d results differ from those of the main thread",
+        i, states[i].nfailures);
+  }
+
+  for (int i = 0; i < NO_INPUTS; i++)
+  {
+    free(inputs[i].at); free(inputs[i].transf);
+  }
+  return test_finalize();
+}
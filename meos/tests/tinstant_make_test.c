@@ -0,0 +1,132 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies that the temporal instants built with
+ * `tinstant_make()` from a value passed by reference only contain the bytes
+ * of the value
+ *
+ * The text values of all the lengths up to a few times the alignment of 8
+ * bytes are copied into a larger buffer filled with garbage, so that reading
+ * beyond the end of the value, which is not necessarily aligned, copies the
+ * garbage into the instant. The program verifies that the padding after the
+ * value in the instant is set to zero, so that the instants built from the
+ * same value are identical byte by byte, and that the value read back is
+ * equal to the original one. The program returns a nonzero exit status on
+ * failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o tinstant_make_test tinstant_make_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <meos.h>
+#include <meos_internal.h>
+#include "meos_test.h"
+
+/* Maximum number of characters of the text values */
+#define MAX_CHARS 32
+/* Size of the header of the text values */
+#define TEXT_HEADER 4
+
+/* Return an instant built from a copy of the text value put at the start of
+ * a larger buffer filled with the garbage byte */
+static TInstant *
+make_from_buffer(const text *txt, size_t size, uint8_t garbage,
+  TimestampTz t)
+{
+  uint8_t *buf = malloc(DOUBLE_PAD(size) + 8);
+  memset(buf, garbage, DOUBLE_PAD(size) + 8);
+  memcpy(buf, txt, size);
+  TInstant *result = tinstant_make(PointerGetDatum(buf), T_TTEXT, t);
+  free(buf);
+  return result;
+}
+
+/* Verify the instants built from a text value of each length */
+static void
+test_text_padding(void)
+{
+  char str[MAX_CHARS + 1];
+  TimestampTz t = pg_timestamptz_in("2001-01-01", -1);
+  for (int len = 0; len <= MAX_CHARS; len++)
+  {
+    memset(str, 'a' + len % 26, (size_t) len);
+    str[len] = '\0';
+    text *txt = cstring2text(str);
+    size_t size = TEXT_HEADER + (size_t) len;
+    TInstant *inst1 = make_from_buffer(txt, size, 0xAA, t);
+    TInstant *inst2 = make_from_buffer(txt, size, 0x55, t);
+
+    /* The padding after the value is set to zero */
+    const uint8_t *value = (const uint8_t *) tinstant_value_p(inst1);
+    for (size_t i = size; i < DOUBLE_PAD(size); i++)
+    {
+      if (value[i] != 0)
+      {
+        test_fail("text of %d characters: byte %zu of the padding is not zero",
+          len, i - size);
+        break;
+      }
+    }
+    /* The instants built from the same value are identical */
+    size_t memsize = temporal_mem_size((Temporal *) inst1);
+    if (memsize != temporal_mem_size((Temporal *) inst2) ||
+        memcmp(inst1, inst2, memsize) != 0)
+      test_fail("text of %d characters: the instants differ", len);
+    /* The value read back is the original one */
+    text *txt1 = (text *) tinstant_value_p(inst1);
+    char *str1 = text2cstring(txt1);
+    if (strcmp(str1, str) != 0)
+      test_fail("text of %d characters: the value read back is \"%s\"", len,
+        str1);
+    free(str1); free(inst1); free(inst2); free(txt);
+  }
+  printf("Padding of text values: %d lengths verified\n", MAX_CHARS + 1);
+  return;
+}
+
+/*****************************************************************************/
+
+int
+main(void)
+{
+  /* Initialize MEOS */
+  test_initialize();
+
+  test_text_padding();
+
+  /* Finalize MEOS */
+  return test_finalize();
+}
@@ -0,0 +1,195 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the restriction of temporal points with
+ * linear interpolation to a geometry and to its complement
+ *
+ * The restriction of a sequence to a geometry tests ranges of consecutive
+ * segments against the geometry prepared by GEOS, and splits a range into
+ * two halves until the range is disjoint from the geometry, covered by it,
+ * or reduced to one segment. The program generates random walks, which stay
+ * inside and outside the geometries during many consecutive segments, and
+ * verifies the results of `tpoint_at_geom()` and `tpoint_minus_geom()` at
+ * random timestamps against the intersection of the value of the temporal
+ * point at the timestamp and the geometry. The timestamps at which the
+ * temporal point is close to the boundary of the geometry are skipped. The
+ * program returns a nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o tpoint_at_geom_test tpoint_at_geom_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include "meos_test.h"
+
+/* SRID of the values */
+#define SRID 3857
+/* Maximum number of instants of a value */
+#define MAX_INSTANTS 300
+/* Number of random values per geometry */
+#define NO_VALUES 40
+/* Number of timestamps tested per value */
+#define NO_TIMESTAMPS 100
+/* Minimum distance to the boundary of the geometry of the points tested */
+#define MIN_DIST 1e-6
+/* Number of microseconds in a minute */
+#define USECS_PER_MINUTE INT64CONST(60000000)
+
+/* Origin of the timestamps */
+static TimestampTz t0;
+
+/*****************************************************************************/
+
+/* Return a temporal point sequence with linear interpolation from arrays of
+ * coordinates, whose timestamps are one minute apart from the one of the
+ * @p start instant */
+static TSequence *
+make_tpointseq(const double *x, const double *y, int start, int count)
+{
+  TInstant **instants = malloc(sizeof(TInstant *) * count);
+  for (int i = 0; i < count; i++)
+  {
+    GSERIALIZED *gs = geompoint_make2d(SRID, x[start + i], y[start + i]);
+    instants[i] = tpointinst_make(gs, t0 + (start + i) * USECS_PER_MINUTE);
+    free(gs);
+  }
+  TSequence *result = tsequence_make((const TInstant **) instants, count,
+    true, true, LINEAR, false);
+  for (int i = 0; i < count; i++)
+    free(instants[i]);
+  free(instants);
+  return result;
+}
+
+/* Return a random walk in [0, 100) x [0, 100), which is a sequence or a
+ * sequence set of three sequences */
+static Temporal *
+random_walk(void)
+{
+  double x[MAX_INSTANTS], y[MAX_INSTANTS];
+  int count = 2 + rnd_int(MAX_INSTANTS - 1);
+  x[0] = rnd_int(100);
+  y[0] = rnd_int(100);
+  for (int i = 1; i < count; i++)
+  {
+    x[i] = fmin(fmax(x[i - 1] + rnd_int(7) - 3, 0), 99);
+    y[i] = fmin(fmax(y[i - 1] + rnd_int(7) - 3, 0), 99);
+  }
+  if (count < 6 || rnd_int(2))
+    return (Temporal *) make_tpointseq(x, y, 0, count);
+  /* Three sequences separated by one minute without instants */
+  TSequence *seqs[3];
+  int n = count / 3;
+  seqs[0] = make_tpointseq(x, y, 0, n - 1);
+  seqs[1] = make_tpointseq(x, y, n, n - 1);
+  seqs[2] = make_tpointseq(x, y, 2 * n, count - 2 * n);
+  Temporal *result = (Temporal *) tsequenceset_make((const TSequence **) seqs,
+    3, false);
+  for (int i = 0; i < 3; i++)
+    free(seqs[i]);
+  return result;
+}
+
+/* Return true if a temporal point, which may be NULL, is defined at a
+ * timestamp */
+static bool
+defined_at(const Temporal *temp, TimestampTz t)
+{
+  GSERIALIZED *value;
+  if (! temp || ! tgeo_value_at_timestamptz(temp, t, true, &value))
+    return false;
+  free(value);
+  return true;
+}
+
+/*****************************************************************************/
+
+/* Verify the restriction of random walks to a geometry */
+static void
+test_geom(const char *name, const char *wkt)
+{
+  char ewkt[512];
+  snprintf(ewkt, sizeof(ewkt), "SRID=%d;%s", SRID, wkt);
+  GSERIALIZED *gs = geom_in(ewkt, -1);
+  GSERIALIZED *boundary = geom_boundary(gs);
+  for (int i = 0; i < NO_VALUES; i++)
+  {
+    Temporal *temp = random_walk();
+    Temporal *at = tpoint_at_geom(temp, gs, NULL);
+    Temporal *minus = tpoint_minus_geom(temp, gs, NULL);
+    TimestampTz start = temporal_start_timestamptz(temp);
+    TimestampTz end = temporal_end_timestamptz(temp);
+    for (int j = 0; j < NO_TIMESTAMPS; j++)
+    {
+      TimestampTz t = start + (TimestampTz) (rnd() * (end - start));
+      GSERIALIZED *point;
+      /* The timestamp may be in a gap of a sequence set */
+      if (! tgeo_value_at_timestamptz(temp, t, true, &point))
+        continue;
+      bool skip = geom_distance2d(point, boundary) < MIN_DIST;
+      bool inside = geom_intersects2d(point, gs);
+      free(point);
+      if (skip)
+        continue;
+      if (defined_at(at, t) != inside)
+        test_fail("%s atGeometry: the value %s defined at %s", name,
+          inside ? "is not" : "is", pg_timestamptz_out(t));
+      if (defined_at(minus, t) == inside)
+        test_fail("%s minusGeometry: the value %s defined at %s", name,
+          inside ? "is" : "is not", pg_timestamptz_out(t));
+    }
+    free(temp); free(at); free(minus);
+  }
+  free(gs); free(boundary);
+  return;
+}
+
+/*****************************************************************************/
+
+int
+main(void)
+{
+  test_initialize();
+  t0 = pg_timestamptz_in("2025-01-01", -1);
+  test_geom("square", "POLYGON((20 20,80 20,80 80,20 80,20 20))");
+  test_geom("L-shape", "POLYGON((10 10,90 10,90 50,50 50,50 90,10 90,10 10))");
+  test_geom("square with hole", "POLYGON((10 10,90 10,90 90,10 90,10 10),"
+    "(30 30,70 30,70 70,30 70,30 30))");
+  test_geom("multipolygon", "MULTIPOLYGON(((0 0,30 0,30 30,0 30,0 0)),"
+    "((40 40,45 40,45 45,40 45,40 40)),((60 10,90 10,75 90,60 10)))");
+  return test_finalize();
+}
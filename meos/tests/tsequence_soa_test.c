@@ -0,0 +1,321 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A program that verifies the functions of the structure-of-arrays
+ * representation of temporal sequences against those of TSequence
+ *
+ * The program verifies on fixed cases and on random temporal integers,
+ * floats, and geometry points of all interpolations that
+ * - converting a sequence to the structure-of-arrays representation and back
+ *   gives the same sequence;
+ * - the function `tsequencesoa_at_tstzspan()` gives the same result as the
+ *   function `temporal_at_tstzspan()`, in particular for step interpolation
+ *   with an exclusive upper bound, for discrete sequences, and for an
+ *   instantaneous intersection;
+ * - the functions `tpointseqsoa_length()` and `tpointseqsoa_speed()` give
+ *   the same results as the functions `tpoint_length()` and `tpoint_speed()`.
+ *
+ * The program returns a nonzero exit status on failure.
+ *
+ * The program can be build as follows
+ * @code
+ * gcc -Wall -g -I/usr/local/include -o tsequence_soa_test tsequence_soa_test.c -L/usr/local/lib -lmeos
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <meos.h>
+#include <meos_geo.h>
+#include <meos_internal.h>
+#include "meos_test.h"
+
+/* Number of random sequences */
+#define NO_SEQUENCES 2000
+/* Number of random spans per sequence */
+#define NO_SPANS 20
+/* Maximum number of instants of the random sequences */
+#define MAX_INSTANTS 20
+/* Number of microseconds in an hour */
+#define USECS_PER_HOUR INT64CONST(3600000000)
+/* Tolerance for the comparison of lengths */
+#define LENGTH_EPSILON 1.0e-9
+
+/* Report a failed check */
+static void
+fail(const char *what, const TSequence *seq, const Span *s)
+{
+  char *seq_str = temporal_out((Temporal *) seq, 6);
+  char *span_str = s ? tstzspan_out(s) : NULL;
+  test_fail("%s: %s%s%s", what, seq_str, s ? " at " : "",
+    s ? span_str : "");
+  free(seq_str); free(span_str);
+  return;
+}
+
+/* Return true if two results are equal, where NULL means an empty result */
+static bool
+result_eq(const Temporal *temp1, const Temporal *temp2)
+{
+  if (! temp1 || ! temp2)
+    return ! temp1 && ! temp2;
+  return temporal_eq(temp1, temp2);
+}
+
+/*****************************************************************************/
+
+/* Verify the conversion from and to the structure-of-arrays representation
+ * and the restriction to a span */
+static void
+check_at(const TSequence *seq, const Span *s)
+{
+  TSequenceSoA *soa = tsequence_to_soa(seq);
+  TSequence *seq1 = tsequencesoa_to_tsequence(soa);
+  if (! result_eq((Temporal *) seq, (Temporal *) seq1))
+    fail("round trip", seq, NULL);
+  free(seq1);
+  if (s)
+  {
+    Temporal *expected = temporal_at_tstzspan((Temporal *) seq, s);
+    TSequenceSoA *soa1 = tsequencesoa_at_tstzspan(soa, s);
+    TSequence *result = soa1 ? tsequencesoa_to_tsequence(soa1) : NULL;
+    if (! result_eq((Temporal *) result, expected))
+      fail("tsequencesoa_at_tstzspan", seq, s);
+    free(expected); free(soa1); free(result);
+  }
+  free(soa);
+  return;
+}
+
+/* Verify the length and the speed of a temporal point */
+static void
+check_point(const TSequence *seq)
+{
+  TSequenceSoA *soa = tsequence_to_soa(seq);
+  double length = tpoint_length((Temporal *) seq);
+  if (fabs(tpointseqsoa_length(soa) - length) > LENGTH_EPSILON * (1 + length))
+    fail("tpointseqsoa_length", seq, NULL);
+  if (MEOS_FLAGS_GET_INTERP(seq->flags) == LINEAR)
+  {
+    Temporal *expected = tpoint_speed((Temporal *) seq);
+    TSequenceSoA *soa1 = tpointseqsoa_speed(soa);
+    TSequence *result = soa1 ? tsequencesoa_to_tsequence(soa1) : NULL;
+    if (! result_eq((Temporal *) result, expected))
+      fail("tpointseqsoa_speed", seq, NULL);
+    free(expected); free(soa1); free(result);
+  }
+  free(soa);
+  return;
+}
+
+/*****************************************************************************/
+
+/* Verify the restriction of a sequence given as a string */
+static void
+check_at_str(Temporal *temp, const char *span_str, const char *expected_str)
+{
+  Span *s = tstzspan_in(span_str);
+  Temporal *expected = NULL;
+  if (expected_str)
+    expected = (temp->temptype == T_TINT) ? tint_in(expected_str) :
+      tfloat_in(expected_str);
+  /* The result of TSequence is also verified */
+  Temporal *result1 = temporal_at_tstzspan(temp, s);
+  if (! result_eq(result1, expected))
+    fail("temporal_at_tstzspan", (TSequence *) temp, s);
+  TSequenceSoA *soa = tsequence_to_soa((TSequence *) temp);
+  TSequenceSoA *soa1 = tsequencesoa_at_tstzspan(soa, s);
+  TSequence *result2 = soa1 ? tsequencesoa_to_tsequence(soa1) : NULL;
+  if (! result_eq((Temporal *) result2, expected))
+    fail("tsequencesoa_at_tstzspan", (TSequence *) temp, s);
+  free(s); free(expected); free(result1); free(soa); free(soa1);
+  free(result2);
+  return;
+}
+
+/* Verify the restriction in particular cases */
+static void
+test_fixed(void)
+{
+  /* Step interpolation with an exclusive upper bound */
+  Temporal *temp = tint_in("[1@2000-01-01, 2@2000-01-03, 3@2000-01-05]");
+  check_at_str(temp, "[2000-01-02, 2000-01-04)",
+    "[1@2000-01-02, 2@2000-01-03, 2@2000-01-04)");
+  check_at_str(temp, "[2000-01-02, 2000-01-03)",
+    "[1@2000-01-02, 1@2000-01-03)");
+  check_at_str(temp, "(2000-01-03, 2000-01-05)",
+    "(2@2000-01-03, 2@2000-01-05)");
+  free(temp);
+  temp = tfloat_in("Interp=Step;[1@2000-01-01, 2@2000-01-03, 2@2000-01-05)");
+  check_at_str(temp, "[2000-01-02, 2000-01-06]",
+    "Interp=Step;[1@2000-01-02, 2@2000-01-03, 2@2000-01-05)");
+  free(temp);
+
+  /* Discrete sequences */
+  temp = tfloat_in("{1@2000-01-01, 2@2000-01-02, 3@2000-01-03}");
+  check_at_str(temp, "(2000-01-01, 2000-01-03]",
+    "{2@2000-01-02, 3@2000-01-03}");
+  check_at_str(temp, "[2000-01-01, 2000-01-03)",
+    "{1@2000-01-01, 2@2000-01-02}");
+  check_at_str(temp, "(2000-01-01, 2000-01-02)", NULL);
+  check_at_str(temp, "[2000-01-02, 2000-01-02]", "{2@2000-01-02}");
+  free(temp);
+
+  /* Instantaneous intersection */
+  temp = tfloat_in("[1@2000-01-01, 3@2000-01-03]");
+  check_at_str(temp, "[2000-01-02, 2000-01-02]", "[2@2000-01-02]");
+  check_at_str(temp, "[2000-01-03, 2000-01-05]", "[3@2000-01-03]");
+  check_at_str(temp, "[1999-12-31, 2000-01-01]", "[1@2000-01-01]");
+  check_at_str(temp, "(2000-01-03, 2000-01-05]", NULL);
+  free(temp);
+  temp = tfloat_in("[1@2000-01-01]");
+  check_at_str(temp, "[2000-01-01, 2000-01-02]", "[1@2000-01-01]");
+  free(temp);
+  return;
+}
+
+/*****************************************************************************/
+
+/* Return a random sequence of the given temporal type and interpolation */
+static TSequence *
+random_sequence(meosType temptype, interpType interp, bool hasz)
+{
+  int count = 1 + rnd_int(MAX_INSTANTS);
+  /* The array and the instants are freed by tsequence_make_free */
+  TInstant **instants = malloc(sizeof(TInstant *) * count);
+  /* Discrete sequences and instantaneous sequences have inclusive bounds */
+  bool lower_inc = (count == 1 || interp == DISCRETE) || rnd() < 0.5;
+  bool upper_inc = (count == 1 || interp == DISCRETE) || rnd() < 0.5;
+  TimestampTz t = 0;
+  double v = 0.0, x = 0.0, y = 0.0, z = 0.0;
+  for (int i = 0; i < count; i++)
+  {
+    t += USECS_PER_HOUR * (1 + rnd_int(24));
+    /* Step sequences with an exclusive upper bound end with equal values,
+     * while repeated values are frequent elsewhere to test normalization */
+    bool last_equal = (i == count - 1 && i > 0 && interp == STEP &&
+      ! upper_inc);
+    if (! last_equal && rnd() < 0.7)
+    {
+      v = (temptype == T_TINT) ? rnd_int(10) : rnd_int(10) + rnd();
+      x = rnd_int(100); y = rnd_int(100); z = rnd_int(100);
+    }
+    if (temptype == T_TINT)
+      instants[i] = tinstant_make(Int32GetDatum((int) v), temptype, t);
+    else if (temptype == T_TFLOAT)
+      instants[i] = tinstant_make(Float8GetDatum(v), temptype, t);
+    else
+    {
+      GSERIALIZED *gs = hasz ? geompoint_make3dz(3857, x, y, z) :
+        geompoint_make2d(3857, x, y);
+      instants[i] = tinstant_make_free(PointerGetDatum(gs), temptype, t);
+    }
+  }
+  return tsequence_make_free(instants, count, lower_inc, upper_inc, interp,
+    true);
+}
+
+/* Return a random span around the time span of a sequence */
+static Span *
+random_span(const TSequence *seq)
+{
+  TimestampTz lower = DatumGetTimestampTz(seq->period.lower);
+  TimestampTz upper = DatumGetTimestampTz(seq->period.upper);
+  TimestampTz width = upper - lower + 2 * USECS_PER_HOUR;
+  TimestampTz t1, t2;
+  /* The bounds are often instants of the sequence */
+  if (rnd() < 0.3)
+    t1 = TSEQUENCE_INST_N(seq, rnd_int(seq->count))->t;
+  else
+    t1 = lower - USECS_PER_HOUR + (TimestampTz) (rnd() * width);
+  if (rnd() < 0.2)
+    return tstzspan_make(t1, t1, true, true);
+  if (rnd() < 0.3)
+    t2 = TSEQUENCE_INST_N(seq, rnd_int(seq->count))->t;
+  else
+    t2 = lower - USECS_PER_HOUR + (TimestampTz) (rnd() * width);
+  if (t1 == t2)
+    return tstzspan_make(t1, t1, true, true);
+  if (t1 > t2)
+  {
+    TimestampTz tmp = t1; t1 = t2; t2 = tmp;
+  }
+  return tstzspan_make(t1, t2, rnd() < 0.5, rnd() < 0.5);
+}
+
+/* Verify the functions on random sequences */
+static void
+test_random(meosType temptype, interpType interp, bool hasz)
+{
+  for (int i = 0; i < NO_SEQUENCES; i++)
+  {
+    TSequence *seq = random_sequence(temptype, interp, hasz);
+    check_at(seq, NULL);
+    for (int j = 0; j < NO_SPANS; j++)
+    {
+      Span *s = random_span(seq);
+      check_at(seq, s);
+      free(s);
+    }
+    if (temptype == T_TGEOMPOINT)
+      check_point(seq);
+    free(seq);
+  }
+  printf("%s%s with %s interpolation: %d sequences verified\n",
+    meostype_name(temptype), hasz ? " 3D" : "",
+    interp == DISCRETE ? "discrete" : (interp == STEP ? "step" : "linear"),
+    NO_SEQUENCES);
+  return;
+}
+
+/*****************************************************************************/
+
+int
+main(void)
+{
+  /* Initialize MEOS */
+  test_initialize();
+
+  test_fixed();
+  test_random(T_TINT, DISCRETE, false);
+  test_random(T_TINT, STEP, false);
+  test_random(T_TFLOAT, DISCRETE, false);
+  test_random(T_TFLOAT, STEP, false);
+  test_random(T_TFLOAT, LINEAR, false);
+  test_random(T_TGEOMPOINT, DISCRETE, false);
+  test_random(T_TGEOMPOINT, STEP, false);
+  test_random(T_TGEOMPOINT, LINEAR, false);
+  test_random(T_TGEOMPOINT, LINEAR, true);
+
+  /* Finalize MEOS */
+  return test_finalize();
+}
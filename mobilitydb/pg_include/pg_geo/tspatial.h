@@ -36,6 +36,7 @@
 
 /* PostgreSQL */
 #include <postgres.h>
+#include <access/skey.h>
 #include <utils/array.h>
 #include <fmgr.h>
 
@@ -45,6 +46,10 @@
 extern FunctionCallInfo fetch_fcinfo(void);
 extern void store_fcinfo(FunctionCallInfo fcinfo);
 
+/* The following function is also called by temporal_brin.c */
+extern bool tspatial_spgist_get_stbox(const ScanKeyData *scankey,
+  STBox *result);
+
 extern Temporal *tspatial_valid_typmod(Temporal *temp, int32_t typmod);
 extern uint32 tspatial_typmod_in(ArrayType *arr, int is_point, int is_geodetic);
 extern Datum Spatialarr_as_text_ext(FunctionCallInfo fcinfo, bool extended);
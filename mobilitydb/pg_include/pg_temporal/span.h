@@ -37,6 +37,7 @@
 
 /* PostgreSQL */
 #include <postgres.h>
+#include <access/skey.h>
 #include <lib/stringinfo.h>
 #include <utils/rangetypes.h>
 /* MEOS */
@@ -54,6 +55,10 @@ extern void span_write(const Span *s, StringInfo buf);
 extern void range_set_span(RangeType *range, TypeCacheEntry *typcache,
   Span *result);
 
+/* Index functions */
+
+extern bool span_spgist_get_span(const ScanKeyData *scankey, Span *result);
+
 /*****************************************************************************/
 
 #endif /* __PG_SPAN_H__ */
@@ -220,6 +220,8 @@ extern Datum Tcomp_temporal_base(FunctionCallInfo fcinfo,
 /* Indexing functions */
 
 extern Temporal *temporal_slice(Datum tempdatum);
+extern void temporal_compressed_slice(Datum datum, meosType *temptype,
+  void *box);
 
 /*****************************************************************************/
 
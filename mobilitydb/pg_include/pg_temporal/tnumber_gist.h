@@ -79,6 +79,11 @@ extern void bbox_gist_consider_split(ConsiderSplitContext *context, int dimNum,
 extern Datum bbox_gist_picksplit(FunctionCallInfo fcinfo, meosType bboxtype,
   void (*bbox_adjust)(void *, void *), double (*bbox_penalty)(void *, void *));
 
+/* The following functions are also called by tspatial_gist.c */
+extern uint64 double_sortable_uint64(double d);
+extern uint64 timestamptz_sortable_uint64(TimestampTz t);
+extern int zorder_cmp(const uint64 *p1, const uint64 *p2, int ndims);
+
 /* The following functions are also called by tnumber_spgist.c */
 extern bool tbox_index_leaf_consistent(const TBox *key, const TBox *query,
   StrategyNumber strategy);
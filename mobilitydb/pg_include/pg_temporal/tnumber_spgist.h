@@ -35,12 +35,20 @@
 #ifndef __TNUMBER_SPGIST_H__
 #define __TNUMBER_SPGIST_H__
 
+/* PostgreSQL */
+#include <postgres.h>
+#include <access/skey.h>
+/* MEOS */
+#include <meos.h>
+
 /*****************************************************************************/
 
 extern int compareInt4(const void *a, const void *b);
 /* The following function is also called by tpoint_spgist.c */
 extern int compareFloat8(const void *a, const void *b);
 extern int compareTimestampTz(const void *a, const void *b);
+/* The following function is also called by temporal_brin.c */
+extern bool tnumber_spgist_get_tbox(const ScanKeyData *scankey, TBox *result);
 
 /*****************************************************************************/
 
@@ -112,6 +112,9 @@ CREATE OPERATOR CLASS tcbuffer_rtree_ops
   FUNCTION  3 tspatial_gist_compress(internal),
   FUNCTION  5 stbox_gist_penalty(internal, internal, internal),
   FUNCTION  6 stbox_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  11 stbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7 stbox_gist_same(stbox, stbox, internal);
 --  FUNCTION  8 gist_tcbuffer_distance(internal, tcbuffer, smallint, oid, internal),
 
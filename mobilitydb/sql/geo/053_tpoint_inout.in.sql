@@ -187,4 +187,31 @@ CREATE FUNCTION asHexEWKB(tgeogpoint, endianenconding text DEFAULT '')
   AS 'MODULE_PATHNAME', 'Temporal_as_hexwkb'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+/*****************************************************************************
+ * Compressed binary representation
+ *****************************************************************************/
+
+CREATE FUNCTION asCompressed(tgeompoint)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Temporal_as_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION asCompressed(tgeogpoint)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Temporal_as_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION tgeompointFromCompressed(bytea)
+  RETURNS tgeompoint
+  AS 'MODULE_PATHNAME', 'Temporal_from_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tgeogpointFromCompressed(bytea)
+  RETURNS tgeogpoint
+  AS 'MODULE_PATHNAME', 'Temporal_from_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION compressedStbox(bytea)
+  RETURNS stbox
+  AS 'MODULE_PATHNAME', 'Tspatial_compressed_stbox'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /*****************************************************************************/
@@ -63,6 +63,12 @@ CREATE FUNCTION stbox_gist_distance(internal, stbox, smallint, oid, internal)
   RETURNS internal
   AS 'MODULE_PATHNAME', 'Stbox_gist_distance'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+CREATE FUNCTION stbox_gist_sortsupport(internal)
+  RETURNS void
+  AS 'MODULE_PATHNAME', 'Stbox_gist_sortsupport'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
 CREATE FUNCTION tspatial_gist_compress(internal)
   RETURNS internal
   AS 'MODULE_PATHNAME', 'Tspatial_gist_compress'
@@ -154,6 +160,9 @@ CREATE OPERATOR CLASS tgeometry_rtree_ops
   FUNCTION  3  tspatial_gist_compress(internal),
   FUNCTION  5  stbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  stbox_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  11  stbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7  stbox_gist_same(stbox, stbox, internal),
   FUNCTION  8  stbox_gist_distance(internal, stbox, smallint, oid, internal);
 
@@ -205,6 +214,9 @@ CREATE OPERATOR CLASS tgeography_rtree_ops
   FUNCTION  3  tspatial_gist_compress(internal),
   FUNCTION  5  stbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  stbox_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  11  stbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7  stbox_gist_same(stbox, stbox, internal),
   FUNCTION  8  stbox_gist_distance(internal, stbox, smallint, oid, internal);
 
@@ -121,6 +121,9 @@ CREATE OPERATOR CLASS stbox_rtree_ops
   FUNCTION  2  stbox_gist_union(internal, internal),
   FUNCTION  5  stbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  stbox_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  11  stbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7  stbox_gist_same(stbox, stbox, internal),
   FUNCTION  8  stbox_gist_distance(internal, stbox, smallint, oid, internal);
 
@@ -219,6 +222,9 @@ CREATE OPERATOR CLASS tgeompoint_rtree_ops
   FUNCTION  3  tspatial_gist_compress(internal),
   FUNCTION  5  stbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  stbox_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  11  stbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7  stbox_gist_same(stbox, stbox, internal),
   FUNCTION  8  stbox_gist_distance(internal, stbox, smallint, oid, internal);
 
@@ -270,6 +276,9 @@ CREATE OPERATOR CLASS tgeogpoint_rtree_ops
   FUNCTION  3  tspatial_gist_compress(internal),
   FUNCTION  5  stbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  stbox_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  11  stbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7  stbox_gist_same(stbox, stbox, internal),
   FUNCTION  8  stbox_gist_distance(internal, stbox, smallint, oid, internal);
 
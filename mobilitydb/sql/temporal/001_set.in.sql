@@ -796,6 +796,19 @@ CREATE FUNCTION set_union_transfn(internal, tstzset)
   AS 'MODULE_PATHNAME', 'Set_union_transfn'
   LANGUAGE C IMMUTABLE PARALLEL SAFE;
 
+CREATE FUNCTION set_union_combinefn(internal, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Set_union_combinefn'
+  LANGUAGE C IMMUTABLE PARALLEL SAFE;
+CREATE FUNCTION set_union_serialfn(internal)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Set_union_serialfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION set_union_deserialfn(bytea, internal)
+  RETURNS internal
+  AS 'MODULE_PATHNAME', 'Set_union_deserialfn'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 CREATE FUNCTION intset_union_finalfn(internal)
   RETURNS intset
   AS 'MODULE_PATHNAME', 'Set_union_finalfn'
@@ -825,36 +838,54 @@ CREATE AGGREGATE setUnion(integer) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = intset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 CREATE AGGREGATE setUnion(bigint) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = bigintset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 CREATE AGGREGATE setUnion(float) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = floatset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 CREATE AGGREGATE setUnion(text) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = textset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 CREATE AGGREGATE setUnion(date) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = dateset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 CREATE AGGREGATE setUnion(timestamptz) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = tstzset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 
@@ -862,36 +893,54 @@ CREATE AGGREGATE setUnion(intset) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = intset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 CREATE AGGREGATE setUnion(bigintset) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = bigintset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 CREATE AGGREGATE setUnion(floatset) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = floatset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 CREATE AGGREGATE setUnion(textset) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = textset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 CREATE AGGREGATE setUnion(dateset) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = dateset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 CREATE AGGREGATE setUnion(tstzset) (
   SFUNC = set_union_transfn,
   STYPE = internal,
   FINALFUNC = tstzset_union_finalfn,
+  COMBINEFUNC = set_union_combinefn,
+  SERIALFUNC = set_union_serialfn,
+  DESERIALFUNC = set_union_deserialfn,
   PARALLEL = safe
 );
 
@@ -51,6 +51,16 @@ CREATE FUNCTION mobilitydb_full_version()
   AS 'MODULE_PATHNAME', 'Mobilitydb_full_version'
   LANGUAGE C IMMUTABLE;
 
+CREATE FUNCTION meosStats(OUT name text, OUT calls bigint,
+    OUT nanoseconds bigint)
+  RETURNS SETOF record
+  AS 'MODULE_PATHNAME', 'Meos_stats'
+  LANGUAGE C VOLATILE PARALLEL RESTRICTED;
+CREATE FUNCTION meosStatsReset()
+  RETURNS void
+  AS 'MODULE_PATHNAME', 'Meos_stats_reset'
+  LANGUAGE C VOLATILE PARALLEL RESTRICTED;
+
 /******************************************************************************
  * Input/Output
  ******************************************************************************/
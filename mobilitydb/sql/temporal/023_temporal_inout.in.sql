@@ -187,4 +187,51 @@ CREATE FUNCTION asHexWKB(ttext, endianenconding text DEFAULT '')
   AS 'MODULE_PATHNAME', 'Temporal_as_hexwkb'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
 
+/*****************************************************************************
+ * Compressed binary representation
+ *****************************************************************************/
+
+CREATE FUNCTION asCompressed(tbool)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Temporal_as_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION asCompressed(tint)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Temporal_as_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION asCompressed(tfloat)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Temporal_as_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION asCompressed(ttext)
+  RETURNS bytea
+  AS 'MODULE_PATHNAME', 'Temporal_as_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION tboolFromCompressed(bytea)
+  RETURNS tbool
+  AS 'MODULE_PATHNAME', 'Temporal_from_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tintFromCompressed(bytea)
+  RETURNS tint
+  AS 'MODULE_PATHNAME', 'Temporal_from_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION tfloatFromCompressed(bytea)
+  RETURNS tfloat
+  AS 'MODULE_PATHNAME', 'Temporal_from_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION ttextFromCompressed(bytea)
+  RETURNS ttext
+  AS 'MODULE_PATHNAME', 'Temporal_from_compressed'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
+CREATE FUNCTION compressedTimeSpan(bytea)
+  RETURNS tstzspan
+  AS 'MODULE_PATHNAME', 'Temporal_compressed_tstzspan'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+CREATE FUNCTION compressedTbox(bytea)
+  RETURNS tbox
+  AS 'MODULE_PATHNAME', 'Tnumber_compressed_tbox'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+
 /*****************************************************************************/
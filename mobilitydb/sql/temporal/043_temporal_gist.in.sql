@@ -58,6 +58,12 @@ CREATE FUNCTION tbox_gist_distance(internal, tbox, smallint, oid, internal)
   RETURNS float8
   AS 'MODULE_PATHNAME', 'Tbox_gist_distance'
   LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+CREATE FUNCTION tbox_gist_sortsupport(internal)
+  RETURNS void
+  AS 'MODULE_PATHNAME', 'Tbox_gist_sortsupport'
+  LANGUAGE C IMMUTABLE STRICT PARALLEL SAFE;
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
 
 /******************************************************************************/
 
@@ -158,6 +164,9 @@ CREATE OPERATOR CLASS tbox_rtree_ops
   FUNCTION  2  tbox_gist_union(internal, internal),
   FUNCTION  5  tbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  tbox_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  11  tbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7  tbox_gist_same(tbox, tbox, internal),
   FUNCTION  8  tbox_gist_distance(internal, tbox, smallint, oid, internal);
 
@@ -272,6 +281,9 @@ CREATE OPERATOR CLASS tint_rtree_ops
   FUNCTION  3  tint_gist_compress(internal),
   FUNCTION  5  tbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  tbox_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  11  tbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7  tbox_gist_same(tbox, tbox, internal),
   FUNCTION  8  tbox_gist_distance(internal, tbox, smallint, oid, internal);
 
@@ -346,6 +358,9 @@ CREATE OPERATOR CLASS tfloat_rtree_ops
   FUNCTION  3  tfloat_gist_compress(internal),
   FUNCTION  5  tbox_gist_penalty(internal, internal, internal),
   FUNCTION  6  tbox_gist_picksplit(internal, internal),
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  FUNCTION  11  tbox_gist_sortsupport(internal),
+#endif //POSTGRESQL_VERSION_NUMBER >= 140000
   FUNCTION  7  tbox_gist_same(tbox, tbox, internal),
   FUNCTION  8  tbox_gist_distance(internal, tbox, smallint, oid, internal);
 
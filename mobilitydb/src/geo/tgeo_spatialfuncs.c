@@ -47,9 +47,11 @@
 #include "temporal/span.h"
 #include "temporal/temporal.h"
 #include "temporal/type_util.h"
+#include "geo/postgis_funcs.h"
 #include "geo/tspatial.h"
 #include "geo/tgeo_spatialfuncs.h"
 #include "geo/stbox.h"
+#include "geo/tgeo_restrict.h"
 /* MobilityDB */
 #include "pg_temporal/temporal.h"
 #include "pg_temporal/type_util.h"
@@ -722,7 +724,9 @@ Tgeo_restrict_geom(FunctionCallInfo fcinfo, bool atfunc)
   Span *zspan = NULL;
   if (PG_NARGS() == 3)
     zspan = PG_GETARG_SPAN_P(2);
-  Temporal *result = tgeo_restrict_geom(temp, gs, zspan, atfunc);
+  /* Keep the prepared geometry between calls */
+  Temporal *result = tgeo_restrict_geom_int(temp, gs, zspan, atfunc,
+    geom_prepared_fncache(fcinfo->flinfo));
   PG_FREE_IF_COPY(temp, 0);
   PG_FREE_IF_COPY(gs, 1);
   if (! result)
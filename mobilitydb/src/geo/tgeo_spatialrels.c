@@ -53,6 +53,7 @@
 #include <meos_internal.h>
 #include <meos_geo.h>
 #include "temporal/temporal.h" /* For varfunc */
+#include "geo/postgis_funcs.h"
 #include "geo/tgeo_spatialfuncs.h"
 /* MobilityDB */
 #include "pg_geo/postgis.h"
@@ -98,6 +99,30 @@ EA_spatialrel_tspatial_geo(FunctionCallInfo fcinfo,
   PG_RETURN_BOOL(result ? true : false);
 }
 
+/**
+ * @brief Return true if a temporal geo and a geometry ever/always satisfy a
+ * spatial relationship, keeping the prepared geometry between calls
+ * @param[in] fcinfo Catalog information about the external function
+ * @param[in] func Spatial relationship for temporal geometry
+ * @param[in] ever True to compute the ever semantics, false for always
+ * @param[in] geofirst True when the geometry is the first argument
+ */
+static Datum
+EA_spatialrel_tgeo_geo_prep(FunctionCallInfo fcinfo,
+  int (*func)(const Temporal *, const GSERIALIZED *, bool,
+    GEOSPreparedFnCache *), bool ever, bool geofirst)
+{
+  int tidx = geofirst ? 1 : 0, gidx = geofirst ? 0 : 1;
+  Temporal *temp = PG_GETARG_TEMPORAL_P(tidx);
+  GSERIALIZED *gs = PG_GETARG_GSERIALIZED_P(gidx);
+  int result = func(temp, gs, ever, geom_prepared_fncache(fcinfo->flinfo));
+  PG_FREE_IF_COPY(temp, tidx);
+  PG_FREE_IF_COPY(gs, gidx);
+  if (result < 0)
+    PG_RETURN_NULL();
+  PG_RETURN_BOOL(result ? true : false);
+}
+
 /**
  * @brief Return true if two spatiotemporal values ever/always satisfy the
  * spatial relationship
@@ -247,6 +272,28 @@ Acontains_tgeo_tgeo(PG_FUNCTION_ARGS)
  * Ever covers
  *****************************************************************************/
 
+/**
+ * @brief Return 1 if a geometry ever/always covers a temporal geometry, 0 if
+ * not, and -1 on error or if the geometry is empty
+ */
+static int
+ea_covers_geo_tgeo_prep(const Temporal *temp, const GSERIALIZED *gs,
+  bool ever, GEOSPreparedFnCache *fncache)
+{
+  return ea_covers_tgeo_geo_int(temp, gs, ever, INVERT, fncache);
+}
+
+/**
+ * @brief Return 1 if a temporal geometry ever/always covers a geometry, 0 if
+ * not, and -1 on error or if the geometry is empty
+ */
+static int
+ea_covers_tgeo_geo_prep(const Temporal *temp, const GSERIALIZED *gs,
+  bool ever, GEOSPreparedFnCache *fncache)
+{
+  return ea_covers_tgeo_geo_int(temp, gs, ever, INVERT_NO, fncache);
+}
+
 PGDLLEXPORT Datum Ecovers_geo_tgeo(PG_FUNCTION_ARGS);
 PG_FUNCTION_INFO_V1(Ecovers_geo_tgeo);
 /**
@@ -257,7 +304,8 @@ PG_FUNCTION_INFO_V1(Ecovers_geo_tgeo);
 inline Datum
 Ecovers_geo_tgeo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_geo_tspatial(fcinfo, &ea_covers_geo_tgeo, EVER);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_covers_geo_tgeo_prep,
+    EVER, true);
 }
 
 PGDLLEXPORT Datum Acovers_geo_tgeo(PG_FUNCTION_ARGS);
@@ -270,7 +318,8 @@ PG_FUNCTION_INFO_V1(Acovers_geo_tgeo);
 inline Datum
 Acovers_geo_tgeo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_geo_tspatial(fcinfo, &ea_covers_geo_tgeo, ALWAYS);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_covers_geo_tgeo_prep,
+    ALWAYS, true);
 }
 
 PGDLLEXPORT Datum Ecovers_tgeo_geo(PG_FUNCTION_ARGS);
@@ -283,7 +332,8 @@ PG_FUNCTION_INFO_V1(Ecovers_tgeo_geo);
 inline Datum
 Ecovers_tgeo_geo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_tspatial_geo(fcinfo, &ea_covers_tgeo_geo, EVER);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_covers_tgeo_geo_prep,
+    EVER, false);
 }
 
 PGDLLEXPORT Datum Acovers_tgeo_geo(PG_FUNCTION_ARGS);
@@ -296,7 +346,8 @@ PG_FUNCTION_INFO_V1(Acovers_tgeo_geo);
 inline Datum
 Acovers_tgeo_geo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_tspatial_geo(fcinfo, &ea_covers_tgeo_geo, ALWAYS);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_covers_tgeo_geo_prep,
+    ALWAYS, false);
 }
 
 PGDLLEXPORT Datum Ecovers_tgeo_tgeo(PG_FUNCTION_ARGS);
@@ -340,7 +391,8 @@ PG_FUNCTION_INFO_V1(Edisjoint_geo_tgeo);
 inline Datum
 Edisjoint_geo_tgeo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_geo_tspatial(fcinfo, &ea_disjoint_geo_tgeo, EVER);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_disjoint_tgeo_geo_int,
+    EVER, true);
 }
 
 PGDLLEXPORT Datum Adisjoint_geo_tgeo(PG_FUNCTION_ARGS);
@@ -354,7 +406,8 @@ PG_FUNCTION_INFO_V1(Adisjoint_geo_tgeo);
 inline Datum
 Adisjoint_geo_tgeo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_geo_tspatial(fcinfo, &ea_disjoint_geo_tgeo, ALWAYS);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_disjoint_tgeo_geo_int,
+    ALWAYS, true);
 }
 
 PGDLLEXPORT Datum Edisjoint_tgeo_geo(PG_FUNCTION_ARGS);
@@ -368,7 +421,8 @@ PG_FUNCTION_INFO_V1(Edisjoint_tgeo_geo);
 inline Datum
 Edisjoint_tgeo_geo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_tspatial_geo(fcinfo, &ea_disjoint_tgeo_geo, EVER);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_disjoint_tgeo_geo_int,
+    EVER, false);
 }
 
 PGDLLEXPORT Datum Adisjoint_tgeo_geo(PG_FUNCTION_ARGS);
@@ -382,7 +436,8 @@ PG_FUNCTION_INFO_V1(Adisjoint_tgeo_geo);
 inline Datum
 Adisjoint_tgeo_geo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_tspatial_geo(fcinfo, &ea_disjoint_tgeo_geo, ALWAYS);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_disjoint_tgeo_geo_int,
+    ALWAYS, false);
 }
 
 PGDLLEXPORT Datum Edisjoint_tgeo_tgeo(PG_FUNCTION_ARGS);
@@ -426,7 +481,8 @@ PG_FUNCTION_INFO_V1(Eintersects_geo_tgeo);
 inline Datum
 Eintersects_geo_tgeo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_geo_tspatial(fcinfo, &ea_intersects_geo_tgeo, EVER);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_intersects_tgeo_geo_int,
+    EVER, true);
 }
 
 PGDLLEXPORT Datum Aintersects_geo_tgeo(PG_FUNCTION_ARGS);
@@ -440,7 +496,8 @@ PG_FUNCTION_INFO_V1(Aintersects_geo_tgeo);
 inline Datum
 Aintersects_geo_tgeo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_geo_tspatial(fcinfo, &ea_intersects_geo_tgeo, ALWAYS);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_intersects_tgeo_geo_int,
+    ALWAYS, true);
 }
 
 PGDLLEXPORT Datum Eintersects_tgeo_geo(PG_FUNCTION_ARGS);
@@ -454,7 +511,8 @@ PG_FUNCTION_INFO_V1(Eintersects_tgeo_geo);
 inline Datum
 Eintersects_tgeo_geo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_tspatial_geo(fcinfo, &ea_intersects_tgeo_geo, EVER);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_intersects_tgeo_geo_int,
+    EVER, false);
 }
 
 PGDLLEXPORT Datum Aintersects_tgeo_geo(PG_FUNCTION_ARGS);
@@ -468,7 +526,8 @@ PG_FUNCTION_INFO_V1(Aintersects_tgeo_geo);
 inline Datum
 Aintersects_tgeo_geo(PG_FUNCTION_ARGS)
 {
-  return EA_spatialrel_tspatial_geo(fcinfo, &ea_intersects_tgeo_geo, ALWAYS);
+  return EA_spatialrel_tgeo_geo_prep(fcinfo, &ea_intersects_tgeo_geo_int,
+    ALWAYS, false);
 }
 
 PGDLLEXPORT Datum Eintersects_tgeo_tgeo(PG_FUNCTION_ARGS);
@@ -434,11 +434,18 @@ Tgeo_space_time_split_ext(FunctionCallInfo fcinfo, bool timesplit)
     bool bitmatrix = PG_GETARG_BOOL(i++);
     bool border_inc = PG_GETARG_BOOL(i++);
 
-    /* Initialize state and verify parameter validity */
+    /* Initialize state and verify parameter validity. When the bit matrix
+     * is requested for a temporal point, the fragments are computed in a
+     * single pass instead */
+    bool onepass = bitmatrix && tpoint_split_onepass(temp);
     int ntiles;
     STboxGridState *state = tgeo_space_time_tile_init(temp, xsize, ysize,
-      zsize, duration, sorigin, torigin, bitmatrix, border_inc, &ntiles);
+      zsize, duration, sorigin, torigin, onepass ? false : bitmatrix,
+      border_inc, &ntiles);
     assert(state);
+    if (onepass)
+      state->splits = tpoint_space_time_split_tiles(temp, state,
+        &state->split_tiles, &state->nsplits);
 
     /* Create function state */
     funcctx->user_fctx = state;
@@ -454,6 +461,28 @@ Tgeo_space_time_split_ext(FunctionCallInfo fcinfo, bool timesplit)
   /* Get state */
   STboxGridState *state = funcctx->user_fctx;
   bool isnull[3] = {0,0,0}; /* needed to say no value is null */
+  bool hasz = MEOS_FLAGS_GET_Z(state->temp->flags);
+  Datum values[3]; /* used to construct the composite return value */
+  int i = 0;
+
+  /* If the fragments were computed in a single pass */
+  if (state->splits)
+  {
+    /* Stop when we have used up all the fragments */
+    if (state->i > state->nsplits)
+      SRF_RETURN_DONE(funcctx);
+    const STBox *box = &state->split_tiles[state->i - 1];
+    values[i++] = PointerGetDatum(geopoint_make(box->xmin, box->ymin,
+      box->zmin, hasz, false, box->srid));
+    if (timesplit)
+      values[i++] = box->period.lower;
+    values[i++] = PointerGetDatum(state->splits[state->i - 1]);
+    state->i++;
+    HeapTuple tuple = heap_form_tuple(funcctx->tuple_desc, values, isnull);
+    Datum result = HeapTupleGetDatum(tuple);
+    SRF_RETURN_NEXT(funcctx, result);
+  }
+
   /* We need to loop since atStbox may be NULL */
   while (true)
   {
@@ -495,9 +524,6 @@ Tgeo_space_time_split_ext(FunctionCallInfo fcinfo, bool timesplit)
       continue;
 
     /* Form tuple and return */
-    bool hasz = MEOS_FLAGS_GET_Z(state->temp->flags);
-    Datum values[3]; /* used to construct the composite return value */
-    int i = 0;
     values[i++] = PointerGetDatum(geopoint_make(box.xmin, box.ymin,
       box.zmin, hasz, false, box.srid));
     if (timesplit)
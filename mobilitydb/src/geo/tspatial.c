@@ -211,6 +211,27 @@ Tspatial_to_stbox(PG_FUNCTION_ARGS)
   PG_RETURN_STBOX_P(result);
 }
 
+PGDLLEXPORT Datum Tspatial_compressed_stbox(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Tspatial_compressed_stbox);
+/**
+ * @ingroup mobilitydb_geo_conversion
+ * @brief Return the spatiotemporal box of a spatiotemporal value from its
+ * compressed binary representation without decoding its instants
+ * @sqlfn compressedStbox()
+ */
+Datum
+Tspatial_compressed_stbox(PG_FUNCTION_ARGS)
+{
+  bboxunion box;
+  meosType temptype;
+  temporal_compressed_slice(PG_GETARG_DATUM(0), &temptype, &box);
+  if (! ensure_tspatial_type(temptype))
+    PG_RETURN_NULL();
+  STBox *result = palloc(sizeof(STBox));
+  *result = box.g;
+  PG_RETURN_STBOX_P(result);
+}
+
 /*****************************************************************************
  * Spatial reference system functions for spatiotemporal types
  *****************************************************************************/
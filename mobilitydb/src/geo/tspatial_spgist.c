@@ -115,6 +115,7 @@
 #include "pg_temporal/meos_catalog.h"
 #include "pg_temporal/temporal.h"
 #include "pg_temporal/tnumber_spgist.h"
+#include "pg_geo/tspatial.h"
 
 /*****************************************************************************
  * Data structures
@@ -691,7 +692,7 @@ distance_stbox_nodebox(const STBox *query, const STboxNode *nodebox)
 /**
  * @brief Return in the last argument a spatiotemporal box obtained from a query 
  */
-static bool
+bool
 tspatial_spgist_get_stbox(const ScanKeyData *scankey, STBox *result)
 {
   meosType type = oid_type(scankey->sk_subtype);
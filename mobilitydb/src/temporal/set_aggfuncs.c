@@ -36,8 +36,7 @@
 #include <assert.h>
 /* PostgreSQL */
 #include <postgres.h>
-#include <funcapi.h>
-#include <utils/array.h>
+#include <fmgr.h>
 /* MEOS */
 #include <meos.h>
 #include <meos_internal.h>
@@ -51,13 +50,37 @@
  * Aggregate functions for set types
  *****************************************************************************/
 
+/*
+ * The state of the union aggregate of sets is a hash table of the distinct
+ * values aggregated so far, see #SetUnionState. Its size thus depends on the
+ * number of distinct values rather than on the number of input values, which
+ * is typically much smaller when aggregating identifiers. For parallel
+ * aggregation a state is serialized as the set of its values.
+ */
+
+/**
+ * @brief Return the state of a union aggregate, create it in the aggregate
+ * context if it is NULL
+ */
+static SetUnionState *
+set_union_state_get(FunctionCallInfo fcinfo, MemoryContext aggContext,
+  meosType basetype)
+{
+  if (! PG_ARGISNULL(0))
+    return (SetUnionState *) PG_GETARG_POINTER(0);
+  MemoryContext oldContext = MemoryContextSwitchTo(aggContext);
+  SetUnionState *result = set_union_state_make(basetype);
+  MemoryContextSwitchTo(oldContext);
+  return result;
+}
+
 PGDLLEXPORT Datum Value_union_transfn(PG_FUNCTION_ARGS);
 PG_FUNCTION_INFO_V1(Value_union_transfn);
 /**
  * @ingroup mobilitydb_setspan_agg
- * @brief Transition function for union aggregation of sets
- * @note We simply gather the input values into an array so that the final
- * function can sort and combine them
+ * @brief Transition function for union aggregation of values
+ * @note The values are added to the hash table of the state only if they are
+ * not already in it
  * @sqlfn union()
  */
 Datum
@@ -67,19 +90,23 @@ Value_union_transfn(PG_FUNCTION_ARGS)
   if (! AggCheckCallContext(fcinfo, &aggContext))
     elog(ERROR, "Value_union_transfn called in non-aggregate context");
 
-  Oid valueoid = get_fn_expr_argtype(fcinfo->flinfo, 1);
-  assert(set_basetype(oid_type(valueoid)));
-
-  ArrayBuildState *state;
-  if (PG_ARGISNULL(0))
-    state = initArrayResult(valueoid, aggContext, false);
-  else
-    state = (ArrayBuildState *) PG_GETARG_POINTER(0);
-
   /* Skip NULLs */
-  if (! PG_ARGISNULL(1))
-    accumArrayResult(state, PG_GETARG_DATUM(1), false, valueoid, aggContext);
+  if (PG_ARGISNULL(1))
+  {
+    if (PG_ARGISNULL(0))
+      PG_RETURN_NULL();
+    PG_RETURN_POINTER(PG_GETARG_POINTER(0));
+  }
 
+  Oid valueoid = get_fn_expr_argtype(fcinfo->flinfo, 1);
+  meosType basetype = oid_type(valueoid);
+  assert(set_basetype(basetype));
+  SetUnionState *state = set_union_state_get(fcinfo, aggContext, basetype);
+  Datum value = basetype_byvalue(basetype) ? PG_GETARG_DATUM(1) :
+    PointerGetDatum(PG_DETOAST_DATUM(PG_GETARG_DATUM(1)));
+  MemoryContext oldContext = MemoryContextSwitchTo(aggContext);
+  set_union_state_add(state, value);
+  MemoryContextSwitchTo(oldContext);
   PG_RETURN_POINTER(state);
 }
 
@@ -88,8 +115,8 @@ PG_FUNCTION_INFO_V1(Set_union_transfn);
 /**
  * @ingroup mobilitydb_setspan_agg
  * @brief Transition function for union aggregation of sets
- * @note We simply gather the input values into an array so that the final
- * function can sort and combine them
+ * @note The values are added to the hash table of the state only if they are
+ * not already in it
  * @sqlfn union()
  */
 Datum
@@ -99,74 +126,130 @@ Set_union_transfn(PG_FUNCTION_ARGS)
   if (! AggCheckCallContext(fcinfo, &aggContext))
     elog(ERROR, "Set_union_transfn called in non-aggregate context");
 
-  Oid setoid = get_fn_expr_argtype(fcinfo->flinfo, 1);
-  meosType settype = oid_type(setoid);
-  assert(set_type(settype));
-  meosType basetype = settype_basetype(settype);
-  Oid baseoid = type_oid(basetype);
-
-  ArrayBuildState *state;
-  if (PG_ARGISNULL(0))
-    state = initArrayResult(baseoid, aggContext, false);
-  else
-    state = (ArrayBuildState *) PG_GETARG_POINTER(0);
-
-  /* skip NULLs */
-  if (! PG_ARGISNULL(1))
+  /* Skip NULLs */
+  if (PG_ARGISNULL(1))
   {
-    Set *set = PG_GETARG_SET_P(1);
-    Datum *values = set_vals(set);
-    for (int i = 0; i < set->count; i++)
-      accumArrayResult(state, values[i], false, baseoid, aggContext);
-    pfree(values);
+    if (PG_ARGISNULL(0))
+      PG_RETURN_NULL();
+    PG_RETURN_POINTER(PG_GETARG_POINTER(0));
   }
+
+  Set *s = PG_GETARG_SET_P(1);
+  SetUnionState *state = set_union_state_get(fcinfo, aggContext,
+    s->basetype);
+  MemoryContext oldContext = MemoryContextSwitchTo(aggContext);
+  set_union_state_add_set(state, s);
+  MemoryContextSwitchTo(oldContext);
+  PG_FREE_IF_COPY(s, 1);
   PG_RETURN_POINTER(state);
 }
 
-PGDLLEXPORT Datum Set_union_finalfn(PG_FUNCTION_ARGS);
-PG_FUNCTION_INFO_V1(Set_union_finalfn);
+PGDLLEXPORT Datum Set_union_combinefn(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Set_union_combinefn);
 /**
  * @ingroup mobilitydb_setspan_agg
- * @brief Final function for union aggregation of sets
+ * @brief Combine function for union aggregation of sets
  * @sqlfn union()
  */
 Datum
-Set_union_finalfn(PG_FUNCTION_ARGS)
+Set_union_combinefn(PG_FUNCTION_ARGS)
 {
   MemoryContext aggContext;
   if (! AggCheckCallContext(fcinfo, &aggContext))
-    elog(ERROR, "Set_union_finalfn called in non-aggregate context");
+    elog(ERROR, "Set_union_combinefn called in non-aggregate context");
 
-  ArrayBuildState *state = PG_ARGISNULL(0) ? NULL :
-    (ArrayBuildState *) PG_GETARG_POINTER(0);
-  if (! state)
-    /* This shouldn't be possible, but just in case.... */
-    PG_RETURN_NULL();
+  SetUnionState *state1 = PG_ARGISNULL(0) ? NULL :
+    (SetUnionState *) PG_GETARG_POINTER(0);
+  SetUnionState *state2 = PG_ARGISNULL(1) ? NULL :
+    (SetUnionState *) PG_GETARG_POINTER(1);
+  if (! state2)
+  {
+    if (! state1)
+      PG_RETURN_NULL();
+    PG_RETURN_POINTER(state1);
+  }
 
-  /* Also return NULL if we had zero inputs, like other aggregates */
-  int32 count = state->nelems;
-  if (count == 0)
-    PG_RETURN_NULL();
+  /* The first state is created in the aggregate context if it is NULL */
+  MemoryContext oldContext = MemoryContextSwitchTo(aggContext);
+  if (! state1)
+    state1 = set_union_state_make(state2->basetype);
+  set_union_state_merge(state1, state2);
+  MemoryContextSwitchTo(oldContext);
+  PG_RETURN_POINTER(state1);
+}
 
-  Oid setoid = get_fn_expr_rettype(fcinfo->flinfo);
-  meosType settype = oid_type(setoid);
-  meosType basetype = settype_basetype(settype);
-  bool typbyval = basetype_byvalue(basetype);
-  int16 typlen = basetype_length(basetype);
+PGDLLEXPORT Datum Set_union_serialfn(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Set_union_serialfn);
+/**
+ * @ingroup mobilitydb_setspan_agg
+ * @brief Serialization function for union aggregation of sets
+ * @note The state is serialized as the set of its values
+ * @sqlfn union()
+ */
+Datum
+Set_union_serialfn(PG_FUNCTION_ARGS)
+{
+  /* Cannot be called directly because of internal-type argument */
+  Assert(AggCheckCallContext(fcinfo, NULL));
+  SetUnionState *state = (SetUnionState *) PG_GETARG_POINTER(0);
+  Set *result = set_union_state_finalize(state);
+  /* An empty state is serialized as an empty bytea */
+  if (! result)
+  {
+    bytea *empty = palloc(VARHDRSZ);
+    SET_VARSIZE(empty, VARHDRSZ);
+    PG_RETURN_BYTEA_P(empty);
+  }
+  PG_RETURN_BYTEA_P((bytea *) result);
+}
 
-  Datum *values = palloc0(sizeof(Datum) * count);
-  for (int i = 0; i < count; i++)
-    values[i] = typlen > 0 ? state->dvalues[i] :
-      PointerGetDatum(PG_DETOAST_DATUM(state->dvalues[i]));
+PGDLLEXPORT Datum Set_union_deserialfn(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Set_union_deserialfn);
+/**
+ * @ingroup mobilitydb_setspan_agg
+ * @brief Deserialization function for union aggregation of sets
+ * @sqlfn union()
+ */
+Datum
+Set_union_deserialfn(PG_FUNCTION_ARGS)
+{
+  MemoryContext aggContext;
+  if (! AggCheckCallContext(fcinfo, &aggContext))
+    elog(ERROR, "Set_union_deserialfn called in non-aggregate context");
 
-  Set *result = set_make_exp(values, count, count, basetype, ORDER);
+  /* The set is copied since its values must be double aligned */
+  bytea *data = PG_GETARG_BYTEA_P_COPY(0);
+  if (VARSIZE(data) == VARHDRSZ)
+    PG_RETURN_NULL();
+  Set *s = (Set *) data;
+  MemoryContext oldContext = MemoryContextSwitchTo(aggContext);
+  SetUnionState *result = set_union_state_make(s->basetype);
+  set_union_state_add_set(result, s);
+  MemoryContextSwitchTo(oldContext);
+  pfree(data);
+  PG_RETURN_POINTER(result);
+}
 
-  /* Free memory */
-  if (typbyval)
-    pfree(values);
-  else
-    pfree_array((void **) values, count);
+PGDLLEXPORT Datum Set_union_finalfn(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Set_union_finalfn);
+/**
+ * @ingroup mobilitydb_setspan_agg
+ * @brief Final function for union aggregation of sets
+ * @sqlfn union()
+ */
+Datum
+Set_union_finalfn(PG_FUNCTION_ARGS)
+{
+  /* Cannot be called directly because of internal-type argument */
+  Assert(AggCheckCallContext(fcinfo, NULL));
 
+  /* Return NULL if we had zero or only null inputs, like other aggregates */
+  if (PG_ARGISNULL(0))
+    PG_RETURN_NULL();
+  SetUnionState *state = (SetUnionState *) PG_GETARG_POINTER(0);
+  Set *result = set_union_state_finalize(state);
+  if (! result)
+    PG_RETURN_NULL();
   PG_RETURN_SET_P(result);
 }
 
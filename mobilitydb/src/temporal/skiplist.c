@@ -35,12 +35,10 @@
 #include "temporal/skiplist.h"
 
 /* PostgreSQL */
-#include <executor/spi.h>
-#include <libpq/pqformat.h>
+#include <fmgr.h>
 /* MEOS */
 #include <meos.h>
 #include <meos_internal.h>
-#include "temporal/type_util.h"
 /* MobilityDB */
 #include "pg_temporal/temporal.h"
 
@@ -75,67 +73,25 @@ unset_aggregation_context(MemoryContext ctx)
  * Generic binary aggregate functions needed for parallelization
  *****************************************************************************/
 
-/**
- * @brief Write the state value into the buffer
- * @param[in] state State
- * @param[in] buf Buffer
- */
-static void
-aggstate_write(SkipList *state, StringInfo buf)
-{
-  int i;
-  void **values = skiplist_values(state);
-  pq_sendint32(buf, (uint32) state->length);
-  for (i = 0; i < state->length; i ++)
-  {
-    SPI_connect();
-    temporal_write((Temporal *) values[i], buf);
-    SPI_finish();
-  }
-  pq_sendint64(buf, state->extrasize);
-  if (state->extra)
-    pq_sendbytes(buf, state->extra, (int) state->extrasize);
-  pfree(values);
-  return;
-}
-
-/**
- * @brief Read the state value from the buffer
- * @param[in] buf Buffer
- */
-static SkipList *
-aggstate_read(StringInfo buf)
-{
-  int length = pq_getmsgint(buf, 4);
-  void **values = palloc0(sizeof(void *) * length);
-  SkipList *result = NULL; /* make compiler quiet */
-  for (int i = 0; i < length; i ++)
-    values[i] = temporal_recv(buf);
-  size_t extrasize = (size_t) pq_getmsgint64(buf);
-  result = temporal_skiplist_make();
-  temporal_skiplist_splice(result, values, length, NULL, false);
-  if (extrasize)
-  {
-    const char *extra = pq_getmsgbytes(buf, (int) extrasize);
-    skiplist_set_extra(result, (void *) extra, extrasize);
-  }
-  pfree_array(values, length);
-  return result;
-}
-
 Datum Taggstate_serialize(PG_FUNCTION_ARGS);
 PG_FUNCTION_INFO_V1(Taggstate_serialize);
 /**
  * @brief Serialize the state value
+ * @note The state is written in the compact columnar format of the function
+ * #taggstate_serialize
  */
 Datum
 Taggstate_serialize(PG_FUNCTION_ARGS)
 {
   SkipList *state = (SkipList *) PG_GETARG_POINTER(0);
-  StringInfoData buf;
-  pq_begintypsend(&buf);
-  aggstate_write(state, &buf);
-  PG_RETURN_BYTEA_P(pq_endtypsend(&buf));
+  store_fcinfo(fcinfo);
+  size_t size;
+  uint8_t *data = taggstate_serialize(state, &size);
+  bytea *result = palloc(VARHDRSZ + size);
+  SET_VARSIZE(result, VARHDRSZ + size);
+  memcpy(VARDATA(result), data, size);
+  pfree(data);
+  PG_RETURN_BYTEA_P(result);
 }
 
 Datum Taggstate_deserialize(PG_FUNCTION_ARGS);
@@ -147,14 +103,13 @@ Datum
 Taggstate_deserialize(PG_FUNCTION_ARGS)
 {
   bytea *data = PG_GETARG_BYTEA_P(0);
-  StringInfoData buf =
-  {
-    .cursor = 0,
-    .data = VARDATA(data),
-    .len = VARSIZE(data),
-    .maxlen = VARSIZE(data)
-  };
-  SkipList *result = aggstate_read(&buf);
+  store_fcinfo(fcinfo);
+  /* The values are kept by the state without being copied and thus must be
+   * allocated in the aggregation context */
+  MemoryContext ctx = set_aggregation_context(fcinfo);
+  SkipList *result = taggstate_deserialize((uint8_t *) VARDATA(data),
+    VARSIZE(data) - VARHDRSZ);
+  unset_aggregation_context(ctx);
   PG_RETURN_SKIPLIST_P(result);
 }
 
@@ -52,6 +52,7 @@
 #include "temporal/stratnum.h"
 /* MobilityDB */
 #include "pg_temporal/meos_catalog.h"
+#include "pg_temporal/span.h"
 #include "pg_temporal/spanset.h"
 #include "pg_temporal/temporal.h"
 
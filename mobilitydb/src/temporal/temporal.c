@@ -52,6 +52,7 @@
 #include "temporal/tbox.h"
 #include "temporal/temporal.h"
 #include "temporal/temporal_boxops.h"
+#include "temporal/temporal_compress.h"
 #include "temporal/type_inout.h"
 #include "temporal/type_util.h"
 #include "geo/tgeo.h"
@@ -270,6 +271,34 @@ temporal_slice(Datum tempdatum)
   return result;
 }
 
+/**
+ * @brief Peek into the compressed binary representation of a temporal value
+ * to find its temporal type and its bounding box
+ * @details If the datum needs to be detoasted, extract only the header and
+ * not the full object, except for temporal instants that do not keep their
+ * bounding box
+ * @note For the header to be fetched without reading the full object, the
+ * column storing the compressed values should not be compressed by
+ * PostgreSQL, e.g., by setting its storage to EXTERNAL
+ */
+void
+temporal_compressed_slice(Datum datum, meosType *temptype, void *box)
+{
+  bytea *data = (bytea *) PG_DETOAST_DATUM_SLICE(datum, 0,
+    TEMPORAL_COMPRESSED_MAX_HEADER_SIZE);
+  size_t size = VARSIZE(data) - VARHDRSZ;
+  if (size >= TEMPORAL_COMPRESSED_HEADER_SIZE &&
+      ((uint8_t *) VARDATA(data))[2] == TINSTANT)
+  {
+    pfree(data);
+    data = (bytea *) PG_DETOAST_DATUM_COPY(datum);
+    size = VARSIZE(data) - VARHDRSZ;
+  }
+  temporal_compressed_set_bbox((uint8_t *) VARDATA(data), size, temptype, box);
+  pfree(data);
+  return;
+}
+
 /*****************************************************************************
  * Version functions
  *****************************************************************************/
@@ -305,6 +334,74 @@ Mobilitydb_full_version(PG_FUNCTION_ARGS UNUSED)
   PG_RETURN_TEXT_P(result);
 }
 
+PGDLLEXPORT Datum Meos_stats(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Meos_stats);
+/**
+ * @ingroup mobilitydb_misc
+ * @brief Return the instrumentation counters of the current backend
+ * @note The extension must have been built with the option
+ * @p -DMEOS_STATS=ON
+ * @sqlfn meosStats()
+ */
+Datum
+Meos_stats(PG_FUNCTION_ARGS)
+{
+  FuncCallContext *funcctx;
+
+  /* If the function is being called for the first time */
+  if (SRF_IS_FIRSTCALL())
+  {
+    /* Initialize the FuncCallContext */
+    funcctx = SRF_FIRSTCALL_INIT();
+    /* Switch to memory context appropriate for multiple function calls */
+    MemoryContext oldcontext =
+      MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+    /* Take a snapshot of the counters so that the rows are consistent */
+    MeosStat *stats = palloc(sizeof(MeosStat) * MEOS_STAT_COUNT);
+    if (! meos_stats_get(stats))
+      meos_error(ERROR, MEOS_ERR_FEATURE_NOT_SUPPORTED,
+        "The extension was built without instrumentation counters");
+    funcctx->user_fctx = stats;
+    funcctx->max_calls = MEOS_STAT_COUNT;
+    /* Build a tuple description for the function output */
+    get_call_result_type(fcinfo, 0, &funcctx->tuple_desc);
+    BlessTupleDesc(funcctx->tuple_desc);
+    MemoryContextSwitchTo(oldcontext);
+  }
+
+  /* Stuff done on every call of the function */
+  funcctx = SRF_PERCALL_SETUP();
+  /* Stop when we've output all the counters */
+  if (funcctx->call_cntr >= funcctx->max_calls)
+    SRF_RETURN_DONE(funcctx);
+
+  MeosStat *stats = funcctx->user_fctx;
+  int i = (int) funcctx->call_cntr;
+  Datum values[3]; /* used to construct the composite return value */
+  values[0] = PointerGetDatum(cstring2text(meos_stat_name((meosStatType) i)));
+  values[1] = Int64GetDatum((int64) stats[i].calls);
+  values[2] = Int64GetDatum((int64) stats[i].nsecs);
+  /* Form tuple and return */
+  bool isnull[3] = {0,0,0}; /* needed to say no value is null */
+  HeapTuple tuple = heap_form_tuple(funcctx->tuple_desc, values, isnull);
+  Datum result = HeapTupleGetDatum(tuple);
+  SRF_RETURN_NEXT(funcctx, result);
+}
+
+PGDLLEXPORT Datum Meos_stats_reset(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Meos_stats_reset);
+/**
+ * @ingroup mobilitydb_misc
+ * @brief Reset the instrumentation counters of the current backend
+ * @sqlfn meosStatsReset()
+ */
+Datum
+Meos_stats_reset(PG_FUNCTION_ARGS UNUSED)
+{
+  meos_stats_reset();
+  PG_RETURN_VOID();
+}
+
 /*****************************************************************************
  * Send and receive functions
  * The send and receive functions are needed for temporal aggregation
@@ -508,6 +605,94 @@ Temporal_send(PG_FUNCTION_ARGS)
   PG_RETURN_BYTEA_P(result);
 }
 
+PGDLLEXPORT Datum Temporal_as_compressed(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Temporal_as_compressed);
+/**
+ * @ingroup mobilitydb_temporal_inout
+ * @brief Return the compressed binary representation of a temporal value
+ * @details The timestamps are encoded with delta-of-delta encoding and the
+ * floats and the coordinates of the points are encoded by XORing them with
+ * the previous value. The bounding box is kept in the header of the result
+ * so that it can be obtained without decoding the instants.
+ * @sqlfn asCompressed()
+ */
+Datum
+Temporal_as_compressed(PG_FUNCTION_ARGS)
+{
+  Temporal *temp = PG_GETARG_TEMPORAL_P(0);
+  size_t size;
+  uint8_t *data = temporal_as_compressed(temp, &size);
+  bytea *result = bstring2bytea(data, size);
+  pfree(data);
+  PG_FREE_IF_COPY(temp, 0);
+  PG_RETURN_BYTEA_P(result);
+}
+
+PGDLLEXPORT Datum Temporal_from_compressed(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Temporal_from_compressed);
+/**
+ * @ingroup mobilitydb_temporal_inout
+ * @brief Return a temporal value from its compressed binary representation
+ * @sqlfn tintFromCompressed(), tfloatFromCompressed(), ...
+ */
+Datum
+Temporal_from_compressed(PG_FUNCTION_ARGS)
+{
+  bytea *data = PG_GETARG_BYTEA_P(0);
+  meosType temptype = oid_type(get_fn_expr_rettype(fcinfo->flinfo));
+  Temporal *result = temporal_from_compressed((uint8_t *) VARDATA(data),
+    VARSIZE(data) - VARHDRSZ);
+  PG_FREE_IF_COPY(data, 0);
+  if (! ensure_temporal_isof_type(result, temptype))
+    PG_RETURN_NULL();
+  PG_RETURN_TEMPORAL_P(result);
+}
+
+PGDLLEXPORT Datum Temporal_compressed_tstzspan(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Temporal_compressed_tstzspan);
+/**
+ * @ingroup mobilitydb_temporal_inout
+ * @brief Return the time span of a temporal value from its compressed binary
+ * representation without decoding its instants
+ * @sqlfn compressedTimeSpan()
+ */
+Datum
+Temporal_compressed_tstzspan(PG_FUNCTION_ARGS)
+{
+  bboxunion box;
+  meosType temptype;
+  temporal_compressed_slice(PG_GETARG_DATUM(0), &temptype, &box);
+  Span *result = palloc(sizeof(Span));
+  if (talpha_type(temptype))
+    *result = box.p;
+  else if (tnumber_type(temptype))
+    *result = box.b.period;
+  else /* tspatial_type(temptype) */
+    *result = box.g.period;
+  PG_RETURN_SPAN_P(result);
+}
+
+PGDLLEXPORT Datum Tnumber_compressed_tbox(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Tnumber_compressed_tbox);
+/**
+ * @ingroup mobilitydb_temporal_inout
+ * @brief Return the temporal box of a temporal number from its compressed
+ * binary representation without decoding its instants
+ * @sqlfn compressedTbox()
+ */
+Datum
+Tnumber_compressed_tbox(PG_FUNCTION_ARGS)
+{
+  bboxunion box;
+  meosType temptype;
+  temporal_compressed_slice(PG_GETARG_DATUM(0), &temptype, &box);
+  if (! ensure_tnumber_type(temptype))
+    PG_RETURN_NULL();
+  TBox *result = palloc(sizeof(TBox));
+  *result = box.b;
+  PG_RETURN_TBOX_P(result);
+}
+
 /*****************************************************************************
  * Constructor functions
  ****************************************************************************/
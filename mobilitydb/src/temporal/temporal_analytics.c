@@ -181,7 +181,7 @@ Temporal_similarity(FunctionCallInfo fcinfo, SimFunc simfunc)
     store_fcinfo(fcinfo);
   double result = (simfunc == HAUSDORFF) ?
     temporal_hausdorff_distance(temp1, temp2) :
-    temporal_similarity(temp1, temp2, simfunc);
+    temporal_similarity(temp1, temp2, simfunc, -1, -1.0);
   PG_FREE_IF_COPY(temp1, 0);
   PG_FREE_IF_COPY(temp2, 1);
   PG_RETURN_FLOAT8(result);
@@ -0,0 +1,300 @@
+/*****************************************************************************
+ *
+ * This MobilityDB code is provided under The PostgreSQL License.
+ * Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+ * contributors
+ *
+ * MobilityDB includes portions of PostGIS version 3 source code released
+ * under the GNU General Public License (GPLv2 or later).
+ * Copyright (c) 2001-2025, PostGIS contributors
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without a written
+ * agreement is hereby granted, provided that the above copyright notice and
+ * this paragraph and the following two paragraphs appear in all copies.
+ *
+ * IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+ * LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+ * EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ *
+ * UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+ * AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief BRIN indexes for temporal types based on their bounding box
+ * @details The summary of a page range is the union of the bounding boxes of
+ * the values in the range, that is, a `tstzspan` for temporal Booleans and
+ * temporal texts, a `tbox` for temporal numbers, and an `stbox` for
+ * spatiotemporal values. The same functions are used for indexing columns of
+ * type `tstzspan`, `tbox`, and `stbox`. Since the summary of a page range
+ * plays the role of the key of an inner node of an R-tree, a page range is
+ * consistent with a query if the GiST inner consistent function of the
+ * bounding box type is satisfied.
+ */
+
+/* PostgreSQL */
+#include <postgres.h>
+#include <access/brin_internal.h>
+#include <access/brin_tuple.h>
+#include <access/skey.h>
+#include <utils/datum.h>
+#include <utils/typcache.h>
+/* MEOS */
+#include <meos.h>
+#include <meos_internal.h>
+#include <meos_internal_geo.h>
+#include "temporal/span.h"
+#include "temporal/span_index.h"
+#include "temporal/tbox.h"
+#include "temporal/tbox_index.h"
+#include "temporal/temporal.h"
+#include "geo/stbox.h"
+#include "geo/stbox_index.h"
+/* MobilityDB */
+#include "pg_temporal/meos_catalog.h"
+#include "pg_temporal/span.h"
+#include "pg_temporal/temporal.h"
+#include "pg_temporal/tnumber_spgist.h"
+#include "pg_geo/tspatial.h"
+
+/**
+ * @brief Information kept by the BRIN operator classes
+ */
+typedef struct
+{
+  meosType type;      /**< Type of the indexed column */
+  meosType bboxtype;  /**< Type of the summary of a page range */
+} BboxBrinOpaque;
+
+/**
+ * @brief Return the information kept by the BRIN operator class of a column
+ */
+#define BRIN_BBOX_OPAQUE(bdesc, attno) \
+  ((BboxBrinOpaque *) (bdesc)->bd_info[(attno) - 1]->oi_opaque)
+
+/*****************************************************************************/
+
+/**
+ * @brief Return the bounding box type used for summarizing a column type
+ */
+static meosType
+brin_bboxtype(meosType type)
+{
+  if (bbox_type(type))
+    return type;
+  if (talpha_type(type))
+    return T_TSTZSPAN;
+  if (tnumber_type(type))
+    return T_TBOX;
+  if (tspatial_type(type))
+    return T_STBOX;
+  elog(ERROR, "Unsupported type for BRIN indexing: %d", type);
+  return T_UNKNOWN; /* make compiler quiet */
+}
+
+/**
+ * @brief Return in the last argument the bounding box of an indexed value
+ */
+static void
+brin_value_set_bbox(Datum value, const BboxBrinOpaque *opaque, void *box)
+{
+  if (opaque->type == opaque->bboxtype)
+    memcpy(box, DatumGetPointer(value), bbox_get_size(opaque->bboxtype));
+  else
+    temporal_set_bbox(temporal_slice(value), box);
+  return;
+}
+
+/**
+ * @brief Expand the second bounding box with the first one
+ */
+static void
+brin_bbox_expand(const void *box1, void *box2, meosType bboxtype)
+{
+  if (bboxtype == T_TSTZSPAN)
+    span_expand((Span *) box1, (Span *) box2);
+  else if (bboxtype == T_TBOX)
+    tbox_expand((TBox *) box1, (TBox *) box2);
+  else /* bboxtype == T_STBOX */
+    stbox_expand((STBox *) box1, (STBox *) box2);
+  return;
+}
+
+/*****************************************************************************
+ * BRIN support functions
+ *****************************************************************************/
+
+PGDLLEXPORT Datum Temporal_brin_opcinfo(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Temporal_brin_opcinfo);
+/**
+ * @brief BRIN opcinfo function for temporal types
+ * @details The summary of a page range is stored as a single value of the
+ * bounding box type of the indexed column
+ */
+Datum
+Temporal_brin_opcinfo(PG_FUNCTION_ARGS)
+{
+  Oid typoid = PG_GETARG_OID(0);
+  meosType type = oid_type(typoid);
+  meosType bboxtype = brin_bboxtype(type);
+
+  BrinOpcInfo *result = palloc0(MAXALIGN(SizeofBrinOpcInfo(1)) +
+    sizeof(BboxBrinOpaque));
+  result->oi_nstored = 1;
+#if POSTGRESQL_VERSION_NUMBER >= 140000
+  /* Null values are handled by the BRIN framework */
+  result->oi_regular_nulls = true;
+#endif
+  BboxBrinOpaque *opaque = (BboxBrinOpaque *)
+    ((char *) result + MAXALIGN(SizeofBrinOpcInfo(1)));
+  opaque->type = type;
+  opaque->bboxtype = bboxtype;
+  result->oi_opaque = opaque;
+  result->oi_typcache[0] = lookup_type_cache(type_oid(bboxtype), 0);
+  PG_RETURN_POINTER(result);
+}
+
+PGDLLEXPORT Datum Temporal_brin_add_value(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Temporal_brin_add_value);
+/**
+ * @brief BRIN add value function for temporal types
+ * @details Expand the summary of a page range with the bounding box of a new
+ * value and return true if the summary has been modified
+ */
+Datum
+Temporal_brin_add_value(PG_FUNCTION_ARGS)
+{
+  BrinDesc *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+  BrinValues *column = (BrinValues *) PG_GETARG_POINTER(1);
+  Datum newval = PG_GETARG_DATUM(2);
+  bool isnull = PG_GETARG_BOOL(3);
+
+  /* Before PostgreSQL 14 the null values must be handled by the function */
+  if (isnull)
+  {
+    if (column->bv_hasnulls)
+      PG_RETURN_BOOL(false);
+    column->bv_hasnulls = true;
+    PG_RETURN_BOOL(true);
+  }
+
+  BboxBrinOpaque *opaque = BRIN_BBOX_OPAQUE(bdesc, column->bv_attno);
+  size_t bboxsize = bbox_get_size(opaque->bboxtype);
+  bboxunion box;
+  brin_value_set_bbox(newval, opaque, &box);
+
+  /* The summary is the bounding box of the first value */
+  if (column->bv_allnulls)
+  {
+    column->bv_values[0] = datumCopy(PointerGetDatum(&box), false,
+      (int) bboxsize);
+    column->bv_allnulls = false;
+    PG_RETURN_BOOL(true);
+  }
+
+  /* Expand a copy of the summary and replace it if it changed */
+  bboxunion summary;
+  memcpy(&summary, DatumGetPointer(column->bv_values[0]), bboxsize);
+  brin_bbox_expand(&box, &summary, opaque->bboxtype);
+  if (memcmp(&summary, DatumGetPointer(column->bv_values[0]), bboxsize) == 0)
+    PG_RETURN_BOOL(false);
+  memcpy(DatumGetPointer(column->bv_values[0]), &summary, bboxsize);
+  PG_RETURN_BOOL(true);
+}
+
+PGDLLEXPORT Datum Temporal_brin_consistent(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Temporal_brin_consistent);
+/**
+ * @brief BRIN consistent function for temporal types
+ * @details Return true if the values of a page range may satisfy the query
+ */
+Datum
+Temporal_brin_consistent(PG_FUNCTION_ARGS)
+{
+  BrinDesc *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+  BrinValues *column = (BrinValues *) PG_GETARG_POINTER(1);
+  ScanKey key = (ScanKey) PG_GETARG_POINTER(2);
+
+  /* Before PostgreSQL 14 the null values must be handled by the function */
+  if (key->sk_flags & SK_ISNULL)
+  {
+    if (key->sk_flags & SK_SEARCHNULL)
+      PG_RETURN_BOOL(column->bv_allnulls || column->bv_hasnulls);
+    if (key->sk_flags & SK_SEARCHNOTNULL)
+      PG_RETURN_BOOL(! column->bv_allnulls);
+    /* Other operators are strict and return false with a null argument */
+    PG_RETURN_BOOL(false);
+  }
+  if (column->bv_allnulls)
+    PG_RETURN_BOOL(false);
+
+  BboxBrinOpaque *opaque = BRIN_BBOX_OPAQUE(bdesc, column->bv_attno);
+  void *summary = DatumGetPointer(column->bv_values[0]);
+  /* A query that cannot be converted into a bounding box is not satisfied */
+  bool result;
+  if (opaque->bboxtype == T_TSTZSPAN)
+  {
+    Span query;
+    result = span_spgist_get_span(key, &query) &&
+      span_gist_inner_consistent((Span *) summary, &query,
+        key->sk_strategy);
+  }
+  else if (opaque->bboxtype == T_TBOX)
+  {
+    TBox query;
+    result = tnumber_spgist_get_tbox(key, &query) &&
+      tbox_gist_inner_consistent((TBox *) summary, &query,
+        key->sk_strategy);
+  }
+  else /* opaque->bboxtype == T_STBOX */
+  {
+    STBox query;
+    result = tspatial_spgist_get_stbox(key, &query) &&
+      stbox_gist_inner_consistent((STBox *) summary, &query,
+        key->sk_strategy);
+  }
+  PG_RETURN_BOOL(result);
+}
+
+PGDLLEXPORT Datum Temporal_brin_union(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Temporal_brin_union);
+/**
+ * @brief BRIN union function for temporal types
+ * @details Expand the summary of the first page range with the one of the
+ * second page range
+ */
+Datum
+Temporal_brin_union(PG_FUNCTION_ARGS)
+{
+  BrinDesc *bdesc = (BrinDesc *) PG_GETARG_POINTER(0);
+  BrinValues *col_a = (BrinValues *) PG_GETARG_POINTER(1);
+  BrinValues *col_b = (BrinValues *) PG_GETARG_POINTER(2);
+
+  /* Before PostgreSQL 14 the null values must be handled by the function */
+  if (col_b->bv_hasnulls)
+    col_a->bv_hasnulls = true;
+  if (col_b->bv_allnulls)
+    PG_RETURN_VOID();
+
+  BboxBrinOpaque *opaque = BRIN_BBOX_OPAQUE(bdesc, col_a->bv_attno);
+  if (col_a->bv_allnulls)
+  {
+    col_a->bv_values[0] = datumCopy(col_b->bv_values[0], false,
+      (int) bbox_get_size(opaque->bboxtype));
+    col_a->bv_allnulls = false;
+    PG_RETURN_VOID();
+  }
+  brin_bbox_expand(DatumGetPointer(col_b->bv_values[0]),
+    DatumGetPointer(col_a->bv_values[0]), opaque->bboxtype);
+  PG_RETURN_VOID();
+}
+
+/*****************************************************************************/
@@ -44,6 +44,7 @@
 #include <postgres.h>
 #include <access/gist.h>
 #include <utils/float.h>
+#include <utils/sortsupport.h>
 #include <utils/timestamp.h>
 /* MEOS */
 #include <meos.h>
@@ -959,6 +960,113 @@ Tbox_gist_picksplit(PG_FUNCTION_ARGS)
   return bbox_gist_picksplit(fcinfo, T_TBOX, &tbox_adjust, &tbox_penalty);
 }
 
+/*****************************************************************************
+ * GiST sortsupport method
+ *****************************************************************************/
+
+/**
+ * @brief Return an unsigned integer whose order is the order of a double
+ * @details Positive values have their sign bit set and negative values have
+ * all their bits flipped, so that the unsigned order of the result is the
+ * order of the doubles.
+ */
+uint64
+double_sortable_uint64(double d)
+{
+  uint64 u;
+  memcpy(&u, &d, sizeof(uint64));
+  return (u & UINT64CONST(0x8000000000000000)) ?
+    ~u : u | UINT64CONST(0x8000000000000000);
+}
+
+/**
+ * @brief Return an unsigned integer whose order is the order of a timestamp
+ */
+uint64
+timestamptz_sortable_uint64(TimestampTz t)
+{
+  return ((uint64) t) ^ UINT64CONST(0x8000000000000000);
+}
+
+/**
+ * @brief Return -1, 0, or 1 depending on whether the first point is before,
+ * equal, or after the second one on a Z-order curve
+ * @details The points are compared without interleaving the bits of their
+ * coordinates: the dimension of the most significant bit in which the
+ * coordinates differ decides the comparison.
+ * @param[in] p1,p2 Coordinates of the points as sortable unsigned integers
+ * @param[in] ndims Number of dimensions
+ */
+int
+zorder_cmp(const uint64 *p1, const uint64 *p2, int ndims)
+{
+  int dim = 0;
+  uint64 msb = 0;
+  for (int i = 0; i < ndims; i++)
+  {
+    uint64 diff = p1[i] ^ p2[i];
+    /* The most significant bit of diff is higher than the one of msb */
+    if (msb < diff && msb < (msb ^ diff))
+    {
+      dim = i;
+      msb = diff;
+    }
+  }
+  if (p1[dim] == p2[dim])
+    return 0;
+  return (p1[dim] < p2[dim]) ? -1 : 1;
+}
+
+/**
+ * @brief Set the coordinates of the center of a temporal box as sortable
+ * unsigned integers, where missing dimensions are set to 0
+ */
+static void
+tbox_zorder_point(const TBox *box, uint64 *p)
+{
+  p[0] = p[1] = 0;
+  if (MEOS_FLAGS_GET_X(box->flags))
+  {
+    double xmin = datum_double(box->span.lower, box->span.basetype);
+    double xmax = datum_double(box->span.upper, box->span.basetype);
+    p[0] = double_sortable_uint64((xmin + xmax) / 2.0);
+  }
+  if (MEOS_FLAGS_GET_T(box->flags))
+    p[1] = timestamptz_sortable_uint64(
+      DatumGetTimestampTz(box->period.lower) / 2 +
+      DatumGetTimestampTz(box->period.upper) / 2);
+  return;
+}
+
+/**
+ * @brief Comparator of the GiST sortsupport method for temporal boxes
+ */
+static int
+tbox_gist_cmp(Datum x, Datum y, SortSupport ssup)
+{
+  uint64 p1[2], p2[2];
+  tbox_zorder_point(DatumGetTboxP(x), p1);
+  tbox_zorder_point(DatumGetTboxP(y), p2);
+  return zorder_cmp(p1, p2, 2);
+}
+
+PGDLLEXPORT Datum Tbox_gist_sortsupport(PG_FUNCTION_ARGS);
+PG_FUNCTION_INFO_V1(Tbox_gist_sortsupport);
+/**
+ * @brief GiST sortsupport method for temporal numbers
+ * @details The boxes are sorted by the position of their center on a Z-order
+ * curve on the value and time dimensions, which enables the sorted build of
+ * GiST indexes available since PostgreSQL 14. This is much faster than
+ * inserting the boxes one by one and produces well-clustered leaf pages.
+ */
+Datum
+Tbox_gist_sortsupport(PG_FUNCTION_ARGS)
+{
+  SortSupport ssup = (SortSupport) PG_GETARG_POINTER(0);
+  ssup->comparator = tbox_gist_cmp;
+  PG_RETURN_VOID();
+}
+
 /*****************************************************************************
  * GiST same method
  *****************************************************************************/
@@ -639,7 +639,7 @@ distance_tbox_nodebox(const TBox *query, const TboxNode *nodebox)
 /**
  * @brief Transform a query argument into a temporal box
  */
-static bool
+bool
 tnumber_spgist_get_tbox(const ScanKeyData *scankey, TBox *result)
 {
   Span *s;
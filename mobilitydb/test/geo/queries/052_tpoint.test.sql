@@ -556,6 +556,10 @@ SELECT asText(setInterp(tgeompoint 'Interp=Step;[Point(1 1)@2000-01-01]', 'linea
 SELECT asText(setInterp(tgeompoint 'Interp=Step;[Point(1 1)@2000-01-01, Point(2 2)@2000-01-02, Point(1 1)@2000-01-03, Point(2 2)@2000-01-04]', 'linear'));
 SELECT asText(setInterp(tgeompoint 'Interp=Step;{[Point(1 1)@2000-01-01, Point(2 2)@2000-01-02, Point(1 1)@2000-01-03, Point(2 2)@2000-01-04], [Point(3 3)@2000-01-05, Point(4 4)@2000-01-06]}', 'linear'));
 
+-- Precision of step temporal points, whose values are passed by reference
+SELECT asText(tprecision(tgeompoint 'Interp=Step;[Point(1 1)@2001-01-01 00:00:00, Point(2 2)@2001-01-01 12:00:00, Point(3 3)@2001-01-02 12:00:00, Point(4 4)@2001-01-03 00:00:00]', '1 day', '2001-01-01'));
+SELECT asText(tprecision(tgeompoint 'Interp=Step;{[Point(1 1)@2001-01-01 00:00:00, Point(2 2)@2001-01-01 06:00:00, Point(2 2)@2001-01-01 12:00:00], [Point(3 3)@2001-01-02 00:00:00, Point(4 4)@2001-01-02 12:00:00, Point(4 4)@2001-01-03 06:00:00]}', '1 day', '2001-01-01'));
+
 -------------------------------------------------------------------------------
 -- Modification functions
 -------------------------------------------------------------------------------
@@ -70,4 +70,23 @@ SELECT DISTINCT tgeogpointFromEWKB(asEWKB(temp)) = temp FROM tbl_tgeogpoint;
 SELECT DISTINCT tgeompointFromHexEWKB(asHexEWKB(temp)) = temp FROM tbl_tgeompoint;
 SELECT DISTINCT tgeogpointFromHexEWKB(asHexEWKB(temp)) = temp FROM tbl_tgeogpoint;
 
+SELECT DISTINCT tgeompointFromCompressed(asCompressed(temp)) = temp FROM tbl_tgeompoint;
+SELECT DISTINCT tgeogpointFromCompressed(asCompressed(temp)) = temp FROM tbl_tgeogpoint;
+SELECT DISTINCT tgeompointFromCompressed(asCompressed(temp)) = temp FROM tbl_tgeompoint3D;
+SELECT DISTINCT tgeogpointFromCompressed(asCompressed(temp)) = temp FROM tbl_tgeogpoint3D;
+
+-- The bounding box is read from the header of the compressed representation
+SELECT DISTINCT compressedTimeSpan(asCompressed(temp)) = timeSpan(temp) FROM tbl_tgeompoint;
+SELECT DISTINCT compressedTimeSpan(asCompressed(temp)) = timeSpan(temp) FROM tbl_tgeogpoint;
+SELECT DISTINCT compressedStbox(asCompressed(temp)) = stbox(temp) FROM tbl_tgeompoint;
+SELECT DISTINCT compressedStbox(asCompressed(temp)) = stbox(temp) FROM tbl_tgeogpoint;
+SELECT DISTINCT compressedStbox(asCompressed(temp)) = stbox(temp) FROM tbl_tgeompoint3D;
+SELECT DISTINCT compressedStbox(asCompressed(temp)) = stbox(temp) FROM tbl_tgeogpoint3D;
+
+-- Truncated and corrupt compressed representations
+SELECT tgeompointFromCompressed(substring(b FROM 1 FOR length(b) - 1)) FROM asCompressed(tgeompoint '[Point(1 1)@2000-01-01, Point(2 2)@2000-01-02]') AS b;
+SELECT tgeogpointFromCompressed(substring(b FROM 1 FOR length(b) - 1)) FROM asCompressed(tgeogpoint 'Point Z(1 1 1)@2000-01-01') AS b;
+SELECT tgeogpointFromCompressed(asCompressed(tgeompoint 'Point(1 1)@2000-01-01'));
+SELECT compressedStbox(asCompressed(tint '1@2000-01-01'));
+
 -------------------------------------------------------------------------------
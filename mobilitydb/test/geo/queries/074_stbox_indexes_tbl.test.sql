@@ -0,0 +1,334 @@
+-------------------------------------------------------------------------------
+--
+-- This MobilityDB code is provided under The PostgreSQL License.
+-- Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+-- contributors
+--
+-- MobilityDB includes portions of PostGIS version 3 source code released
+-- under the GNU General Public License (GPLv2 or later).
+-- Copyright (c) 2001-2025, PostGIS contributors
+--
+-- Permission to use, copy, modify, and distribute this software and its
+-- documentation for any purpose, without fee, and without a written
+-- agreement is hereby granted, provided that the above copyright notice and
+-- this paragraph and the following two paragraphs appear in all copies.
+--
+-- IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+-- DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+-- LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+-- EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+-- OF SUCH DAMAGE.
+--
+-- UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+-- INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+-- AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+-- AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+-- PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+--
+-------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------
+-- GiST indexes on stbox values. From PostgreSQL 14 on, the index is built by
+-- sorting the keys with the sortsupport function of the operator class and
+-- packing the leaf pages, instead of inserting the keys one by one. The
+-- results of the queries must be the same with and without the index.
+-------------------------------------------------------------------------------
+
+DROP TABLE IF EXISTS tbl_stbox_sort;
+CREATE TABLE tbl_stbox_sort AS
+SELECT k, format('STBOX XT(((%s,%s),(%s,%s)),[%s,%s])', x, y, x + k % 7 + 1,
+  y + k % 5 + 1, timestamptz '2001-01-01' + t * interval '1 hour',
+  timestamptz '2001-01-01' + (t + k % 11 + 1) * interval '1 hour')::stbox AS b
+FROM ( SELECT k, (k * 7919) % 1000 AS x, (k * 6007) % 1000 AS y,
+  (k * 104729) % 8000 AS t FROM generate_series(1, 10000) AS k ) AS s;
+ANALYZE tbl_stbox_sort;
+
+DROP TABLE IF EXISTS test_idxops;
+CREATE TABLE test_idxops(
+  op CHAR(3),
+  leftarg TEXT,
+  rightarg TEXT,
+  no_idx TEXT,
+  rtree_idx TEXT
+);
+
+-------------------------------------------------------------------------------
+-- Without index
+-------------------------------------------------------------------------------
+
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b && stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b @> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b <@ stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b ~= stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b -|- stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b << stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b &< stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '>>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b >> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b &> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<|', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b <<| stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<|', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b &<| stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '|>>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b |>> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '|&>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b |&> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b <<# stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b &<# stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b #>> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox_sort WHERE b #&> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '|=|', 'stbox', 'stbox', array_agg(d ORDER BY d) FROM (
+  SELECT round((b |=| stbox 'STBOX XT(((1100,1100),(1200,1200)),[2001-03-01,2001-05-01])')::numeric, 6) AS d FROM tbl_stbox_sort
+  ORDER BY b |=| stbox 'STBOX XT(((1100,1100),(1200,1200)),[2001-03-01,2001-05-01])' LIMIT 10 ) AS t;
+
+-------------------------------------------------------------------------------
+-- R-tree index built by sorting the keys with the sortsupport function
+-------------------------------------------------------------------------------
+
+CREATE INDEX tbl_stbox_sort_rtree_idx ON tbl_stbox_sort USING GIST(b);
+SET enable_seqscan = off;
+
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b && stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&&' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b @> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '@>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b <@ stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '<@' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b ~= stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '~=' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b -|- stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '-|-' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b << stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '<<' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b &< stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&<' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b >> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '>>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b &> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b <<| stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '<<|' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b &<| stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&<|' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b |>> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '|>>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b |&> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '|&>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b <<# stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '<<#' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b &<# stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&<#' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b #>> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '#>>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox_sort WHERE b #&> stbox 'STBOX XT(((100,100),(300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '#&>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT array_agg(d ORDER BY d) FROM (
+  SELECT round((b |=| stbox 'STBOX XT(((1100,1100),(1200,1200)),[2001-03-01,2001-05-01])')::numeric, 6) AS d FROM tbl_stbox_sort
+  ORDER BY b |=| stbox 'STBOX XT(((1100,1100),(1200,1200)),[2001-03-01,2001-05-01])' LIMIT 10 ) AS t )
+WHERE op = '|=|' AND leftarg = 'stbox' AND rightarg = 'stbox';
+
+SET enable_seqscan = on;
+
+-------------------------------------------------------------------------------
+
+SELECT * FROM test_idxops
+WHERE no_idx <> rtree_idx OR no_idx IS NULL OR rtree_idx IS NULL
+ORDER BY op, leftarg, rightarg;
+
+DROP TABLE test_idxops;
+DROP TABLE tbl_stbox_sort;
+
+-------------------------------------------------------------------------------
+
+DROP TABLE IF EXISTS tbl_stbox3d_sort;
+CREATE TABLE tbl_stbox3d_sort AS
+SELECT k, format('STBOX ZT(((%s,%s,%s),(%s,%s,%s)),[%s,%s])', x, y, z,
+  x + k % 7 + 1, y + k % 5 + 1, z + k % 3 + 1,
+  timestamptz '2001-01-01' + t * interval '1 hour',
+  timestamptz '2001-01-01' + (t + k % 11 + 1) * interval '1 hour')::stbox AS b
+FROM ( SELECT k, (k * 7919) % 1000 AS x, (k * 6007) % 1000 AS y,
+  (k * 3001) % 1000 AS z, (k * 104729) % 8000 AS t
+  FROM generate_series(1, 10000) AS k ) AS s;
+ANALYZE tbl_stbox3d_sort;
+
+DROP TABLE IF EXISTS test_idxops;
+CREATE TABLE test_idxops(
+  op CHAR(3),
+  leftarg TEXT,
+  rightarg TEXT,
+  no_idx TEXT,
+  rtree_idx TEXT
+);
+
+-------------------------------------------------------------------------------
+-- Without index
+-------------------------------------------------------------------------------
+
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b && stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b @> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b <@ stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b ~= stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b -|- stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b << stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b &< stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '>>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b >> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b &> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<|', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b <<| stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<|', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b &<| stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '|>>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b |>> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '|&>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b |&> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b <<# stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b &<# stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b #>> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b #&> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<</', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b <</ stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&</', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b &</ stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '/>>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b />> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '/&>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox3d_sort WHERE b /&> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '|=|', 'stbox', 'stbox', array_agg(d ORDER BY d) FROM (
+  SELECT round((b |=| stbox 'STBOX ZT(((1100,1100,1100),(1200,1200,1200)),[2001-03-01,2001-05-01])')::numeric, 6) AS d FROM tbl_stbox3d_sort
+  ORDER BY b |=| stbox 'STBOX ZT(((1100,1100,1100),(1200,1200,1200)),[2001-03-01,2001-05-01])' LIMIT 10 ) AS t;
+
+-------------------------------------------------------------------------------
+-- R-tree index built by sorting the keys with the sortsupport function
+-------------------------------------------------------------------------------
+
+CREATE INDEX tbl_stbox3d_sort_rtree_idx ON tbl_stbox3d_sort USING GIST(b);
+SET enable_seqscan = off;
+
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b && stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&&' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b @> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '@>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b <@ stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '<@' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b ~= stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '~=' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b -|- stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '-|-' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b << stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '<<' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b &< stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&<' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b >> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '>>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b &> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b <<| stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '<<|' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b &<| stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&<|' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b |>> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '|>>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b |&> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '|&>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b <<# stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '<<#' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b &<# stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&<#' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b #>> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '#>>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b #&> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '#&>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b <</ stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '<</' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b &</ stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '&</' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b />> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '/>>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_stbox3d_sort WHERE b /&> stbox 'STBOX ZT(((100,100,100),(300,300,300)),[2001-03-01,2001-05-01])' )
+WHERE op = '/&>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT array_agg(d ORDER BY d) FROM (
+  SELECT round((b |=| stbox 'STBOX ZT(((1100,1100,1100),(1200,1200,1200)),[2001-03-01,2001-05-01])')::numeric, 6) AS d FROM tbl_stbox3d_sort
+  ORDER BY b |=| stbox 'STBOX ZT(((1100,1100,1100),(1200,1200,1200)),[2001-03-01,2001-05-01])' LIMIT 10 ) AS t )
+WHERE op = '|=|' AND leftarg = 'stbox' AND rightarg = 'stbox';
+
+SET enable_seqscan = on;
+
+-------------------------------------------------------------------------------
+
+SELECT * FROM test_idxops
+WHERE no_idx <> rtree_idx OR no_idx IS NULL OR rtree_idx IS NULL
+ORDER BY op, leftarg, rightarg;
+
+DROP TABLE test_idxops;
+DROP TABLE tbl_stbox3d_sort;
+
+-------------------------------------------------------------------------------
+
@@ -0,0 +1,363 @@
+-------------------------------------------------------------------------------
+--
+-- This MobilityDB code is provided under The PostgreSQL License.
+-- Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+-- contributors
+--
+-- MobilityDB includes portions of PostGIS version 3 source code released
+-- under the GNU General Public License (GPLv2 or later).
+-- Copyright (c) 2001-2025, PostGIS contributors
+--
+-- Permission to use, copy, modify, and distribute this software and its
+-- documentation for any purpose, without fee, and without a written
+-- agreement is hereby granted, provided that the above copyright notice and
+-- this paragraph and the following two paragraphs appear in all copies.
+--
+-- IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+-- DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+-- LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+-- EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+-- OF SUCH DAMAGE.
+--
+-- UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+-- INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+-- AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+-- AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+-- PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+--
+-------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------
+-- BRIN indexes on temporal points and spatiotemporal boxes. The results of the queries using the index, forced
+-- by disabling sequential scans, must be the same as those without the
+-- index.
+-------------------------------------------------------------------------------
+
+ANALYZE tbl_tgeompoint3D_big;
+ANALYZE tbl_tgeogpoint3D_big;
+ANALYZE tbl_stbox;
+
+DROP INDEX IF EXISTS tbl_tgeompoint3D_big_brin_idx;
+DROP INDEX IF EXISTS tbl_tgeogpoint3D_big_brin_idx;
+DROP INDEX IF EXISTS tbl_stbox_brin_idx;
+
+DROP TABLE IF EXISTS test_idxops;
+CREATE TABLE test_idxops(
+  op CHAR(3),
+  leftarg TEXT,
+  rightarg TEXT,
+  no_idx BIGINT,
+  brin_idx BIGINT
+);
+
+-------------------------------------------------------------------------------
+-- Without index
+-------------------------------------------------------------------------------
+
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tgeompoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tgeompoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tgeompoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tgeompoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tgeompoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'tgeompoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'tgeompoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'tgeompoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'tgeompoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tgeogpoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tgeogpoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tgeogpoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tgeogpoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tgeogpoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'tgeogpoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'tgeogpoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'tgeogpoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'tgeogpoint3D', 'tstzspan', COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp && stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp @> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <@ stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp ~= stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp -|- stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp << stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &< stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '>>', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp >> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&>', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <<# stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &<# stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp #>> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp #&> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<|', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <<| stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<|', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &<| stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '|>>', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp |>> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '|&>', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp |&> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<</', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <</ stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&</', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &</ stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '/>>', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp />> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '/&>', 'tgeompoint3D', 'stbox', COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp /&> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b && stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b @> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b <@ stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b ~= stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b -|- stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b << stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b &< stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '>>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b >> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b &> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b <<# stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b &<# stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b #>> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b #&> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<|', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b <<| stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<|', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b &<| stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '|>>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b |>> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '|&>', 'stbox', 'stbox', COUNT(*) FROM tbl_stbox WHERE b |&> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])';
+
+-------------------------------------------------------------------------------
+-- With index
+-------------------------------------------------------------------------------
+
+CREATE INDEX tbl_tgeompoint3D_big_brin_idx ON tbl_tgeompoint3D_big USING BRIN(temp);
+CREATE INDEX tbl_tgeogpoint3D_big_brin_idx ON tbl_tgeogpoint3D_big USING BRIN(temp);
+CREATE INDEX tbl_stbox_brin_idx ON tbl_stbox USING BRIN(b);
+
+SET enable_seqscan = off;
+
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&&' AND leftarg = 'tgeompoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '@>' AND leftarg = 'tgeompoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<@' AND leftarg = 'tgeompoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '~=' AND leftarg = 'tgeompoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '-|-' AND leftarg = 'tgeompoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<<#' AND leftarg = 'tgeompoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&<#' AND leftarg = 'tgeompoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#>>' AND leftarg = 'tgeompoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#&>' AND leftarg = 'tgeompoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&&' AND leftarg = 'tgeogpoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '@>' AND leftarg = 'tgeogpoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<@' AND leftarg = 'tgeogpoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '~=' AND leftarg = 'tgeogpoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '-|-' AND leftarg = 'tgeogpoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<<#' AND leftarg = 'tgeogpoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&<#' AND leftarg = 'tgeogpoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#>>' AND leftarg = 'tgeogpoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeogpoint3D_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#&>' AND leftarg = 'tgeogpoint3D' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp && stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&&' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp @> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '@>' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <@ stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '<@' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp ~= stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '~=' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp -|- stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '-|-' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp << stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '<<' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &< stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&<' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp >> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '>>' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&>' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <<# stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '<<#' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &<# stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&<#' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp #>> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '#>>' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp #&> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '#&>' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <<| stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '<<|' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &<| stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&<|' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp |>> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '|>>' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp |&> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '|&>' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp <</ stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '<</' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp &</ stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&</' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp />> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '/>>' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tgeompoint3D_big WHERE temp /&> stbox 'STBOX ZT(((1,1,1),(50,50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '/&>' AND leftarg = 'tgeompoint3D' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b && stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&&' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b @> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '@>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b <@ stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '<@' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b ~= stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '~=' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b -|- stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '-|-' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b << stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '<<' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b &< stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&<' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b >> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '>>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b &> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b <<# stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '<<#' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b &<# stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&<#' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b #>> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '#>>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b #&> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '#&>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b <<| stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '<<|' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b &<| stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '&<|' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b |>> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '|>>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_stbox WHERE b |&> stbox 'STBOX XT(((1,1),(50,50)),[2001-01-01,2001-02-01])' )
+WHERE op = '|&>' AND leftarg = 'stbox' AND rightarg = 'stbox';
+
+SET enable_seqscan = on;
+
+DROP INDEX tbl_tgeompoint3D_big_brin_idx;
+DROP INDEX tbl_tgeogpoint3D_big_brin_idx;
+DROP INDEX tbl_stbox_brin_idx;
+
+-------------------------------------------------------------------------------
+
+SELECT * FROM test_idxops
+WHERE no_idx <> brin_idx OR no_idx IS NULL OR brin_idx IS NULL
+ORDER BY op, leftarg, rightarg;
+
+DROP TABLE test_idxops;
+
+-------------------------------------------------------------------------------
@@ -228,3 +228,58 @@ SELECT k%2, numValues(setUnion(t)) FROM tbl_textset GROUP BY k%2 ORDER BY k%2;
 SELECT k%2, numValues(setUnion(d)) FROM tbl_dateset GROUP BY k%2 ORDER BY k%2;
 
 -------------------------------------------------------------------------------
+-- Parallel aggregation
+-- The results are compared with those of the serial aggregation
+
+DROP TABLE IF EXISTS tbl_setunion;
+DROP TABLE IF EXISTS tbl_setunion_serial;
+DROP TABLE IF EXISTS tbl_setunion_serial_group;
+
+-- Many duplicates and negative values, more than 64 distinct values
+CREATE TABLE tbl_setunion AS
+SELECT k, k % 1000 - 500 AS i, (k % 3000 - 1500)::bigint * 1000000007 AS b,
+  'text' || k % 700 AS t, date '2000-01-01' + k % 800 - 400 AS d,
+  timestamptz '2000-01-01' + (k % 900 - 450) * interval '1 min' AS tz
+FROM generate_series(1, 100000) AS k;
+ANALYZE tbl_setunion;
+
+SET max_parallel_workers_per_gather = 0;
+CREATE TABLE tbl_setunion_serial AS
+SELECT setUnion(i) AS i, setUnion(b) AS b, setUnion(t) AS t, setUnion(d) AS d,
+  setUnion(tz) AS tz
+FROM tbl_setunion;
+CREATE TABLE tbl_setunion_serial_group AS
+SELECT k % 7 AS k, setUnion(i) AS i, setUnion(b) AS b, setUnion(t) AS t, setUnion(d) AS d,
+  setUnion(tz) AS tz
+FROM tbl_setunion GROUP BY k % 7;
+RESET max_parallel_workers_per_gather;
+
+SET parallel_setup_cost = 0;
+SET parallel_tuple_cost = 0;
+SET min_parallel_table_scan_size = 0;
+
+SELECT numValues(i) AS i, numValues(b) AS b, numValues(t) AS t,
+  numValues(d) AS d, numValues(tz) AS tz
+FROM tbl_setunion_serial;
+WITH p AS (
+  SELECT setUnion(i) AS i, setUnion(b) AS b, setUnion(t) AS t, setUnion(d) AS d,
+  setUnion(tz) AS tz
+  FROM tbl_setunion )
+SELECT COUNT(*) FROM tbl_setunion_serial s, p
+WHERE s.i <> p.i OR s.b <> p.b OR s.t <> p.t OR s.d <> p.d OR s.tz <> p.tz;
+WITH p AS (
+  SELECT k % 7 AS k, setUnion(i) AS i, setUnion(b) AS b, setUnion(t) AS t, setUnion(d) AS d,
+  setUnion(tz) AS tz
+  FROM tbl_setunion GROUP BY k % 7 )
+SELECT COUNT(*) FROM tbl_setunion_serial_group s, p
+WHERE s.k = p.k AND (s.i <> p.i OR s.b <> p.b OR s.t <> p.t OR s.d <> p.d OR s.tz <> p.tz);
+
+RESET parallel_setup_cost;
+RESET parallel_tuple_cost;
+RESET min_parallel_table_scan_size;
+
+DROP TABLE tbl_setunion;
+DROP TABLE tbl_setunion_serial;
+DROP TABLE tbl_setunion_serial_group;
+
+-------------------------------------------------------------------------------
@@ -291,6 +291,8 @@ SELECT tstzspanset '{[2000-01-01, 2000-01-03]}' - tstzspan '[2000-01-01, 2000-01
 SELECT tstzspanset '{[2000-01-01, 2000-01-03],[2000-01-04, 2000-01-05]}' - tstzspanset '{[2000-01-01, 2000-01-03],[2000-01-04, 2000-01-05]}';
 SELECT tstzspanset '{[2000-01-01, 2000-01-03],[2000-01-04, 2000-01-05]}' - tstzspanset '{[2000-01-04, 2000-01-05]}';
 SELECT tstzspanset '{[2000-01-01, 2000-01-03],[2000-01-04, 2000-01-05]}' - tstzspanset '{[2000-01-01, 2000-01-03]}';
+SELECT tstzspanset '{[2000-01-02, 2000-01-03],[2000-01-04, 2000-01-05]}' - tstzspanset '{[2000-01-01, 2000-01-01 12:00:00],[2000-01-02 12:00:00, 2000-01-06]}';
+SELECT tstzspanset '{[2000-01-01, 2000-01-03],[2000-01-04, 2000-01-06]}' - tstzspanset '{[2000-01-02, 2000-01-05],[2000-01-07, 2000-01-08]}';
 
 -------------------------------------------------------------------------------
 
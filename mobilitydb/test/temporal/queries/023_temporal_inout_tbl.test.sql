@@ -80,4 +80,54 @@ SELECT COUNT(*) FROM tbl_tint WHERE temp IS NOT NULL AND tintFromHexWKB(asHexWKB
 SELECT COUNT(*) from tbl_tfloat WHERE temp IS NOT NULL AND tfloatFromHexWKB(asHexWKB(temp)) <> temp;
 SELECT COUNT(*) FROM tbl_ttext WHERE temp IS NOT NULL AND ttextFromHexWKB(asHexWKB(temp)) <> temp;
 
+SELECT COUNT(*) FROM tbl_tbool WHERE temp IS NOT NULL AND tboolFromCompressed(asCompressed(temp)) <> temp;
+SELECT COUNT(*) FROM tbl_tint WHERE temp IS NOT NULL AND tintFromCompressed(asCompressed(temp)) <> temp;
+SELECT COUNT(*) from tbl_tfloat WHERE temp IS NOT NULL AND tfloatFromCompressed(asCompressed(temp)) <> temp;
+SELECT COUNT(*) FROM tbl_ttext WHERE temp IS NOT NULL AND ttextFromCompressed(asCompressed(temp)) <> temp;
+
+-- The bounding box is read from the header of the compressed representation
+SELECT COUNT(*) FROM tbl_tbool WHERE temp IS NOT NULL AND compressedTimeSpan(asCompressed(temp)) <> timeSpan(temp);
+SELECT COUNT(*) FROM tbl_tint WHERE temp IS NOT NULL AND compressedTimeSpan(asCompressed(temp)) <> timeSpan(temp);
+SELECT COUNT(*) from tbl_tfloat WHERE temp IS NOT NULL AND compressedTimeSpan(asCompressed(temp)) <> timeSpan(temp);
+SELECT COUNT(*) FROM tbl_ttext WHERE temp IS NOT NULL AND compressedTimeSpan(asCompressed(temp)) <> timeSpan(temp);
+SELECT COUNT(*) FROM tbl_tint WHERE temp IS NOT NULL AND compressedTbox(asCompressed(temp)) <> tbox(temp);
+SELECT COUNT(*) from tbl_tfloat WHERE temp IS NOT NULL AND compressedTbox(asCompressed(temp)) <> tbox(temp);
+
+-- Temporal instants, whose bounding box is obtained by decoding the value
+SELECT compressedTimeSpan(asCompressed(tbool 't@2000-01-01'));
+SELECT compressedTimeSpan(asCompressed(ttext 'AAA@2000-01-01'));
+SELECT compressedTbox(asCompressed(tint '1@2000-01-01'));
+SELECT compressedTbox(asCompressed(tfloat '1.5@2000-01-01'));
+
+-- Encoding of an instant and round trips of each subtype
+SELECT asCompressed(tint '1@2000-01-01 00:00:00+00');
+SELECT tintFromCompressed(asCompressed(tint '{1@2000-01-01, 2@2000-01-02}'));
+SELECT tfloatFromCompressed(asCompressed(tfloat 'Interp=Step;[1.5@2000-01-01, 2.5@2000-01-02]'));
+SELECT ttextFromCompressed(asCompressed(ttext '{[AAA@2000-01-01, BBB@2000-01-02], [CCC@2000-01-03]}'));
+SELECT tboolFromCompressed(asCompressed(tbool '{[t@2000-01-01, f@2000-01-02], [t@2000-01-03]}'));
+
+-- Values stored out of line, of which only the header is fetched
+CREATE TABLE tbl_compressed(k int, b bytea);
+ALTER TABLE tbl_compressed ALTER COLUMN b SET STORAGE EXTERNAL;
+INSERT INTO tbl_compressed SELECT 1, asCompressed(tfloatSeq(array_agg(
+  tfloat((i % 2)::float, timestamptz '2000-01-01' + i * interval '1 minute') ORDER BY i)))
+FROM generate_series(1, 10000) AS i;
+INSERT INTO tbl_compressed VALUES (2, asCompressed(tint '1@2000-01-01'));
+SELECT k, compressedTimeSpan(b) FROM tbl_compressed ORDER BY k;
+SELECT k, compressedTbox(b) FROM tbl_compressed ORDER BY k;
+SELECT numInstants(tfloatFromCompressed(b)) FROM tbl_compressed WHERE k = 1;
+DROP TABLE tbl_compressed;
+
+-- Truncated and corrupt compressed representations
+SELECT tintFromCompressed('\x01'::bytea);
+SELECT tintFromCompressed(substring(asCompressed(tint '[1@2000-01-01, 2@2000-01-02]') FROM 1 FOR 20));
+SELECT tintFromCompressed(substring(b FROM 1 FOR length(b) - 1)) FROM asCompressed(tint '{[1@2000-01-01, 2@2000-01-02], [3@2000-01-03]}') AS b;
+SELECT ttextFromCompressed(substring(b FROM 1 FOR length(b) - 1)) FROM asCompressed(ttext '[AAA@2000-01-01, BBB@2000-01-02]') AS b;
+SELECT tintFromCompressed(set_byte(asCompressed(tint '1@2000-01-01'), 0, 2));
+SELECT tintFromCompressed(set_byte(asCompressed(tint '1@2000-01-01'), 2, 9));
+SELECT compressedTimeSpan('\x01'::bytea);
+SELECT compressedTimeSpan(substring(b FROM 1 FOR length(b) - 1)) FROM asCompressed(tint '1@2000-01-01') AS b;
+SELECT tintFromCompressed(asCompressed(tfloat '1.5@2000-01-01'));
+SELECT compressedTbox(asCompressed(tbool 't@2000-01-01'));
+
 ------------------------------------------------------------------------------
@@ -0,0 +1,145 @@
+-------------------------------------------------------------------------------
+--
+-- This MobilityDB code is provided under The PostgreSQL License.
+-- Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+-- contributors
+--
+-- MobilityDB includes portions of PostGIS version 3 source code released
+-- under the GNU General Public License (GPLv2 or later).
+-- Copyright (c) 2001-2025, PostGIS contributors
+--
+-- Permission to use, copy, modify, and distribute this software and its
+-- documentation for any purpose, without fee, and without a written
+-- agreement is hereby granted, provided that the above copyright notice and
+-- this paragraph and the following two paragraphs appear in all copies.
+--
+-- IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+-- DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+-- LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+-- EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+-- OF SUCH DAMAGE.
+--
+-- UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+-- INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+-- AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+-- AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+-- PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+--
+-------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------
+-- GiST indexes on tbox values. From PostgreSQL 14 on, the index is built by
+-- sorting the keys with the sortsupport function of the operator class and
+-- packing the leaf pages, instead of inserting the keys one by one. The
+-- results of the queries must be the same with and without the index.
+-------------------------------------------------------------------------------
+
+DROP TABLE IF EXISTS tbl_tbox_sort;
+CREATE TABLE tbl_tbox_sort AS
+SELECT k, format('TBOXFLOAT XT([%s,%s],[%s,%s])', x, x + k % 7 + 1,
+  timestamptz '2001-01-01' + t * interval '1 hour',
+  timestamptz '2001-01-01' + (t + k % 11 + 1) * interval '1 hour')::tbox AS b
+FROM ( SELECT k, (k * 7919) % 1000 AS x, (k * 104729) % 8000 AS t
+  FROM generate_series(1, 10000) AS k ) AS s;
+ANALYZE tbl_tbox_sort;
+
+DROP TABLE IF EXISTS test_idxops;
+CREATE TABLE test_idxops(
+  op CHAR(3),
+  leftarg TEXT,
+  rightarg TEXT,
+  no_idx TEXT,
+  rtree_idx TEXT
+);
+
+-------------------------------------------------------------------------------
+-- Without index
+-------------------------------------------------------------------------------
+
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b && tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b @> tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b <@ tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b ~= tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b -|- tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b << tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b &< tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '>>', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b >> tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&>', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b &> tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b <<# tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b &<# tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b #>> tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'tbox', 'tbox', COUNT(*) FROM tbl_tbox_sort WHERE b #&> tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])';
+
+-------------------------------------------------------------------------------
+-- R-tree index built by sorting the keys with the sortsupport function
+-------------------------------------------------------------------------------
+
+CREATE INDEX tbl_tbox_sort_rtree_idx ON tbl_tbox_sort USING GIST(b);
+SET enable_seqscan = off;
+
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b && tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '&&' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b @> tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '@>' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b <@ tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '<@' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b ~= tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '~=' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b -|- tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '-|-' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b << tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '<<' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b &< tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '&<' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b >> tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '>>' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b &> tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '&>' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b <<# tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '<<#' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b &<# tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '&<#' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b #>> tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '#>>' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET rtree_idx = ( SELECT COUNT(*) FROM tbl_tbox_sort WHERE b #&> tbox 'TBOXFLOAT XT([100,300],[2001-03-01,2001-05-01])' )
+WHERE op = '#&>' AND leftarg = 'tbox' AND rightarg = 'tbox';
+
+SET enable_seqscan = on;
+
+-------------------------------------------------------------------------------
+
+SELECT * FROM test_idxops
+WHERE no_idx <> rtree_idx OR no_idx IS NULL OR rtree_idx IS NULL
+ORDER BY op, leftarg, rightarg;
+
+DROP TABLE test_idxops;
+DROP TABLE tbl_tbox_sort;
+
+-------------------------------------------------------------------------------
+
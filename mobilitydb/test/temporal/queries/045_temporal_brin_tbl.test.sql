@@ -0,0 +1,556 @@
+-------------------------------------------------------------------------------
+--
+-- This MobilityDB code is provided under The PostgreSQL License.
+-- Copyright (c) 2016-2025, Université libre de Bruxelles and MobilityDB
+-- contributors
+--
+-- MobilityDB includes portions of PostGIS version 3 source code released
+-- under the GNU General Public License (GPLv2 or later).
+-- Copyright (c) 2001-2025, PostGIS contributors
+--
+-- Permission to use, copy, modify, and distribute this software and its
+-- documentation for any purpose, without fee, and without a written
+-- agreement is hereby granted, provided that the above copyright notice and
+-- this paragraph and the following two paragraphs appear in all copies.
+--
+-- IN NO EVENT SHALL UNIVERSITE LIBRE DE BRUXELLES BE LIABLE TO ANY PARTY FOR
+-- DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING
+-- LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION,
+-- EVEN IF UNIVERSITE LIBRE DE BRUXELLES HAS BEEN ADVISED OF THE POSSIBILITY
+-- OF SUCH DAMAGE.
+--
+-- UNIVERSITE LIBRE DE BRUXELLES SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+-- INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+-- AND FITNESS FOR A PARTICULAR PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON
+-- AN "AS IS" BASIS, AND UNIVERSITE LIBRE DE BRUXELLES HAS NO OBLIGATIONS TO
+-- PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+--
+-------------------------------------------------------------------------------
+
+-------------------------------------------------------------------------------
+-- BRIN indexes on temporal values and temporal boxes. The results of the queries using the index, forced
+-- by disabling sequential scans, must be the same as those without the
+-- index.
+-------------------------------------------------------------------------------
+
+ANALYZE tbl_tbool_big;
+ANALYZE tbl_tint_big;
+ANALYZE tbl_tfloat_big;
+ANALYZE tbl_ttext_big;
+ANALYZE tbl_tboxfloat;
+
+DROP INDEX IF EXISTS tbl_tbool_big_brin_idx;
+DROP INDEX IF EXISTS tbl_tint_big_brin_idx;
+DROP INDEX IF EXISTS tbl_tfloat_big_brin_idx;
+DROP INDEX IF EXISTS tbl_ttext_big_brin_idx;
+DROP INDEX IF EXISTS tbl_tboxfloat_brin_idx;
+
+DROP TABLE IF EXISTS test_idxops;
+CREATE TABLE test_idxops(
+  op CHAR(3),
+  leftarg TEXT,
+  rightarg TEXT,
+  no_idx BIGINT,
+  brin_idx BIGINT
+);
+
+-------------------------------------------------------------------------------
+-- Without index
+-------------------------------------------------------------------------------
+
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tbool', 'tstzspan', COUNT(*) FROM tbl_tbool_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tbool', 'tstzspan', COUNT(*) FROM tbl_tbool_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tbool', 'tstzspan', COUNT(*) FROM tbl_tbool_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tbool', 'tstzspan', COUNT(*) FROM tbl_tbool_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tbool', 'tstzspan', COUNT(*) FROM tbl_tbool_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'tbool', 'tstzspan', COUNT(*) FROM tbl_tbool_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'tbool', 'tstzspan', COUNT(*) FROM tbl_tbool_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'tbool', 'tstzspan', COUNT(*) FROM tbl_tbool_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'tbool', 'tstzspan', COUNT(*) FROM tbl_tbool_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tint', 'tstzspan', COUNT(*) FROM tbl_tint_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tint', 'tstzspan', COUNT(*) FROM tbl_tint_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tint', 'tstzspan', COUNT(*) FROM tbl_tint_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tint', 'tstzspan', COUNT(*) FROM tbl_tint_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tint', 'tstzspan', COUNT(*) FROM tbl_tint_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'tint', 'tstzspan', COUNT(*) FROM tbl_tint_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'tint', 'tstzspan', COUNT(*) FROM tbl_tint_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'tint', 'tstzspan', COUNT(*) FROM tbl_tint_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'tint', 'tstzspan', COUNT(*) FROM tbl_tint_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tfloat', 'tstzspan', COUNT(*) FROM tbl_tfloat_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tfloat', 'tstzspan', COUNT(*) FROM tbl_tfloat_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tfloat', 'tstzspan', COUNT(*) FROM tbl_tfloat_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tfloat', 'tstzspan', COUNT(*) FROM tbl_tfloat_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tfloat', 'tstzspan', COUNT(*) FROM tbl_tfloat_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'tfloat', 'tstzspan', COUNT(*) FROM tbl_tfloat_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'tfloat', 'tstzspan', COUNT(*) FROM tbl_tfloat_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'tfloat', 'tstzspan', COUNT(*) FROM tbl_tfloat_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'tfloat', 'tstzspan', COUNT(*) FROM tbl_tfloat_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'ttext', 'tstzspan', COUNT(*) FROM tbl_ttext_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'ttext', 'tstzspan', COUNT(*) FROM tbl_ttext_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'ttext', 'tstzspan', COUNT(*) FROM tbl_ttext_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'ttext', 'tstzspan', COUNT(*) FROM tbl_ttext_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'ttext', 'tstzspan', COUNT(*) FROM tbl_ttext_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'ttext', 'tstzspan', COUNT(*) FROM tbl_ttext_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'ttext', 'tstzspan', COUNT(*) FROM tbl_ttext_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'ttext', 'tstzspan', COUNT(*) FROM tbl_ttext_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'ttext', 'tstzspan', COUNT(*) FROM tbl_ttext_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tint', 'intspan', COUNT(*) FROM tbl_tint_big WHERE temp && intspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tint', 'intspan', COUNT(*) FROM tbl_tint_big WHERE temp @> intspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tint', 'intspan', COUNT(*) FROM tbl_tint_big WHERE temp <@ intspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tint', 'intspan', COUNT(*) FROM tbl_tint_big WHERE temp ~= intspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tint', 'intspan', COUNT(*) FROM tbl_tint_big WHERE temp -|- intspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<', 'tint', 'intspan', COUNT(*) FROM tbl_tint_big WHERE temp << intspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<', 'tint', 'intspan', COUNT(*) FROM tbl_tint_big WHERE temp &< intspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '>>', 'tint', 'intspan', COUNT(*) FROM tbl_tint_big WHERE temp >> intspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&>', 'tint', 'intspan', COUNT(*) FROM tbl_tint_big WHERE temp &> intspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp && tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp @> tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp <@ tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp ~= tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp -|- tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp << tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp &< tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '>>', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp >> tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&>', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp &> tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp <<# tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp &<# tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp #>> tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'tint', 'tbox', COUNT(*) FROM tbl_tint_big WHERE temp #&> tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tfloat', 'floatspan', COUNT(*) FROM tbl_tfloat_big WHERE temp && floatspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tfloat', 'floatspan', COUNT(*) FROM tbl_tfloat_big WHERE temp @> floatspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tfloat', 'floatspan', COUNT(*) FROM tbl_tfloat_big WHERE temp <@ floatspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tfloat', 'floatspan', COUNT(*) FROM tbl_tfloat_big WHERE temp ~= floatspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tfloat', 'floatspan', COUNT(*) FROM tbl_tfloat_big WHERE temp -|- floatspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<', 'tfloat', 'floatspan', COUNT(*) FROM tbl_tfloat_big WHERE temp << floatspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<', 'tfloat', 'floatspan', COUNT(*) FROM tbl_tfloat_big WHERE temp &< floatspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '>>', 'tfloat', 'floatspan', COUNT(*) FROM tbl_tfloat_big WHERE temp >> floatspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&>', 'tfloat', 'floatspan', COUNT(*) FROM tbl_tfloat_big WHERE temp &> floatspan '[1,50]';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp && tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp @> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp <@ tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp ~= tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp -|- tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp << tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp &< tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '>>', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp >> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&>', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp &> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp <<# tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp &<# tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp #>> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'tfloat', 'tbox', COUNT(*) FROM tbl_tfloat_big WHERE temp #&> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&&', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b && tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '@>', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b @> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<@', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b <@ tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '~=', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b ~= tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '-|-', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b -|- tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b << tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b &< tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '>>', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b >> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&>', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b &> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '<<#', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b <<# tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '&<#', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b &<# tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#>>', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b #>> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+INSERT INTO test_idxops(op, leftarg, rightarg, no_idx)
+SELECT '#&>', 'tbox', 'tbox', COUNT(*) FROM tbl_tboxfloat WHERE b #&> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])';
+
+-------------------------------------------------------------------------------
+-- With index
+-------------------------------------------------------------------------------
+
+CREATE INDEX tbl_tbool_big_brin_idx ON tbl_tbool_big USING BRIN(temp);
+CREATE INDEX tbl_tint_big_brin_idx ON tbl_tint_big USING BRIN(temp);
+CREATE INDEX tbl_tfloat_big_brin_idx ON tbl_tfloat_big USING BRIN(temp);
+CREATE INDEX tbl_ttext_big_brin_idx ON tbl_ttext_big USING BRIN(temp);
+CREATE INDEX tbl_tboxfloat_brin_idx ON tbl_tboxfloat USING BRIN(b);
+
+SET enable_seqscan = off;
+
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tbool_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&&' AND leftarg = 'tbool' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tbool_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '@>' AND leftarg = 'tbool' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tbool_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<@' AND leftarg = 'tbool' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tbool_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '~=' AND leftarg = 'tbool' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tbool_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '-|-' AND leftarg = 'tbool' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tbool_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<<#' AND leftarg = 'tbool' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tbool_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&<#' AND leftarg = 'tbool' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tbool_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#>>' AND leftarg = 'tbool' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tbool_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#&>' AND leftarg = 'tbool' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&&' AND leftarg = 'tint' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '@>' AND leftarg = 'tint' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<@' AND leftarg = 'tint' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '~=' AND leftarg = 'tint' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '-|-' AND leftarg = 'tint' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<<#' AND leftarg = 'tint' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&<#' AND leftarg = 'tint' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#>>' AND leftarg = 'tint' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#&>' AND leftarg = 'tint' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&&' AND leftarg = 'tfloat' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '@>' AND leftarg = 'tfloat' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<@' AND leftarg = 'tfloat' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '~=' AND leftarg = 'tfloat' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '-|-' AND leftarg = 'tfloat' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<<#' AND leftarg = 'tfloat' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&<#' AND leftarg = 'tfloat' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#>>' AND leftarg = 'tfloat' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#&>' AND leftarg = 'tfloat' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_ttext_big WHERE temp && tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&&' AND leftarg = 'ttext' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_ttext_big WHERE temp @> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '@>' AND leftarg = 'ttext' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_ttext_big WHERE temp <@ tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<@' AND leftarg = 'ttext' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_ttext_big WHERE temp ~= tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '~=' AND leftarg = 'ttext' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_ttext_big WHERE temp -|- tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '-|-' AND leftarg = 'ttext' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_ttext_big WHERE temp <<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '<<#' AND leftarg = 'ttext' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_ttext_big WHERE temp &<# tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '&<#' AND leftarg = 'ttext' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_ttext_big WHERE temp #>> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#>>' AND leftarg = 'ttext' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_ttext_big WHERE temp #&> tstzspan '[2001-01-01, 2001-02-01]' )
+WHERE op = '#&>' AND leftarg = 'ttext' AND rightarg = 'tstzspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp && intspan '[1,50]' )
+WHERE op = '&&' AND leftarg = 'tint' AND rightarg = 'intspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp @> intspan '[1,50]' )
+WHERE op = '@>' AND leftarg = 'tint' AND rightarg = 'intspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp <@ intspan '[1,50]' )
+WHERE op = '<@' AND leftarg = 'tint' AND rightarg = 'intspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp ~= intspan '[1,50]' )
+WHERE op = '~=' AND leftarg = 'tint' AND rightarg = 'intspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp -|- intspan '[1,50]' )
+WHERE op = '-|-' AND leftarg = 'tint' AND rightarg = 'intspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp << intspan '[1,50]' )
+WHERE op = '<<' AND leftarg = 'tint' AND rightarg = 'intspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp &< intspan '[1,50]' )
+WHERE op = '&<' AND leftarg = 'tint' AND rightarg = 'intspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp >> intspan '[1,50]' )
+WHERE op = '>>' AND leftarg = 'tint' AND rightarg = 'intspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp &> intspan '[1,50]' )
+WHERE op = '&>' AND leftarg = 'tint' AND rightarg = 'intspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp && tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&&' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp @> tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '@>' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp <@ tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '<@' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp ~= tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '~=' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp -|- tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '-|-' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp << tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '<<' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp &< tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&<' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp >> tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '>>' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp &> tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&>' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp <<# tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '<<#' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp &<# tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&<#' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp #>> tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '#>>' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tint_big WHERE temp #&> tbox 'TBOXINT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '#&>' AND leftarg = 'tint' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp && floatspan '[1,50]' )
+WHERE op = '&&' AND leftarg = 'tfloat' AND rightarg = 'floatspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp @> floatspan '[1,50]' )
+WHERE op = '@>' AND leftarg = 'tfloat' AND rightarg = 'floatspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp <@ floatspan '[1,50]' )
+WHERE op = '<@' AND leftarg = 'tfloat' AND rightarg = 'floatspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp ~= floatspan '[1,50]' )
+WHERE op = '~=' AND leftarg = 'tfloat' AND rightarg = 'floatspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp -|- floatspan '[1,50]' )
+WHERE op = '-|-' AND leftarg = 'tfloat' AND rightarg = 'floatspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp << floatspan '[1,50]' )
+WHERE op = '<<' AND leftarg = 'tfloat' AND rightarg = 'floatspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp &< floatspan '[1,50]' )
+WHERE op = '&<' AND leftarg = 'tfloat' AND rightarg = 'floatspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp >> floatspan '[1,50]' )
+WHERE op = '>>' AND leftarg = 'tfloat' AND rightarg = 'floatspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp &> floatspan '[1,50]' )
+WHERE op = '&>' AND leftarg = 'tfloat' AND rightarg = 'floatspan';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp && tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&&' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp @> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '@>' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp <@ tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '<@' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp ~= tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '~=' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp -|- tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '-|-' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp << tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '<<' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp &< tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&<' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp >> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '>>' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp &> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&>' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp <<# tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '<<#' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp &<# tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&<#' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp #>> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '#>>' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tfloat_big WHERE temp #&> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '#&>' AND leftarg = 'tfloat' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b && tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&&' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b @> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '@>' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b <@ tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '<@' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b ~= tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '~=' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b -|- tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '-|-' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b << tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '<<' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b &< tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&<' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b >> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '>>' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b &> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&>' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b <<# tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '<<#' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b &<# tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '&<#' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b #>> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '#>>' AND leftarg = 'tbox' AND rightarg = 'tbox';
+UPDATE test_idxops
+SET brin_idx = ( SELECT COUNT(*) FROM tbl_tboxfloat WHERE b #&> tbox 'TBOXFLOAT XT([1,50],[2001-01-01,2001-02-01])' )
+WHERE op = '#&>' AND leftarg = 'tbox' AND rightarg = 'tbox';
+
+SET enable_seqscan = on;
+
+DROP INDEX tbl_tbool_big_brin_idx;
+DROP INDEX tbl_tint_big_brin_idx;
+DROP INDEX tbl_tfloat_big_brin_idx;
+DROP INDEX tbl_ttext_big_brin_idx;
+DROP INDEX tbl_tboxfloat_brin_idx;
+
+-------------------------------------------------------------------------------
+
+SELECT * FROM test_idxops
+WHERE no_idx <> brin_idx OR no_idx IS NULL OR brin_idx IS NULL
+ORDER BY op, leftarg, rightarg;
+
+DROP TABLE test_idxops;
+
+-------------------------------------------------------------------------------
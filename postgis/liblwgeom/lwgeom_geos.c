@@ -36,8 +36,9 @@
 LWTIN* lwtin_from_geos(const GEOSGeometry* geom, uint8_t want3d);
 
 #define AUTOFIX LW_TRUE
-#define LWGEOM_GEOS_ERRMSG_MAXSIZE 256
+#if ! MEOS
 char lwgeom_geos_errmsg[LWGEOM_GEOS_ERRMSG_MAXSIZE];
+#endif
 
 const char *
 lwgeom_geos_compiled_version()
@@ -33,6 +33,129 @@ typedef void (*GEOSMessageHandler)(const char *fmt, ...) __attribute__ (( format
 #include "liblwgeom.h"
 #include "lwunionfind.h"
 
+#if MEOS
+/*
+** MEOS may be called by several threads, each of them with its own GEOS
+** context handle. The non-reentrant GEOS API used by liblwgeom and MEOS is
+** mapped to the reentrant API on the context handle of the calling thread,
+** which is created on first use and kept until the thread finalizes MEOS.
+*/
+extern GEOSContextHandle_t meos_geos_context(void);
+extern void meos_geos_init(GEOSMessageHandler notice, GEOSMessageHandler error);
+extern char *meos_geos_errmsg(void);
+
+#define initGEOS(notice, error) meos_geos_init(notice, error)
+#define finishGEOS() ((void) 0)
+#define GEOSBoundary(...) GEOSBoundary_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSBufferParams_create() GEOSBufferParams_create_r(meos_geos_context())
+#define GEOSBufferParams_destroy(...) GEOSBufferParams_destroy_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSBufferParams_setEndCapStyle(...) GEOSBufferParams_setEndCapStyle_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSBufferParams_setJoinStyle(...) GEOSBufferParams_setJoinStyle_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSBufferParams_setMitreLimit(...) GEOSBufferParams_setMitreLimit_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSBufferParams_setQuadrantSegments(...) GEOSBufferParams_setQuadrantSegments_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSBufferParams_setSingleSided(...) GEOSBufferParams_setSingleSided_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSBufferWithParams(...) GEOSBufferWithParams_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSBuildArea(...) GEOSBuildArea_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSClipByRect(...) GEOSClipByRect_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSConcaveHull(...) GEOSConcaveHull_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSConcaveHullOfPolygons(...) GEOSConcaveHullOfPolygons_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSConstrainedDelaunayTriangulation(...) GEOSConstrainedDelaunayTriangulation_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSContains(...) GEOSContains_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSConvexHull(...) GEOSConvexHull_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_copyFromBuffer(...) GEOSCoordSeq_copyFromBuffer_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_copyToBuffer(...) GEOSCoordSeq_copyToBuffer_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_create(...) GEOSCoordSeq_create_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_destroy(...) GEOSCoordSeq_destroy_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_getDimensions(...) GEOSCoordSeq_getDimensions_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_getSize(...) GEOSCoordSeq_getSize_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_getXY(...) GEOSCoordSeq_getXY_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_getXYZ(...) GEOSCoordSeq_getXYZ_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_setX(...) GEOSCoordSeq_setX_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_setXY(...) GEOSCoordSeq_setXY_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_setXYZ(...) GEOSCoordSeq_setXYZ_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_setY(...) GEOSCoordSeq_setY_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCoordSeq_setZ(...) GEOSCoordSeq_setZ_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSCovers(...) GEOSCovers_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSDelaunayTriangulation(...) GEOSDelaunayTriangulation_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSDifference(...) GEOSDifference_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSDifferencePrec(...) GEOSDifferencePrec_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSDistance(...) GEOSDistance_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSEquals(...) GEOSEquals_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSFree(...) GEOSFree_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeomGetEndPoint(...) GEOSGeomGetEndPoint_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeomGetLength(...) GEOSGeomGetLength_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeomGetPointN(...) GEOSGeomGetPointN_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeomGetStartPoint(...) GEOSGeomGetStartPoint_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeomGetX(...) GEOSGeomGetX_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeomGetY(...) GEOSGeomGetY_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeomToWKT(...) GEOSGeomToWKT_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeomTypeId(...) GEOSGeomTypeId_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeom_createCollection(...) GEOSGeom_createCollection_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeom_createEmptyLineString() GEOSGeom_createEmptyLineString_r(meos_geos_context())
+#define GEOSGeom_createEmptyPoint() GEOSGeom_createEmptyPoint_r(meos_geos_context())
+#define GEOSGeom_createEmptyPolygon() GEOSGeom_createEmptyPolygon_r(meos_geos_context())
+#define GEOSGeom_createLineString(...) GEOSGeom_createLineString_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeom_createLinearRing(...) GEOSGeom_createLinearRing_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeom_createPoint(...) GEOSGeom_createPoint_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeom_createPointFromXY(...) GEOSGeom_createPointFromXY_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeom_createPolygon(...) GEOSGeom_createPolygon_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeom_destroy(...) GEOSGeom_destroy_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeom_getCoordSeq(...) GEOSGeom_getCoordSeq_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGeom_setPrecision(...) GEOSGeom_setPrecision_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGetCentroid(...) GEOSGetCentroid_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGetExteriorRing(...) GEOSGetExteriorRing_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGetGeometryN(...) GEOSGetGeometryN_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGetInteriorRingN(...) GEOSGetInteriorRingN_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGetNumGeometries(...) GEOSGetNumGeometries_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGetNumInteriorRings(...) GEOSGetNumInteriorRings_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSGetSRID(...) GEOSGetSRID_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSHasZ(...) GEOSHasZ_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSIntersection(...) GEOSIntersection_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSIntersectionPrec(...) GEOSIntersectionPrec_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSIntersects(...) GEOSIntersects_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSLineMerge(...) GEOSLineMerge_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSLineMergeDirected(...) GEOSLineMergeDirected_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSMakeValid(...) GEOSMakeValid_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSMakeValidParams_create() GEOSMakeValidParams_create_r(meos_geos_context())
+#define GEOSMakeValidParams_destroy(...) GEOSMakeValidParams_destroy_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSMakeValidParams_setKeepCollapsed(...) GEOSMakeValidParams_setKeepCollapsed_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSMakeValidParams_setMethod(...) GEOSMakeValidParams_setMethod_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSMakeValidWithParams(...) GEOSMakeValidWithParams_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSMinimumRotatedRectangle(...) GEOSMinimumRotatedRectangle_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSNode(...) GEOSNode_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSNormalize(...) GEOSNormalize_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSOffsetCurve(...) GEOSOffsetCurve_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSPointOnSurface(...) GEOSPointOnSurface_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSPolygonHullSimplify(...) GEOSPolygonHullSimplify_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSPolygonize(...) GEOSPolygonize_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSPrepare(...) GEOSPrepare_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSPreparedCovers(...) GEOSPreparedCovers_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSPreparedGeom_destroy(...) GEOSPreparedGeom_destroy_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSPreparedIntersects(...) GEOSPreparedIntersects_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSPreparedIntersectsXY(...) GEOSPreparedIntersectsXY_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSRelatePattern(...) GEOSRelatePattern_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSSTRtree_create(...) GEOSSTRtree_create_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSSTRtree_destroy(...) GEOSSTRtree_destroy_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSSTRtree_insert(...) GEOSSTRtree_insert_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSSTRtree_query(...) GEOSSTRtree_query_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSSetSRID(...) GEOSSetSRID_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSSharedPaths(...) GEOSSharedPaths_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSSnap(...) GEOSSnap_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSSymDifference(...) GEOSSymDifference_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSSymDifferencePrec(...) GEOSSymDifferencePrec_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSTouches(...) GEOSTouches_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSUnaryUnion(...) GEOSUnaryUnion_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSUnaryUnionPrec(...) GEOSUnaryUnionPrec_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSUnion(...) GEOSUnion_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSUnionPrec(...) GEOSUnionPrec_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSVoronoiDiagram(...) GEOSVoronoiDiagram_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSWKTWriter_create() GEOSWKTWriter_create_r(meos_geos_context())
+#define GEOSWKTWriter_destroy(...) GEOSWKTWriter_destroy_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSWKTWriter_write(...) GEOSWKTWriter_write_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSisEmpty(...) GEOSisEmpty_r(meos_geos_context(), __VA_ARGS__)
+#define GEOSisSimple(...) GEOSisSimple_r(meos_geos_context(), __VA_ARGS__)
+#endif /* MEOS */
+
 /*
 ** Public prototypes for GEOS utility functions.
 */
@@ -49,7 +172,13 @@ int union_dbscan(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps,
 
 POINTARRAY* ptarray_from_GEOSCoordSeq(const GEOSCoordSequence* cs, uint8_t want3d);
 
+#define LWGEOM_GEOS_ERRMSG_MAXSIZE 256
+#if MEOS
+/* The last GEOS error message is kept per thread */
+#define lwgeom_geos_errmsg (meos_geos_errmsg())
+#else
 extern char lwgeom_geos_errmsg[];
+#endif
 extern void lwgeom_geos_error(const char* fmt, ...) __attribute__ ((format (printf, 1, 2)));
 
 
@@ -28,6 +28,13 @@
 #include "lwgeom_log.h"
 #include <string.h>
 
+#if MEOS
+/* MEOS creates the PROJ objects in the PROJ context of the calling thread */
+extern PJ_CONTEXT *proj_get_context(void);
+#undef PJ_DEFAULT_CTX
+#define PJ_DEFAULT_CTX proj_get_context()
+#endif
+
 /** convert decimal degrees to radians */
 static void
 to_rad(POINT4D *pt)
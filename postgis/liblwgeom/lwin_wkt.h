@@ -23,8 +23,27 @@
  *
  **********************************************************************/
 
+#ifndef _LWIN_WKT_H
+#define _LWIN_WKT_H
+
 #include "liblwgeom_internal.h"
 
+/*
+* MEOS may parse WKT in several threads at the same time. The state of the
+* scanner and of the parser generated in the files lwin_wkt_lex.c and
+* lwin_wkt_parse.c is thus declared with this storage class, which must be
+* added again when these files are regenerated.
+*/
+#if MEOS
+#if defined(_MSC_VER)
+#define WKT_THREAD_LOCAL __declspec(thread)
+#else
+#define WKT_THREAD_LOCAL __thread
+#endif
+#else
+#define WKT_THREAD_LOCAL
+#endif
+
 /*
 * Coordinate object to hold information about last coordinate temporarily.
 * We need to know how many dimensions there are at any given time.
@@ -42,7 +61,7 @@ POINT;
 /*
 * Global that holds the final output geometry for the WKT parser.
 */
-extern LWGEOM_PARSER_RESULT global_parser_result;
+extern WKT_THREAD_LOCAL LWGEOM_PARSER_RESULT global_parser_result;
 extern const char *parser_error_messages[];
 
 /*
@@ -79,3 +98,5 @@ LWGEOM* wkt_parser_collection_new(LWGEOM *geom);
 LWGEOM* wkt_parser_collection_add_geom(LWGEOM *col, LWGEOM *geom);
 LWGEOM* wkt_parser_collection_finalize(int lwtype, LWGEOM *col, char *dimensionality);
 void wkt_parser_geometry_new(LWGEOM *geom, int32_t srid);
+
+#endif /* _LWIN_WKT_H */
@@ -4,6 +4,8 @@
 
 #define  YY_INT_ALIGNED short int
 
+#include "lwin_wkt.h"
+
 /* A lexical scanner generated by flex */
 
 #define yy_create_buffer wkt_yy_create_buffer
@@ -414,9 +416,9 @@ typedef struct yy_buffer_state *YY_BUFFER_STATE;
 typedef size_t yy_size_t;
 #endif
 
-extern int yyleng;
+extern WKT_THREAD_LOCAL int yyleng;
 
-extern FILE *yyin, *yyout;
+extern WKT_THREAD_LOCAL FILE *yyin, *yyout;
 
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
@@ -506,9 +508,9 @@ struct yy_buffer_state
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE * yy_buffer_stack = NULL; /**< Stack as an array. */
+static WKT_THREAD_LOCAL size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static WKT_THREAD_LOCAL size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static WKT_THREAD_LOCAL YY_BUFFER_STATE * yy_buffer_stack = NULL; /**< Stack as an array. */
 
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
@@ -525,19 +527,19 @@ static YY_BUFFER_STATE * yy_buffer_stack = NULL; /**< Stack as an array. */
 #define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
 
 /* yy_hold_char holds the character lost when yytext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int yyleng;
+static WKT_THREAD_LOCAL char yy_hold_char;
+static WKT_THREAD_LOCAL int yy_n_chars;		/* number of characters read into yy_ch_buf */
+WKT_THREAD_LOCAL int yyleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = NULL;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static WKT_THREAD_LOCAL char *yy_c_buf_p = NULL;
+static WKT_THREAD_LOCAL int yy_init = 0;		/* whether we need to initialize */
+static WKT_THREAD_LOCAL int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow yywrap()'s to do buffer switches
  * instead of setting up a fresh yyin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static WKT_THREAD_LOCAL int yy_did_buffer_switch_on_eof;
 
 void yyrestart ( FILE *input_file  );
 void yy_switch_to_buffer ( YY_BUFFER_STATE new_buffer  );
@@ -587,14 +589,14 @@ void yyfree ( void *  );
 #define YY_SKIP_YYWRAP
 typedef flex_uint8_t YY_CHAR;
 
-FILE *yyin = NULL, *yyout = NULL;
+WKT_THREAD_LOCAL FILE *yyin = NULL, *yyout = NULL;
 
 typedef int yy_state_type;
 
-extern int yylineno;
-int yylineno = 1;
+extern WKT_THREAD_LOCAL int yylineno;
+WKT_THREAD_LOCAL int yylineno = 1;
 
-extern char *yytext;
+extern WKT_THREAD_LOCAL char *yytext;
 #ifdef yytext_ptr
 #undef yytext_ptr
 #endif
@@ -840,8 +842,8 @@ static const flex_int16_t yy_chk[444] =
       176,  176,  176
     } ;
 
-static yy_state_type yy_last_accepting_state;
-static char *yy_last_accepting_cpos;
+static WKT_THREAD_LOCAL yy_state_type yy_last_accepting_state;
+static WKT_THREAD_LOCAL char *yy_last_accepting_cpos;
 
 extern int yy_flex_debug;
 int yy_flex_debug = 0;
@@ -853,7 +855,7 @@ int yy_flex_debug = 0;
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *yytext;
+WKT_THREAD_LOCAL char *yytext;
 #line 1 "lwin_wkt_lex.l"
 #line 2 "lwin_wkt_lex.l"
 
@@ -865,7 +867,7 @@ char *yytext;
 #include "lwin_wkt_parse.h"
 #include "lwgeom_log.h"
 
-static YY_BUFFER_STATE wkt_yy_buf_state;
+static WKT_THREAD_LOCAL YY_BUFFER_STATE wkt_yy_buf_state;
 
 /*
 * Handle errors due to unexpected junk in WKT strings.
@@ -94,7 +94,7 @@ int wkt_yylex(void);
 
 
 /* Declare the global parser variable */
-LWGEOM_PARSER_RESULT global_parser_result;
+WKT_THREAD_LOCAL LWGEOM_PARSER_RESULT global_parser_result;
 
 /* Turn on/off verbose parsing (turn off for production) */
 int wkt_yydebug = 0;
@@ -1746,18 +1746,18 @@ yydestruct (const char *yymsg,
 
 
 /* Lookahead token kind.  */
-int yychar;
+WKT_THREAD_LOCAL int yychar;
 
 /* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
+WKT_THREAD_LOCAL YYSTYPE yylval;
 /* Location data for the lookahead symbol.  */
-YYLTYPE yylloc
+WKT_THREAD_LOCAL YYLTYPE yylloc
 # if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
   = { 1, 1, 1, 1 }
 # endif
 ;
 /* Number of syntax errors so far.  */
-int yynerrs;
+WKT_THREAD_LOCAL int yynerrs;
 
 
 
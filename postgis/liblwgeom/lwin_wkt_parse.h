@@ -117,8 +117,8 @@ struct YYLTYPE
 #endif
 
 
-extern YYSTYPE wkt_yylval;
-extern YYLTYPE wkt_yylloc;
+extern WKT_THREAD_LOCAL YYSTYPE wkt_yylval;
+extern WKT_THREAD_LOCAL YYLTYPE wkt_yylloc;
 
 int wkt_yyparse (void);
 
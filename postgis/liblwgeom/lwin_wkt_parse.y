@@ -16,7 +16,7 @@ int wkt_yylex(void);
 
 
 /* Declare the global parser variable */
-LWGEOM_PARSER_RESULT global_parser_result;
+WKT_THREAD_LOCAL LWGEOM_PARSER_RESULT global_parser_result;
 
 /* Turn on/off verbose parsing (turn off for production) */
 int wkt_yydebug = 0;